@@ -38,8 +38,8 @@
 #include "no_os_util.h"
 #include "no_os_alloc.h"
 
-#define AD74413R_FRAME_SIZE 		4
 #define AD74413R_CRC_POLYNOMIAL 	0x7
+#define AD74413R_STREAM_POLL_US		20
 #define AD74413R_DIN_DEBOUNCE_LEN 	NO_OS_BIT(5)
 
 NO_OS_DECLARE_CRC8_TABLE(_crc_table);
@@ -266,6 +266,83 @@ int ad74413r_reg_read(struct ad74413r_desc *desc, uint32_t addr, uint16_t *val)
 	return 0;
 }
 
+/**
+ * @brief Read consecutive registers with the auto read feature, optionally
+ * followed by a register write, in a single SPI transfer.
+ * @param desc - The device structure.
+ * @param addr - The address of the first register.
+ * @param nb - The number of registers, at most AD74413R_BURST_MAX.
+ * @param frames - The raw frames of the registers (4 bytes each).
+ * @param wr_frame - A write frame sent after the reads, NULL if none. It is
+ * overwritten by the frame received meanwhile.
+ * @return 0 in case of success, negative error otherwise.
+ */
+static int __ad74413r_reg_read_burst(struct ad74413r_desc *desc, uint32_t addr,
+				     uint32_t nb, uint8_t *frames,
+				     uint8_t *wr_frame)
+{
+	struct no_os_spi_msg msgs[AD74413R_BURST_MAX + 2] = {0};
+	uint8_t sel[AD74413R_FRAME_SIZE];
+	uint32_t i, n = 0;
+	uint8_t *frame;
+	uint8_t crc;
+	int ret;
+
+	if (!nb || nb > AD74413R_BURST_MAX)
+		return -EINVAL;
+
+	/*
+	 * Every frame is sent in place, the no_os_spi_transfer() fallback
+	 * needs tx_buff == rx_buff. Each NOP frame is built in the slot of the
+	 * register it returns, the next one after addr.
+	 */
+	ad74413r_format_reg_write(AD74413R_READ_SELECT,
+				  addr | AD74413R_AUTO_RD_EN_MASK, sel);
+	msgs[n].tx_buff = sel;
+	msgs[n++].rx_buff = sel;
+	for (i = 0; i < nb; i++) {
+		frame = &frames[i * AD74413R_FRAME_SIZE];
+		ad74413r_format_reg_write(AD74413R_NOP, AD74413R_NOP, frame);
+		msgs[n].tx_buff = frame;
+		msgs[n++].rx_buff = frame;
+	}
+	if (wr_frame) {
+		msgs[n].tx_buff = wr_frame;
+		msgs[n++].rx_buff = wr_frame;
+	}
+	for (i = 0; i < n; i++) {
+		msgs[i].bytes_number = AD74413R_FRAME_SIZE;
+		msgs[i].cs_change = 1;
+	}
+
+	ret = no_os_spi_transfer(desc->comm_desc, msgs, n);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < nb; i++) {
+		crc = no_os_crc8(_crc_table, &frames[i * AD74413R_FRAME_SIZE], 3, 0);
+		if (crc != frames[i * AD74413R_FRAME_SIZE + 3])
+			return -EINVAL;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Read the raw frames of consecutive registers in a single SPI
+ * transfer.
+ * @param desc - The device structure.
+ * @param addr - The address of the first register.
+ * @param nb - The number of registers, at most AD74413R_BURST_MAX.
+ * @param frames - The raw frames of the registers (4 bytes each).
+ * @return 0 in case of success, negative error otherwise.
+ */
+int ad74413r_reg_read_burst(struct ad74413r_desc *desc, uint32_t addr,
+			    uint32_t nb, uint8_t *frames)
+{
+	return __ad74413r_reg_read_burst(desc, addr, nb, frames, NULL);
+}
+
 /**
  * @brief Update a register's field.
  * @param desc  - The device structure.
@@ -748,6 +825,200 @@ int ad74413r_get_adc_single(struct ad74413r_desc *desc, uint32_t ch,
 	return ad74413r_set_adc_channel_enable(desc, ch, false);
 }
 
+/**
+ * @brief Start converting the stream channels continuously.
+ * @param desc - The device structure.
+ * @param stream - The stream configuration.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ad74413r_stream_start(struct ad74413r_desc *desc,
+			  struct ad74413r_stream *stream)
+{
+	uint16_t conv_ctrl;
+	uint32_t last;
+	uint32_t ch;
+	int ret;
+
+	if (!stream || stream->ch_mask & ~NO_OS_GENMASK(3, 0) ||
+	    stream->diag_mask & ~NO_OS_GENMASK(3, 0))
+		return -EINVAL;
+
+	if (stream->nb_rr_diag) {
+		if (!stream->rr_diag ||
+		    stream->rr_ch >= AD74413R_N_DIAG_CHANNELS)
+			return -EINVAL;
+
+		stream->diag_mask |= NO_OS_BIT(stream->rr_ch);
+
+		ret = ad74413r_reg_read(desc, AD74413R_DIAG_ASSIGN,
+					&stream->diag_assign);
+		if (ret)
+			return ret;
+
+		stream->rr_idx = 0;
+		stream->diag_assign &= ~AD74413R_DIAG_ASSIGN_MASK(stream->rr_ch);
+		stream->diag_assign |= no_os_field_prep(
+					       AD74413R_DIAG_ASSIGN_MASK(stream->rr_ch),
+					       stream->rr_diag[0]);
+		ret = ad74413r_reg_write(desc, AD74413R_DIAG_ASSIGN,
+					 stream->diag_assign);
+		if (ret)
+			return ret;
+	}
+
+	if (!stream->ch_mask && !stream->diag_mask)
+		return -EINVAL;
+
+	/* The results of all channels are read from first_reg to the last one */
+	if (stream->ch_mask)
+		stream->first_reg = AD74413R_ADC_RESULT(
+					    no_os_find_first_set_bit(stream->ch_mask));
+	else
+		stream->first_reg = AD74413R_DIAG_RESULT(
+					    no_os_find_first_set_bit(stream->diag_mask));
+	if (stream->diag_mask)
+		last = AD74413R_DIAG_RESULT(no_os_find_last_set_bit(stream->diag_mask));
+	else
+		last = AD74413R_ADC_RESULT(no_os_find_last_set_bit(stream->ch_mask));
+	stream->nb_regs = last - stream->first_reg + 1;
+
+	ret = ad74413r_reg_read(desc, AD74413R_ADC_CONV_CTRL, &conv_ctrl);
+	if (ret)
+		return ret;
+
+	conv_ctrl &= ~(NO_OS_GENMASK(7, 0) | AD74413R_CONV_SEQ_MASK);
+	conv_ctrl |= stream->ch_mask;
+	conv_ctrl |= stream->diag_mask << 4;
+	conv_ctrl |= no_os_field_prep(AD74413R_CONV_SEQ_MASK,
+				      AD74413R_START_CONT);
+	ret = ad74413r_reg_write(desc, AD74413R_ADC_CONV_CTRL, conv_ctrl);
+	if (ret)
+		return ret;
+
+	/* ADC power up time */
+	no_os_udelay(100);
+
+	for (ch = 0; ch < AD74413R_N_CHANNELS; ch++)
+		desc->channel_configs[ch].enabled = stream->ch_mask & NO_OS_BIT(ch);
+
+	return 0;
+}
+
+/**
+ * @brief Wait for the end of a conversion sequence by polling the
+ * ADC_DATA_RDY bit. The ADC_RDY pin can be used instead, as an interrupt.
+ * @param desc - The device structure.
+ * @param timeout_us - The maximum time to wait.
+ * @return 0 in case of success, -ETIMEDOUT if no sequence ended, negative
+ * error code otherwise.
+ */
+int ad74413r_stream_wait(struct ad74413r_desc *desc, uint32_t timeout_us)
+{
+	uint32_t elapsed = 0;
+	uint16_t status;
+	int ret;
+
+	while (true) {
+		ret = ad74413r_reg_read(desc, AD74413R_LIVE_STATUS, &status);
+		if (ret)
+			return ret;
+
+		if (status & AD74413R_ADC_DATA_RDY_MASK)
+			return ad74413r_reg_write(desc, AD74413R_LIVE_STATUS,
+						  AD74413R_ADC_DATA_RDY_MASK);
+
+		if (elapsed >= timeout_us)
+			return -ETIMEDOUT;
+
+		no_os_udelay(AD74413R_STREAM_POLL_US);
+		elapsed += AD74413R_STREAM_POLL_US;
+	}
+}
+
+/**
+ * @brief Read the results of the last conversion sequence in a single SPI
+ * transfer, and select the next round-robin diagnostic.
+ * @param desc - The device structure.
+ * @param stream - The stream started by ad74413r_stream_start().
+ * @param data - The ADC channel results followed by the diagnostic results,
+ * in channel order.
+ * @return The number of results in case of success, negative error code
+ * otherwise.
+ */
+int ad74413r_stream_read(struct ad74413r_desc *desc,
+			 struct ad74413r_stream *stream, uint16_t *data)
+{
+	uint8_t frames[AD74413R_BURST_MAX * AD74413R_FRAME_SIZE];
+	uint8_t wr_frame[AD74413R_FRAME_SIZE];
+	uint16_t assign = stream->diag_assign;
+	uint32_t reg, i;
+	uint8_t next = 0;
+	int ret, n = 0;
+
+	if (stream->nb_rr_diag) {
+		next = (stream->rr_idx + 1) % stream->nb_rr_diag;
+		assign &= ~AD74413R_DIAG_ASSIGN_MASK(stream->rr_ch);
+		assign |= no_os_field_prep(AD74413R_DIAG_ASSIGN_MASK(stream->rr_ch),
+					   stream->rr_diag[next]);
+		ad74413r_format_reg_write(AD74413R_DIAG_ASSIGN, assign, wr_frame);
+	}
+
+	ret = __ad74413r_reg_read_burst(desc, stream->first_reg, stream->nb_regs,
+					frames,
+					stream->nb_rr_diag ? wr_frame : NULL);
+	if (ret)
+		return ret;
+
+	if (stream->nb_rr_diag) {
+		stream->rr_result = stream->rr_diag[stream->rr_idx];
+		stream->rr_idx = next;
+		stream->diag_assign = assign;
+	}
+
+	for (i = 0; i < stream->nb_regs; i++) {
+		reg = stream->first_reg + i;
+		if (reg < AD74413R_DIAG_RESULT(0)) {
+			if (!(stream->ch_mask & NO_OS_BIT(reg - AD74413R_ADC_RESULT(0))))
+				continue;
+		} else if (!(stream->diag_mask &
+			     NO_OS_BIT(reg - AD74413R_DIAG_RESULT(0)))) {
+			continue;
+		}
+
+		data[n++] = no_os_get_unaligned_be16(&frames[i * AD74413R_FRAME_SIZE + 1]);
+	}
+
+	return n;
+}
+
+/**
+ * @brief Stop the stream conversions and power down the ADC.
+ * @param desc - The device structure.
+ * @param stream - The stream started by ad74413r_stream_start().
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ad74413r_stream_stop(struct ad74413r_desc *desc,
+			 struct ad74413r_stream *stream)
+{
+	uint32_t ch;
+	int ret;
+
+	ret = ad74413r_set_adc_conv_seq(desc, AD74413R_STOP_PWR_DOWN);
+	if (ret)
+		return ret;
+
+	ret = ad74413r_reg_update(desc, AD74413R_ADC_CONV_CTRL,
+				  NO_OS_GENMASK(7, 0), 0);
+	if (ret)
+		return ret;
+
+	for (ch = 0; ch < AD74413R_N_CHANNELS; ch++)
+		if (stream->ch_mask & NO_OS_BIT(ch))
+			desc->channel_configs[ch].enabled = false;
+
+	return 0;
+}
+
 /**
  * @brief Get the ADC real value, according to the operation mode.
  * @param desc - The device structure.
@@ -90,6 +90,7 @@
 /** Command to load code into the DAC from DAC_CLR_CODEx */
 #define AD74413R_CMD_KEY_DAC_CLEAR		0x73D1
 
+#define AD74413R_AUTO_RD_EN_MASK		NO_OS_BIT(9)
 #define AD74413R_SPI_RD_RET_INFO_MASK		NO_OS_BIT(8)
 #define AD74413R_ERR_CLR_MASK			NO_OS_GENMASK(15, 0)
 #define AD74413R_SPI_CRC_ERR_MASK		NO_OS_BIT(13)
@@ -141,6 +142,13 @@
 /** DIAG_ASSIGN register */
 #define AD74413R_DIAG_ASSIGN_MASK(x)		(NO_OS_GENMASK(3, 0) << (x * 4))
 
+/** LIVE_STATUS register */
+#define AD74413R_ADC_DATA_RDY_MASK		NO_OS_BIT(14)
+
+/** DIN_COMP_OUT, ADC_RESULTx and DIAG_RESULTx can be read in one burst */
+#define AD74413R_BURST_MAX	(AD74413R_DIAG_RESULT(3) - AD74413R_DIN_COMP_OUT + 1)
+#define AD74413R_FRAME_SIZE	4
+
 /** The maximum voltage output of the DAC is 11V */
 #define AD74413R_DAC_RANGE			11000
 /** 13 bit DAC */
@@ -354,6 +362,36 @@ struct ad74413r_desc {
 	struct no_os_gpio_desc *reset_gpio;
 };
 
+/**
+ * @brief Continuous conversion stream.
+ *
+ * The ADC channels and diagnostics are converted in a loop and every
+ * sequence is read in one SPI burst. Optionally, the diagnostic channel
+ * rr_ch measures the rr_diag functions in turn, one per sequence. The next
+ * function is assigned in the same burst as the results are read, so it is
+ * measured in the next sequence as long as the burst ends before the ADC
+ * channels of that sequence are converted.
+ */
+struct ad74413r_stream {
+	/** ADC channels to convert, bit 0 is channel A */
+	uint8_t ch_mask;
+	/** Diagnostic channels to convert, with the functions already set */
+	uint8_t diag_mask;
+	/** Diagnostic channel used for the round-robin */
+	uint8_t rr_ch;
+	/** Round-robin diagnostic functions */
+	const enum ad74413r_diag_mode *rr_diag;
+	/** Number of round-robin functions, 0 to disable the round-robin */
+	uint8_t nb_rr_diag;
+	/** Function measured by rr_ch in the last read sequence */
+	enum ad74413r_diag_mode rr_result;
+	/** Private, set by ad74413r_stream_start() */
+	uint8_t rr_idx;
+	uint16_t diag_assign;
+	uint8_t first_reg;
+	uint8_t nb_regs;
+};
+
 /** Converts a millivolt value in the corresponding DAC 13 bit code */
 int ad74413r_dac_voltage_to_code(uint32_t, uint32_t *);
 
@@ -371,6 +409,10 @@ int ad74413r_reg_read_raw(struct ad74413r_desc *, uint32_t, uint8_t *);
 /** Read a register's value */
 int ad74413r_reg_read(struct ad74413r_desc *, uint32_t, uint16_t *);
 
+/** Read the raw frames of consecutive registers in a single SPI transfer */
+int ad74413r_reg_read_burst(struct ad74413r_desc *, uint32_t, uint32_t,
+			    uint8_t *);
+
 /** Update a register's field */
 int ad74413r_reg_update(struct ad74413r_desc *, uint32_t, uint16_t,
 			uint16_t);
@@ -442,6 +484,19 @@ int ad74413r_set_adc_conv_seq(struct ad74413r_desc *, enum ad74413r_conv_seq);
 /** Get a single ADC raw value for a specific channel, then power down the ADC */
 int ad74413r_get_adc_single(struct ad74413r_desc *, uint32_t, uint16_t *, bool);
 
+/** Start converting the stream channels continuously */
+int ad74413r_stream_start(struct ad74413r_desc *, struct ad74413r_stream *);
+
+/** Wait for the end of a conversion sequence */
+int ad74413r_stream_wait(struct ad74413r_desc *, uint32_t);
+
+/** Read the results of the last conversion sequence */
+int ad74413r_stream_read(struct ad74413r_desc *, struct ad74413r_stream *,
+			 uint16_t *);
+
+/** Stop the stream conversions and power down the ADC */
+int ad74413r_stream_stop(struct ad74413r_desc *, struct ad74413r_stream *);
+
 /** Get the ADC real value, according to the operation mode */
 int ad74413r_adc_get_value(struct ad74413r_desc *, uint32_t,
 			   struct ad74413r_decimal *);
@@ -1427,22 +1427,32 @@ static int ad74413r_iio_buffer_disable(void *dev)
  */
 static int ad74413r_iio_read_samples(void *dev, uint32_t *buf, uint32_t samples)
 {
-	int ret;
-	uint32_t j = 0;
-	uint32_t val;
-	uint32_t i, chan_i;
+	uint8_t frames[AD74413R_N_CHANNELS * AD74413R_FRAME_SIZE];
 	struct ad74413r_iio_desc *iio_desc = dev;
+	uint32_t first, nb;
+	uint32_t i, chan_i;
+	uint32_t j = 0;
+	int ret;
+
+	if (!(iio_desc->active_channels & NO_OS_GENMASK(AD74413R_N_CHANNELS - 1, 0)))
+		return -EINVAL;
+
+	first = no_os_find_first_set_bit(iio_desc->active_channels);
+	nb = no_os_find_last_set_bit(iio_desc->active_channels &
+				     NO_OS_GENMASK(AD74413R_N_CHANNELS - 1, 0)) - first + 1;
 
 	for (i = 0; i < samples; i++) {
-		for (chan_i = 0; chan_i < AD74413R_N_CHANNELS; chan_i++) {
-			if (iio_desc->active_channels & NO_OS_BIT(chan_i)) {
-				ret = ad74413r_reg_read_raw(iio_desc->ad74413r_desc,
-							    AD74413R_ADC_RESULT(chan_i),
-							    (uint8_t *)&val);
-				if (ret)
-					return ret;
-				buf[j++] = val;
-			}
+		/* All the ADC results of a sample are read in a single transfer */
+		ret = ad74413r_reg_read_burst(iio_desc->ad74413r_desc,
+					      AD74413R_ADC_RESULT(first), nb, frames);
+		if (ret)
+			return ret;
+
+		for (chan_i = first; chan_i < first + nb; chan_i++) {
+			if (iio_desc->active_channels & NO_OS_BIT(chan_i))
+				memcpy(&buf[j++],
+				       &frames[(chan_i - first) * AD74413R_FRAME_SIZE],
+				       AD74413R_FRAME_SIZE);
 		}
 	}
 
@@ -1456,52 +1466,70 @@ static int ad74413r_iio_read_samples(void *dev, uint32_t *buf, uint32_t samples)
  */
 static int ad74413r_iio_trigger_handler(struct iio_device_data *dev_data)
 {
-	int ret;
-	uint32_t i;
+	uint8_t frames[AD74413R_BURST_MAX * AD74413R_FRAME_SIZE];
+	uint32_t regs[AD74413R_N_CHANNELS + AD74413R_N_DIAG_CHANNELS];
+	uint32_t first = AD74413R_DIAG_RESULT(AD74413R_N_DIAG_CHANNELS - 1);
+	uint32_t last = AD74413R_DIN_COMP_OUT;
+	uint32_t i, n = 0;
 	uint32_t ch;
-	uint32_t diag_ch_idx;
 	uint32_t digital_val;
 	uint8_t buff[32] = {0};
-	uint32_t buffer_idx = 0;
+	uint8_t *frame;
 	struct ad74413r_iio_desc *iio_desc;
 	struct ad74413r_channel_config *config;
-	struct ad74413r_desc *desc;
+	int ret;
 
 	iio_desc = dev_data->dev;
-	desc = iio_desc->ad74413r_desc;
 	config = iio_desc->channel_configs;
 
-	for (i = 0; i < AD74413R_N_CHANNELS + AD74413R_N_CHANNELS; i++) {
-		if (iio_desc->active_channels & NO_OS_BIT(i)) {
-			ret = _get_ch_by_idx(iio_desc->iio_dev, i, &ch);
-			if (ret)
-				continue;
+	for (i = 0; i < AD74413R_N_CHANNELS + AD74413R_N_DIAG_CHANNELS; i++) {
+		if (!(iio_desc->active_channels & NO_OS_BIT(i)))
+			continue;
 
-			if (ch < AD74413R_N_DIAG_CHANNELS) {
-				if (config[ch].function == AD74413R_DIGITAL_INPUT ||
-				    config[ch].function == AD74413R_DIGITAL_INPUT_LOOP) {
-					ret = ad74413r_reg_read_raw(desc, AD74413R_DIN_COMP_OUT,
-								    &buff[buffer_idx]);
-					digital_val = no_os_field_get(AD74413R_DIN_COMP_CH(ch),
-								      buff[buffer_idx + 2]);
-					buff[buffer_idx + 1] = 0x0;
-					buff[buffer_idx + 2] = !!digital_val;
-				} else {
-					ret = ad74413r_reg_read_raw(desc, AD74413R_ADC_RESULT(ch),
-								    &buff[buffer_idx]);
-				}
-			} else {
-				diag_ch_idx = ch - AD74413R_N_DIAG_CHANNELS;
-				ret = ad74413r_reg_read_raw(desc,
-							    AD74413R_DIAG_RESULT(diag_ch_idx),
-							    &buff[buffer_idx]);
-			}
+		ret = _get_ch_by_idx(iio_desc->iio_dev, i, &ch);
+		if (ret)
+			continue;
 
-			if (ret)
-				return ret;
+		if (ch >= AD74413R_N_CHANNELS)
+			regs[n] = AD74413R_DIAG_RESULT(ch - AD74413R_N_CHANNELS);
+		else if (config[ch].function == AD74413R_DIGITAL_INPUT ||
+			 config[ch].function == AD74413R_DIGITAL_INPUT_LOOP)
+			regs[n] = AD74413R_DIN_COMP_OUT;
+		else
+			regs[n] = AD74413R_ADC_RESULT(ch);
+
+		first = no_os_min(first, regs[n]);
+		last = no_os_max(last, regs[n]);
+		n++;
+	}
+
+	if (!n)
+		return 0;
+
+	/*
+	 * The result registers are consecutive, so the whole scan is read with
+	 * a single SPI transfer instead of one register read per channel.
+	 */
+	ret = ad74413r_reg_read_burst(iio_desc->ad74413r_desc, first,
+				      last - first + 1, frames);
+	if (ret)
+		return ret;
+
+	for (i = 0, n = 0; i < AD74413R_N_CHANNELS + AD74413R_N_DIAG_CHANNELS; i++) {
+		if (!(iio_desc->active_channels & NO_OS_BIT(i)))
+			continue;
+
+		if (_get_ch_by_idx(iio_desc->iio_dev, i, &ch))
+			continue;
 
-			buffer_idx += 4;
+		frame = &frames[(regs[n] - first) * AD74413R_FRAME_SIZE];
+		memcpy(&buff[n * AD74413R_FRAME_SIZE], frame, AD74413R_FRAME_SIZE);
+		if (regs[n] == AD74413R_DIN_COMP_OUT) {
+			digital_val = no_os_field_get(AD74413R_DIN_COMP_CH(ch), frame[2]);
+			buff[n * AD74413R_FRAME_SIZE + 1] = 0x0;
+			buff[n * AD74413R_FRAME_SIZE + 2] = !!digital_val;
 		}
+		n++;
 	}
 
 	return iio_buffer_push_scan(dev_data->buffer, buff);
@@ -561,6 +561,7 @@ int32_t ad469x_std_sequence_ch(struct ad469x_dev *dev, uint16_t ch_mask)
 		return ret;
 
 	dev->num_slots = no_os_hweight16(ch_mask);
+	dev->std_seq_ch_mask = ch_mask;
 
 	return ret;
 }
@@ -735,6 +736,56 @@ static int32_t ad469x_adv_seq_osr_get_util_data(struct ad469x_dev *dev,
 	return 0;
 }
 
+#if defined(USE_STANDARD_SPI)
+/**
+ * @brief Read conversion results, one CS frame per conversion, with a single
+ *        SPI transfer.
+ * @param [in] dev - ad469x_dev device handler.
+ * @param [in] msgs - Message descriptors, one per conversion.
+ * @param [in] rx - Frame buffer, nb frames long.
+ * @param [out] buf - Conversion results, right aligned.
+ * @param [in] nb - Number of conversions.
+ * @param [in] gap_us - Delay between two frames.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ad469x_read_frames(struct ad469x_dev *dev,
+				  struct no_os_spi_msg *msgs,
+				  uint8_t *rx,
+				  uint32_t *buf,
+				  uint32_t nb,
+				  uint32_t gap_us)
+{
+	uint8_t bytes = NO_OS_DIV_ROUND_UP(dev->capture_data_width, 8);
+	uint8_t shift = bytes * 8 - dev->capture_data_width;
+	uint32_t i, j, raw;
+	int32_t ret;
+
+	/* Zeros on SDI, no command is issued in conversion mode */
+	memset(rx, 0, nb * bytes);
+	memset(msgs, 0, nb * sizeof(*msgs));
+	for (i = 0; i < nb; i++) {
+		msgs[i].tx_buff = &rx[i * bytes];
+		msgs[i].rx_buff = &rx[i * bytes];
+		msgs[i].bytes_number = bytes;
+		msgs[i].cs_change = 1;
+		msgs[i].cs_change_delay = gap_us;
+	}
+
+	ret = no_os_spi_transfer(dev->spi_desc, msgs, nb);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < nb; i++) {
+		raw = 0;
+		for (j = 0; j < bytes; j++)
+			raw = (raw << 8) | rx[i * bytes + j];
+		buf[i] = raw >> shift;
+	}
+
+	return 0;
+}
+#endif
+
 /**
  * @brief Read from device when converter has the channel sequencer activated.
  *        Enter register mode to read/write registers
@@ -820,14 +871,211 @@ int32_t ad469x_read_data(struct ad469x_dev *dev,
 	if (dev->dcache_invalidate_range)
 		dev->dcache_invalidate_range(msg.rx_addr, samples * 4);
 #else
-	ret = no_os_spi_write_and_read(dev->spi_desc, buf, (samples * 2));
-	if (ret != 0)
-		return ret;
+	uint32_t nb;
+
+	ret = 0;
+	while (samples) {
+		nb = no_os_min((uint32_t)samples, AD469x_STREAM_BATCH_MAX);
+		ret = ad469x_read_frames(dev, dev->read_msgs, dev->read_rx, buf,
+					 nb, 0);
+		if (ret)
+			break;
+
+		buf += nb;
+		samples -= nb;
+	}
 #endif
 
 	return ret;
 }
 
+#if defined(USE_STANDARD_SPI)
+/**
+ * @brief Prepare the streaming of the active sequence. The sequencer and the
+ *        conversion mode must already be configured. stream->ch_buf,
+ *        stream->ch_len, stream->batch and stream->period_ns are set by the
+ *        user, the samples are delivered with ad469x_seq_stream_read().
+ * @param [in] dev - ad469x_dev device handler.
+ * @param [in, out] stream - Stream descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad469x_seq_stream_init(struct ad469x_dev *dev,
+			       struct ad469x_stream *stream)
+{
+	uint8_t bytes;
+	uint32_t frame_ns, i;
+
+	if (!dev || !stream || !stream->batch ||
+	    stream->batch > AD469x_STREAM_BATCH_MAX)
+		return -EINVAL;
+
+	stream->nb_slots = 0;
+	if (dev->ch_sequence == AD469x_advanced_seq) {
+		for (i = 0; i < dev->num_slots; i++)
+			stream->slot_ch[stream->nb_slots++] = dev->ch_slots[i];
+	} else if (dev->ch_sequence == AD469x_standard_seq) {
+		for (i = 0; i < AD469x_CHANNEL_NO; i++)
+			if (dev->std_seq_ch_mask & NO_OS_BIT(i))
+				stream->slot_ch[stream->nb_slots++] = i;
+	} else {
+		return -EINVAL;
+	}
+
+	if (dev->temp_enabled)
+		stream->slot_ch[stream->nb_slots++] = AD469x_CHANNEL_NO;
+	if (!stream->nb_slots)
+		return -EINVAL;
+
+	bytes = NO_OS_DIV_ROUND_UP(dev->capture_data_width, 8);
+	frame_ns = NO_OS_DIV_ROUND_UP(bytes * 8 * 1000000000ULL,
+				      dev->spi_desc->max_speed_hz);
+	if (stream->period_ns > frame_ns)
+		stream->gap_us = NO_OS_DIV_ROUND_UP(stream->period_ns - frame_ns,
+						    1000);
+	else
+		stream->gap_us = 0;
+
+	stream->msgs = no_os_calloc(stream->batch, sizeof(*stream->msgs));
+	stream->rx = no_os_calloc(stream->batch, bytes);
+	stream->raw = no_os_calloc(stream->batch, sizeof(*stream->raw));
+	if (!stream->msgs || !stream->rx || !stream->raw) {
+		ad469x_seq_stream_remove(stream);
+		return -ENOMEM;
+	}
+
+	stream->slot = 0;
+	stream->nb_transfers = 0;
+	stream->nb_samples = 0;
+	stream->elapsed_us = 0;
+	memset(stream->ch_cnt, 0, sizeof(stream->ch_cnt));
+
+	return 0;
+}
+
+/**
+ * @brief Read samples of every slot of the sequence, batch conversions per
+ *        SPI transfer, and store them in the channel buffers. The sequence
+ *        position is kept between calls.
+ * @param [in] dev - ad469x_dev device handler.
+ * @param [in, out] stream - Stream descriptor.
+ * @param [in] samples - Number of samples per slot.
+ * @return 0 in case of success, -ENOSPC if a channel buffer can't hold its
+ *         samples, in which case nothing is read, negative error code
+ *         otherwise.
+ */
+int32_t ad469x_seq_stream_read(struct ad469x_dev *dev,
+			       struct ad469x_stream *stream,
+			       uint32_t samples)
+{
+	uint64_t need[AD469x_CHANNEL_NO + 1] = {0};
+	struct no_os_time start, end;
+	uint32_t total, nb, i, sample;
+	uint8_t ch;
+	int32_t ret = 0;
+
+	if (!dev || !stream || !stream->msgs)
+		return -EINVAL;
+
+	/* Every slot gets samples conversions, wherever the sequence stands. */
+	for (i = 0; i < stream->nb_slots; i++)
+		need[stream->slot_ch[i]] += samples;
+
+	for (ch = 0; ch <= AD469x_CHANNEL_NO; ch++)
+		if (stream->ch_buf[ch] &&
+		    stream->ch_cnt[ch] + need[ch] > stream->ch_len[ch])
+			return -ENOSPC;
+
+	total = samples * stream->nb_slots;
+	start = no_os_get_time();
+	while (total) {
+		nb = no_os_min(total, stream->batch);
+		ret = ad469x_read_frames(dev, stream->msgs, stream->rx,
+					 stream->raw, nb, stream->gap_us);
+		if (ret)
+			break;
+
+		stream->nb_transfers++;
+		for (i = 0; i < nb; i++) {
+			ch = stream->slot_ch[stream->slot];
+			sample = stream->raw[i];
+			if (dev->ch_sequence == AD469x_advanced_seq &&
+			    ch != AD469x_CHANNEL_NO)
+				sample >>= dev->capture_data_width -
+					   dev->adv_seq_osr_resol[ch];
+
+			if (stream->ch_buf[ch])
+				stream->ch_buf[ch][stream->ch_cnt[ch]++] = sample;
+
+			stream->slot = (stream->slot + 1) % stream->nb_slots;
+		}
+
+		stream->nb_samples += nb;
+		total -= nb;
+	}
+	end = no_os_get_time();
+
+	stream->elapsed_us += (uint64_t)(end.s - start.s) * 1000000 +
+			      end.us - start.us;
+
+	return ret;
+}
+
+/**
+ * @brief Get the sample rate reached by the stream, all slots included, and
+ *        the one of the SPI Engine offload path, where the conversions are
+ *        triggered by the PWM at the device rate and read without software
+ *        intervention.
+ * @param [in] dev - ad469x_dev device handler.
+ * @param [in] stream - Stream descriptor.
+ * @param [out] rate_sps - Streaming sample rate.
+ * @param [out] offload_sps - Offload sample rate for the same SPI clock.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad469x_seq_stream_get_rate(struct ad469x_dev *dev,
+				   struct ad469x_stream *stream,
+				   uint32_t *rate_sps,
+				   uint32_t *offload_sps)
+{
+	uint8_t bytes;
+	uint32_t frame_sps;
+
+	if (!dev || !stream || !rate_sps || !offload_sps)
+		return -EINVAL;
+
+	if (stream->elapsed_us)
+		*rate_sps = stream->nb_samples * 1000000 / stream->elapsed_us;
+	else
+		*rate_sps = 0;
+
+	bytes = NO_OS_DIV_ROUND_UP(dev->capture_data_width, 8);
+	frame_sps = dev->spi_desc->max_speed_hz / (bytes * 8);
+	*offload_sps = no_os_min(dev_info[dev->dev_id].max_rate_ksps * 1000,
+				 frame_sps);
+
+	return 0;
+}
+
+/**
+ * @brief Free the streaming buffers.
+ * @param [in] stream - Stream descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad469x_seq_stream_remove(struct ad469x_stream *stream)
+{
+	if (!stream)
+		return -EINVAL;
+
+	no_os_free(stream->raw);
+	no_os_free(stream->rx);
+	no_os_free(stream->msgs);
+	stream->raw = NULL;
+	stream->rx = NULL;
+	stream->msgs = NULL;
+
+	return 0;
+}
+#endif
+
 /**
  * @brief Resets the ad469x device
  * @param [in] dev - ad469x_dev device handler.
@@ -150,6 +150,12 @@
 #define AD469x_CHANNEL_NO			16
 #define AD469x_SLOTS_NO				0x80
 
+#if defined(USE_STANDARD_SPI)
+/* Conversions read with a single SPI transfer, kept under the 511 transfers
+ * and the 4096 bytes a spidev message is limited to. */
+#define AD469x_STREAM_BATCH_MAX			256
+#endif
+
 /**
  * @enum ad469x_channel_sequencing
  * @brief Channel sequencing modes
@@ -336,10 +342,61 @@ struct ad469x_dev {
 	bool temp_enabled;
 	/** Number of active channel slots, for advanced sequencer */
 	uint8_t num_slots;
+	/** Channels enabled in the standard sequencer */
+	uint16_t std_seq_ch_mask;
 	/** Number of data channels to enable */
 	uint8_t num_data_ch;
+#if defined(USE_STANDARD_SPI)
+	/** Message descriptors of ad469x_read_data() */
+	struct no_os_spi_msg read_msgs[AD469x_STREAM_BATCH_MAX];
+	/** Frame buffer of ad469x_read_data(), up to 32 bit per conversion */
+	uint8_t read_rx[AD469x_STREAM_BATCH_MAX * sizeof(uint32_t)];
+#endif
 };
 
+#if defined(USE_STANDARD_SPI)
+/**
+ * @struct ad469x_stream
+ * @brief Sequencer streaming over a standard SPI controller. Each conversion
+ * is read in its own CS frame and up to batch frames are sent as a single SPI
+ * transfer. The frames are spaced with cs_change delays so that, with CNV
+ * tied to CS or driven by an external clock of the same period, one
+ * conversion is done every period_ns.
+ */
+struct ad469x_stream {
+	/** Sample buffer of each channel, the temperature one being at index
+	 * AD469x_CHANNEL_NO. NULL for the channels that are not stored. */
+	uint32_t *ch_buf[AD469x_CHANNEL_NO + 1];
+	/** Number of samples stored in each buffer, may be cleared by the
+	 * user to reuse the buffers */
+	uint32_t ch_cnt[AD469x_CHANNEL_NO + 1];
+	/** Capacity of each buffer, in samples */
+	uint32_t ch_len[AD469x_CHANNEL_NO + 1];
+	/** Conversions read per SPI transfer, at most AD469x_STREAM_BATCH_MAX */
+	uint32_t batch;
+	/** Conversion period in ns, 0 to read the frames back to back */
+	uint32_t period_ns;
+	/** Number of SPI transfers done */
+	uint32_t nb_transfers;
+	/** Number of conversions read */
+	uint64_t nb_samples;
+	/** Time spent reading the conversions, in us */
+	uint64_t elapsed_us;
+	/* Channel of each sequencer slot */
+	uint8_t slot_ch[AD469x_SLOTS_NO + 1];
+	/* Number of sequencer slots, temperature included */
+	uint32_t nb_slots;
+	/* Slot of the next conversion */
+	uint32_t slot;
+	/* Delay between two frames, in us */
+	uint32_t gap_us;
+	/* Batch buffers */
+	struct no_os_spi_msg *msgs;
+	uint8_t *rx;
+	uint32_t *raw;
+};
+#endif
+
 /* Read device register. */
 int32_t ad469x_spi_reg_read(struct ad469x_dev *dev,
 			    uint16_t reg_addr,
@@ -373,6 +430,26 @@ int32_t ad469x_seq_read_data(struct ad469x_dev *dev,
 			     uint32_t *buf,
 			     uint32_t samples);
 
+#if defined(USE_STANDARD_SPI)
+/* Prepare the streaming of the active sequence */
+int32_t ad469x_seq_stream_init(struct ad469x_dev *dev,
+			       struct ad469x_stream *stream);
+
+/* Read samples per slot of the sequence into the channel buffers */
+int32_t ad469x_seq_stream_read(struct ad469x_dev *dev,
+			       struct ad469x_stream *stream,
+			       uint32_t samples);
+
+/* Get the streaming sample rate and the one of the offload path */
+int32_t ad469x_seq_stream_get_rate(struct ad469x_dev *dev,
+				   struct ad469x_stream *stream,
+				   uint32_t *rate_sps,
+				   uint32_t *offload_sps);
+
+/* Free the streaming buffers */
+int32_t ad469x_seq_stream_remove(struct ad469x_stream *stream);
+#endif
+
 /* Set channel sequence */
 int32_t ad469x_set_channel_sequence(struct ad469x_dev *dev,
 				    enum ad469x_channel_sequencing seq);
@@ -35,6 +35,7 @@
 #include "ad4858.h"
 #include "no_os_delay.h"
 #include "no_os_print_log.h"
+#include "no_os_unpack.h"
 
 /**
  * @brief Write device register.
@@ -685,63 +686,25 @@ int ad4858_spi_data_read(struct ad4858_dev *dev, struct ad4858_conv_data *data)
 {
 	int ret;
 	uint16_t nb_bytes;
-	uint8_t indx;
 	uint8_t chn;
 	uint8_t buff[32] = {0};
-	// Buffer index offset for each channel while reading 20-bit conversion result
-	uint8_t buff_chn_offset[] = { 0, 2, 5, 7, 10, 12, 15, 17 };
+	uint32_t status[AD4858_NUM_CHANNELS];
+	struct no_os_unpack_fmt fmt = { 0 };
 
 	if (!dev || !data)
 		return -EINVAL;
 
-	switch (dev->packet_format) {
-	case AD4858_PACKET_16_BIT:
-		nb_bytes = (16 * AD4858_NUM_CHANNELS) >> 3;
-		break;
-
-	case AD4858_PACKET_20_BIT:
-		nb_bytes = (20 * AD4858_NUM_CHANNELS) >> 3;
-		break;
-
-	case AD4858_PACKET_24_BIT:
-		nb_bytes = (24 * AD4858_NUM_CHANNELS) >> 3;
-		break;
-
-	case AD4858_PACKET_32_BIT:
-		nb_bytes = (32 * AD4858_NUM_CHANNELS) >> 3;
-		break;
-
-	default:
-		return -EINVAL;
-	}
-
-	/* Read SPI data */
-	ret = no_os_spi_write_and_read(dev->spi_desc, buff, nb_bytes);
-	if (ret)
-		return ret;
-
 	switch (dev->prod_res) {
 	case AD4858_16_BIT_RES:
+		fmt.bits = 16;
 		switch (dev->packet_format) {
 		case AD4858_PACKET_16_BIT:
 			/* 16-bit conversion result */
-			for (chn = 0; chn < AD4858_NUM_CHANNELS; chn++) {
-				indx = chn * 2;
-				data->raw[chn] = no_os_get_unaligned_be16(buff + indx);
-			}
 			break;
 
 		case AD4858_PACKET_24_BIT:
 			/* 16-bit conversion result + 1-bit OR/UR + 3-bit channel ID + 4-bit softspan ID */
-			for (chn = 0; chn < AD4858_NUM_CHANNELS; chn++) {
-				indx = chn * 3;
-				data->raw[chn] = no_os_get_unaligned_be16(buff + indx);
-				data->or_ur_status[chn] = no_os_field_get(AD4858_OR_UR_STATUS_MSK_16_BIT,
-							  buff[indx + 2]);
-				data->chn_id[chn] = no_os_field_get(AD4858_CHN_ID_MSK_16_BIT, buff[indx + 2]);
-				data->softspan_id[chn] = no_os_field_get(AD4858_SOFTSPAN_ID_MSK_16_BIT,
-							 buff[indx + 2]);
-			}
+			fmt.status_bits = 8;
 			break;
 
 		default:
@@ -751,45 +714,20 @@ int ad4858_spi_data_read(struct ad4858_dev *dev, struct ad4858_conv_data *data)
 		break;
 
 	case AD4858_20_BIT_RES:
+		fmt.bits = 20;
 		switch (dev->packet_format) {
 		case AD4858_PACKET_20_BIT:
 			/* 20-bit conversion result */
-			for (chn = 0; chn < AD4858_NUM_CHANNELS; chn++) {
-				indx = buff_chn_offset[chn];
-				if (!(chn % 2))
-					data->raw[chn] = no_os_field_get(AD4858_RAW_DATA_MSK_EVEN_20_BIT,
-									 no_os_get_unaligned_be24(buff + indx));
-				else
-					data->raw[chn] = no_os_field_get(AD4858_RAW_DATA_MSK_ODD_20_BIT,
-									 no_os_get_unaligned_be24(buff + indx));
-			}
 			break;
 
 		case AD4858_PACKET_24_BIT:
 			/* 20-bit conversion result + 1-bit OR/UR + 3-bit channel ID */
-			for (chn = 0; chn < AD4858_NUM_CHANNELS; chn++) {
-				indx = chn * 3;
-				data->raw[chn] = no_os_field_get(AD4858_RAW_DATA_MSK_20_BIT,
-								 no_os_get_unaligned_be24(buff + indx));
-				data->or_ur_status[chn] = no_os_field_get(AD4858_OR_UR_STATUS_MSK_20_BIT,
-							  buff[indx + 2]);
-				data->chn_id[chn] = no_os_field_get(AD4858_CHN_ID_MSK_20_BIT, buff[indx + 2]);
-			}
-			chn = 0;
+			fmt.status_bits = 4;
 			break;
 
 		case AD4858_PACKET_32_BIT:
 			/* 20-bit conversion result + 1-bit OR/UR + 3-bit channel ID + 4-bit softspan ID + 4 0's */
-			for (chn = 0; chn < AD4858_NUM_CHANNELS; chn++) {
-				indx = chn * 4;
-				data->raw[chn] = no_os_field_get(AD4858_RAW_DATA_MSK_20_BIT,
-								 no_os_get_unaligned_be24(buff + indx));
-				data->or_ur_status[chn] = no_os_field_get(AD4858_OR_UR_STATUS_MSK_20_BIT,
-							  buff[indx + 2]);
-				data->chn_id[chn] = no_os_field_get(AD4858_CHN_ID_MSK_20_BIT, buff[indx + 2]);
-				data->softspan_id[chn] = no_os_field_get(AD4858_SOFTSPAN_ID_MSK_20_BIT,
-							 buff[indx + 3]);
-			}
+			fmt.status_bits = 12;
 			break;
 
 		default:
@@ -802,6 +740,48 @@ int ad4858_spi_data_read(struct ad4858_dev *dev, struct ad4858_conv_data *data)
 		return -EINVAL;
 	}
 
+	nb_bytes = ((fmt.bits + fmt.status_bits) * AD4858_NUM_CHANNELS) >> 3;
+
+	/* Read SPI data */
+	ret = no_os_spi_write_and_read(dev->spi_desc, buff, nb_bytes);
+	if (ret)
+		return ret;
+
+	ret = no_os_unpack(&fmt, buff, AD4858_NUM_CHANNELS, (int32_t *)data->raw,
+			   status);
+	if (ret)
+		return ret;
+
+	for (chn = 0; chn < AD4858_NUM_CHANNELS; chn++) {
+		switch (fmt.status_bits) {
+		case 8:
+			data->or_ur_status[chn] = no_os_field_get(AD4858_OR_UR_STATUS_MSK_16_BIT,
+						  status[chn]);
+			data->chn_id[chn] = no_os_field_get(AD4858_CHN_ID_MSK_16_BIT, status[chn]);
+			data->softspan_id[chn] = no_os_field_get(AD4858_SOFTSPAN_ID_MSK_16_BIT,
+						 status[chn]);
+			break;
+
+		case 4:
+			data->or_ur_status[chn] = no_os_field_get(AD4858_OR_UR_STATUS_MSK_20_BIT,
+						  status[chn]);
+			data->chn_id[chn] = no_os_field_get(AD4858_CHN_ID_MSK_20_BIT, status[chn]);
+			break;
+
+		case 12:
+			data->or_ur_status[chn] = no_os_field_get(AD4858_OR_UR_STATUS_MSK_20_BIT,
+						  status[chn] >> 8);
+			data->chn_id[chn] = no_os_field_get(AD4858_CHN_ID_MSK_20_BIT,
+							    status[chn] >> 8);
+			data->softspan_id[chn] = no_os_field_get(AD4858_SOFTSPAN_ID_MSK_20_BIT,
+						 status[chn] & 0xff);
+			break;
+
+		default:
+			break;
+		}
+	}
+
 	return 0;
 }
 
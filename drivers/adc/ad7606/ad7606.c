@@ -41,6 +41,7 @@
 #include "no_os_util.h"
 #include "no_os_crc.h"
 #include "no_os_alloc.h"
+#include "no_os_unpack.h"
 
 #ifdef XILINX_PLATFORM
 #include "no_os_axi_io.h"
@@ -525,60 +526,6 @@ int32_t ad7606_reg_write_mask(struct ad7606_dev *dev,
 	return ad7606_reg_write(dev, addr, reg_data);
 }
 
-/* Internal function to copy the content of a buffer in 18-bit chunks to a 32-bit buffer by
- * extending the chunks to 32-bit size. */
-static int32_t cpy18b32b(uint8_t *psrc, uint32_t srcsz, uint32_t *pdst)
-{
-	unsigned int i, j;
-
-	if (srcsz % 9)
-		return -EINVAL;
-
-	for (i = 0; i < srcsz; i += 9) {
-		j = 4 * (i / 9);
-		pdst[j + 0] = ((uint32_t)(psrc[i + 0] & 0xff) << 10) | ((
-					uint32_t)psrc[i + 1] << 2)
-			      | ((uint32_t)psrc[i + 2] >> 6);
-		pdst[j + 1] = ((uint32_t)(psrc[i + 2] & 0x3f) << 12) | ((
-					uint32_t)psrc[i + 3] << 4)
-			      | ((uint32_t)psrc[i + 4] >> 4);
-		pdst[j + 2] = ((uint32_t)(psrc[i + 4] & 0x0f) << 14) | ((
-					uint32_t)psrc[i + 5] << 6)
-			      | ((uint32_t)psrc[i + 6] >> 2);
-		pdst[j + 3] = ((uint32_t)(psrc[i + 6] & 0x03) << 16) | ((
-					uint32_t)psrc[i + 7] << 8)
-			      | ((uint32_t)psrc[i + 8] >> 0);
-	}
-	return 0;
-}
-
-/* Internal function to copy the content of a buffer in 26-bit chunks to a 32-bit buffer by
- * extending the chunks to 32-bit size. */
-static int32_t cpy26b32b(uint8_t *psrc, uint32_t srcsz, uint32_t *pdst)
-{
-	unsigned int i, j;
-
-	if (srcsz % 13)
-		return -EINVAL;
-
-	for (i = 0; i < srcsz; i += 13) {
-		j = 4 * (i / 13);
-		pdst[j + 0] = ((uint32_t)(psrc[i + 0] & 0xff) << 18) | ((
-					uint32_t)psrc[i + 1] << 10)
-			      | ((uint32_t)psrc[i + 2] << 2) | ((uint32_t)psrc[i + 3] >> 6);
-		pdst[j + 1] = ((uint32_t)(psrc[i + 3] & 0x3f) << 20) | ((
-					uint32_t)psrc[i + 4] << 12)
-			      | ((uint32_t)psrc[i + 5] << 4) | ((uint32_t)psrc[i + 6] >> 4);
-		pdst[j + 2] = ((uint32_t)(psrc[i + 6] & 0x0f) << 22) | ((
-					uint32_t)psrc[i + 7] << 14)
-			      | ((uint32_t)psrc[i + 8] << 6) | ((uint32_t)psrc[i + 9] >> 2);
-		pdst[j + 3] = ((uint32_t)(psrc[i + 9] & 0x03) << 24) | ((
-					uint32_t)psrc[i + 10] << 16)
-			      | ((uint32_t)psrc[i + 11] << 8) | ((uint32_t)psrc[i + 12] >> 0);
-	}
-	return 0;
-}
-
 /***************************************************************************//**
  * @brief Toggle the CONVST pin to start a conversion.
  *
@@ -615,6 +562,90 @@ int32_t ad7606_convst(struct ad7606_dev *dev)
 	return no_os_gpio_set_value(dev->gpio_convst, 1);
 }
 
+/***************************************************************************//**
+ * @brief Get the size of a serial conversion data frame.
+ *
+ * The frame holds one sample of each channel, with the status byte if the
+ * status header is enabled and the CRC16 if the interface CRC is enabled.
+ *
+ * @param dev        - The device structure.
+ *
+ * @return Frame size in bytes.
+*******************************************************************************/
+uint32_t ad7606_spi_frame_size(struct ad7606_dev *dev)
+{
+	uint8_t bits = ad7606_chip_info_tbl[dev->device_id].bits;
+	uint8_t sbits = dev->config.status_header ? 8 : 0;
+	uint8_t nchannels = ad7606_chip_info_tbl[dev->device_id].num_channels;
+	uint32_t sz;
+
+	sz = nchannels * (bits + sbits);
+
+	/* Number of bits to read, corresponds to SCLK cycles in transfer.
+	 * This should always be a multiple of 8 to work with most SPI's.
+	 * With this chip family this holds true because we either:
+	 *  - multiply 8 channels * bits per sample
+	 *  - multiply 4 channels * bits per sample (always multiple of 2)
+	 * Therefore, due to design reasons, we don't check for the
+	 * remainder of this division because it is zero by design.
+	 */
+	sz /= 8;
+
+	if (dev->digital_diag_enable.int_crc_err_en)
+		sz += 2;
+
+	return sz;
+}
+
+/***************************************************************************//**
+ * @brief Check and unpack a serial conversion data frame.
+ *
+ * Does the same CRC16 check as ad7606_spi_data_read(), but unpacks the
+ * samples in a single pass and sign-extends the ones of bipolar channels,
+ * so the result does not need ad7606_data_correction_serial(). If the
+ * status header is enabled, the status stays in the lowest 8 bits and the
+ * sample is sign-extended above it.
+ *
+ * @param dev        - The device structure.
+ * @param frame      - Frame of ad7606_spi_frame_size() bytes read from DOUT.
+ * @param data       - Buffer for one sample of each channel.
+ *
+ * @return ret - return code.
+ *         Example: -EBADMSG - CRC computation mismatch.
+ *                  0 - No errors encountered.
+*******************************************************************************/
+int32_t ad7606_spi_frame_decode(struct ad7606_dev *dev, const uint8_t *frame,
+				int32_t *data)
+{
+	uint8_t bits = ad7606_chip_info_tbl[dev->device_id].bits;
+	uint8_t nchannels = ad7606_chip_info_tbl[dev->device_id].num_channels;
+	struct no_os_unpack_fmt fmt = {
+		.bits = bits + (dev->config.status_header ? 8 : 0),
+		.sign = true,
+	};
+	uint32_t sz = nchannels * fmt.bits / 8;
+	uint16_t crc, icrc;
+	uint32_t i;
+	int32_t ret;
+
+	if (dev->digital_diag_enable.int_crc_err_en) {
+		crc = no_os_crc16(ad7606_crc16, frame, sz, 0);
+		icrc = ((uint16_t)frame[sz] << 8) | frame[sz + 1];
+		if (icrc != crc)
+			return -EBADMSG;
+	}
+
+	ret = no_os_unpack(&fmt, frame, nchannels, data, NULL);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < nchannels; i++)
+		if (dev->range_ch_type[i] == AD7606_SW_RANGE_SINGLE_ENDED_UNIPOLAR)
+			data[i] &= NO_OS_GENMASK(fmt.bits - 1, 0);
+
+	return 0;
+}
+
 /***************************************************************************//**
  * @brief Read conversion data.
  *
@@ -638,27 +669,15 @@ int32_t ad7606_convst(struct ad7606_dev *dev)
 int32_t ad7606_spi_data_read(struct ad7606_dev *dev, uint32_t *data)
 {
 	uint32_t sz;
-	int32_t ret, i;
+	int32_t ret;
 	uint16_t crc, icrc;
-	uint8_t bits = ad7606_chip_info_tbl[dev->device_id].bits;
-	uint8_t sbits = dev->config.status_header ? 8 : 0;
 	uint8_t nchannels = ad7606_chip_info_tbl[dev->device_id].num_channels;
+	struct no_os_unpack_fmt fmt = {
+		.bits = ad7606_chip_info_tbl[dev->device_id].bits,
+		.status_bits = dev->config.status_header ? 8 : 0,
+	};
 
-	sz = nchannels * (bits + sbits);
-
-	/* Number of bits to read, corresponds to SCLK cycles in transfer.
-	 * This should always be a multiple of 8 to work with most SPI's.
-	 * With this chip family this holds true because we either:
-	 *  - multiply 8 channels * bits per sample
-	 *  - multiply 4 channels * bits per sample (always multiple of 2)
-	 * Therefore, due to design reasons, we don't check for the
-	 * remainder of this division because it is zero by design.
-	 */
-	sz /= 8;
-
-	if (dev->digital_diag_enable.int_crc_err_en) {
-		sz += 2;
-	}
+	sz = ad7606_spi_frame_size(dev);
 
 	memset(dev->data, 0, sz);
 	ret = no_os_spi_write_and_read(dev->spi_desc, dev->data, sz);
@@ -674,33 +693,7 @@ int32_t ad7606_spi_data_read(struct ad7606_dev *dev, uint32_t *data)
 			return -EBADMSG;
 	}
 
-	switch (bits) {
-	case 18:
-		if (dev->config.status_header)
-			ret = cpy26b32b(dev->data, sz, data);
-		else
-			ret = cpy18b32b(dev->data, sz, data);
-		if (ret < 0)
-			return ret;
-		break;
-	case 16:
-		for (i = 0; i < nchannels; i++) {
-			if (dev->config.status_header) {
-				data[i] = (uint32_t)dev->data[i * 3] << 16;
-				data[i] |= (uint32_t)dev->data[i * 3 + 1] << 8;
-				data[i] |= (uint32_t)dev->data[i * 3 + 2];
-			} else {
-				data[i] = (uint32_t)dev->data[i * 2] << 8;
-				data[i] |= (uint32_t)dev->data[i * 2 + 1];
-			}
-		}
-		break;
-	default:
-		ret = -ENOTSUP;
-		break;
-	};
-
-	return ret;
+	return no_os_unpack(&fmt, dev->data, nchannels, (int32_t *)data, NULL);
 }
 
 /***************************************************************************//**
@@ -938,6 +931,18 @@ int32_t ad7606_read_one_sample(struct ad7606_dev *dev, uint32_t * data)
 	return ad7606_spi_data_read(dev, data);
 }
 
+/***************************************************************************//**
+ * @brief Get the maximum conversion time for the current oversampling ratio.
+ *
+ * @param dev        - The device structure.
+ *
+ * @return Conversion time in microseconds.
+*******************************************************************************/
+uint32_t ad7606_get_conversion_time_us(struct ad7606_dev *dev)
+{
+	return tconv_max[dev->oversampling.os_ratio];
+}
+
 /***************************************************************************//**
  * @brief Prepares buffer capture for an AXI SPI Engine or AXI Parallel interface
  *
@@ -1927,8 +1932,8 @@ error:
  * @brief correct spi read serial raw data
  *        1. sign extend for hardware/bipolar mode in case of negative value
  *        2. split data and status information into 2 arrays
- *        note: this function should be called after read a sample through spi
- *              serial interface( parallel interface not supported yet)
+ *        note: this function takes the 32-bit words of ad7606_spi_data_read()
+ *              or ad7606_read_samples(), buf is left unchanged
  *
  * @param dev          - The device structure.
  * @param buf          - pointer to data buffer read by spi.
@@ -1944,35 +1949,36 @@ error:
 int32_t ad7606_data_correction_serial(struct ad7606_dev *dev,
 				      uint32_t *buf, int32_t *data, uint8_t *status)
 {
-	uint8_t i = 0;
+	uint32_t st[AD7606_MAX_CHANNELS];
 	uint8_t num_ch = dev->num_channels;
-	uint32_t *pbuf = buf;
-	uint8_t bits = ad7606_chip_info_tbl[dev->device_id].bits;
+	struct no_os_unpack_fmt fmt = {
+		.bits = ad7606_chip_info_tbl[dev->device_id].bits,
+		.sign = true,
+	};
+	int32_t ret;
+	uint8_t i;
+
+	if (!data)
+		return -EINVAL;
 
 	if (dev->config.status_header) {
 		// validate status pointers
 		if (!status)
-			return EINVAL;
+			return -EINVAL;
 
-		for (i = 0; i < num_ch; i++) {
-			*status = (uint8_t) * pbuf | 0xff;
-			*pbuf = *pbuf >> 8;
-			pbuf++;
-			status++;
-		}
+		fmt.status_bits = 8;
 	}
 
-	// validate data pointers
-	if (!status)
-		return EINVAL;
+	ret = no_os_unpack32(&fmt, buf, num_ch, data, st);
+	if (ret)
+		return ret;
 
-	// correct negative data value
 	for (i = 0; i < num_ch; i++) {
-		// if negative value exist (hardware/bipolar)
-		if (dev->range_ch_type[i] != AD7606_SW_RANGE_SINGLE_ENDED_UNIPOLAR)
-			*data = no_os_sign_extend32(*buf, bits - 1);
-		buf++;
-		data++;
+		// only hardware/bipolar ranges hold negative values
+		if (dev->range_ch_type[i] == AD7606_SW_RANGE_SINGLE_ENDED_UNIPOLAR)
+			data[i] &= NO_OS_GENMASK(fmt.bits - 1, 0);
+		if (dev->config.status_header)
+			status[i] = st[i];
 	}
 
 	return 0;
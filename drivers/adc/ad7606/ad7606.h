@@ -456,6 +456,10 @@ int32_t ad7606_write_mask(struct ad7606_dev *dev,
 			  uint32_t val);
 int32_t ad7606_spi_data_read(struct ad7606_dev *dev,
 			     uint32_t *data);
+uint32_t ad7606_spi_frame_size(struct ad7606_dev *dev);
+int32_t ad7606_spi_frame_decode(struct ad7606_dev *dev, const uint8_t *frame,
+				int32_t *data);
+uint32_t ad7606_get_conversion_time_us(struct ad7606_dev *dev);
 int32_t ad7606_read_samples(struct ad7606_dev *dev,
 			    uint32_t *data,
 			    uint32_t samples);
@@ -0,0 +1,647 @@
+/***************************************************************************//**
+ *   @file   ad7606_capture.c
+ *   @brief  Continuous AD7606 serial capture for Linux hosts.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include <errno.h>
+#include <sched.h>
+#include <string.h>
+#include <time.h>
+#include "ad7606_capture.h"
+#include "no_os_alloc.h"
+#include "no_os_error.h"
+#include "no_os_gpio.h"
+#include "no_os_irq.h"
+#include "no_os_spi.h"
+#include "no_os_thread.h"
+#include "no_os_util.h"
+#include "linux_gpio.h"
+
+/* BUSY is high for at most 324us, at 256x oversampling */
+#define AD7606_CAPTURE_BUSY_TIMEOUT_US	1000
+
+#define AD7606_CAPTURE_NSEC_PER_SEC	1000000000ULL
+
+static uint64_t ad7606_capture_now(clockid_t clk)
+{
+	struct timespec ts;
+
+	clock_gettime(clk, &ts);
+
+	return (uint64_t)ts.tv_sec * AD7606_CAPTURE_NSEC_PER_SEC + ts.tv_nsec;
+}
+
+static void ad7606_capture_to_timespec(uint64_t ns, struct timespec *ts)
+{
+	ts->tv_sec = ns / AD7606_CAPTURE_NSEC_PER_SEC;
+	ts->tv_nsec = ns % AD7606_CAPTURE_NSEC_PER_SEC;
+}
+
+static void ad7606_capture_sleep_until(uint64_t ns)
+{
+	struct timespec ts;
+
+	ad7606_capture_to_timespec(ns, &ts);
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+		;
+}
+
+/*
+ * Start a conversion. Unlike ad7606_convst() there is no delay between the
+ * two writes, a GPIO write takes longer than the minimum CONVST low time.
+ */
+static int32_t ad7606_capture_convst(struct ad7606_capture *cap)
+{
+	int32_t ret;
+
+	ret = no_os_gpio_set_value(cap->dev->gpio_convst, NO_OS_GPIO_LOW);
+	if (ret)
+		return ret;
+
+	return no_os_gpio_set_value(cap->dev->gpio_convst, NO_OS_GPIO_HIGH);
+}
+
+/*
+ * Wait for the end of the conversion started at start_ns. A timeout of 0
+ * only checks if it ended. Without a BUSY GPIO, the conversion is assumed
+ * to end after the maximum conversion time.
+ */
+static int32_t ad7606_capture_busy_wait(struct ad7606_capture *cap,
+					uint64_t start_ns, uint32_t timeout_us)
+{
+	struct ad7606_dev *dev = cap->dev;
+	uint64_t end;
+	uint8_t busy;
+	int32_t ret;
+
+	if (cap->busy_edge)
+		return linux_gpio_edge_wait(dev->gpio_busy, timeout_us);
+
+	if (!dev->gpio_busy) {
+		end = start_ns + ad7606_get_conversion_time_us(dev) * 1000ULL;
+		if (timeout_us)
+			ad7606_capture_sleep_until(end);
+		else if (ad7606_capture_now(CLOCK_MONOTONIC) < end)
+			return -ETIMEDOUT;
+
+		return 0;
+	}
+
+	end = ad7606_capture_now(CLOCK_MONOTONIC) + timeout_us * 1000ULL;
+	do {
+		ret = no_os_gpio_get_value(dev->gpio_busy, &busy);
+		if (ret)
+			return ret;
+
+		if (busy == NO_OS_GPIO_LOW)
+			return 0;
+	} while (ad7606_capture_now(CLOCK_MONOTONIC) < end);
+
+	return -ETIMEDOUT;
+}
+
+/* Make the counters visible and, if a block was filled, hand it over. */
+static void ad7606_capture_publish(struct ad7606_capture *cap,
+				   const struct ad7606_capture_stats *stats,
+				   bool block_done)
+{
+	pthread_mutex_lock(&cap->lock);
+
+	cap->stats = *stats;
+	cap->update_ns = ad7606_capture_now(CLOCK_MONOTONIC);
+	cap->cpu_ns = ad7606_capture_now(CLOCK_THREAD_CPUTIME_ID) -
+		      cap->cpu_start;
+	if (block_done)
+		__atomic_store_n(&cap->head, cap->head + 1, __ATOMIC_RELEASE);
+
+	pthread_cond_broadcast(&cap->cond);
+	pthread_mutex_unlock(&cap->lock);
+}
+
+/*
+ * Read the frame of the last finished conversion and unpack it into the
+ * block being filled. If the read is done while the next conversion runs,
+ * it must end before BUSY falls, otherwise the frame is dropped and 1 is
+ * returned since the next conversion already ended.
+ */
+static int32_t ad7606_capture_take(struct ad7606_capture *cap,
+				   struct ad7606_capture_stats *stats,
+				   uint32_t *nframes, uint64_t conv_ns,
+				   bool during_conv)
+{
+	struct no_os_spi_msg msg = {
+		.tx_buff = cap->tx,
+		.rx_buff = cap->rx,
+		.bytes_number = cap->frame_size,
+	};
+	uint32_t tail, ch;
+	int32_t *frame, *dst;
+	int32_t ret;
+
+	tail = __atomic_load_n(&cap->tail, __ATOMIC_ACQUIRE);
+	if (cap->head - tail == cap->nb_blocks) {
+		stats->overflows++;
+		stats->dropped++;
+		return 0;
+	}
+
+	ret = no_os_spi_transfer(cap->dev->spi_desc, &msg, 1);
+	if (ret)
+		return ret;
+
+	if (during_conv) {
+		ret = ad7606_capture_busy_wait(cap, conv_ns, 0);
+		if (!ret) {
+			stats->late_reads++;
+			stats->dropped++;
+			return 1;
+		}
+		if (ret != -ETIMEDOUT)
+			return ret;
+	}
+
+	dst = cap->blocks + ((cap->head % cap->nb_blocks) * cap->block_frames +
+			     *nframes) * cap->frame_len;
+	frame = cap->frame_len == cap->nb_channels ? dst : cap->frame;
+	ret = ad7606_spi_frame_decode(cap->dev, cap->rx, frame);
+	if (ret == -EBADMSG) {
+		stats->crc_errors++;
+		stats->dropped++;
+		return 0;
+	}
+	if (ret)
+		return ret;
+
+	if (frame != dst) {
+		for (ch = 0; ch < cap->nb_channels; ch++)
+			if (cap->channel_mask & NO_OS_BIT(ch))
+				*dst++ = frame[ch];
+	}
+
+	stats->frames++;
+	if (++(*nframes) == cap->block_frames) {
+		*nframes = 0;
+		ad7606_capture_publish(cap, stats, true);
+	}
+
+	return 0;
+}
+
+static void ad7606_capture_thread(void *arg)
+{
+	struct ad7606_capture *cap = arg;
+	struct ad7606_capture_stats stats = { 0 };
+	struct sched_param sp;
+	uint64_t next, now, conv_ns, n;
+	uint32_t nframes = 0;
+	bool pending = false;
+	int32_t ret = 0;
+
+	if (cap->rt_priority) {
+		sp.sched_priority = cap->rt_priority;
+		pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp);
+	}
+
+	cap->cpu_start = ad7606_capture_now(CLOCK_THREAD_CPUTIME_ID);
+	next = ad7606_capture_now(CLOCK_MONOTONIC);
+
+	while (__atomic_load_n(&cap->running, __ATOMIC_RELAXED)) {
+		ad7606_capture_sleep_until(next);
+
+		/* Conversions that should have started while we were late */
+		now = ad7606_capture_now(CLOCK_MONOTONIC);
+		if (now - next >= cap->period_ns) {
+			n = (now - next) / cap->period_ns;
+			stats.missed += n;
+			stats.dropped += n;
+			next += n * cap->period_ns;
+		}
+		next += cap->period_ns;
+
+		conv_ns = now;
+		ret = ad7606_capture_convst(cap);
+		if (ret)
+			break;
+
+		if (pending) {
+			/* Read frame k while conversion k + 1 runs */
+			pending = false;
+			ret = ad7606_capture_take(cap, &stats, &nframes,
+						  conv_ns, true);
+			if (ret < 0)
+				break;
+			if (ret) {
+				pending = true;
+				continue;
+			}
+		}
+
+		ret = ad7606_capture_busy_wait(cap, conv_ns,
+					       AD7606_CAPTURE_BUSY_TIMEOUT_US);
+		if (ret == -ETIMEDOUT) {
+			stats.busy_timeouts++;
+			stats.dropped++;
+			continue;
+		}
+		if (ret)
+			break;
+
+		if (cap->read_during_conv) {
+			pending = true;
+			continue;
+		}
+
+		ret = ad7606_capture_take(cap, &stats, &nframes, conv_ns,
+					  false);
+		if (ret < 0)
+			break;
+	}
+
+	/* The partially filled block is dropped */
+	cap->error = ret < 0 ? ret : 0;
+	__atomic_store_n(&cap->running, false, __ATOMIC_RELAXED);
+	ad7606_capture_publish(cap, &stats, false);
+}
+
+/***************************************************************************//**
+ * @brief Set up continuous capture.
+ *
+ * CONVST is toggled by a capture thread at the requested rate and the end of
+ * the conversion is waited on the BUSY falling edge, or by polling BUSY if
+ * the GPIO does not support edges. The frames are unpacked, sign-extended
+ * and written to a queue of blocks read with ad7606_capture_get_block().
+ * The queue is allocated here, ad7606_capture_set_buffer() can place it in
+ * memory owned by the caller instead. The device configuration must not
+ * change while capturing.
+ *
+ * @param capture - The capture descriptor.
+ * @param dev     - The device structure, using the serial interface.
+ * @param param   - Capture parameters.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int32_t ad7606_capture_init(struct ad7606_capture **capture,
+			    struct ad7606_dev *dev,
+			    const struct ad7606_capture_init_param *param)
+{
+	struct ad7606_capture *cap;
+	pthread_condattr_t attr;
+	int32_t ret;
+
+	if (!capture || !dev || !param || !param->rate_hz ||
+	    !param->block_frames || !param->nb_blocks)
+		return -EINVAL;
+
+	if (dev->parallel_interface || !dev->gpio_convst)
+		return -ENOTSUP;
+
+	cap = no_os_calloc(1, sizeof(*cap));
+	if (!cap)
+		return -ENOMEM;
+
+	cap->dev = dev;
+	cap->period_ns = AD7606_CAPTURE_NSEC_PER_SEC / param->rate_hz;
+	cap->frame_size = ad7606_spi_frame_size(dev);
+	cap->nb_channels = ad7606_get_channels_number(dev);
+	cap->block_frames = param->block_frames;
+	cap->nb_blocks = param->nb_blocks;
+	cap->channel_mask = NO_OS_GENMASK(cap->nb_channels - 1, 0);
+	cap->frame_len = cap->nb_channels;
+	cap->queue_frames = param->block_frames;
+	cap->queue_blocks = param->nb_blocks;
+	cap->read_during_conv = param->read_during_conv;
+	cap->rt_priority = param->rt_priority;
+
+	ret = -ENOMEM;
+	cap->queue = no_os_calloc((size_t)cap->nb_blocks * cap->block_frames *
+				  cap->nb_channels, sizeof(*cap->queue));
+	if (!cap->queue)
+		goto error;
+	cap->blocks = cap->queue;
+
+	cap->frame = no_os_calloc(cap->nb_channels, sizeof(*cap->frame));
+	if (!cap->frame)
+		goto error;
+
+	cap->tx = no_os_calloc(cap->frame_size, 1);
+	if (!cap->tx)
+		goto error;
+
+	cap->rx = no_os_calloc(cap->frame_size, 1);
+	if (!cap->rx)
+		goto error;
+
+	if (dev->gpio_busy)
+		cap->busy_edge = !linux_gpio_edge_enable(dev->gpio_busy,
+				 NO_OS_IRQ_EDGE_FALLING);
+
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_init(&cap->cond, &attr);
+	pthread_condattr_destroy(&attr);
+	pthread_mutex_init(&cap->lock, NULL);
+
+	*capture = cap;
+
+	return 0;
+
+error:
+	no_os_free(cap->rx);
+	no_os_free(cap->tx);
+	no_os_free(cap->frame);
+	no_os_free(cap->queue);
+	no_os_free(cap);
+
+	return ret;
+}
+
+/***************************************************************************//**
+ * @brief Place the block queue in memory owned by the caller.
+ *
+ * The frames are written straight to mem, keeping only the samples of the
+ * channels in channel_mask, in channel order. This lets a consumer such as
+ * an IIO buffer be filled without copying the blocks. The memory must stay
+ * valid until the capture is stopped. A NULL mem goes back to the queue
+ * allocated by ad7606_capture_init().
+ *
+ * @param capture      - The capture descriptor.
+ * @param mem          - Storage for nb_blocks * block_frames frames of 32 bit
+ *                       samples, NULL for the allocated queue.
+ * @param nb_blocks    - Blocks in mem.
+ * @param block_frames - Frames in a block.
+ * @param channel_mask - Channels stored in each frame.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int32_t ad7606_capture_set_buffer(struct ad7606_capture *capture, void *mem,
+				  uint32_t nb_blocks, uint32_t block_frames,
+				  uint32_t channel_mask)
+{
+	uint32_t all;
+
+	if (!capture)
+		return -EINVAL;
+
+	if (capture->thread)
+		return -EBUSY;
+
+	all = NO_OS_GENMASK(capture->nb_channels - 1, 0);
+	if (!mem) {
+		capture->blocks = capture->queue;
+		capture->nb_blocks = capture->queue_blocks;
+		capture->block_frames = capture->queue_frames;
+		capture->channel_mask = all;
+		capture->frame_len = capture->nb_channels;
+
+		return 0;
+	}
+
+	channel_mask &= all;
+	if (!nb_blocks || !block_frames || !channel_mask)
+		return -EINVAL;
+
+	capture->blocks = mem;
+	capture->nb_blocks = nb_blocks;
+	capture->block_frames = block_frames;
+	capture->channel_mask = channel_mask;
+	capture->frame_len = no_os_hweight32(channel_mask);
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Start continuous capture.
+ *
+ * The queue and the counters are reset.
+ *
+ * @param capture - The capture descriptor.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int32_t ad7606_capture_start(struct ad7606_capture *capture)
+{
+	struct ad7606_dev *dev;
+	int32_t ret;
+
+	if (!capture)
+		return -EINVAL;
+
+	if (capture->thread)
+		return -EBUSY;
+
+	dev = capture->dev;
+	if (dev->reg_mode) {
+		/* Enter ADC reading mode by writing at address zero. */
+		ret = ad7606_reg_write(dev, 0, 0);
+		if (ret)
+			return ret;
+
+		dev->reg_mode = false;
+	}
+
+	memset(&capture->stats, 0, sizeof(capture->stats));
+	capture->head = 0;
+	capture->tail = 0;
+	capture->error = 0;
+	capture->cpu_ns = 0;
+	capture->start_ns = ad7606_capture_now(CLOCK_MONOTONIC);
+	capture->update_ns = capture->start_ns;
+	capture->running = true;
+
+	ret = no_os_thread_create(&capture->thread, ad7606_capture_thread,
+				  capture);
+	if (ret) {
+		capture->running = false;
+		capture->thread = NULL;
+	}
+
+	return ret;
+}
+
+/***************************************************************************//**
+ * @brief Stop continuous capture.
+ *
+ * Blocks filled before the stop can still be read.
+ *
+ * @param capture - The capture descriptor.
+ *
+ * @return 0 in case of success, the error that stopped the capture thread
+ *         otherwise.
+*******************************************************************************/
+int32_t ad7606_capture_stop(struct ad7606_capture *capture)
+{
+	int32_t ret;
+
+	if (!capture)
+		return -EINVAL;
+
+	if (!capture->thread)
+		return 0;
+
+	__atomic_store_n(&capture->running, false, __ATOMIC_RELAXED);
+	ret = no_os_thread_join(capture->thread);
+	capture->thread = NULL;
+	if (ret)
+		return ret;
+
+	return capture->error;
+}
+
+/***************************************************************************//**
+ * @brief Wait for a filled block.
+ *
+ * A block holds block_frames frames of frame_len samples each. The same
+ * block is returned until it is released with ad7606_capture_put_block().
+ *
+ * @param capture    - The capture descriptor.
+ * @param block      - Filled block.
+ * @param timeout_ms - Time to wait for a block.
+ *
+ * @return 0 in case of success, -ETIMEDOUT if no block was filled in time,
+ *         -ENODATA if the capture is stopped and all blocks were read, other
+ *         negative error code otherwise.
+*******************************************************************************/
+int32_t ad7606_capture_get_block(struct ad7606_capture *capture,
+				 int32_t **block, uint32_t timeout_ms)
+{
+	struct timespec ts;
+	uint32_t tail;
+	int32_t ret = 0;
+
+	if (!capture || !block)
+		return -EINVAL;
+
+	ad7606_capture_to_timespec(ad7606_capture_now(CLOCK_MONOTONIC) +
+				   timeout_ms * 1000000ULL, &ts);
+	tail = capture->tail;
+
+	pthread_mutex_lock(&capture->lock);
+	while (__atomic_load_n(&capture->head, __ATOMIC_ACQUIRE) == tail) {
+		if (!__atomic_load_n(&capture->running, __ATOMIC_RELAXED)) {
+			ret = capture->error ? capture->error : -ENODATA;
+			break;
+		}
+
+		if (pthread_cond_timedwait(&capture->cond, &capture->lock,
+					   &ts) == ETIMEDOUT) {
+			ret = -ETIMEDOUT;
+			break;
+		}
+	}
+	pthread_mutex_unlock(&capture->lock);
+
+	if (ret)
+		return ret;
+
+	*block = capture->blocks + (tail % capture->nb_blocks) *
+		 capture->block_frames * capture->frame_len;
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Release the block returned by ad7606_capture_get_block().
+ *
+ * @param capture - The capture descriptor.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int32_t ad7606_capture_put_block(struct ad7606_capture *capture)
+{
+	if (!capture)
+		return -EINVAL;
+
+	if (__atomic_load_n(&capture->head, __ATOMIC_ACQUIRE) == capture->tail)
+		return -EINVAL;
+
+	__atomic_store_n(&capture->tail, capture->tail + 1, __ATOMIC_RELEASE);
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Get the capture counters.
+ *
+ * The counters are updated once per block and when the capture stops. The
+ * rate and the CPU load are averaged since the capture started.
+ *
+ * @param capture - The capture descriptor.
+ * @param stats   - Counters.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int32_t ad7606_capture_get_stats(struct ad7606_capture *capture,
+				 struct ad7606_capture_stats *stats)
+{
+	uint64_t elapsed;
+
+	if (!capture || !stats)
+		return -EINVAL;
+
+	pthread_mutex_lock(&capture->lock);
+
+	*stats = capture->stats;
+	elapsed = capture->update_ns - capture->start_ns;
+	if (elapsed) {
+		stats->rate_hz = stats->frames * AD7606_CAPTURE_NSEC_PER_SEC /
+				 elapsed;
+		stats->cpu_load = capture->cpu_ns * 100 / elapsed;
+	}
+
+	pthread_mutex_unlock(&capture->lock);
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Free the resources allocated by ad7606_capture_init().
+ *
+ * @param capture - The capture descriptor.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int32_t ad7606_capture_remove(struct ad7606_capture *capture)
+{
+	if (!capture)
+		return -EINVAL;
+
+	ad7606_capture_stop(capture);
+
+	pthread_cond_destroy(&capture->cond);
+	pthread_mutex_destroy(&capture->lock);
+	no_os_free(capture->rx);
+	no_os_free(capture->tx);
+	no_os_free(capture->frame);
+	no_os_free(capture->queue);
+	no_os_free(capture);
+
+	return 0;
+}
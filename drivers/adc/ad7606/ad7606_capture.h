@@ -0,0 +1,176 @@
+/***************************************************************************//**
+ *   @file   ad7606_capture.h
+ *   @brief  Continuous AD7606 serial capture for Linux hosts.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#ifndef AD7606_CAPTURE_H_
+#define AD7606_CAPTURE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "ad7606.h"
+
+/**
+ * @struct ad7606_capture_init_param
+ * @brief Continuous capture parameters
+ */
+struct ad7606_capture_init_param {
+	/** Conversion rate in Hz */
+	uint32_t rate_hz;
+	/** Number of frames (one sample of each channel) in a block */
+	uint32_t block_frames;
+	/** Number of blocks in the queue */
+	uint32_t nb_blocks;
+	/** Read frame k while conversion k + 1 runs. Only use it when the
+	 *  conversion time is longer than reading a frame, late reads are
+	 *  dropped. */
+	bool read_during_conv;
+	/** SCHED_FIFO priority of the capture thread, 0 keeps the default */
+	int rt_priority;
+};
+
+/**
+ * @struct ad7606_capture_stats
+ * @brief Continuous capture counters
+ */
+struct ad7606_capture_stats {
+	/** Frames written to the queue */
+	uint64_t frames;
+	/** Frames lost, sum of the counters below */
+	uint64_t dropped;
+	/** Conversions not started because the thread was late */
+	uint64_t missed;
+	/** Frames dropped because the queue was full */
+	uint64_t overflows;
+	/** Frames dropped because BUSY fell before they were read */
+	uint64_t late_reads;
+	/** Frames dropped because of a CRC mismatch */
+	uint64_t crc_errors;
+	/** Conversions that did not end in time */
+	uint64_t busy_timeouts;
+	/** Achieved frame rate in Hz */
+	uint32_t rate_hz;
+	/** CPU time of the capture thread, in percent of one CPU */
+	uint32_t cpu_load;
+};
+
+/**
+ * @struct ad7606_capture
+ * @brief Continuous capture descriptor
+ */
+struct ad7606_capture {
+	/** Device */
+	struct ad7606_dev *dev;
+	/** Capture thread */
+	void *thread;
+	/** Conversion period in ns */
+	uint64_t period_ns;
+	/** Frame size in bytes, as read from DOUT */
+	uint32_t frame_size;
+	/** Number of channels */
+	uint32_t nb_channels;
+	/** Frames in a block */
+	uint32_t block_frames;
+	/** Blocks in the queue */
+	uint32_t nb_blocks;
+	/** Queue storage, nb_blocks * block_frames * frame_len samples */
+	int32_t *blocks;
+	/** Channels stored in the blocks */
+	uint32_t channel_mask;
+	/** Samples stored per frame, one for each channel in channel_mask */
+	uint32_t frame_len;
+	/** Storage allocated by ad7606_capture_init(), all channels */
+	int32_t *queue;
+	/** Frames in a block of the allocated storage */
+	uint32_t queue_frames;
+	/** Blocks of the allocated storage */
+	uint32_t queue_blocks;
+	/** Decoded frame, when only some of the channels are stored */
+	int32_t *frame;
+	/** Blocks filled by the capture thread */
+	uint32_t head;
+	/** Blocks released by the reader */
+	uint32_t tail;
+	/** Zeroes sent on SDI while reading a frame */
+	uint8_t *tx;
+	/** Raw frame */
+	uint8_t *rx;
+	/** BUSY falling edge can be waited for */
+	bool busy_edge;
+	/** See ad7606_capture_init_param */
+	bool read_during_conv;
+	/** See ad7606_capture_init_param */
+	int rt_priority;
+	/** Cleared to stop the capture thread */
+	bool running;
+	/** Error that stopped the capture thread */
+	int32_t error;
+	/** Capture start, CLOCK_MONOTONIC ns */
+	uint64_t start_ns;
+	/** Last update of stats, CLOCK_MONOTONIC ns */
+	uint64_t update_ns;
+	/** CPU time of the capture thread at the last update */
+	uint64_t cpu_ns;
+	/** CPU time of the capture thread when it started */
+	uint64_t cpu_start;
+	/** Counters, updated by the capture thread once per block */
+	struct ad7606_capture_stats stats;
+	/** Protects stats and signals new blocks */
+	pthread_mutex_t lock;
+	/** Signaled when a block is filled */
+	pthread_cond_t cond;
+};
+
+/* Allocate the block queue and set up the BUSY edge */
+int32_t ad7606_capture_init(struct ad7606_capture **capture,
+			    struct ad7606_dev *dev,
+			    const struct ad7606_capture_init_param *param);
+/* Write the blocks to the given memory, keeping only some channels */
+int32_t ad7606_capture_set_buffer(struct ad7606_capture *capture, void *mem,
+				  uint32_t nb_blocks, uint32_t block_frames,
+				  uint32_t channel_mask);
+/* Start the capture thread */
+int32_t ad7606_capture_start(struct ad7606_capture *capture);
+/* Stop the capture thread, filled blocks can still be read */
+int32_t ad7606_capture_stop(struct ad7606_capture *capture);
+/* Wait for a filled block */
+int32_t ad7606_capture_get_block(struct ad7606_capture *capture,
+				 int32_t **block, uint32_t timeout_ms);
+/* Give back the block returned by ad7606_capture_get_block() */
+int32_t ad7606_capture_put_block(struct ad7606_capture *capture);
+/* Get the capture counters, rate and CPU load */
+int32_t ad7606_capture_get_stats(struct ad7606_capture *capture,
+				 struct ad7606_capture_stats *stats);
+/* Free the resources allocated by ad7606_capture_init() */
+int32_t ad7606_capture_remove(struct ad7606_capture *capture);
+
+#endif /* AD7606_CAPTURE_H_ */
@@ -20,6 +20,11 @@
 #include "no_os_util.h"
 #include "no_os_alloc.h"
 #include "no_os_error.h"
+#ifdef LINUX_PLATFORM
+#include "ad7606_capture.h"
+
+#define AD7606_IIO_CAPTURE_TIMEOUT_MS	1000
+#endif
 
 #define AD7606_CH(_idx, bits) {\
 	.name = "voltage" #_idx, \
@@ -296,6 +301,15 @@ static int32_t iio_ad7606_pre_enable(void *dev, uint32_t mask)
 {
 	struct ad7606_iio_dev *iio_dev = dev;
 
+#ifdef LINUX_PLATFORM
+	/* The capture starts on the first refill, once the buffer is known */
+	if (iio_dev->capture) {
+		iio_dev->capture_block = NULL;
+		iio_dev->capture_running = false;
+		return 0;
+	}
+#endif
+
 	return ad7606_capture_pre_enable(iio_dev->ad7606_dev);
 }
 
@@ -308,11 +322,83 @@ static int32_t iio_ad7606_post_disable(void *dev)
 {
 	struct ad7606_iio_dev *iio_dev = dev;
 
+#ifdef LINUX_PLATFORM
+	int32_t ret;
+
+	if (iio_dev->capture) {
+		ret = ad7606_capture_stop(iio_dev->capture);
+		iio_dev->capture_running = false;
+		iio_dev->capture_block = NULL;
+		ad7606_capture_set_buffer(iio_dev->capture, NULL, 0, 0, 0);
+
+		return ret;
+	}
+#endif
+
 	ad7606_capture_post_disable(iio_dev->ad7606_dev);
 
 	return 0;
 }
 
+#ifdef LINUX_PLATFORM
+/**
+ * @brief	Publish the next block filled by the continuous capture
+ *
+ * The capture writes the enabled channels straight into the buffer memory,
+ * one IIO block per capture block. On the first refill it is started on
+ * that memory, later refills release the block published by the previous
+ * one, which has been read by then.
+ *
+ * @param	iio_dev - Pointer to AD7606 IIO device
+ * @param	buffer - IIO buffer
+ * @return	0 in case of success, negative error code otherwise
+ */
+static int32_t iio_ad7606_submit_capture(struct ad7606_iio_dev *iio_dev,
+		struct iio_buffer *buffer)
+{
+	struct ad7606_capture *cap = iio_dev->capture;
+	int32_t *block;
+	void *buff;
+	int32_t ret;
+
+	if (!iio_dev->capture_running) {
+		if (buffer->dir != IIO_DIRECTION_INPUT || !buffer->size ||
+		    buffer->buf->write.idx)
+			return -EINVAL;
+
+		ret = ad7606_capture_set_buffer(cap, buffer->buf->buff,
+						buffer->buf->size / buffer->size,
+						buffer->samples,
+						buffer->active_mask);
+		if (ret)
+			return ret;
+
+		ret = ad7606_capture_start(cap);
+		if (ret)
+			return ret;
+
+		iio_dev->capture_running = true;
+	} else if (iio_dev->capture_block) {
+		ad7606_capture_put_block(cap);
+		iio_dev->capture_block = NULL;
+	}
+
+	ret = ad7606_capture_get_block(cap, &block,
+				       AD7606_IIO_CAPTURE_TIMEOUT_MS);
+	if (ret)
+		return ret;
+
+	iio_dev->capture_block = block;
+
+	/* Blocks tile the buffer, so the write index follows the capture. */
+	ret = iio_buffer_get_block(buffer, &buff);
+	if (ret)
+		return ret;
+
+	return iio_buffer_block_done(buffer);
+}
+#endif
+
 /**
  * @brief	Read buffer data corresponding to AD7606 IIO device
  * @param	iio_dev_data - Pointer to IIO device data structure
@@ -330,6 +416,11 @@ static int32_t iio_ad7606_submit_buffer(struct iio_device_data *iio_dev_data)
 	uint32_t i, j, k;
 	int32_t ret;
 
+#ifdef LINUX_PLATFORM
+	if (iio_dev->capture)
+		return iio_ad7606_submit_capture(iio_dev, buffer);
+#endif
+
 	ret = iio_buffer_get_block(buffer, &buff);
 	if (ret)
 		return ret;
@@ -19,10 +19,19 @@
 #include "iio_types.h"
 #include "ad7606.h"
 
+struct ad7606_capture;
+
 struct ad7606_iio_dev {
 	struct ad7606_dev *ad7606_dev;
 	struct iio_device *iio_dev;
 	int sign_bit;
+	/* Continuous capture feeding the buffer (Linux), set by the
+	 * application. NULL to read the samples on demand. */
+	struct ad7606_capture *capture;
+	/* Capture block published to the buffer, released on the next refill */
+	int32_t *capture_block;
+	/* The capture fills the buffer memory */
+	bool capture_running;
 };
 
 /* Init the IIO interface */
@@ -829,12 +829,14 @@ static int32_t ad9081_spi_xfer(void *user_data, uint8_t *in_data,
 			       uint8_t *out_data, uint32_t size_bytes)
 {
 	struct ad9081_phy *phy = user_data;
-	uint8_t data[6];
+	uint8_t data[2 + AD9081_HAL_STREAM_MAX];
 	uint16_t bytes_number;
 	int32_t ret;
 	int32_t i;
 
 	bytes_number = (size_bytes & 0xFF);
+	if (bytes_number > sizeof(data))
+		return -1;
 
 	if (phy->ad9081.hal_info.msb == SPI_MSB_FIRST) {
 		for (i = 0; i < bytes_number; i++)
@@ -1419,6 +1421,7 @@ int32_t ad9081_init(struct ad9081_phy **dev,
 	struct ad9081_jesd204_priv *priv;
 	adi_cms_chip_id_t chip_id;
 	struct ad9081_phy *phy;
+	struct no_os_time t0, t1;
 	uint8_t api_rev[3];
 	int32_t ret;
 
@@ -1456,6 +1459,14 @@ int32_t ad9081_init(struct ad9081_phy **dev,
 	phy->ad9081.hal_info.addr_inc = SPI_ADDR_INC_AUTO;
 	phy->ad9081.hal_info.spi_xfer = ad9081_spi_xfer;
 	phy->ad9081.hal_info.log_write = ad9081_log_write;
+#if AD9081_USE_SPI_CACHE > 0
+	phy->ad9081.hal_info.cache = no_os_calloc(1,
+				     sizeof(*phy->ad9081.hal_info.cache));
+	if (!phy->ad9081.hal_info.cache) {
+		ret = -ENOMEM;
+		goto error_3;
+	}
+#endif
 
 	phy->ad9081.serdes_info = (adi_ad9081_serdes_settings_t) {
 		.ser_settings = { /* txfe jtx */
@@ -1538,11 +1549,32 @@ int32_t ad9081_init(struct ad9081_phy **dev,
 		goto error_3;
 	}
 
+	t0 = no_os_get_time();
+#if AD9081_USE_SPI_CACHE > 0
+	/* Queue setup writes, they are flushed on delays, polls and resets */
+	adi_ad9081_hal_batch_begin(&phy->ad9081);
+#endif
 	ret = ad9081_setup(phy);
+#if AD9081_USE_SPI_CACHE > 0
+	if (adi_ad9081_hal_batch_commit(&phy->ad9081) != API_CMS_ERROR_OK &&
+	    ret >= 0)
+		ret = -EIO;
+#endif
 	if (ret < 0) {
 		printf("%s: ad9081_setup failed (%"PRId32")\n", __func__, ret);
 		goto error_3;
 	}
+	t1 = no_os_get_time();
+	pr_info("%s: setup took %u ms\n", __func__,
+		(t1.s - t0.s) * 1000 + t1.us / 1000 - t0.us / 1000);
+#if AD9081_USE_SPI_CACHE > 0
+	pr_debug("%s: setup took %"PRIu32" SPI transfers, %"PRIu32
+		 " cache hits\n", __func__, phy->ad9081.hal_info.xfer_cnt,
+		 phy->ad9081.hal_info.cache->hit_cnt);
+#else
+	pr_debug("%s: setup took %"PRIu32" SPI transfers\n", __func__,
+		 phy->ad9081.hal_info.xfer_cnt);
+#endif
 
 	ret = jesd204_dev_register(&phy->jdev, &jesd204_ad9081_init);
 	if (ret < 0)
@@ -1567,6 +1599,7 @@ error_3:
 error_2:
 	no_os_gpio_remove(phy->gpio_reset);
 error_1:
+	no_os_free(phy->ad9081.hal_info.cache);
 	no_os_free(phy);
 
 	return ret;
@@ -1583,6 +1616,7 @@ int32_t ad9081_remove(struct ad9081_phy *dev)
 
 	ret = no_os_gpio_remove(dev->gpio_reset);
 	ret += no_os_spi_remove(dev->spi_desc);
+	no_os_free(dev->ad9081.hal_info.cache);
 	no_os_free(dev);
 
 	return ret;
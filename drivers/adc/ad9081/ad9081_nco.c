@@ -0,0 +1,526 @@
+/***************************************************************************//**
+ *   @file   ad9081_nco.c
+ *   @brief  AD9081 NCO frequency hopping plan.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include "adi_ad9081_hal.h"
+#include "ad9081_nco.h"
+
+#define AD9081_NCO_FTW48_MASK	0xFFFFFFFFFFFFULL
+
+/* Page registers tracked in ad9081_nco_plan.pages */
+#define AD9081_NCO_PAGE_DAC	NO_OS_BIT(0)
+#define AD9081_NCO_PAGE_CHAN	NO_OS_BIT(1)
+#define AD9081_NCO_PAGE_CDDC	NO_OS_BIT(2)
+#define AD9081_NCO_PAGE_FDDC	NO_OS_BIT(3)
+
+static void ad9081_nco_put48(uint8_t *buf, uint64_t val)
+{
+	uint8_t i;
+
+	for (i = 0; i < 6; i++)
+		buf[i] = (val >> (8 * i)) & 0xFF;
+}
+
+/* All fine DDCs in the plan must run at the same rate to share a FTW. */
+static int ad9081_nco_fddc_rate(struct ad9081_nco_plan *plan,
+				uint64_t *rate_hz)
+{
+	adi_ad9081_device_t *dev = plan->dev;
+	uint8_t i, fddc, cddc, dcm, c2r;
+	uint64_t rate;
+	int ret;
+
+	*rate_hz = 0;
+	for (i = 0; i < 8; i++) {
+		fddc = plan->fddcs & (AD9081_ADC_FDDC_0 << i);
+		if (!fddc)
+			continue;
+
+		ret = adi_ad9081_adc_xbar_find_cddc(dev, fddc, &cddc);
+		if (ret)
+			return ret;
+		ret = adi_ad9081_adc_ddc_coarse_select_set(dev, cddc);
+		if (ret)
+			return ret;
+		ret = adi_ad9081_hal_bf_get(dev, REG_COARSE_DEC_CTRL_ADDR,
+					    BF_COARSE_DEC_SEL_INFO, &dcm, 1);
+		if (ret)
+			return ret;
+		ret = adi_ad9081_hal_bf_get(dev, REG_COARSE_DEC_CTRL_ADDR,
+					    BF_COARSE_C2R_EN_INFO, &c2r, 1);
+		if (ret)
+			return ret;
+
+		rate = dev->dev_info.adc_freq_hz /
+		       adi_ad9081_adc_ddc_coarse_dcm_decode(dcm);
+		if (c2r)
+			rate *= 2;
+		if (*rate_hz && *rate_hz != rate)
+			return -EINVAL;
+		*rate_hz = rate;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Compute the tuning words of every hop.
+ *
+ * The FTWs are computed the same way as adi_ad9081_dac_duc_nco_set(),
+ * adi_ad9081_adc_ddc_coarse_nco_set() and adi_ad9081_adc_ddc_fine_nco_set(),
+ * reading the interpolation and decimation settings once. The device must be
+ * set up before calling this.
+ * @param plan - The plan structure.
+ * @param init_param - The structure that contains the plan parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ad9081_nco_plan_init(struct ad9081_nco_plan **plan,
+			 const struct ad9081_nco_plan_init_param *init_param)
+{
+	const struct ad9081_nco_hop *hop;
+	struct ad9081_nco_plan *p;
+	adi_ad9081_device_t *dev;
+	uint64_t dac_hz, adc_hz;
+	uint64_t fddc_rate = 0;
+	uint8_t main_interp = 0;
+	uint64_t ftw;
+	uint8_t i;
+	int ret;
+
+	if (!plan || !init_param || !init_param->dev || !init_param->hops)
+		return -EINVAL;
+	if (!init_param->num_hops ||
+	    init_param->num_hops > AD9081_NCO_HOPS_MAX)
+		return -EINVAL;
+	if ((init_param->cddcs || init_param->fddcs) &&
+	    init_param->num_hops > AD9081_NCO_DDC_HOPS_MAX)
+		return -EINVAL;
+	if (init_param->hopf_mode > 2)
+		return -EINVAL;
+	/* The channel NCOs have no hop table, they are retuned over SPI */
+	if (init_param->trig == AD9081_NCO_TRIG_GPIO && init_param->dac_chans)
+		return -EINVAL;
+
+	dev = init_param->dev;
+	if ((init_param->dacs || init_param->dac_chans) &&
+	    !dev->dev_info.dac_freq_hz)
+		return -EINVAL;
+	if ((init_param->cddcs || init_param->fddcs) &&
+	    !dev->dev_info.adc_freq_hz)
+		return -EINVAL;
+
+	p = no_os_calloc(1, sizeof(*p));
+	if (!p)
+		return -ENOMEM;
+
+	p->dev = dev;
+	p->dacs = init_param->dacs;
+	p->dac_chans = init_param->dac_chans;
+	p->cddcs = init_param->cddcs;
+	p->fddcs = init_param->fddcs;
+	p->hopf_mode = init_param->hopf_mode;
+	p->trig = init_param->trig;
+	p->num_hops = init_param->num_hops;
+	p->cur = -1;
+
+	if (p->dac_chans) {
+		ret = adi_ad9081_hal_bf_get(dev, REG_INTRP_MODE_ADDR,
+					    BF_FINE_INTERP_SEL_INFO,
+					    &main_interp, 1);
+		if (ret)
+			goto error;
+	}
+
+	if (p->fddcs) {
+		ret = ad9081_nco_fddc_rate(p, &fddc_rate);
+		if (ret)
+			goto error;
+	}
+
+	dac_hz = dev->dev_info.dac_freq_hz;
+	adc_hz = dev->dev_info.adc_freq_hz;
+	for (i = 0; i < p->num_hops; i++) {
+		hop = &init_param->hops[i];
+		if (p->dacs) {
+			ret = adi_ad9081_hal_calc_tx_nco_ftw32(dev, dac_hz,
+							       hop->dac_hz,
+							       &ftw);
+			if (ret)
+				goto error;
+			p->dac_ftw[i] = ftw;
+		}
+		if (p->dac_chans) {
+			ret = adi_ad9081_hal_calc_tx_nco_ftw(dev, dac_hz,
+							     hop->dac_chan_hz *
+							     main_interp,
+							     &p->chan_ftw[i]);
+			if (ret)
+				goto error;
+		}
+		if (p->cddcs) {
+			ret = adi_ad9081_hal_calc_rx_nco_ftw(dev, adc_hz,
+							     hop->cddc_hz,
+							     &p->cddc_ftw[i]);
+			if (ret)
+				goto error;
+		}
+		if (p->fddcs) {
+			ret = adi_ad9081_hal_calc_tx_nco_ftw(dev, fddc_rate,
+							     hop->fddc_hz,
+							     &p->fddc_ftw[i]);
+			if (ret)
+				goto error;
+		}
+	}
+
+	*plan = p;
+
+	return 0;
+
+error:
+	no_os_free(p);
+
+	return ret;
+}
+
+/*
+ * Write every profile of a coarse or fine DDC NCO. The profile update index
+ * shares a byte with the update mode, the index and the phase increment are
+ * written in one burst, the (unused) modulus in a second one.
+ */
+static int ad9081_nco_ddc_load(struct ad9081_nco_plan *plan, bool fine)
+{
+	adi_ad9081_device_t *dev = plan->dev;
+	uint32_t ctrl_reg, frac_reg, offset_reg;
+	uint8_t buf[13] = { 0 };
+	uint64_t *ftws;
+	uint8_t ctrl;
+	uint8_t i;
+	int ret;
+
+	if (fine) {
+		ret = adi_ad9081_adc_ddc_fine_select_set(dev, plan->fddcs);
+		ctrl_reg = REG_FINE_DDC_PROFILE_CTRL_ADDR;
+		frac_reg = REG_FINE_DDC_PHASE_INC_FRAC_A0_ADDR;
+		ftws = plan->fddc_ftw;
+	} else {
+		ret = adi_ad9081_adc_ddc_coarse_select_set(dev, plan->cddcs);
+		ctrl_reg = REG_COARSE_DDC_PROFILE_CTRL_ADDR;
+		frac_reg = REG_COARSE_DDC_PHASE_INC_FRAC_A0_ADDR;
+		ftws = plan->cddc_ftw;
+	}
+	if (ret)
+		return ret;
+
+	ret = adi_ad9081_hal_reg_get(dev, ctrl_reg, &ctrl);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < plan->num_hops; i++) {
+		buf[0] = (ctrl & 0xF0) | i;
+		ad9081_nco_put48(&buf[1], ftws[i]);
+		ret = adi_ad9081_hal_reg_stream_set(dev, ctrl_reg, buf, 7);
+		if (ret)
+			return ret;
+
+		memset(buf, 0, sizeof(buf));
+		ret = adi_ad9081_hal_reg_stream_set(dev, frac_reg, buf, 12);
+		if (ret)
+			return ret;
+	}
+
+	if (fine || !(plan->cddcs & (AD9081_ADC_CDDC_0 | AD9081_ADC_CDDC_1)))
+		return 0;
+
+	/*
+	 * adi_ad9081_adc_ddc_coarse_nco_ftw_set() also sets the phase offset
+	 * of CDDC0 and CDDC1, do the same for every profile.
+	 */
+	ret = adi_ad9081_adc_ddc_coarse_select_set(dev, plan->cddcs &
+			(AD9081_ADC_CDDC_0 | AD9081_ADC_CDDC_1));
+	if (ret)
+		return ret;
+
+	offset_reg = REG_COARSE_DDC_PHASE_OFFSET0_ADDR;
+	for (i = 0; i < plan->num_hops; i++) {
+		ret = adi_ad9081_hal_reg_set(dev, ctrl_reg, (ctrl & 0xF0) | i);
+		if (ret)
+			return ret;
+		ad9081_nco_put48(buf, (ftws[i] << 3) & AD9081_NCO_FTW48_MASK);
+		ret = adi_ad9081_hal_reg_stream_set(dev, offset_reg, buf, 6);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/*
+ * Point a page register at the plan's blocks. Without a HAL cache the
+ * selects made since the last load are remembered in the plan, with one the
+ * HAL already skips the writes that do not change the page.
+ */
+static int ad9081_nco_select(struct ad9081_nco_plan *plan, uint8_t page)
+{
+	adi_ad9081_device_t *dev = plan->dev;
+	int ret;
+
+	if ((plan->pages & page) && !dev->hal_info.cache)
+		return 0;
+
+	switch (page) {
+	case AD9081_NCO_PAGE_DAC:
+		ret = adi_ad9081_dac_select_set(dev, plan->dacs);
+		break;
+	case AD9081_NCO_PAGE_CHAN:
+		ret = adi_ad9081_dac_chan_select_set(dev, plan->dac_chans);
+		break;
+	case AD9081_NCO_PAGE_CDDC:
+		ret = adi_ad9081_adc_ddc_coarse_select_set(dev, plan->cddcs);
+		break;
+	default:
+		ret = adi_ad9081_adc_ddc_fine_select_set(dev, plan->fddcs);
+		break;
+	}
+	if (ret)
+		return ret;
+
+	plan->pages |= page;
+
+	return 0;
+}
+
+/**
+ * @brief Write the hop tables to the device and set up the trigger.
+ *
+ * The DAC main NCO FTW1..FTWn table is sent in a single SPI burst, each ADC
+ * NCO profile takes two bursts. Nothing is retuned until the first hop.
+ * @param plan - The plan structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ad9081_nco_plan_load(struct ad9081_nco_plan *plan)
+{
+	adi_ad9081_device_t *dev;
+	uint8_t buf[4 * AD9081_NCO_HOPS_MAX];
+	uint8_t gpio = 0;
+	uint8_t i;
+	int ret;
+
+	if (!plan)
+		return -EINVAL;
+
+	dev = plan->dev;
+	if (plan->trig == AD9081_NCO_TRIG_GPIO)
+		gpio = 1;
+
+	if (plan->dacs || plan->dac_chans) {
+		ret = adi_ad9081_dac_duc_nco_enable_set(dev, plan->dacs,
+							plan->dac_chans, 1);
+		if (ret)
+			return ret;
+	}
+
+	if (plan->dac_chans) {
+		/* Keep the SYSREF load setting across the hop load requests */
+		ret = adi_ad9081_dac_chan_select_set(dev, plan->dac_chans);
+		if (ret)
+			return ret;
+		ret = adi_ad9081_hal_reg_get(dev, REG_DDSC_FTW_UPDATE_ADDR,
+					     &plan->ftw_update);
+		if (ret)
+			return ret;
+		plan->ftw_update &= BF_DDSC_FTW_LOAD_SYSREF(1);
+	}
+
+	if (plan->dacs) {
+		for (i = 0; i < plan->num_hops; i++)
+			no_os_put_unaligned_le32(plan->dac_ftw[i], &buf[4 * i]);
+
+		ret = adi_ad9081_dac_select_set(dev, plan->dacs);
+		if (ret)
+			return ret;
+		ret = adi_ad9081_hal_reg_stream_set(dev,
+						    REG_DDSM_HOPF_FTW1_0_ADDR,
+						    buf, 4 * plan->num_hops);
+		if (ret)
+			return ret;
+		ret = adi_ad9081_dac_duc_main_nco_hopf_mode_set(dev,
+								plan->dacs,
+								plan->hopf_mode);
+		if (ret)
+			return ret;
+		ret = adi_ad9081_dac_duc_main_nco_hopf_gpio_as_hop_en_set(dev,
+									  gpio);
+		if (ret)
+			return ret;
+	}
+
+	if (plan->cddcs) {
+		ret = ad9081_nco_ddc_load(plan, false);
+		if (ret)
+			return ret;
+		if (gpio) {
+			ret = adi_ad9081_adc_ddc_coarse_nco_channel_select_via_gpio_set(
+				      dev, plan->cddcs, 4);
+			if (ret)
+				return ret;
+		}
+	}
+
+	if (plan->fddcs) {
+		ret = ad9081_nco_ddc_load(plan, true);
+		if (ret)
+			return ret;
+		if (gpio) {
+			ret = adi_ad9081_adc_ddc_fine_nco_channel_select_via_gpio_set(
+				      dev, plan->fddcs, 4);
+			if (ret)
+				return ret;
+		}
+	}
+
+	plan->pages = 0;
+	plan->cur = -1;
+
+	return 0;
+}
+
+/**
+ * @brief Switch every NCO in the plan to the given hop.
+ *
+ * The DAC main NCO and the ADC NCOs switch with one register write each,
+ * the DAC channel NCOs need the FTW and a load request. Blocks whose
+ * frequency does not change are skipped. The page selects are only written
+ * on the first hop after ad9081_nco_plan_load(), from then on a full retune
+ * is at most five SPI transactions, with or without a HAL cache. Without a
+ * cache, clear plan->pages if other calls moved the page registers.
+ * @param plan - The plan structure.
+ * @param idx - Hop index, 0 to num_hops - 1.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ad9081_nco_plan_hop(struct ad9081_nco_plan *plan, uint8_t idx)
+{
+	adi_ad9081_device_t *dev;
+	uint8_t buf[7];
+	uint8_t sel;
+	bool all;
+	int ret;
+
+	if (!plan || idx >= plan->num_hops)
+		return -EINVAL;
+	/* The hop index comes from the pins */
+	if (plan->trig == AD9081_NCO_TRIG_GPIO)
+		return -EPERM;
+
+	dev = plan->dev;
+	all = plan->cur < 0;
+
+	if (plan->dacs &&
+	    (all || plan->dac_ftw[idx] != plan->dac_ftw[plan->cur])) {
+		ret = ad9081_nco_select(plan, AD9081_NCO_PAGE_DAC);
+		if (ret)
+			return ret;
+		/* FTW0 is the main NCO tuning word, the table starts at 1 */
+		sel = idx + 1;
+		ret = adi_ad9081_hal_reg_set(dev, REG_DDSM_HOPF_CTRL0_ADDR,
+					     BF_DDSM_HOPF_MODE(plan->hopf_mode) |
+					     BF_DDSM_HOPF_SEL(sel));
+		if (ret)
+			return ret;
+	}
+
+	if (plan->dac_chans &&
+	    (all || plan->chan_ftw[idx] != plan->chan_ftw[plan->cur])) {
+		ret = ad9081_nco_select(plan, AD9081_NCO_PAGE_CHAN);
+		if (ret)
+			return ret;
+		/* FTW_UPDATE is followed by FTW0..FTW5, clear the request too */
+		buf[0] = plan->ftw_update;
+		ad9081_nco_put48(&buf[1], plan->chan_ftw[idx]);
+		ret = adi_ad9081_hal_reg_stream_set(dev,
+						    REG_DDSC_FTW_UPDATE_ADDR,
+						    buf, 7);
+		if (ret)
+			return ret;
+		ret = adi_ad9081_hal_reg_set(dev, REG_DDSC_FTW_UPDATE_ADDR,
+					     plan->ftw_update |
+					     BF_DDSC_FTW_LOAD_REQ(1));
+		if (ret)
+			return ret;
+	}
+
+	if (plan->cddcs &&
+	    (all || plan->cddc_ftw[idx] != plan->cddc_ftw[plan->cur])) {
+		ret = ad9081_nco_select(plan, AD9081_NCO_PAGE_CDDC);
+		if (ret)
+			return ret;
+		/* Register map channel selection, regmap_chan_sel = idx */
+		ret = adi_ad9081_hal_reg_set(dev, REG_COARSE_DDC_NCO_CTRL_ADDR,
+					     idx);
+		if (ret)
+			return ret;
+	}
+
+	if (plan->fddcs &&
+	    (all || plan->fddc_ftw[idx] != plan->fddc_ftw[plan->cur])) {
+		ret = ad9081_nco_select(plan, AD9081_NCO_PAGE_FDDC);
+		if (ret)
+			return ret;
+		ret = adi_ad9081_hal_reg_set(dev, REG_FINE_DDC_NCO_CTRL_ADDR,
+					     idx);
+		if (ret)
+			return ret;
+	}
+
+	plan->cur = idx;
+
+	return 0;
+}
+
+/**
+ * @brief Free the plan.
+ * @param plan - The plan structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ad9081_nco_plan_remove(struct ad9081_nco_plan *plan)
+{
+	if (!plan)
+		return -EINVAL;
+
+	no_os_free(plan);
+
+	return 0;
+}
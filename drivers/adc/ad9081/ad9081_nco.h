@@ -0,0 +1,133 @@
+/***************************************************************************//**
+ *   @file   ad9081_nco.h
+ *   @brief  AD9081 NCO frequency hopping plan.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+#ifndef AD9081_NCO_H_
+#define AD9081_NCO_H_
+
+#include <stdint.h>
+#include "adi_ad9081.h"
+
+/* The DAC main NCO holds FTW1..FTW31 for fast frequency hopping */
+#define AD9081_NCO_HOPS_MAX		31
+/* The ADC coarse and fine NCOs hold 16 profiles */
+#define AD9081_NCO_DDC_HOPS_MAX		16
+
+/**
+ * @enum ad9081_nco_trig
+ * @brief How the hop index is applied.
+ */
+enum ad9081_nco_trig {
+	/** One register write per NCO block, from ad9081_nco_plan_hop() */
+	AD9081_NCO_TRIG_SPI,
+	/** DAC FFH pins and ADC profile pins select the hop */
+	AD9081_NCO_TRIG_GPIO,
+};
+
+/**
+ * @struct ad9081_nco_hop
+ * @brief One entry of the NCO plan. Members for blocks that are not part of
+ * the plan are ignored.
+ */
+struct ad9081_nco_hop {
+	/** DAC main NCO shift */
+	int64_t dac_hz;
+	/** DAC channel NCO shift */
+	int64_t dac_chan_hz;
+	/** ADC coarse DDC NCO shift */
+	int64_t cddc_hz;
+	/** ADC fine DDC NCO shift */
+	int64_t fddc_hz;
+};
+
+/**
+ * @struct ad9081_nco_plan_init_param
+ * @brief NCO plan initialization parameters.
+ */
+struct ad9081_nco_plan_init_param {
+	/** Device, clocks and datapath already configured */
+	adi_ad9081_device_t *dev;
+	/** DAC main NCOs, adi_ad9081_dac_select_e mask */
+	uint8_t dacs;
+	/** DAC channel NCOs, adi_ad9081_dac_channel_select_e mask */
+	uint8_t dac_chans;
+	/** Coarse DDCs, adi_ad9081_adc_coarse_ddc_select_e mask */
+	uint8_t cddcs;
+	/** Fine DDCs, adi_ad9081_adc_fine_ddc_select_e mask */
+	uint8_t fddcs;
+	/** DAC hop mode: 0 phase continuous, 1 phase discontinuous,
+	 *  2 phase coherent */
+	uint8_t hopf_mode;
+	/** Hop trigger */
+	enum ad9081_nco_trig trig;
+	/** Frequency list */
+	const struct ad9081_nco_hop *hops;
+	/** Number of entries in hops */
+	uint8_t num_hops;
+};
+
+/**
+ * @struct ad9081_nco_plan
+ * @brief Precomputed tuning words and the last applied hop.
+ */
+struct ad9081_nco_plan {
+	adi_ad9081_device_t *dev;
+	uint8_t dacs;
+	uint8_t dac_chans;
+	uint8_t cddcs;
+	uint8_t fddcs;
+	uint8_t hopf_mode;
+	enum ad9081_nco_trig trig;
+	uint8_t num_hops;
+	uint32_t dac_ftw[AD9081_NCO_HOPS_MAX];
+	uint64_t chan_ftw[AD9081_NCO_HOPS_MAX];
+	uint64_t cddc_ftw[AD9081_NCO_DDC_HOPS_MAX];
+	uint64_t fddc_ftw[AD9081_NCO_DDC_HOPS_MAX];
+	/** Channel NCO FTW_UPDATE bits kept by the load requests */
+	uint8_t ftw_update;
+	/** Page selects made by ad9081_nco_plan_hop(), clear it when other
+	 *  calls changed the page registers between hops */
+	uint8_t pages;
+	/** Active hop, -1 until the first ad9081_nco_plan_hop() */
+	int8_t cur;
+};
+
+/* Compute the tuning words of every hop. */
+int ad9081_nco_plan_init(struct ad9081_nco_plan **plan,
+			 const struct ad9081_nco_plan_init_param *init_param);
+/* Write the hop tables to the device and set up the trigger. */
+int ad9081_nco_plan_load(struct ad9081_nco_plan *plan);
+/* Switch every NCO in the plan to the given hop. */
+int ad9081_nco_plan_hop(struct ad9081_nco_plan *plan, uint8_t idx);
+/* Free the plan. */
+int ad9081_nco_plan_remove(struct ad9081_nco_plan *plan);
+
+#endif
@@ -292,6 +292,18 @@
 
 #define AD9081_USE_FLOATING_TYPE 0
 #define AD9081_USE_SPI_BURST_MODE 0
+/* Off until the volatile register table is validated on hardware */
+#ifndef AD9081_USE_SPI_CACHE
+#define AD9081_USE_SPI_CACHE 0
+#endif
+
+#define AD9081_HAL_CACHE_SIZE 0x4000 /* Direct register space */
+#define AD9081_HAL_BATCH_SIZE 64
+#define AD9081_HAL_STREAM_MAX 128
+
+#if (AD9081_USE_SPI_CACHE > 0) && (AD9081_USE_SPI_BURST_MODE > 0)
+#error "SPI burst mode writes bypass the HAL register cache"
+#endif
 
 /*============= ENUMS ==============*/
 
@@ -872,6 +884,23 @@ typedef struct {
 	uint8_t virtual_converterf_index; /*! Index for JTX virtual converter15 */
 } adi_ad9081_jtx_conv_sel_t;
 
+/*!
+ * @brief Device HAL Register Cache Structure
+ *
+ * Shadows the direct (< 0x4000) register space. Registers listed in the
+ * HAL volatile table are never served from the shadow. Any page register
+ * change, soft reset or reset pin toggle invalidates the whole shadow.
+ */
+typedef struct {
+	uint8_t shadow[AD9081_HAL_CACHE_SIZE]; /*!< Last known register values */
+	uint8_t valid[AD9081_HAL_CACHE_SIZE / 8]; /*!< Shadow valid bitmap */
+	uint16_t batch_addr[AD9081_HAL_BATCH_SIZE]; /*!< Deferred write addresses, in issue order */
+	uint8_t batch_data[AD9081_HAL_BATCH_SIZE]; /*!< Deferred write values */
+	uint8_t batch_len; /*!< Number of deferred writes */
+	uint8_t batch_en; /*!< Defer writes until adi_ad9081_hal_batch_commit() */
+	uint32_t hit_cnt; /*!< Register reads served from the shadow */
+} adi_ad9081_hal_cache_t;
+
 /*!
  * @brief Device Hardware Abstract Layer Structure
  */
@@ -898,6 +927,9 @@ typedef struct {
 		tx_en_pin_ctrl; /*!< Function pointer to hal tx_enable pin control function */
 	adi_reset_pin_ctrl_t
 		reset_pin_ctrl; /*!< Function pointer to hal reset# pin control function */
+	adi_ad9081_hal_cache_t
+		*cache; /*!< Register shadow cache, NULL if disabled */
+	uint32_t xfer_cnt; /*!< Number of SPI transactions issued */
 } adi_ad9081_hal_t;
 
 /*!
@@ -13,9 +13,202 @@
  */
 
 /*============= I N C L U D E S ============*/
+#include <string.h>
 #include "adi_ad9081_hal.h"
 
+/*============= D A T A ====================*/
+/* Direct space registers never served from the shadow cache: status,
+ * counters, self-clearing controls and the indirect access windows. */
+static const uint16_t ad9081_hal_volatile_regs[][2] = {
+	{ 0x0000, 0x0000 }, { 0x0002, 0x0002 }, { 0x0004, 0x0005 },
+	{ 0x0010, 0x0013 }, { 0x0020, 0x0034 }, { 0x0038, 0x0038 },
+	{ 0x0060, 0x0060 }, { 0x0063, 0x0063 }, { 0x0093, 0x0093 },
+	{ 0x0095, 0x0095 }, { 0x00A0, 0x00A0 }, { 0x00A4, 0x00A5 },
+	{ 0x00B0, 0x00B1 }, { 0x00B4, 0x00B4 }, { 0x00B7, 0x00B9 },
+	{ 0x00BB, 0x00BC }, { 0x00C0, 0x00C0 }, { 0x00C2, 0x00C2 },
+	{ 0x00C4, 0x00C6 }, { 0x00CB, 0x00CC }, { 0x00E2, 0x00E2 },
+	{ 0x00E4, 0x00E5 }, { 0x00EA, 0x00F4 }, { 0x010F, 0x0110 },
+	{ 0x011F, 0x011F }, { 0x0187, 0x0187 }, { 0x0191, 0x0191 },
+	{ 0x0193, 0x0193 }, { 0x0199, 0x0199 }, { 0x01A1, 0x01A1 },
+	{ 0x01C7, 0x01C7 }, { 0x01CA, 0x01CA }, { 0x01E5, 0x01E9 },
+	{ 0x01F6, 0x01F6 }, { 0x01FB, 0x01FB }, { 0x01FE, 0x0201 },
+	{ 0x0203, 0x0204 }, { 0x0210, 0x0215 }, { 0x028A, 0x028A },
+	{ 0x02A4, 0x02A7 }, { 0x02B1, 0x02B1 }, { 0x02BA, 0x02BB },
+	{ 0x02BD, 0x02BD }, { 0x02C2, 0x02C5 }, { 0x02CC, 0x02CD },
+	{ 0x02D5, 0x02D5 }, { 0x0301, 0x0302 }, { 0x0304, 0x0304 },
+	{ 0x031F, 0x0320 }, { 0x0322, 0x0322 }, { 0x0324, 0x0324 },
+	{ 0x0402, 0x0402 }, { 0x0405, 0x040A }, { 0x040D, 0x040D },
+	{ 0x0413, 0x0416 }, { 0x0428, 0x042A }, { 0x0435, 0x0437 },
+	{ 0x0447, 0x0448 }, { 0x0459, 0x0459 }, { 0x04A0, 0x04A0 },
+	{ 0x04BE, 0x04BE }, { 0x04CF, 0x04D6 }, { 0x04DE, 0x04E5 },
+	{ 0x04FE, 0x0505 }, { 0x050E, 0x0515 }, { 0x0557, 0x0558 },
+	{ 0x055A, 0x055C }, { 0x055E, 0x0561 }, { 0x056B, 0x0572 },
+	{ 0x0574, 0x057B }, { 0x058C, 0x058C }, { 0x0595, 0x0598 },
+	{ 0x05A4, 0x05A9 }, { 0x05AC, 0x05AE }, { 0x05B0, 0x05B2 },
+	{ 0x05B5, 0x05B5 }, { 0x05B7, 0x05B7 }, { 0x05BB, 0x05BB },
+	{ 0x0611, 0x0611 }, { 0x0624, 0x0624 }, { 0x062D, 0x062D },
+	{ 0x0630, 0x0630 }, { 0x0636, 0x0637 }, { 0x063B, 0x063B },
+	{ 0x065A, 0x065A }, { 0x065C, 0x065E }, { 0x0669, 0x066C },
+	{ 0x066E, 0x0677 }, { 0x0701, 0x0701 }, { 0x0706, 0x0706 },
+	{ 0x070A, 0x070B }, { 0x0710, 0x0713 }, { 0x0720, 0x0723 },
+	{ 0x0726, 0x0726 }, { 0x0729, 0x0729 }, { 0x072E, 0x072F },
+	{ 0x0732, 0x0737 }, { 0x073A, 0x073B }, { 0x073E, 0x0743 },
+	{ 0x0773, 0x0778 }, { 0x0790, 0x0798 }, { 0x0950, 0x0951 },
+	{ 0x0953, 0x0964 }, { 0x0977, 0x0979 }, { 0x097D, 0x0981 },
+	{ 0x0983, 0x0984 }, { 0x0993, 0x0995 }, { 0x099A, 0x099A },
+	{ 0x099C, 0x099F }, { 0x09A4, 0x09A4 }, { 0x09A6, 0x09A9 },
+	{ 0x09AE, 0x09AE }, { 0x09B0, 0x09B3 }, { 0x09B8, 0x09B8 },
+	{ 0x09BA, 0x09BD }, { 0x09C2, 0x09C2 }, { 0x09C4, 0x09C7 },
+	{ 0x09CC, 0x09CC }, { 0x09CE, 0x09D1 }, { 0x09D6, 0x09D6 },
+	{ 0x09D8, 0x09DB }, { 0x09E0, 0x09E0 }, { 0x09E2, 0x09E2 },
+	{ 0x09EC, 0x09EC }, { 0x0A00, 0x0A02 }, { 0x0A04, 0x0A04 },
+	{ 0x0A1D, 0x0A1D }, { 0x0A32, 0x0A38 }, { 0x0A80, 0x0A82 },
+	{ 0x0A84, 0x0A84 }, { 0x0A9D, 0x0A9D }, { 0x0AB2, 0x0AB8 },
+	{ 0x0F2C, 0x0F2C }, { 0x0F32, 0x0F32 }, { 0x0F34, 0x0F34 },
+	{ 0x2008, 0x2008 }, { 0x2061, 0x2061 }, { 0x2063, 0x2066 },
+	{ 0x20D4, 0x20D4 }, { 0x3D12, 0x3D14 }, { 0x3D26, 0x3D28 },
+	{ 0x3D30, 0x3D30 }, { 0x3D33, 0x3D37 }, { 0x3D3A, 0x3D3A },
+	{ 0x3D3C, 0x3D3C }
+};
+
 /*============= C O D E ====================*/
+static uint8_t adi_ad9081_hal_reg_is_volatile(uint32_t reg)
+{
+	int32_t lo = 0, mid;
+	int32_t hi = (int32_t)(sizeof(ad9081_hal_volatile_regs) /
+			       sizeof(ad9081_hal_volatile_regs[0])) - 1;
+
+	while (lo <= hi) {
+		mid = (lo + hi) / 2;
+		if (reg < ad9081_hal_volatile_regs[mid][0])
+			hi = mid - 1;
+		else if (reg > ad9081_hal_volatile_regs[mid][1])
+			lo = mid + 1;
+		else
+			return 1;
+	}
+
+	return 0;
+}
+
+static uint8_t adi_ad9081_hal_reg_is_page(uint32_t reg)
+{
+	return (reg >= REG_ADC_COARSE_PAGE_ADDR) &&
+	       (reg <= REG_PFILT_COEFF_PAGE_ADDR);
+}
+
+static uint8_t adi_ad9081_hal_can_stream(adi_ad9081_device_t *device)
+{
+	return (device->hal_info.addr_inc == SPI_ADDR_INC_AUTO) &&
+	       (device->hal_info.msb == SPI_MSB_FIRST);
+}
+
+static int32_t adi_ad9081_hal_xfer(adi_ad9081_device_t *device,
+				   uint8_t *in_data, uint8_t *out_data,
+				   uint32_t size_bytes)
+{
+	device->hal_info.xfer_cnt++;
+	return device->hal_info.spi_xfer(device->hal_info.user_data, in_data,
+					 out_data, size_bytes);
+}
+
+static uint8_t adi_ad9081_hal_cache_get(adi_ad9081_device_t *device,
+					uint32_t reg, uint8_t *data)
+{
+	adi_ad9081_hal_cache_t *cache = device->hal_info.cache;
+
+	if (cache == NULL || reg >= AD9081_HAL_CACHE_SIZE ||
+	    !(cache->valid[reg >> 3] & (1 << (reg & 7))) ||
+	    adi_ad9081_hal_reg_is_volatile(reg))
+		return 0;
+
+	*data = cache->shadow[reg];
+	cache->hit_cnt++;
+
+	return 1;
+}
+
+static void adi_ad9081_hal_cache_put(adi_ad9081_device_t *device,
+				     uint32_t reg, uint8_t data)
+{
+	adi_ad9081_hal_cache_t *cache = device->hal_info.cache;
+
+	if (cache == NULL || reg >= AD9081_HAL_CACHE_SIZE)
+		return;
+
+	cache->shadow[reg] = data;
+	if (adi_ad9081_hal_reg_is_volatile(reg))
+		cache->valid[reg >> 3] &= ~(1 << (reg & 7));
+	else
+		cache->valid[reg >> 3] |= (1 << (reg & 7));
+}
+
+static void adi_ad9081_hal_cache_drop(adi_ad9081_device_t *device,
+				      uint32_t reg, uint8_t len)
+{
+	adi_ad9081_hal_cache_t *cache = device->hal_info.cache;
+
+	if (cache == NULL)
+		return;
+
+	for (; len > 0 && reg < AD9081_HAL_CACHE_SIZE; len--, reg++)
+		cache->valid[reg >> 3] &= ~(1 << (reg & 7));
+}
+
+/* Registers behind the page selects change meaning, the selects do not. */
+static void adi_ad9081_hal_cache_invalidate_paged(adi_ad9081_device_t *device)
+{
+	adi_ad9081_hal_cache_t *cache = device->hal_info.cache;
+	uint8_t page_valid;
+
+	if (cache == NULL)
+		return;
+
+	page_valid = cache->valid[REG_ADC_COARSE_PAGE_ADDR >> 3];
+	memset(cache->valid, 0, sizeof(cache->valid));
+	cache->valid[REG_ADC_COARSE_PAGE_ADDR >> 3] = page_valid;
+}
+
+/* Sends the deferred writes, one streaming transaction per run of
+ * consecutive addresses. */
+static int32_t adi_ad9081_hal_batch_flush(adi_ad9081_device_t *device)
+{
+	adi_ad9081_hal_cache_t *cache = device->hal_info.cache;
+	uint8_t in_data[2 + AD9081_HAL_STREAM_MAX], out_data[2 + AD9081_HAL_STREAM_MAX];
+	uint8_t i = 0, n, stream;
+	uint16_t reg;
+
+	if (cache == NULL || cache->batch_len == 0)
+		return API_CMS_ERROR_OK;
+
+	stream = adi_ad9081_hal_can_stream(device);
+	while (i < cache->batch_len) {
+		reg = cache->batch_addr[i];
+		n = 1;
+		while (stream && n < AD9081_HAL_STREAM_MAX &&
+		       i + n < cache->batch_len &&
+		       cache->batch_addr[i + n] == reg + n)
+			n++;
+
+		in_data[0] = (reg >> 8) & 0x3F;
+		in_data[1] = (reg >> 0) & 0xFF;
+		memcpy(&in_data[2], &cache->batch_data[i], n);
+		if (API_CMS_ERROR_OK !=
+		    adi_ad9081_hal_xfer(device, in_data, out_data, 2 + n)) {
+			cache->batch_len = 0;
+			return API_CMS_ERROR_SPI_XFER;
+		}
+		for (; n > 0; n--, i++, reg++) {
+			if (API_CMS_ERROR_OK !=
+			    AD9081_LOG_SPIW(reg, cache->batch_data[i]))
+				return API_CMS_ERROR_LOG_WRITE;
+		}
+	}
+	cache->batch_len = 0;
+
+	return API_CMS_ERROR_OK;
+}
+
 int32_t adi_ad9081_hal_hw_open(adi_ad9081_device_t *device)
 {
 	AD9081_NULL_POINTER_RETURN(device);
@@ -44,6 +237,9 @@ int32_t adi_ad9081_hal_delay_us(adi_ad9081_device_t *device, uint32_t us)
 {
 	AD9081_NULL_POINTER_RETURN(device);
 	AD9081_NULL_POINTER_RETURN(device->hal_info.delay_us);
+	/* deferred writes must land before the time they are given to settle */
+	if (API_CMS_ERROR_OK != adi_ad9081_hal_batch_flush(device))
+		return API_CMS_ERROR_SPI_XFER;
 	if (API_CMS_ERROR_OK !=
 	    device->hal_info.delay_us(device->hal_info.user_data, us)) {
 		return API_CMS_ERROR_DELAY_US;
@@ -57,10 +253,13 @@ int32_t adi_ad9081_hal_reset_pin_ctrl(adi_ad9081_device_t *device,
 {
 	AD9081_NULL_POINTER_RETURN(device);
 	AD9081_NULL_POINTER_RETURN(device->hal_info.reset_pin_ctrl);
+	if (API_CMS_ERROR_OK != adi_ad9081_hal_batch_flush(device))
+		return API_CMS_ERROR_SPI_XFER;
 	if (API_CMS_ERROR_OK != device->hal_info.reset_pin_ctrl(
 					device->hal_info.user_data, enable)) {
 		return API_CMS_ERROR_RESET_PIN_CTRL;
 	}
+	adi_ad9081_hal_cache_invalidate(device);
 
 	return API_CMS_ERROR_OK;
 }
@@ -97,6 +296,7 @@ int32_t adi_ad9081_hal_bf_get(adi_ad9081_device_t *device, uint32_t reg,
 	uint8_t reg_bytes =
 		((width + offset) >> 3) + (((width + offset) & 7) == 0 ? 0 : 1);
 	uint8_t i = 0, j = 0, filled_bits = 0;
+	uint8_t regs[9];
 	AD9081_NULL_POINTER_RETURN(device);
 	AD9081_NULL_POINTER_RETURN(value);
 	AD9081_INVALID_PARAM_RETURN(width > 64);
@@ -104,10 +304,12 @@ int32_t adi_ad9081_hal_bf_get(adi_ad9081_device_t *device, uint32_t reg,
 	AD9081_INVALID_PARAM_RETURN(value_size_bytes > 8);
 
 	if (reg < 0x4000) {
+		/* all bytes of the bitfield in one streaming read */
+		err = adi_ad9081_hal_reg_stream_get(device, reg, regs,
+						    reg_bytes);
+		AD9081_ERROR_RETURN(err);
 		for (reg_offset = 0; reg_offset < reg_bytes; reg_offset++) {
-			err = adi_ad9081_hal_reg_get(device, reg + reg_offset,
-						     &data8);
-			AD9081_ERROR_RETURN(err);
+			data8 = regs[reg_offset];
 			if ((offset + width) <= 8) { /* last 8bits */
 				mask = (1 << width) - 1;
 				data8 = (data8 >> offset) & mask;
@@ -167,6 +369,7 @@ int32_t adi_ad9081_hal_bf_set(adi_ad9081_device_t *device, uint32_t reg,
 	uint32_t data32 = 0, mask = 0;
 	uint8_t reg_bytes =
 		((width + offset) >> 3) + (((width + offset) & 7) == 0 ? 0 : 1);
+	uint8_t regs[9];
 	AD9081_NULL_POINTER_RETURN(device);
 	AD9081_INVALID_PARAM_RETURN(width > 64);
 	AD9081_INVALID_PARAM_RETURN(width < 1);
@@ -197,10 +400,12 @@ int32_t adi_ad9081_hal_bf_set(adi_ad9081_device_t *device, uint32_t reg,
 				width = offset + width - 8;
 				offset = 0;
 			}
-			err = adi_ad9081_hal_reg_set(device, reg + reg_offset,
-						     data8);
-			AD9081_ERROR_RETURN(err);
+			regs[reg_offset] = data8;
 		}
+		/* all bytes of the bitfield in one streaming write */
+		err = adi_ad9081_hal_reg_stream_set(device, reg, regs,
+						    reg_bytes);
+		AD9081_ERROR_RETURN(err);
 	} else { /* access extended space */
 		for (reg_offset = 0; reg_offset < reg_bytes; reg_offset += 4) {
 			if ((offset + width) <= 32) { /* last 32bits */
@@ -244,14 +449,21 @@ int32_t adi_ad9081_hal_reg_get(adi_ad9081_device_t *device, uint32_t reg,
 	AD9081_NULL_POINTER_RETURN(device->hal_info.spi_xfer);
 	AD9081_NULL_POINTER_RETURN(data);
 
+	if (adi_ad9081_hal_cache_get(device, reg, data))
+		return API_CMS_ERROR_OK;
+	/* status may depend on writes that are still deferred */
+	if (((reg >= 0x4000) || adi_ad9081_hal_reg_is_volatile(reg)) &&
+	    (API_CMS_ERROR_OK != adi_ad9081_hal_batch_flush(device)))
+		return API_CMS_ERROR_SPI_XFER;
+
 	if (reg < 0x4000) {
 		in_data[0] = ((reg >> 8) & 0x3F) | 0x80;
 		in_data[1] = ((reg >> 0) & 0xFF);
 		if (API_CMS_ERROR_OK !=
-		    device->hal_info.spi_xfer(device->hal_info.user_data,
-					      in_data, out_data, 0x3))
+		    adi_ad9081_hal_xfer(device, in_data, out_data, 0x3))
 			return API_CMS_ERROR_SPI_XFER;
 		*data = out_data[2];
+		adi_ad9081_hal_cache_put(device, reg, *data);
 		if (API_CMS_ERROR_OK !=
 		    AD9081_LOG_SPIR((in_data[0] << 8) + in_data[1],
 				    out_data[2]))
@@ -261,8 +473,7 @@ int32_t adi_ad9081_hal_reg_get(adi_ad9081_device_t *device, uint32_t reg,
 		in_data[1] = 0x21;
 		in_data[2] = (reg >> 8) & 0xC0;
 		if (API_CMS_ERROR_OK !=
-		    device->hal_info.spi_xfer(device->hal_info.user_data,
-					      in_data, out_data, 0x3))
+		    adi_ad9081_hal_xfer(device, in_data, out_data, 0x3))
 			return API_CMS_ERROR_SPI_XFER;
 		if (API_CMS_ERROR_OK != AD9081_LOG_SPIW(0x3d21, in_data[2]))
 			return API_CMS_ERROR_LOG_WRITE;
@@ -270,8 +481,7 @@ int32_t adi_ad9081_hal_reg_get(adi_ad9081_device_t *device, uint32_t reg,
 		in_data[1] = 0x22;
 		in_data[2] = (reg >> 16) & 0xFF;
 		if (API_CMS_ERROR_OK !=
-		    device->hal_info.spi_xfer(device->hal_info.user_data,
-					      in_data, out_data, 0x3))
+		    adi_ad9081_hal_xfer(device, in_data, out_data, 0x3))
 			return API_CMS_ERROR_SPI_XFER;
 		if (API_CMS_ERROR_OK != AD9081_LOG_SPIW(0x3d22, in_data[2]))
 			return API_CMS_ERROR_LOG_WRITE;
@@ -279,8 +489,7 @@ int32_t adi_ad9081_hal_reg_get(adi_ad9081_device_t *device, uint32_t reg,
 		in_data[1] = 0x23;
 		in_data[2] = (reg >> 24) & 0xFF;
 		if (API_CMS_ERROR_OK !=
-		    device->hal_info.spi_xfer(device->hal_info.user_data,
-					      in_data, out_data, 0x3))
+		    adi_ad9081_hal_xfer(device, in_data, out_data, 0x3))
 			return API_CMS_ERROR_SPI_XFER;
 		if (API_CMS_ERROR_OK != AD9081_LOG_SPIW(0x3d23, in_data[2]))
 			return API_CMS_ERROR_LOG_WRITE;
@@ -290,8 +499,8 @@ int32_t adi_ad9081_hal_reg_get(adi_ad9081_device_t *device, uint32_t reg,
 			in_data[0] = ((reg >> 8) & 0x3F) | 0xC0;
 			in_data[1] = ((reg >> 0) & 0xFF);
 			if (API_CMS_ERROR_OK !=
-			    device->hal_info.spi_xfer(device->hal_info.user_data,
-						      in_data, out_data, 0x3))
+			    adi_ad9081_hal_xfer(device, in_data, out_data,
+						0x3))
 				return API_CMS_ERROR_SPI_XFER;
 			*data = out_data[2];
 			if (API_CMS_ERROR_OK !=
@@ -307,9 +516,8 @@ int32_t adi_ad9081_hal_reg_get(adi_ad9081_device_t *device, uint32_t reg,
 			in_data[0] = ((reg >> 8) & 0x3F) | 0xC0;
 			in_data[1] = ((reg >> 0) & 0xFF);
 			if (API_CMS_ERROR_OK !=
-			    device->hal_info.spi_xfer(
-				    device->hal_info.user_data, in_data,
-				    out_data, 0x20000006))
+			    adi_ad9081_hal_xfer(device, in_data, out_data,
+						0x20000006))
 				return API_CMS_ERROR_SPI_XFER;
 			if (device->hal_info.addr_inc == SPI_ADDR_INC_AUTO) {
 				*(uint32_t *)data = (out_data[2]) +
@@ -335,18 +543,48 @@ int32_t adi_ad9081_hal_reg_get(adi_ad9081_device_t *device, uint32_t reg,
 int32_t adi_ad9081_hal_reg_set(adi_ad9081_device_t *device, uint32_t reg,
 			       uint32_t data)
 {
+	adi_ad9081_hal_cache_t *cache;
 	uint8_t in_data[6] = { 0 }, out_data[6] = { 0 };
+	uint8_t cached;
 	AD9081_NULL_POINTER_RETURN(device);
 	AD9081_NULL_POINTER_RETURN(device->hal_info.spi_xfer);
 
+	cache = device->hal_info.cache;
+	if ((cache != NULL) && (reg < 0x4000)) {
+		if (adi_ad9081_hal_reg_is_page(reg)) {
+			/* page selects have no side effect, skip rewrites */
+			if (adi_ad9081_hal_cache_get(device, reg, &cached) &&
+			    (cached == (uint8_t)data))
+				return API_CMS_ERROR_OK;
+		} else if (cache->batch_en &&
+			   !adi_ad9081_hal_reg_is_volatile(reg)) {
+			if ((cache->batch_len == AD9081_HAL_BATCH_SIZE) &&
+			    (API_CMS_ERROR_OK !=
+			     adi_ad9081_hal_batch_flush(device)))
+				return API_CMS_ERROR_SPI_XFER;
+			cache->batch_addr[cache->batch_len] = (uint16_t)reg;
+			cache->batch_data[cache->batch_len] = (uint8_t)data;
+			cache->batch_len++;
+			adi_ad9081_hal_cache_put(device, reg, (uint8_t)data);
+			return API_CMS_ERROR_OK;
+		}
+	}
+	if (API_CMS_ERROR_OK != adi_ad9081_hal_batch_flush(device))
+		return API_CMS_ERROR_SPI_XFER;
+
 	if (reg < 0x4000) {
 		in_data[0] = (reg >> 8) & 0x3F;
 		in_data[1] = (reg >> 0) & 0xFF;
 		in_data[2] = (uint8_t)(data & 0xFF);
 		if (API_CMS_ERROR_OK !=
-		    device->hal_info.spi_xfer(device->hal_info.user_data,
-					      in_data, out_data, 0x3))
+		    adi_ad9081_hal_xfer(device, in_data, out_data, 0x3))
 			return API_CMS_ERROR_SPI_XFER;
+		if (adi_ad9081_hal_reg_is_page(reg))
+			adi_ad9081_hal_cache_invalidate_paged(device);
+		else if ((reg == REG_SPI_INTFCONFA_ADDR) &&
+			 (data & (BF_SOFTRESET(1) | BF_SOFTRESET_M(1))))
+			adi_ad9081_hal_cache_invalidate(device);
+		adi_ad9081_hal_cache_put(device, reg, in_data[2]);
 		if (API_CMS_ERROR_OK !=
 		    AD9081_LOG_SPIW(reg & 0x3fff, in_data[2]))
 			return API_CMS_ERROR_LOG_WRITE;
@@ -355,8 +593,7 @@ int32_t adi_ad9081_hal_reg_set(adi_ad9081_device_t *device, uint32_t reg,
 		in_data[1] = 0x21;
 		in_data[2] = (reg >> 8) & 0xC0;
 		if (API_CMS_ERROR_OK !=
-		    device->hal_info.spi_xfer(device->hal_info.user_data,
-					      in_data, out_data, 0x3))
+		    adi_ad9081_hal_xfer(device, in_data, out_data, 0x3))
 			return API_CMS_ERROR_SPI_XFER;
 		if (API_CMS_ERROR_OK != AD9081_LOG_SPIW(0x3d21, in_data[2]))
 			return API_CMS_ERROR_LOG_WRITE;
@@ -364,8 +601,7 @@ int32_t adi_ad9081_hal_reg_set(adi_ad9081_device_t *device, uint32_t reg,
 		in_data[1] = 0x22;
 		in_data[2] = (reg >> 16) & 0xFF;
 		if (API_CMS_ERROR_OK !=
-		    device->hal_info.spi_xfer(device->hal_info.user_data,
-					      in_data, out_data, 0x3))
+		    adi_ad9081_hal_xfer(device, in_data, out_data, 0x3))
 			return API_CMS_ERROR_SPI_XFER;
 		if (API_CMS_ERROR_OK != AD9081_LOG_SPIW(0x3d22, in_data[2]))
 			return API_CMS_ERROR_LOG_WRITE;
@@ -373,8 +609,7 @@ int32_t adi_ad9081_hal_reg_set(adi_ad9081_device_t *device, uint32_t reg,
 		in_data[1] = 0x23;
 		in_data[2] = (reg >> 24) & 0xFF;
 		if (API_CMS_ERROR_OK !=
-		    device->hal_info.spi_xfer(device->hal_info.user_data,
-					      in_data, out_data, 0x3))
+		    adi_ad9081_hal_xfer(device, in_data, out_data, 0x3))
 			return API_CMS_ERROR_SPI_XFER;
 		if (API_CMS_ERROR_OK != AD9081_LOG_SPIW(0x3d23, in_data[2]))
 			return API_CMS_ERROR_LOG_WRITE;
@@ -385,8 +620,8 @@ int32_t adi_ad9081_hal_reg_set(adi_ad9081_device_t *device, uint32_t reg,
 			in_data[1] = ((reg >> 0) & 0xFF);
 			in_data[2] = (uint8_t)(data & 0xFF);
 			if (API_CMS_ERROR_OK !=
-			    device->hal_info.spi_xfer(device->hal_info.user_data,
-						      in_data, out_data, 0x3))
+			    adi_ad9081_hal_xfer(device, in_data, out_data,
+						0x3))
 				return API_CMS_ERROR_SPI_XFER;
 			if (API_CMS_ERROR_OK !=
 			    AD9081_LOG_SPIW((in_data[0] << 8) + in_data[1],
@@ -410,9 +645,8 @@ int32_t adi_ad9081_hal_reg_set(adi_ad9081_device_t *device, uint32_t reg,
 				in_data[5] = (uint8_t)((data >> 0) & 0xFF);
 			}
 			if (API_CMS_ERROR_OK !=
-			    device->hal_info.spi_xfer(
-				    device->hal_info.user_data, in_data,
-				    out_data, 0x20000006))
+			    adi_ad9081_hal_xfer(device, in_data, out_data,
+						0x20000006))
 				return API_CMS_ERROR_SPI_XFER;
 			if (API_CMS_ERROR_OK !=
 			    AD9081_LOG_SPIW32((in_data[0] << 8) + in_data[1],
@@ -424,6 +658,131 @@ int32_t adi_ad9081_hal_reg_set(adi_ad9081_device_t *device, uint32_t reg,
 	return API_CMS_ERROR_OK;
 }
 
+int32_t adi_ad9081_hal_reg_stream_get(adi_ad9081_device_t *device,
+				      uint32_t reg, uint8_t *data, uint8_t len)
+{
+	uint8_t in_data[2 + AD9081_HAL_STREAM_MAX] = { 0 };
+	uint8_t out_data[2 + AD9081_HAL_STREAM_MAX] = { 0 };
+	uint8_t hit[AD9081_HAL_STREAM_MAX];
+	uint8_t i, nb_hits = 0, flush = 0;
+	int32_t err;
+	AD9081_NULL_POINTER_RETURN(device);
+	AD9081_NULL_POINTER_RETURN(device->hal_info.spi_xfer);
+	AD9081_NULL_POINTER_RETURN(data);
+	AD9081_INVALID_PARAM_RETURN(len < 1);
+	AD9081_INVALID_PARAM_RETURN(reg + len > 0x4000);
+
+	if ((len == 1) || (len > AD9081_HAL_STREAM_MAX) ||
+	    !adi_ad9081_hal_can_stream(device)) {
+		for (i = 0; i < len; i++) {
+			err = adi_ad9081_hal_reg_get(device, reg + i, &data[i]);
+			AD9081_ERROR_RETURN(err);
+		}
+		return API_CMS_ERROR_OK;
+	}
+
+	for (i = 0; i < len; i++) {
+		hit[i] = adi_ad9081_hal_cache_get(device, reg + i, &data[i]);
+		if (hit[i])
+			nb_hits++;
+		else if (adi_ad9081_hal_reg_is_volatile(reg + i))
+			flush = 1;
+	}
+	if (nb_hits == len)
+		return API_CMS_ERROR_OK;
+	if (flush && (API_CMS_ERROR_OK != adi_ad9081_hal_batch_flush(device)))
+		return API_CMS_ERROR_SPI_XFER;
+
+	in_data[0] = ((reg >> 8) & 0x3F) | 0x80;
+	in_data[1] = ((reg >> 0) & 0xFF);
+	if (API_CMS_ERROR_OK !=
+	    adi_ad9081_hal_xfer(device, in_data, out_data, 2 + len))
+		return API_CMS_ERROR_SPI_XFER;
+	for (i = 0; i < len; i++) {
+		if (hit[i])
+			continue;
+		data[i] = out_data[2 + i];
+		adi_ad9081_hal_cache_put(device, reg + i, data[i]);
+		if (API_CMS_ERROR_OK != AD9081_LOG_SPIR(reg + i, data[i]))
+			return API_CMS_ERROR_LOG_WRITE;
+	}
+
+	return API_CMS_ERROR_OK;
+}
+
+int32_t adi_ad9081_hal_reg_stream_set(adi_ad9081_device_t *device,
+				      uint32_t reg, uint8_t *data, uint8_t len)
+{
+	uint8_t in_data[2 + AD9081_HAL_STREAM_MAX] = { 0 };
+	uint8_t out_data[2 + AD9081_HAL_STREAM_MAX] = { 0 };
+	uint8_t i;
+	int32_t err;
+	AD9081_NULL_POINTER_RETURN(device);
+	AD9081_NULL_POINTER_RETURN(device->hal_info.spi_xfer);
+	AD9081_NULL_POINTER_RETURN(data);
+	AD9081_INVALID_PARAM_RETURN(len < 1);
+	AD9081_INVALID_PARAM_RETURN(reg + len > 0x4000);
+
+	/* page selects, soft reset and batched writes need per register handling */
+	if ((len == 1) || (len > AD9081_HAL_STREAM_MAX) ||
+	    !adi_ad9081_hal_can_stream(device) ||
+	    (reg <= REG_PFILT_COEFF_PAGE_ADDR) ||
+	    ((device->hal_info.cache != NULL) &&
+	     device->hal_info.cache->batch_en)) {
+		for (i = 0; i < len; i++) {
+			err = adi_ad9081_hal_reg_set(device, reg + i, data[i]);
+			AD9081_ERROR_RETURN(err);
+		}
+		return API_CMS_ERROR_OK;
+	}
+
+	if (API_CMS_ERROR_OK != adi_ad9081_hal_batch_flush(device))
+		return API_CMS_ERROR_SPI_XFER;
+
+	in_data[0] = (reg >> 8) & 0x3F;
+	in_data[1] = (reg >> 0) & 0xFF;
+	memcpy(&in_data[2], data, len);
+	if (API_CMS_ERROR_OK !=
+	    adi_ad9081_hal_xfer(device, in_data, out_data, 2 + len))
+		return API_CMS_ERROR_SPI_XFER;
+	for (i = 0; i < len; i++) {
+		adi_ad9081_hal_cache_put(device, reg + i, data[i]);
+		if (API_CMS_ERROR_OK != AD9081_LOG_SPIW(reg + i, data[i]))
+			return API_CMS_ERROR_LOG_WRITE;
+	}
+
+	return API_CMS_ERROR_OK;
+}
+
+void adi_ad9081_hal_cache_invalidate(adi_ad9081_device_t *device)
+{
+	if ((device == NULL) || (device->hal_info.cache == NULL))
+		return;
+
+	memset(device->hal_info.cache->valid, 0,
+	       sizeof(device->hal_info.cache->valid));
+}
+
+int32_t adi_ad9081_hal_batch_begin(adi_ad9081_device_t *device)
+{
+	AD9081_NULL_POINTER_RETURN(device);
+	AD9081_NULL_POINTER_RETURN(device->hal_info.cache);
+
+	device->hal_info.cache->batch_en = 1;
+
+	return API_CMS_ERROR_OK;
+}
+
+int32_t adi_ad9081_hal_batch_commit(adi_ad9081_device_t *device)
+{
+	AD9081_NULL_POINTER_RETURN(device);
+	AD9081_NULL_POINTER_RETURN(device->hal_info.cache);
+
+	device->hal_info.cache->batch_en = 0;
+
+	return adi_ad9081_hal_batch_flush(device);
+}
+
 int32_t adi_ad9081_hal_cbusjrx_reg_get(adi_ad9081_device_t *device,
 				       uint32_t reg, uint8_t *data,
 				       uint8_t lane)
@@ -562,6 +921,7 @@ int32_t adi_ad9081_hal_bf_wait_to_clear(adi_ad9081_device_t *device,
 	for (i = 0; i < 200; i++) {
 		err = adi_ad9081_hal_delay_us(device, 20);
 		AD9081_ERROR_RETURN(err);
+		adi_ad9081_hal_cache_drop(device, reg, 1);
 		err = adi_ad9081_hal_bf_get(device, reg, info, &bf_value, 1);
 		AD9081_ERROR_RETURN(err);
 		if (bf_value == 0) {
@@ -584,6 +944,7 @@ int32_t adi_ad9081_hal_bf_wait_to_set(adi_ad9081_device_t *device, uint32_t reg,
 	for (i = 0; i < 200; i++) {
 		err = adi_ad9081_hal_delay_us(device, 20);
 		AD9081_ERROR_RETURN(err);
+		adi_ad9081_hal_cache_drop(device, reg, 1);
 		err = adi_ad9081_hal_bf_get(device, reg, info, &bf_value, 1);
 		AD9081_ERROR_RETURN(err);
 		if (bf_value == 1) {
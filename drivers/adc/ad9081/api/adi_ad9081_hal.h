@@ -159,6 +159,43 @@ int32_t adi_ad9081_hal_reg_get(adi_ad9081_device_t *device, uint32_t reg,
 			       uint8_t *data);
 int32_t adi_ad9081_hal_reg_set(adi_ad9081_device_t *device, uint32_t reg,
 			       uint32_t data);
+int32_t adi_ad9081_hal_reg_stream_get(adi_ad9081_device_t *device,
+				      uint32_t reg, uint8_t *data, uint8_t len);
+int32_t adi_ad9081_hal_reg_stream_set(adi_ad9081_device_t *device,
+				      uint32_t reg, uint8_t *data, uint8_t len);
+
+/**
+ * @ingroup dev_init
+ * @brief  Drop every register value held in the HAL shadow cache.
+ *
+ * \param[in]  device            Pointer to the device structure
+ */
+void adi_ad9081_hal_cache_invalidate(adi_ad9081_device_t *device);
+
+/**
+ * @ingroup dev_init
+ * @brief  Start deferring cacheable register writes.
+ *
+ * Writes are queued in issue order and sent when the queue fills, before any
+ * volatile access, page change or delay, and on adi_ad9081_hal_batch_commit().
+ * Consecutive register addresses are sent as one SPI streaming transaction.
+ *
+ * \param[in]  device            Pointer to the device structure
+ *
+ * \returns API_CMS_ERROR_OK is returned upon success, API_CMS_ERROR_NULL_PARAM
+ *          if the register cache is disabled.
+ */
+int32_t adi_ad9081_hal_batch_begin(adi_ad9081_device_t *device);
+
+/**
+ * @ingroup dev_init
+ * @brief  Send the deferred register writes and leave batch mode.
+ *
+ * \param[in]  device            Pointer to the device structure
+ *
+ * \returns API_CMS_ERROR_OK is returned upon success. Otherwise a failure code.
+ */
+int32_t adi_ad9081_hal_batch_commit(adi_ad9081_device_t *device);
 
 int32_t adi_ad9081_hal_cbusjrx_reg_get(adi_ad9081_device_t *device,
 				       uint32_t reg, uint8_t *data,
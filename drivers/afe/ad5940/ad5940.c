@@ -40,6 +40,7 @@
 #include "no_os_spi.h"
 #include "no_os_gpio.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
 #include "ad5940.h"
 
 static int AD5940_Initialize(struct ad5940_dev *dev);
@@ -195,6 +196,7 @@ int ad5940_remove(struct ad5940_dev *dev)
 	no_os_gpio_remove(dev->reset_gpio);
 	no_os_spi_remove(dev->spi);
 	dev->spi = NULL;
+	no_os_free(dev->fifo_buf);
 	no_os_free(dev);
 
 	return 0;
@@ -645,30 +647,32 @@ static int AD5940_SPIReadReg(struct no_os_spi_desc *spi, uint16_t RegAddr,
 	return 0;
 }
 
-static int AD5940_FIFORd_Fast(struct no_os_spi_desc *spi, uint32_t *pBuffer,
+static int AD5940_FIFORd_Fast(struct ad5940_dev *dev, uint32_t *pBuffer,
 			      uint32_t uiReadCount)
 {
 	int ret;
-	static uint32_t iobuf_alloc_sz = 0;
+	uint8_t setaddr[] = {SPICMD_SETADDR, 0, 0, 0, 0,
+			     (uint16_t)REG_AFE_DATAFIFORD >> 8,
+			     (uint8_t)REG_AFE_DATAFIFORD
+			    };
 	uint32_t iobuf_sz = 7 + uiReadCount * sizeof(uiReadCount);
-	static uint8_t *iobuf;
-	uint8_t *buf;
+	struct no_os_spi_msg msgs[2] = {0};
+	uint8_t *iobuf;
 	uint32_t i = 0;
 	uint32_t s = 0;
 
-	if (!iobuf_alloc_sz) {
-		iobuf = no_os_malloc(iobuf_sz);
-		if (!iobuf)
-			return -ENOMEM;
-	}
-
-	if (iobuf_alloc_sz < iobuf_sz) {
-		buf = realloc(iobuf, iobuf_sz);
-		if (!buf)
+	/* The buffer is kept across calls, it only grows with the read size */
+	if (dev->fifo_buf_sz < iobuf_sz) {
+		no_os_free(dev->fifo_buf);
+		dev->fifo_buf = no_os_malloc(iobuf_sz);
+		if (!dev->fifo_buf) {
+			dev->fifo_buf_sz = 0;
 			return -ENOMEM;
+		}
 
-		iobuf = buf;
+		dev->fifo_buf_sz = iobuf_sz;
 	}
+	iobuf = dev->fifo_buf;
 
 	// zero-out everything, needed for bytes 1 through 6 (dummy bytes).
 	memset(iobuf, 0, iobuf_sz);
@@ -677,15 +681,23 @@ static int AD5940_FIFORd_Fast(struct no_os_spi_desc *spi, uint32_t *pBuffer,
 	// set the MOSI output during last two samples to 0x44444444 for each.
 	memset(&iobuf[iobuf_sz - 8], 0x44, 8);
 
-	ret = no_os_spi_write_and_read(spi, iobuf, iobuf_sz);
+	/* Address and data phases go out back to back in a single transfer */
+	msgs[0].tx_buff = setaddr;
+	msgs[0].rx_buff = setaddr;
+	msgs[0].bytes_number = sizeof(setaddr);
+	msgs[0].cs_change = 1;
+	msgs[1].tx_buff = iobuf;
+	msgs[1].rx_buff = iobuf;
+	msgs[1].bytes_number = iobuf_sz;
+	msgs[1].cs_change = 1;
+
+	ret = no_os_spi_transfer(dev->spi, msgs, NO_OS_ARRAY_SIZE(msgs));
 	if (ret)
 		return ret;
 
 	for (i = 7; i < iobuf_sz; i += sizeof(uiReadCount))
-		pBuffer[s++] = iobuf[i] << 24 |
-			       iobuf[i + 1] << 16 |
-			       iobuf[i + 2] << 8 |
-			       iobuf[i + 3];
+		pBuffer[s++] = no_os_get_unaligned_be32(&iobuf[i]);
+
 	return 0;
 }
 
@@ -698,27 +710,258 @@ static int AD5940_FIFORd_Fast(struct no_os_spi_desc *spi, uint32_t *pBuffer,
 int ad5940_FIFORd(struct ad5940_dev *dev, uint32_t *pBuffer,
 		  uint32_t uiReadCount)
 {
-	int ret;
+	int ret = 0;
+	uint32_t i;
+
 	if (!dev)
 		return -EINVAL;
 
 	if (uiReadCount < 4) {
-		uint8_t i;
 		for (i = 0; i < uiReadCount; i++) {
 			ret = AD5940_SPIReadReg(dev->spi, REG_AFE_DATAFIFORD, &pBuffer[i]);
 			if (ret)
 				break;
 		}
 	} else {
-		uint8_t iobuf[] = {SPICMD_SETADDR, 0, 0, 0, 0, (uint16_t)REG_AFE_DATAFIFORD >> 8, (uint8_t)REG_AFE_DATAFIFORD};
-		ret = no_os_spi_write_and_read(dev->spi, iobuf, sizeof(iobuf));
+		ret = AD5940_FIFORd_Fast(dev, pBuffer, uiReadCount);
+	}
+
+	return ret;
+}
+
+/**
+  @brief Set up a data FIFO stream. The FIFO threshold interrupt is routed to
+         GP0 and the words read by ad5940_fifo_stream_isr() are queued in buf.
+  @param stream: The stream to set up.
+  @param buf: Ring buffer of the FIFO words, best a multiple of thresh.
+  @param nb_words: Size of the ring buffer, in words.
+  @param thresh: FIFO threshold, at least 4 words so the fast read is used.
+  @return 0 in case of success, negative error code otherwise.
+ **/
+int ad5940_fifo_stream_init(struct ad5940_dev *dev,
+			    struct ad5940_fifo_stream *stream,
+			    uint32_t *buf, uint32_t nb_words, uint32_t thresh)
+{
+	int ret;
+
+	if (!dev || !stream || !buf || thresh < 4 || thresh > nb_words)
+		return -EINVAL;
+
+	memset(stream, 0, sizeof(*stream));
+	ret = no_os_cb_cfg(&stream->ring, (int8_t *)buf,
+			   nb_words * sizeof(*buf));
+	if (ret)
+		return ret;
+	stream->thresh = thresh;
+
+	/* Sized for the whole FIFO, so the handler never allocates */
+	if (dev->fifo_buf_sz < AD5940_FIFO_BUF_MAX) {
+		no_os_free(dev->fifo_buf);
+		dev->fifo_buf = no_os_malloc(AD5940_FIFO_BUF_MAX);
+		if (!dev->fifo_buf) {
+			dev->fifo_buf_sz = 0;
+			return -ENOMEM;
+		}
+
+		dev->fifo_buf_sz = AD5940_FIFO_BUF_MAX;
+	}
+
+	ret = ad5940_FIFOThrshSet(dev, thresh);
+	if (ret)
+		return ret;
+
+	ret = ad5940_INTCCfg(dev, AFEINTC_0, AFEINTSRC_DATAFIFOTHRESH, true);
+	if (ret)
+		return ret;
+
+	return ad5940_INTCClrFlag(dev, AFEINTSRC_DATAFIFOTHRESH |
+				  AFEINTSRC_DATAFIFOOF);
+}
+
+/**
+  @brief Drain the data FIFO into the stream ring. Call it from the GP0
+         interrupt handler, or when GP0 is found low.
+  @param stream: The stream set up by ad5940_fifo_stream_init().
+  @return The number of words read in case of success, negative error code
+          otherwise. Words that do not fit in the ring are left in the FIFO.
+ **/
+int ad5940_fifo_stream_isr(struct ad5940_dev *dev,
+			   struct ad5940_fifo_stream *stream)
+{
+	uint32_t flags, cnt, used, size;
+	uint32_t nb = 0;
+	void *buf;
+	int ret;
+
+	if (!dev || !stream)
+		return -EINVAL;
+
+	ret = ad5940_INTCGetFlag(dev, AFEINTC_0, &flags);
+	if (ret)
+		return ret;
+	if (flags & AFEINTSRC_DATAFIFOOF)
+		stream->nb_overflows++;
+
+	/*
+	 * Clear before reading the count, so that words which reach the
+	 * threshold after it raise the interrupt again.
+	 */
+	ret = ad5940_INTCClrFlag(dev, AFEINTSRC_DATAFIFOTHRESH |
+				 AFEINTSRC_DATAFIFOOF);
+	if (ret)
+		return ret;
+
+	ret = ad5940_FIFOGetCnt(dev, &cnt);
+	if (ret)
+		return ret;
+	cnt = no_os_min(cnt, AD5940_DATAFIFO_MAX_WORDS);
+
+	ret = no_os_cb_size(&stream->ring, &used);
+	if (ret)
+		return ret;
+	cnt = no_os_min(cnt, (stream->ring.size - used) / sizeof(uint32_t));
+
+	/* At most two reads, when the free space wraps around the ring */
+	while (nb < cnt) {
+		ret = no_os_cb_prepare_async_write(&stream->ring,
+						   (cnt - nb) * sizeof(uint32_t),
+						   &buf, &size);
+		if (ret)
+			return ret;
+
+		size /= sizeof(uint32_t);
+		ret = ad5940_FIFORd(dev, buf, size);
+		if (ret)
+			return ret;
+
+		ret = no_os_cb_end_async_write(&stream->ring);
 		if (ret)
 			return ret;
 
-		ret = AD5940_FIFORd_Fast(dev->spi, pBuffer, uiReadCount);
+		nb += size;
 	}
+	stream->nb_words += nb;
 
-	return ret;
+	return nb;
+}
+
+/**
+  @brief Decode the words queued in the stream ring. The real and imaginary
+         parts of DFT results are merged, even across calls.
+  @param stream: The stream set up by ad5940_fifo_stream_init().
+  @param data: The decoded results.
+  @param nb: The maximum number of results.
+  @return The number of results in case of success, negative error code
+          otherwise.
+ **/
+int ad5940_fifo_stream_decode(struct ad5940_fifo_stream *stream,
+			      struct ad5940_fifo_data *data, uint32_t nb)
+{
+	uint32_t words[32];
+	uint32_t avail, cnt, tag, i;
+	struct ad5940_fifo_data *d;
+	uint32_t n = 0;
+	int32_t val;
+	int ret;
+
+	if (!stream || !data)
+		return -EINVAL;
+
+	while (n < nb) {
+		ret = no_os_cb_size(&stream->ring, &avail);
+		if (ret)
+			return ret;
+
+		/* Every word gives at most one result */
+		cnt = no_os_min(avail / sizeof(uint32_t), nb - n);
+		cnt = no_os_min(cnt, NO_OS_ARRAY_SIZE(words));
+		if (!cnt)
+			break;
+
+		ret = no_os_cb_read(&stream->ring, words, cnt * sizeof(uint32_t));
+		if (ret)
+			return ret;
+
+		for (i = 0; i < cnt; i++) {
+			d = &data[n];
+			tag = no_os_field_get(FIFOWORD_TAG_MSK, words[i]);
+			d->seqid = no_os_field_get(FIFOWORD_SEQID_MSK, words[i]);
+			d->chid = 0;
+			val = no_os_sign_extend32(words[i] & FIFOWORD_DATA18_MSK, 17);
+
+			switch (tag) {
+			case FIFOWORD_TAG_DFT:
+				if (!stream->dft_pending) {
+					stream->dft_real = val;
+					stream->dft_pending = true;
+					continue;
+				}
+				d->type = AD5940_FIFO_DFT;
+				d->val.Real = stream->dft_real;
+				d->val.Image = val;
+				stream->dft_pending = false;
+				break;
+			case FIFOWORD_TAG_MEAN:
+				d->type = AD5940_FIFO_MEAN;
+				d->val.Real = val;
+				d->val.Image = 0;
+				break;
+			case FIFOWORD_TAG_VAR:
+				d->type = AD5940_FIFO_VAR;
+				d->val.Real = val;
+				d->val.Image = 0;
+				break;
+			default:
+				d->type = AD5940_FIFO_ADC;
+				d->chid = no_os_field_get(FIFOWORD_CHID_MSK, words[i]);
+				d->val.Real = words[i] & FIFOWORD_DATA16_MSK;
+				d->val.Image = 0;
+				break;
+			}
+			n++;
+		}
+	}
+
+	return n;
+}
+
+/**
+  @brief Convert consecutive pairs of DFT results, voltage then current, to
+         impedances: Z = V / I * Rtia. The DFT block reports the conjugate of
+         the result, so both imaginary parts are negated first.
+  @param data: The results decoded by ad5940_fifo_stream_decode(). Results
+          other than DFT are skipped.
+  @param nb: The number of results.
+  @param rtia: The calibrated RTIA value.
+  @param z: The impedances, nb / 2 at most.
+  @return The number of impedances.
+ **/
+int ad5940_dft_to_impedance(const struct ad5940_fifo_data *data, uint32_t nb,
+			    fImpCar_Type *rtia, fImpCar_Type *z)
+{
+	iImpCar_Type dft[2];
+	fImpCar_Type ratio;
+	uint32_t i, k = 0;
+	int n = 0;
+
+	if (!data || !rtia || !z)
+		return -EINVAL;
+
+	for (i = 0; i < nb; i++) {
+		if (data[i].type != AD5940_FIFO_DFT)
+			continue;
+
+		dft[k].Real = data[i].val.Real;
+		dft[k].Image = -data[i].val.Image;
+		if (++k < 2)
+			continue;
+
+		ratio = ad5940_ComplexDivInt(&dft[0], &dft[1]);
+		z[n++] = ad5940_ComplexMulFloat(&ratio, rtia);
+		k = 0;
+	}
+
+	return n;
 }
 
 /** Write to address @ref RegAddr with data @RegData  */
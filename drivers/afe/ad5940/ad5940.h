@@ -34,8 +34,10 @@
 #ifndef _AD5940_H_
 #define _AD5940_H_
 #include <stdint.h>
+#include <stdbool.h>
 #include "no_os_spi.h"
 #include "no_os_gpio.h"
+#include "no_os_circular_buffer.h"
 
 /** @addtogroup AD5940_Library
   * @{
@@ -3299,6 +3301,26 @@ enum ad5940_afe_result {
 #define FIFOSRC_MEAN                5     /**< Statistic mean output */
 /** @} */
 
+/**
+ * @defgroup FIFOWORD_Const
+ * Fields of the words read from the data FIFO. DFT and statistic results are
+ * 18 bit wide and are told apart from ADC samples by the upper channel ID bits.
+ * @{
+*/
+#define FIFOWORD_ECC_MSK            0xFE000000    /**< ECC of the data word */
+#define FIFOWORD_SEQID_POS          23
+#define FIFOWORD_SEQID_MSK          0x01800000    /**< Sequence that wrote the word */
+#define FIFOWORD_CHID_POS           16
+#define FIFOWORD_CHID_MSK           0x007F0000    /**< ADC mux channel of ADC samples */
+#define FIFOWORD_TAG_POS            18
+#define FIFOWORD_TAG_MSK            0x007C0000    /**< Result type of 18 bit results */
+#define FIFOWORD_TAG_DFT            0x1F
+#define FIFOWORD_TAG_MEAN           0x1E
+#define FIFOWORD_TAG_VAR            0x1D
+#define FIFOWORD_DATA18_MSK         0x0003FFFF
+#define FIFOWORD_DATA16_MSK         0x0000FFFF
+/** @} */
+
 /**
  * @defgroup FIFOSIZE_Const
  * @brief Set FIFO size.
@@ -3933,6 +3955,45 @@ typedef struct {
 	int32_t Image;
 } iImpCar_Type;
 
+/**
+ * Type of a result read from the data FIFO
+ */
+enum ad5940_fifo_type {
+	AD5940_FIFO_ADC,
+	AD5940_FIFO_DFT,
+	AD5940_FIFO_MEAN,
+	AD5940_FIFO_VAR,
+};
+
+/**
+ * Result decoded from the data FIFO
+ */
+struct ad5940_fifo_data {
+	enum ad5940_fifo_type type;
+	uint8_t seqid;
+	uint8_t chid;       /* ADC mux channel, for ADC samples only */
+	iImpCar_Type val;   /* DFT results use both parts, the others only Real */
+};
+
+/* Largest data FIFO, FIFOSIZE_6KB, in words */
+#define AD5940_DATAFIFO_MAX_WORDS	(6144 / 4)
+/* SPI buffer of a fast read of the whole data FIFO */
+#define AD5940_FIFO_BUF_MAX		(7 + AD5940_DATAFIFO_MAX_WORDS * 4)
+
+/**
+ * Data FIFO stream. The FIFO threshold interrupt drives GP0 and the handler
+ * drains the FIFO into the ring with one fast read, while the results are
+ * decoded later, in batch, out of the interrupt context.
+ */
+struct ad5940_fifo_stream {
+	struct no_os_circular_buffer ring;
+	uint32_t thresh;        /* FIFO threshold, in words */
+	uint32_t nb_words;      /* Words read from the FIFO */
+	uint32_t nb_overflows;  /* Data FIFO overflows seen by the handler */
+	bool dft_pending;       /* Real part of a DFT result already decoded */
+	int32_t dft_real;
+};
+
 /**
  * Structure used to store register information(address and its data)
  * */
@@ -3972,6 +4033,8 @@ struct ad5940_dev {
 	struct no_os_gpio_desc *reset_gpio;
 	struct no_os_gpio_desc *gp0_gpio;
 	struct SeqGen SeqGenDB;
+	uint8_t *fifo_buf;      /* SPI buffer of the fast FIFO reads */
+	uint32_t fifo_buf_sz;
 };
 
 /**
@@ -3995,6 +4058,17 @@ int ad5940_WriteReg_mask(struct ad5940_dev *dev, uint16_t RegAddr,
 int ad5940_FIFORd(struct ad5940_dev *dev, uint32_t *pBuffer,
 		  uint32_t uiReadCount);
 
+/* Data FIFO stream */
+int ad5940_fifo_stream_init(struct ad5940_dev *dev,
+			    struct ad5940_fifo_stream *stream,
+			    uint32_t *buf, uint32_t nb_words, uint32_t thresh);
+int ad5940_fifo_stream_isr(struct ad5940_dev *dev,
+			   struct ad5940_fifo_stream *stream);
+int ad5940_fifo_stream_decode(struct ad5940_fifo_stream *stream,
+			      struct ad5940_fifo_data *data, uint32_t nb);
+int ad5940_dft_to_impedance(const struct ad5940_fifo_data *data, uint32_t nb,
+			    fImpCar_Type *rtia, fImpCar_Type *z);
+
 /* 2. AD5940 Top Control functions */
 int ad5940_AFECtrlS(struct ad5940_dev *dev, uint32_t AfeCtrlSet, bool State);
 int ad5940_LPModeCtrlS(struct ad5940_dev *dev, uint32_t EnSet);
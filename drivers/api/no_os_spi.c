@@ -37,6 +37,7 @@
 #include "no_os_error.h"
 #include "no_os_mutex.h"
 #include "no_os_alloc.h"
+#include "no_os_prof.h"
 
 /**
  * @brief spi_table contains the pointers towards the SPI buses
@@ -160,6 +161,7 @@ int32_t no_os_spi_write_and_read(struct no_os_spi_desc *desc,
 				 uint8_t *data,
 				 uint16_t bytes_number)
 {
+	uint64_t start;
 	int32_t ret;
 
 	if (!desc || !desc->platform_ops)
@@ -168,10 +170,14 @@ int32_t no_os_spi_write_and_read(struct no_os_spi_desc *desc,
 	if (!desc->platform_ops->write_and_read)
 		return -ENOSYS;
 
+	start = no_os_prof_start();
+
 	no_os_mutex_lock(desc->bus->mutex);
 	ret =  desc->platform_ops->write_and_read(desc, data, bytes_number);
 	no_os_mutex_unlock(desc->bus->mutex);
 
+	no_os_prof_record(NO_OS_PROF_SPI, NO_OS_PROF_SITE, start, bytes_number);
+
 	return ret;
 }
 
@@ -186,14 +192,23 @@ int32_t no_os_spi_transfer(struct no_os_spi_desc *desc,
 			   struct no_os_spi_msg *msgs,
 			   uint32_t len)
 {
+	uint32_t bytes = 0;
+	uint64_t start;
 	int32_t  ret = 0;
 	uint32_t i;
 
 	if (!desc || !desc->platform_ops)
 		return -EINVAL;
 
-	if (desc->platform_ops->transfer)
-		return desc->platform_ops->transfer(desc, msgs, len);
+	if (desc->platform_ops->transfer) {
+		start = no_os_prof_start();
+		ret = desc->platform_ops->transfer(desc, msgs, len);
+		for (i = 0; i < len; i++)
+			bytes += msgs[i].bytes_number;
+		no_os_prof_record(NO_OS_PROF_SPI, NO_OS_PROF_SITE, start, bytes);
+
+		return ret;
+	}
 
 	no_os_mutex_lock(desc->bus->mutex);
 
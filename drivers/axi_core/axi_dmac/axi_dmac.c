@@ -286,6 +286,12 @@ static int32_t axi_dmac_detect_caps(struct axi_dmac *dmac)
 	/* Restore initial value for AXI_DMAC_REG_FLAGS register */
 	axi_dmac_write(dmac, AXI_DMAC_REG_FLAGS, initial_reg_val);
 
+	/* Check if HW scatter-gather possible */
+	axi_dmac_write(dmac, AXI_DMAC_REG_SG_ADDRESS, 0xffffffff);
+	axi_dmac_read(dmac, AXI_DMAC_REG_SG_ADDRESS, &reg_val);
+	dmac->hw_sg = reg_val != 0;
+	axi_dmac_write(dmac, AXI_DMAC_REG_SG_ADDRESS, 0x0);
+
 	/* Get maximum burst size and set value. */
 	axi_dmac_write(dmac, AXI_DMAC_REG_X_LENGTH, dmac->max_length);
 	axi_dmac_read(dmac, AXI_DMAC_REG_X_LENGTH, &dmac->max_length);
@@ -348,6 +354,20 @@ free:
 	return -1;
 }
 
+/*******************************************************************************
+ * @brief Forget the scatter-gather transfer and free its descriptors.
+ *
+ * @param dmac - DMAC istance.
+*******************************************************************************/
+static void axi_dmac_sg_release(struct axi_dmac *dmac)
+{
+	no_os_free(dmac->sg_desc_alloc);
+
+	dmac->sg_desc = NULL;
+	dmac->sg_desc_alloc = NULL;
+	dmac->sg_nb = 0;
+}
+
 /*******************************************************************************
  * @brief Remove the DMAC instance.
  *
@@ -360,6 +380,7 @@ int32_t axi_dmac_remove(struct axi_dmac *dmac)
 	if (!dmac)
 		return -1;
 
+	axi_dmac_sg_release(dmac);
 	no_os_free(dmac);
 
 	return 0;
@@ -421,9 +442,11 @@ int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
 		axi_dmac_write(dmac, AXI_DMAC_REG_FLAGS, reg_val);
 	}
 
-	/* Enable DMA if not already enabled. */
+	/* Enable DMA if not already enabled, leaving scatter-gather mode. */
 	axi_dmac_read(dmac, AXI_DMAC_REG_CTRL, &reg_val);
-	if (!(reg_val & AXI_DMAC_CTRL_ENABLE)) {
+	if (!(reg_val & AXI_DMAC_CTRL_ENABLE) ||
+	    (reg_val & AXI_DMAC_CTRL_ENABLE_SG)) {
+		axi_dmac_sg_release(dmac);
 		axi_dmac_write(dmac, AXI_DMAC_REG_CTRL, 0x0);
 		axi_dmac_write(dmac, AXI_DMAC_REG_CTRL, AXI_DMAC_CTRL_ENABLE);
 		axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_MASK, 0x0);
@@ -519,7 +542,16 @@ int32_t axi_dmac_transfer_wait_completion(struct axi_dmac *dmac,
 	uint32_t timeout = 0;
 	uint32_t reg_val = 0;
 
-	if (dmac->irq_option == IRQ_ENABLED) {
+	if (dmac->sg_nb && dmac->irq_option == IRQ_DISABLED) {
+		while (axi_dmac_sg_poll(dmac), !dmac->transfer.transfer_done) {
+			timeout++;
+			no_os_mdelay(1);
+			if (timeout == timeout_ms) {
+				printf("Error transferring data using DMA.\n");
+				return -1;
+			}
+		}
+	} else if (dmac->irq_option == IRQ_ENABLED) {
 		while (!dmac->transfer.transfer_done) {
 			timeout++;
 			no_os_mdelay(1);
@@ -555,3 +587,200 @@ void axi_dmac_transfer_stop(struct axi_dmac *dmac)
 {
 	axi_dmac_write(dmac, AXI_DMAC_REG_CTRL, AXI_DMAC_CTRL_DISABLE);
 }
+
+/*******************************************************************************
+ * @brief ISR for scatter-gather transfers. Reports the completed segments
+ *			through axi_dmac_sg_poll().
+ *
+ * @param instance - the instance that triggered the ISR.
+*******************************************************************************/
+void axi_dmac_sg_isr(void *instance)
+{
+	struct axi_dmac *dmac = (struct axi_dmac *)instance;
+	uint32_t reg_val;
+
+	/* Get interrupt sources and clear interrupts. */
+	axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
+	axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_PENDING, reg_val);
+
+	if (reg_val & AXI_DMAC_IRQ_EOT)
+		axi_dmac_sg_poll(dmac);
+}
+
+/*******************************************************************************
+ * @brief Start a hardware scatter-gather transfer.
+ *
+ * Builds one linked hardware descriptor per segment and hands the chain to
+ * the DMAC with a single submit, so no CPU intervention is needed between
+ * segments. With cyclic set the last descriptor points back to the first one
+ * and the ring runs until axi_dmac_transfer_stop().
+ *
+ * The DMAC writes the transfer ID back into each descriptor when done; this
+ * is how axi_dmac_sg_poll() tells which segments are complete. When the
+ * descriptors are in cached memory, pass the dcache callbacks: the chain is
+ * flushed before the submit and each descriptor is invalidated before its ID
+ * is read. Descriptors are 64 bytes, so an aligned array never shares a cache
+ * line with other data.
+ *
+ * @param dmac - DMAC istance.
+ * @param sg - Structure containing the segments and completion callback.
+ *
+ * @return 0 for success, negative error code otherwise.
+*******************************************************************************/
+int32_t axi_dmac_transfer_sg(struct axi_dmac *dmac,
+			     const struct axi_dmac_sg_transfer *sg)
+{
+	const struct axi_dmac_sg_segment *seg;
+	volatile struct axi_dmac_hw_desc *desc;
+	uint64_t desc_phys;
+	uint32_t reg_val;
+	uint32_t i;
+
+	if (!dmac || !sg || !sg->segments || !sg->nb_segments)
+		return -EINVAL;
+
+	if (!dmac->hw_sg)
+		return -ENOTSUP;
+
+	if (sg->desc && (sg->desc_phys & 0x7))
+		return -EINVAL;
+
+	if (sg->cyclic == CYCLIC && dmac->direction == DMA_MEM_TO_MEM)
+		return -EINVAL;
+
+	for (i = 0; i < sg->nb_segments; i++) {
+		seg = &sg->segments[i];
+		if (!seg->size || seg->size - 1 > dmac->max_length)
+			return -EINVAL;
+
+		if (dmac->direction != DMA_MEM_TO_DEV &&
+		    seg->dest_addr % (dmac->width_dst / 8))
+			return -EINVAL;
+
+		if (dmac->direction != DMA_DEV_TO_MEM &&
+		    seg->src_addr % (dmac->width_src / 8))
+			return -EINVAL;
+	}
+
+	axi_dmac_read(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, &reg_val);
+	if (reg_val & AXI_DMAC_QUEUE_FULL)
+		return -EBUSY;
+
+	axi_dmac_sg_release(dmac);
+
+	if (sg->desc) {
+		desc = sg->desc;
+		desc_phys = sg->desc_phys;
+	} else {
+		/* One spare entry to align the chain on a cache line. */
+		dmac->sg_desc_alloc = no_os_calloc(sg->nb_segments + 1,
+						   sizeof(*desc));
+		if (!dmac->sg_desc_alloc)
+			return -ENOMEM;
+		desc_phys = ((uintptr_t)dmac->sg_desc_alloc + sizeof(*desc) - 1) &
+			    ~(uintptr_t)(sizeof(*desc) - 1);
+		desc = (struct axi_dmac_hw_desc *)(uintptr_t)desc_phys;
+	}
+
+	for (i = 0; i < sg->nb_segments; i++) {
+		seg = &sg->segments[i];
+		desc[i].flags = AXI_DMAC_HW_FLAG_IRQ;
+		desc[i].id = AXI_DMAC_SG_UNUSED;
+		desc[i].dest_addr = seg->dest_addr;
+		desc[i].src_addr = seg->src_addr;
+		desc[i].next_sg_addr = desc_phys + (i + 1) * sizeof(*desc);
+		desc[i].y_len = 0;
+		desc[i].x_len = seg->size - 1;
+		desc[i].src_stride = 0;
+		desc[i].dst_stride = 0;
+	}
+
+	if (sg->cyclic == CYCLIC) {
+		desc[i - 1].next_sg_addr = desc_phys;
+	} else {
+		desc[i - 1].flags |= AXI_DMAC_HW_FLAG_LAST;
+		desc[i - 1].next_sg_addr = 0;
+	}
+
+	dmac->sg_desc = desc;
+	dmac->sg_nb = sg->nb_segments;
+	dmac->sg_next = 0;
+	dmac->sg_cyclic = sg->cyclic;
+	dmac->sg_complete = sg->complete;
+	dmac->sg_ctx = sg->ctx;
+	dmac->sg_flush = sg->dcache_flush_range;
+	dmac->sg_invalidate = sg->dcache_invalidate_range;
+	dmac->remaining_size = 0;
+	dmac->transfer.cyclic = sg->cyclic;
+	dmac->transfer.transfer_done = false;
+
+	/* The ring is closed by the descriptors, not by the cyclic flag. */
+	axi_dmac_read(dmac, AXI_DMAC_REG_FLAGS, &reg_val);
+	axi_dmac_write(dmac, AXI_DMAC_REG_FLAGS, reg_val & ~DMA_CYCLIC);
+
+	/* Enable DMA in scatter-gather mode; only EOT is of interest. */
+	axi_dmac_read(dmac, AXI_DMAC_REG_CTRL, &reg_val);
+	if (reg_val != (AXI_DMAC_CTRL_ENABLE | AXI_DMAC_CTRL_ENABLE_SG)) {
+		axi_dmac_write(dmac, AXI_DMAC_REG_CTRL, 0x0);
+		axi_dmac_write(dmac, AXI_DMAC_REG_CTRL,
+			       AXI_DMAC_CTRL_ENABLE | AXI_DMAC_CTRL_ENABLE_SG);
+	}
+	axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_MASK, AXI_DMAC_IRQ_SOT);
+
+	if (dmac->sg_flush)
+		dmac->sg_flush((uintptr_t)desc, sg->nb_segments * sizeof(*desc));
+
+	axi_dmac_write(dmac, AXI_DMAC_REG_SG_ADDRESS, (uint32_t)desc_phys);
+	axi_dmac_write(dmac, AXI_DMAC_REG_SG_ADDRESS_HIGH,
+		       (uint32_t)(desc_phys >> 32));
+	axi_dmac_write(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT,
+		       AXI_DMAC_TRANSFER_SUBMIT);
+
+	return 0;
+}
+
+/*******************************************************************************
+ * @brief Report the scatter-gather segments completed since the last call.
+ *
+ * Calls the completion callback once per segment, in order. In cyclic mode
+ * the descriptors are re-armed so the ring can be reported again on the next
+ * pass; otherwise transfer_done is set once the last segment completes.
+ *
+ * @param dmac - DMAC istance.
+ *
+ * @return Number of segments completed.
+*******************************************************************************/
+uint32_t axi_dmac_sg_poll(struct axi_dmac *dmac)
+{
+	volatile struct axi_dmac_hw_desc *desc;
+	uint32_t done = 0;
+	uint32_t idx;
+
+	while (dmac->sg_nb && !dmac->transfer.transfer_done) {
+		idx = dmac->sg_next;
+		desc = &dmac->sg_desc[idx];
+		if (dmac->sg_invalidate)
+			dmac->sg_invalidate((uintptr_t)desc, sizeof(*desc));
+		if (desc->id == AXI_DMAC_SG_UNUSED)
+			break;
+
+		if (dmac->sg_cyclic == CYCLIC) {
+			desc->id = AXI_DMAC_SG_UNUSED;
+			if (dmac->sg_flush)
+				dmac->sg_flush((uintptr_t)desc, sizeof(*desc));
+		}
+
+		dmac->sg_next = idx + 1;
+		if (dmac->sg_next == dmac->sg_nb) {
+			dmac->sg_next = 0;
+			if (dmac->sg_cyclic != CYCLIC)
+				dmac->transfer.transfer_done = true;
+		}
+		done++;
+
+		if (dmac->sg_complete)
+			dmac->sg_complete(dmac->sg_ctx, idx);
+	}
+
+	return done;
+}
@@ -52,6 +52,7 @@
 #define AXI_DMAC_CTRL_ENABLE		NO_OS_BIT(0)
 #define AXI_DMAC_CTRL_DISABLE		0u
 #define AXI_DMAC_CTRL_PAUSE			NO_OS_BIT(1)
+#define AXI_DMAC_CTRL_ENABLE_SG		NO_OS_BIT(2)
 
 #define AXI_DMAC_REG_TRANSFER_ID		0x404
 #define AXI_DMAC_REG_TRANSFER_SUBMIT	0x408
@@ -65,6 +66,14 @@
 #define AXI_DMAC_REG_DEST_STRIDE		0x420
 #define AXI_DMAC_REG_SRC_STRIDE			0x424
 #define AXI_DMAC_REG_TRANSFER_DONE		0x428
+#define AXI_DMAC_REG_SG_ADDRESS			0x47c
+#define AXI_DMAC_REG_SG_ADDRESS_HIGH	0x4bc
+
+/* Hardware descriptor flags */
+#define AXI_DMAC_HW_FLAG_LAST			NO_OS_BIT(0)
+#define AXI_DMAC_HW_FLAG_IRQ			NO_OS_BIT(1)
+/* Descriptor ID until the DMAC writes back the completed transfer ID */
+#define AXI_DMAC_SG_UNUSED				0xffffffffu
 
 enum use_irq {
 	IRQ_DISABLED = 0,
@@ -98,12 +107,52 @@ struct axi_dma_transfer {
 	uint32_t dest_addr;
 };
 
+/* Hardware scatter-gather descriptor, as read and updated by the DMAC. */
+struct axi_dmac_hw_desc {
+	uint32_t flags;
+	uint32_t id;
+	uint64_t dest_addr;
+	uint64_t src_addr;
+	uint64_t next_sg_addr;
+	uint32_t y_len;
+	uint32_t x_len;
+	uint32_t src_stride;
+	uint32_t dst_stride;
+	uint64_t __pad[2];
+};
+
+/* One block of a scatter-gather transfer. */
+struct axi_dmac_sg_segment {
+	uint32_t size;
+	uint32_t src_addr;
+	uint32_t dest_addr;
+};
+
+struct axi_dmac_sg_transfer {
+	/* Blocks, each at most max_length + 1 bytes */
+	const struct axi_dmac_sg_segment *segments;
+	uint32_t nb_segments;
+	/* Link the last descriptor back to the first one */
+	enum cyclic_transfer cyclic;
+	/* nb_segments descriptors, 64-byte aligned if cached; allocated if NULL */
+	struct axi_dmac_hw_desc *desc;
+	/* Bus address of desc, only used when desc is provided */
+	uint64_t desc_phys;
+	/* Called for each completed segment, from axi_dmac_sg_poll() */
+	void (*complete)(void *ctx, uint32_t segment);
+	void *ctx;
+	/* Descriptor cache maintenance, NULL when desc is not cached */
+	void (*dcache_flush_range)(uint32_t address, uint32_t bytes_count);
+	void (*dcache_invalidate_range)(uint32_t address, uint32_t bytes_count);
+};
+
 struct axi_dmac {
 	const char *name;
 	uint32_t base;
 	enum use_irq irq_option;
 	enum dma_direction direction;
 	bool hw_cyclic;
+	bool hw_sg;
 	uint32_t max_length;
 	uint32_t width_dst;
 	uint32_t width_src;
@@ -113,6 +162,16 @@ struct axi_dmac {
 	uint32_t remaining_size;
 	uint32_t next_src_addr;
 	uint32_t next_dest_addr;
+	//Scatter-gather transfer properties
+	volatile struct axi_dmac_hw_desc *sg_desc;
+	void *sg_desc_alloc;
+	uint32_t sg_nb;
+	uint32_t sg_next;
+	enum cyclic_transfer sg_cyclic;
+	void (*sg_complete)(void *ctx, uint32_t segment);
+	void *sg_ctx;
+	void (*sg_flush)(uint32_t address, uint32_t bytes_count);
+	void (*sg_invalidate)(uint32_t address, uint32_t bytes_count);
 };
 
 struct axi_dmac_init {
@@ -125,6 +184,7 @@ void axi_dmac_dev_to_mem_isr(void *instance);
 void axi_dmac_mem_to_dev_isr(void *instance);
 void axi_dmac_mem_to_mem_isr(void *instance);
 void axi_dmac_write_isr(void *instance);
+void axi_dmac_sg_isr(void *instance);
 int32_t axi_dmac_read(struct axi_dmac *dmac, uint32_t reg_addr,
 		      uint32_t *reg_data);
 int32_t axi_dmac_write(struct axi_dmac *dmac, uint32_t reg_addr,
@@ -138,5 +198,8 @@ int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
 int32_t axi_dmac_transfer_wait_completion(struct axi_dmac *dmac,
 		uint32_t timeout_ms);
 void axi_dmac_transfer_stop(struct axi_dmac *dmac);
+int32_t axi_dmac_transfer_sg(struct axi_dmac *dmac,
+			     const struct axi_dmac_sg_transfer *sg);
+uint32_t axi_dmac_sg_poll(struct axi_dmac *dmac);
 
 #endif
@@ -371,6 +371,108 @@ int32_t	iio_axi_adc_read_dev(void *dev, void *buff, uint32_t nb_samples)
 	return 0;
 }
 
+/**
+ * @brief Publish a block filled by the scatter-gather ring.
+ * @param ctx - Instance of the iio_axi_adc
+ * @param segment - Index of the completed block
+ */
+static void iio_axi_adc_sg_complete(void *ctx, uint32_t segment)
+{
+	struct iio_axi_adc_desc *iio_adc = ctx;
+	struct iio_buffer *buffer = iio_adc->sg_buffer;
+	uint32_t size;
+	void *buff;
+
+	if (!buffer)
+		return;
+
+	if (iio_adc->dcache_invalidate_range)
+		iio_adc->dcache_invalidate_range((uintptr_t)buffer->buf->buff +
+						 segment * buffer->size,
+						 buffer->size);
+
+	/* Blocks tile the buffer, so the write index follows the ring. */
+	if (!no_os_cb_prepare_async_write(buffer->buf, buffer->size, &buff,
+					  &size))
+		no_os_cb_end_async_write(buffer->buf);
+}
+
+/**
+ * @brief Start the scatter-gather ring on the first refill, then report the
+ * blocks completed since the previous refill.
+ * @param dev_data - IIO device data
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int32_t iio_axi_adc_submit_sg(struct iio_device_data *dev_data)
+{
+	struct iio_axi_adc_desc *iio_adc = dev_data->dev;
+	struct iio_buffer *buffer = dev_data->buffer;
+	struct axi_dmac_sg_segment *segments;
+	struct axi_dmac_sg_transfer sg;
+	uint32_t nb_blocks;
+	uint32_t i;
+	int32_t ret;
+
+	if (iio_adc->sg_buffer) {
+		if (iio_adc->dmac->irq_option == IRQ_DISABLED)
+			axi_dmac_sg_poll(iio_adc->dmac);
+
+		return 0;
+	}
+
+	if (buffer->dir != IIO_DIRECTION_INPUT || !buffer->size ||
+	    buffer->buf->write.idx)
+		return -EINVAL;
+
+	nb_blocks = buffer->buf->size / buffer->size;
+	segments = no_os_calloc(nb_blocks, sizeof(*segments));
+	if (!segments)
+		return -ENOMEM;
+
+	for (i = 0; i < nb_blocks; i++) {
+		segments[i].size = buffer->size;
+		segments[i].dest_addr = (uintptr_t)buffer->buf->buff +
+					i * buffer->size;
+	}
+
+	sg = (struct axi_dmac_sg_transfer) {
+		.segments = segments,
+		.nb_segments = nb_blocks,
+		.cyclic = CYCLIC,
+		.complete = iio_axi_adc_sg_complete,
+		.ctx = iio_adc,
+		.dcache_flush_range = iio_adc->dcache_flush_range,
+		.dcache_invalidate_range = iio_adc->dcache_invalidate_range,
+	};
+
+	/* Publish from the first completion on. */
+	iio_adc->sg_buffer = buffer;
+	ret = axi_dmac_transfer_sg(iio_adc->dmac, &sg);
+	no_os_free(segments);
+	if (ret)
+		iio_adc->sg_buffer = NULL;
+
+	return ret;
+}
+
+/**
+ * @brief Stop the scatter-gather ring.
+ * @param dev - Instance of the iio_axi_adc
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int32_t iio_axi_adc_post_disable(void *dev)
+{
+	struct iio_axi_adc_desc *iio_adc = dev;
+
+	if (!iio_adc->sg_buffer)
+		return 0;
+
+	axi_dmac_transfer_stop(iio_adc->dmac);
+	iio_adc->sg_buffer = NULL;
+
+	return 0;
+}
+
 /**
  * @brief Delete iio_device.
  * @param iio_device - Structure describing a device, channels and attributes.
@@ -438,6 +540,10 @@ static int32_t iio_axi_adc_create_device_descriptor(
 
 	iio_device->pre_enable = iio_axi_adc_prepare_transfer;
 	iio_device->read_dev = iio_axi_adc_read_dev;
+	if (desc->sg_capture) {
+		iio_device->submit = iio_axi_adc_submit_sg;
+		iio_device->post_disable = iio_axi_adc_post_disable;
+	}
 
 	return 0;
 error:
@@ -493,6 +599,13 @@ int32_t iio_axi_adc_init(struct iio_axi_adc_desc **desc,
 	if (init->rx_dmac) {
 		iio_axi_adc_inst->dmac = init->rx_dmac;
 		iio_axi_adc_inst->dcache_invalidate_range = init->dcache_invalidate_range;
+		iio_axi_adc_inst->dcache_flush_range = init->dcache_flush_range;
+		iio_axi_adc_inst->sg_capture = init->sg_capture;
+	}
+
+	if (iio_axi_adc_inst->sg_capture && !iio_axi_adc_inst->dmac->hw_sg) {
+		no_os_free(iio_axi_adc_inst);
+		return -ENOTSUP;
 	}
 	iio_axi_adc_inst->get_sampling_frequency = init->get_sampling_frequency;
 
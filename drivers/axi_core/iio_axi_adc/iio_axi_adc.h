@@ -51,6 +51,12 @@ struct iio_axi_adc_desc {
 	struct axi_dmac *dmac;
 	/** Invalidate cache memory function pointer */
 	void (*dcache_invalidate_range)(uint32_t address, uint32_t bytes_count);
+	/** Flush cache memory function pointer */
+	void (*dcache_flush_range)(uint32_t address, uint32_t bytes_count);
+	/** Capture through a cyclic scatter-gather ring */
+	bool sg_capture;
+	/** Buffer the scatter-gather ring is writing, NULL when stopped */
+	struct iio_buffer *sg_buffer;
 	/** Custom implementation for get sampling frequency */
 	int (*get_sampling_frequency)(struct axi_adc *dev, uint32_t chan,
 				      uint64_t *sampling_freq_hz);
@@ -73,6 +79,11 @@ struct iio_axi_adc_init_param {
 	struct axi_dmac *rx_dmac;
 	/** Invalidate the Data cache for the given address range */
 	void (*dcache_invalidate_range)(uint32_t address, uint32_t bytes_count);
+	/** Flush the Data cache for the given address range */
+	void (*dcache_flush_range)(uint32_t address, uint32_t bytes_count);
+	/** Capture into the whole IIO buffer through a cyclic scatter-gather
+	    ring, one descriptor per block; needs a DMAC with scatter-gather */
+	bool sg_capture;
 	/** Custom sampling frequency getter */
 	int (*get_sampling_frequency)(struct axi_adc *dev, uint32_t chan,
 				      uint64_t *sampling_freq_hz);
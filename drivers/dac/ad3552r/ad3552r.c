@@ -1487,6 +1487,17 @@ err:
 	return err;
 }
 
+static void ad3552r_stream_free(struct ad3552r_desc *desc)
+{
+	if (!desc->stream)
+		return;
+
+	no_os_free(desc->stream->frame[0]);
+	no_os_free(desc->stream->frame[1]);
+	no_os_free(desc->stream);
+	desc->stream = NULL;
+}
+
 int32_t ad3552r_remove(struct ad3552r_desc *desc)
 {
 	if (desc->ldac)
@@ -1496,6 +1507,7 @@ int32_t ad3552r_remove(struct ad3552r_desc *desc)
 	if (!desc->axi)
 		no_os_spi_remove(desc->spi);
 
+	ad3552r_stream_free(desc);
 	no_os_free(desc);
 
 	return 0;
@@ -1950,6 +1962,309 @@ int32_t ad3552r_write_samples(struct ad3552r_desc *desc, uint16_t *data,
 	return 0;
 }
 
+/*
+ * On platforms without a time base no_os_get_time() stays at 0. The stream
+ * runs the same, but only the frame and sample counts of the statistics are
+ * kept.
+ */
+static uint64_t ad3552r_stream_now_us(void)
+{
+	struct no_os_time t = no_os_get_time();
+
+	return (uint64_t)t.s * 1000000 + t.us;
+}
+
+static void ad3552r_stream_done(void *ctx)
+{
+	struct ad3552r_stream *st = ctx;
+
+	st->last_end_us = ad3552r_stream_now_us();
+	st->busy = false;
+}
+
+/*
+ * Account the time the outputs held the last sample set before the first
+ * one of the frame sent at start_us.
+ */
+static void ad3552r_stream_account(struct ad3552r_desc *desc,
+				   uint64_t start_us)
+{
+	struct ad3552r_stream *st = desc->stream;
+	struct ad3552r_stream_stats *stats = &desc->stream_stats;
+	uint64_t gap_us;
+
+	if (!stats->nb_frames) {
+		st->start_us = start_us;
+		return;
+	}
+
+	/* Allow for the 1 us resolution of no_os_get_time() */
+	gap_us = start_us > st->last_end_us ? start_us - st->last_end_us : 0;
+	if (gap_us * 1000 > st->period_ns + 1000) {
+		stats->nb_underruns++;
+		stats->held_us += gap_us;
+	}
+}
+
+/* Wait for the frame in flight, if any, to be sent. */
+static int32_t ad3552r_stream_wait(struct ad3552r_stream *st)
+{
+	uint32_t timeout_us = st->timeout_us;
+
+	while (st->busy) {
+		if (!timeout_us--)
+			return -ETIMEDOUT;
+		no_os_udelay(1);
+	}
+
+	return 0;
+}
+
+static int32_t ad3552r_stream_send(struct ad3552r_desc *desc)
+{
+	struct ad3552r_stream *st = desc->stream;
+	struct ad3552r_stream_stats *stats = &desc->stream_stats;
+	struct no_os_spi_msg *msg = &st->msg[st->cur];
+	uint64_t end, wire_us;
+	int32_t err;
+
+	/* Only one frame on the bus, the other one is being filled */
+	err = ad3552r_stream_wait(st);
+	if (err)
+		return err;
+
+	/*
+	 * Sent in place, as the no_os_spi_transfer() fallback on
+	 * write_and_read requires. The instruction byte is read over.
+	 */
+	st->frame[st->cur][0] = st->instr;
+	msg->tx_buff = st->frame[st->cur];
+	msg->rx_buff = st->frame[st->cur];
+	msg->bytes_number = 1 + st->fill * st->loop_len;
+	msg->cs_change = 1;
+
+	if (st->async) {
+		/* Before the callback can move last_end_us */
+		ad3552r_stream_account(desc, ad3552r_stream_now_us());
+		st->busy = true;
+		err = no_os_spi_transfer_dma_async(desc->spi, msg, 1,
+						   ad3552r_stream_done, st);
+		if (err == -ENOSYS) {
+			st->busy = false;
+			st->async = false;
+		} else if (NO_OS_IS_ERR_VALUE(err)) {
+			st->busy = false;
+			return err;
+		}
+	}
+
+	if (!st->async) {
+		/*
+		 * The call overhead cannot be told apart from the wire time,
+		 * it is all taken as a gap before the frame.
+		 */
+		err = no_os_spi_transfer(desc->spi, msg, 1);
+		if (NO_OS_IS_ERR_VALUE(err))
+			return err;
+
+		end = ad3552r_stream_now_us();
+		wire_us = (uint64_t)msg->bytes_number * 8 * 1000000 /
+			  desc->spi->max_speed_hz;
+		ad3552r_stream_account(desc, end > wire_us ? end - wire_us : 0);
+		st->last_end_us = end;
+	}
+
+	stats->nb_frames++;
+	stats->nb_samples += st->fill;
+	stats->elapsed_us = st->last_end_us - st->start_us;
+	st->cur ^= 1;
+	st->fill = 0;
+
+	return 0;
+}
+
+/**
+ * @brief Start streaming samples over plain SPI.
+ *
+ * The chip is put in streaming mode with a loop over the DAC registers of
+ * the channels in ch_mask, so one SPI frame carries one instruction byte
+ * and then block_samples sample sets. Frames are double buffered and sent
+ * with DMA when the platform supports it, otherwise synchronously.
+ * @param desc - The device structure.
+ * @param ch_mask - Channels to stream. Ex. 0b11 (both channels)
+ * @param block_samples - Sample sets per frame, 0 for the largest frame.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad3552r_spi_stream_start(struct ad3552r_desc *desc, uint32_t ch_mask,
+				 uint32_t block_samples)
+{
+	struct ad3552r_stream *st;
+	uint32_t max_samples;
+	uint8_t ch, top, is_fast;
+	int32_t err;
+
+	if (!desc || desc->axi || desc->crc_en || desc->stream)
+		return -EINVAL;
+
+	if (!ch_mask || (ch_mask & ~AD3552R_MASK_ALL_CH) ||
+	    !desc->spi->max_speed_hz)
+		return -EINVAL;
+
+	if (ch_mask == AD3552R_MASK_ALL_CH &&
+	    desc->ch_data[0].fast_en != desc->ch_data[1].fast_en)
+		return -EINVAL;
+
+	/* The loop starts on the highest register and goes down */
+	top = no_os_find_last_set_bit(ch_mask);
+	is_fast = desc->ch_data[top].fast_en;
+
+	st = no_os_calloc(1, sizeof(*st));
+	if (!st)
+		return -ENOMEM;
+
+	st->ch_mask = ch_mask;
+	st->reg_len = is_fast ? 2 : 3;
+	st->loop_len = st->reg_len * no_os_hweight32(ch_mask);
+	st->period_ns = (uint64_t)st->loop_len * 8 * 1000000000 /
+			desc->spi->max_speed_hz;
+	st->async = true;
+
+	max_samples = (AD3552R_STREAM_FRAME_MAX - 1) / st->loop_len;
+	if (!block_samples || block_samples > max_samples)
+		block_samples = max_samples;
+	st->block_samples = block_samples;
+	/* Twice the wire time of a frame, plus the DMA start latency */
+	st->timeout_us = (uint64_t)(1 + block_samples * st->loop_len) * 16 *
+			 1000000 / desc->spi->max_speed_hz +
+			 AD3552R_STREAM_TIMEOUT_US;
+	st->instr = ad3552r_get_code_reg_addr(top, 1, is_fast);
+
+	desc->stream = st;
+	memset(&desc->stream_stats, 0, sizeof(desc->stream_stats));
+
+	for (ch = 0; ch < 2; ch++) {
+		st->frame[ch] = no_os_calloc(1, 1 + block_samples * st->loop_len);
+		if (!st->frame[ch]) {
+			err = -ENOMEM;
+			goto err_free;
+		}
+	}
+
+	/* Streaming mode, keeping the loop length between transactions */
+	err = _ad3552r_update_reg_field(desc,
+					AD3552R_REG_ADDR_INTERFACE_CONFIG_B,
+					AD3552R_MASK_SINGLE_INST, 0);
+	if (err)
+		goto err_free;
+
+	err = _ad3552r_update_reg_field(desc,
+					AD3552R_REG_ADDR_TRANSFER_REGISTER,
+					AD3552R_MASK_STREAM_LENGTH_KEEP_VALUE,
+					1);
+	if (err)
+		goto err_single_inst;
+
+	err = ad3552r_write_reg(desc, AD3552R_REG_ADDR_STREAM_MODE,
+				st->loop_len);
+	if (err)
+		goto err_single_inst;
+
+	return 0;
+
+err_single_inst:
+	_ad3552r_update_reg_field(desc, AD3552R_REG_ADDR_INTERFACE_CONFIG_B,
+				  AD3552R_MASK_SINGLE_INST, 1);
+err_free:
+	ad3552r_stream_free(desc);
+
+	return err;
+}
+
+/**
+ * @brief Queue samples on the plain SPI stream.
+ *
+ * A frame is sent each time block_samples sample sets are queued.
+ * @param desc - The device structure.
+ * @param data - Samples, one per active channel for each set, in the order
+ *               of ad3552r_write_samples().
+ * @param samples - Number of sample sets.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad3552r_spi_stream_write(struct ad3552r_desc *desc,
+				 const uint16_t *data, uint32_t samples)
+{
+	struct ad3552r_stream *st;
+	uint8_t nb_ch, *p;
+	uint32_t i;
+	int32_t err;
+
+	if (!desc || !desc->stream || (samples && !data))
+		return -EINVAL;
+
+	st = desc->stream;
+	nb_ch = no_os_hweight32(st->ch_mask);
+	for (i = 0; i < samples; i++, data += nb_ch) {
+		p = st->frame[st->cur] + 1 + st->fill * st->loop_len;
+		no_os_put_unaligned_be16(data[0], p);
+		if (nb_ch == 2)
+			no_os_put_unaligned_be16(data[1], p + st->reg_len);
+
+		if (++st->fill < st->block_samples)
+			continue;
+
+		err = ad3552r_stream_send(desc);
+		if (NO_OS_IS_ERR_VALUE(err))
+			return err;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Stop the plain SPI stream.
+ *
+ * The queued samples are sent, then the chip goes back to single
+ * instruction mode. The statistics stay in desc->stream_stats.
+ * @param desc - The device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad3552r_spi_stream_stop(struct ad3552r_desc *desc)
+{
+	int32_t err = 0, ret;
+
+	if (!desc || !desc->stream)
+		return -EINVAL;
+
+	if (desc->stream->fill)
+		err = ad3552r_stream_send(desc);
+
+	/* The frame may still be in flight, keep the buffers for a retry */
+	ret = ad3552r_stream_wait(desc->stream);
+	if (ret)
+		return ret;
+
+	if (desc->stream_stats.nb_frames)
+		desc->stream_stats.elapsed_us = desc->stream->last_end_us -
+						desc->stream->start_us;
+
+	ret = _ad3552r_update_reg_field(desc,
+					AD3552R_REG_ADDR_INTERFACE_CONFIG_B,
+					AD3552R_MASK_SINGLE_INST, 1);
+	if (!err)
+		err = ret;
+
+	ret = _ad3552r_update_reg_field(desc,
+					AD3552R_REG_ADDR_TRANSFER_REGISTER,
+					AD3552R_MASK_STREAM_LENGTH_KEEP_VALUE,
+					0);
+	if (!err)
+		err = ret;
+
+	ad3552r_stream_free(desc);
+
+	return err;
+}
+
 #ifdef AD3552R_DEBUG
 
 int32_t ad3552r_get_status(struct ad3552r_desc *desc, uint32_t *status,
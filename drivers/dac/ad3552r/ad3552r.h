@@ -381,6 +381,53 @@ struct ad3552r_ch_data {
 	uint8_t fast_en;
 };
 
+/* Largest frame of the plain SPI stream, the default spidev buffer size */
+#define AD3552R_STREAM_FRAME_MAX	4096
+/* Margin over the wire time of a frame when waiting for it to be sent */
+#define AD3552R_STREAM_TIMEOUT_US	10000
+
+struct ad3552r_stream_stats {
+	/* SPI frames sent */
+	uint32_t nb_frames;
+	/* Sample sets (one code per active channel) sent */
+	uint64_t nb_samples;
+	/* Frame boundaries where the outputs held for more than one period */
+	uint32_t nb_underruns;
+	/* Total time the outputs held between frames */
+	uint64_t held_us;
+	/* Time from the first to the last frame */
+	uint64_t elapsed_us;
+};
+
+/* Plain SPI stream, the samples loop over the DAC registers of the channels */
+struct ad3552r_stream {
+	/* Frames, one is filled while the other one is sent */
+	uint8_t *frame[2];
+	struct no_os_spi_msg msg[2];
+	/* Frame being filled and number of sample sets in it */
+	uint8_t cur;
+	uint32_t fill;
+	/* Sample sets per frame */
+	uint32_t block_samples;
+	/* Instruction byte starting each frame */
+	uint8_t instr;
+	/* Active channels, bytes per channel and per sample set */
+	uint8_t ch_mask;
+	uint8_t reg_len;
+	uint8_t loop_len;
+	/* Output period of a sample set at the SPI clock */
+	uint32_t period_ns;
+	/* Frames are sent with no_os_spi_transfer_dma_async() */
+	bool async;
+	/* An asynchronous frame is in flight */
+	volatile bool busy;
+	/* Longest wait for the frame in flight */
+	uint32_t timeout_us;
+	/* Start of the first frame and end of the last one */
+	uint64_t start_us;
+	volatile uint64_t last_end_us;
+};
+
 struct ad3552r_desc {
 	struct ad3552_transfer_config spi_cfg;
 	struct no_os_spi_desc *spi;
@@ -400,6 +447,8 @@ struct ad3552r_desc {
 	uint8_t is_simultaneous : 1;
 	uint8_t single_transfer : 1;
 	uint8_t axi: 1;
+	struct ad3552r_stream *stream;
+	struct ad3552r_stream_stats stream_stats;
 };
 
 struct ad3552r_custom_output_range_cfg {
@@ -520,6 +569,21 @@ int32_t ad3552r_write_samples(struct ad3552r_desc *desc, uint16_t *data,
 
 int32_t ad3552r_simulatneous_update_enable(struct ad3552r_desc *desc);
 
+/*
+ * Streaming over plain SPI. Sample sets of the channels in ch_mask are looped
+ * over their DAC registers, block_samples sets per SPI frame (0 for the
+ * largest frame that fits AD3552R_STREAM_FRAME_MAX).
+ */
+int32_t ad3552r_spi_stream_start(struct ad3552r_desc *desc, uint32_t ch_mask,
+				 uint32_t block_samples);
+
+/* Queue samples, interleaved like for ad3552r_write_samples() */
+int32_t ad3552r_spi_stream_write(struct ad3552r_desc *desc,
+				 const uint16_t *data, uint32_t samples);
+
+/* Send the last partial frame and go back to single instruction mode */
+int32_t ad3552r_spi_stream_stop(struct ad3552r_desc *desc);
+
 /* DMA buffering, fast mode, AXI QSPI */
 int32_t ad3552r_axi_write_data(struct ad3552r_desc *desc, uint32_t *buf,
 			       uint16_t samples, bool cyclic, int cyclic_secs);
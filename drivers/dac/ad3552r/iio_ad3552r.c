@@ -184,12 +184,42 @@ static int32_t iio_ad3552r_read_reg(struct iio_ad3552r_desc *iio_dac,
 	return err;
 }
 
+static int iio_ad3552r_underruns_get(void *device, char *buf, uint32_t len,
+				     const struct iio_ch_info *channel,
+				     intptr_t priv)
+{
+	struct iio_ad3552r_desc *iio_dac = device;
+	int32_t val = iio_dac->dac->stream_stats.nb_underruns;
+
+	return iio_format_value(buf, len, IIO_VAL_INT, 1, &val);
+}
+
+static struct iio_attribute iio_ad3552r_dev_attributes[] = {
+	{
+		.name = "stream_underruns",
+		.show = iio_ad3552r_underruns_get,
+	},
+	END_ATTRIBUTES_ARRAY,
+};
+
 static int32_t iio_ad3552r_prep_wr(struct iio_ad3552r_desc *iio_dac,
 				   uint32_t mask)
 {
 	iio_dac->mask = mask;
 
-	return 0;
+	/* Without the AXI core, stream over plain SPI when possible */
+	if (iio_dac->dac->axi || iio_dac->dac->crc_en)
+		return 0;
+
+	return ad3552r_spi_stream_start(iio_dac->dac, mask, 0);
+}
+
+static int32_t iio_ad3552r_post_disable(struct iio_ad3552r_desc *iio_dac)
+{
+	if (!iio_dac->dac->stream)
+		return 0;
+
+	return ad3552r_spi_stream_stop(iio_dac->dac);
 }
 
 static int32_t iio_ad3552r_wr_dev(struct iio_ad3552r_desc *iio_dac,
@@ -203,6 +233,9 @@ static int32_t iio_ad3552r_wr_dev(struct iio_ad3552r_desc *iio_dac,
 	for (i = 0; i < nb_samples * no_os_hweight32(iio_dac->mask); ++i)
 		buff[i] = no_os_get_unaligned_be16((uint8_t *)&buff[i]);
 
+	if (iio_dac->dac->stream)
+		return ad3552r_spi_stream_write(iio_dac->dac, buff, nb_samples);
+
 	return ad3552r_write_samples(iio_dac->dac, buff, nb_samples,
 				     iio_dac->mask,
 				     AD3552R_WRITE_INPUT_REGS_AND_TRIGGER_LDAC);
@@ -238,6 +271,8 @@ int32_t iio_ad3552r_init(struct iio_ad3552r_desc **iio_dac,
 	liio_dac->iio_desc.channels = liio_dac->channels;
 	liio_dac->iio_desc.write_dev = (int32_t (*)())iio_ad3552r_wr_dev;
 	liio_dac->iio_desc.pre_enable = (int32_t (*)())iio_ad3552r_prep_wr;
+	liio_dac->iio_desc.post_disable = (int32_t (*)())iio_ad3552r_post_disable;
+	liio_dac->iio_desc.attributes = iio_ad3552r_dev_attributes;
 	liio_dac->iio_desc.debug_reg_read = (int32_t (*)())iio_ad3552r_read_reg;
 	liio_dac->iio_desc.debug_reg_write = (int32_t (*)())iio_ad3552r_write_reg;
 
@@ -33,8 +33,10 @@
 ******************************************************************************/
 
 #include <stdlib.h>
+#include <errno.h>
 #include "ad5686.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
 
 static const uint32_t ad5683_channel_addr [] = {
 	[AD5686_CH_0] = 0,
@@ -88,198 +90,231 @@ static const struct ad5686_chip_info chip_info[] = {
 		.register_map = AD5686_REG_MAP,
 		.communication = I2C,
 		.channel_addr = ad5676_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5676_channel_addr),
 	},
 	[ID_AD5672R] = {
 		.resolution = 12,
 		.register_map = AD5686_REG_MAP,
 		.communication = SPI,
 		.channel_addr = ad5676_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5676_channel_addr),
 	},
 	[ID_AD5673R] = {
 		.resolution = 12,
 		.register_map = AD5686_REG_MAP,
 		.communication = I2C,
 		.channel_addr = ad5679_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5679_channel_addr),
 	},
 	[ID_AD5674] = {
 		.resolution = 12,
 		.register_map = AD5686_REG_MAP,
 		.communication = SPI,
 		.channel_addr = ad5679_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5679_channel_addr),
 	},
 	[ID_AD5674R] = {
 		.resolution = 12,
 		.register_map = AD5686_REG_MAP,
 		.communication = SPI,
 		.channel_addr = ad5679_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5679_channel_addr),
 	},
 	[ID_AD5675R] = {
 		.resolution = 16,
 		.register_map = AD5686_REG_MAP,
 		.communication = I2C,
 		.channel_addr = ad5676_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5676_channel_addr),
 	},
 	[ID_AD5676] = {
 		.resolution = 16,
 		.register_map = AD5686_REG_MAP,
 		.communication = SPI,
 		.channel_addr = ad5676_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5676_channel_addr),
 	},
 	[ID_AD5676R] = {
 		.resolution = 16,
 		.register_map = AD5686_REG_MAP,
 		.communication = SPI,
 		.channel_addr = ad5676_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5676_channel_addr),
 	},
 	[ID_AD5677R] = {
 		.resolution = 16,
 		.register_map = AD5686_REG_MAP,
 		.communication = I2C,
 		.channel_addr = ad5679_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5679_channel_addr),
 	},
 	[ID_AD5679] = {
 		.resolution = 16,
 		.register_map = AD5686_REG_MAP,
 		.communication = SPI,
 		.channel_addr = ad5679_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5679_channel_addr),
 	},
 	[ID_AD5679R] = {
 		.resolution = 16,
 		.register_map = AD5686_REG_MAP,
 		.communication = SPI,
 		.channel_addr = ad5679_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5679_channel_addr),
 	},
 	[ID_AD5684R] = {
 		.resolution = 12,
 		.register_map = AD5686_REG_MAP,
 		.communication = SPI,
 		.channel_addr = ad5686_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5686_channel_addr),
 	},
 	[ID_AD5685R] = {
 		.resolution = 14,
 		.register_map = AD5686_REG_MAP,
 		.communication = SPI,
 		.channel_addr = ad5686_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5686_channel_addr),
 	},
 	[ID_AD5686] = {
 		.resolution = 16,
 		.register_map = AD5686_REG_MAP,
 		.communication = SPI,
 		.channel_addr = ad5686_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5686_channel_addr),
 	},
 	[ID_AD5686R] = {
 		.resolution = 16,
 		.register_map = AD5686_REG_MAP,
 		.communication = SPI,
 		.channel_addr = ad5686_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5686_channel_addr),
 	},
 	[ID_AD5687] = {
 		.resolution = 12,
 		.register_map = AD5686_REG_MAP,
 		.communication = SPI,
 		.channel_addr = ad5689_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5689_channel_addr),
 	},
 	[ID_AD5687R] = {
 		.resolution = 12,
 		.register_map = AD5686_REG_MAP,
 		.communication = SPI,
 		.channel_addr = ad5689_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5689_channel_addr),
 	},
 	[ID_AD5689] = {
 		.resolution = 16,
 		.register_map = AD5686_REG_MAP,
 		.communication = SPI,
 		.channel_addr = ad5689_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5689_channel_addr),
 	},
 	[ID_AD5689R] = {
 		.resolution = 16,
 		.register_map = AD5686_REG_MAP,
 		.communication = SPI,
 		.channel_addr = ad5689_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5689_channel_addr),
 	},
 	[ID_AD5697R] = {
 		.resolution = 12,
 		.register_map = AD5686_REG_MAP,
 		.communication = I2C,
 		.channel_addr = ad5689_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5689_channel_addr),
 	},
 	[ID_AD5694] = {
 		.resolution = 12,
 		.register_map = AD5686_REG_MAP,
 		.communication = I2C,
 		.channel_addr = ad5686_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5686_channel_addr),
 	},
 	[ID_AD5694R] = {
 		.resolution = 12,
 		.register_map = AD5686_REG_MAP,
 		.communication = I2C,
 		.channel_addr = ad5686_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5686_channel_addr),
 	},
 	[ID_AD5695R] = {
 		.resolution = 14,
 		.register_map = AD5686_REG_MAP,
 		.communication = I2C,
 		.channel_addr = ad5686_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5686_channel_addr),
 	},
 	[ID_AD5696] = {
 		.resolution = 16,
 		.register_map = AD5686_REG_MAP,
 		.communication = I2C,
 		.channel_addr = ad5686_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5686_channel_addr),
 	},
 	[ID_AD5696R] = {
 		.resolution = 16,
 		.register_map = AD5686_REG_MAP,
 		.communication = I2C,
 		.channel_addr = ad5686_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5686_channel_addr),
 	},
 	[ID_AD5681R] = {
 		.resolution = 12,
 		.register_map = AD5683_REG_MAP,
 		.communication = SPI,
 		.channel_addr = ad5683_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5683_channel_addr),
 	},
 	[ID_AD5682R] = {
 		.resolution = 14,
 		.register_map = AD5683_REG_MAP,
 		.communication = SPI,
 		.channel_addr = ad5683_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5683_channel_addr),
 	},
 	[ID_AD5683R] = {
 		.resolution = 16,
 		.register_map = AD5683_REG_MAP,
 		.communication = SPI,
 		.channel_addr = ad5683_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5683_channel_addr),
 	},
 	[ID_AD5683] = {
 		.resolution = 16,
 		.register_map = AD5683_REG_MAP,
 		.communication = SPI,
 		.channel_addr = ad5683_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5683_channel_addr),
 	},
 	[ID_AD5691R] = {
 		.resolution = 12,
 		.register_map = AD5683_REG_MAP,
 		.communication = I2C,
 		.channel_addr = ad5683_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5683_channel_addr),
 	},
 	[ID_AD5692R] = {
 		.resolution = 14,
 		.register_map = AD5683_REG_MAP,
 		.communication = I2C,
 		.channel_addr = ad5683_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5683_channel_addr),
 	},
 	[ID_AD5693R] = {
 		.resolution = 16,
 		.register_map = AD5683_REG_MAP,
 		.communication = I2C,
 		.channel_addr = ad5683_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5683_channel_addr),
 	},
 	[ID_AD5693] = {
 		.resolution = 16,
 		.register_map = AD5683_REG_MAP,
 		.communication = I2C,
 		.channel_addr = ad5683_channel_addr,
+		.num_channels = NO_OS_ARRAY_SIZE(ad5683_channel_addr),
 	}
 };
 
@@ -365,6 +400,36 @@ int32_t ad5686_remove(struct ad5686_dev *dev)
 	return ret;
 }
 
+/**************************************************************************//**
+ * @brief Fill the input shift register frame of a command.
+ *
+ * @param dev     - The device structure.
+ * @param command - The command.
+ * @param address - The address.
+ * @param data    - The data.
+ * @param buf     - The PKT_LENGTH bytes frame.
+ *
+ * @return None.
+******************************************************************************/
+static void ad5686_pack_shift_reg(struct ad5686_dev *dev,
+				  uint8_t command,
+				  uint8_t address,
+				  uint16_t data,
+				  uint8_t *buf)
+{
+	if (chip_info[dev->act_device].register_map == AD5686_REG_MAP) {
+		buf[0] = ((command & AD5686_CMD_MASK) << CMD_OFFSET) | \
+			 (address & ADDR_MASK);
+		buf[1] = (data & AD5686_MSB_MASK) >> AD5686_MSB_OFFSET;
+		buf[2] = (data & AD5686_LSB_MASK);
+	} else {
+		buf[0] = ((command & AD5683_CMD_MASK) << CMD_OFFSET) |
+			 ((data >> AD5683_MSB_OFFSET) & AD5683_MSB_MASK);
+		buf[1] = (data >> AD5683_MIDB_OFFSET) & AD5683_MIDB_MASK;
+		buf[2] = (data & AD5683_LSB_MASK) << AD5683_LSB_OFFSET;
+	}
+}
+
 /**************************************************************************//**
  * @brief Write to input shift register.
  *
@@ -383,17 +448,7 @@ uint16_t ad5686_set_shift_reg(struct ad5686_dev *dev,
 	uint8_t data_buff [ PKT_LENGTH ] = {0, 0, 0};
 	uint16_t read_back_data = 0;
 
-	if (chip_info[dev->act_device].register_map == AD5686_REG_MAP) {
-		data_buff[0] = ((command & AD5686_CMD_MASK) << CMD_OFFSET) | \
-			       (address & ADDR_MASK);
-		data_buff[1] = (data & AD5686_MSB_MASK) >> AD5686_MSB_OFFSET;
-		data_buff[2] = (data & AD5686_LSB_MASK);
-	} else {
-		data_buff[0] = ((command & AD5683_CMD_MASK) << CMD_OFFSET) |
-			       ((data >> AD5683_MSB_OFFSET) & AD5683_MSB_MASK);
-		data_buff[1] = (data >> AD5683_MIDB_OFFSET) & AD5683_MIDB_MASK;
-		data_buff[2] = (data & AD5683_LSB_MASK) << AD5683_LSB_OFFSET;
-	}
+	ad5686_pack_shift_reg(dev, command, address, data, data_buff);
 
 	if (chip_info[dev->act_device].communication == SPI) {
 		no_os_spi_write_and_read(dev->spi_desc, data_buff, PKT_LENGTH);
@@ -739,3 +794,37 @@ int32_t ad5686_gain_mode(struct ad5686_dev *dev, uint8_t value)
 					    AD5683_CTRL_GM(value));
 	return -1;
 }
+
+/**************************************************************************//**
+ * @brief Fill the frame of an input register write, for no_os_dac_batch.
+ *
+ * @param dev   - The device structure.
+ * @param ch    - The channel.
+ * @param code  - The DAC code.
+ * @param frame - The PKT_LENGTH bytes frame.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+******************************************************************************/
+static int ad5686_batch_pack_write(void *dev, uint8_t ch, uint32_t code,
+				   uint8_t *frame)
+{
+	struct ad5686_dev *ad5686 = dev;
+	const struct ad5686_chip_info *info = &chip_info[ad5686->act_device];
+
+	if (info->communication != SPI || ch >= info->num_channels)
+		return -EINVAL;
+
+	if (code >> info->resolution)
+		return -EINVAL;
+
+	ad5686_pack_shift_reg(ad5686, AD5686_CTRL_WRITE, info->channel_addr[ch],
+			      code << (MAX_RESOLUTION - info->resolution), frame);
+
+	return 0;
+}
+
+/* Input register writes, loaded by the LDAC pin. NOP frames are all zeros. */
+const struct no_os_dac_batch_ops ad5686_dac_batch_ops = {
+	.frame_size = PKT_LENGTH,
+	.pack_write = ad5686_batch_pack_write,
+};
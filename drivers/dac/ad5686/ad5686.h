@@ -38,6 +38,7 @@
 #include "no_os_gpio.h"
 #include "no_os_spi.h"
 #include "no_os_i2c.h"
+#include "no_os_dac_batch.h"
 
 /* Control Bits */
 #define AD5686_CTRL_NOP          0
@@ -168,6 +169,7 @@ struct ad5686_chip_info {
 	uint8_t		register_map;
 	enum comm_type	communication;
 	const uint32_t *channel_addr;
+	uint8_t		num_channels;
 };
 
 struct ad5686_dev {
@@ -256,3 +258,6 @@ void ad5686_read_back_en(struct ad5686_dev *dev,
 
 /* Set Gain mode */
 int32_t ad5686_gain_mode(struct ad5686_dev *dev, uint8_t value);
+
+/* Frame encoders for no_os_dac_batch, the LDAC pin must be provided */
+extern const struct no_os_dac_batch_ops ad5686_dac_batch_ops;
@@ -505,3 +505,68 @@ int32_t ltc268x_remove(struct ltc268x_dev *dev)
 
 	return ret;
 }
+
+/**
+ * @brief Fill the frame of a channel code write, for no_os_dac_batch.
+ * @param dev - The device structure.
+ * @param ch - The channel.
+ * @param code - The DAC code.
+ * @param frame - The 3 bytes frame.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int ltc268x_batch_pack_write(void *dev, uint8_t ch, uint32_t code,
+				    uint8_t *frame)
+{
+	struct ltc268x_dev *ltc268x = dev;
+
+	if (ch >= (ltc268x->dev_id == LTC2688 ? 16 : 8) || code > 0xFFFF)
+		return -EINVAL;
+
+	frame[0] = LTC268X_CMD_CH_CODE(ch, ltc268x->dev_id);
+	frame[1] = code >> 8;
+	frame[2] = code & 0xFF;
+
+	return 0;
+}
+
+/**
+ * @brief Fill a no-op frame, for no_os_dac_batch.
+ * @param dev - The device structure.
+ * @param frame - The 3 bytes frame.
+ * @return 0.
+ */
+static int ltc268x_batch_pack_nop(void *dev, uint8_t *frame)
+{
+	NO_OS_UNUSED_PARAM(dev);
+
+	frame[0] = LTC268X_CMD_NOOP;
+	frame[1] = 0;
+	frame[2] = 0;
+
+	return 0;
+}
+
+/**
+ * @brief Fill an update all channels frame, for no_os_dac_batch.
+ * @param dev - The device structure.
+ * @param frame - The 3 bytes frame.
+ * @return 0.
+ */
+static int ltc268x_batch_pack_update(void *dev, uint8_t *frame)
+{
+	NO_OS_UNUSED_PARAM(dev);
+
+	frame[0] = LTC268X_CMD_UPDATE_ALL;
+	frame[1] = 0;
+	frame[2] = 0;
+
+	return 0;
+}
+
+/* Channel code writes, loaded by an update all command or the LDAC pin. */
+const struct no_os_dac_batch_ops ltc268x_dac_batch_ops = {
+	.frame_size = 3,
+	.pack_write = ltc268x_batch_pack_write,
+	.pack_nop = ltc268x_batch_pack_nop,
+	.pack_update = ltc268x_batch_pack_update,
+};
@@ -36,6 +36,7 @@
 #include "no_os_spi.h"
 #include "no_os_util.h"
 #include "no_os_delay.h"
+#include "no_os_dac_batch.h"
 #include "errno.h"
 
 #define LTC268X_CHANNEL_SEL(x, id)			(id ? x : (x << 1))
@@ -176,4 +177,7 @@ int32_t ltc268x_init(struct ltc268x_dev **device,
 		     struct ltc268x_init_param init_param);
 int32_t ltc268x_remove(struct ltc268x_dev *dev);
 
+/* Frame encoders for no_os_dac_batch */
+extern const struct no_os_dac_batch_ops ltc268x_dac_batch_ops;
+
 #endif // __LTC268X_H__
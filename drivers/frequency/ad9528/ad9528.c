@@ -384,6 +384,9 @@ int32_t ad9528_clk_recalc_rate(struct no_os_clk_desc *desc,
 	return 0;
 }
 
+static int32_t ad9528_clk_set_div(struct ad9528_dev *dev, uint32_t chan,
+				  uint32_t rate);
+
 /**
  * @brief Set the clock rate.
  *
@@ -476,12 +479,39 @@ static int ad9528_clk_disable(struct no_os_clk_desc *desc)
 	return 0;
 }
 
+/**
+ * @brief Set the rate of several channels with a single IO update.
+ *
+ * @param desc - The CLK descriptors, all of the same device.
+ * @param rates - The desired rates.
+ * @param nb_clks - Number of clocks.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int ad9528_clk_set_rates_no_os(struct no_os_clk_desc **desc,
+				      const uint64_t *rates, uint32_t nb_clks)
+{
+	struct ad9528_dev *dev = desc[0]->dev_desc;
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i < nb_clks; i++) {
+		ret = ad9528_clk_set_div(dev, desc[i]->hw_ch_num,
+					 (uint32_t)rates[i]);
+		if (ret)
+			return ret;
+	}
+
+	return ad9528_io_update(dev);
+}
+
 static const struct no_os_clk_platform_ops ad9528_no_os_clk_ops = {
 	.clk_recalc_rate = &ad9528_clk_recalc_rate,
 	.clk_enable = &ad9528_clk_enable,
 	.clk_disable = &ad9528_clk_disable,
 	.clk_round_rate = &ad9528_clk_round_rate_no_os,
 	.clk_set_rate = &ad9528_clk_set_rate_no_os,
+	.clk_set_rates = &ad9528_clk_set_rates_no_os,
 };
 
 static int ad9528_lmfc_lemc_validate(struct ad9528_dev *dev, uint64_t dividend,
@@ -713,7 +743,7 @@ int32_t ad9528_setup(struct ad9528_dev **device,
 	uint32_t pll2_ndiv, pll2_ndiv_a_cnt, pll2_ndiv_b_cnt;
 	struct ad9528_dev *dev;
 	struct no_os_clk_desc **clocks = NULL;
-	struct no_os_clk_init_param clk_init;
+	struct no_os_clk_init_param clk_init = { 0 };
 	const char *names[AD9528_NUM_CHAN] = {
 		"ad9528-1_out0", "ad9528-1_out1", "ad9528-1_out2", "ad9528-1_out3", "ad9528-1_out4",
 		"ad9528-1_out5", "ad9528-1_out6", "ad9528-1_out7", "ad9528-1_out8", "ad9528-1_out9",
@@ -743,6 +773,7 @@ int32_t ad9528_setup(struct ad9528_dev **device,
 			clk_init.hw_ch_num = i;
 			clk_init.platform_ops = &ad9528_no_os_clk_ops;
 			clk_init.dev_desc = dev;
+			clk_init.flags = NO_OS_CLK_CACHE_RATE;
 
 			ret = no_os_clk_init(&clocks[i], &clk_init);
 			if (ret) {
@@ -1208,7 +1239,31 @@ uint32_t ad9528_clk_round_rate(struct ad9528_dev *dev, uint32_t chan,
 }
 
 /***************************************************************************//**
- * @brief Set channel rate.
+ * @brief Drop the cached rates affected by a divider change.
+ *
+ * @param dev - is a pointer to the ad9528_dev data structure.
+ * @param chan - Channel number.
+ *******************************************************************************/
+static void ad9528_clk_invalidate(struct ad9528_dev *dev, uint32_t chan)
+{
+	uint32_t i;
+
+	if (!dev->clk_desc)
+		return;
+
+	if (dev->pdata->channels[chan].signal_source != AD9528_SYSREF) {
+		no_os_clk_invalidate_rate(dev->clk_desc[chan]);
+		return;
+	}
+
+	/* The SYSREF divider is shared by all the SYSREF outputs */
+	for (i = 0; i < AD9528_NUM_CHAN; i++)
+		no_os_clk_invalidate_rate(dev->clk_desc[i]);
+}
+
+/***************************************************************************//**
+ * @brief Program the divider of a channel. The new value takes effect on the
+ *        next IO update.
  *
  * @param dev - is a pointer to the ad9528_dev data structure.
  * @param chan - Channel number.
@@ -1216,8 +1271,8 @@ uint32_t ad9528_clk_round_rate(struct ad9528_dev *dev, uint32_t chan,
  *
  * @return 0 in case of success, negative error code otherwise.
  *******************************************************************************/
-int32_t ad9528_clk_set_rate(struct ad9528_dev *dev, uint32_t chan,
-			    uint32_t rate)
+static int32_t ad9528_clk_set_div(struct ad9528_dev *dev, uint32_t chan,
+				  uint32_t rate)
 {
 	uint32_t signal_source;
 	uint32_t reg_val;
@@ -1245,10 +1300,9 @@ int32_t ad9528_clk_set_rate(struct ad9528_dev *dev, uint32_t chan,
 				NO_OS_DIV_ROUND_CLOSEST(dev->ad9528_st.sysref_src_pll2,
 							tmp);
 
-		ret = ad9528_io_update(dev);
-		if (ret)
-			return ret;
-		goto out;
+		ad9528_clk_invalidate(dev, chan);
+
+		return ret;
 	}
 
 	// make a copy of the channel control register.
@@ -1271,12 +1325,30 @@ int32_t ad9528_clk_set_rate(struct ad9528_dev *dev, uint32_t chan,
 	if (ret)
 		return ret;
 
-	ret = ad9528_io_update(dev);
+	ad9528_clk_invalidate(dev, chan);
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Set channel rate.
+ *
+ * @param dev - is a pointer to the ad9528_dev data structure.
+ * @param chan - Channel number.
+ * @param rate - Channel rate in Hz.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+ *******************************************************************************/
+int32_t ad9528_clk_set_rate(struct ad9528_dev *dev, uint32_t chan,
+			    uint32_t rate)
+{
+	int32_t ret;
+
+	ret = ad9528_clk_set_div(dev, chan, rate);
 	if (ret)
 		return ret;
 
-out:
-	return 0;
+	return ad9528_io_update(dev);
 }
 
 /***************************************************************************//**
@@ -461,6 +461,9 @@ int32_t hmc7044_clk_set_rate(struct hmc7044_dev *dev, uint32_t chan_num,
 	div = hmc7044_calc_out_div(rate, dev->pll2_freq);
 	chan->divider = div;
 
+	if (dev->clk_desc)
+		no_os_clk_invalidate_rate(dev->clk_desc[chan->num]);
+
 	ret = hmc7044_write(dev, HMC7044_REG_CH_OUT_CRTL_1(chan->num),
 			    HMC7044_DIV_LSB(div));
 	if (ret < 0)
@@ -1462,7 +1465,7 @@ int32_t hmc7044_init(struct hmc7044_dev **device,
 	int32_t ret;
 	unsigned int i;
 	struct no_os_clk_desc **clocks = NULL;
-	struct no_os_clk_init_param clk_init;
+	struct no_os_clk_init_param clk_init = { 0 };
 	const char *names[HMC7044_NUM_CHAN] = {
 		"clock_0", "clock_1", "clock_2", "clock_3", "clock_4",
 		"clock_5", "clock_6", "clock_7", "clock_8", "clock_9",
@@ -1490,6 +1493,7 @@ int32_t hmc7044_init(struct hmc7044_dev **device,
 			clk_init.hw_ch_num = i;
 			clk_init.platform_ops = &hmc7044_clk_ops;
 			clk_init.dev_desc = dev;
+			clk_init.flags = NO_OS_CLK_CACHE_RATE;
 
 			ret = no_os_clk_init(&clocks[i], &clk_init);
 			if (ret)
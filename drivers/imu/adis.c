@@ -4074,6 +4074,45 @@ int adis_read_burst_data(struct adis_dev *adis, struct adis_burst_data *data,
 	return 0;
 }
 
+/**
+ * @brief Read multiple burst data samples from the FIFO.
+ * @param adis      - The adis device.
+ * @param data      - Array of nb burst data structures to be populated.
+ * @param nb        - Number of samples to read, at most ADIS_FIFO_BURST_MAX.
+ * @param burst32   - True if 32-bit data is requested for accel
+ *		      and gyro (or delta angle and delta velocity)
+ *		      measurements, false if 16-bit data is requested.
+ * @param burst_sel - 0 if accel and gyro data is requested, 1
+ *		      if delta angle and delta velocity is requested.
+ * @param crc_check - If true CRC will be checked, if false check will be skipped.
+ * @note The fifo_msgs and fifo_rx buffers of the device have to be allocated,
+ * as done by the IIO init of the devices with FIFO.
+ * @return The number of valid samples stored in data, negative error code
+ * otherwise. -EAGAIN in case the request has to be sent again due to data
+ * being unavailable at the time of the request.
+ */
+int adis_read_burst_data_fifo(struct adis_dev *adis,
+			      struct adis_burst_data *data, uint32_t nb,
+			      bool burst32, uint8_t burst_sel, bool crc_check)
+{
+	if (!(adis->info->flags & ADIS_HAS_FIFO))
+		return -EINVAL;
+
+	/* Device does not support delta data readings with burst method */
+	if (!(adis->info->flags & ADIS_HAS_BURST_DELTA_DATA) && burst_sel)
+		return -EINVAL;
+
+	/* Device does not support burst32 readings with burst method */
+	if (!(adis->info->flags & ADIS_HAS_BURST32) && burst32)
+		return -EINVAL;
+
+	if (!adis->info->read_burst_data_fifo)
+		return -ENOTSUP;
+
+	return adis->info->read_burst_data_fifo(adis, data, nb, burst32, burst_sel,
+						crc_check);
+}
+
 /**
  * @brief Update external clock frequency.
  * @param adis     - The adis device.
@@ -56,6 +56,11 @@
 #define ADIS_SYNC_OUTPUT	3
 #define ADIS_SYNC_PULSE		5
 
+/* Maximum number of samples read by adis_read_burst_data_fifo() */
+#define ADIS_FIFO_BURST_MAX	32
+/* Maximum size in bytes of a frame read by adis_read_burst_data_fifo() */
+#define ADIS_FIFO_BURST_FRAME_MAX	36
+
 /**
  * @brief Supported device ids
  */
@@ -274,6 +279,10 @@ struct adis_dev {
 	uint8_t				tx[12];
 	/** Receive buffer used in SPI transactions. */
 	uint8_t				rx[8];
+	/** SPI messages of a FIFO burst read, ADIS_FIFO_BURST_MAX + 1 entries. */
+	struct no_os_spi_msg		*fifo_msgs;
+	/** Receive buffer of a FIFO burst read, ADIS_FIFO_BURST_MAX + 1 frames. */
+	uint8_t				*fifo_rx;
 	/** Internal clock frequency in Hertz. */
 	uint32_t 			int_clk;
 	/** External clock frequency in Hertz. */
@@ -891,6 +900,10 @@ int adis_write_fir_coef(struct adis_dev *adis, uint8_t coef_idx, uint32_t coef);
 /*! Read burst data */
 int adis_read_burst_data(struct adis_dev *adis, struct adis_burst_data *data,
 			 bool burst32, uint8_t burst_sel, bool fifo_pop, bool crc_check);
+/*! Read multiple burst data samples from the FIFO */
+int adis_read_burst_data_fifo(struct adis_dev *adis,
+			      struct adis_burst_data *data, uint32_t nb,
+			      bool burst32, uint8_t burst_sel, bool crc_check);
 
 /*! Update external clock frequency. */
 int adis_update_ext_clk_freq(struct adis_dev *adis, uint32_t clk_freq);
@@ -41,6 +41,8 @@
 #define ADIS1657X_MSG_SIZE_32_BIT_BURST_FIFO	34 /* in bytes */
 #define ADIS1657X_READ_BURST_DATA_NO_POP	0x00
 #define ADIS1657X_CHECKSUM_BUF_IDX_FIFO		2
+/* From data-sheet, minimum time between burst reads */
+#define ADIS1657X_BURST_STALL_US		10
 
 static const struct adis_data_field_map_def adis1657x_def = {
 	.x_gyro 		 = {.reg_addr = 0x04, .reg_size = 0x04, .field_mask = 0xFFFFFFFF},
@@ -239,28 +241,19 @@ static int adis1657x_get_scale(struct adis_dev *adis,
 }
 
 /**
- * @brief Read burst data.
+ * @brief Update the burst configuration if needed.
  * @param adis      - The adis device.
- * @param data      - The burst read data structure to be populated.
- * @param burst32   - True if 32-bit data is requested for accel
- *		      and gyro (or delta angle and delta velocity)
- *		      measurements, false if 16-bit data is requested.
- * @param burst_sel - 0 if accel and gyro data is requested, 1
- *		      if delta angle and delta velocity is requested.
- * @param fifo_pop  - In case FIFO is present, will pop the fifo if
- * 		      true. Unused if FIFO is not present.
- * @param crc_check - If true CRC will be checked, if false check will be skipped.
+ * @param burst32   - True if 32-bit data is requested.
+ * @param burst_sel - 0 for accel and gyro data, 1 for delta angle and delta
+ *		      velocity data.
  * @return 0 in case of success, error code otherwise.
- * -EAGAIN in case the request has to be sent again due to data being unavailable
- * at the time of the request.
+ * -EAGAIN if the configuration has changed, the according data will be
+ * available only after the next data ready impulse.
  */
-int adis1657x_read_burst_data(struct adis_dev *adis,
-			      struct adis_burst_data *data,
-			      bool burst32, uint8_t burst_sel, bool fifo_pop, bool crc_check)
+static int adis1657x_burst_config(struct adis_dev *adis, bool burst32,
+				  uint8_t burst_sel)
 {
 	int ret = 0;
-	uint8_t msg_size = ADIS1657X_MSG_SIZE_16_BIT_BURST_FIFO;
-	uint8_t idx;
 
 	if (adis->info->flags & ADIS_HAS_BURST32) {
 		if (adis->burst32 != burst32) {
@@ -277,28 +270,25 @@ int adis1657x_read_burst_data(struct adis_dev *adis,
 		}
 	}
 
-	/* If burst32 or burst select has changed, wait for the next reading
-	   request to actually read the data, because the according data will be available
-	   only after the next data ready impulse. */
-	if (ret == -EAGAIN)
-		return ret;
-
-	if (burst32)
-		msg_size = ADIS1657X_MSG_SIZE_32_BIT_BURST_FIFO;
-
-	uint8_t buffer[msg_size + ADIS_READ_BURST_DATA_CMD_SIZE];
-
-	if (!fifo_pop)
-		buffer[0] = ADIS1657X_READ_BURST_DATA_NO_POP;
-	else
-		buffer[0] = ADIS_READ_BURST_DATA_CMD_MSB;
-
-	buffer[1] = ADIS_READ_BURST_DATA_CMD_LSB;
+	return ret;
+}
 
-	ret = no_os_spi_write_and_read(adis->spi_desc, buffer,
-				       msg_size + ADIS_READ_BURST_DATA_CMD_SIZE);
-	if (ret)
-		return ret;
+/**
+ * @brief Decode one burst frame.
+ * @param adis      - The adis device.
+ * @param buffer    - The frame, starting with the command bytes.
+ * @param msg_size  - The frame size without the command bytes.
+ * @param burst32   - True if the frame holds 32-bit data.
+ * @param crc_check - If true CRC will be checked, if false check will be skipped.
+ * @param data      - The burst read data structure to be populated.
+ * @return 0 in case of success, -EAGAIN if the FIFO was empty, -EINVAL in
+ * case of checksum error.
+ */
+static int adis1657x_decode_burst(struct adis_dev *adis, const uint8_t *buffer,
+				  uint8_t msg_size, bool burst32, bool crc_check,
+				  struct adis_burst_data *data)
+{
+	uint8_t idx;
 
 	for (idx = ADIS_READ_BURST_DATA_CMD_SIZE; idx < msg_size; idx++)
 		if (buffer[idx] != 0)
@@ -309,15 +299,11 @@ int adis1657x_read_burst_data(struct adis_dev *adis,
 
 	if (crc_check) {
 		/* Diag data not calculated in the checksum for this device. */
-		if (!adis_validate_checksum(&buffer[ADIS_READ_BURST_DATA_CMD_SIZE], msg_size,
-					    ADIS1657X_CHECKSUM_BUF_IDX_FIFO)) {
-			adis->diag_flags.checksum_err = true;
+		if (!adis_validate_checksum((uint8_t *)&buffer[ADIS_READ_BURST_DATA_CMD_SIZE],
+					    msg_size, ADIS1657X_CHECKSUM_BUF_IDX_FIFO))
 			return -EINVAL;
-		}
 	}
 
-	adis->diag_flags.checksum_err = false;
-
 	uint8_t axis_data_size = 12;
 	if (burst32)
 		axis_data_size = 24;
@@ -358,7 +344,7 @@ int adis1657x_read_burst_data(struct adis_dev *adis,
 	/* Temp data */
 	memcpy(&data->temp_lsb, &buffer[temp_offset], 2);
 	/* Counter data - aligned */
-	data->data_cntr_lsb = no_os_get_unaligned_be16(&buffer[data_cntr_offset]);;
+	data->data_cntr_lsb = no_os_get_unaligned_be16((uint8_t *)&buffer[data_cntr_offset]);
 	data->data_cntr_msb = 0;
 	/* Update diagnosis flags at each reading */
 	adis_update_diag_flags(adis, buffer[ADIS_READ_BURST_DATA_CMD_SIZE]);
@@ -366,6 +352,141 @@ int adis1657x_read_burst_data(struct adis_dev *adis,
 	return 0;
 }
 
+/**
+ * @brief Read burst data.
+ * @param adis      - The adis device.
+ * @param data      - The burst read data structure to be populated.
+ * @param burst32   - True if 32-bit data is requested for accel
+ *		      and gyro (or delta angle and delta velocity)
+ *		      measurements, false if 16-bit data is requested.
+ * @param burst_sel - 0 if accel and gyro data is requested, 1
+ *		      if delta angle and delta velocity is requested.
+ * @param fifo_pop  - In case FIFO is present, will pop the fifo if
+ * 		      true. Unused if FIFO is not present.
+ * @param crc_check - If true CRC will be checked, if false check will be skipped.
+ * @return 0 in case of success, error code otherwise.
+ * -EAGAIN in case the request has to be sent again due to data being unavailable
+ * at the time of the request.
+ */
+int adis1657x_read_burst_data(struct adis_dev *adis,
+			      struct adis_burst_data *data,
+			      bool burst32, uint8_t burst_sel, bool fifo_pop, bool crc_check)
+{
+	int ret;
+	uint8_t msg_size = ADIS1657X_MSG_SIZE_16_BIT_BURST_FIFO;
+
+	/* If burst32 or burst select has changed, wait for the next reading
+	   request to actually read the data, because the according data will be available
+	   only after the next data ready impulse. */
+	ret = adis1657x_burst_config(adis, burst32, burst_sel);
+	if (ret)
+		return ret;
+
+	if (burst32)
+		msg_size = ADIS1657X_MSG_SIZE_32_BIT_BURST_FIFO;
+
+	uint8_t buffer[msg_size + ADIS_READ_BURST_DATA_CMD_SIZE];
+
+	if (!fifo_pop)
+		buffer[0] = ADIS1657X_READ_BURST_DATA_NO_POP;
+	else
+		buffer[0] = ADIS_READ_BURST_DATA_CMD_MSB;
+
+	buffer[1] = ADIS_READ_BURST_DATA_CMD_LSB;
+
+	ret = no_os_spi_write_and_read(adis->spi_desc, buffer,
+				       msg_size + ADIS_READ_BURST_DATA_CMD_SIZE);
+	if (ret)
+		return ret;
+
+	ret = adis1657x_decode_burst(adis, buffer, msg_size, burst32, crc_check,
+				     data);
+	if (ret != -EAGAIN)
+		adis->diag_flags.checksum_err = ret == -EINVAL;
+
+	return ret;
+}
+
+/**
+ * @brief Drain samples from the FIFO in a single SPI transfer.
+ *
+ * The output of a burst frame is the sample popped by the previous frame,
+ * so nb + 1 frames are sent: nb frames popping the FIFO, and a last one
+ * that does not, returning the last popped sample. The frames are separated
+ * by the stall time through the cs_change_delay of each message, instead of
+ * a delay per SPI transaction. The messages and the frames use the fifo_msgs
+ * and fifo_rx buffers of the device, so that no allocation is done in the
+ * trigger handler. Each frame is sent and received in place, as the
+ * no_os_spi_transfer() fallback of platforms without a transfer op
+ * requires. Platforms timing cs_change_delay with no_os_udelay() (maxim,
+ * stm32) still busy-wait the stall time.
+ * @param adis      - The adis device.
+ * @param data      - Array of nb burst data structures to be populated.
+ * @param nb        - Number of samples to read, at most
+ *		      ADIS_FIFO_BURST_MAX.
+ * @param burst32   - True if 32-bit data is requested.
+ * @param burst_sel - 0 for accel and gyro data, 1 for delta angle and delta
+ *		      velocity data.
+ * @param crc_check - If true the checksum of each frame will be checked.
+ * @return The number of valid samples stored in data, frames with a checksum
+ * error or read from an empty FIFO are dropped. Negative error code otherwise,
+ * -EAGAIN in case the burst configuration has changed.
+ */
+int adis1657x_read_burst_data_fifo(struct adis_dev *adis,
+				   struct adis_burst_data *data, uint32_t nb,
+				   bool burst32, uint8_t burst_sel, bool crc_check)
+{
+	uint8_t msg_size = ADIS1657X_MSG_SIZE_16_BIT_BURST_FIFO;
+	struct no_os_spi_msg *msgs = adis->fifo_msgs;
+	bool checksum_err = false;
+	uint32_t frame, i, valid = 0;
+	uint8_t *rx = adis->fifo_rx;
+	int ret;
+
+	if (!nb || nb > ADIS_FIFO_BURST_MAX || !msgs || !rx)
+		return -EINVAL;
+
+	ret = adis1657x_burst_config(adis, burst32, burst_sel);
+	if (ret)
+		return ret;
+
+	if (burst32)
+		msg_size = ADIS1657X_MSG_SIZE_32_BIT_BURST_FIFO;
+	frame = msg_size + ADIS_READ_BURST_DATA_CMD_SIZE;
+
+	memset(rx, 0, (nb + 1) * frame);
+	for (i = 0; i <= nb; i++) {
+		rx[i * frame] = i < nb ? ADIS_READ_BURST_DATA_CMD_MSB :
+				ADIS1657X_READ_BURST_DATA_NO_POP;
+		rx[i * frame + 1] = ADIS_READ_BURST_DATA_CMD_LSB;
+
+		memset(&msgs[i], 0, sizeof(msgs[i]));
+		msgs[i].tx_buff = rx + i * frame;
+		msgs[i].rx_buff = rx + i * frame;
+		msgs[i].bytes_number = frame;
+		msgs[i].cs_change = 1;
+		msgs[i].cs_change_delay = ADIS1657X_BURST_STALL_US;
+	}
+
+	ret = no_os_spi_transfer(adis->spi_desc, msgs, nb + 1);
+	if (ret)
+		return ret;
+
+	/* The first frame returns the sample popped before this call */
+	for (i = 1; i <= nb; i++) {
+		ret = adis1657x_decode_burst(adis, rx + i * frame, msg_size, burst32,
+					     crc_check, &data[valid]);
+		if (!ret)
+			valid++;
+		else if (ret == -EINVAL)
+			checksum_err = true;
+	}
+
+	adis->diag_flags.checksum_err = checksum_err;
+
+	return valid;
+}
+
 const struct adis_chip_info adis1657x_chip_info = {
 	.field_map		= &adis1657x_def,
 	.sync_clk_freq_limits	= adis1657x_sync_clk_freq_limits,
@@ -383,4 +504,5 @@ const struct adis_chip_info adis1657x_chip_info = {
 	.flags			= ADIS_HAS_BURST32 | ADIS_HAS_BURST_DELTA_DATA | ADIS_HAS_FIFO,
 	.get_scale		= &adis1657x_get_scale,
 	.read_burst_data	= &adis1657x_read_burst_data,
+	.read_burst_data_fifo	= &adis1657x_read_burst_data_fifo,
 };
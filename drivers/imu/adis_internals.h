@@ -473,6 +473,10 @@ struct adis_chip_info {
 	/** Chip specifc implementation for reading burst data. */
 	int (*read_burst_data)(struct adis_dev *adis, struct adis_burst_data *data,
 			       bool burst32, uint8_t burst_sel, bool fifo_pop, bool crc_check);
+	/** Chip specific implementation for reading multiple samples from FIFO. */
+	int (*read_burst_data_fifo)(struct adis_dev *adis,
+				    struct adis_burst_data *data, uint32_t nb,
+				    bool burst32, uint8_t burst_sel, bool crc_check);
 	/** Chip specific implementation for reading channel offset. */
 	int (*get_offset)(struct adis_dev *adis,
 			  int *offset,
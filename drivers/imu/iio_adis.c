@@ -1476,37 +1476,22 @@ int adis_iio_post_disable(void* dev, uint32_t mask)
 }
 
 /**
- * @brief API to be called to get one single sample-set based on the given mask.
+ * @brief Build one sample-set based on the given mask.
  * @param iio_adis - The iio adis structure.
  * @param mask     - The active channels mask.
- * @param buffer   - IIO buffer to push the sample set to.
- * @return 0 in case of success, error code otherwise.
+ * @param data     - The burst data read from the device.
+ * @param scan     - Sample-set to build.
+ * @return true if the sample-set holds new data, false otherwise.
  */
-static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
-		uint32_t mask, struct iio_buffer *buffer, bool pop)
+static bool adis_iio_fill_scan(struct adis_iio_dev *iio_adis, uint32_t mask,
+			       struct adis_burst_data *data, uint16_t *scan)
 {
-	struct adis_dev *adis;
-	int ret;
-	struct adis_burst_data data;
 	uint8_t i = 0;
 	uint32_t res1;
 	uint32_t res2;
 	uint8_t chan;
 
-	adis = iio_adis->adis_dev;
-
-	ret = adis_read_burst_data(adis, &data, iio_adis->burst_size,
-				   iio_adis->burst_sel, pop, false);
-
-	/* If ret ==  EAGAIN then no data is available to read (will happen
-	for a burst request or in case burst32 or burst select has been changed) */
-	if (ret == -EAGAIN)
-		return 0;
-
-	if (ret)
-		return ret;
-
-	uint32_t current_data_cntr = data.data_cntr_lsb | data.data_cntr_msb << 16;
+	uint32_t current_data_cntr = data->data_cntr_lsb | data->data_cntr_msb << 16;
 
 	if (iio_adis->data_cntr) {
 		if (current_data_cntr > iio_adis->data_cntr) {
@@ -1525,7 +1510,7 @@ static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
 
 		} else if (current_data_cntr == iio_adis->data_cntr) {
 			/* No new data, nothing else to do */
-			return 0;
+			return false;
 		}
 
 		else { /* data counter overflowed occurred */
@@ -1543,9 +1528,9 @@ static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
 			case ADIS_TEMP:
 
 				if (iio_adis->iio_dev->channels[chan].scan_type->storagebits == 32)
-					iio_adis->data[i++] = data.temp_msb;
+					scan[i++] = data->temp_msb;
 
-				iio_adis->data[i++] = data.temp_lsb;
+				scan[i++] = data->temp_lsb;
 				/*
 				 * The temperature channel has 16-bit storage size.
 				 * We need to perform the padding to have the buffer
@@ -1556,138 +1541,138 @@ static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
 				 */
 				if (mask & NO_OS_GENMASK(ADIS_DELTA_VEL_Z, ADIS_DELTA_ANGL_X)
 				    && iio_adis->iio_dev->channels[chan].scan_type->storagebits == 16)
-					iio_adis->data[i++] = 0;
+					scan[i++] = 0;
 				break;
 			case ADIS_GYRO_X:
 				if (iio_adis->burst_sel) {
-					iio_adis->data[i++] = 0;
-					iio_adis->data[i++] = 0;
+					scan[i++] = 0;
+					scan[i++] = 0;
 				} else {
 					/* upper 16 */
-					iio_adis->data[i++] = data.x_gyro_msb;
+					scan[i++] = data->x_gyro_msb;
 					/* lower 16 */
-					iio_adis->data[i++] =  data.x_gyro_lsb;
+					scan[i++] =  data->x_gyro_lsb;
 				}
 				break;
 			case ADIS_GYRO_Y:
 				if (iio_adis->burst_sel) {
-					iio_adis->data[i++] = 0;
-					iio_adis->data[i++] = 0;
+					scan[i++] = 0;
+					scan[i++] = 0;
 				} else {
 					/* upper 16 */
-					iio_adis->data[i++] = data.y_gyro_msb;
+					scan[i++] = data->y_gyro_msb;
 					/* lower 16 */
-					iio_adis->data[i++] =  data.y_gyro_lsb;
+					scan[i++] =  data->y_gyro_lsb;
 				}
 				break;
 			case ADIS_GYRO_Z:
 				if (iio_adis->burst_sel) {
-					iio_adis->data[i++] = 0;
-					iio_adis->data[i++] = 0;
+					scan[i++] = 0;
+					scan[i++] = 0;
 				} else {
 					/* upper 16 */
-					iio_adis->data[i++] = data.z_gyro_msb;
+					scan[i++] = data->z_gyro_msb;
 					/* lower 16 */
-					iio_adis->data[i++] =  data.z_gyro_lsb;
+					scan[i++] =  data->z_gyro_lsb;
 				}
 				break;
 			case ADIS_ACCEL_X:
 				if (iio_adis->burst_sel) {
-					iio_adis->data[i++] = 0;
-					iio_adis->data[i++] = 0;
+					scan[i++] = 0;
+					scan[i++] = 0;
 				} else {
 					/* upper 16 */
-					iio_adis->data[i++] = data.x_accel_msb;
+					scan[i++] = data->x_accel_msb;
 					/* lower 16 */
-					iio_adis->data[i++] =  data.x_accel_lsb;
+					scan[i++] =  data->x_accel_lsb;
 				}
 				break;
 			case ADIS_ACCEL_Y:
 				if (iio_adis->burst_sel) {
-					iio_adis->data[i++] = 0;
-					iio_adis->data[i++] = 0;
+					scan[i++] = 0;
+					scan[i++] = 0;
 				} else {
 					/* upper 16 */
-					iio_adis->data[i++] = data.y_accel_msb;
+					scan[i++] = data->y_accel_msb;
 					/* lower 16 */
-					iio_adis->data[i++] =  data.y_accel_lsb;
+					scan[i++] =  data->y_accel_lsb;
 				}
 				break;
 			case ADIS_ACCEL_Z:
 				if (iio_adis->burst_sel) {
-					iio_adis->data[i++] = 0;
-					iio_adis->data[i++] = 0;
+					scan[i++] = 0;
+					scan[i++] = 0;
 				} else {
 					/* upper 16 */
-					iio_adis->data[i++] = data.z_accel_msb;
+					scan[i++] = data->z_accel_msb;
 					/* lower 16 */
-					iio_adis->data[i++] =  data.z_accel_lsb;
+					scan[i++] =  data->z_accel_lsb;
 				}
 				break;
 			case ADIS_DELTA_ANGL_X:
 				if (!iio_adis->burst_sel) {
-					iio_adis->data[i++] = 0;
-					iio_adis->data[i++] = 0;
+					scan[i++] = 0;
+					scan[i++] = 0;
 				} else {
 					/* upper 16 */
-					iio_adis->data[i++] = data.x_gyro_msb;
+					scan[i++] = data->x_gyro_msb;
 					/* lower 16 */
-					iio_adis->data[i++] =  data.x_gyro_lsb;
+					scan[i++] =  data->x_gyro_lsb;
 				}
 				break;
 			case ADIS_DELTA_ANGL_Y:
 				if (!iio_adis->burst_sel) {
-					iio_adis->data[i++] = 0;
-					iio_adis->data[i++] = 0;
+					scan[i++] = 0;
+					scan[i++] = 0;
 				} else {
 					/* upper 16 */
-					iio_adis->data[i++] = data.y_gyro_msb;
+					scan[i++] = data->y_gyro_msb;
 					/* lower 16 */
-					iio_adis->data[i++] =  data.y_gyro_lsb;
+					scan[i++] =  data->y_gyro_lsb;
 				}
 				break;
 			case ADIS_DELTA_ANGL_Z:
 				if (!iio_adis->burst_sel) {
-					iio_adis->data[i++] = 0;
-					iio_adis->data[i++] = 0;
+					scan[i++] = 0;
+					scan[i++] = 0;
 				} else {
 					/* upper 16 */
-					iio_adis->data[i++] = data.z_gyro_msb;
+					scan[i++] = data->z_gyro_msb;
 					/* lower 16 */
-					iio_adis->data[i++] =  data.z_gyro_lsb;
+					scan[i++] =  data->z_gyro_lsb;
 				}
 				break;
 			case ADIS_DELTA_VEL_X:
 				if (!iio_adis->burst_sel) {
-					iio_adis->data[i++] = 0;
-					iio_adis->data[i++] = 0;
+					scan[i++] = 0;
+					scan[i++] = 0;
 				} else {
 					/* upper 16 */
-					iio_adis->data[i++] = data.x_accel_msb;
+					scan[i++] = data->x_accel_msb;
 					/* lower 16 */
-					iio_adis->data[i++] =  data.x_accel_lsb;
+					scan[i++] =  data->x_accel_lsb;
 				}
 				break;
 			case ADIS_DELTA_VEL_Y:
 				if (!iio_adis->burst_sel) {
-					iio_adis->data[i++] = 0;
-					iio_adis->data[i++] = 0;
+					scan[i++] = 0;
+					scan[i++] = 0;
 				} else {
 					/* upper 16 */
-					iio_adis->data[i++] = data.y_accel_msb;
+					scan[i++] = data->y_accel_msb;
 					/* lower 16 */
-					iio_adis->data[i++] =  data.y_accel_lsb;
+					scan[i++] =  data->y_accel_lsb;
 				}
 				break;
 			case ADIS_DELTA_VEL_Z:
 				if (!iio_adis->burst_sel) {
-					iio_adis->data[i++] = 0;
-					iio_adis->data[i++] = 0;
+					scan[i++] = 0;
+					scan[i++] = 0;
 				} else {
 					/* upper 16 */
-					iio_adis->data[i++] = data.z_accel_msb;
+					scan[i++] = data->z_accel_msb;
 					/* lower 16 */
-					iio_adis->data[i++] =  data.z_accel_lsb;
+					scan[i++] =  data->z_accel_lsb;
 				}
 				break;
 			default:
@@ -1696,6 +1681,39 @@ static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
 		}
 	}
 
+	return true;
+}
+
+/**
+ * @brief API to be called to get one single sample-set based on the given mask.
+ * @param iio_adis - The iio adis structure.
+ * @param mask     - The active channels mask.
+ * @param buffer   - IIO buffer to push the sample set to.
+ * @return 0 in case of success, error code otherwise.
+ */
+static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
+		uint32_t mask, struct iio_buffer *buffer, bool pop)
+{
+	struct adis_dev *adis;
+	int ret;
+	struct adis_burst_data data;
+
+	adis = iio_adis->adis_dev;
+
+	ret = adis_read_burst_data(adis, &data, iio_adis->burst_size,
+				   iio_adis->burst_sel, pop, false);
+
+	/* If ret ==  EAGAIN then no data is available to read (will happen
+	for a burst request or in case burst32 or burst select has been changed) */
+	if (ret == -EAGAIN)
+		return 0;
+
+	if (ret)
+		return ret;
+
+	if (!adis_iio_fill_scan(iio_adis, mask, &data, iio_adis->data))
+		return 0;
+
 	return iio_buffer_push_scan(buffer, &iio_adis->data[0]);
 }
 
@@ -1729,22 +1747,24 @@ int adis_iio_trigger_handler(struct iio_device_data *dev_data)
 int adis_iio_trigger_handler_with_fifo(struct iio_device_data *dev_data)
 {
 	struct adis_iio_dev *iio_adis;
+	struct iio_buffer *buffer;
 	struct adis_dev *adis;
-	int ret;
-	uint32_t fifo_cnt;
-	uint16_t j;
+	uint32_t fifo_cnt, nb, words, n;
+	int ret, j;
 
 	if (!dev_data)
 		return -EINVAL;
 
 	iio_adis = (struct adis_iio_dev *)dev_data->dev;
 
-	if (!iio_adis->adis_dev)
+	if (!iio_adis->adis_dev || !iio_adis->fifo_data)
 		return -EINVAL;
 
 	iio_trig_disable(iio_adis->hw_trig_desc);
 
 	adis = iio_adis->adis_dev;
+	buffer = dev_data->buffer;
+	words = buffer->bytes_per_scan / sizeof(*iio_adis->fifo_scans);
 
 	ret = adis_read_fifo_cnt(adis, &fifo_cnt);
 	if (ret)
@@ -1752,32 +1772,37 @@ int adis_iio_trigger_handler_with_fifo(struct iio_device_data *dev_data)
 
 	/* From data-sheet, minimum time between reads */
 	no_os_udelay(10);
-	if (fifo_cnt > dev_data->buffer->samples)
-		fifo_cnt = dev_data->buffer->samples;
+	if (fifo_cnt > buffer->samples)
+		fifo_cnt = buffer->samples;
 
-	if (fifo_cnt > 2) {
-		/* Burst request */
-		ret = adis_iio_trigger_push_single_sample(iio_adis,
-				dev_data->buffer->active_mask, dev_data->buffer, true);
-		if (ret)
+	if (fifo_cnt <= 2)
+		goto trig_enable;
+
+	/* Drain the FIFO in bursts of up to ADIS_FIFO_BURST_MAX samples */
+	while (fifo_cnt) {
+		nb = no_os_min(fifo_cnt, (uint32_t)ADIS_FIFO_BURST_MAX);
+		ret = adis_read_burst_data_fifo(adis, iio_adis->fifo_data, nb,
+						iio_adis->burst_size,
+						iio_adis->burst_sel, true);
+		/* Burst32 or burst select has been changed */
+		if (ret == -EAGAIN) {
+			ret = 0;
+			break;
+		}
+		if (ret < 0)
 			goto trig_enable;
 
-		/* From data-sheet, minimum time between reads */
-		no_os_udelay(10);
+		for (j = 0, n = 0; j < ret; j++)
+			if (adis_iio_fill_scan(iio_adis, buffer->active_mask,
+					       &iio_adis->fifo_data[j],
+					       &iio_adis->fifo_scans[n * words]))
+				n++;
 
-		for (j = 0; j < fifo_cnt - 1; j++) {
-			ret = adis_iio_trigger_push_single_sample(iio_adis,
-					dev_data->buffer->active_mask, dev_data->buffer, true);
-			if (ret)
-				goto trig_enable;
+		ret = iio_buffer_push_scans(buffer, iio_adis->fifo_scans, n);
+		if (ret)
+			goto trig_enable;
 
-			/* From data-sheet, minimum time between reads */
-			no_os_udelay(10);
-		}
-		ret = adis_iio_trigger_push_single_sample(iio_adis,
-				dev_data->buffer->active_mask, dev_data->buffer, false);
-		/* From data-sheet, minimum time between reads */
-		no_os_udelay(10);
+		fifo_cnt -= nb;
 	}
 
 trig_enable:
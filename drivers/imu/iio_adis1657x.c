@@ -491,15 +491,40 @@ int adis1657x_iio_init(struct adis_iio_dev **iio_dev,
 	desc->has_fifo = true;
 	desc->hw_trig_desc = adis1657x_trig_desc;
 
+	/* FIFO samples and sample-sets of a burst read */
+	desc->fifo_data = no_os_calloc(ADIS_FIFO_BURST_MAX,
+				       sizeof(*desc->fifo_data));
+	desc->fifo_scans = no_os_calloc(ADIS_FIFO_BURST_MAX, sizeof(desc->data));
+	if (!desc->fifo_data || !desc->fifo_scans) {
+		ret = -ENOMEM;
+		goto error_adis1657x_init;
+	}
+
 	ret = adis_init(&desc->adis_dev, init_param);
 	if (ret)
 		goto error_adis1657x_init;
 
+	/* SPI messages and frames of a burst read, used in the trigger handler */
+	desc->adis_dev->fifo_msgs = no_os_calloc(ADIS_FIFO_BURST_MAX + 1,
+				    sizeof(*desc->adis_dev->fifo_msgs));
+	desc->adis_dev->fifo_rx = no_os_calloc(ADIS_FIFO_BURST_MAX + 1,
+					       ADIS_FIFO_BURST_FRAME_MAX);
+	if (!desc->adis_dev->fifo_msgs || !desc->adis_dev->fifo_rx) {
+		ret = -ENOMEM;
+		goto error_adis_init;
+	}
+
 	*iio_dev = desc;
 
 	return 0;
 
+error_adis_init:
+	no_os_free(desc->adis_dev->fifo_rx);
+	no_os_free(desc->adis_dev->fifo_msgs);
+	adis_remove(desc->adis_dev);
 error_adis1657x_init:
+	no_os_free(desc->fifo_scans);
+	no_os_free(desc->fifo_data);
 	no_os_free(desc);
 	return ret;
 }
@@ -512,6 +537,10 @@ void adis1657x_iio_remove(struct adis_iio_dev *desc)
 {
 	if (!desc)
 		return;
+	no_os_free(desc->adis_dev->fifo_rx);
+	no_os_free(desc->adis_dev->fifo_msgs);
 	adis_remove(desc->adis_dev);
+	no_os_free(desc->fifo_scans);
+	no_os_free(desc->fifo_data);
 	no_os_free(desc);
 }
@@ -228,6 +228,10 @@ struct adis_iio_dev {
 	uint16_t data[26];
 	/** True if iio device offers FIFO support for buffer reading. */
 	bool has_fifo;
+	/** FIFO samples of a burst read, ADIS_FIFO_BURST_MAX entries. */
+	struct adis_burst_data *fifo_data;
+	/** Sample-sets built from fifo_data. */
+	uint16_t *fifo_scans;
 	/** Gyroscope measurement range value in text. */
 	const char *rang_mdl_txt;
 	struct iio_hw_trig *hw_trig_desc;
@@ -366,6 +366,240 @@ int ade9000_set_egy_model(struct ade9000_dev *dev, enum ade9000_egy_model model,
 	return ade9000_write(dev, ADE9000_REG_RUN, 1);
 }
 
+/* Current time in microseconds */
+static uint64_t ade9000_wfb_now_us(void)
+{
+	struct no_os_time t = no_os_get_time();
+
+	return (uint64_t)t.s * 1000000 + t.us;
+}
+
+/**
+ * @brief Start the continuous waveform buffer capture. The fixed data rate
+ * 	  samples of all channels are stored and PAGE_FULL is raised each time
+ * 	  half of the buffer is filled.
+ * @param dev - The device structure.
+ * @param src - Waveform source, 32 kSPS for sinc4, 8 kSPS otherwise.
+ * @param in_en - Store the neutral current samples.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ade9000_wfb_start(struct ade9000_dev *dev, enum ade9000_wf_src_e src,
+		      bool in_en)
+{
+	int ret;
+	/* waveform buffer configuration */
+	uint32_t cfg;
+
+	if (!dev)
+		return -ENODEV;
+	if (src != ADE9000_SRC_SINC4 && src != ADE9000_SRC_SINC4_IIR &&
+	    src != ADE9000_SRC_DSP)
+		return -EINVAL;
+
+	if (!dev->wfb_buf) {
+		dev->wfb_buf = no_os_calloc(ADE9000_WFB_HALF_WORDS * 4 + 2, 1);
+		if (!dev->wfb_buf)
+			return -ENOMEM;
+	}
+
+	/* The configuration can only be changed with the capture stopped */
+	ret = ade9000_update_bits(dev, ADE9000_REG_WFB_CFG, ADE9000_WF_CAP_EN, 0);
+	if (ret)
+		return ret;
+
+	cfg = no_os_field_prep(ADE9000_WF_IN_EN, in_en) |
+	      no_os_field_prep(ADE9000_WF_SRC, src) |
+	      no_os_field_prep(ADE9000_WF_MODE, ADE9000_MODE_TRIG_EN_EVENTS) |
+	      ADE9000_WF_CAP_SEL |
+	      no_os_field_prep(ADE9000_BURST_CHAN, ADE9000_BURST_ALL_CH);
+	ret = ade9000_write(dev, ADE9000_REG_WFB_CFG, cfg);
+	if (ret)
+		return ret;
+
+	/* No trigger event, the buffer is filled until the capture is stopped */
+	ret = ade9000_write(dev, ADE9000_REG_WFB_TRG_CFG, 0);
+	if (ret)
+		return ret;
+
+	ret = ade9000_write(dev, ADE9000_REG_WFB_PG_IRQEN, ADE9000_WFB_PG_IRQ);
+	if (ret)
+		return ret;
+
+	ret = ade9000_update_bits(dev, ADE9000_REG_MASK0, ADE9000_MASK0_PAGE_FULL,
+				  ADE9000_MASK0_PAGE_FULL);
+	if (ret)
+		return ret;
+
+	ret = ade9000_write(dev, ADE9000_REG_STATUS0, ADE9000_STATUS0_PAGE_FULL);
+	if (ret)
+		return ret;
+
+	dev->wfb_src = src;
+	dev->wfb_half = 0;
+	dev->wfb_seq = 0;
+	dev->wfb_nb_halves = 0;
+	dev->wfb_overruns = 0;
+
+	ret = ade9000_write(dev, ADE9000_REG_WFB_CFG, cfg | ADE9000_WF_CAP_EN);
+	if (ret)
+		return ret;
+
+	dev->wfb_time_us = ade9000_wfb_now_us();
+
+	return 0;
+}
+
+/**
+ * @brief Handle the PAGE_FULL interrupt. The half of the buffer that was
+ * 	  filled is read with a single burst while the device fills the
+ * 	  other one.
+ * @param dev - The device structure.
+ * @return Number of sample sets read, 0 if no half was filled, negative error
+ * 	   code otherwise.
+ */
+int ade9000_wfb_isr(struct ade9000_dev *dev)
+{
+	int ret;
+	/* register value read */
+	uint32_t reg_val;
+	/* half of the buffer that was filled */
+	uint8_t half;
+	/* burst read start address */
+	uint16_t addr;
+	/* time since the last half read and time to fill a half */
+	uint64_t now, elapsed, half_us;
+	/* halves filled since the last one read */
+	uint32_t nb;
+
+	if (!dev)
+		return -ENODEV;
+	if (!dev->wfb_buf)
+		return -EINVAL;
+
+	ret = ade9000_read(dev, ADE9000_REG_STATUS0, &reg_val);
+	if (ret)
+		return ret;
+
+	if (!(reg_val & ADE9000_STATUS0_PAGE_FULL))
+		return 0;
+
+	ret = ade9000_write(dev, ADE9000_REG_STATUS0, ADE9000_STATUS0_PAGE_FULL);
+	if (ret)
+		return ret;
+
+	ret = ade9000_read(dev, ADE9000_REG_WFB_TRG_STAT, &reg_val);
+	if (ret)
+		return ret;
+
+	half = no_os_field_get(ADE9000_WFB_LAST_PAGE, reg_val) /
+	       ADE9000_WFB_HALF_PAGES;
+
+	/*
+	 * The page only tells the parity of the number of halves filled
+	 * since the last read: odd if the expected half is the last one.
+	 * The fixed data rate gives that number within one half, so take the
+	 * closest value with the right parity. Without a time base this
+	 * falls back to 1 or 2.
+	 */
+	now = ade9000_wfb_now_us();
+	elapsed = now > dev->wfb_time_us ? now - dev->wfb_time_us : 0;
+	half_us = ADE9000_WFB_HALF_US(dev->wfb_src);
+	if (half == dev->wfb_half)
+		nb = 1 + 2 * no_os_div_u64(elapsed, 2 * half_us);
+	else
+		nb = no_os_max(2, 2 * no_os_div_u64(elapsed + half_us,
+						    2 * half_us));
+	dev->wfb_time_us = now;
+	dev->wfb_seq += nb;
+	dev->wfb_half = !half;
+
+	addr = ADE9000_WFB_ADDR + half * ADE9000_WFB_HALF_WORDS;
+	no_os_put_unaligned_be16(no_os_field_prep(NO_OS_GENMASK(15, 4), addr) |
+				 ADE9000_SPI_READ, dev->wfb_buf);
+	ret = no_os_spi_write_and_read(dev->spi_desc, dev->wfb_buf,
+				       ADE9000_WFB_HALF_WORDS * 4 + 2);
+	if (ret)
+		return ret;
+
+	/* Only the last of the halves filled is still in the buffer */
+	dev->wfb_nb_halves++;
+	dev->wfb_overruns = dev->wfb_seq - dev->wfb_nb_halves;
+
+	return ADE9000_WFB_HALF_SETS;
+}
+
+/**
+ * @brief Get a raw sample of the last half read.
+ * @param dev - The device structure.
+ * @param set - Sample set, up to ADE9000_WFB_HALF_SETS.
+ * @param chan - Channel.
+ * @return The raw sample.
+ */
+int32_t ade9000_wfb_get_raw(struct ade9000_dev *dev, uint32_t set,
+			    enum ade9000_wfb_chan chan)
+{
+	return (int32_t)no_os_get_unaligned_be32(&dev->wfb_buf[2 +
+			(set * ADE9000_WFB_SET_WORDS + chan) * 4]);
+}
+
+/**
+ * @brief Convert a channel of the last half read to mV for the voltage
+ * 	  channels and to mA for the current ones.
+ * @param dev - The device structure.
+ * @param chan - Channel.
+ * @param data - ADE9000_WFB_HALF_SETS converted samples.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ade9000_wfb_convert(struct ade9000_dev *dev, enum ade9000_wfb_chan chan,
+			int32_t *data)
+{
+	/* sensor transfer function */
+	int64_t tr_fcn;
+	/* index */
+	uint32_t i;
+
+	if (!dev)
+		return -ENODEV;
+	if (!dev->wfb_buf || !data || chan >= ADE9000_WFB_NB_CHAN)
+		return -EINVAL;
+
+	if (chan == ADE9000_WFB_VA || chan == ADE9000_WFB_VB ||
+	    chan == ADE9000_WFB_VC)
+		tr_fcn = ADE9000_VOLTAGE_TR_FCN;
+	else
+		tr_fcn = ADE9000_CURRENT_TR_FCN;
+
+	for (i = 0; i < ADE9000_WFB_HALF_SETS; i++)
+		data[i] = (int64_t)ade9000_wfb_get_raw(dev, i, chan) *
+			  ADE9000_FS_PEAK_VOLTAGE * tr_fcn / ADE9000_PCF_FS_CODES;
+
+	return 0;
+}
+
+/**
+ * @brief Stop the waveform buffer capture.
+ * @param dev - The device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ade9000_wfb_stop(struct ade9000_dev *dev)
+{
+	int ret;
+
+	if (!dev)
+		return -ENODEV;
+
+	ret = ade9000_update_bits(dev, ADE9000_REG_WFB_CFG, ADE9000_WF_CAP_EN, 0);
+	if (ret)
+		return ret;
+
+	ret = ade9000_update_bits(dev, ADE9000_REG_MASK0, ADE9000_MASK0_PAGE_FULL,
+				  0);
+	if (ret)
+		return ret;
+
+	return ade9000_write(dev, ADE9000_REG_WFB_PG_IRQEN, 0);
+}
+
 /**
  * @brief Initialize the device.
  * @param device - The device structure.
@@ -504,6 +738,7 @@ int ade9000_remove(struct ade9000_dev *dev)
 	if (ret)
 		return ret;
 
+	no_os_free(dev->wfb_buf);
 	no_os_free(dev);
 
 	return 0;
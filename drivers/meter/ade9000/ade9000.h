@@ -826,7 +826,7 @@
 /* ADE9000_REG_WFB_CFG Bit Definition */
 #define ADE9000_WF_IN_EN		NO_OS_BIT(12)
 #define ADE9000_WF_SRC			NO_OS_GENMASK(9, 8)
-#define ADE9000_WF_MODE			NO_OS_BIT(7, 6)
+#define ADE9000_WF_MODE			NO_OS_GENMASK(7, 6)
 #define ADE9000_WF_CAP_SEL		NO_OS_BIT(5)
 #define ADE9000_WF_CAP_EN		NO_OS_BIT(4)
 #define ADE9000_BURST_CHAN		NO_OS_GENMASK(3, 0)
@@ -914,6 +914,21 @@
 /* Miscellaneous Definitions */
 #define ADE9000_CHIP_ID			0x63
 
+/* Waveform buffer, 16 pages of 128 words. In fixed data rate mode every
+ * sample set takes 8 words: IA, VA, IB, VB, IC, VC, IN and a spare one. */
+#define ADE9000_WFB_ADDR		0x0800
+#define ADE9000_WFB_WORDS		2048
+#define ADE9000_WFB_PAGE_WORDS		128
+#define ADE9000_WFB_SET_WORDS		8
+/* The buffer is read by halves, page 7 and 15 raising PAGE_FULL */
+#define ADE9000_WFB_HALF_WORDS		(ADE9000_WFB_WORDS / 2)
+#define ADE9000_WFB_HALF_SETS		(ADE9000_WFB_HALF_WORDS / ADE9000_WFB_SET_WORDS)
+#define ADE9000_WFB_HALF_PAGES		(ADE9000_WFB_HALF_WORDS / ADE9000_WFB_PAGE_WORDS)
+#define ADE9000_WFB_PG_IRQ		(NO_OS_BIT(ADE9000_WFB_HALF_PAGES - 1) | \
+					 NO_OS_BIT(2 * ADE9000_WFB_HALF_PAGES - 1))
+/* Time to fill a half: 4 ms at 32 kSPS (sinc4), 16 ms at 8 kSPS */
+#define ADE9000_WFB_HALF_US(src)	((src) == ADE9000_SRC_SINC4 ? 4000 : 16000)
+
 /*Configuration registers*/
 /*PGA@0x0000. Gain of all channels=1*/
 #define ADE9000_PGA_GAIN 		0x0000
@@ -978,6 +993,8 @@
 
 // 0.707V rms full scale * 1000 for mili units
 #define ADE9000_FS_VOLTAGE           	707
+// 1V peak full scale of the waveform samples * 1000 for mili units
+#define ADE9000_FS_PEAK_VOLTAGE		1000
 
 /**
  * @enum ade9000_isum_cfg_e
@@ -1336,6 +1353,21 @@ enum ade9000_pga_gain_e {
 	ADE9000_PGA_GAIN_4
 };
 
+/**
+ * @enum ade9000_wfb_chan
+ * @brief Position of the channels in a waveform buffer sample set.
+ */
+enum ade9000_wfb_chan {
+	ADE9000_WFB_IA,
+	ADE9000_WFB_VA,
+	ADE9000_WFB_IB,
+	ADE9000_WFB_VB,
+	ADE9000_WFB_IC,
+	ADE9000_WFB_VC,
+	ADE9000_WFB_IN,
+	ADE9000_WFB_NB_CHAN
+};
+
 /**
  * @enum ade9000_phase
  * @brief ADE9000 available phases.
@@ -1382,6 +1414,21 @@ struct ade9000_dev {
 	uint32_t			vrms_val;
 	/** Variable storing the temperature value in degrees */
 	int32_t				temp_deg;
+	/** Waveform buffer source of the running capture */
+	enum ade9000_wf_src_e		wfb_src;
+	/** Buffer half expected at the next PAGE_FULL interrupt */
+	uint8_t				wfb_half;
+	/** Number of buffer halves filled by the device */
+	uint32_t			wfb_seq;
+	/** Time of the capture start or of the last half read */
+	uint64_t			wfb_time_us;
+	/** Number of buffer halves read */
+	uint32_t			wfb_nb_halves;
+	/** Number of buffer halves overwritten before being read */
+	uint32_t			wfb_overruns;
+	/** Burst read buffer, the samples of the last half read start at
+	 * byte 2 */
+	uint8_t				*wfb_buf;
 };
 
 /* Read device register. */
@@ -1420,4 +1467,22 @@ int ade9000_remove(struct ade9000_dev *dev);
 int ade9000_get_int_status0(struct ade9000_dev *dev, uint32_t msk,
 			    uint8_t *status);
 
+/* Start the continuous waveform buffer capture. */
+int ade9000_wfb_start(struct ade9000_dev *dev, enum ade9000_wf_src_e src,
+		      bool in_en);
+
+/* Handle the PAGE_FULL interrupt and read the filled half of the buffer. */
+int ade9000_wfb_isr(struct ade9000_dev *dev);
+
+/* Get a raw sample of the last half read. */
+int32_t ade9000_wfb_get_raw(struct ade9000_dev *dev, uint32_t set,
+			    enum ade9000_wfb_chan chan);
+
+/* Convert a channel of the last half read to mV or mA. */
+int ade9000_wfb_convert(struct ade9000_dev *dev, enum ade9000_wfb_chan chan,
+			int32_t *data);
+
+/* Stop the waveform buffer capture. */
+int ade9000_wfb_stop(struct ade9000_dev *dev);
+
 #endif // __ADE9000_H__
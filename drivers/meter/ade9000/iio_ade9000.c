@@ -0,0 +1,387 @@
+/***************************************************************************//**
+ *   @file   iio_ade9000.c
+ *   @brief  Implementation of the ADE9000 IIO driver.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include <string.h>
+#include "no_os_error.h"
+#include "no_os_util.h"
+#include "no_os_alloc.h"
+#include "no_os_circular_buffer.h"
+#include "iio_ade9000.h"
+#include "ade9000.h"
+#include "iio.h"
+
+static int ade9000_iio_read_raw(void *dev, char *buf, uint32_t len,
+				const struct iio_ch_info *channel, intptr_t priv);
+static int ade9000_iio_read_scale(void *dev, char *buf, uint32_t len,
+				  const struct iio_ch_info *channel, intptr_t priv);
+static int ade9000_iio_read_sampling_freq(void *dev, char *buf, uint32_t len,
+		const struct iio_ch_info *channel, intptr_t priv);
+static int ade9000_iio_update_channels(void *dev, uint32_t mask);
+static int ade9000_iio_post_disable(void *dev);
+static int32_t ade9000_iio_trigger_handler(struct iio_device_data *dev_data);
+static int32_t ade9000_iio_submit(struct iio_device_data *dev_data);
+
+/* Instantaneous value register of each waveform buffer channel */
+static const uint16_t ade9000_iio_pcf_regs[] = {
+	[ADE9000_WFB_IA] = ADE9000_REG_AI_PCF,
+	[ADE9000_WFB_VA] = ADE9000_REG_AV_PCF,
+	[ADE9000_WFB_IB] = ADE9000_REG_BI_PCF,
+	[ADE9000_WFB_VB] = ADE9000_REG_BV_PCF,
+	[ADE9000_WFB_IC] = ADE9000_REG_CI_PCF,
+	[ADE9000_WFB_VC] = ADE9000_REG_CV_PCF,
+	[ADE9000_WFB_IN] = ADE9000_REG_NI_PCF,
+};
+
+static struct iio_attribute ade9000_iio_attrs[] = {
+	{
+		.name = "raw",
+		.show = ade9000_iio_read_raw,
+	},
+	{
+		.name = "scale",
+		.show = ade9000_iio_read_scale,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+static struct iio_attribute ade9000_iio_dev_attrs[] = {
+	{
+		.name = "sampling_frequency",
+		.show = ade9000_iio_read_sampling_freq,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+static struct scan_type ade9000_iio_scan = {
+	.sign = 's',
+	.realbits = 32,
+	.storagebits = 32,
+	.shift = 0,
+	.is_big_endian = false,
+};
+
+#define ADE9000_IIO_CHANNEL(_type, _num, _wfb_ch) {	\
+	.ch_type = _type,				\
+	.channel = _num,				\
+	.address = _wfb_ch,				\
+	.scan_index = _wfb_ch,				\
+	.scan_type = &ade9000_iio_scan,			\
+	.attributes = ade9000_iio_attrs,		\
+	.ch_out = false,				\
+	.indexed = true,				\
+}
+
+static struct iio_channel ade9000_iio_channels[] = {
+	ADE9000_IIO_CHANNEL(IIO_CURRENT, 0, ADE9000_WFB_IA),
+	ADE9000_IIO_CHANNEL(IIO_VOLTAGE, 0, ADE9000_WFB_VA),
+	ADE9000_IIO_CHANNEL(IIO_CURRENT, 1, ADE9000_WFB_IB),
+	ADE9000_IIO_CHANNEL(IIO_VOLTAGE, 1, ADE9000_WFB_VB),
+	ADE9000_IIO_CHANNEL(IIO_CURRENT, 2, ADE9000_WFB_IC),
+	ADE9000_IIO_CHANNEL(IIO_VOLTAGE, 2, ADE9000_WFB_VC),
+	ADE9000_IIO_CHANNEL(IIO_CURRENT, 3, ADE9000_WFB_IN),
+};
+
+static struct iio_device ade9000_iio_dev = {
+	.num_ch = NO_OS_ARRAY_SIZE(ade9000_iio_channels),
+	.channels = ade9000_iio_channels,
+	.attributes = ade9000_iio_dev_attrs,
+	.pre_enable = (int32_t (*)())ade9000_iio_update_channels,
+	.post_disable = (int32_t (*)())ade9000_iio_post_disable,
+	.trigger_handler = (int32_t (*)())ade9000_iio_trigger_handler,
+	.submit = (int32_t (*)())ade9000_iio_submit,
+};
+
+/**
+ * @brief Read the instantaneous value of a channel.
+ * @param dev - The iio device structure.
+ * @param buf - Buffer to be filled with requested data.
+ * @param len - Length of the received command buffer in bytes.
+ * @param channel - Command channel info.
+ * @param priv - Private descriptor
+ * @return 0 in case of success, error code otherwise
+ */
+static int ade9000_iio_read_raw(void *dev, char *buf, uint32_t len,
+				const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct ade9000_iio_dev *desc = dev;
+	uint32_t reg_val;
+	int32_t val;
+	int ret;
+
+	ret = ade9000_read(desc->ade9000_dev,
+			   ade9000_iio_pcf_regs[channel->address], &reg_val);
+	if (ret)
+		return ret;
+
+	val = (int32_t)reg_val;
+
+	return iio_format_value(buf, len, IIO_VAL_INT, 1, &val);
+}
+
+/**
+ * @brief Read the scale of a channel, in mV or mA per code.
+ * @param dev - The iio device structure.
+ * @param buf - Buffer to be filled with requested data.
+ * @param len - Length of the received command buffer in bytes.
+ * @param channel - Command channel info.
+ * @param priv - Private descriptor
+ * @return 0 in case of success, error code otherwise
+ */
+static int ade9000_iio_read_scale(void *dev, char *buf, uint32_t len,
+				  const struct iio_ch_info *channel, intptr_t priv)
+{
+	int32_t val[2];
+
+	if (channel->type == IIO_VOLTAGE)
+		val[0] = ADE9000_FS_PEAK_VOLTAGE * ADE9000_VOLTAGE_TR_FCN;
+	else
+		val[0] = ADE9000_FS_PEAK_VOLTAGE * ADE9000_CURRENT_TR_FCN;
+	val[1] = ADE9000_PCF_FS_CODES;
+
+	return iio_format_value(buf, len, IIO_VAL_FRACTIONAL, 2, val);
+}
+
+/**
+ * @brief Read the sampling frequency of the waveform buffer.
+ * @param dev - The iio device structure.
+ * @param buf - Buffer to be filled with requested data.
+ * @param len - Length of the received command buffer in bytes.
+ * @param channel - Command channel info.
+ * @param priv - Private descriptor
+ * @return 0 in case of success, error code otherwise
+ */
+static int ade9000_iio_read_sampling_freq(void *dev, char *buf, uint32_t len,
+		const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct ade9000_iio_dev *desc = dev;
+	int32_t val;
+
+	val = desc->wfb_src == ADE9000_SRC_SINC4 ? 32000 : 8000;
+
+	return iio_format_value(buf, len, IIO_VAL_INT, 1, &val);
+}
+
+/**
+ * @brief Store the buffer channels and start the waveform buffer capture.
+ * @param dev - The iio device structure.
+ * @param mask - Mask of the active channels.
+ * @return 0 in case of success, error code otherwise
+ */
+static int ade9000_iio_update_channels(void *dev, uint32_t mask)
+{
+	struct ade9000_iio_dev *desc = dev;
+
+	desc->active_channels = mask;
+	desc->no_of_active_channels = no_os_hweight32(mask);
+	desc->pend_first = 0;
+	desc->pend_nb = 0;
+
+	return ade9000_wfb_start(desc->ade9000_dev, desc->wfb_src,
+				 mask & NO_OS_BIT(ADE9000_WFB_IN));
+}
+
+/**
+ * @brief Stop the waveform buffer capture.
+ * @param dev - The iio device structure.
+ * @return 0 in case of success, error code otherwise
+ */
+static int ade9000_iio_post_disable(void *dev)
+{
+	struct ade9000_iio_dev *desc = dev;
+
+	return ade9000_wfb_stop(desc->ade9000_dev);
+}
+
+/**
+ * @brief Push up to max scans to the iio buffer. The scans left of the last
+ *        half read go first, otherwise the filled half of the waveform
+ *        buffer, if any, is read. What does not fit is kept for the next
+ *        call.
+ * @param desc - The iio device structure.
+ * @param buffer - The iio buffer.
+ * @param max - Maximum number of scans to push.
+ * @return Number of scans pushed, error code otherwise
+ */
+static int ade9000_iio_push(struct ade9000_iio_dev *desc,
+			    struct iio_buffer *buffer, uint32_t max)
+{
+	uint32_t set, ch, i, nb;
+	int ret;
+
+	if (!desc->pend_nb) {
+		ret = ade9000_wfb_isr(desc->ade9000_dev);
+		if (ret <= 0)
+			return ret;
+
+		i = 0;
+		for (set = 0; set < (uint32_t)ret; set++)
+			for (ch = 0; ch < ADE9000_WFB_NB_CHAN; ch++)
+				if (desc->active_channels & NO_OS_BIT(ch))
+					desc->scans[i++] = ade9000_wfb_get_raw(desc->ade9000_dev,
+									       set, ch);
+
+		desc->pend_first = 0;
+		desc->pend_nb = ret;
+	}
+
+	nb = no_os_min(desc->pend_nb, max);
+	ret = iio_buffer_push_scans(buffer, &desc->scans[desc->pend_first *
+				    desc->no_of_active_channels], nb);
+	if (ret)
+		return ret;
+
+	desc->pend_first += nb;
+	desc->pend_nb -= nb;
+
+	return nb;
+}
+
+/**
+ * @brief Handle the PAGE_FULL interrupt trigger.
+ * @param dev_data - The iio device data structure.
+ * @return 0 in case of success, error code otherwise
+ */
+static int32_t ade9000_iio_trigger_handler(struct iio_device_data *dev_data)
+{
+	struct iio_buffer *buffer = dev_data->buffer;
+	uint32_t size;
+	int ret;
+
+	/* Do not overwrite the scans not read by the client yet */
+	ret = no_os_cb_size(buffer->buf, &size);
+	if (ret && ret != -NO_OS_EOVERRUN)
+		return ret;
+
+	ret = ade9000_iio_push(dev_data->dev, buffer,
+			       (buffer->buf->size - size) / buffer->bytes_per_scan);
+	if (ret < 0)
+		return ret;
+
+	return 0;
+}
+
+/**
+ * @brief Fill the iio buffer with the requested number of scans, polling the
+ *        waveform buffer.
+ * @param dev_data - The iio device data structure.
+ * @return 0 in case of success, error code otherwise
+ */
+static int32_t ade9000_iio_submit(struct iio_device_data *dev_data)
+{
+	struct ade9000_iio_dev *desc = dev_data->dev;
+	uint32_t scans = 0;
+	int ret;
+
+	while (scans < dev_data->buffer->samples) {
+		ret = ade9000_iio_push(desc, dev_data->buffer,
+				       dev_data->buffer->samples - scans);
+		if (ret < 0)
+			return ret;
+
+		scans += ret;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Initializes the ADE9000 IIO descriptor.
+ * @param desc - The iio device descriptor.
+ * @param init_param - The structure that contains the device initial parameters.
+ * @return 0 in case of success, an error code otherwise.
+ */
+int ade9000_iio_init(struct ade9000_iio_dev **desc,
+		     struct ade9000_iio_dev_init_param *init_param)
+{
+	struct ade9000_iio_dev *descriptor;
+	int ret;
+
+	if (!init_param || !init_param->ade9000_init_param)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	descriptor->scans = no_os_calloc(ADE9000_WFB_HALF_SETS *
+					 ADE9000_WFB_NB_CHAN,
+					 sizeof(*descriptor->scans));
+	if (!descriptor->scans) {
+		ret = -ENOMEM;
+		goto free_desc;
+	}
+
+	ret = ade9000_init(&descriptor->ade9000_dev,
+			   *init_param->ade9000_init_param);
+	if (ret)
+		goto free_scans;
+
+	ret = ade9000_setup(descriptor->ade9000_dev);
+	if (ret)
+		goto remove_dev;
+
+	descriptor->wfb_src = init_param->wfb_src;
+	descriptor->iio_dev = &ade9000_iio_dev;
+
+	*desc = descriptor;
+
+	return 0;
+
+remove_dev:
+	ade9000_remove(descriptor->ade9000_dev);
+free_scans:
+	no_os_free(descriptor->scans);
+free_desc:
+	no_os_free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Free an iio descriptor.
+ * @param desc - The descriptor to be freed.
+ * @return 0 in case of success, an error code otherwise.
+ */
+int ade9000_iio_remove(struct ade9000_iio_dev *desc)
+{
+	int ret;
+
+	ret = ade9000_remove(desc->ade9000_dev);
+	if (ret)
+		return ret;
+
+	no_os_free(desc->scans);
+	no_os_free(desc);
+
+	return 0;
+}
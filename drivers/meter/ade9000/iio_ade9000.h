@@ -0,0 +1,79 @@
+/***************************************************************************//**
+ *   @file   iio_ade9000.h
+ *   @brief  Header file of the ADE9000 IIO driver.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#ifndef IIO_ADE9000_H
+#define IIO_ADE9000_H
+
+#include "iio.h"
+#include "ade9000.h"
+
+/**
+ * @brief Descriptor that stores an iio specific state.
+ */
+struct ade9000_iio_dev {
+	/** ADE9000 device */
+	struct ade9000_dev *ade9000_dev;
+	/** IIO device */
+	struct iio_device *iio_dev;
+	/** Mask of the channels enabled in the buffer */
+	uint32_t active_channels;
+	/** Number of channels enabled in the buffer */
+	uint8_t no_of_active_channels;
+	/** Waveform buffer source */
+	enum ade9000_wf_src_e wfb_src;
+	/** Scans of the last waveform buffer half read */
+	int32_t *scans;
+	/** First scan of the half not pushed to the iio buffer yet */
+	uint32_t pend_first;
+	/** Number of scans of the half not pushed to the iio buffer yet */
+	uint32_t pend_nb;
+};
+
+/**
+ * @brief Init parameter for the iio descriptor.
+ */
+struct ade9000_iio_dev_init_param {
+	/** ADE9000 initialization parameters */
+	struct ade9000_init_param *ade9000_init_param;
+	/** Waveform buffer source, sinc4 for 32 kSPS */
+	enum ade9000_wf_src_e wfb_src;
+};
+
+/** Initialize the iio descriptor */
+int ade9000_iio_init(struct ade9000_iio_dev **,
+		     struct ade9000_iio_dev_init_param *);
+
+/** Free the iio descriptor */
+int ade9000_iio_remove(struct ade9000_iio_dev *);
+
+#endif /** IIO_ADE9000_H */
@@ -31,6 +31,7 @@
  * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************/
 
+#include <sys/alt_alarm.h>
 #include "no_os_delay.h"
 
 /**
@@ -50,3 +51,24 @@ void no_os_mdelay(uint32_t msecs)
 {
 	usleep(msecs * 1000);
 }
+
+/**
+ * @brief Get current time.
+ * @return Current time structure from system start (seconds, microseconds),
+ * with the resolution of the HAL system clock timer, zero if there is none.
+ */
+struct no_os_time no_os_get_time(void)
+{
+	struct no_os_time t = {0, 0};
+	alt_u32 rate = alt_ticks_per_second();
+	alt_u32 ticks;
+
+	if (!rate)
+		return t;
+
+	ticks = alt_nticks();
+	t.s = ticks / rate;
+	t.us = (uint64_t)(ticks % rate) * 1000000 / rate;
+
+	return t;
+}
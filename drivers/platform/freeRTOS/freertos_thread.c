@@ -0,0 +1,126 @@
+/***************************************************************************//**
+ *   @file   freertos_thread.c
+ *   @brief  Implementation of no-OS threads through FreeRTOS tasks.
+ *   @author Analog Devices Inc.
+********************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <FreeRTOS.h>
+#include "no_os_thread.h"
+#include "no_os_alloc.h"
+#include "no_os_error.h"
+#include "semphr.h"
+#include "task.h"
+
+#ifndef NO_OS_THREAD_STACK_SIZE
+#define NO_OS_THREAD_STACK_SIZE	(configMINIMAL_STACK_SIZE * 4)
+#endif
+
+/**
+ * @struct freertos_thread
+ * @brief FreeRTOS thread handle.
+ */
+struct freertos_thread {
+	/** Given when the thread function returns */
+	SemaphoreHandle_t done;
+	/** Thread function */
+	void (*func)(void *arg);
+	/** Argument passed to the thread function */
+	void *arg;
+};
+
+static void freertos_thread_run(void *arg)
+{
+	struct freertos_thread *t = arg;
+
+	t->func(t->arg);
+	xSemaphoreGive(t->done);
+	vTaskDelete(NULL);
+}
+
+/**
+ * @brief Start a thread, at the priority of the caller.
+ * @param thread - Location where the thread handle will be stored.
+ * @param func - Thread function.
+ * @param arg - Argument passed to the thread function.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_thread_create(void **thread, void (*func)(void *arg), void *arg)
+{
+	struct freertos_thread *t;
+
+	if (!thread || !func)
+		return -EINVAL;
+
+	t = no_os_calloc(1, sizeof(*t));
+	if (!t)
+		return -ENOMEM;
+
+	t->done = xSemaphoreCreateBinary();
+	if (!t->done)
+		goto error;
+
+	t->func = func;
+	t->arg = arg;
+
+	if (xTaskCreate(freertos_thread_run, "no_os_thread",
+			NO_OS_THREAD_STACK_SIZE, t, uxTaskPriorityGet(NULL),
+			NULL) != pdPASS) {
+		vSemaphoreDelete(t->done);
+		goto error;
+	}
+
+	*thread = t;
+
+	return 0;
+
+error:
+	no_os_free(t);
+
+	return -ENOMEM;
+}
+
+/**
+ * @brief Wait for a thread to end and release it.
+ * @param thread - Thread handle.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_thread_join(void *thread)
+{
+	struct freertos_thread *t = thread;
+
+	if (!t)
+		return -EINVAL;
+
+	xSemaphoreTake(t->done, portMAX_DELAY);
+	vSemaphoreDelete(t->done);
+	no_os_free(t);
+
+	return 0;
+}
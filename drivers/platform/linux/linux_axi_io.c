@@ -1,6 +1,6 @@
 /***************************************************************************//**
  *   @file   linux/linux_axi_io.c
- *   @brief  Implementation of AXI IO through UIO/devmem.
+ *   @brief  Implementation of AXI IO through persistent UIO/devmem mappings.
  *   @author Dragos Bogdan (dragos.bogdan@analog.com)
 ********************************************************************************
  * Copyright 2020(c) Analog Devices, Inc.
@@ -31,149 +31,576 @@
  * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************/
 
+#include <errno.h>
 #include <fcntl.h>
 #include <inttypes.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
+#include <pthread.h>
 #include <sys/mman.h>
 #include "no_os_error.h"
 #include "no_os_axi_io.h"
+#include "no_os_prof.h"
+#include "linux_axi_io.h"
 
 /**
- * @brief AXI IO through UIO read/write function.
+ * @struct linux_axi_io_window
+ * @brief Persistent mapping of a register region.
+ */
+struct linux_axi_io_window {
+	/** UIO index (/dev/uioX)/base address */
+	uint32_t base;
+	/** File descriptor backing the mapping */
+	int fd;
+	/** Start of the mapping, as returned by mmap() */
+	void *map;
+	/** Length of the mapping */
+	size_t map_size;
+	/** First register of the region */
+	volatile uint32_t *regs;
+	/** Number of bytes accessible from regs */
+	uint32_t size;
+	/** Size of the region, 0 if unknown */
+	uint32_t max_size;
+	/** Register model of a simulated region, NULL for hardware */
+	const struct linux_axi_io_sim_ops *sim;
+	/** Context passed to the register model */
+	void *sim_ctx;
+	/** Next window */
+	struct linux_axi_io_window *next;
+};
+
+/* Windows, most recently created first */
+static struct linux_axi_io_window *windows;
+static bool exit_registered;
+/* Protects windows and exit_registered */
+static pthread_mutex_t windows_lock = PTHREAD_MUTEX_INITIALIZER;
+/* Changed by linux_axi_io_unmap_all(), drops the cached windows */
+static uint32_t windows_gen;
+/* Last window used by this thread, valid while last_gen == windows_gen */
+static __thread struct linux_axi_io_window *last_window;
+static __thread uint32_t last_gen;
+
+#ifndef DEVMEM
+/**
+ * @brief Get the size of a UIO region from sysfs.
  * @param base - UIO index (/dev/uioX).
- * @param offset - Address offset.
- * @param read - Location where read data will be stored.
- * @param write - Data to be written.
- * @return 0 in case of success, -1 otherwise.
+ * @return Region size, 0 if unavailable.
+ */
+static uint32_t uio_region_size(uint32_t base)
+{
+	char buf[64];
+	FILE *f;
+	unsigned long size = 0;
+
+	sprintf(buf, "/sys/class/uio/uio%"PRIu32"/maps/map0/size", base);
+
+	f = fopen(buf, "r");
+	if (!f)
+		return 0;
+
+	if (fscanf(f, "%lx", &size) != 1)
+		size = 0;
+	fclose(f);
+
+	return size;
+}
+#endif
+
+/**
+ * @brief Map a region and add it to the window list.
+ * @param base - UIO index (/dev/uioX)/base address.
+ * @param fd - File descriptor, owned by the window on success, -1 for
+ * 	       anonymous memory.
+ * @param size - Number of bytes to be mapped.
+ * @param max_size - Size of the region, 0 if unknown.
+ * @param win - The new window.
+ * @return 0 in case of success, negative error code otherwise.
+ * @note Called with windows_lock held.
  */
-static int32_t uio_read_write(uint32_t base, uint32_t offset, uint32_t *read,
-			      uint32_t *write)
+static int32_t linux_axi_io_add(uint32_t base, int fd, uint32_t size,
+				uint32_t max_size,
+				struct linux_axi_io_window **win)
+{
+	struct linux_axi_io_window *w;
+	size_t page = sysconf(_SC_PAGESIZE);
+	off_t map_offset = 0;
+	size_t page_offset = 0;
+
+#ifdef DEVMEM
+	if (!max_size) {
+		page_offset = base & (page - 1);
+		map_offset = base - page_offset;
+	}
+#endif
+
+	w = calloc(1, sizeof(*w));
+	if (!w)
+		return -ENOMEM;
+
+	w->map_size = (page_offset + size + page - 1) & ~(page - 1);
+	w->map = mmap(NULL, w->map_size, PROT_READ | PROT_WRITE,
+		      fd < 0 ? MAP_SHARED | MAP_ANONYMOUS : MAP_SHARED,
+		      fd, map_offset);
+	if (w->map == MAP_FAILED) {
+		printf("%s: mmap() failed\n\r", __func__);
+		free(w);
+		return -errno;
+	}
+
+	w->base = base;
+	w->fd = fd;
+	w->regs = (volatile uint32_t *)((uintptr_t)w->map + page_offset);
+	w->size = size;
+	w->max_size = max_size;
+	w->next = windows;
+	windows = w;
+
+	if (!exit_registered)
+		exit_registered = !atexit(linux_axi_io_unmap_all);
+
+	*win = w;
+
+	return 0;
+}
+
+/**
+ * @brief Open a region that has no window yet.
+ * @param base - UIO index (/dev/uioX)/base address.
+ * @param size - Number of bytes needed.
+ * @param win - The new window.
+ * @return 0 in case of success, negative error code otherwise.
+ * @note Called with windows_lock held.
+ */
+static int32_t linux_axi_io_open(uint32_t base, uint32_t size,
+				 struct linux_axi_io_window **win)
 {
 	char buf[32];
-	int ret;
-	int uio_fd;
-	int32_t status = 0;
-	void *uio_addr;
+	uint32_t max_size = 0;
+	int32_t ret;
+	int fd;
 
+#ifdef DEVMEM
+	sprintf(buf, "/dev/mem");
+	fd = open(buf, O_RDWR | O_SYNC);
+	size = size > LINUX_AXI_IO_DEVMEM_SIZE ? size : LINUX_AXI_IO_DEVMEM_SIZE;
+#else
 	sprintf(buf, "/dev/uio%"PRIu32"", base);
-
-	uio_fd = open(buf, O_RDWR);
-	if (uio_fd < 0) {
+	fd = open(buf, O_RDWR);
+#endif
+	if (fd < 0) {
 		printf("%s: Can't open %s\n\r", __func__, buf);
-		return -1;
+		return -errno;
 	}
 
-	uio_addr = mmap(NULL,
-			offset + sizeof(*read),
-			PROT_READ | PROT_WRITE,
-			MAP_SHARED,
-			uio_fd,
-			0);
-	if (uio_addr == MAP_FAILED) {
-		printf("%s: mmap() failed\n\r", __func__);
-		status = -1;
-		goto close;
+#ifndef DEVMEM
+	max_size = uio_region_size(base);
+	if (max_size) {
+		if (size > max_size) {
+			close(fd);
+			return -EINVAL;
+		}
+		size = max_size;
 	}
+#endif
 
-	if (read)
-		*read = *(uint32_t *)((uintptr_t)uio_addr + offset);
-	if (write)
-		*(uint32_t *)((uintptr_t)uio_addr + offset) = *write;
+	ret = linux_axi_io_add(base, fd, size, max_size, win);
+	if (ret)
+		close(fd);
 
-	ret = munmap(uio_addr, offset + sizeof(*read));
-	if (ret < 0) {
-		printf("%s: munmap() failed\n\r", __func__);
-		status = -1;
+	return ret;
+}
+
+/**
+ * @brief Find or create a window covering the first size bytes of a region.
+ * @param base - UIO index (/dev/uioX)/base address.
+ * @param size - Number of bytes needed.
+ * @param win - The window.
+ * @return 0 in case of success, negative error code otherwise.
+ * @note Called with windows_lock held.
+ */
+static int32_t linux_axi_io_lookup(uint32_t base, uint32_t size,
+				   struct linux_axi_io_window **win)
+{
+	struct linux_axi_io_window *w;
+	int32_t ret;
+	int fd;
+
+	for (w = windows; w; w = w->next)
+		if (w->base == base)
+			break;
+
+	if (!w) {
+		ret = linux_axi_io_open(base, size, &w);
+		if (ret)
+			return ret;
+	} else if (w->size < size) {
+		/*
+		 * Map a larger window and keep the old one until teardown, so
+		 * pointers returned by linux_axi_io_map() stay valid.
+		 */
+		if (w->max_size && size > w->max_size)
+			return -EINVAL;
+
+		fd = dup(w->fd);
+		if (fd < 0)
+			return -errno;
+
+		ret = linux_axi_io_add(base, fd, size, w->max_size, &w);
+		if (ret) {
+			close(fd);
+			return ret;
+		}
 	}
 
-close:
-	ret = close(uio_fd);
-	if (ret < 0) {
-		printf("%s: Can't close %s\n\r", __func__, buf);
-		status = -1;
+	*win = w;
+
+	return 0;
+}
+
+/**
+ * @brief Get a window covering the first size bytes of a region.
+ *
+ * The window last used by the calling thread is checked first, without
+ * taking the lock; windows are only freed by linux_axi_io_unmap_all().
+ * @param base - UIO index (/dev/uioX)/base address.
+ * @param size - Number of bytes needed.
+ * @param win - The window.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_axi_io_get(uint32_t base, uint32_t size,
+				struct linux_axi_io_window **win)
+{
+	struct linux_axi_io_window *w = last_window;
+	uint32_t gen;
+	int32_t ret;
+
+	if (w && last_gen == __atomic_load_n(&windows_gen, __ATOMIC_ACQUIRE) &&
+	    w->base == base && w->size >= size) {
+		*win = w;
+		return 0;
 	}
 
-	return status;
+	pthread_mutex_lock(&windows_lock);
+	gen = windows_gen;
+	ret = linux_axi_io_lookup(base, size, &w);
+	pthread_mutex_unlock(&windows_lock);
+	if (ret)
+		return ret;
+
+	last_window = w;
+	last_gen = gen;
+	*win = w;
+
+	return 0;
 }
 
-#ifdef DEVMEM
 /**
- * @brief AXI IO through devmem read/write function.
- * @param base - Base address.
+ * @brief Check an access and get the window covering it.
+ * @param base - UIO index (/dev/uioX)/base address.
  * @param offset - Address offset.
- * @param read - Location where read data will be stored.
- * @param write - Data to be written.
- * @return 0 in case of success, -1 otherwise.
+ * @param nb_words - Number of registers accessed.
+ * @param win - The window.
+ * @return 0 in case of success, negative error code otherwise.
  */
-static int32_t devmem_read_write(uint32_t base, uint32_t offset, uint32_t *read,
-				 uint32_t *write)
+static int32_t linux_axi_io_access(uint32_t base, uint32_t offset,
+				   uint32_t nb_words,
+				   struct linux_axi_io_window **win)
 {
-	char command[64];
-	char answer[64];
-	FILE *stream;
+	uint64_t end = (uint64_t)offset + (uint64_t)nb_words * 4;
+
+	if ((offset & 3) || end > UINT32_MAX)
+		return -EINVAL;
+
+	return linux_axi_io_get(base, end, win);
+}
+
+/**
+ * @brief Get a persistent mapping of a register region.
+ *
+ * The region is opened and mapped on first use and stays mapped until
+ * linux_axi_io_unmap_all() is called, which happens at exit.
+ * @param base - UIO index (/dev/uioX)/base address.
+ * @param size - Number of bytes that must be accessible.
+ * @param regs - Location where the first register address will be stored.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_axi_io_map(uint32_t base, uint32_t size,
+			 volatile uint32_t **regs)
+{
+	struct linux_axi_io_window *win;
 	int32_t ret;
 
-	if (write)
-		ret = snprintf(command, sizeof(command),
-			       "busybox devmem 0x%x w 0x%x", base + offset, *write);
-	else if (read)
-		ret = snprintf(command, sizeof(command),
-			       "busybox devmem 0x%x", base + offset);
-	else
-		return -1;
+	if (!regs || !size)
+		return -EINVAL;
 
-	if (ret < 0 || ret >= (int32_t) sizeof(command))
-		return -1;
+	ret = linux_axi_io_get(base, size, &win);
+	if (ret)
+		return ret;
 
-	stream = popen(command, "r");
-	if (stream == NULL)
-		return -1;
+	*regs = win->regs;
 
-	if (!(fgets(answer, sizeof(answer), stream))) {
-		ret = -1;
-		goto close;
+	return 0;
+}
+
+/**
+ * @brief Use an already open file as the register region of a base.
+ *
+ * Meant for register files that are not a UIO device or /dev/mem, such as
+ * a memfd standing in for the hardware. The file is mapped from offset 0 and
+ * accesses past size are rejected.
+ * @param base - UIO index (/dev/uioX)/base address.
+ * @param fd - File descriptor, duplicated internally.
+ * @param size - Size of the register region.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_axi_io_attach(uint32_t base, int fd, uint32_t size)
+{
+	struct linux_axi_io_window *win;
+	int32_t ret;
+	int dfd;
+
+	if (fd < 0 || !size)
+		return -EINVAL;
+
+	pthread_mutex_lock(&windows_lock);
+	for (win = windows; win; win = win->next)
+		if (win->base == base) {
+			ret = -EBUSY;
+			goto unlock;
+		}
+
+	dfd = dup(fd);
+	if (dfd < 0) {
+		ret = -errno;
+		goto unlock;
 	}
 
-	if (read)
-		*read = strtol(answer, NULL, 0);
+	ret = linux_axi_io_add(base, dfd, size, size, &win);
+	if (ret)
+		close(dfd);
+unlock:
+	pthread_mutex_unlock(&windows_lock);
+
+	return ret;
+}
 
-	ret = 0;
-close:
-	pclose(stream);
+/**
+ * @brief Use a register model as the register region of a base.
+ *
+ * The registers are backed by anonymous memory. Every access made through
+ * no_os_axi_io_read()/no_os_axi_io_write() and the bulk functions is passed
+ * to the model, which can update the status bits the drivers poll. Direct
+ * accesses through a pointer returned by linux_axi_io_map() bypass it.
+ * @param base - Base address the drivers use.
+ * @param size - Size of the register region.
+ * @param ops - Register model.
+ * @param ctx - Context passed to the model.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_axi_io_attach_sim(uint32_t base, uint32_t size,
+				const struct linux_axi_io_sim_ops *ops,
+				void *ctx)
+{
+	struct linux_axi_io_window *win;
+	int32_t ret;
+
+	if (!size || !ops || !ops->read || !ops->write)
+		return -EINVAL;
+
+	pthread_mutex_lock(&windows_lock);
+	for (win = windows; win; win = win->next)
+		if (win->base == base) {
+			ret = -EBUSY;
+			goto unlock;
+		}
+
+	ret = linux_axi_io_add(base, -1, size, size, &win);
+	if (!ret) {
+		win->sim = ops;
+		win->sim_ctx = ctx;
+	}
+unlock:
+	pthread_mutex_unlock(&windows_lock);
 
 	return ret;
 }
-#endif //DEVMEM
+
+/**
+ * @brief Read a register of a window.
+ * @param win - The window.
+ * @param offset - Register byte offset.
+ * @return Register value.
+ */
+static inline uint32_t linux_axi_io_win_read(struct linux_axi_io_window *win,
+		uint32_t offset)
+{
+	if (win->sim)
+		win->sim->read(win->sim_ctx, win->regs, offset);
+
+	return win->regs[offset >> 2];
+}
+
+/**
+ * @brief Write a register of a window.
+ * @param win - The window.
+ * @param offset - Register byte offset.
+ * @param data - Value to be written.
+ */
+static inline void linux_axi_io_win_write(struct linux_axi_io_window *win,
+		uint32_t offset, uint32_t data)
+{
+	if (win->sim)
+		win->sim->write(win->sim_ctx, win->regs, offset, data);
+	else
+		win->regs[offset >> 2] = data;
+}
+
+/**
+ * @brief Read consecutive registers.
+ * @param base - UIO index (/dev/uioX)/base address.
+ * @param offset - Offset of the first register.
+ * @param data - Location where read data will be stored.
+ * @param nb_words - Number of registers.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_axi_io_read_bulk(uint32_t base, uint32_t offset, uint32_t *data,
+			       uint32_t nb_words)
+{
+	struct linux_axi_io_window *win;
+	volatile uint32_t *reg;
+	uint32_t i;
+	int32_t ret;
+
+	if (!data)
+		return -EINVAL;
+
+	ret = linux_axi_io_access(base, offset, nb_words, &win);
+	if (ret)
+		return ret;
+
+	if (win->sim) {
+		for (i = 0; i < nb_words; i++)
+			data[i] = linux_axi_io_win_read(win, offset + i * 4);
+
+		return 0;
+	}
+
+	reg = win->regs + (offset >> 2);
+	for (i = 0; i < nb_words; i++)
+		data[i] = reg[i];
+
+	return 0;
+}
+
+/**
+ * @brief Write consecutive registers.
+ * @param base - UIO index (/dev/uioX)/base address.
+ * @param offset - Offset of the first register.
+ * @param data - Data to be written.
+ * @param nb_words - Number of registers.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_axi_io_write_bulk(uint32_t base, uint32_t offset,
+				const uint32_t *data, uint32_t nb_words)
+{
+	struct linux_axi_io_window *win;
+	volatile uint32_t *reg;
+	uint32_t i;
+	int32_t ret;
+
+	if (!data)
+		return -EINVAL;
+
+	ret = linux_axi_io_access(base, offset, nb_words, &win);
+	if (ret)
+		return ret;
+
+	if (win->sim) {
+		for (i = 0; i < nb_words; i++)
+			linux_axi_io_win_write(win, offset + i * 4, data[i]);
+
+		return 0;
+	}
+
+	reg = win->regs + (offset >> 2);
+	for (i = 0; i < nb_words; i++)
+		reg[i] = data[i];
+
+	return 0;
+}
+
+/**
+ * @brief Unmap and close every cached window.
+ *
+ * Pointers returned by linux_axi_io_map() are invalid afterwards, and no
+ * other thread may be accessing the registers meanwhile. Called
+ * automatically at exit.
+ */
+void linux_axi_io_unmap_all(void)
+{
+	struct linux_axi_io_window *w;
+
+	pthread_mutex_lock(&windows_lock);
+	while (windows) {
+		w = windows;
+		windows = w->next;
+		munmap(w->map, w->map_size);
+		if (w->fd >= 0)
+			close(w->fd);
+		free(w);
+	}
+	__atomic_add_fetch(&windows_gen, 1, __ATOMIC_RELEASE);
+	pthread_mutex_unlock(&windows_lock);
+	last_window = NULL;
+}
+
 /**
  * @brief AXI IO through UIO/devmem read function.
  * @param base - UIO index (/dev/uioX)/base address.
  * @param offset - Address offset.
  * @param data - Location where read data will be stored.
- * @return 0 in case of success, -1 otherwise.
+ * @return 0 in case of success, negative error code otherwise.
  */
 int32_t no_os_axi_io_read(uint32_t base, uint32_t offset, uint32_t *data)
 {
-#ifdef DEVMEM
-	return devmem_read_write(base, offset, data, NULL);
-#else
-	return uio_read_write(base, offset, data, NULL);
-#endif
+	struct linux_axi_io_window *win;
+	uint64_t start = no_os_prof_start();
+	int32_t ret;
+
+	ret = linux_axi_io_access(base, offset, 1, &win);
+	if (ret)
+		return ret;
+
+	*data = linux_axi_io_win_read(win, offset);
+
+	no_os_prof_axi(NO_OS_PROF_SITE, start, base, offset, false);
+
+	return 0;
 }
 
 /**
- * @brief AXI IO through UIO specific write function.
- * @param base - UIO index (/dev/uioX).
+ * @brief AXI IO through UIO/devmem write function.
+ * @param base - UIO index (/dev/uioX)/base address.
  * @param offset - Address offset.
  * @param data - Data to be written.
- * @return 0 in case of success, -1 otherwise.
+ * @return 0 in case of success, negative error code otherwise.
  */
 int32_t no_os_axi_io_write(uint32_t base, uint32_t offset, uint32_t data)
 {
-#ifdef DEVMEM
-	return devmem_read_write(base, offset, NULL, &data);
-#else
-	return uio_read_write(base, offset, NULL, &data);
-#endif
+	struct linux_axi_io_window *win;
+	uint64_t start = no_os_prof_start();
+	int32_t ret;
+
+	ret = linux_axi_io_access(base, offset, 1, &win);
+	if (ret)
+		return ret;
+
+	linux_axi_io_win_write(win, offset, data);
+
+	no_os_prof_axi(NO_OS_PROF_SITE, start, base, offset, true);
+
+	return 0;
 }
@@ -0,0 +1,103 @@
+/*******************************************************************************
+ *   @file   linux/linux_axi_io.h
+ *   @brief  Header containing the Linux specific AXI IO mapping cache API.
+ *   @author Analog Devices Inc.
+********************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef LINUX_AXI_IO_H_
+#define LINUX_AXI_IO_H_
+
+#include <stdint.h>
+
+/**
+ * Size mapped for a /dev/mem window when the caller does not ask for more.
+ * Covers the register map of every ADI AXI IP core.
+ */
+#define LINUX_AXI_IO_DEVMEM_SIZE	0x10000
+
+/**
+ * @struct linux_axi_io_sim_ops
+ * @brief Register model of a simulated region.
+ */
+struct linux_axi_io_sim_ops {
+	/** Called before a register is read, may update regs[offset >> 2] */
+	void (*read)(void *ctx, volatile uint32_t *regs, uint32_t offset);
+	/** Called instead of storing a register */
+	void (*write)(void *ctx, volatile uint32_t *regs, uint32_t offset,
+		      uint32_t data);
+};
+
+/**
+ * @brief Read a register through a window returned by linux_axi_io_map().
+ * @param regs - Window start.
+ * @param offset - Register byte offset.
+ * @return Register value.
+ */
+static inline uint32_t linux_axi_io_reg_read(volatile uint32_t *regs,
+		uint32_t offset)
+{
+	return regs[offset >> 2];
+}
+
+/**
+ * @brief Write a register through a window returned by linux_axi_io_map().
+ * @param regs - Window start.
+ * @param offset - Register byte offset.
+ * @param data - Value to be written.
+ */
+static inline void linux_axi_io_reg_write(volatile uint32_t *regs,
+		uint32_t offset, uint32_t data)
+{
+	regs[offset >> 2] = data;
+}
+
+/* Get a persistent mapping of at least size bytes for a base */
+int32_t linux_axi_io_map(uint32_t base, uint32_t size,
+			 volatile uint32_t **regs);
+
+/* Use an already open file (e.g. a memfd) as register file for a base */
+int32_t linux_axi_io_attach(uint32_t base, int fd, uint32_t size);
+
+/* Use a register model (e.g. linux_axi_sim) as register file for a base */
+int32_t linux_axi_io_attach_sim(uint32_t base, uint32_t size,
+				const struct linux_axi_io_sim_ops *ops,
+				void *ctx);
+
+/* Read consecutive registers */
+int32_t linux_axi_io_read_bulk(uint32_t base, uint32_t offset, uint32_t *data,
+			       uint32_t nb_words);
+
+/* Write consecutive registers */
+int32_t linux_axi_io_write_bulk(uint32_t base, uint32_t offset,
+				const uint32_t *data, uint32_t nb_words);
+
+/* Unmap and close every cached window */
+void linux_axi_io_unmap_all(void);
+
+#endif // LINUX_AXI_IO_H_
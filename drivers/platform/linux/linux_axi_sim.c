@@ -0,0 +1,623 @@
+/***************************************************************************//**
+ *   @file   linux_axi_sim.c
+ *   @brief  Simulated ADI AXI HDL cores for host builds.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include <errno.h>
+#include <stdlib.h>
+#include <time.h>
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include "linux_axi_io.h"
+#include "linux_axi_sim.h"
+
+#define SIM_VER(major, minor, patch)	\
+	(((major) << 16) | ((minor) << 8) | (patch))
+
+/* Common to all cores */
+#define SIM_REG_VERSION			0x0000
+#define SIM_REG_FPGA_INFO		0x001C
+
+/* axi_adxcvr */
+#define SIM_XCVR_REG_RESETN		0x0010
+#define SIM_XCVR_RESETN			NO_OS_BIT(0)
+#define SIM_XCVR_REG_STATUS		0x0014
+#define SIM_XCVR_REG_SYNTH		0x0024
+#define SIM_XCVR_REG_DRP_SEL(x)		(0x0040 + (x))
+#define SIM_XCVR_REG_DRP_CTRL(x)	(0x0044 + (x))
+#define SIM_XCVR_DRP_CTRL_WR		NO_OS_BIT(28)
+#define SIM_XCVR_REG_DRP_STATUS(x)	(0x0048 + (x))
+#define SIM_XCVR_DRP_PORT_COMMON	0x00
+#define SIM_XCVR_DRP_PORT_CHANNEL	0x20
+#define SIM_XCVR_BROADCAST		0xff
+#define SIM_XCVR_REG_FPGA_VOLTAGE	0x0140
+
+/* axi_jesd204_rx/tx */
+#define SIM_JESD_REG_MAGIC		0x000C
+#define SIM_JESD_RX_MAGIC		(('2' << 24) | ('0' << 16) | ('4' << 8) | 'R')
+#define SIM_JESD_TX_MAGIC		(('2' << 24) | ('0' << 16) | ('4' << 8) | 'T')
+#define SIM_JESD_REG_NUM_LANES		0x0010
+#define SIM_JESD_REG_DATA_PATH_WIDTH	0x0014
+#define SIM_JESD_REG_SYNTH_REG_1	0x0018
+#define SIM_JESD_REG_LINK_DISABLE	0x00C0
+#define SIM_JESD_REG_LINK_STATE		0x00C4
+#define SIM_JESD_REG_SYSREF_STATUS	0x0108
+#define SIM_JESD_REG_LINK_STATUS	0x0280
+#define SIM_JESD_LINK_STATUS_CGS	2
+#define SIM_JESD_LINK_STATUS_DATA	3
+#define SIM_JESD_REG_LANE_STATUS(x)	(((x) * 32) + 0x300)
+#define SIM_JESD_EMB_STATE_LOCK		4
+
+/* axi_adc_core/axi_dac_core */
+#define SIM_CONV_REG_RSTN		0x0040
+#define SIM_CONV_RSTN			NO_OS_BIT(0)
+#define SIM_CONV_REG_CLK_FREQ		0x0054
+#define SIM_CONV_REG_CLK_RATIO		0x0058
+#define SIM_CONV_REG_STATUS		0x005C
+#define SIM_ADC_REG_CHAN_STATUS(c)	(0x0404 + (c) * 0x40)
+
+/* axi_dmac */
+#define SIM_DMAC_REG_IRQ_PENDING	0x0084
+#define SIM_DMAC_IRQ_SOT		NO_OS_BIT(0)
+#define SIM_DMAC_IRQ_EOT		NO_OS_BIT(1)
+#define SIM_DMAC_REG_TRANSFER_ID	0x0404
+#define SIM_DMAC_REG_TRANSFER_SUBMIT	0x0408
+#define SIM_DMAC_REG_TRANSFER_DONE	0x0428
+
+/**
+ * @brief Get the current time.
+ * @return Time in microseconds.
+ */
+static uint64_t linux_axi_sim_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/**
+ * @brief Start the lock/transfer timer of a core.
+ * @param sim - The simulated core.
+ * @param run - True when reset is released, link enabled or transfer started.
+ */
+static void linux_axi_sim_run(struct linux_axi_sim_desc *sim, bool run)
+{
+	if (run && !sim->running)
+		sim->ready_us = linux_axi_sim_now() + sim->param.lock_us;
+	sim->running = run;
+}
+
+/**
+ * @brief Check if the core reports it is ready.
+ * @param sim - The simulated core.
+ * @return true if ready.
+ */
+static bool linux_axi_sim_ready(struct linux_axi_sim_desc *sim)
+{
+	return sim->running && !sim->fault &&
+	       linux_axi_sim_now() >= sim->ready_us;
+}
+
+/**
+ * @brief Get the DRP registers of a transceiver port.
+ * @param sim - The simulated core.
+ * @param common - Common port instead of channel port.
+ * @param port - Lane index.
+ * @return The registers, NULL if the port does not exist.
+ */
+static uint16_t *linux_axi_sim_drp_port(struct linux_axi_sim_desc *sim,
+					bool common, uint32_t port)
+{
+	if (port >= sim->nb_drp_ports)
+		return NULL;
+
+	return sim->drp[common ? sim->nb_drp_ports + port : port];
+}
+
+/**
+ * @brief Handle a DRP access of the transceiver.
+ * @param sim - The simulated core.
+ * @param regs - Register file.
+ * @param drp - DRP interface (common or channel).
+ * @param ctrl - Value written to the control register.
+ */
+static void linux_axi_sim_drp(struct linux_axi_sim_desc *sim,
+			      volatile uint32_t *regs, uint32_t drp,
+			      uint32_t ctrl)
+{
+	uint32_t sel = regs[SIM_XCVR_REG_DRP_SEL(drp) >> 2] & 0xff;
+	uint32_t addr = (ctrl >> 16) & 0xfff;
+	bool common = drp == SIM_XCVR_DRP_PORT_COMMON;
+	uint16_t *port;
+	uint32_t i;
+
+	if (ctrl & SIM_XCVR_DRP_CTRL_WR) {
+		for (i = 0; i < sim->nb_drp_ports; i++) {
+			if (sel != SIM_XCVR_BROADCAST && sel != i)
+				continue;
+			port = linux_axi_sim_drp_port(sim, common, i);
+			port[addr] = ctrl & 0xffff;
+		}
+		regs[SIM_XCVR_REG_DRP_STATUS(drp) >> 2] = 0;
+
+		return;
+	}
+
+	/* Transfers complete at once, the busy bit is never seen set */
+	port = linux_axi_sim_drp_port(sim, common,
+				      sel == SIM_XCVR_BROADCAST ? 0 : sel);
+	regs[SIM_XCVR_REG_DRP_STATUS(drp) >> 2] = port ? port[addr] : 0;
+}
+
+/**
+ * @brief Register read hook of the transceiver.
+ * @param sim - The simulated core.
+ * @param regs - Register file.
+ * @param offset - Register offset.
+ */
+static void linux_axi_sim_xcvr_read(struct linux_axi_sim_desc *sim,
+				    volatile uint32_t *regs, uint32_t offset)
+{
+	struct linux_axi_sim_init_param *p = &sim->param;
+
+	switch (offset) {
+	case SIM_REG_FPGA_INFO:
+		regs[offset >> 2] = p->fpga_info;
+		break;
+	case SIM_XCVR_REG_FPGA_VOLTAGE:
+		regs[offset >> 2] = p->fpga_voltage;
+		break;
+	case SIM_XCVR_REG_STATUS:
+		/* Buffer status errors are never reported */
+		regs[offset >> 2] = linux_axi_sim_ready(sim);
+		break;
+	case SIM_XCVR_REG_SYNTH:
+		regs[offset >> 2] = (p->num_lanes & 0xff) | (p->tx << 8) |
+				    ((p->jesd204c ? 2 : 1) << 12) |
+				    ((p->xcvr_type & 0xf) << 16) |
+				    (p->qpll_enable << 20);
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * @brief Register write hook of the transceiver.
+ * @param sim - The simulated core.
+ * @param regs - Register file.
+ * @param offset - Register offset.
+ * @param data - Value written.
+ */
+static void linux_axi_sim_xcvr_write(struct linux_axi_sim_desc *sim,
+				     volatile uint32_t *regs, uint32_t offset,
+				     uint32_t data)
+{
+	switch (offset) {
+	case SIM_XCVR_REG_RESETN:
+		linux_axi_sim_run(sim, data & SIM_XCVR_RESETN);
+		break;
+	case SIM_XCVR_REG_DRP_CTRL(SIM_XCVR_DRP_PORT_COMMON):
+		linux_axi_sim_drp(sim, regs, SIM_XCVR_DRP_PORT_COMMON, data);
+		break;
+	case SIM_XCVR_REG_DRP_CTRL(SIM_XCVR_DRP_PORT_CHANNEL):
+		linux_axi_sim_drp(sim, regs, SIM_XCVR_DRP_PORT_CHANNEL, data);
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * @brief Register read hook of the JESD204 link layer.
+ * @param sim - The simulated core.
+ * @param regs - Register file.
+ * @param offset - Register offset.
+ */
+static void linux_axi_sim_jesd_read(struct linux_axi_sim_desc *sim,
+				    volatile uint32_t *regs, uint32_t offset)
+{
+	struct linux_axi_sim_init_param *p = &sim->param;
+	bool up = linux_axi_sim_ready(sim);
+	uint32_t width = p->jesd204c ? 8 : 4;
+
+	if (offset >= SIM_JESD_REG_LANE_STATUS(0) &&
+	    offset < SIM_JESD_REG_LANE_STATUS(p->num_lanes) &&
+	    !(offset & 0x1f)) {
+		if (!up)
+			regs[offset >> 2] = 0;
+		else if (p->jesd204c)
+			regs[offset >> 2] = SIM_JESD_EMB_STATE_LOCK << 8;
+		else
+			regs[offset >> 2] = 0x3;
+		return;
+	}
+
+	switch (offset) {
+	case SIM_JESD_REG_MAGIC:
+		regs[offset >> 2] = sim->core == LINUX_AXI_SIM_JESD204_RX ?
+				    SIM_JESD_RX_MAGIC : SIM_JESD_TX_MAGIC;
+		break;
+	case SIM_JESD_REG_NUM_LANES:
+		regs[offset >> 2] = p->num_lanes;
+		break;
+	case SIM_JESD_REG_DATA_PATH_WIDTH:
+		regs[offset >> 2] = no_os_find_first_set_bit(width) |
+				    (width << 8);
+		break;
+	case SIM_JESD_REG_SYNTH_REG_1:
+		regs[offset >> 2] = (p->jesd204c ? 2 : 1) << 8;
+		break;
+	case SIM_JESD_REG_LINK_STATE:
+		regs[offset >> 2] = !sim->running;
+		break;
+	case SIM_JESD_REG_LINK_STATUS:
+		if (up)
+			regs[offset >> 2] = SIM_JESD_LINK_STATUS_DATA;
+		else
+			regs[offset >> 2] = sim->running ?
+					    SIM_JESD_LINK_STATUS_CGS : 0;
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * @brief Register write hook of the JESD204 link layer.
+ * @param sim - The simulated core.
+ * @param regs - Register file.
+ * @param offset - Register offset.
+ * @param data - Value written.
+ */
+static void linux_axi_sim_jesd_write(struct linux_axi_sim_desc *sim,
+				     volatile uint32_t *regs, uint32_t offset,
+				     uint32_t data)
+{
+	switch (offset) {
+	case SIM_JESD_REG_LINK_DISABLE:
+		regs[offset >> 2] = data;
+		linux_axi_sim_run(sim, !(data & 1));
+		/* SYSREF is captured as soon as the link is enabled */
+		if (sim->running)
+			regs[SIM_JESD_REG_SYSREF_STATUS >> 2] |= 1;
+		break;
+	case SIM_JESD_REG_SYSREF_STATUS:
+		regs[offset >> 2] &= ~data;
+		break;
+	default:
+		regs[offset >> 2] = data;
+		break;
+	}
+}
+
+/**
+ * @brief Register read hook of the ADC/DAC core.
+ * @param sim - The simulated core.
+ * @param regs - Register file.
+ * @param offset - Register offset.
+ */
+static void linux_axi_sim_conv_read(struct linux_axi_sim_desc *sim,
+				    volatile uint32_t *regs, uint32_t offset)
+{
+	switch (offset) {
+	case SIM_CONV_REG_STATUS:
+		regs[offset >> 2] = linux_axi_sim_ready(sim);
+		break;
+	case SIM_CONV_REG_CLK_FREQ:
+		/* The core counts in units of 100 MHz / 2^16 */
+		regs[offset >> 2] = ((uint64_t)sim->param.clk_hz << 8) / 390625;
+		break;
+	case SIM_CONV_REG_CLK_RATIO:
+		regs[offset >> 2] = 1;
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * @brief Register write hook of the ADC/DAC core.
+ * @param sim - The simulated core.
+ * @param regs - Register file.
+ * @param offset - Register offset.
+ * @param data - Value written.
+ */
+static void linux_axi_sim_conv_write(struct linux_axi_sim_desc *sim,
+				     volatile uint32_t *regs, uint32_t offset,
+				     uint32_t data)
+{
+	uint32_t ch;
+
+	if (offset == SIM_CONV_REG_RSTN)
+		linux_axi_sim_run(sim, data & SIM_CONV_RSTN);
+
+	/* PN monitor errors are write 1 to clear and never set again */
+	for (ch = 0; ch < sim->param.num_lanes; ch++) {
+		if (sim->core == LINUX_AXI_SIM_ADC &&
+		    offset == SIM_ADC_REG_CHAN_STATUS(ch)) {
+			regs[offset >> 2] &= ~data;
+			return;
+		}
+	}
+
+	regs[offset >> 2] = data;
+}
+
+/**
+ * @brief Register read hook of the DMA controller.
+ * @param sim - The simulated core.
+ * @param regs - Register file.
+ * @param offset - Register offset.
+ */
+static void linux_axi_sim_dmac_read(struct linux_axi_sim_desc *sim,
+				    volatile uint32_t *regs, uint32_t offset)
+{
+	uint32_t id;
+
+	if (offset != SIM_DMAC_REG_IRQ_PENDING &&
+	    offset != SIM_DMAC_REG_TRANSFER_DONE &&
+	    offset != SIM_DMAC_REG_TRANSFER_SUBMIT)
+		return;
+
+	/* No data is moved, the transfer only completes after lock_us */
+	if (linux_axi_sim_ready(sim)) {
+		id = regs[SIM_DMAC_REG_TRANSFER_ID >> 2] & 0x3;
+		regs[SIM_DMAC_REG_IRQ_PENDING >> 2] |= SIM_DMAC_IRQ_SOT |
+						      SIM_DMAC_IRQ_EOT;
+		regs[SIM_DMAC_REG_TRANSFER_DONE >> 2] |= NO_OS_BIT(id);
+		regs[SIM_DMAC_REG_TRANSFER_SUBMIT >> 2] = 0;
+		regs[SIM_DMAC_REG_TRANSFER_ID >> 2] = (id + 1) & 0x3;
+		sim->running = false;
+	}
+}
+
+/**
+ * @brief Register write hook of the DMA controller.
+ * @param sim - The simulated core.
+ * @param regs - Register file.
+ * @param offset - Register offset.
+ * @param data - Value written.
+ */
+static void linux_axi_sim_dmac_write(struct linux_axi_sim_desc *sim,
+				     volatile uint32_t *regs, uint32_t offset,
+				     uint32_t data)
+{
+	switch (offset) {
+	case SIM_DMAC_REG_IRQ_PENDING:
+		regs[offset >> 2] &= ~data;
+		break;
+	case SIM_DMAC_REG_TRANSFER_SUBMIT:
+		regs[offset >> 2] = data & 1;
+		if (data & 1) {
+			regs[SIM_DMAC_REG_TRANSFER_DONE >> 2] = 0;
+			linux_axi_sim_run(sim, true);
+		}
+		break;
+	default:
+		regs[offset >> 2] = data;
+		break;
+	}
+}
+
+/**
+ * @brief Register read hook.
+ * @param ctx - The simulated core.
+ * @param regs - Register file.
+ * @param offset - Register offset.
+ */
+static void linux_axi_sim_read(void *ctx, volatile uint32_t *regs,
+			       uint32_t offset)
+{
+	struct linux_axi_sim_desc *sim = ctx;
+
+	if (offset == SIM_REG_VERSION) {
+		regs[offset >> 2] = sim->version;
+		return;
+	}
+
+	switch (sim->core) {
+	case LINUX_AXI_SIM_ADXCVR:
+		linux_axi_sim_xcvr_read(sim, regs, offset);
+		break;
+	case LINUX_AXI_SIM_JESD204_RX:
+	case LINUX_AXI_SIM_JESD204_TX:
+		linux_axi_sim_jesd_read(sim, regs, offset);
+		break;
+	case LINUX_AXI_SIM_ADC:
+	case LINUX_AXI_SIM_DAC:
+		linux_axi_sim_conv_read(sim, regs, offset);
+		break;
+	case LINUX_AXI_SIM_DMAC:
+		linux_axi_sim_dmac_read(sim, regs, offset);
+		break;
+	}
+}
+
+/**
+ * @brief Register write hook.
+ * @param ctx - The simulated core.
+ * @param regs - Register file.
+ * @param offset - Register offset.
+ * @param data - Value written.
+ */
+static void linux_axi_sim_write(void *ctx, volatile uint32_t *regs,
+				uint32_t offset, uint32_t data)
+{
+	struct linux_axi_sim_desc *sim = ctx;
+
+	switch (sim->core) {
+	case LINUX_AXI_SIM_ADXCVR:
+		regs[offset >> 2] = data;
+		linux_axi_sim_xcvr_write(sim, regs, offset, data);
+		break;
+	case LINUX_AXI_SIM_JESD204_RX:
+	case LINUX_AXI_SIM_JESD204_TX:
+		linux_axi_sim_jesd_write(sim, regs, offset, data);
+		break;
+	case LINUX_AXI_SIM_ADC:
+	case LINUX_AXI_SIM_DAC:
+		linux_axi_sim_conv_write(sim, regs, offset, data);
+		break;
+	case LINUX_AXI_SIM_DMAC:
+		linux_axi_sim_dmac_write(sim, regs, offset, data);
+		break;
+	}
+}
+
+static const struct linux_axi_io_sim_ops linux_axi_sim_ops = {
+	.read = linux_axi_sim_read,
+	.write = linux_axi_sim_write,
+};
+
+/**
+ * @brief Simulate an HDL core at a base address.
+ *
+ * The identification registers read what the driver expects for the
+ * configuration in param, status bits follow the resets, link enables and
+ * transfer submissions made by the driver, with lock_us of latency. Other
+ * registers read back what was written.
+ * @param desc - The simulated core.
+ * @param param - Initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_axi_sim_init(struct linux_axi_sim_desc **desc,
+		       const struct linux_axi_sim_init_param *param)
+{
+	static const uint32_t versions[] = {
+		[LINUX_AXI_SIM_ADXCVR] = SIM_VER(17, 5, 'a'),
+		[LINUX_AXI_SIM_JESD204_RX] = SIM_VER(1, 7, 'a'),
+		[LINUX_AXI_SIM_JESD204_TX] = SIM_VER(1, 7, 'a'),
+		[LINUX_AXI_SIM_ADC] = SIM_VER(10, 0, 'a'),
+		[LINUX_AXI_SIM_DAC] = SIM_VER(9, 1, 'b'),
+		[LINUX_AXI_SIM_DMAC] = SIM_VER(4, 3, 'a'),
+	};
+	struct linux_axi_sim_desc *sim;
+	int ret;
+
+	if (!desc || !param || param->core > LINUX_AXI_SIM_DMAC)
+		return -EINVAL;
+
+	sim = no_os_calloc(1, sizeof(*sim));
+	if (!sim)
+		return -ENOMEM;
+
+	sim->base = param->base;
+	sim->core = param->core;
+	sim->version = param->version ? param->version : versions[param->core];
+	sim->param = *param;
+
+	if (sim->core == LINUX_AXI_SIM_ADXCVR && param->num_lanes) {
+		sim->nb_drp_ports = param->num_lanes;
+		sim->drp = no_os_calloc(2 * sim->nb_drp_ports,
+					sizeof(*sim->drp));
+		if (!sim->drp) {
+			ret = -ENOMEM;
+			goto error;
+		}
+	}
+
+	ret = linux_axi_io_attach_sim(param->base, LINUX_AXI_SIM_SIZE,
+				      &linux_axi_sim_ops, sim);
+	if (ret)
+		goto error;
+
+	*desc = sim;
+
+	return 0;
+
+error:
+	no_os_free(sim->drp);
+	no_os_free(sim);
+
+	return ret;
+}
+
+/**
+ * @brief Keep the core from reporting ready, or release it.
+ *
+ * The transceiver keeps its PLL unlocked, the JESD204 link stays in CGS, the
+ * converter cores report a status error and DMA transfers never end.
+ * @param desc - The simulated core.
+ * @param fault - true to inject the fault, false to release it.
+ */
+void linux_axi_sim_set_fault(struct linux_axi_sim_desc *desc, bool fault)
+{
+	if (desc)
+		desc->fault = fault;
+}
+
+/**
+ * @brief Read a DRP register of a transceiver port.
+ * @param desc - The simulated core.
+ * @param common - Common port instead of channel port.
+ * @param port - Lane index.
+ * @param reg - DRP register address.
+ * @param val - Location where the value will be stored.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_axi_sim_drp_read(struct linux_axi_sim_desc *desc, bool common,
+			   uint32_t port, uint32_t reg, uint16_t *val)
+{
+	uint16_t *drp;
+
+	if (!desc || !val || reg >= LINUX_AXI_SIM_DRP_SIZE)
+		return -EINVAL;
+
+	drp = linux_axi_sim_drp_port(desc, common, port);
+	if (!drp)
+		return -EINVAL;
+
+	*val = drp[reg];
+
+	return 0;
+}
+
+/**
+ * @brief Free a simulated core.
+ *
+ * The register window stays attached to the core until
+ * linux_axi_io_unmap_all(), which must be called first.
+ * @param desc - The simulated core.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_axi_sim_remove(struct linux_axi_sim_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	no_os_free(desc->drp);
+	no_os_free(desc);
+
+	return 0;
+}
@@ -0,0 +1,137 @@
+/***************************************************************************//**
+ *   @file   linux_axi_sim.h
+ *   @brief  Simulated ADI AXI HDL cores for host builds.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#ifndef LINUX_AXI_SIM_H_
+#define LINUX_AXI_SIM_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** Register window size of a simulated core */
+#define LINUX_AXI_SIM_SIZE		0x1000
+/** Number of DRP registers of a transceiver port */
+#define LINUX_AXI_SIM_DRP_SIZE		0x1000
+
+/**
+ * @enum linux_axi_sim_core
+ * @brief HDL cores the simulator can stand in for.
+ */
+enum linux_axi_sim_core {
+	/** axi_adxcvr */
+	LINUX_AXI_SIM_ADXCVR,
+	/** axi_jesd204_rx */
+	LINUX_AXI_SIM_JESD204_RX,
+	/** axi_jesd204_tx */
+	LINUX_AXI_SIM_JESD204_TX,
+	/** axi_adc_core */
+	LINUX_AXI_SIM_ADC,
+	/** axi_dac_core */
+	LINUX_AXI_SIM_DAC,
+	/** axi_dmac */
+	LINUX_AXI_SIM_DMAC,
+};
+
+/**
+ * @struct linux_axi_sim_init_param
+ * @brief Simulated core initialization parameters.
+ */
+struct linux_axi_sim_init_param {
+	/** Base address the driver uses */
+	uint32_t base;
+	/** Core to be simulated */
+	enum linux_axi_sim_core core;
+	/** Core version, 0 for a version every driver supports */
+	uint32_t version;
+	/** Lanes (ADXCVR, JESD204) or channels (ADC, DAC) */
+	uint32_t num_lanes;
+	/** ADXCVR: TX transceiver */
+	bool tx;
+	/** ADXCVR: transceiver type (XILINX_XCVR_TYPE_*) */
+	uint32_t xcvr_type;
+	/** ADXCVR: QPLL instantiated */
+	bool qpll_enable;
+	/** ADXCVR: AXI_REG_FPGA_INFO value */
+	uint32_t fpga_info;
+	/** ADXCVR: FPGA voltage in mV */
+	uint32_t fpga_voltage;
+	/** ADXCVR, JESD204: 64b66b link layer */
+	bool jesd204c;
+	/** ADC, DAC: interface clock in Hz */
+	uint32_t clk_hz;
+	/**
+	 * Time from reset release (ADXCVR, ADC, DAC), link enable (JESD204) or
+	 * transfer submit (DMAC) until the core reports it is ready.
+	 */
+	uint32_t lock_us;
+};
+
+/**
+ * @struct linux_axi_sim_desc
+ * @brief Simulated core descriptor.
+ */
+struct linux_axi_sim_desc {
+	/** Base address the driver uses */
+	uint32_t base;
+	/** Simulated core */
+	enum linux_axi_sim_core core;
+	/** Core version */
+	uint32_t version;
+	/** Initialization parameters */
+	struct linux_axi_sim_init_param param;
+	/** Reset released, link enabled or transfer submitted */
+	bool running;
+	/** Time at which the core reports it is ready */
+	uint64_t ready_us;
+	/** Keep reporting not ready, to exercise driver timeouts */
+	bool fault;
+	/** DRP registers, channel ports first, then common ports */
+	uint16_t (*drp)[LINUX_AXI_SIM_DRP_SIZE];
+	/** Number of channel (and common) DRP ports */
+	uint32_t nb_drp_ports;
+};
+
+/* Simulate a core at a base address */
+int linux_axi_sim_init(struct linux_axi_sim_desc **desc,
+		       const struct linux_axi_sim_init_param *param);
+
+/* Keep the core from reporting ready, or release it */
+void linux_axi_sim_set_fault(struct linux_axi_sim_desc *desc, bool fault);
+
+/* Read a DRP register of a transceiver port */
+int linux_axi_sim_drp_read(struct linux_axi_sim_desc *desc, bool common,
+			   uint32_t port, uint32_t reg, uint16_t *val);
+
+/* Free a simulated core, after linux_axi_io_unmap_all() */
+int linux_axi_sim_remove(struct linux_axi_sim_desc *desc);
+
+#endif // LINUX_AXI_SIM_H_
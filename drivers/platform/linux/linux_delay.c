@@ -32,7 +32,10 @@
 *******************************************************************************/
 
 #include <stdint.h>
+#include <time.h>
 #include <unistd.h>
+#include "no_os_delay.h"
+#include "no_os_prof.h"
 
 /**
  * @brief Generate microseconds delay.
@@ -40,7 +43,10 @@
  */
 void no_os_udelay(uint32_t usecs)
 {
+	uint64_t start = no_os_prof_start();
+
 	usleep(usecs);
+	no_os_prof_record(NO_OS_PROF_DELAY, NO_OS_PROF_SITE, start, 0);
 }
 
 /**
@@ -49,5 +55,24 @@ void no_os_udelay(uint32_t usecs)
  */
 void no_os_mdelay(uint32_t msecs)
 {
+	uint64_t start = no_os_prof_start();
+
 	usleep(msecs * 1000);
+	no_os_prof_record(NO_OS_PROF_DELAY, NO_OS_PROF_SITE, start, 0);
+}
+
+/**
+ * @brief Get current time.
+ * @return Current time structure from system start (seconds, microseconds).
+ */
+struct no_os_time no_os_get_time(void)
+{
+	struct no_os_time t;
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	t.s = ts.tv_sec;
+	t.us = ts.tv_nsec / 1000;
+
+	return t;
 }
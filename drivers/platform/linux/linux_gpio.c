@@ -35,11 +35,15 @@
 #include "no_os_gpio.h"
 #include "no_os_delay.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
+#include "linux_gpio.h"
 
 #include <errno.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
 
@@ -52,6 +56,8 @@ struct linux_gpio_desc {
 	int direction_fd;
 	/** /sys/class/gpio/gpio"number"/value file descriptor */
 	int value_fd;
+	/** value file descriptor polled for edges, -1 if edges are off */
+	int edge_fd;
 };
 
 #define GPIO_TIMEOUT_MS 1000
@@ -83,6 +89,7 @@ int32_t linux_gpio_get(struct no_os_gpio_desc **desc,
 
 	descriptor->extra = linux_desc;
 	descriptor->number = param->number;
+	linux_desc->edge_fd = -1;
 
 	fd = open("/sys/class/gpio/export", O_WRONLY);
 	if (fd < 0) {
@@ -120,7 +127,7 @@ int32_t linux_gpio_get(struct no_os_gpio_desc **desc,
 	sprintf(path, "/sys/class/gpio/gpio%d/value", descriptor->number);
 	timeout = GPIO_TIMEOUT_MS;
 	while (--timeout) {
-		linux_desc->value_fd = open(path, O_WRONLY);
+		linux_desc->value_fd = open(path, O_RDWR);
 		if (linux_desc->value_fd >= 0)
 			break;
 		no_os_mdelay(1);
@@ -173,6 +180,9 @@ int32_t linux_gpio_remove(struct no_os_gpio_desc *desc)
 
 	linux_desc = desc->extra;
 
+	if (linux_desc->edge_fd >= 0)
+		close(linux_desc->edge_fd);
+
 	ret = close(linux_desc->direction_fd);
 	if (ret < 0) {
 		printf("%s: Can't close device\n\r", __func__);
@@ -255,7 +265,7 @@ int32_t linux_gpio_get_value(struct no_os_gpio_desc *desc,
 
 	linux_desc = desc->extra;
 
-	ret = read(linux_desc->value_fd, &data, 1);
+	ret = pread(linux_desc->value_fd, &data, 1, 0);
 	if (ret < 0) {
 		printf("%s: Can't read from file\n\r", __func__);
 		return -1;
@@ -352,6 +362,108 @@ int32_t linux_gpio_get_direction(struct no_os_gpio_desc *desc,
 	return 0;
 }
 
+/**
+ * @brief Enable edge notifications on an input GPIO.
+ *
+ * The edge is latched by the kernel, so an edge that happens before
+ * linux_gpio_edge_wait() is called is not lost.
+ * @param desc - The GPIO descriptor, obtained with linux_gpio_ops.
+ * @param edge - NO_OS_IRQ_EDGE_RISING, NO_OS_IRQ_EDGE_FALLING or
+ *               NO_OS_IRQ_EDGE_BOTH.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_edge_enable(struct no_os_gpio_desc *desc,
+			       enum no_os_irq_trig_level edge)
+{
+	struct linux_gpio_desc *linux_desc;
+	const char *name;
+	char path[64];
+	char data;
+	int fd;
+	int ret;
+
+	if (!desc || desc->platform_ops != &linux_gpio_ops)
+		return -ENOTSUP;
+
+	switch (edge) {
+	case NO_OS_IRQ_EDGE_RISING:
+		name = "rising";
+		break;
+	case NO_OS_IRQ_EDGE_FALLING:
+		name = "falling";
+		break;
+	case NO_OS_IRQ_EDGE_BOTH:
+		name = "both";
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	linux_desc = desc->extra;
+
+	sprintf(path, "/sys/class/gpio/gpio%d/edge", desc->number);
+	fd = open(path, O_WRONLY);
+	if (fd < 0)
+		return -errno;
+
+	ret = write(fd, name, strlen(name) + 1);
+	close(fd);
+	if (ret < 0)
+		return -errno;
+
+	if (linux_desc->edge_fd < 0) {
+		sprintf(path, "/sys/class/gpio/gpio%d/value", desc->number);
+		linux_desc->edge_fd = open(path, O_RDONLY | O_NONBLOCK);
+		if (linux_desc->edge_fd < 0)
+			return -errno;
+	}
+
+	/* Acknowledge the edge reported for the initial state */
+	ret = pread(linux_desc->edge_fd, &data, 1, 0);
+
+	return ret < 0 ? -errno : 0;
+}
+
+/**
+ * @brief Wait for the edge set with linux_gpio_edge_enable().
+ * @param desc - The GPIO descriptor.
+ * @param timeout_us - Timeout in microseconds, rounded up to milliseconds.
+ *                     0 only checks for an edge that already happened.
+ * @return 0 if an edge was seen, -ETIMEDOUT if none happened in time, other
+ *         negative error code otherwise.
+ */
+int32_t linux_gpio_edge_wait(struct no_os_gpio_desc *desc, uint32_t timeout_us)
+{
+	struct linux_gpio_desc *linux_desc;
+	struct pollfd pfd;
+	char data;
+	int ret;
+
+	if (!desc || desc->platform_ops != &linux_gpio_ops)
+		return -ENOTSUP;
+
+	linux_desc = desc->extra;
+	if (linux_desc->edge_fd < 0)
+		return -EINVAL;
+
+	pfd.fd = linux_desc->edge_fd;
+	pfd.events = POLLPRI | POLLERR;
+
+	do {
+		ret = poll(&pfd, 1, NO_OS_DIV_ROUND_UP(timeout_us, 1000));
+	} while (ret < 0 && errno == EINTR);
+	if (ret < 0)
+		return -errno;
+	if (!ret)
+		return -ETIMEDOUT;
+
+	/* Reading the value rearms the notification */
+	if (pread(linux_desc->edge_fd, &data, 1, 0) < 0)
+		return -errno;
+
+	return 0;
+}
+
 /**
  * @brief Linux platform specific GPIO platform ops structure
  */
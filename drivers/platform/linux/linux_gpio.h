@@ -33,9 +33,20 @@
 #ifndef LINUX_GPIO_H_
 #define LINUX_GPIO_H_
 
+#include <stdint.h>
+#include "no_os_gpio.h"
+#include "no_os_irq.h"
+
 /**
  * @brief Linux specific GPIO platform ops structure
  */
 extern const struct no_os_gpio_platform_ops linux_gpio_ops;
 
+/* Enable sysfs edge notifications on an input GPIO */
+int32_t linux_gpio_edge_enable(struct no_os_gpio_desc *desc,
+			       enum no_os_irq_trig_level edge);
+
+/* Wait for an edge enabled with linux_gpio_edge_enable() */
+int32_t linux_gpio_edge_wait(struct no_os_gpio_desc *desc, uint32_t timeout_us);
+
 #endif // LINUX_GPIO_H_
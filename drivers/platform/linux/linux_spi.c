@@ -39,11 +39,15 @@
 #include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/ioctl.h>
 #include <unistd.h>
 #include <linux/spi/spidev.h>
 
-#warning SPI cs_delay_first and cs_delay_last delays are not supported on the linux platform
+#warning SPI cs_delay_first delay is not supported on the linux platform
+
+/* Transfers of up to this many messages are built on the stack */
+#define LINUX_SPI_SMALL_MSGS	4
 
 /**
  * @struct linux_spi_desc
@@ -180,6 +184,7 @@ static int32_t linux_spi_transfer(struct no_os_spi_desc *desc,
 				  uint32_t len)
 
 {
+	struct spi_ioc_transfer tr_small[LINUX_SPI_SMALL_MSGS];
 	struct spi_ioc_transfer *tr;
 	struct linux_spi_desc	*linux_desc;
 	int			ret;
@@ -187,21 +192,32 @@ static int32_t linux_spi_transfer(struct no_os_spi_desc *desc,
 
 	linux_desc = desc->extra;
 
-	tr = (struct spi_ioc_transfer *)no_os_calloc(len, sizeof(*tr));
-	if (!tr)
-		return -ENOMEM;
+	/* Short transfers, like a sample frame, don't need an allocation */
+	if (len <= LINUX_SPI_SMALL_MSGS) {
+		tr = tr_small;
+		memset(tr, 0, len * sizeof(*tr));
+	} else {
+		tr = (struct spi_ioc_transfer *)no_os_calloc(len, sizeof(*tr));
+		if (!tr)
+			return -ENOMEM;
+	}
 
 	for (i = 0; i < len; i++) {
 		tr[i].tx_buf = (unsigned long) msgs[i].tx_buff;
 		tr[i].rx_buf = (unsigned long) msgs[i].rx_buff;
 		tr[i].len = msgs[i].bytes_number;
-		tr[i].cs_change = msgs[i].cs_change;
-		tr[i].word_delay_usecs = msgs[i].cs_change_delay;
+		/*
+		 * For spidev, cs_change on the last transfer keeps CS asserted
+		 * after the message, the opposite of its no-OS meaning.
+		 */
+		tr[i].cs_change = msgs[i].cs_change && i != len - 1;
+		tr[i].delay_usecs = msgs[i].cs_delay_last + msgs[i].cs_change_delay;
 	}
 
 	ret = ioctl(linux_desc->spidev_fd, SPI_IOC_MESSAGE(len), tr);
 
-	no_os_free(tr);
+	if (tr != tr_small)
+		no_os_free(tr);
 
 	if (ret < 0) {
 		printf("%s: Can't send spi message (%d)\n\r", __func__, errno);
@@ -0,0 +1,111 @@
+/***************************************************************************//**
+ *   @file   linux_thread.c
+ *   @brief  Implementation of no-OS threads through pthreads.
+ *   @author Analog Devices Inc.
+********************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include "no_os_thread.h"
+
+/**
+ * @struct linux_thread
+ * @brief Linux thread handle.
+ */
+struct linux_thread {
+	/** pthread handle */
+	pthread_t tid;
+	/** Thread function */
+	void (*func)(void *arg);
+	/** Argument passed to the thread function */
+	void *arg;
+};
+
+static void *linux_thread_run(void *arg)
+{
+	struct linux_thread *t = arg;
+
+	t->func(t->arg);
+
+	return NULL;
+}
+
+/**
+ * @brief Start a thread.
+ * @param thread - Location where the thread handle will be stored.
+ * @param func - Thread function.
+ * @param arg - Argument passed to the thread function.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_thread_create(void **thread, void (*func)(void *arg), void *arg)
+{
+	struct linux_thread *t;
+	int ret;
+
+	if (!thread || !func)
+		return -EINVAL;
+
+	t = calloc(1, sizeof(*t));
+	if (!t)
+		return -ENOMEM;
+
+	t->func = func;
+	t->arg = arg;
+
+	ret = pthread_create(&t->tid, NULL, linux_thread_run, t);
+	if (ret) {
+		free(t);
+		return -ret;
+	}
+
+	*thread = t;
+
+	return 0;
+}
+
+/**
+ * @brief Wait for a thread to end and release it.
+ * @param thread - Thread handle.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_thread_join(void *thread)
+{
+	struct linux_thread *t = thread;
+	int ret;
+
+	if (!t)
+		return -EINVAL;
+
+	ret = pthread_join(t->tid, NULL);
+	free(t);
+
+	return -ret;
+}
@@ -53,7 +53,11 @@
 #ifdef XUARTPS_H
 /**
  * @brief Save received data into fifo.
- * @param desc - Instance descriptor containing a fifo element.
+ *
+ * Data is copied into the preallocated receive ring, bytes that do not fit are
+ * accounted in the fifo overflow counters.
+ *
+ * @param desc - Instance descriptor containing the receive fifo.
  * @return 0 in case of success, -1 otherwise.
  */
 static int32_t uart_fifo_insert(struct no_os_uart_desc *desc)
@@ -66,10 +70,9 @@ static int32_t uart_fifo_insert(struct no_os_uart_desc *desc)
 		ret = no_os_irq_disable(irq_desc, xil_uart_desc->irq_id);
 		if (ret < 0)
 			return ret;
-		ret = no_os_fifo_insert(&xil_uart_desc->fifo, xil_uart_desc->buff,
-					xil_uart_desc->bytes_received);
-		if (ret < 0)
-			return ret;
+		no_os_fifo_ring_write(&xil_uart_desc->fifo,
+				      (uint8_t *)xil_uart_desc->buff,
+				      xil_uart_desc->bytes_received);
 		xil_uart_desc->bytes_received = 0;
 		switch (xil_uart_desc->type) {
 		case UART_PS:
@@ -93,50 +96,21 @@ static int32_t uart_fifo_insert(struct no_os_uart_desc *desc)
 #endif // XUARTPS_H
 
 /**
- * @brief Read byte from fifo.
- * @param desc - Instance descriptor containing a fifo element
+ * @brief Read byte from the UART Lite receive FIFO.
+ * @param desc - Instance descriptor.
  * @param data - read value.
  * @return 0 in case of success, -1 otherwise.
  */
 static int32_t xil_uart_read_byte(struct no_os_uart_desc *desc, uint8_t *data)
 {
-	struct xil_uart_desc *xil_uart_desc = desc->extra;
 #ifdef XUARTLITE_H
+	struct xil_uart_desc *xil_uart_desc = desc->extra;
 	XUartLite *instance = xil_uart_desc->instance;
-#endif
-#ifdef XUARTPS_H
-	int32_t ret;
-#endif
 
-	switch (xil_uart_desc->type) {
-	case UART_PS:
-#ifdef XUARTPS_H
-		while (xil_uart_desc->fifo == NULL) {
-			/* nothing in fifo, wait until something is received */
-			ret = uart_fifo_insert(desc);
-			if (ret < 0)
-				return ret;
-		}
-
-		*data = xil_uart_desc->fifo->data[xil_uart_desc->fifo_read_offset];
-		xil_uart_desc->fifo_read_offset++;
-
-		if (xil_uart_desc->fifo->len - xil_uart_desc->fifo_read_offset <= 0) {
-			xil_uart_desc->fifo_read_offset = 0;
-			xil_uart_desc->fifo = no_os_fifo_remove(xil_uart_desc->fifo);
-		}
-#endif // XUARTPS_H
-		break;
-	case UART_PL:
-#ifdef XUARTLITE_H
-		while (!(Xil_In32(instance->RegBaseAddress + XUL_STATUS_REG_OFFSET) &
-			 XUL_SR_RX_FIFO_VALID_DATA));
-		*data = Xil_In32(instance->RegBaseAddress + XUL_RX_FIFO_OFFSET);
+	while (!(Xil_In32(instance->RegBaseAddress + XUL_STATUS_REG_OFFSET) &
+		 XUL_SR_RX_FIFO_VALID_DATA));
+	*data = Xil_In32(instance->RegBaseAddress + XUL_RX_FIFO_OFFSET);
 #endif // XUARTLITE_H
-		break;
-	default:
-		break;
-	}
 
 	return 0;
 }
@@ -151,11 +125,35 @@ static int32_t xil_uart_read_byte(struct no_os_uart_desc *desc, uint8_t *data)
 static int32_t xil_uart_read(struct no_os_uart_desc *desc, uint8_t *data,
 			     uint32_t bytes_number)
 {
+	struct xil_uart_desc *xil_uart_desc = desc->extra;
+	uint32_t i = 0;
 	int ret;
-	for (uint32_t i = 0; i < bytes_number; i++) {
-		ret = xil_uart_read_byte(desc, &data[i]);
-		if (ret < 0)
-			return ret;
+
+	switch (xil_uart_desc->type) {
+	case UART_PS:
+#ifdef XUARTPS_H
+		while (i < bytes_number) {
+			i += no_os_fifo_ring_read(&xil_uart_desc->fifo, &data[i],
+						  bytes_number - i);
+			if (i == bytes_number)
+				break;
+
+			/* Not enough data in fifo, wait until something is received */
+			ret = uart_fifo_insert(desc);
+			if (ret < 0)
+				return ret;
+		}
+#endif // XUARTPS_H
+		break;
+	case UART_PL:
+		for (i = 0; i < bytes_number; i++) {
+			ret = xil_uart_read_byte(desc, &data[i]);
+			if (ret < 0)
+				return ret;
+		}
+		break;
+	default:
+		return -1;
 	}
 
 	return bytes_number;
@@ -417,6 +415,12 @@ static int32_t xil_uart_init(struct no_os_uart_desc **desc,
 		 */
 		XUartPs_SetRecvTimeout(xil_uart_desc->instance, 8);
 
+		status = no_os_fifo_ring_cfg(&xil_uart_desc->fifo,
+					     xil_uart_desc->fifo_buff,
+					     UART_FIFO_LENGTH);
+		if (status)
+			goto error_free_instance;
+
 		status = uart_irq_init(descriptor);
 		if (status != XST_SUCCESS)
 			goto error_free_instance;
@@ -34,8 +34,10 @@
 #ifndef XILINX_UART_H_
 #define XILINX_UART_H_
 
+#include "no_os_fifo.h"
 
 #define UART_BUFF_LENGTH 256
+#define UART_FIFO_LENGTH 1024
 
 /**
  * @enum xil_uart_type
@@ -73,10 +75,10 @@ struct xil_uart_desc {
 	uint32_t			irq_id;
 	/** Interrupt Request Descriptor */
 	struct no_os_irq_ctrl_desc *irq_desc;
-	/** FIFO */
-	struct no_os_fifo_element	*fifo;
-	/** FIFO read offset */
-	uint32_t 			fifo_read_offset;
+	/** Receive FIFO */
+	struct no_os_fifo		fifo;
+	/** Receive FIFO storage */
+	uint8_t				fifo_buff[UART_FIFO_LENGTH];
 	/** UART Buffer */
 	char 				buff[UART_BUFF_LENGTH];
 	/** Number of bytes received */
@@ -2221,3 +2221,384 @@ int32_t ad9361_get_temperature(struct ad9361_rf_phy *phy,
 
 	return 0;
 }
+
+/**
+ * Characterize a list of LO frequencies into fastlock profiles.
+ * Each frequency is tuned once (running the full synthesizer calibration)
+ * and the resulting profile words are kept in RAM, so that the schedule
+ * can later be hopped without any further calibration. The LO frequency
+ * set before the call is restored at the end.
+ * @param phy The AD9361 state structure.
+ * @param tx The synthesizer (0 - RX, 1 - TX).
+ * @param freq_hz The LO frequencies (Hz).
+ * @param num_freqs Number of frequencies.
+ * @param table The allocated hop table.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_hop_table_compile(struct ad9361_rf_phy *phy, bool tx,
+				 const uint64_t *freq_hz, uint32_t num_freqs,
+				 struct ad9361_hop_table **table)
+{
+	struct ad9361_hop_table *tbl;
+	uint64_t lo_freq_hz;
+	uint32_t i;
+	int32_t ret;
+
+	if (!phy || !freq_hz || !num_freqs || !table)
+		return -EINVAL;
+
+	tbl = (struct ad9361_hop_table *)no_os_calloc(1, sizeof(*tbl));
+	if (!tbl)
+		return -ENOMEM;
+
+	tbl->freq_hz = no_os_calloc(num_freqs, sizeof(*tbl->freq_hz));
+	tbl->profile = no_os_calloc(num_freqs, sizeof(*tbl->profile));
+	if (!tbl->freq_hz || !tbl->profile) {
+		ret = -ENOMEM;
+		goto error;
+	}
+
+	tbl->tx = tx;
+	tbl->num_freqs = num_freqs;
+	for (i = 0; i < AD9361_HOP_SLOTS; i++)
+		tbl->slot[i] = -1;
+
+	if (tx)
+		ret = ad9361_get_tx_lo_freq(phy, &lo_freq_hz);
+	else
+		ret = ad9361_get_rx_lo_freq(phy, &lo_freq_hz);
+	if (ret < 0)
+		goto error;
+
+	for (i = 0; i < num_freqs; i++) {
+		if (tx)
+			ret = ad9361_set_tx_lo_freq(phy, freq_hz[i]);
+		else
+			ret = ad9361_set_rx_lo_freq(phy, freq_hz[i]);
+		if (ret < 0)
+			goto error;
+
+		ret = ad9361_fastlock_capture(phy, tx, tbl->profile[i]);
+		if (ret < 0)
+			goto error;
+
+		tbl->freq_hz[i] = freq_hz[i];
+	}
+
+	if (tx)
+		ret = ad9361_set_tx_lo_freq(phy, lo_freq_hz);
+	else
+		ret = ad9361_set_rx_lo_freq(phy, lo_freq_hz);
+	if (ret < 0)
+		goto error;
+
+	*table = tbl;
+
+	return 0;
+
+error:
+	ad9361_hop_table_remove(tbl);
+
+	return ret;
+}
+
+/**
+ * Free a hop table.
+ * @param table The hop table.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_hop_table_remove(struct ad9361_hop_table *table)
+{
+	if (!table)
+		return -EINVAL;
+
+	no_os_free(table->profile);
+	no_os_free(table->freq_hz);
+	no_os_free(table);
+
+	return 0;
+}
+
+/**
+ * Get the current time in microseconds.
+ * @return The time (us).
+ */
+static uint64_t ad9361_hop_time_us(void)
+{
+	struct no_os_time t = no_os_get_time();
+
+	return (uint64_t)t.s * 1000000 + t.us;
+}
+
+/**
+ * Load a hop table entry into a fastlock slot, unless the slot already
+ * holds it.
+ * @param phy The AD9361 state structure.
+ * @param table The hop table.
+ * @param slot The fastlock profile slot (0 - 7).
+ * @param index The hop table index.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ad9361_hop_load(struct ad9361_rf_phy *phy,
+			       struct ad9361_hop_table *table,
+			       uint32_t slot, uint32_t index)
+{
+	int32_t ret;
+
+	if (table->slot[slot] == (int32_t)index)
+		return 0;
+
+	table->slot[slot] = -1;
+	ret = ad9361_fastlock_load(phy, table->tx, slot, table->profile[index]);
+	if (ret < 0)
+		return ret;
+
+	table->slot[slot] = index;
+	table->stats.reloads++;
+
+	return 0;
+}
+
+/**
+ * Give every table index of a schedule its own fastlock slot, if the
+ * schedule uses at most AD9361_HOP_SLOTS of them. An index already held
+ * by a slot keeps that slot.
+ * @param table The hop table.
+ * @param schedule The hop table indexes, in hop order.
+ * @param num_hops Number of hops.
+ * @param assign Table index assigned to each slot, -1 if unused.
+ * @return true if the schedule fits in the slots, false otherwise.
+ */
+static bool ad9361_hop_assign(struct ad9361_hop_table *table,
+			      const uint32_t *schedule, uint32_t num_hops,
+			      int32_t *assign)
+{
+	int32_t idx[AD9361_HOP_SLOTS];
+	uint32_t i, j, s, n = 0;
+
+	for (i = 0; i < num_hops; i++) {
+		for (j = 0; j < n; j++)
+			if (idx[j] == (int32_t)schedule[i])
+				break;
+		if (j < n)
+			continue;
+		if (n == AD9361_HOP_SLOTS)
+			return false;
+		idx[n++] = schedule[i];
+	}
+
+	for (s = 0; s < AD9361_HOP_SLOTS; s++) {
+		assign[s] = -1;
+		for (j = 0; j < n; j++) {
+			if (table->slot[s] == idx[j]) {
+				assign[s] = idx[j];
+				idx[j] = -1;
+				break;
+			}
+		}
+	}
+
+	for (j = 0, s = 0; j < n; j++) {
+		if (idx[j] < 0)
+			continue;
+		while (assign[s] >= 0)
+			s++;
+		assign[s] = idx[j];
+	}
+
+	return true;
+}
+
+/**
+ * Switch the synthesizer to a fastlock slot.
+ * @param phy The AD9361 state structure.
+ * @param table The hop table.
+ * @param slot The fastlock profile slot (0 - 7).
+ * @param first Whether this is the first hop of the schedule.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ad9361_hop_select(struct ad9361_rf_phy *phy,
+				 struct ad9361_hop_table *table,
+				 uint32_t slot, bool first)
+{
+	uint32_t i;
+	int32_t ret;
+
+	if (table->mode == AD9361_HOP_SPI)
+		return ad9361_fastlock_recall(phy, table->tx, slot);
+
+	for (i = 0; i < AD9361_HOP_PINS; i++) {
+		ret = no_os_gpio_set_value(table->pin[i], (slot >> i) & 1);
+		if (ret)
+			return ret;
+	}
+
+	/* Fastlock pin select mode is entered once, then the pins hop */
+	if (first)
+		return ad9361_fastlock_recall(phy, table->tx, slot);
+
+	phy->fastlock.current_profile[table->tx] = slot + 1;
+
+	return 0;
+}
+
+/**
+ * Wait for the synthesizer to lock after a hop.
+ * @param phy The AD9361 state structure.
+ * @param table The hop table.
+ * @param settle_us The time until lock was detected (us).
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ad9361_hop_settle(struct ad9361_rf_phy *phy,
+				 struct ad9361_hop_table *table,
+				 uint32_t *settle_us)
+{
+	uint32_t reg = table->tx ? REG_TX_CP_OVERRANGE_VCO_LOCK :
+		       REG_RX_CP_OVERRANGE_VCO_LOCK;
+	uint64_t start, now;
+
+	start = ad9361_hop_time_us();
+	do {
+		now = ad9361_hop_time_us();
+		if (ad9361_spi_read(phy->spi, reg) & VCO_LOCK) {
+			*settle_us = now - start;
+			return 0;
+		}
+	} while (now - start < AD9361_HOP_LOCK_TIMEOUT_US);
+
+	return -ETIMEDOUT;
+}
+
+/**
+ * Hop through a schedule of hop table indexes.
+ * A schedule using up to eight table indexes gives each of them its own
+ * fastlock slot, so the slots are loaded once, before the first hop.
+ * Longer schedules use the eight slots as two banks of four: while the
+ * schedule hops through one bank, the profiles of the next four hops are
+ * loaded into the other one. Profiles already present in a slot are not
+ * reloaded. The table assumes exclusive use of the
+ * fastlock slots of its synthesizer; set its slot[] entries to -1 after
+ * using the fastlock store/load functions directly.
+ * The gain table is not reloaded while hopping, keep the RX frequencies
+ * of a table within one gain table band.
+ * @param phy The AD9361 state structure.
+ * @param table The hop table.
+ * @param schedule The hop table indexes, in hop order.
+ * @param num_hops Number of hops.
+ * @param rate_hz The target hop rate (Hz), 0 to hop as fast as possible.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_hop_run(struct ad9361_rf_phy *phy,
+		       struct ad9361_hop_table *table,
+		       const uint32_t *schedule, uint32_t num_hops,
+		       uint32_t rate_hz)
+{
+	struct ad9361_hop_stats *stats;
+	uint64_t start, deadline, now, settle_sum = 0;
+	uint32_t period_us, settle_us, settled = 0;
+	int32_t assign[AD9361_HOP_SLOTS];
+	uint32_t i, j, h, slot;
+	bool pinctrl_en, fixed;
+	int32_t ret;
+
+	if (!phy || !table || !schedule || !num_hops)
+		return -EINVAL;
+
+	for (i = 0; i < num_hops; i++)
+		if (schedule[i] >= table->num_freqs)
+			return -EINVAL;
+
+	if (table->mode == AD9361_HOP_PIN)
+		for (i = 0; i < AD9361_HOP_PINS; i++)
+			if (!table->pin[i])
+				return -EINVAL;
+
+	stats = &table->stats;
+	memset(stats, 0, sizeof(*stats));
+	period_us = rate_hz ? 1000000 / rate_hz : 0;
+
+	fixed = ad9361_hop_assign(table, schedule, num_hops, assign);
+	if (fixed) {
+		for (i = 0; i < AD9361_HOP_SLOTS; i++) {
+			if (assign[i] < 0)
+				continue;
+			ret = ad9361_hop_load(phy, table, i, assign[i]);
+			if (ret < 0)
+				return ret;
+		}
+	} else {
+		/* Prime both banks */
+		for (i = 0; i < AD9361_HOP_SLOTS; i++) {
+			ret = ad9361_hop_load(phy, table, i, schedule[i]);
+			if (ret < 0)
+				return ret;
+		}
+	}
+
+	pinctrl_en = phy->pdata->trx_fastlock_pinctrl_en[table->tx];
+	phy->pdata->trx_fastlock_pinctrl_en[table->tx] =
+		(table->mode == AD9361_HOP_PIN);
+
+	start = ad9361_hop_time_us();
+	for (i = 0; i < num_hops; i++) {
+		if (fixed) {
+			for (slot = 0; slot < AD9361_HOP_SLOTS; slot++)
+				if (assign[slot] == (int32_t)schedule[i])
+					break;
+		} else {
+			slot = i % AD9361_HOP_SLOTS;
+		}
+		deadline = start + (uint64_t)i * period_us;
+		do {
+			now = ad9361_hop_time_us();
+		} while (now < deadline);
+		if (period_us && (now - deadline > period_us))
+			stats->late++;
+
+		ret = ad9361_hop_select(phy, table, slot, i == 0);
+		if (ret < 0)
+			goto out;
+		stats->hops++;
+
+		if (table->measure_settle) {
+			if (ad9361_hop_settle(phy, table, &settle_us) < 0) {
+				stats->lock_fail++;
+			} else {
+				if (!settled || settle_us < stats->settle_min_us)
+					stats->settle_min_us = settle_us;
+				if (settle_us > stats->settle_max_us)
+					stats->settle_max_us = settle_us;
+				settle_sum += settle_us;
+				settled++;
+			}
+		}
+
+		/* Entering a bank frees the other one for the hops after it */
+		if (fixed || slot % AD9361_HOP_BANK)
+			continue;
+
+		for (j = 0; j < AD9361_HOP_BANK; j++) {
+			h = i + AD9361_HOP_BANK + j;
+			if (h >= num_hops)
+				break;
+			ret = ad9361_hop_load(phy, table, h % AD9361_HOP_SLOTS,
+					      schedule[h]);
+			if (ret < 0)
+				goto out;
+		}
+	}
+
+	ret = 0;
+
+out:
+	stats->elapsed_us = ad9361_hop_time_us() - start;
+	if (stats->elapsed_us)
+		stats->rate_hz = no_os_div_u64((uint64_t)stats->hops * 1000000,
+					       stats->elapsed_us);
+	if (settled)
+		stats->settle_avg_us = no_os_div_u64(settle_sum, settled);
+
+	phy->pdata->trx_fastlock_pinctrl_en[table->tx] = pinctrl_en;
+
+	return ret;
+}
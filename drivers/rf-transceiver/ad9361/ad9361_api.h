@@ -316,6 +316,48 @@ enum ad9361_ensm_mode {
 	ENSM_MODE_PINCTRL_FDD_INDEP,
 };
 
+#define AD9361_HOP_SLOTS	8
+#define AD9361_HOP_BANK		(AD9361_HOP_SLOTS / 2)
+#define AD9361_HOP_PINS		3
+#define AD9361_HOP_LOCK_TIMEOUT_US	1000
+
+enum ad9361_hop_mode {
+	AD9361_HOP_SPI,		/* profile recalled over SPI */
+	AD9361_HOP_PIN,		/* profile selected with the CTRL_IN pins */
+};
+
+struct ad9361_hop_stats {
+	uint32_t	hops;
+	/* Profiles written into the hardware slots during the run */
+	uint32_t	reloads;
+	/* Hops issued more than one period after their deadline */
+	uint32_t	late;
+	uint32_t	elapsed_us;
+	/* Achieved hop rate */
+	uint32_t	rate_hz;
+	/* VCO lock time after a hop, only if settle measurement is on */
+	uint32_t	settle_min_us;
+	uint32_t	settle_max_us;
+	uint32_t	settle_avg_us;
+	uint32_t	lock_fail;
+};
+
+struct ad9361_hop_table {
+	bool		tx;
+	uint32_t	num_freqs;
+	uint64_t	*freq_hz;
+	/* Characterized fastlock profiles, one per frequency */
+	uint8_t		(*profile)[RX_FAST_LOCK_CONFIG_WORD_NUM];
+	/* Table index held by each hardware slot, -1 if unknown */
+	int32_t		slot[AD9361_HOP_SLOTS];
+	enum ad9361_hop_mode	mode;
+	/* CTRL_IN profile select GPIOs (LSB first), used in AD9361_HOP_PIN */
+	struct no_os_gpio_desc	*pin[AD9361_HOP_PINS];
+	/* Poll the VCO lock bit after every hop */
+	bool		measure_settle;
+	struct ad9361_hop_stats	stats;
+};
+
 #define ENABLE		1
 #define DISABLE		0
 
@@ -537,4 +579,15 @@ int32_t ad9361_do_dcxo_tune_fine(struct ad9361_rf_phy *phy,
 /* Get the temperature. */
 int32_t ad9361_get_temperature(struct ad9361_rf_phy *phy,
 			       int32_t *temp);
+/* Characterize a list of LO frequencies into fastlock profiles. */
+int32_t ad9361_hop_table_compile(struct ad9361_rf_phy *phy, bool tx,
+				 const uint64_t *freq_hz, uint32_t num_freqs,
+				 struct ad9361_hop_table **table);
+/* Free a hop table. */
+int32_t ad9361_hop_table_remove(struct ad9361_hop_table *table);
+/* Hop through a schedule of hop table indexes. */
+int32_t ad9361_hop_run(struct ad9361_rf_phy *phy,
+		       struct ad9361_hop_table *table,
+		       const uint32_t *schedule, uint32_t num_hops,
+		       uint32_t rate_hz);
 #endif
@@ -2351,8 +2351,19 @@ error:
 
 static int adrv9002_profile_load(struct adrv9002_rf_phy *phy)
 {
+	/* Generated by tools/scripts/adrv9001_profile_gen.py, no parsing needed */
+	if (phy->profile_init) {
+		memcpy(&phy->profile, phy->profile_init, sizeof(phy->profile));
+		return 0;
+	}
+
+#ifdef ADI_DYNAMIC_PROFILE_LOAD
 	return adi_adrv9001_profileutil_Parse(phy->adrv9001, &phy->profile,
 					      (char *)phy->profile_json, phy->profile_length);
+#else
+	pr_err("No precompiled profile and JSON profile support not built\n");
+	return -EINVAL;
+#endif
 }
 
 static int adrv9002_init_cals_coeffs_name_get(struct adrv9002_rf_phy *phy)
@@ -2482,6 +2493,7 @@ int32_t adrv9002_dev_init(struct adrv9002_rf_phy *device,
 
 	device->profile_json = init_param->profile;
 	device->profile_length = init_param->profile_length;
+	device->profile_init = init_param->profile_init;
 
 	return 0;
 }
@@ -323,6 +323,7 @@ struct adrv9002_rf_phy {
 	struct axi_dmac			*tx2_dmac;
 	char 					*profile_json;
 	size_t	 				profile_length;
+	const struct adi_adrv9001_Init		*profile_init;
 };
 
 struct adrv9002_init_param {
@@ -332,6 +333,8 @@ struct adrv9002_init_param {
 	struct adi_adrv9001_GainControlCfg *agcConfig_init_param;
 	char 						*profile;
 	size_t	 					profile_length;
+	/* Precompiled profile, used instead of the JSON one when set */
+	const struct adi_adrv9001_Init			*profile_init;
 };
 
 /* Initialize the device. */
@@ -0,0 +1,434 @@
+/***************************************************************************//**
+ *   @file   adrv9002_fh.c
+ *   @brief  ADRV9002 frequency hopping table manager.
+ *   @author Analog Devices Inc.
+********************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+#include "no_os_alloc.h"
+#include "no_os_delay.h"
+#include "no_os_util.h"
+#include "adrv9002_fh.h"
+#include "adi_adrv9001_arm.h"
+#include "adi_adrv9001_fh.h"
+#include "adi_adrv9001_rx_types.h"
+#include "adi_adrv9001_spi.h"
+#include "adrv9001_reg_addr_macros.h"
+
+/**
+ * @brief Fill hop frames from frequency and gain sequences.
+ * @param seq - Hop sequence.
+ * @param frames - Hop frames, seq->num_hops entries.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int adrv9002_fh_seq_build(const struct adrv9002_fh_seq *seq,
+			  adi_adrv9001_FhHopFrame_t *frames)
+{
+	uint32_t i;
+
+	if (!seq || !seq->freq_hz || !frames)
+		return -EINVAL;
+
+	for (i = 0; i < seq->num_hops; i++) {
+		if (seq->freq_hz[i] < ADI_ADRV9001_FH_MIN_CARRIER_FREQUENCY_HZ ||
+		    seq->freq_hz[i] > ADI_ADRV9001_FH_MAX_CARRIER_FREQUENCY_HZ)
+			return -EINVAL;
+
+		frames[i].hopFrequencyHz = seq->freq_hz[i];
+		frames[i].rx1OffsetFrequencyHz =
+			seq->rx_offset_hz ? seq->rx_offset_hz[i] : 0;
+		frames[i].rx2OffsetFrequencyHz = frames[i].rx1OffsetFrequencyHz;
+		frames[i].rx1GainIndex = seq->rx_gain ? seq->rx_gain[i] :
+					 ADI_ADRV9001_RX_GAIN_INDEX_MAX;
+		frames[i].rx2GainIndex = frames[i].rx1GainIndex;
+		frames[i].tx1Attenuation_fifthdB =
+			seq->tx_atten ? seq->tx_atten[i] : 0;
+		frames[i].tx2Attenuation_fifthdB = frames[i].tx1Attenuation_fifthdB;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Pack hop frames into a hop table image.
+ *
+ * The image holds the frames in the ARM firmware layout, as in
+ * adi_adrv9001_fh_HopTable_Static_Configure(), and is written as is to the
+ * hop table buffer.
+ * @param frames - Hop frames.
+ * @param num_hops - Number of frames, up to ADRV9002_FH_TABLE_HOPS_MAX.
+ * @param image - Output buffer, ADRV9002_FH_IMAGE_SIZE(num_hops) bytes.
+ * @param len - Image length.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int adrv9002_fh_table_pack(const adi_adrv9001_FhHopFrame_t *frames,
+			   uint32_t num_hops, uint8_t *image, uint32_t *len)
+{
+	uint8_t *frame;
+	uint32_t i;
+
+	if (!frames || !num_hops || num_hops > ADRV9002_FH_TABLE_HOPS_MAX ||
+	    !image || !len)
+		return -EINVAL;
+
+	for (i = 0; i < num_hops; i++) {
+		frame = &image[i * ADRV9002_FH_FRAME_BYTES];
+		no_os_put_unaligned_le32((uint32_t)frames[i].hopFrequencyHz,
+					 &frame[0]);
+		no_os_put_unaligned_le32((uint32_t)(frames[i].hopFrequencyHz >> 32),
+					 &frame[4]);
+		no_os_put_unaligned_le32(frames[i].rx1OffsetFrequencyHz, &frame[8]);
+		no_os_put_unaligned_le32(frames[i].rx2OffsetFrequencyHz, &frame[12]);
+		frame[16] = frames[i].rx1GainIndex;
+		frame[17] = frames[i].rx2GainIndex;
+		frame[18] = frames[i].tx1Attenuation_fifthdB;
+		frame[19] = frames[i].tx2Attenuation_fifthdB;
+	}
+
+	*len = ADRV9002_FH_IMAGE_SIZE(num_hops);
+
+	return 0;
+}
+
+/**
+ * @brief Write a hop table image to hop table A or B.
+ *
+ * The entry count and the frames are written with streaming ARM memory
+ * writes, then the table load software interrupt is raised.
+ * @param adrv9001 - ADRV9001 device, holds the ARM hop table addresses.
+ * @param hop_signal - Hop signal the table belongs to.
+ * @param table - Hop table A or B.
+ * @param image - Image built by adrv9002_fh_table_pack().
+ * @param len - Image length.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int adrv9002_fh_table_write(adi_adrv9001_Device_t *adrv9001,
+			    adi_adrv9001_FhHopSignal_e hop_signal,
+			    adi_adrv9001_FhHopTable_e table,
+			    const uint8_t *image, uint32_t len)
+{
+	adi_adrv9001_Info_t *info;
+	uint32_t table_addr, buf_addr;
+	uint8_t count[4];
+	uint8_t sw_int;
+	int ret;
+
+	if (!adrv9001 || !image || !len || len % ADRV9002_FH_FRAME_BYTES ||
+	    len > ADRV9002_FH_IMAGE_SIZE(ADRV9002_FH_TABLE_HOPS_MAX))
+		return -EINVAL;
+
+	info = &adrv9001->devStateInfo;
+	if (hop_signal == ADI_ADRV9001_FH_HOP_SIGNAL_1) {
+		if (table == ADI_ADRV9001_FHHOPTABLE_A) {
+			table_addr = info->fhHopTableA1Addr;
+			buf_addr = info->fhHopTableBufferA1Addr;
+			sw_int = 0x1;
+		} else {
+			table_addr = info->fhHopTableB1Addr;
+			buf_addr = info->fhHopTableBufferB1Addr;
+			sw_int = 0x2;
+		}
+	} else {
+		if (table == ADI_ADRV9001_FHHOPTABLE_A) {
+			table_addr = info->fhHopTableA2Addr;
+			buf_addr = info->fhHopTableBufferA2Addr;
+			sw_int = 0x80;
+		} else {
+			table_addr = info->fhHopTableB2Addr;
+			buf_addr = info->fhHopTableBufferB2Addr;
+			sw_int = 0x40;
+		}
+	}
+
+	no_os_put_unaligned_le32(len / ADRV9002_FH_FRAME_BYTES, count);
+	ret = adi_adrv9001_arm_Memory_Write(adrv9001, table_addr, count,
+					    sizeof(count),
+					    ADI_ADRV9001_ARM_SINGLE_SPI_WRITE_MODE_STREAMING_BYTES_4);
+	if (ret)
+		return -EIO;
+
+	ret = adi_adrv9001_arm_Memory_Write(adrv9001, buf_addr, image, len,
+					    ADI_ADRV9001_ARM_SINGLE_SPI_WRITE_MODE_STREAMING_BYTES_4);
+	if (ret)
+		return -EIO;
+
+	/* Self clearing, no need to read/modify/write */
+	ret = adi_adrv9001_spi_Byte_Write(adrv9001, ADRV9001_ADDR_SW_INTERRUPT_4,
+					  sw_int);
+	if (ret)
+		return -EIO;
+
+	return 0;
+}
+
+/**
+ * @brief Number of hops in a sequence chunk.
+ * @param mgr - Hop table manager.
+ * @param chunk - Sequence chunk.
+ * @return The number of hops.
+ */
+static uint32_t adrv9002_fh_chunk_hops(struct adrv9002_fh_mgr *mgr,
+				       uint32_t chunk)
+{
+	return no_os_min(mgr->table_hops, mgr->num_hops - chunk * mgr->table_hops);
+}
+
+/**
+ * @brief Upload a sequence chunk into hop table A or B.
+ * @param mgr - Hop table manager.
+ * @param table - Hop table A or B.
+ * @param chunk - Sequence chunk.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int adrv9002_fh_mgr_load(struct adrv9002_fh_mgr *mgr,
+				adi_adrv9001_FhHopTable_e table,
+				uint32_t chunk)
+{
+	struct adrv9002_fh_stats *stats = &mgr->stats;
+	struct no_os_time start, end;
+	uint32_t us;
+	int ret;
+
+	mgr->chunk[table] = -1;
+	start = no_os_get_time();
+	ret = adrv9002_fh_table_write(mgr->adrv9001, mgr->hop_signal, table,
+				      mgr->image[chunk], mgr->image_len[chunk]);
+	if (ret)
+		return ret;
+	end = no_os_get_time();
+	mgr->chunk[table] = chunk;
+
+	us = (end.s - start.s) * 1000000 + end.us - start.us;
+
+	stats->tables_loaded++;
+	stats->frames_loaded += adrv9002_fh_chunk_hops(mgr, chunk);
+	stats->bytes += mgr->image_len[chunk];
+	stats->upload_us += us;
+	if (stats->upload_us)
+		stats->frames_per_sec = no_os_div_u64((uint64_t)stats->frames_loaded *
+						      1000000, stats->upload_us);
+
+	return 0;
+}
+
+/**
+ * @brief Initialize the hop table manager.
+ *
+ * The sequence is split in tables of init->table_hops frames, which are all
+ * packed up front. The first two are loaded into hop tables A and B and
+ * table A is selected. The hop table select mode of the profile must allow
+ * selecting the table over SPI.
+ * @param mgr - Hop table manager.
+ * @param init - Initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int adrv9002_fh_mgr_init(struct adrv9002_fh_mgr **mgr,
+			 const struct adrv9002_fh_mgr_init *init)
+{
+	struct adrv9002_fh_mgr *m;
+	uint32_t i, hops;
+	int ret;
+
+	if (!mgr || !init || !init->adrv9001 || !init->frames ||
+	    !init->num_hops || !init->table_hops ||
+	    init->table_hops > ADRV9002_FH_TABLE_HOPS_MAX)
+		return -EINVAL;
+
+	m = no_os_calloc(1, sizeof(*m));
+	if (!m)
+		return -ENOMEM;
+
+	m->adrv9001 = init->adrv9001;
+	m->hop_signal = init->hop_signal;
+	m->num_hops = init->num_hops;
+	m->table_hops = init->table_hops;
+	m->num_chunks = NO_OS_DIV_ROUND_UP(init->num_hops, init->table_hops);
+	m->chunk[ADI_ADRV9001_FHHOPTABLE_A] = -1;
+	m->chunk[ADI_ADRV9001_FHHOPTABLE_B] = -1;
+
+	m->image = no_os_calloc(m->num_chunks, sizeof(*m->image));
+	m->image_len = no_os_calloc(m->num_chunks, sizeof(*m->image_len));
+	if (!m->image || !m->image_len) {
+		ret = -ENOMEM;
+		goto error;
+	}
+
+	for (i = 0; i < m->num_chunks; i++) {
+		hops = adrv9002_fh_chunk_hops(m, i);
+		m->image[i] = no_os_malloc(ADRV9002_FH_IMAGE_SIZE(hops));
+		if (!m->image[i]) {
+			ret = -ENOMEM;
+			goto error;
+		}
+
+		ret = adrv9002_fh_table_pack(&init->frames[i * m->table_hops],
+					     hops, m->image[i], &m->image_len[i]);
+		if (ret)
+			goto error;
+	}
+
+	ret = adrv9002_fh_mgr_load(m, ADI_ADRV9001_FHHOPTABLE_A, 0);
+	if (ret)
+		goto error;
+
+	if (m->num_chunks > 1) {
+		ret = adrv9002_fh_mgr_load(m, ADI_ADRV9001_FHHOPTABLE_B, 1);
+		if (ret)
+			goto error;
+	}
+
+	ret = adi_adrv9001_fh_HopTable_Set(m->adrv9001, m->hop_signal,
+					   ADI_ADRV9001_FHHOPTABLE_A);
+	if (ret) {
+		ret = -EIO;
+		goto error;
+	}
+	m->active = ADI_ADRV9001_FHHOPTABLE_A;
+
+	*mgr = m;
+
+	return 0;
+
+error:
+	adrv9002_fh_mgr_remove(m);
+
+	return ret;
+}
+
+/**
+ * @brief Free the hop table manager.
+ * @param mgr - Hop table manager.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int adrv9002_fh_mgr_remove(struct adrv9002_fh_mgr *mgr)
+{
+	uint32_t i;
+
+	if (!mgr)
+		return -EINVAL;
+
+	if (mgr->image)
+		for (i = 0; i < mgr->num_chunks; i++)
+			no_os_free(mgr->image[i]);
+	no_os_free(mgr->image);
+	no_os_free(mgr->image_len);
+	no_os_free(mgr);
+
+	return 0;
+}
+
+/**
+ * @brief Sequence chunk which follows the one in the active table.
+ * @param mgr - Hop table manager.
+ * @return The chunk index.
+ */
+static uint32_t adrv9002_fh_mgr_next(struct adrv9002_fh_mgr *mgr)
+{
+	return (mgr->chunk[mgr->active] + 1) % mgr->num_chunks;
+}
+
+/**
+ * @brief Upload the next table into the idle hop table, if needed.
+ *
+ * Call from the idle loop between hops; the upload goes to the table
+ * which is not playing.
+ * @param mgr - Hop table manager.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int adrv9002_fh_mgr_service(struct adrv9002_fh_mgr *mgr)
+{
+	adi_adrv9001_FhHopTable_e idle;
+	uint32_t next;
+
+	if (!mgr)
+		return -EINVAL;
+
+	if (mgr->num_chunks < 2)
+		return 0;
+
+	idle = mgr->active == ADI_ADRV9001_FHHOPTABLE_A ?
+	       ADI_ADRV9001_FHHOPTABLE_B : ADI_ADRV9001_FHHOPTABLE_A;
+	next = adrv9002_fh_mgr_next(mgr);
+	if (mgr->chunk[idle] == (int32_t)next)
+		return 0;
+
+	return adrv9002_fh_mgr_load(mgr, idle, next);
+}
+
+/**
+ * @brief Issue one hop.
+ *
+ * When the active table has been played, the idle table is selected if it
+ * holds the next part of the sequence. Otherwise an underrun is counted and
+ * the active table is played again.
+ * @param mgr - Hop table manager.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int adrv9002_fh_mgr_hop(struct adrv9002_fh_mgr *mgr)
+{
+	adi_adrv9001_FhHopTable_e idle;
+	uint32_t hops, next;
+	int ret;
+
+	if (!mgr)
+		return -EINVAL;
+
+	hops = adrv9002_fh_chunk_hops(mgr, mgr->chunk[mgr->active]);
+	if (mgr->pos == hops) {
+		idle = mgr->active == ADI_ADRV9001_FHHOPTABLE_A ?
+		       ADI_ADRV9001_FHHOPTABLE_B : ADI_ADRV9001_FHHOPTABLE_A;
+		next = adrv9002_fh_mgr_next(mgr);
+		if (mgr->chunk[mgr->active] == (int32_t)next) {
+			/* The whole sequence fits in one table */
+		} else if (mgr->chunk[idle] == (int32_t)next) {
+			ret = adi_adrv9001_fh_HopTable_Set(mgr->adrv9001,
+							   mgr->hop_signal,
+							   idle);
+			if (ret)
+				return -EIO;
+			mgr->active = idle;
+			mgr->stats.switches++;
+		} else {
+			mgr->stats.underruns++;
+		}
+		mgr->pos = 0;
+	}
+
+	ret = adi_adrv9001_fh_Hop(mgr->adrv9001, mgr->hop_signal);
+	if (ret)
+		return -EIO;
+
+	mgr->pos++;
+	mgr->stats.hops++;
+
+	return 0;
+}
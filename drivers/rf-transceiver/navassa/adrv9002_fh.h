@@ -0,0 +1,137 @@
+/***************************************************************************//**
+ *   @file   adrv9002_fh.h
+ *   @brief  ADRV9002 frequency hopping table manager.
+ *   @author Analog Devices Inc.
+********************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef ADRV9002_FH_H_
+#define ADRV9002_FH_H_
+
+#include <stdint.h>
+#include "adi_adrv9001_types.h"
+#include "adi_adrv9001_fh_types.h"
+
+#define ADRV9002_FH_TABLE_HOPS_MAX	ADI_ADRV9001_FH_MAX_HOP_TABLE_SIZE
+#define ADRV9002_FH_FRAME_BYTES		20
+/* Size of the image of a hop table with n hops */
+#define ADRV9002_FH_IMAGE_SIZE(n)	(ADRV9002_FH_FRAME_BYTES * (n))
+
+/**
+ * @struct adrv9002_fh_seq
+ * @brief Hop sequence description, one entry per hop.
+ */
+struct adrv9002_fh_seq {
+	/** LO frequency of each hop */
+	const uint64_t *freq_hz;
+	/** RX gain index of each hop, NULL for the maximum gain index */
+	const uint8_t *rx_gain;
+	/** TX attenuation of each hop in 0.2 dB steps, NULL for 0 */
+	const uint8_t *tx_atten;
+	/** RX IF offset of each hop, NULL for 0 */
+	const int32_t *rx_offset_hz;
+	uint32_t num_hops;
+};
+
+/**
+ * @struct adrv9002_fh_stats
+ * @brief Hop table manager counters.
+ */
+struct adrv9002_fh_stats {
+	uint32_t hops;
+	/** Hop table A/B swaps */
+	uint32_t switches;
+	uint32_t tables_loaded;
+	uint32_t frames_loaded;
+	/** Hop table bytes written to the ARM memory */
+	uint32_t bytes;
+	/** Time spent uploading tables */
+	uint32_t upload_us;
+	/** Upload throughput in hop frames per second */
+	uint32_t frames_per_sec;
+	/** Table ends reached before the next table was uploaded */
+	uint32_t underruns;
+};
+
+/**
+ * @struct adrv9002_fh_mgr_init
+ * @brief Hop table manager initialization parameters.
+ */
+struct adrv9002_fh_mgr_init {
+	adi_adrv9001_Device_t *adrv9001;
+	adi_adrv9001_FhHopSignal_e hop_signal;
+	/** Complete hop sequence, played in a loop */
+	const adi_adrv9001_FhHopFrame_t *frames;
+	uint32_t num_hops;
+	/** Hops per hop table, up to ADRV9002_FH_TABLE_HOPS_MAX */
+	uint32_t table_hops;
+};
+
+/**
+ * @struct adrv9002_fh_mgr
+ * @brief Double buffered hop table manager.
+ */
+struct adrv9002_fh_mgr {
+	adi_adrv9001_Device_t *adrv9001;
+	adi_adrv9001_FhHopSignal_e hop_signal;
+	uint32_t num_hops;
+	uint32_t table_hops;
+	uint32_t num_chunks;
+	/** Prepacked image of every table sized chunk of the sequence */
+	uint8_t **image;
+	uint32_t *image_len;
+	/** Sequence chunk held by hop table A and B, -1 if none */
+	int32_t chunk[ADI_ADRV9001_FHHOPTABLE_B + 1];
+	adi_adrv9001_FhHopTable_e active;
+	/** Hops played from the active table */
+	uint32_t pos;
+	struct adrv9002_fh_stats stats;
+};
+
+/* Fill hop frames from frequency and gain sequences. */
+int adrv9002_fh_seq_build(const struct adrv9002_fh_seq *seq,
+			  adi_adrv9001_FhHopFrame_t *frames);
+/* Pack hop frames into a hop table image. */
+int adrv9002_fh_table_pack(const adi_adrv9001_FhHopFrame_t *frames,
+			   uint32_t num_hops, uint8_t *image, uint32_t *len);
+/* Write a hop table image to hop table A or B. */
+int adrv9002_fh_table_write(adi_adrv9001_Device_t *adrv9001,
+			    adi_adrv9001_FhHopSignal_e hop_signal,
+			    adi_adrv9001_FhHopTable_e table,
+			    const uint8_t *image, uint32_t len);
+/* Initialize the hop table manager and load the first tables. */
+int adrv9002_fh_mgr_init(struct adrv9002_fh_mgr **mgr,
+			 const struct adrv9002_fh_mgr_init *init);
+/* Free the hop table manager. */
+int adrv9002_fh_mgr_remove(struct adrv9002_fh_mgr *mgr);
+/* Upload the next table into the idle hop table, if needed. */
+int adrv9002_fh_mgr_service(struct adrv9002_fh_mgr *mgr);
+/* Issue one hop, swapping hop tables at the end of the active one. */
+int adrv9002_fh_mgr_hop(struct adrv9002_fh_mgr *mgr);
+
+#endif
@@ -9,6 +9,7 @@
  * Released under the AD9378-AD9379 API license, for more information see the "LICENSE.txt" file in this zip file.
  */
 
+#include <string.h>
 #include "talise_arm.h"
 #include "talise_radioctrl.h"
 #include "talise_reg_addr_macros.h"
@@ -797,20 +798,119 @@ uint32_t TALISE_readArmMem(taliseDevice_t *device, uint32_t address,
 	return (uint32_t)retVal;
 }
 
-uint32_t TALISE_writeArmMem(taliseDevice_t *device, uint32_t address,
-			    uint8_t *data, uint32_t byteCount)
+static uint32_t talWriteArmDmaData(taliseDevice_t *device, uint32_t offset,
+				   uint8_t *data, uint32_t byteCount)
 {
 	talRecoveryActions_t retVal = TALACT_NO_ACTION;
 	adiHalErr_t halError = ADIHAL_OK;
-	uint8_t dataMem = 0;
 	uint32_t i = 0;
-	uint8_t regWrite = 0;
 
 	uint32_t addrIndex = 0;
 	uint32_t dataIndex = 0;
 	uint32_t spiBufferSize = HAL_SPIWRITEARRAY_BUFFERSIZE;
 	uint16_t addrArray[HAL_SPIWRITEARRAY_BUFFERSIZE] = {0};
 
+	/* one SPI write per byte, cycling through the DMA data registers */
+	for (i = 0; i < byteCount; i++) {
+		addrArray[addrIndex++] = (uint16_t)(TALISE_ADDR_ARM_DMA_DATA0 + ((
+				offset + i) % 4));
+
+		if (addrIndex == spiBufferSize) {
+			halError = talSpiWriteBytes(device->devHalInfo, &addrArray[0], &data[dataIndex],
+						    addrIndex);
+			retVal = talApiErrHandler(device, TAL_ERRHDL_HAL_SPI, halError, retVal,
+						  TALACT_ERR_RESET_SPI);
+			IF_ERR_RETURN_U32(retVal);
+
+			dataIndex = dataIndex + addrIndex;
+			addrIndex = 0;
+		}
+	}
+
+	/* write remaining SPI bytes that did not fit  into a multiple of the spiBufferSize */
+	if (addrIndex > 0) {
+		halError = talSpiWriteBytes(device->devHalInfo, &addrArray[0], &data[dataIndex],
+					    addrIndex);
+		retVal = talApiErrHandler(device, TAL_ERRHDL_HAL_SPI, halError, retVal,
+					  TALACT_ERR_RESET_SPI);
+		IF_ERR_RETURN_U32(retVal);
+	}
+
+	return (uint32_t)retVal;
+}
+
+static uint32_t talWriteArmDmaBurst(taliseDevice_t *device, uint8_t *data,
+				    uint32_t byteCount)
+{
+	talRecoveryActions_t retVal = TALACT_NO_ACTION;
+	adiHalErr_t halError = ADIHAL_OK;
+	adiHalErr_t burstError = ADIHAL_OK;
+	uint8_t spiCfgA = 0;
+	uint8_t spiCfgB = 0;
+
+	static const uint8_t SOFT_RESET_BITS = 0x81;
+	static const uint8_t ADDR_ASCENSION_BITS = 0x24;
+	static const uint8_t SINGLE_INSTRUCTION_BIT = 0x80;
+
+	halError = talSpiReadByte(device->devHalInfo,
+				  TALISE_ADDR_SPI_INTERFACE_CONFIG_A, &spiCfgA);
+	retVal = talApiErrHandler(device, TAL_ERRHDL_HAL_SPI, halError, retVal,
+				  TALACT_ERR_RESET_SPI);
+	IF_ERR_RETURN_U32(retVal);
+
+	halError = talSpiReadByte(device->devHalInfo,
+				  TALISE_ADDR_SPI_INTERFACE_CONFIG_B, &spiCfgB);
+	retVal = talApiErrHandler(device, TAL_ERRHDL_HAL_SPI, halError, retVal,
+				  TALACT_ERR_RESET_SPI);
+	IF_ERR_RETURN_U32(retVal);
+
+	spiCfgA &= ~SOFT_RESET_BITS;
+
+	/* streaming with ascending addresses: one frame fills DATA0..DATA3 */
+	halError = talSpiWriteByte(device->devHalInfo,
+				   TALISE_ADDR_SPI_INTERFACE_CONFIG_A, spiCfgA | ADDR_ASCENSION_BITS);
+	retVal = talApiErrHandler(device, TAL_ERRHDL_HAL_SPI, halError, retVal,
+				  TALACT_ERR_RESET_SPI);
+	IF_ERR_RETURN_U32(retVal);
+
+	halError = talSpiWriteByte(device->devHalInfo,
+				   TALISE_ADDR_SPI_INTERFACE_CONFIG_B, spiCfgB & ~SINGLE_INSTRUCTION_BIT);
+	retVal = talApiErrHandler(device, TAL_ERRHDL_HAL_SPI, halError, retVal,
+				  TALACT_ERR_RESET_SPI);
+	IF_ERR_RETURN_U32(retVal);
+
+	burstError = talSpiWriteBurst(device->devHalInfo, TALISE_ADDR_ARM_DMA_DATA0,
+				      data, byteCount, 4);
+
+	/* restore the SPI settings before reporting a burst failure */
+	halError = talSpiWriteByte(device->devHalInfo,
+				   TALISE_ADDR_SPI_INTERFACE_CONFIG_B, spiCfgB);
+	retVal = talApiErrHandler(device, TAL_ERRHDL_HAL_SPI, halError, retVal,
+				  TALACT_ERR_RESET_SPI);
+	IF_ERR_RETURN_U32(retVal);
+
+	halError = talSpiWriteByte(device->devHalInfo,
+				   TALISE_ADDR_SPI_INTERFACE_CONFIG_A, spiCfgA);
+	retVal = talApiErrHandler(device, TAL_ERRHDL_HAL_SPI, halError, retVal,
+				  TALACT_ERR_RESET_SPI);
+	IF_ERR_RETURN_U32(retVal);
+
+	retVal = talApiErrHandler(device, TAL_ERRHDL_HAL_SPI, burstError, retVal,
+				  TALACT_ERR_RESET_SPI);
+
+	return (uint32_t)retVal;
+}
+
+uint32_t TALISE_writeArmMem(taliseDevice_t *device, uint32_t address,
+			    uint8_t *data, uint32_t byteCount)
+{
+	talRecoveryActions_t retVal = TALACT_NO_ACTION;
+	adiHalErr_t halError = ADIHAL_OK;
+	uint8_t dataMem = 0;
+	uint8_t regWrite = 0;
+	uint32_t headCount = 0;
+	uint32_t burstCount = 0;
+
 	static const uint8_t FORCE_AUTO_INC = 0x02;
 	static const uint8_t LEGACY_MODE_BIT = 0x20;
 
@@ -864,30 +964,67 @@ uint32_t TALISE_writeArmMem(taliseDevice_t *device, uint32_t address,
 				  TALACT_ERR_RESET_SPI);
 	IF_ERR_RETURN_U32(retVal);
 
-	/* starting write at zero address offset */
-	for (i = 0; i < byteCount; i++) {
-		addrArray[addrIndex++] = (uint16_t)(TALISE_ADDR_ARM_DMA_DATA0 + (((
-				address & 0x3) + i) % 4));
+	/* leading bytes up to the next ARM word boundary */
+	headCount = (4 - (address & 0x3)) & 0x3;
+	if (headCount > byteCount) {
+		headCount = byteCount;
+	}
 
-		if (addrIndex == spiBufferSize) {
-			halError = talSpiWriteBytes(device->devHalInfo, &addrArray[0], &data[dataIndex],
-						    addrIndex);
-			retVal = talApiErrHandler(device, TAL_ERRHDL_HAL_SPI, halError, retVal,
-						  TALACT_ERR_RESET_SPI);
-			IF_ERR_RETURN_U32(retVal);
+	/* whole words are streamed, small writes are not worth the mode switch */
+	burstCount = (byteCount - headCount) & ~0x3;
+	if (burstCount < TALISE_ARM_BURST_MIN_BYTES) {
+		burstCount = 0;
+	}
 
-			dataIndex = dataIndex + addrIndex;
-			addrIndex = 0;
-		}
+	retVal = (talRecoveryActions_t)talWriteArmDmaData(device, address & 0x3,
+			&data[0], headCount);
+	IF_ERR_RETURN_U32(retVal);
+
+	if (burstCount > 0) {
+		retVal = (talRecoveryActions_t)talWriteArmDmaBurst(device,
+				&data[headCount], burstCount);
+		IF_ERR_RETURN_U32(retVal);
 	}
 
-	/* write remaining SPI bytes that did not fit  into a multiple of the spiBufferSize */
-	if (addrIndex > 0) {
-		halError = talSpiWriteBytes(device->devHalInfo, &addrArray[0], &data[dataIndex],
-					    addrIndex);
-		retVal = talApiErrHandler(device, TAL_ERRHDL_HAL_SPI, halError, retVal,
-					  TALACT_ERR_RESET_SPI);
+	retVal = (talRecoveryActions_t)talWriteArmDmaData(device,
+			(address + headCount + burstCount) & 0x3,
+			&data[headCount + burstCount], byteCount - headCount - burstCount);
+	IF_ERR_RETURN_U32(retVal);
+
+	return (uint32_t)retVal;
+}
+
+uint32_t TALISE_verifyArmMem(taliseDevice_t *device, uint32_t address,
+			     uint8_t *data, uint32_t byteCount)
+{
+	talRecoveryActions_t retVal = TALACT_NO_ACTION;
+	uint8_t readBack[64] = {0};
+	uint32_t offset = 0;
+	uint32_t chunk = 0;
+
+#if TALISE_VERBOSE
+	adiHalErr_t halError = ADIHAL_OK;
+
+	halError = talWriteToLog(device->devHalInfo, ADIHAL_LOG_MSG, TAL_ERR_OK,
+				 "TALISE_verifyArmMem()\n");
+	retVal = talApiErrHandler(device, TAL_ERRHDL_HAL_LOG, halError, retVal,
+				  TALACT_WARN_RESET_LOG);
+#endif
+
+	for (offset = 0; offset < byteCount; offset += chunk) {
+		chunk = byteCount - offset;
+		if (chunk > sizeof(readBack)) {
+			chunk = sizeof(readBack);
+		}
+
+		retVal = (talRecoveryActions_t)TALISE_readArmMem(device, address + offset,
+				&readBack[0], chunk, 1);
 		IF_ERR_RETURN_U32(retVal);
+
+		if (memcmp(&readBack[0], &data[offset], chunk) != 0) {
+			return (uint32_t)talApiErrHandler(device, TAL_ERRHDL_API_FAIL,
+							  TAL_ERR_VERIFYARMMEM_MISMATCH, retVal, TALACT_ERR_RESET_ARM);
+		}
 	}
 
 	return (uint32_t)retVal;
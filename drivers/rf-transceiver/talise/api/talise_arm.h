@@ -189,6 +189,32 @@ uint32_t TALISE_readArmMem(taliseDevice_t *device, uint32_t address,
 uint32_t TALISE_writeArmMem(taliseDevice_t *device, uint32_t address,
 			    uint8_t *data, uint32_t byteCount);
 
+/**
+ * \brief Verifies a block of the Talise ARM program or data memory
+ *
+ * Reads back the ARM memory written by TALISE_writeArmMem() and checks it
+ * against the source image, so a faulty burst load is caught before the ARM
+ * or the stream processor runs the image.
+ *
+ * \pre This function may be called any time after TALISE_initArm().
+ *
+ * \dep_begin
+ * \dep{device->devHalInfo}
+ * \dep_end
+ *
+ * \param device Structure pointer to the Talise data structure containing settings
+ * \param address The 32-bit ARM address the image was written to
+ * \param data Byte array (uint8_t) containing the expected ARM memory contents
+ * \param byteCount Number of bytes in the data array to be verified
+ *
+ * \retval TALACT_ERR_CHECK_PARAM Recovery action for bad parameter check
+ * \retval TALACT_ERR_RESET_SPI Recovery action for SPI reset required
+ * \retval TALACT_ERR_RESET_ARM Read back data does not match the image
+ * \retval TALACT_NO_ACTION Function completed successfully, no action required
+ */
+uint32_t TALISE_verifyArmMem(taliseDevice_t *device, uint32_t address,
+			     uint8_t *data, uint32_t byteCount);
+
 /**
  * \brief Low level helper function used by Talise API to write the ARM memory config structures
  *
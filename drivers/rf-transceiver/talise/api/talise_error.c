@@ -1108,6 +1108,8 @@ const char* TALISE_getErrorMessage(uint32_t errSrc, uint32_t errCode)
 			return "TALISE_txNcoShifterSet(): tx1 tone frequency > divider rate KHZ or < negative divider rate KHZ";
 		case TAL_ERR_TXNCOSHIFTER_INV_TX2_FREQ:
 			return "TALISE_txNcoShifterSet(): tx2 tone frequency > divider rate KHZ or < negative divider rate KHZ";
+		case TAL_ERR_VERIFYARMMEM_MISMATCH:
+			return "VerifyArmMem() read back data does not match the written image\n";
 		case TAL_ERR_NUMBER_OF_ERRORS:
 			return "Invalid API error passed, last in error list\n"; /*Use for TestApiErrorStrings */
 
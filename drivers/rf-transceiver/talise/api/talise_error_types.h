@@ -528,6 +528,7 @@ typedef enum {
 	TAL_ERR_TXNCOSHIFTER_NULL_PARM,
 	TAL_ERR_TXNCOSHIFTER_INV_TX1_FREQ,
 	TAL_ERR_TXNCOSHIFTER_INV_TX2_FREQ,
+	TAL_ERR_VERIFYARMMEM_MISMATCH,
 	TAL_ERR_NUMBER_OF_ERRORS /* Keep this ENUM last as a reference to the total number of error enum values */
 } taliseErr_t;
 
@@ -53,6 +53,21 @@ adiHalErr_t talSpiWriteBytes(void *devHalInfo, uint16_t *addr, uint8_t *data,
 	return halError;
 }
 
+adiHalErr_t talSpiWriteBurst(void *devHalInfo, uint16_t addr, uint8_t *data,
+			     uint32_t count, uint32_t frameSize)
+{
+	adiHalErr_t halError = ADIHAL_OK;
+
+	halError = ADIHAL_spiWriteBurst(devHalInfo, addr, data, count, frameSize);
+	if (halError == ADIHAL_WAIT_TIMEOUT) {
+		ADIHAL_setTimeout(devHalInfo, HAL_TIMEOUT_DEFAULT * HAL_TIMEOUT_MULT);
+		halError = ADIHAL_spiWriteBurst(devHalInfo, addr, data, count, frameSize);
+	}
+
+	ADIHAL_setTimeout(devHalInfo, HAL_TIMEOUT_DEFAULT);
+	return halError;
+}
+
 adiHalErr_t talSpiReadBytes(void *devHalInfo, uint16_t *addr, uint8_t *readdata,
 			    uint32_t count)
 {
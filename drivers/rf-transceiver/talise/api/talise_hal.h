@@ -141,6 +141,27 @@ adiHalErr_t talSpiReadByte(void *devHalInfo, uint16_t addr, uint8_t *readdata);
 adiHalErr_t talSpiWriteBytes(void *devHalInfo, uint16_t *addr, uint8_t *data,
 			     uint32_t count);
 
+/**
+ * \brief Wrapper function for ADIHAL_spiWriteBurst with error handling
+ *
+ * This function can be called any time after the devHalInfo has been initialized
+ * with valid settings by the user and the device is in SPI streaming mode
+ *
+ * \dep_begin
+ * \dep{devHalInfo}
+ * \dep_end
+ *
+ * \param devHalInfo Pointer to device HAL information container
+ * \param addr 16-bit SPI address of the first register of every frame
+ * \param data Pointer to byte array to be written
+ * \param count Number of bytes to be written, multiple of frameSize
+ * \param frameSize Number of data bytes per streaming frame
+ *
+ * \retval Returns adiHalErr_t enumerated type
+ */
+adiHalErr_t talSpiWriteBurst(void *devHalInfo, uint16_t addr, uint8_t *data,
+			     uint32_t count, uint32_t frameSize);
+
 /**
  * \brief Wrapper function for ADIHAL_spiReadBytes with error handling
  *
@@ -56,6 +56,13 @@ uint32_t TALISE_loadStreamFromBinary(taliseDevice_t *device, uint8_t *binary)
 			binary, imageSize);
 	IF_ERR_RETURN_U32(retVal);
 
+#if TALISE_VERIFY_STREAM_LOAD
+	/* the stream image has no on-chip checksum, read it back instead */
+	retVal = (talRecoveryActions_t)TALISE_verifyArmMem(device, streamBinBaseAddr,
+			binary, imageSize);
+	IF_ERR_RETURN_U32(retVal);
+#endif
+
 	/* writing lower 16 bits of stream base address */
 	halError = talSpiWriteByte(device->devHalInfo, TALISE_ADDR_STREAM_BASE_BYTE0,
 				   (uint8_t)streamBaseAddr);
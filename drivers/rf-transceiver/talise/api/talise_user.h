@@ -106,6 +106,21 @@ extern "C" {
 #define START_ORX_GAIN_INDEX            (MIN_RX_GAIN_TABLE_INDEX - 1)
 #define MIN_ORX_GAIN_TABLE_INDEX        4
 
+/*
+ *****************************************
+ * ARM memory loading
+ ******************************************
+ */
+/* Smallest ARM memory write sent as SPI streaming frames */
+#ifndef TALISE_ARM_BURST_MIN_BYTES
+#define TALISE_ARM_BURST_MIN_BYTES      64
+#endif
+
+/* Read back the stream processor image after loading it */
+#ifndef TALISE_VERIFY_STREAM_LOAD
+#define TALISE_VERIFY_STREAM_LOAD       1
+#endif
+
 extern taliseRxGainTable_t rxGainTable [61];
 extern taliseOrxGainTable_t orxGainTable [61];
 
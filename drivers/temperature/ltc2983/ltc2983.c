@@ -32,6 +32,8 @@
 *******************************************************************************/
 
 #include <errno.h>
+#include <stddef.h>
+#include <string.h>
 #include "ltc2983.h"
 #include "no_os_alloc.h"
 #include "no_os_delay.h"
@@ -99,13 +101,23 @@ int ltc2983_init(struct ltc2983_desc **device,
 	if (ret)
 		goto gpio_err;
 
-	ret = ltc2983_setup(descriptor);
+	ret = no_os_gpio_get_optional(&descriptor->gpio_intr,
+				      init_param->gpio_intr);
 	if (ret)
 		goto gpio_err;
+	ret = no_os_gpio_direction_input(descriptor->gpio_intr);
+	if (ret)
+		goto gpio_intr_err;
+
+	ret = ltc2983_setup(descriptor);
+	if (ret)
+		goto gpio_intr_err;
 
 	*device = descriptor;
 	return 0;
 
+gpio_intr_err:
+	no_os_gpio_remove(descriptor->gpio_intr);
 gpio_err:
 	no_os_gpio_remove(descriptor->gpio_rstn);
 spi_err:
@@ -126,6 +138,10 @@ int ltc2983_remove(struct ltc2983_desc *device)
 	if (!device)
 		return -ENODEV;
 
+	ret = no_os_gpio_remove(device->gpio_intr);
+	if (ret)
+		return -EINVAL;
+
 	ret = no_os_gpio_remove(device->gpio_rstn);
 	if (ret)
 		return -EINVAL;
@@ -319,7 +335,7 @@ int ltc2983_chan_read(struct ltc2983_desc *device, const int chan, int *val)
 	uint32_t raw_val, scale_val, scale_val2;
 	int ret;
 
-	if (device->sensors[chan]->type == LTC2983_RSENSE) {
+	if (device->sensors[chan - 1]->type == LTC2983_RSENSE) {
 		*val = -1;
 		return 0;
 	}
@@ -337,6 +353,82 @@ int ltc2983_chan_read(struct ltc2983_desc *device, const int chan, int *val)
 	return 0;
 }
 
+/**
+ * @brief Wait for the end of the conversions in progress
+ * @param device - LTC2983 descriptor
+ * @param nb - number of channels being converted
+ * @return 0 in case of success, errno errors otherwise
+ */
+static int ltc2983_wait_conv(struct ltc2983_desc *device, uint32_t nb)
+{
+	uint32_t delay = LTC2983_POLL_MIN_MS;
+	uint32_t timeout = nb * LTC2983_CONV_TIMEOUT_MS;
+	uint32_t elapsed;
+	uint8_t val;
+	int ret;
+
+	/* Every channel takes at least two conversion cycles */
+	elapsed = nb * 2 * LTC2983_CONV_CYCLE_MS;
+	no_os_mdelay(elapsed);
+
+	while (true) {
+		if (device->gpio_intr) {
+			/* INTERRUPT goes high at the end of the conversions */
+			ret = no_os_gpio_get_value(device->gpio_intr, &val);
+			if (ret)
+				return ret;
+			if (val == NO_OS_GPIO_HIGH)
+				return 0;
+		} else {
+			ret = ltc2983_reg_read(device, LTC2983_STATUS_REG, &val);
+			if (ret)
+				return ret;
+			if (LTC2983_STATUS_UP(val) == 1)
+				return 0;
+		}
+
+		if (elapsed >= timeout)
+			return -ETIMEDOUT;
+
+		no_os_mdelay(delay);
+		elapsed += delay;
+		/* Back off, every status read is an SPI transaction */
+		if (!device->gpio_intr)
+			delay = no_os_min(delay * 2, LTC2983_POLL_MAX_MS);
+	}
+}
+
+/**
+ * @brief Check a conversion result
+ * @param device - LTC2983 descriptor
+ * @param chan - channel number
+ * @param res - result register value
+ * @param val - sign extended channel data / temperature
+ * @return 0 in case of success, errno errors otherwise
+ */
+static int ltc2983_chan_result(struct ltc2983_desc *device, const int chan,
+			       uint32_t res, int32_t *val)
+{
+	int ret;
+
+	if (!(LTC2983_RES_VALID_MASK & res)) {
+		pr_err("Channel %d: Invalid conversion detected\r\n", chan);
+		return -EIO;
+	}
+
+	if (device->sensors[chan - 1]->type <= LTC2983_THERMOCOUPLE_CUSTOM)
+		ret = ltc2983_thermocouple_fault_handler(res);
+	else
+		ret = ltc2983_common_fault_handler(res);
+	if (ret)
+		return ret;
+
+	*val = no_os_sign_extend32(res & LTC2983_DATA_MASK,
+				   LTC2983_DATA_SIGN_BIT);
+
+	return 0;
+}
+
 /**
  * @brief Read raw channel data / temperature
  * @param device - LTC2983 descriptor
@@ -349,6 +441,7 @@ int ltc2983_chan_read_raw(struct ltc2983_desc *device, const int chan,
 {
 	uint32_t start_conversion = 0;
 	uint8_t raw_array[7];
+	int32_t res;
 	int ret;
 
 	start_conversion = LTC2983_STATUS_START(true);
@@ -358,7 +451,9 @@ int ltc2983_chan_read_raw(struct ltc2983_desc *device, const int chan,
 	if (ret)
 		return ret;
 
-	no_os_mdelay(300);
+	ret = ltc2983_wait_conv(device, 1);
+	if (ret)
+		return ret;
 
 	/* read the converted data */
 	raw_array[0] = LTC2983_SPI_READ_BYTE;
@@ -369,23 +464,96 @@ int ltc2983_chan_read_raw(struct ltc2983_desc *device, const int chan,
 	if (ret)
 		return ret;
 
-	*val = no_os_get_unaligned_be32(raw_array + 3);
+	ret = ltc2983_chan_result(device, chan,
+				  no_os_get_unaligned_be32(raw_array + 3), &res);
+	if (ret)
+		return ret;
 
-	if (!(LTC2983_RES_VALID_MASK & *val)) {
-		pr_err("Channel %d: Invalid conversion detected\r\n", chan);
-		return -EIO;
+	*val = res;
+
+	return 0;
+}
+
+/**
+ * @brief Convert a set of channels with a single command
+ *
+ * The channels are converted one after the other by the device, which
+ * signals the end of the sequence on the INTERRUPT pin and in the status
+ * register. All results are then read with a single SPI transaction.
+ * @param device - LTC2983 descriptor
+ * @param mask - channels to convert, bit 0 is channel 1
+ * @param scan - scan result
+ * @return 0 if all channels are valid, -EIO if some results are invalid or
+ * faulty (see scan->valid), errno errors otherwise
+ */
+int ltc2983_scan(struct ltc2983_desc *device, uint32_t mask,
+		 struct ltc2983_scan *scan)
+{
+	uint8_t raw_array[3 + 4 * LTC2983_MAX_CHANNELS];
+	uint32_t first, last, nb, len;
+	uint8_t *res;
+	int ret, chan;
+
+	if (!device || !scan || !mask ||
+	    mask & ~NO_OS_GENMASK(device->max_channels_nr - 1, 0))
+		return -EINVAL;
+
+	for (chan = 1; chan <= device->max_channels_nr; chan++) {
+		if (!(mask & NO_OS_BIT(chan - 1)))
+			continue;
+		if (!device->sensors[chan - 1] ||
+		    device->sensors[chan - 1]->type == LTC2983_RSENSE)
+			return -EINVAL;
 	}
 
-	if (device->sensors[chan]->type <= LTC2983_THERMOCOUPLE_CUSTOM)
-		ret = ltc2983_thermocouple_fault_handler(*val);
-	else
-		ret = ltc2983_common_fault_handler(*val);
+	first = no_os_find_first_set_bit(mask) + 1;
+	last = no_os_find_last_set_bit(mask) + 1;
+	nb = no_os_hweight32(mask);
+
+	/* select the channels */
+	raw_array[0] = LTC2983_SPI_WRITE_BYTE;
+	no_os_put_unaligned_be16(LTC2983_MULT_CHANNEL_REG, raw_array + 1);
+	no_os_put_unaligned_be32(mask, raw_array + 3);
+	ret = no_os_spi_write_and_read(device->comm_desc, raw_array, 7);
 	if (ret)
 		return ret;
 
-	*val = no_os_sign_extend32((*val) & LTC2983_DATA_MASK,
-				   LTC2983_DATA_SIGN_BIT);
-	return 0;
+	/* start a multiple conversion, channel select 0 */
+	ret = ltc2983_reg_write(device, LTC2983_STATUS_REG,
+				LTC2983_STATUS_START(true));
+	if (ret)
+		return ret;
+
+	ret = ltc2983_wait_conv(device, nb);
+	if (ret)
+		return ret;
+
+	scan->timestamp = no_os_get_time();
+
+	/* read all results from first to last channel in one burst */
+	len = 3 + 4 * (last - first + 1);
+	memset(raw_array, 0, len);
+	raw_array[0] = LTC2983_SPI_READ_BYTE;
+	no_os_put_unaligned_be16(LTC2983_CHAN_RES_ADDR(first), raw_array + 1);
+	ret = no_os_spi_write_and_read(device->comm_desc, raw_array, len);
+	if (ret)
+		return ret;
+
+	scan->valid = 0;
+	for (chan = first; chan <= (int)last; chan++) {
+		if (!(mask & NO_OS_BIT(chan - 1)))
+			continue;
+
+		res = raw_array + 3 + 4 * (chan - first);
+		if (ltc2983_chan_result(device, chan,
+					no_os_get_unaligned_be32(res),
+					&scan->raw[chan - 1]))
+			continue;
+
+		scan->valid |= NO_OS_BIT(chan - 1);
+	}
+
+	return scan->valid == mask ? 0 : -EIO;
 }
 
 /**
@@ -399,7 +567,7 @@ int ltc2983_chan_read_raw(struct ltc2983_desc *device, const int chan,
 int ltc2983_chan_read_scale(struct ltc2983_desc *device, const int chan,
 			    uint32_t *val, uint32_t *val2)
 {
-	if (device->sensors[chan]->type == LTC2983_DIRECT_ADC) {
+	if (device->sensors[chan - 1]->type == LTC2983_DIRECT_ADC) {
 		/* value in millivolt */
 		*val = 1000;
 		/* 2^21 */
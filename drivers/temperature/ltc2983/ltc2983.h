@@ -35,6 +35,7 @@
 #define __LTC2983_H__
 
 #include <stdbool.h>
+#include "no_os_delay.h"
 #include "no_os_gpio.h"
 #include "no_os_spi.h"
 #include "no_os_util.h"
@@ -44,6 +45,7 @@
 #define LTC2983_EEPROM_KEY_REG			0x00B0
 #define LTC2983_EEPROM_READ_STATUS_REG		0x00D0
 #define LTC2983_GLOBAL_CONFIG_REG 		0x00F0
+#define LTC2983_MULT_CHANNEL_REG		0x00F4
 #define LTC2986_EEPROM_STATUS_REG		0x00F9
 #define LTC2983_MUX_CONFIG_REG 			0x00FF
 #define LTC2983_CHAN_ASSIGN_START_REG 	0x0200
@@ -64,6 +66,13 @@
 #define LTC2983_EEPROM_WRITE_TIME_MS	2600
 #define LTC2983_EEPROM_READ_TIME_MS		20
 
+/* One conversion cycle, a channel takes two or three of them */
+#define LTC2983_CONV_CYCLE_MS		82
+#define LTC2983_CONV_TIMEOUT_MS		500
+#define LTC2983_POLL_MIN_MS		1
+#define LTC2983_POLL_MAX_MS		20
+#define LTC2983_MAX_CHANNELS		20
+
 #define LTC2983_CHAN_START_ADDR(chan) \
 			(((chan - 1) * 4) + LTC2983_CHAN_ASSIGN_START_REG)
 #define LTC2983_CHAN_RES_ADDR(chan) \
@@ -222,6 +231,9 @@ struct ltc2983_init_param {
 	struct no_os_spi_init_param spi_init;
 	/** Reset GPIO configuration */
 	struct no_os_gpio_init_param gpio_rstn;
+	/** INTERRUPT GPIO configuration, the status register is polled if
+	 *  NULL */
+	struct no_os_gpio_init_param *gpio_intr;
 	/** MUX configuration delay in us */
 	uint32_t mux_delay_config_us;
 	/** Notch frequency of the digital filter */
@@ -242,6 +254,8 @@ struct ltc2983_desc {
 	struct no_os_spi_desc *comm_desc;
 	/** Reset GPIO descriptor */
 	struct no_os_gpio_desc *gpio_rstn;
+	/** INTERRUPT GPIO descriptor */
+	struct no_os_gpio_desc *gpio_intr;
 	/** MUX configuration delay in us */
 	uint32_t mux_delay_config_us;
 	/** Notch frequency of the digital filter */
@@ -392,6 +406,19 @@ struct ltc2983_temp {
 	bool single_ended;
 };
 
+/**
+ * @brief LTC2983 multi-channel scan result
+ */
+struct ltc2983_scan {
+	/** Channels with a valid result, bit 0 is channel 1 */
+	uint32_t valid;
+	/** Time at which the end of the conversions was detected, 0 on
+	 *  platforms without a time base */
+	struct no_os_time timestamp;
+	/** Sign extended results, index 0 is channel 1 */
+	int32_t raw[LTC2983_MAX_CHANNELS];
+};
+
 /** Device and comm init function */
 int ltc2983_init(struct ltc2983_desc **, struct ltc2983_init_param *);
 
@@ -416,6 +443,9 @@ int ltc2983_chan_read(struct ltc2983_desc *, const int, int *);
 /** Read raw channel data / temperature */
 int ltc2983_chan_read_raw(struct ltc2983_desc *, const int, uint32_t *);
 
+/** Convert a set of channels with a single command */
+int ltc2983_scan(struct ltc2983_desc *, uint32_t, struct ltc2983_scan *);
+
 /** Set scale of raw channel data / temperature */
 int ltc2983_chan_read_scale(struct ltc2983_desc *, const int, uint32_t *,
 			    uint32_t *);
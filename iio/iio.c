@@ -1420,9 +1420,25 @@ int iio_buffer_push_scan(struct iio_buffer *buffer, void *data)
 	if (!buffer)
 		return -EINVAL;
 
+	/* Nothing to store when only unbuffered channels are enabled */
+	if (!buffer->bytes_per_scan)
+		return 0;
+
 	return no_os_cb_write(buffer->buf, data, buffer->bytes_per_scan);
 }
 
+/* Write to buffer nb * iio_buffer.bytes_per_scan bytes from data */
+int iio_buffer_push_scans(struct iio_buffer *buffer, void *data, uint32_t nb)
+{
+	if (!buffer)
+		return -EINVAL;
+
+	if (!nb || !buffer->bytes_per_scan)
+		return 0;
+
+	return no_os_cb_write(buffer->buf, data, nb * buffer->bytes_per_scan);
+}
+
 /* Read from buffer iio_buffer.bytes_per_scan bytes into data */
 int iio_buffer_pop_scan(struct iio_buffer *buffer, void *data)
 {
@@ -137,6 +137,8 @@ int iio_buffer_block_done(struct iio_buffer *buffer);
 /* Trigger buffer functions. */
 /* Write to buffer iio_buffer.bytes_per_scan bytes from data */
 int iio_buffer_push_scan(struct iio_buffer *buffer, void *data);
+/* Write to buffer nb * iio_buffer.bytes_per_scan bytes from data */
+int iio_buffer_push_scans(struct iio_buffer *buffer, void *data, uint32_t nb);
 /* Read from buffer iio_buffer.bytes_per_scan bytes into data */
 int iio_buffer_pop_scan(struct iio_buffer *buffer, void *data);
 
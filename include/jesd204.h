@@ -242,6 +242,14 @@ struct jesd204_topology_dev {
 	bool			is_sysref_provider;
 	unsigned int		link_ids[JESD204_MAX_TOPOLOGY_LINKS];
 	unsigned int		links_number;
+	/*
+	 * Devices that must complete a state before this one enters it, e.g.
+	 * the clock chip feeding a transceiver. Only used when the topology
+	 * runs in parallel (max_workers set); devices with no inputs do not
+	 * wait for each other.
+	 */
+	struct jesd204_dev	**inputs;
+	unsigned int		inputs_number;
 };
 
 /* no-OS specific */
@@ -249,6 +257,16 @@ struct jesd204_topology {
 	struct jesd204_dev_top		*dev_top;
 	struct jesd204_topology_dev	*devs;
 	unsigned int			devs_number;
+	/*
+	 * Number of threads running the state ops of independent devices
+	 * during jesd204_fsm_start(); 0 keeps the sequential order. When set,
+	 * the callbacks of a state are no longer interleaved link by link:
+	 * each device handles all its links at once and the top device runs
+	 * last.
+	 */
+	unsigned int			max_workers;
+	/* Time spent in each state op by the last jesd204_fsm_start() */
+	uint32_t			op_time_us[__JESD204_MAX_OPS];
 };
 
 /* no-OS specific */
@@ -34,6 +34,46 @@
 #define _NO_OS_CLK_H_
 
 #include <stdint.h>
+#include <stdbool.h>
+
+/** Keep the last rate in the descriptor and only read it again after a
+ *  change. The driver must call no_os_clk_invalidate_rate() if it changes the
+ *  rate without going through no_os_clk_set_rate(). */
+#define NO_OS_CLK_CACHE_RATE	(1 << 0)
+
+struct no_os_clk_desc;
+
+/**
+ * @enum no_os_clk_event
+ * @brief Rate change events delivered to notifiers.
+ */
+enum no_os_clk_event {
+	/** The rate is about to change, a notifier may refuse it */
+	NO_OS_CLK_PRE_RATE_CHANGE,
+	/** The rate has changed */
+	NO_OS_CLK_POST_RATE_CHANGE,
+	/** The change announced by NO_OS_CLK_PRE_RATE_CHANGE was cancelled */
+	NO_OS_CLK_ABORT_RATE_CHANGE,
+};
+
+/**
+ * @struct no_os_clk_notifier
+ * @brief Rate change callback of a clock consumer.
+ */
+struct no_os_clk_notifier {
+	/** Called for rate changes of the clock or of one of its parents.
+	 *  new_rate is 0 when it is not known yet (PRE event of a child clock).
+	 *  A non-zero return value on NO_OS_CLK_PRE_RATE_CHANGE cancels the
+	 *  change. */
+	int (*notifier_call)(struct no_os_clk_notifier *nb,
+			     enum no_os_clk_event event,
+			     struct no_os_clk_desc *desc,
+			     uint64_t old_rate, uint64_t new_rate);
+	/** Consumer data */
+	void *priv;
+	/** Next notifier of the clock, managed by no_os_clk */
+	struct no_os_clk_notifier *next;
+};
 
 struct no_os_clk_init_param {
 	/** Device name */
@@ -44,6 +84,10 @@ struct no_os_clk_init_param {
 	const struct no_os_clk_platform_ops *platform_ops;
 	/**  CLK hardware device descriptor */
 	void		*dev_desc;
+	/** (Optional) Parent clock, its rate changes are propagated here */
+	struct no_os_clk_desc *parent;
+	/** NO_OS_CLK_* flags */
+	uint32_t	flags;
 };
 
 struct no_os_clk_hw {
@@ -75,6 +119,22 @@ typedef struct no_os_clk_desc {
 	const struct no_os_clk_platform_ops *platform_ops;
 	/**  CLK hardware device descriptor */
 	void		*dev_desc;
+	/** Parent clock */
+	struct no_os_clk_desc *parent;
+	/** First child clock */
+	struct no_os_clk_desc *child;
+	/** Next clock with the same parent */
+	struct no_os_clk_desc *sibling;
+	/** Rate change notifiers */
+	struct no_os_clk_notifier *notifiers;
+	/** NO_OS_CLK_* flags */
+	uint32_t	flags;
+	/** Cached rate, valid if rate_valid is set */
+	uint64_t	rate;
+	/** Set when rate holds the current rate */
+	bool		rate_valid;
+	/** old_rate reported to the notifiers during a change */
+	uint64_t	old_rate;
 } no_os_clk_desc;
 
 /**
@@ -95,6 +155,10 @@ struct no_os_clk_platform_ops {
 	int (*clk_round_rate)(struct no_os_clk_desc *, uint64_t, uint64_t *);
 	/* Change CLK frequency function pointer. */
 	int (*clk_set_rate)(struct no_os_clk_desc *, uint64_t);
+	/* (Optional) Change the frequency of several clocks of the same device
+	 * at once. */
+	int (*clk_set_rates)(struct no_os_clk_desc **, const uint64_t *,
+			     uint32_t);
 	/** CLK remove function pointer */
 	int (*remove)(struct no_os_clk_desc *);
 };
@@ -125,4 +189,20 @@ int32_t no_os_clk_round_rate(struct no_os_clk_desc *desc,
 int32_t no_os_clk_set_rate(struct no_os_clk_desc *desc,
 			   uint64_t rate);
 
+/* Change the frequency of several clocks in one batch. */
+int32_t no_os_clk_set_rates(struct no_os_clk_desc **desc,
+			    const uint64_t *rates,
+			    uint32_t nb_clks);
+
+/* Drop the cached rate of the clock and of its children. */
+void no_os_clk_invalidate_rate(struct no_os_clk_desc *desc);
+
+/* Register a rate change notifier. */
+int32_t no_os_clk_notifier_register(struct no_os_clk_desc *desc,
+				    struct no_os_clk_notifier *nb);
+
+/* Unregister a rate change notifier. */
+int32_t no_os_clk_notifier_unregister(struct no_os_clk_desc *desc,
+				      struct no_os_clk_notifier *nb);
+
 #endif // _NO_OS_CLK_H_
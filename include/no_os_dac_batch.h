@@ -0,0 +1,157 @@
+/***************************************************************************//**
+ *   @file   no_os_dac_batch.h
+ *   @brief  Batched, LDAC synchronous DAC channel updates.
+ *   @author Analog Devices Inc.
+********************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_DAC_BATCH_H_
+#define _NO_OS_DAC_BATCH_H_
+
+#include <stdint.h>
+#include "no_os_spi.h"
+#include "no_os_gpio.h"
+#include "no_os_timer.h"
+
+/** Largest SPI frame of a single DAC command, in bytes */
+#define NO_OS_DAC_BATCH_MAX_FRAME	4
+
+/**
+ * @enum no_os_dac_batch_mode
+ * @brief How the updates are laid out on the SPI bus.
+ */
+enum no_os_dac_batch_mode {
+	/** One device, one chip select frame per update */
+	NO_OS_DAC_BATCH_STREAM,
+	/** Devices daisy chained, one chip select frame per chain round */
+	NO_OS_DAC_BATCH_DAISY_CHAIN,
+};
+
+/**
+ * @struct no_os_dac_update
+ * @brief Input register write of one channel.
+ */
+struct no_os_dac_update {
+	/** Device index in the chain, 0 is the one wired to the controller */
+	uint8_t dev;
+	/** Device channel */
+	uint8_t ch;
+	/** DAC code, right aligned */
+	uint32_t code;
+};
+
+/**
+ * @struct no_os_dac_batch_ops
+ * @brief Frame encoders of a DAC driver. They only fill the frame, no IO.
+ */
+struct no_os_dac_batch_ops {
+	/** Bytes per command frame */
+	uint8_t frame_size;
+	/** Write the input register of a channel, without updating the output */
+	int (*pack_write)(void *dev, uint8_t ch, uint32_t code,
+			  uint8_t *frame);
+	/** Command with no effect, pads the chain. All zeros if NULL */
+	int (*pack_nop)(void *dev, uint8_t *frame);
+	/** Update all the outputs, used when there is no LDAC. May be NULL */
+	int (*pack_update)(void *dev, uint8_t *frame);
+};
+
+/**
+ * @struct no_os_dac_batch_desc
+ * @brief Batched DAC update descriptor.
+ */
+struct no_os_dac_batch_desc {
+	/** SPI bus of the device or of the chain */
+	struct no_os_spi_desc *spi;
+	/** LDAC pin, idles high */
+	struct no_os_gpio_desc *ldac;
+	/** Driver descriptors handed to the ops */
+	void **devs;
+	/** Number of devices */
+	uint8_t nb_devs;
+	/** Bus layout */
+	enum no_os_dac_batch_mode mode;
+	/** Driver frame encoders */
+	const struct no_os_dac_batch_ops *ops;
+	/** Largest number of updates accepted by one write */
+	uint32_t max_updates;
+	/** Rows started after their slot by the last playback */
+	uint32_t nb_late;
+	/** Updates per device in the current write */
+	uint32_t *cnt;
+	/** Transmit buffer */
+	uint8_t *buf;
+	/** SPI messages, one per chip select frame */
+	struct no_os_spi_msg *msgs;
+	/** Row being played */
+	struct no_os_dac_update *row;
+};
+
+/**
+ * @struct no_os_dac_batch_init_param
+ * @brief Batched DAC update initialization parameters.
+ */
+struct no_os_dac_batch_init_param {
+	/** SPI bus of the device or of the chain, not owned */
+	struct no_os_spi_desc *spi;
+	/**
+	 * LDAC pin, not owned. If NULL, ops->pack_update is sent instead and
+	 * if that is NULL too, the updates are only latched
+	 */
+	struct no_os_gpio_desc *ldac;
+	/** Driver descriptors, not owned */
+	void **devs;
+	/** Number of devices, 1 in stream mode */
+	uint8_t nb_devs;
+	/** Bus layout */
+	enum no_os_dac_batch_mode mode;
+	/** Driver frame encoders */
+	const struct no_os_dac_batch_ops *ops;
+	/** Largest number of updates accepted by one write */
+	uint32_t max_updates;
+};
+
+/* Allocate the frame buffers of a batch. */
+int no_os_dac_batch_init(struct no_os_dac_batch_desc **desc,
+			 const struct no_os_dac_batch_init_param *param);
+
+/* Write nb updates in one SPI transfer, then load them all together. */
+int no_os_dac_batch_write(struct no_os_dac_batch_desc *desc,
+			  const struct no_os_dac_update *upd, uint32_t nb);
+
+/* Write nb_rows rows of nb_chans samples at rate_hz, paced by a timer. */
+int no_os_dac_batch_play(struct no_os_dac_batch_desc *desc,
+			 const struct no_os_dac_update *chans,
+			 uint32_t nb_chans, const uint32_t *samples,
+			 uint32_t nb_rows, struct no_os_timer_desc *timer,
+			 uint32_t rate_hz);
+
+/* Free the resources allocated by no_os_dac_batch_init(). */
+int no_os_dac_batch_remove(struct no_os_dac_batch_desc *desc);
+
+#endif // _NO_OS_DAC_BATCH_H_
@@ -0,0 +1,135 @@
+/***************************************************************************//**
+ *   @file   no_os_dds.h
+ *   @brief  Direct digital synthesis (DDS) waveform generator.
+ *   @author Analog Devices Inc.
+********************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_DDS_H_
+#define _NO_OS_DDS_H_
+
+#include <stdint.h>
+
+/** Maximum number of tones summed by one generator */
+#define NO_OS_DDS_MAX_TONES	4
+
+/** Full scale tone amplitude (Q15) */
+#define NO_OS_DDS_FULL_SCALE	0x7FFF
+
+/** Phase word for a given angle in degrees */
+#define NO_OS_DDS_PHASE_DEG(deg) \
+	((uint32_t)(((uint64_t)(deg) << 32) / 360))
+
+/* 512 entries, one period, offset binary centered at 0x8000 */
+extern const uint16_t no_os_sine_lut_16[512];
+
+/**
+ * @enum no_os_dds_format
+ * @brief Coding of the generated samples.
+ */
+enum no_os_dds_format {
+	/** Offset binary, 0x8000 is mid scale */
+	NO_OS_DDS_OFFSET_BINARY,
+	/** Two's complement, 0 is mid scale */
+	NO_OS_DDS_TWOS_COMPLEMENT,
+};
+
+/**
+ * @struct no_os_dds_tone
+ * @brief State of one tone of the generator.
+ */
+struct no_os_dds_tone {
+	/** Phase accumulator */
+	uint32_t phase;
+	/** Frequency tuning word, added to the phase every sample */
+	uint32_t ftw;
+	/** Tone amplitude (Q15), 0 disables the tone */
+	uint16_t amplitude;
+	/** Tuning word change per sample, 0 for a fixed frequency tone */
+	int32_t chirp_step;
+	/** Sweep length in samples */
+	uint32_t chirp_len;
+	/** Position in the sweep */
+	uint32_t chirp_pos;
+	/** Tuning word at the start of the sweep */
+	uint32_t ftw_start;
+};
+
+/**
+ * @struct no_os_dds_desc
+ * @brief DDS generator descriptor.
+ */
+struct no_os_dds_desc {
+	/** Sample rate in Hz */
+	uint32_t sample_rate;
+	/** Output sample coding */
+	enum no_os_dds_format format;
+	/** Tones summed into the output */
+	struct no_os_dds_tone tone[NO_OS_DDS_MAX_TONES];
+};
+
+/**
+ * @struct no_os_dds_init_param
+ * @brief DDS generator initialization parameters.
+ */
+struct no_os_dds_init_param {
+	/** Sample rate in Hz */
+	uint32_t sample_rate;
+	/** Output sample coding */
+	enum no_os_dds_format format;
+};
+
+/* Allocate a generator with all the tones disabled. */
+int no_os_dds_init(struct no_os_dds_desc **desc,
+		   const struct no_os_dds_init_param *param);
+
+/* Set a fixed frequency tone. */
+int no_os_dds_set_tone(struct no_os_dds_desc *desc, uint8_t idx,
+		       uint32_t freq, uint16_t amplitude, uint32_t phase);
+
+/* Set a tone sweeping linearly from f_start to f_stop every nb_samples. */
+int no_os_dds_set_chirp(struct no_os_dds_desc *desc, uint8_t idx,
+			uint32_t f_start, uint32_t f_stop, uint32_t nb_samples,
+			uint16_t amplitude);
+
+/* Generate nb_samples samples, stride elements apart. */
+int no_os_dds_fill(struct no_os_dds_desc *desc, uint16_t *buff,
+		   uint32_t nb_samples, uint32_t stride);
+
+#ifdef IIO_SUPPORT
+struct iio_buffer;
+
+/* Fill one block of an iio buffer, one generator per active channel. */
+int no_os_dds_fill_iio_buffer(struct no_os_dds_desc **desc,
+			      struct iio_buffer *buffer);
+#endif
+
+/* Free the resources allocated by no_os_dds_init(). */
+int no_os_dds_remove(struct no_os_dds_desc *desc);
+
+#endif // _NO_OS_DDS_H_
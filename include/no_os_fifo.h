@@ -34,6 +34,7 @@
 #define _NO_OS_FIFO_H_
 
 #include <stdint.h>
+#include <stdbool.h>
 
 /**
  * @struct no_os_fifo_element
@@ -48,6 +49,76 @@ struct no_os_fifo_element {
 	uint32_t len;
 };
 
+/**
+ * @struct no_os_fifo
+ * @brief Byte FIFO backed by a preallocated ring.
+ *
+ * Indexes are free running and wrapped with a mask, so the storage size must
+ * be a power of two. One producer (typically an interrupt handler) and one
+ * consumer may use the FIFO concurrently without locking.
+ */
+struct no_os_fifo {
+	/** Ring storage */
+	uint8_t			*buff;
+	/** Storage size in bytes (power of two) */
+	uint32_t		size;
+	/** Write index, updated only by the producer */
+	volatile uint32_t	head;
+	/** Read index, updated only by the consumer */
+	volatile uint32_t	tail;
+	/** Number of writes that did not fit entirely */
+	volatile uint32_t	overflows;
+	/** Number of bytes dropped because the FIFO was full */
+	volatile uint32_t	dropped;
+	/** Set if buff was allocated by no_os_fifo_ring_init() */
+	bool			own_buff;
+};
+
+/* Allocate a ring-backed fifo of the given size. */
+int no_os_fifo_ring_init(struct no_os_fifo **fifo, uint32_t size);
+
+/* Configure a ring-backed fifo over caller provided storage. */
+int no_os_fifo_ring_cfg(struct no_os_fifo *fifo, uint8_t *buff, uint32_t size);
+
+/* Free the resources allocated by no_os_fifo_ring_init(). */
+int no_os_fifo_ring_remove(struct no_os_fifo *fifo);
+
+/* Append data to the fifo, return the number of bytes stored. */
+uint32_t no_os_fifo_ring_write(struct no_os_fifo *fifo, const uint8_t *data,
+			       uint32_t len);
+
+/* Drain up to len bytes, return the number of bytes copied. */
+uint32_t no_os_fifo_ring_read(struct no_os_fifo *fifo, uint8_t *data,
+			      uint32_t len);
+
+/* Discard all data currently in the fifo. */
+void no_os_fifo_ring_flush(struct no_os_fifo *fifo);
+
+/**
+ * @brief Get the number of bytes available for reading.
+ * @param fifo - Ring-backed fifo.
+ * @return Number of bytes stored in the fifo.
+ */
+static inline uint32_t no_os_fifo_ring_level(struct no_os_fifo *fifo)
+{
+	return fifo->head - fifo->tail;
+}
+
+/**
+ * @brief Get the number of bytes that can be written without overflow.
+ * @param fifo - Ring-backed fifo.
+ * @return Free space in bytes.
+ */
+static inline uint32_t no_os_fifo_ring_space(struct no_os_fifo *fifo)
+{
+	return fifo->size - no_os_fifo_ring_level(fifo);
+}
+
+/*
+ * Linked-list fifo. Every insert allocates a new element and walks the list,
+ * prefer the ring-backed fifo above for new code.
+ */
+
 /* Insert element to fifo tail. */
 int32_t no_os_fifo_insert(struct no_os_fifo_element **p_fifo, char *buff,
 			  uint32_t len);
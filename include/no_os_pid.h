@@ -70,10 +70,30 @@ struct no_os_pid_config {
 
 struct no_os_pid;
 
+/**
+ * @struct no_os_pid_bank
+ * @brief Bank of independent PID controllers updated together.
+ *
+ * State is kept as one array per field (structure of arrays) so the update
+ * runs on several controllers at once with SSE2 or NEON when available.
+ * Results are bit-exact with no_os_pid_control().
+ */
+struct no_os_pid_bank;
+
 int no_os_pid_init(struct no_os_pid **pid, struct no_os_pid_config config);
 int no_os_pid_control(struct no_os_pid *pid, int SP, int PV, int *output);
 int no_os_pid_hysteresis(struct no_os_pid *pid, unsigned int hyst);
 int no_os_pid_reset(struct no_os_pid *pid);
 int no_os_pid_remove(struct no_os_pid *pid);
 
+int no_os_pid_bank_init(struct no_os_pid_bank **bank,
+			const struct no_os_pid_config *config,
+			unsigned int nb_pids);
+int no_os_pid_bank_control(struct no_os_pid_bank *bank, const int *SP,
+			   const int *PV, int *output);
+int no_os_pid_bank_hysteresis(struct no_os_pid_bank *bank, unsigned int idx,
+			      unsigned int hyst);
+int no_os_pid_bank_reset(struct no_os_pid_bank *bank);
+int no_os_pid_bank_remove(struct no_os_pid_bank *bank);
+
 #endif
@@ -57,74 +57,97 @@
 #define pr_time			;
 #endif
 
-#if defined(NO_OS_LOG_LEVEL) && NO_OS_LOG_LEVEL >= NO_OS_LOG_EMERG && NO_OS_LOG_LEVEL <= NO_OS_LOG_DEBUG
-#define pr_emerg(fmt, args...) do {							\
-	pr_time										\
-	printf("EMERG: %s:%d:%s(): " fmt, __FILE__, __LINE__, __func__, ##args);	\
+#if defined(NO_OS_LOG_DEFERRED)
+/*
+ * Deferred logging: only the format string id and the raw arguments are
+ * recorded, formatting happens later in no_os_log_process() or on the host
+ * (tools/scripts/no_os_log_decode.py). The format must be a string literal,
+ * it is placed in the no_os_log_fmt section which is extracted at build time.
+ */
+#include <stdint.h>
+
+#define __no_os_log_str(x)	#x
+#define no_os_log_str(x)	__no_os_log_str(x)
+
+#define pr_deferred(level, fmt, args...) do {				\
+	static const char _no_os_log_fmt[]				\
+	__attribute__((section("no_os_log_fmt"), used)) = fmt;		\
+	no_os_log_record(level, _no_os_log_fmt, ##args);		\
 } while (0)
+
+#define pr_log_loc(level, tag, fmt, args...)				\
+	pr_deferred(level, tag __FILE__ ":" no_os_log_str(__LINE__) ": " fmt, ##args)
+#define pr_log(level, tag, fmt, args...)				\
+	pr_deferred(level, tag fmt, ##args)
+
+/* Record a log message in the deferred log ring. */
+void no_os_log_record(uint8_t level, const char *fmt, ...)
+__attribute__((format(printf, 2, 3)));
+
+/* Copy complete binary records out of the ring, for host side decoding. */
+uint32_t no_os_log_read(uint32_t *words, uint32_t max_words);
+
+/* Format and print one pending record, return 0 if the ring was empty. */
+int no_os_log_process(void);
+
+/* Number of messages lost because the ring was full. */
+uint32_t no_os_log_dropped(void);
+#else
+#define pr_log_loc(level, tag, fmt, args...) do {				\
+	pr_time									\
+	printf(tag "%s:%d:%s(): " fmt, __FILE__, __LINE__, __func__, ##args);	\
+} while (0)
+
+#define pr_log(level, tag, fmt, args...) do {	\
+	pr_time					\
+	printf(tag fmt, ##args);		\
+} while (0)
+#endif
+
+#if defined(NO_OS_LOG_LEVEL) && NO_OS_LOG_LEVEL >= NO_OS_LOG_EMERG && NO_OS_LOG_LEVEL <= NO_OS_LOG_DEBUG
+#define pr_emerg(fmt, args...) pr_log_loc(NO_OS_LOG_EMERG, "EMERG: ", fmt, ##args)
 #else
 #define pr_emerg(fmt, args...)
 #endif
 
 #if defined(NO_OS_LOG_LEVEL) && NO_OS_LOG_LEVEL >= NO_OS_LOG_ALERT && NO_OS_LOG_LEVEL <= NO_OS_LOG_DEBUG
-#define pr_alert(fmt, args...) do {							\
-	pr_time										\
-	printf("ALERT: %s:%d:%s(): " fmt, __FILE__, __LINE__, __func__, ##args);	\
-} while (0)
+#define pr_alert(fmt, args...) pr_log_loc(NO_OS_LOG_ALERT, "ALERT: ", fmt, ##args)
 #else
 #define pr_alert(fmt, args...)
 #endif
 
 #if defined(NO_OS_LOG_LEVEL) && NO_OS_LOG_LEVEL >= NO_OS_LOG_CRIT && NO_OS_LOG_LEVEL <= NO_OS_LOG_DEBUG
-#define pr_crit(fmt, args...) do { 						\
-	pr_time									\
-	printf("CRIT: %s:%d:%s(): " fmt, __FILE__, __LINE__, __func__, ##args);	\
-} while (0)
+#define pr_crit(fmt, args...) pr_log_loc(NO_OS_LOG_CRIT, "CRIT: ", fmt, ##args)
 #else
 #define pr_crit(fmt, args...)
 #endif
 
 #if defined(NO_OS_LOG_LEVEL) && NO_OS_LOG_LEVEL >= NO_OS_LOG_ERR && NO_OS_LOG_LEVEL <= NO_OS_LOG_DEBUG
-#define pr_err(fmt, args...) do {						\
-	pr_time									\
-	printf("ERR: %s:%d:%s(): " fmt, __FILE__, __LINE__, __func__, ##args);	\
-} while (0)
+#define pr_err(fmt, args...) pr_log_loc(NO_OS_LOG_ERR, "ERR: ", fmt, ##args)
 #else
 #define pr_err(fmt, args...)
 #endif
 
 #if defined(NO_OS_LOG_LEVEL) && NO_OS_LOG_LEVEL >= NO_OS_LOG_WARNING && NO_OS_LOG_LEVEL <= NO_OS_LOG_DEBUG
-#define pr_warning(fmt, args...) do {		\
-	pr_time					\
-	printf("WARNING: " fmt, ##args);	\
-} while (0)
+#define pr_warning(fmt, args...) pr_log(NO_OS_LOG_WARNING, "WARNING: ", fmt, ##args)
 #else
 #define pr_warning(fmt, args...)
 #endif
 
 #if defined(NO_OS_LOG_LEVEL) && NO_OS_LOG_LEVEL >= NO_OS_LOG_NOTICE && NO_OS_LOG_LEVEL <= NO_OS_LOG_DEBUG
-#define pr_notice(fmt, args...) do {	\
-	pr_time				\
-	printf("NOTICE: " fmt, ##args);	\
-} while (0)
+#define pr_notice(fmt, args...) pr_log(NO_OS_LOG_NOTICE, "NOTICE: ", fmt, ##args)
 #else
 #define pr_notice(fmt, args...)
 #endif
 
 #if defined(NO_OS_LOG_LEVEL) && NO_OS_LOG_LEVEL >= NO_OS_LOG_INFO && NO_OS_LOG_LEVEL <= NO_OS_LOG_DEBUG
-#define pr_info(fmt, args...) do {	\
-	pr_time 			\
-	printf(fmt, ##args);		\
-} while(0)
+#define pr_info(fmt, args...) pr_log(NO_OS_LOG_INFO, "", fmt, ##args)
 #else
 #define pr_info(fmt, args...)
 #endif
 
 #if defined(NO_OS_LOG_LEVEL) && NO_OS_LOG_LEVEL == NO_OS_LOG_DEBUG
-#define pr_debug(fmt, args...) do {	\
-	pr_time				\
-	printf("DEBUG: " fmt, ##args);	\
-} while(0)
+#define pr_debug(fmt, args...) pr_log(NO_OS_LOG_DEBUG, "DEBUG: ", fmt, ##args)
 #else
 #define pr_debug(fmt, args...)
 #endif
@@ -0,0 +1,124 @@
+/***************************************************************************//**
+ *   @file   no_os_prof.h
+ *   @brief  Bring-up latency profiler.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#ifndef _NO_OS_PROF_H_
+#define _NO_OS_PROF_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @enum no_os_prof_event
+ * @brief Kind of time accounted by the profiler.
+ */
+enum no_os_prof_event {
+	/** no_os_mdelay()/no_os_udelay() */
+	NO_OS_PROF_DELAY,
+	/** Repeated reads of the same register, delays in between included */
+	NO_OS_PROF_POLL,
+	/** no_os_spi_write_and_read()/no_os_spi_transfer() */
+	NO_OS_PROF_SPI,
+	/** Single AXI register accesses */
+	NO_OS_PROF_AXI,
+	NO_OS_PROF_EVENT_MAX
+};
+
+/**
+ * @struct no_os_prof_stat
+ * @brief Accumulated cost of one kind of event, or of one call site.
+ */
+struct no_os_prof_stat {
+	/** Caller of the instrumented function, NULL for a total */
+	const void *site;
+	/** Kind of event */
+	enum no_os_prof_event event;
+	/** Number of events */
+	uint32_t count;
+	/** Bytes transferred (SPI) */
+	uint64_t bytes;
+	/** Time spent */
+	uint64_t time_us;
+	/** Register polled (POLL) */
+	uint32_t base;
+	uint32_t offset;
+};
+
+#if defined(NO_OS_PROF)
+/*
+ * Bring-up profiler, enabled with NO_OS_PROF=y. The platform delay, SPI and
+ * AXI IO layers account their time against the caller of the instrumented
+ * function, so the report points at the driver code spending it. Sites are
+ * printed as return addresses, use addr2line -f -e <binary> to resolve them.
+ */
+#define NO_OS_PROF_SITE		__builtin_return_address(0)
+
+/* Current time, start of an event */
+uint64_t no_os_prof_start(void);
+
+/* Account an event that started at start_us */
+void no_os_prof_record(enum no_os_prof_event event, const void *site,
+		       uint64_t start_us, uint32_t bytes);
+
+/* Account a register access, detecting polling loops */
+void no_os_prof_axi(const void *site, uint64_t start_us, uint32_t base,
+		    uint32_t offset, bool write);
+
+/* Get the total of an event kind */
+void no_os_prof_get(enum no_os_prof_event event,
+		    struct no_os_prof_stat *stat);
+
+/* Get the most expensive call sites */
+uint32_t no_os_prof_top(struct no_os_prof_stat *stats, uint32_t max);
+
+/* Print the totals and the most expensive call sites */
+void no_os_prof_report(uint32_t max_sites);
+
+/* Clear all counters */
+void no_os_prof_reset(void);
+#else
+#define NO_OS_PROF_SITE		((const void *)0)
+
+static inline uint64_t no_os_prof_start(void)
+{
+	return 0;
+}
+
+static inline void no_os_prof_record(enum no_os_prof_event event,
+				     const void *site, uint64_t start_us,
+				     uint32_t bytes) {}
+
+static inline void no_os_prof_axi(const void *site, uint64_t start_us,
+				  uint32_t base, uint32_t offset, bool write) {}
+#endif
+
+#endif // _NO_OS_PROF_H_
@@ -0,0 +1,57 @@
+/***************************************************************************//**
+ *   @file   no_os_thread.h
+ *   @brief  Header file of no-OS thread functionality.
+ *   @author Analog Devices Inc.
+********************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef _NO_OS_THREAD_H_
+#define _NO_OS_THREAD_H_
+
+/**
+ * @brief Function for starting a thread.
+ * This function is implemented based on the platforms/OS libraries that
+ * NO-OS supports. The default implementation, used on platforms without
+ * threads, runs the function to completion before returning, so callers
+ * work the same way with or without an OS, only without the concurrency.
+ * @param thread - Location where the thread handle will be stored.
+ * @param func - Thread function.
+ * @param arg - Argument passed to the thread function.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_thread_create(void **thread, void (*func)(void *arg), void *arg);
+
+/**
+ * @brief Function for waiting for a thread to end and releasing it.
+ * @param thread - Thread handle returned by no_os_thread_create().
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_thread_join(void *thread);
+
+#endif // _NO_OS_THREAD_H_
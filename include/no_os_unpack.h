@@ -0,0 +1,62 @@
+/***************************************************************************//**
+ *   @file   no_os_unpack.h
+ *   @brief  Unpacking of packed ADC sample words.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#ifndef _NO_OS_UNPACK_H_
+#define _NO_OS_UNPACK_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @struct no_os_unpack_fmt
+ * @brief Layout of a packed ADC word: a sample of bits bits, MSB first,
+ * followed by status_bits status bits. The word is at most 32 bits.
+ */
+struct no_os_unpack_fmt {
+	/** Sample width */
+	uint8_t bits;
+	/** Status bits after the sample, 0 if none */
+	uint8_t status_bits;
+	/** Sign-extend the sample */
+	bool sign;
+};
+
+/* Unpack words packed back to back, MSB first */
+int no_os_unpack(const struct no_os_unpack_fmt *fmt, const uint8_t *src,
+		 uint32_t nb, int32_t *dst, uint32_t *status);
+
+/* Unpack words already right aligned in 32-bit containers */
+int no_os_unpack32(const struct no_os_unpack_fmt *fmt, const uint32_t *src,
+		   uint32_t nb, int32_t *dst, uint32_t *status);
+
+#endif /* _NO_OS_UNPACK_H_ */
@@ -115,7 +115,7 @@ int jesd204_topology_init(struct jesd204_topology **topology,
 
 	for (i = 0; i < devs_number; i++) {
 		if (devs[i].is_sysref_provider)
-			top->dev_top->jdev_sysref = top->devs[i].jdev;
+			top->dev_top->jdev_sysref = devs[i].jdev;
 	}
 
 	*topology = top;
@@ -129,7 +129,9 @@ int jesd204_topology_remove(struct jesd204_topology *topology)
 	if (!topology)
 		return -EINVAL;
 
+	no_os_free(topology->dev_top->active_links);
 	no_os_free(topology->dev_top);
+	no_os_free(topology->devs);
 	no_os_free(topology);
 
 	return 0;
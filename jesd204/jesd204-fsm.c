@@ -5,20 +5,413 @@
  */
 
 #include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "no_os_delay.h"
+#include "no_os_print_log.h"
+#include "no_os_thread.h"
 #include "jesd204-priv.h"
 
+/* no-OS specific */
+static const char *const jesd204_op_names[__JESD204_MAX_OPS] = {
+	[JESD204_OP_DEVICE_INIT] = "device_init",
+	[JESD204_OP_LINK_INIT] = "link_init",
+	[JESD204_OP_LINK_SUPPORTED] = "link_supported",
+	[JESD204_OP_LINK_PRE_SETUP] = "link_pre_setup",
+	[JESD204_OP_CLK_SYNC_STAGE1] = "clk_sync_stage1",
+	[JESD204_OP_CLK_SYNC_STAGE2] = "clk_sync_stage2",
+	[JESD204_OP_CLK_SYNC_STAGE3] = "clk_sync_stage3",
+	[JESD204_OP_LINK_SETUP] = "link_setup",
+	[JESD204_OP_OPT_SETUP_STAGE1] = "opt_setup_stage1",
+	[JESD204_OP_OPT_SETUP_STAGE2] = "opt_setup_stage2",
+	[JESD204_OP_OPT_SETUP_STAGE3] = "opt_setup_stage3",
+	[JESD204_OP_OPT_SETUP_STAGE4] = "opt_setup_stage4",
+	[JESD204_OP_OPT_SETUP_STAGE5] = "opt_setup_stage5",
+	[JESD204_OP_CLOCKS_ENABLE] = "clocks_enable",
+	[JESD204_OP_LINK_ENABLE] = "link_enable",
+	[JESD204_OP_LINK_RUNNING] = "link_running",
+	[JESD204_OP_OPT_POST_RUNNING_STAGE] = "opt_post_running_stage",
+};
+
+/* no-OS specific */
+struct jesd204_fsm_job {
+	struct jesd204_topology_dev	*tdev;
+	enum jesd204_dev_op		op;
+	unsigned int			level;
+	int				ret;
+};
+
+/* no-OS specific */
+struct jesd204_fsm_worker {
+	struct jesd204_dev_top		*jdev_top;
+	struct jesd204_fsm_job		*jobs;
+	unsigned int			nb_jobs;
+	unsigned int			first;
+	unsigned int			stride;
+	unsigned int			level;
+};
+
+static uint32_t jesd204_fsm_elapsed_us(struct no_os_time start)
+{
+	struct no_os_time now = no_os_get_time();
+
+	return (now.s - start.s) * 1000000 + now.us - start.us;
+}
+
+static void jesd204_fsm_report(struct jesd204_topology *topology)
+{
+	int op;
+
+	for (op = 0; op < __JESD204_MAX_OPS; op++) {
+		if (!topology->op_time_us[op])
+			continue;
+		pr_debug("jesd204: %s took %u us\n", jesd204_op_names[op],
+			 (unsigned int)topology->op_time_us[op]);
+	}
+}
+
+/* Run the per_device and per_link callbacks of a device for one state. */
+static int jesd204_fsm_dev_op(struct jesd204_dev_top *jdev_top,
+			      struct jesd204_topology_dev *tdev,
+			      enum jesd204_dev_op op)
+{
+	const struct jesd204_state_op *state_op =
+			&tdev->jdev->dev_data->state_ops[op];
+	enum jesd204_state_op_reason reason = JESD204_STATE_OP_REASON_INIT;
+	bool per_device_op_done = false;
+	unsigned int lnk_dev;
+	unsigned int lnk_id;
+	int ret;
+
+	for (lnk_id = 0; lnk_id < jdev_top->num_links; lnk_id++) {
+		for (lnk_dev = 0; lnk_dev < tdev->links_number; lnk_dev++) {
+			if (tdev->link_ids[lnk_dev] != jdev_top->link_ids[lnk_id])
+				continue;
+
+			if (state_op->per_device && !per_device_op_done) {
+				ret = state_op->per_device(tdev->jdev, reason);
+				if (ret < 0)
+					return ret;
+				per_device_op_done = true;
+			}
+			if (state_op->per_link) {
+				ret = state_op->per_link(tdev->jdev, reason,
+							 &jdev_top->active_links[lnk_id].link);
+				if (ret < 0)
+					return ret;
+			}
+		}
+	}
+
+	return 0;
+}
+
+/* Run the callbacks of the top device for one state, with SYSREF if needed. */
+static int jesd204_fsm_top_op(struct jesd204_dev_top *jdev_top,
+			      enum jesd204_dev_op op)
+{
+	const struct jesd204_state_op *state_op =
+			&jdev_top->jdev->dev_data->state_ops[op];
+	enum jesd204_state_op_reason reason = JESD204_STATE_OP_REASON_INIT;
+	unsigned int lnk_id;
+	int ret;
+
+	if (state_op->per_link) {
+		for (lnk_id = 0; lnk_id < jdev_top->num_links; lnk_id++) {
+			ret = state_op->per_link(jdev_top->jdev, reason,
+						 &jdev_top->active_links[lnk_id].link);
+			if (ret < 0)
+				return ret;
+			if (state_op->post_state_sysref)
+				jesd204_sysref_async(jdev_top->jdev);
+		}
+	}
+
+	if (state_op->per_device) {
+		ret = state_op->per_device(jdev_top->jdev, reason);
+		if (ret < 0)
+			return ret;
+		if (state_op->post_state_sysref)
+			jesd204_sysref_async(jdev_top->jdev);
+	}
+
+	return 0;
+}
+
+static void jesd204_fsm_worker_run(void *arg)
+{
+	struct jesd204_fsm_worker *w = arg;
+	unsigned int i, n = 0;
+
+	for (i = 0; i < w->nb_jobs; i++) {
+		if (w->jobs[i].level != w->level)
+			continue;
+		if (n++ % w->stride != w->first)
+			continue;
+		w->jobs[i].ret = jesd204_fsm_dev_op(w->jdev_top, w->jobs[i].tdev,
+						    w->jobs[i].op);
+	}
+}
+
+/*
+ * Run the jobs of one dependency level, spread over up to max_workers
+ * threads. The calling thread acts as the first worker.
+ */
+static int jesd204_fsm_run_level(struct jesd204_topology *topology,
+				 struct jesd204_fsm_job *jobs,
+				 unsigned int nb_jobs, unsigned int level)
+{
+	struct jesd204_fsm_worker *workers;
+	void **threads;
+	unsigned int nb_workers = 0;
+	unsigned int started;
+	unsigned int i;
+	int ret = 0;
+
+	for (i = 0; i < nb_jobs; i++)
+		if (jobs[i].level == level)
+			nb_workers++;
+
+	if (nb_workers > topology->max_workers)
+		nb_workers = topology->max_workers;
+	if (!nb_workers)
+		return 0;
+
+	workers = no_os_calloc(nb_workers, sizeof(*workers));
+	threads = no_os_calloc(nb_workers, sizeof(*threads));
+	if (!workers || !threads) {
+		ret = -ENOMEM;
+		goto free;
+	}
+
+	for (i = 0; i < nb_workers; i++) {
+		workers[i].jdev_top = topology->dev_top;
+		workers[i].jobs = jobs;
+		workers[i].nb_jobs = nb_jobs;
+		workers[i].first = i;
+		workers[i].stride = nb_workers;
+		workers[i].level = level;
+	}
+
+	for (started = 1; started < nb_workers; started++) {
+		ret = no_os_thread_create(&threads[started],
+					  jesd204_fsm_worker_run,
+					  &workers[started]);
+		if (ret)
+			break;
+	}
+
+	/* Jobs of workers that could not be started run here */
+	jesd204_fsm_worker_run(&workers[0]);
+	for (i = started; i < nb_workers; i++)
+		jesd204_fsm_worker_run(&workers[i]);
+
+	for (i = 1; i < started; i++)
+		no_os_thread_join(threads[i]);
+
+	ret = 0;
+	for (i = 0; i < nb_jobs; i++) {
+		if (jobs[i].level == level && jobs[i].ret < 0) {
+			pr_err("jesd204: %s failed (%d)\n",
+			       jesd204_op_names[jobs[i].op], jobs[i].ret);
+			ret = jobs[i].ret;
+			break;
+		}
+	}
+
+free:
+	no_os_free(threads);
+	no_os_free(workers);
+
+	return ret;
+}
+
+/* Index of a device in the topology, -1 for the top device or unknown ones. */
+static int jesd204_fsm_dev_index(struct jesd204_topology *topology,
+				 struct jesd204_dev *jdev)
+{
+	unsigned int i;
+
+	for (i = 0; i < topology->devs_number; i++)
+		if (topology->devs[i].jdev == jdev)
+			return i;
+
+	return -1;
+}
+
+static bool jesd204_fsm_dev_on_top_links(struct jesd204_dev_top *jdev_top,
+		struct jesd204_topology_dev *tdev)
+{
+	unsigned int lnk_dev;
+	unsigned int lnk_id;
+
+	for (lnk_id = 0; lnk_id < jdev_top->num_links; lnk_id++)
+		for (lnk_dev = 0; lnk_dev < tdev->links_number; lnk_dev++)
+			if (tdev->link_ids[lnk_dev] == jdev_top->link_ids[lnk_id])
+				return true;
+
+	return false;
+}
+
+/*
+ * Parallel execution of the state ops.
+ *
+ * Within a state, a device waits only for its inputs, so independent devices
+ * (several converters or transceivers) run concurrently. A device enters the
+ * next state as soon as it is done with the current one, unless the top
+ * device has callbacks for that state: those run, followed by the SYSREF
+ * when requested, once every device is done, which makes the state a barrier.
+ *
+ * The order of the callbacks differs from the sequential walk. There, each
+ * link is done in turn for a state: the per_link callbacks of every device,
+ * then the one of the top device. Here a device runs its callbacks for all
+ * its links in one go, and the top device runs its callbacks for all links
+ * after every device is done with the state.
+ */
+static int jesd204_fsm_start_parallel(struct jesd204_topology *topology)
+{
+	struct jesd204_dev_top *jdev_top = topology->dev_top;
+	const struct jesd204_state_op *state_op;
+	struct jesd204_topology_dev *tdev;
+	struct jesd204_fsm_job *jobs;
+	struct no_os_time start;
+	unsigned int nb_devs = topology->devs_number;
+	unsigned int *level, *prev_level;
+	unsigned int max_level = 0;
+	unsigned int nb_jobs = 0;
+	unsigned int i, l, pass;
+	uint32_t elapsed;
+	bool seg_start = true;
+	bool ops_run[__JESD204_MAX_OPS];
+	bool changed;
+	int in, op;
+	int ret = 0;
+
+	jobs = no_os_calloc(nb_devs * __JESD204_MAX_OPS + 1, sizeof(*jobs));
+	level = no_os_calloc(2 * nb_devs + 1, sizeof(*level));
+	if (!jobs || !level) {
+		ret = -ENOMEM;
+		goto free;
+	}
+	prev_level = level + nb_devs;
+
+	for (op = 0; op < __JESD204_MAX_OPS; op++) {
+		/* Order the devices for this state */
+		for (i = 0; i < nb_devs; i++)
+			level[i] = seg_start ? 0 : prev_level[i] + 1;
+
+		for (pass = 0, changed = true; changed && pass <= nb_devs; pass++) {
+			changed = false;
+			for (i = 0; i < nb_devs; i++) {
+				tdev = &topology->devs[i];
+				for (l = 0; l < tdev->inputs_number; l++) {
+					in = jesd204_fsm_dev_index(topology,
+								   tdev->inputs[l]);
+					if (in < 0 || level[in] + 1 <= level[i])
+						continue;
+					level[i] = level[in] + 1;
+					changed = true;
+				}
+			}
+		}
+		if (changed) {
+			pr_err("jesd204: dependency loop between devices\n");
+			ret = -EINVAL;
+			goto free;
+		}
+
+		for (i = 0; i < nb_devs; i++) {
+			tdev = &topology->devs[i];
+			prev_level[i] = level[i];
+			state_op = &tdev->jdev->dev_data->state_ops[op];
+			if (!state_op->per_device && !state_op->per_link)
+				continue;
+			if (!jesd204_fsm_dev_on_top_links(jdev_top, tdev))
+				continue;
+
+			jobs[nb_jobs].tdev = tdev;
+			jobs[nb_jobs].op = op;
+			jobs[nb_jobs].level = level[i];
+			nb_jobs++;
+			if (level[i] > max_level)
+				max_level = level[i];
+		}
+		seg_start = false;
+
+		state_op = &jdev_top->jdev->dev_data->state_ops[op];
+		if (!state_op->per_device && !state_op->per_link &&
+		    op != __JESD204_MAX_OPS - 1)
+			continue;
+
+		/* Barrier: run everything queued so far, then the top device */
+		for (l = 0; l <= max_level && nb_jobs; l++) {
+			for (i = 0; i < __JESD204_MAX_OPS; i++)
+				ops_run[i] = false;
+			for (i = 0; i < nb_jobs; i++)
+				if (jobs[i].level == l)
+					ops_run[jobs[i].op] = true;
+
+			start = no_os_get_time();
+			ret = jesd204_fsm_run_level(topology, jobs, nb_jobs, l);
+			if (ret)
+				goto free;
+			elapsed = jesd204_fsm_elapsed_us(start);
+
+			for (i = 0; i < __JESD204_MAX_OPS; i++)
+				if (ops_run[i])
+					topology->op_time_us[i] += elapsed;
+		}
+
+		start = no_os_get_time();
+		ret = jesd204_fsm_top_op(jdev_top, op);
+		if (ret) {
+			pr_err("jesd204: %s failed (%d)\n", jesd204_op_names[op],
+			       ret);
+			goto free;
+		}
+		topology->op_time_us[op] += jesd204_fsm_elapsed_us(start);
+
+		nb_jobs = 0;
+		max_level = 0;
+		seg_start = true;
+	}
+
+free:
+	no_os_free(level);
+	no_os_free(jobs);
+
+	return ret;
+}
+
 /* no-OS specific */
 int jesd204_fsm_start(struct jesd204_topology *topology, unsigned int link_idx)
 {
 	enum jesd204_state_op_reason reason = JESD204_STATE_OP_REASON_INIT;
 	struct jesd204_dev_top *jdev_top = topology->dev_top;
-	bool per_device_op_done[16];
+	struct no_os_time start;
+	bool *per_device_op_done;
 	enum jesd204_dev_op op;
 	int lnk_dev;
 	int lnk_id;
 	int dev;
+	int ret;
+
+	for (op = 0; op < __JESD204_MAX_OPS; op++)
+		topology->op_time_us[op] = 0;
+
+	if (topology->max_workers) {
+		ret = jesd204_fsm_start_parallel(topology);
+		jesd204_fsm_report(topology);
+		return ret;
+	}
+
+	per_device_op_done = no_os_calloc(topology->devs_number + 1,
+					  sizeof(*per_device_op_done));
+	if (!per_device_op_done)
+		return -ENOMEM;
 
 	for (op = 0; op < __JESD204_MAX_OPS; op++) {
+		start = no_os_get_time();
+
 		for (dev = 0; dev < topology->devs_number; dev++)
 			per_device_op_done[dev] = false;
 
@@ -51,8 +444,13 @@ int jesd204_fsm_start(struct jesd204_topology *topology, unsigned int link_idx)
 			if (jdev_top->jdev->dev_data->state_ops[op].post_state_sysref)
 				jesd204_sysref_async(jdev_top->jdev);
 		}
+
+		topology->op_time_us[op] = jesd204_fsm_elapsed_us(start);
 	}
 
+	no_os_free(per_device_op_done);
+	jesd204_fsm_report(topology);
+
 	return 0;
 }
 
@@ -61,12 +459,17 @@ int jesd204_fsm_stop(struct jesd204_topology *topology, unsigned int link_idx)
 {
 	enum jesd204_state_op_reason reason = JESD204_STATE_OP_REASON_UNINIT;
 	struct jesd204_dev_top *jdev_top = topology->dev_top;
-	bool per_device_op_done[16];
+	bool *per_device_op_done;
 	int lnk_dev;
 	int lnk_id;
 	int dev;
 	int op;
 
+	per_device_op_done = no_os_calloc(topology->devs_number + 1,
+					  sizeof(*per_device_op_done));
+	if (!per_device_op_done)
+		return -ENOMEM;
+
 	for (op = __JESD204_MAX_OPS - 1; op >= 0; op--) {
 		for (dev = topology->devs_number - 1; dev >= 0 ; dev--)
 			per_device_op_done[dev] = false;
@@ -97,5 +500,7 @@ int jesd204_fsm_stop(struct jesd204_topology *topology, unsigned int link_idx)
 		}
 	}
 
+	no_os_free(per_device_op_done);
+
 	return 0;
 }
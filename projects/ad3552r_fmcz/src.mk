@@ -5,6 +5,7 @@ SRCS += $(NO-OS)/util/no_os_util.c \
         $(NO-OS)/util/no_os_alloc.c \
         $(NO-OS)/util/no_os_mutex.c \
         $(NO-OS)/util/no_os_sin_lut.c \
+        $(NO-OS)/util/no_os_dds.c \
         $(NO-OS)/util/no_os_crc8.c \
 	$(DRIVERS)/api/no_os_spi.c \
         $(DRIVERS)/api/no_os_gpio.c \
@@ -21,6 +22,7 @@ INCS += $(INCLUDE)/no_os_timer.h \
 	$(INCLUDE)/no_os_delay.h \
 	$(INCLUDE)/no_os_error.h \
 	$(INCLUDE)/no_os_crc8.h \
+	$(INCLUDE)/no_os_dds.h \
 	$(INCLUDE)/no_os_print_log.h \
 	$(INCLUDE)/no_os_spi.h \
 	$(INCLUDE)/no_os_util.h \
@@ -39,6 +39,7 @@
 #include "no_os_gpio.h"
 #include "no_os_util.h"
 #include "no_os_delay.h"
+#include "no_os_dds.h"
 #include "xilinx_spi.h"
 #include "xilinx_gpio.h"
 #include "ad3552r.h"
@@ -134,34 +135,59 @@ void set_power_up_success_led()
 	no_os_gpio_remove(gpio);
 }
 
-extern const uint16_t no_os_sine_lut_16[512];
+/* Scans generated at once by the DDS */
+#define EXAMPLE_BLOCK_SCANS	32
 
 int32_t run_example(struct ad3552r_desc *dac)
 {
 	const uint32_t time_between_samples_us = 100;
-	uint32_t nb_samples, i;
-	uint16_t samples[2];
+	struct no_os_dds_init_param dds_param = {
+		.sample_rate = 1000000 / time_between_samples_us,
+		.format = NO_OS_DDS_OFFSET_BINARY,
+	};
+	struct no_os_dds_desc *dds[2] = {NULL, NULL};
+	uint16_t samples[2 * EXAMPLE_BLOCK_SCANS];
+	uint32_t freq, i;
 	int32_t err;
 
-	nb_samples = NO_OS_ARRAY_SIZE(no_os_sine_lut_16);
+	/* Close to one period every 512 samples, as with the plain table */
+	freq = dds_param.sample_rate / NO_OS_ARRAY_SIZE(no_os_sine_lut_16);
+
+	for (i = 0; i < 2; i++) {
+		err = no_os_dds_init(&dds[i], &dds_param);
+		if (err)
+			goto out;
 
-	pr_debug("sending syn wave, %ld samples per period\n", nb_samples * 2);
+		err = no_os_dds_set_tone(dds[i], 0, freq, NO_OS_DDS_FULL_SCALE,
+					 NO_OS_DDS_PHASE_DEG(180 * i));
+		if (err)
+			goto out;
+	}
+
+	pr_debug("sending sine wave, %"PRIu32" Hz\n", freq);
 
-	i = 0;
 	do {
-		samples[0] = no_os_sine_lut_16[i];
-		samples[1] = no_os_sine_lut_16[(i + nb_samples / 2) % nb_samples];
-		err = ad3552r_write_samples(dac, samples, 1,
-					    AD3552R_MASK_ALL_CH,
-					    AD3552R_WRITE_INPUT_REGS);
-		if (NO_OS_IS_ERR_VALUE(err))
-			return err;
+		no_os_dds_fill(dds[0], &samples[0], EXAMPLE_BLOCK_SCANS, 2);
+		no_os_dds_fill(dds[1], &samples[1], EXAMPLE_BLOCK_SCANS, 2);
+
+		for (i = 0; i < EXAMPLE_BLOCK_SCANS; i++) {
+			err = ad3552r_write_samples(dac, &samples[2 * i], 1,
+						    AD3552R_MASK_ALL_CH,
+						    AD3552R_WRITE_INPUT_REGS);
+			if (NO_OS_IS_ERR_VALUE(err))
+				goto out;
 
-		no_os_udelay(time_between_samples_us);
+			no_os_udelay(time_between_samples_us);
+
+			err = ad3552r_ldac_trigger(dac, AD3552R_MASK_ALL_CH, false);
+			if (NO_OS_IS_ERR_VALUE(err))
+				goto out;
+		}
+	} while (1);
 
-		i = (i + 1) % nb_samples;
-		err = ad3552r_ldac_trigger(dac, AD3552R_MASK_ALL_CH, false);
-	} while (!NO_OS_IS_ERR_VALUE(err));
+out:
+	no_os_dds_remove(dds[0]);
+	no_os_dds_remove(dds[1]);
 
 	return err;
 }
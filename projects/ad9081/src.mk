@@ -13,6 +13,7 @@ SRCS += $(PROJECT)/src/app.c \
 	$(PROJECT)/src/app_clock.c \
 	$(PROJECT)/src/app_jesd.c \
 	$(DRIVERS)/adc/ad9081/ad9081.c \
+	$(DRIVERS)/adc/ad9081/ad9081_nco.c \
 	$(DRIVERS)/adc/ad9081/api/adi_ad9081_adc.c \
 	$(DRIVERS)/adc/ad9081/api/adi_ad9081_dac.c \
 	$(DRIVERS)/adc/ad9081/api/adi_ad9081_device.c \
@@ -39,6 +40,7 @@ SRCS += $(PROJECT)/src/app.c \
 	$(NO-OS)/util/no_os_util.c \
 	$(NO-OS)/util/no_os_alloc.c \
 	$(NO-OS)/util/no_os_mutex.c \
+	$(NO-OS)/util/no_os_thread.c \
 	$(NO-OS)/jesd204/jesd204-core.c \
 	$(NO-OS)/jesd204/jesd204-fsm.c
 ifeq (y,$(strip $(QUAD_MXFE)))
@@ -61,6 +63,7 @@ INCS +=	$(PROJECT)/src/app_clock.h \
 	$(PROJECT)/src/parameters.h \
 	$(PROJECT)/profiles/$(PROFILE)/app_config.h \
 	$(DRIVERS)/adc/ad9081/ad9081.h \
+	$(DRIVERS)/adc/ad9081/ad9081_nco.h \
 	$(DRIVERS)/adc/ad9081/api/adi_ad9081_bf_ad9081.h \
 	$(DRIVERS)/adc/ad9081/api/adi_ad9081_bf_impala_tc.h \
 	$(DRIVERS)/adc/ad9081/api/adi_ad9081_bf_jrxa_des.h \
@@ -104,6 +107,7 @@ INCS +=	$(PROJECT)/src/app_clock.h \
 	$(INCLUDE)/no_os_mutex.h \
 	$(INCLUDE)/no_os_lf256fifo.h \
 	$(INCLUDE)/jesd204.h \
+	$(INCLUDE)/no_os_thread.h \
 	$(NO-OS)/jesd204/jesd204-priv.h
 ifeq (y,$(strip $(QUAD_MXFE)))
 INCS += $(DRIVERS)/frequency/adf4371/adf4371.h
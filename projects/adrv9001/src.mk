@@ -18,7 +18,9 @@ INCS += $(DRIVERS)/rf-transceiver/navassa/adrv9002.h \
 	$(PROJECT)/src/app/RxGainTable_GainCompensated.h \
 	$(PROJECT)/src/app/TxAttenTable.h \
 	$(PROJECT)/src/app/Navassa_CMOS_profile.h \
-	$(PROJECT)/src/app/Navassa_LVDS_profile.h
+	$(PROJECT)/src/app/Navassa_LVDS_profile.h \
+	$(PROJECT)/src/app/Navassa_CMOS_profile_init.h \
+	$(PROJECT)/src/app/Navassa_LVDS_profile_init.h
 # hal
 SRCS += $(PROJECT)/src/hal/no_os_platform.c
 INCS += $(PROJECT)/src/hal/parameters.h \
@@ -93,3 +95,7 @@ CFLAGS = -DADI_DYNAMIC_PROFILE_LOAD \
 ifeq (y,$(strip $(LVDS)))
 CFLAGS += -DLVDS
 endif
+
+ifeq (y,$(strip $(STATIC_PROFILE)))
+CFLAGS += -DSTATIC_PROFILE
+endif
@@ -42,6 +42,7 @@
 #include "no_os_error.h"
 #include "no_os_util.h"
 #include "no_os_spi.h"
+#include "no_os_delay.h"
 
 #include "axi_adc_core.h"
 #include "axi_dac_core.h"
@@ -61,11 +62,21 @@
 #include "adi_adrv9001_arm.h"
 #include "adi_adrv9001_radio.h"
 #include "adi_adrv9001_profileutil.h"
+#ifdef STATIC_PROFILE
+#ifdef LVDS
+#include "Navassa_LVDS_profile_init.h"
+#define static_profile	navassa_lvds_profile_init
+#else
+#include "Navassa_CMOS_profile_init.h"
+#define static_profile	navassa_cmos_profile_init
+#endif
+#else
 #ifdef LVDS
 #include "Navassa_LVDS_profile.h"
 #else
 #include "Navassa_CMOS_profile.h"
 #endif
+#endif
 
 /* ADC/DAC Buffers */
 #if defined(DMA_EXAMPLE) || defined(IIO_SUPPORT)
@@ -274,6 +285,7 @@ int main(void)
 	struct no_os_clk_init_param clk_init = { 0 };
 	struct adrv9002_chip_info chip = { 0 };
 	struct adrv9002_rf_phy phy = { 0 };
+	struct no_os_time start, end;
 	int ret;
 
 	struct axi_adc_init rx1_adc_init = {
@@ -374,8 +386,12 @@ int main(void)
 
 	adrv9002_init_par.chip = &chip;
 	adrv9002_init_par.agcConfig_init_param = &agc_defaults;
+#ifdef STATIC_PROFILE
+	adrv9002_init_par.profile_init = &static_profile;
+#else
 	adrv9002_init_par.profile = (char *)json_profile;
 	adrv9002_init_par.profile_length = strlen(json_profile);
+#endif
 	adrv9002_dev_init(&phy, &adrv9002_init_par);
 
 	/* Initialize the ADC/DAC cores */
@@ -405,11 +421,16 @@ int main(void)
 #endif
 
 	/* Post AXI DAC/ADC setup, digital interface tuning */
+	start = no_os_get_time();
 	ret = adrv9002_post_setup(&phy);
 	if (ret) {
 		printf("adrv9002_post_setup() failed with status %d\n", ret);
 		goto error;
 	}
+	end = no_os_get_time();
+	printf("ADRV9002 initialized in %u ms (%s profile)\n",
+	       (end.s - start.s) * 1000 + (end.us / 1000) - (start.us / 1000),
+	       phy.profile_init ? "precompiled" : "JSON");
 
 	/* Finalize the ADC/DAC cores initialization */
 	ret = axi_adc_init_finish(phy.rx1_adc);
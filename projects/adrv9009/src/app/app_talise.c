@@ -78,6 +78,23 @@ bool adrv9009_check_sysref_rate(uint32_t lmfc, uint32_t sysref)
 	return mod <= div || mod >= sysref - div;
 }
 
+/**
+ * @brief Print the time spent in an initialization phase and start the next.
+ * @param phase - Name of the phase that just completed, NULL to only start
+ *		  timing.
+ * @param start_us - Start timestamp of the phase, updated to the current time.
+ */
+static void talise_phase_done(const char *phase, uint64_t *start_us)
+{
+	struct no_os_time t = no_os_get_time();
+	uint64_t now_us = (uint64_t)t.s * 1000000 + t.us;
+
+	if (phase)
+		printf("talise: %-16s %8lu us\n", phase,
+		       (unsigned long)(now_us - *start_us));
+	*start_us = now_us;
+}
+
 adiHalErr_t talise_setup(taliseDevice_t * const pd, taliseInit_t * const pi)
 {
 	uint32_t talAction = TALACT_NO_ACTION;
@@ -112,11 +129,14 @@ adiHalErr_t talise_setup(taliseDevice_t * const pd, taliseInit_t * const pi)
 
 	uint32_t api_vers[4];
 	uint8_t rev;
+	uint64_t phase_us = 0;
 
 	/*******************************/
 	/**** Talise Initialization ***/
 	/*******************************/
 
+	talise_phase_done(NULL, &phase_us);
+
 	/*Open Talise Hw Device*/
 	talAction = TALISE_openHw(pd);
 	if (talAction != TALACT_NO_ACTION) {
@@ -132,6 +152,7 @@ adiHalErr_t talise_setup(taliseDevice_t * const pd, taliseInit_t * const pi)
 		printf("error: TALISE_resetDevice() failed\n");
 		goto error_11;
 	}
+	talise_phase_done("reset", &phase_us);
 
 	/* TALISE_initialize() loads the Talise device data structure
 	 * settings for the Rx/Tx/ORx profiles, FIR filters, digital
@@ -145,6 +166,7 @@ adiHalErr_t talise_setup(taliseDevice_t * const pd, taliseInit_t * const pi)
 		printf("error: TALISE_initialize() failed\n");
 		goto error_11;
 	}
+	talise_phase_done("initialize", &phase_us);
 
 	/*******************************/
 	/***** CLKPLL Status Check *****/
@@ -184,6 +206,7 @@ adiHalErr_t talise_setup(taliseDevice_t * const pd, taliseInit_t * const pi)
 		/*< user code - MCS failed - ensure MCS before proceeding*/
 		printf("warning: TALISE_enableMultichipSync() failed\n");
 	}
+	talise_phase_done("multichip sync", &phase_us);
 
 	/*******************************************************/
 	/**** Prepare Talise Arm binary and Load Arm and	****/
@@ -196,6 +219,7 @@ adiHalErr_t talise_setup(taliseDevice_t * const pd, taliseInit_t * const pi)
 			printf("error: TALISE_initArm() failed\n");
 			goto error_11;
 		}
+		talise_phase_done("ARM init", &phase_us);
 
 		/*< user code- load Talise stream binary into streamBinary[4096] >*/
 		/*< user code- load ARM binary byte array into armBinary[114688] >*/
@@ -206,6 +230,7 @@ adiHalErr_t talise_setup(taliseDevice_t * const pd, taliseInit_t * const pi)
 			printf("error: TALISE_loadStreamFromBinary() failed\n");
 			goto error_11;
 		}
+		talise_phase_done("stream load", &phase_us);
 
 		talAction = TALISE_loadArmFromBinary(pd, &armBinary[0], count);
 		if (talAction != TALACT_NO_ACTION) {
@@ -213,6 +238,7 @@ adiHalErr_t talise_setup(taliseDevice_t * const pd, taliseInit_t * const pi)
 			printf("error: TALISE_loadArmFromBinary() failed\n");
 			goto error_11;
 		}
+		talise_phase_done("ARM load", &phase_us);
 
 		/* TALISE_verifyArmChecksum() will timeout after 200ms
 		 * if ARM checksum is not computed
@@ -223,6 +249,7 @@ adiHalErr_t talise_setup(taliseDevice_t * const pd, taliseInit_t * const pi)
 			printf("error: TALISE_verifyArmChecksum() failed\n");
 			goto error_11;
 		}
+		talise_phase_done("ARM checksum", &phase_us);
 
 	} else {
 		/*< user code- check settings for proper CLKPLL lock  > ***/
@@ -285,6 +312,7 @@ adiHalErr_t talise_setup(taliseDevice_t * const pd, taliseInit_t * const pi)
 		/*< user code - Calibrations completed successfully > */
 		printf("talise: Calibrations completed successfully\n");
 	}
+	talise_phase_done("init cals", &phase_us);
 
 #ifndef ADRV9008_2
 	/***************************************************/
@@ -81,6 +81,9 @@ extern "C" {
 /* Minimum HAL_SPIWRITEARRAY_BUFFERSIZE = 18 */
 #define HAL_SPIWRITEARRAY_BUFFERSIZE 341
 
+/* Maximum number of bytes sent in a single ADIHAL_spiWriteBurst() transfer */
+#define HAL_SPIBURST_BUFFERSIZE 1024
+
 /*============================================================================
  * ADI Device Hardware Control Functions
  *===========================================================================*/
@@ -331,6 +334,43 @@ adiHalErr_t ADIHAL_spiWriteByte(void *devHalInfo, uint16_t addr, uint8_t data);
 adiHalErr_t  ADIHAL_spiWriteBytes(void *devHalInfo, uint16_t *addr,
 				  uint8_t *data, uint32_t count);
 
+/**
+ * \brief Performs SPI streaming writes to an ADI Device
+ *
+ * This function shall write the data array as a sequence of SPI streaming
+ * frames. Every frame carries one instruction for addr followed by frameSize
+ * data bytes, which the device writes to consecutive register addresses.
+ * Frames are queued and sent in as few SPI transfers as the platform allows,
+ * deasserting chip select between frames.
+ *
+ * Used to feed auto-incrementing data windows (such as the ARM DMA data
+ * registers) without a full instruction per data byte.
+ *
+ * \pre The device must be configured for SPI streaming with ascending
+ * addresses before this function is called.
+ *
+ * <B>Dependencies</B>
+ * --Application and Platform Specific modules
+ *
+ * \param devHalInfo Pointer to Platform HAL defined structure containing
+ *                   hardware settings describing the device of interest.
+ *
+ * \param addr 15-bit address of the first register of every frame.
+ *
+ * \param data An array of 8-bit data values to write.
+ *
+ * \param count The number of bytes in the data array. Must be a multiple
+ *              of frameSize.
+ *
+ * \param frameSize The number of data bytes per streaming frame.
+ *
+ * \retval ADIHAL_OK if function completed successfully.
+ * \retval ADIHAL_GEN_SW if the frame size or count is invalid.
+ * \retval ADIHAL_SPI_FAIL if function failed to complete SPI transaction
+ */
+adiHalErr_t ADIHAL_spiWriteBurst(void *devHalInfo, uint16_t addr,
+				 uint8_t *data, uint32_t count, uint32_t frameSize);
+
 /**
  * \brief Performs a Single SPI Read from an ADI Device
  *
@@ -32,12 +32,14 @@
 *******************************************************************************/
 
 #include <stdio.h>
+#include <string.h>
 #include "adi_hal.h"
 #include "parameters.h"
 #include "no_os_spi.h"
 #include "no_os_gpio.h"
 #include "no_os_error.h"
 #include "no_os_delay.h"
+#include "no_os_util.h"
 #ifndef ALTERA_PLATFORM
 #include "xilinx_spi.h"
 #include "xilinx_gpio.h"
@@ -46,6 +48,11 @@
 #include "altera_gpio.h"
 #endif
 
+/* Shared scratch for queued SPI writes; the HAL is not reentrant */
+static uint8_t hal_spi_buf[no_os_max(HAL_SPIBURST_BUFFERSIZE,
+				     HAL_SPIWRITEARRAY_BUFFERSIZE * 3)];
+static struct no_os_spi_msg hal_spi_msgs[HAL_SPIWRITEARRAY_BUFFERSIZE];
+
 adiHalErr_t ADIHAL_setTimeout(void *devHalInfo, uint32_t halTimeout_ms)
 {
 	return ADIHAL_OK;
@@ -174,13 +181,71 @@ adiHalErr_t ADIHAL_spiWriteByte(void *devHalInfo,
 adiHalErr_t ADIHAL_spiWriteBytes(void *devHalInfo,
 				 uint16_t *addr, uint8_t *data, uint32_t count)
 {
-	adiHalErr_t errVal;
+	struct adi_hal *devHalData = (struct adi_hal *)devHalInfo;
+	uint8_t *buf;
+	uint32_t n = 0;
 	uint32_t i;
+	int32_t status;
 
+	/* One 3 byte instruction per write, queued as a single transfer */
 	for (i = 0; i < count; i++) {
-		errVal = ADIHAL_spiWriteByte(devHalInfo, addr[i], data[i]);
-		if (errVal)
-			return errVal;
+		buf = &hal_spi_buf[n * 3];
+		buf[0] = (addr[i] >> 8) & 0x7F;
+		buf[1] = addr[i] & 0xFF;
+		buf[2] = data[i];
+		hal_spi_msgs[n].tx_buff = buf;
+		hal_spi_msgs[n].rx_buff = buf;
+		hal_spi_msgs[n].bytes_number = 3;
+		hal_spi_msgs[n].cs_change = 1;
+		n++;
+
+		if (n == HAL_SPIWRITEARRAY_BUFFERSIZE || i == count - 1) {
+			status = no_os_spi_transfer(devHalData->spi_adrv_desc,
+						    hal_spi_msgs, n);
+			if (status != 0)
+				return ADIHAL_SPI_FAIL;
+			n = 0;
+		}
+	}
+
+	return ADIHAL_OK;
+}
+
+adiHalErr_t ADIHAL_spiWriteBurst(void *devHalInfo, uint16_t addr,
+				 uint8_t *data, uint32_t count, uint32_t frameSize)
+{
+	struct adi_hal *devHalData = (struct adi_hal *)devHalInfo;
+	uint32_t frameLen = frameSize + 2;
+	uint32_t maxFrames;
+	uint8_t *buf;
+	uint32_t n = 0;
+	uint32_t i;
+	int32_t status;
+
+	if (!frameSize || count % frameSize || frameLen > HAL_SPIBURST_BUFFERSIZE)
+		return ADIHAL_GEN_SW;
+
+	maxFrames = no_os_min(HAL_SPIBURST_BUFFERSIZE / frameLen,
+			      HAL_SPIWRITEARRAY_BUFFERSIZE);
+
+	for (i = 0; i < count; i += frameSize) {
+		buf = &hal_spi_buf[n * frameLen];
+		buf[0] = (addr >> 8) & 0x7F;
+		buf[1] = addr & 0xFF;
+		memcpy(&buf[2], &data[i], frameSize);
+		hal_spi_msgs[n].tx_buff = buf;
+		hal_spi_msgs[n].rx_buff = buf;
+		hal_spi_msgs[n].bytes_number = frameLen;
+		hal_spi_msgs[n].cs_change = 1;
+		n++;
+
+		if (n == maxFrames || i + frameSize == count) {
+			status = no_os_spi_transfer(devHalData->spi_adrv_desc,
+						    hal_spi_msgs, n);
+			if (status != 0)
+				return ADIHAL_SPI_FAIL;
+			n = 0;
+		}
 	}
 
 	return ADIHAL_OK;
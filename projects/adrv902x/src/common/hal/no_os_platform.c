@@ -228,7 +228,7 @@ int32_t no_os_LogWrite(void *devHalCfg, int32_t logLevel, const char *comment,
 		pr_debug("%s", logMessage);
 		break;
 	case ADI_HAL_LOG_ALL:
-		pr_info(logMessage);
+		pr_info("%s", logMessage);
 		break;
 	}
 
@@ -0,0 +1,320 @@
+/***************************************************************************//**
+ *   @file   ad3552r_model.c
+ *   @brief  Simulated AD3552R for the plain SPI streaming tests.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+#include "no_os_alloc.h"
+#include "no_os_delay.h"
+#include "no_os_spi.h"
+#include "no_os_util.h"
+#include "ad3552r.h"
+
+/*
+ * AD3552R register file on a simulated time base. A CS frame is an
+ * instruction byte followed by data bytes at descending addresses. In
+ * streaming mode with a loop length, the address goes back to the first one
+ * after each loop. Every DAC register write is logged per channel.
+ *
+ * A synchronous transfer costs MODEL_CALL_NS, like a spidev ioctl, plus the
+ * wire time. An asynchronous one costs MODEL_DMA_NS to start, the callback
+ * runs at the end of the wire time and the bus stays busy until then.
+ */
+#define MODEL_SCLK_HZ		25000000
+#define MODEL_CALL_NS		15000
+#define MODEL_DMA_NS		200
+#define MODEL_NB_REGS		(AD3552R_REG_ADDR_MAX + 1)
+#define MODEL_MAX_OUT		(1 << 16)
+
+static uint8_t model_regs[MODEL_NB_REGS];
+static uint16_t model_out[AD3552R_MAX_NUM_CH][MODEL_MAX_OUT];
+static uint32_t model_nb_out[AD3552R_MAX_NUM_CH];
+static uint64_t model_now_ns;
+static uint64_t model_bus_free_ns;
+static uint32_t model_transfers;
+
+/* State of the current CS frame */
+static uint32_t model_pos;
+static uint32_t model_loop_pos;
+static uint8_t model_start;
+static uint8_t model_addr;
+static bool model_read;
+
+static void model_reset(void)
+{
+	memset(model_regs, 0, sizeof(model_regs));
+	model_regs[AD3552R_REG_ADDR_INTERFACE_CONFIG_B] = 0x08;
+	model_regs[AD3552R_REG_ADDR_PRODUCT_ID_L] = 0x08;
+	model_regs[AD3552R_REG_ADDR_PRODUCT_ID_H] = 0x40;
+}
+
+static void model_init(void)
+{
+	model_reset();
+	memset(model_nb_out, 0, sizeof(model_nb_out));
+	model_now_ns = 0;
+	model_bus_free_ns = 0;
+	model_transfers = 0;
+	model_pos = 0;
+}
+
+static bool model_streaming(void)
+{
+	return !(model_regs[AD3552R_REG_ADDR_INTERFACE_CONFIG_B] &
+		 AD3552R_MASK_SINGLE_INST);
+}
+
+/* Log the code once the last (lowest) byte of a DAC register is written */
+static void model_dac_write(uint8_t addr)
+{
+	uint8_t ch;
+
+	for (ch = 0; ch < AD3552R_MAX_NUM_CH; ch++) {
+		if (addr == AD3552R_REG_ADDR_CH_DAC_16B(ch) - 1) {
+			model_out[ch][model_nb_out[ch]++ % MODEL_MAX_OUT] =
+				model_regs[addr + 1] << 8 | model_regs[addr];
+			return;
+		}
+		if (addr == AD3552R_REG_ADDR_CH_DAC_24B(ch) - 2) {
+			model_out[ch][model_nb_out[ch]++ % MODEL_MAX_OUT] =
+				model_regs[addr + 2] << 8 | model_regs[addr + 1];
+			return;
+		}
+	}
+}
+
+static uint8_t model_byte(uint8_t tx)
+{
+	uint8_t rx = 0, len;
+
+	if (!model_pos++) {
+		model_read = tx & 0x80;
+		model_start = tx & 0x7F;
+		model_addr = model_start;
+		model_loop_pos = 0;
+		return 0;
+	}
+
+	TEST_ASSERT_TRUE(model_addr < MODEL_NB_REGS);
+	if (model_read) {
+		rx = model_regs[model_addr];
+	} else {
+		model_regs[model_addr] = tx;
+		if (model_addr == AD3552R_REG_ADDR_INTERFACE_CONFIG_A &&
+		    (tx & AD3552R_MASK_SOFTWARE_RESET) ==
+		    AD3552R_MASK_SOFTWARE_RESET)
+			model_reset();
+		model_dac_write(model_addr);
+	}
+
+	len = model_regs[AD3552R_REG_ADDR_STREAM_MODE];
+	if (model_streaming() && len && ++model_loop_pos == len) {
+		model_addr = model_start;
+		model_loop_pos = 0;
+	} else if (model_regs[AD3552R_REG_ADDR_INTERFACE_CONFIG_A] &
+		   AD3552R_MASK_ADDR_ASCENSION) {
+		model_addr++;
+	} else {
+		model_addr--;
+	}
+
+	return rx;
+}
+
+static void model_cs_deassert(void)
+{
+	model_pos = 0;
+	if (!(model_regs[AD3552R_REG_ADDR_TRANSFER_REGISTER] &
+	      AD3552R_MASK_STREAM_LENGTH_KEEP_VALUE))
+		model_regs[AD3552R_REG_ADDR_STREAM_MODE] = 0;
+}
+
+static uint64_t model_wire_ns(uint32_t bytes)
+{
+	return (uint64_t)bytes * 8 * 1000000000 / MODEL_SCLK_HZ;
+}
+
+static uint32_t model_msgs(struct no_os_spi_msg *msgs, uint32_t len)
+{
+	uint32_t i, j, bytes = 0;
+	uint8_t rx;
+
+	for (i = 0; i < len; i++) {
+		for (j = 0; j < msgs[i].bytes_number; j++) {
+			rx = model_byte(msgs[i].tx_buff ? msgs[i].tx_buff[j] : 0);
+			if (msgs[i].rx_buff)
+				msgs[i].rx_buff[j] = rx;
+		}
+		bytes += msgs[i].bytes_number;
+		if (msgs[i].cs_change || i == len - 1)
+			model_cs_deassert();
+	}
+
+	return bytes;
+}
+
+static int32_t model_spi_init(struct no_os_spi_desc **desc,
+			      const struct no_os_spi_init_param *param)
+{
+	*desc = no_os_calloc(1, sizeof(**desc));
+	if (!*desc)
+		return -ENOMEM;
+
+	(*desc)->max_speed_hz = param->max_speed_hz;
+
+	return 0;
+}
+
+static int32_t model_spi_remove(struct no_os_spi_desc *desc)
+{
+	no_os_free(desc);
+
+	return 0;
+}
+
+static int32_t model_spi_transfer(struct no_os_spi_desc *desc,
+				  struct no_os_spi_msg *msgs, uint32_t len)
+{
+	NO_OS_UNUSED_PARAM(desc);
+
+	model_transfers++;
+	model_now_ns += MODEL_CALL_NS;
+	model_now_ns += model_wire_ns(model_msgs(msgs, len));
+
+	return 0;
+}
+
+static int32_t model_spi_transfer_dma_async(struct no_os_spi_desc *desc,
+		struct no_os_spi_msg *msgs, uint32_t len,
+		void (*callback)(void *), void *ctx)
+{
+	uint64_t now;
+
+	NO_OS_UNUSED_PARAM(desc);
+
+	/* The caller spins until the previous frame is out */
+	if (model_now_ns < model_bus_free_ns)
+		model_now_ns = model_bus_free_ns;
+
+	model_transfers++;
+	model_now_ns += MODEL_DMA_NS;
+	model_bus_free_ns = model_now_ns + model_wire_ns(model_msgs(msgs, len));
+
+	now = model_now_ns;
+	model_now_ns = model_bus_free_ns;
+	callback(ctx);
+	model_now_ns = now;
+
+	return 0;
+}
+
+/* Platforms with no transfer op: one in place frame per call */
+static int32_t model_spi_write_and_read(struct no_os_spi_desc *desc,
+					uint8_t *data, uint16_t bytes_number)
+{
+	struct no_os_spi_msg msg = {
+		.tx_buff = data,
+		.rx_buff = data,
+		.bytes_number = bytes_number,
+	};
+
+	NO_OS_UNUSED_PARAM(desc);
+
+	model_transfers++;
+	model_now_ns += MODEL_CALL_NS;
+	model_now_ns += model_wire_ns(model_msgs(&msg, 1));
+
+	return 0;
+}
+
+/* A DMA that never completes */
+static int32_t model_spi_transfer_dma_stuck(struct no_os_spi_desc *desc,
+		struct no_os_spi_msg *msgs, uint32_t len,
+		void (*callback)(void *), void *ctx)
+{
+	NO_OS_UNUSED_PARAM(desc);
+	NO_OS_UNUSED_PARAM(msgs);
+	NO_OS_UNUSED_PARAM(len);
+	NO_OS_UNUSED_PARAM(callback);
+	NO_OS_UNUSED_PARAM(ctx);
+
+	model_transfers++;
+
+	return 0;
+}
+
+static const struct no_os_spi_platform_ops model_spi_ops = {
+	.init = model_spi_init,
+	.remove = model_spi_remove,
+	.transfer = model_spi_transfer,
+};
+
+static const struct no_os_spi_platform_ops model_spi_dma_ops = {
+	.init = model_spi_init,
+	.remove = model_spi_remove,
+	.transfer = model_spi_transfer,
+	.transfer_dma_async = model_spi_transfer_dma_async,
+};
+
+static const struct no_os_spi_platform_ops model_spi_wr_ops = {
+	.init = model_spi_init,
+	.remove = model_spi_remove,
+	.write_and_read = model_spi_write_and_read,
+};
+
+static const struct no_os_spi_platform_ops model_spi_stuck_ops = {
+	.init = model_spi_init,
+	.remove = model_spi_remove,
+	.transfer = model_spi_transfer,
+	.transfer_dma_async = model_spi_transfer_dma_stuck,
+};
+
+void no_os_udelay(uint32_t usecs)
+{
+	model_now_ns += usecs * 1000ull;
+}
+
+void no_os_mdelay(uint32_t msecs)
+{
+	model_now_ns += msecs * 1000000ull;
+}
+
+struct no_os_time no_os_get_time(void)
+{
+	struct no_os_time t = {
+		.s = model_now_ns / 1000000000ull,
+		.us = model_now_ns / 1000 % 1000000,
+	};
+
+	return t;
+}
@@ -0,0 +1,321 @@
+/***************************************************************************//**
+ *   @file   test_ad3552r_spi_stream.c
+ *   @brief  Unit tests for the AD3552R plain SPI streaming mode.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <errno.h>
+#include "unity.h"
+#include "ad3552r.h"
+#include "no_os_spi.h"
+#include "no_os_util.h"
+#include "ad3552r_model.c"
+
+TEST_FILE("no_os_gpio.c")
+TEST_FILE("no_os_mutex.c")
+TEST_FILE("no_os_alloc.c")
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define NB_SETS		5000
+
+static struct ad3552r_init_param init_param = {
+	.chip_id = AD3552R_ID,
+	.spi_param = {
+		.max_speed_hz = MODEL_SCLK_HZ,
+		.platform_ops = &model_spi_ops,
+	},
+	.channels = {
+		{ .en = true, .fast_en = true },
+		{ .en = true, .fast_en = true },
+	},
+};
+static struct ad3552r_desc *dac;
+static uint16_t samples[NB_SETS * AD3552R_MAX_NUM_CH];
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+/* Two different ramps */
+static void fill_samples(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < NB_SETS; i++) {
+		samples[2 * i] = i * 13;
+		samples[2 * i + 1] = 0xFFFF - i * 7;
+	}
+}
+
+/* Like ad3552r_write_samples(), the first sample of a set goes to CH1 */
+static void check_outputs(uint32_t nb)
+{
+	uint32_t i;
+
+	TEST_ASSERT_EQUAL_UINT32(nb, model_nb_out[0]);
+	TEST_ASSERT_EQUAL_UINT32(nb, model_nb_out[1]);
+	for (i = 0; i < nb; i++) {
+		TEST_ASSERT_EQUAL_UINT32(samples[2 * i], model_out[1][i]);
+		TEST_ASSERT_EQUAL_UINT32(samples[2 * i + 1], model_out[0][i]);
+	}
+}
+
+/* Sample sets per second, on the simulated time base */
+static uint32_t rate(uint32_t nb, uint64_t ns)
+{
+	return (uint64_t)nb * 1000000000 / ns;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	model_init();
+	fill_samples();
+	init_param.spi_param.platform_ops = &model_spi_ops;
+	init_param.crc_en = false;
+	init_param.channels[1].fast_en = true;
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_init(&dac, &init_param));
+	memset(model_nb_out, 0, sizeof(model_nb_out));
+}
+
+void tearDown(void)
+{
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_remove(dac));
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_ad3552r_spi_stream_start_stop(void)
+{
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_start(dac,
+			      AD3552R_MASK_ALL_CH, 100));
+	TEST_ASSERT_FALSE(model_regs[AD3552R_REG_ADDR_INTERFACE_CONFIG_B] &
+			  AD3552R_MASK_SINGLE_INST);
+	TEST_ASSERT_TRUE(model_regs[AD3552R_REG_ADDR_TRANSFER_REGISTER] &
+			 AD3552R_MASK_STREAM_LENGTH_KEEP_VALUE);
+	TEST_ASSERT_EQUAL_UINT32(4, model_regs[AD3552R_REG_ADDR_STREAM_MODE]);
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ad3552r_spi_stream_start(dac,
+			      AD3552R_MASK_ALL_CH, 100));
+
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_stop(dac));
+	TEST_ASSERT_NULL(dac->stream);
+	TEST_ASSERT_TRUE(model_regs[AD3552R_REG_ADDR_INTERFACE_CONFIG_B] &
+			 AD3552R_MASK_SINGLE_INST);
+	TEST_ASSERT_FALSE(model_regs[AD3552R_REG_ADDR_TRANSFER_REGISTER] &
+			  AD3552R_MASK_STREAM_LENGTH_KEEP_VALUE);
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ad3552r_spi_stream_stop(dac));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ad3552r_spi_stream_write(dac, samples, 1));
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ad3552r_spi_stream_start(dac, 0, 0));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ad3552r_spi_stream_start(dac, 4, 0));
+}
+
+/* Channels streamed with different resolutions or with CRC are refused. */
+void test_ad3552r_spi_stream_invalid(void)
+{
+	dac->ch_data[1].fast_en = false;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ad3552r_spi_stream_start(dac,
+			      AD3552R_MASK_ALL_CH, 0));
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_start(dac, NO_OS_BIT(1), 0));
+	TEST_ASSERT_EQUAL_UINT32(3, model_regs[AD3552R_REG_ADDR_STREAM_MODE]);
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_stop(dac));
+
+	dac->crc_en = 1;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ad3552r_spi_stream_start(dac,
+			      AD3552R_MASK_ALL_CH, 0));
+	dac->crc_en = 0;
+}
+
+/* Every set reaches both DAC registers in order, the partial frame at stop. */
+void test_ad3552r_spi_stream_data(void)
+{
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_start(dac,
+			      AD3552R_MASK_ALL_CH, 0));
+	TEST_ASSERT_EQUAL_UINT32((AD3552R_STREAM_FRAME_MAX - 1) / 4,
+				 dac->stream->block_samples);
+
+	model_transfers = 0;
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_write(dac, samples, 1000));
+	TEST_ASSERT_EQUAL_UINT32(0, model_transfers);
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_write(dac, samples + 2000,
+			      NB_SETS - 1000));
+	TEST_ASSERT_EQUAL_UINT32(NB_SETS / 1023, model_transfers);
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_stop(dac));
+
+	check_outputs(NB_SETS);
+	TEST_ASSERT_EQUAL_UINT32(NB_SETS / 1023 + 1, dac->stream_stats.nb_frames);
+	TEST_ASSERT_EQUAL_UINT32(NB_SETS, dac->stream_stats.nb_samples);
+}
+
+/* Single channel, 16 bit precision: 3 byte loop on the 24 bit register. */
+void test_ad3552r_spi_stream_single_ch(void)
+{
+	uint32_t i;
+
+	dac->ch_data[0].fast_en = false;
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_start(dac, NO_OS_BIT(0), 64));
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_write(dac, samples, 200));
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_stop(dac));
+
+	TEST_ASSERT_EQUAL_UINT32(200, model_nb_out[0]);
+	TEST_ASSERT_EQUAL_UINT32(0, model_nb_out[1]);
+	for (i = 0; i < 200; i++)
+		TEST_ASSERT_EQUAL_UINT32(samples[i], model_out[0][i]);
+}
+
+/*
+ * Without a transfer op, as on Xilinx PS SPI, no_os_spi_transfer() sends
+ * each frame in place with write_and_read, which reads over the frame.
+ */
+void test_ad3552r_spi_stream_write_and_read(void)
+{
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_start(dac,
+			      AD3552R_MASK_ALL_CH, 0));
+	dac->spi->platform_ops = &model_spi_wr_ops;
+
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_write(dac, samples, NB_SETS));
+	dac->spi->platform_ops = &model_spi_ops;
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_stop(dac));
+
+	check_outputs(NB_SETS);
+}
+
+/* A frame which is never sent makes the next one and the stop time out. */
+void test_ad3552r_spi_stream_timeout(void)
+{
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_remove(dac));
+	init_param.spi_param.platform_ops = &model_spi_stuck_ops;
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_init(&dac, &init_param));
+
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_start(dac,
+			      AD3552R_MASK_ALL_CH, 100));
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_write(dac, samples, 100));
+	TEST_ASSERT_EQUAL_INT(-ETIMEDOUT, ad3552r_spi_stream_write(dac, samples,
+			      100));
+	TEST_ASSERT_TRUE(model_now_ns >= AD3552R_STREAM_TIMEOUT_US * 1000ull);
+
+	TEST_ASSERT_EQUAL_INT(-ETIMEDOUT, ad3552r_spi_stream_stop(dac));
+	TEST_ASSERT_NOT_NULL(dac->stream);
+
+	/* The transfer completes after all, the next ones do too */
+	dac->stream->busy = false;
+	dac->spi->platform_ops = &model_spi_dma_ops;
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_stop(dac));
+	TEST_ASSERT_NULL(dac->stream);
+}
+
+/*
+ * With DMA the next frame follows the previous one back to back, as long as
+ * it is filled in time. A producer slower than a frame leaves the outputs
+ * held, which is counted as an underrun.
+ */
+void test_ad3552r_spi_stream_underrun(void)
+{
+	uint32_t i;
+
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_remove(dac));
+	init_param.spi_param.platform_ops = &model_spi_dma_ops;
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_init(&dac, &init_param));
+
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_start(dac,
+			      AD3552R_MASK_ALL_CH, 100));
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_write(dac, samples, 1000));
+	TEST_ASSERT_EQUAL_UINT32(0, dac->stream_stats.nb_underruns);
+
+	/* 1 ms to fill frames that go out in 128 us */
+	for (i = 0; i < 3; i++) {
+		model_now_ns += 1000000;
+		TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_write(dac, samples,
+				      100));
+	}
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_stop(dac));
+	TEST_ASSERT_EQUAL_UINT32(3, dac->stream_stats.nb_underruns);
+	TEST_ASSERT_TRUE(dac->stream_stats.held_us > 3 * 800);
+	TEST_ASSERT_EQUAL_UINT32(1300, dac->stream_stats.nb_samples);
+}
+
+/*
+ * Sample set update rate of the two channels, writing each set with its
+ * own transfer against streaming frames of 1023 sets, with synchronous
+ * transfers (spidev) and with DMA.
+ */
+void test_ad3552r_spi_stream_rate(void)
+{
+	uint32_t single_sps, sync_sps, dma_sps;
+	uint32_t sync_und, dma_und;
+	uint64_t start;
+
+	start = model_now_ns;
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_write_samples(dac, samples, NB_SETS,
+			      AD3552R_MASK_ALL_CH, AD3552R_WRITE_DAC_REGS));
+	single_sps = rate(NB_SETS, model_now_ns - start);
+	check_outputs(NB_SETS);
+
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_start(dac,
+			      AD3552R_MASK_ALL_CH, 0));
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_write(dac, samples, NB_SETS));
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_stop(dac));
+	sync_sps = rate(NB_SETS, dac->stream_stats.elapsed_us * 1000);
+	sync_und = dac->stream_stats.nb_underruns;
+
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_remove(dac));
+	init_param.spi_param.platform_ops = &model_spi_dma_ops;
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_init(&dac, &init_param));
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_start(dac,
+			      AD3552R_MASK_ALL_CH, 0));
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_write(dac, samples, NB_SETS));
+	TEST_ASSERT_EQUAL_INT(0, ad3552r_spi_stream_stop(dac));
+	dma_sps = rate(NB_SETS, dac->stream_stats.elapsed_us * 1000);
+	dma_und = dac->stream_stats.nb_underruns;
+
+	printf("\n%-22s %12s %10s\n", "AD3552R 2 ch, 25 MHz", "sets/s",
+	       "underruns");
+	printf("%-22s %12u %10s\n", "single transfer", single_sps, "-");
+	printf("%-22s %12u %10u\n", "stream, spidev", sync_sps, sync_und);
+	printf("%-22s %12u %10u\n", "stream, DMA", dma_sps, dma_und);
+	printf("%-22s %12u\n", "wire limit", MODEL_SCLK_HZ / 32);
+
+	TEST_ASSERT_TRUE(sync_sps > 10 * single_sps);
+	TEST_ASSERT_TRUE(dma_sps > sync_sps);
+	TEST_ASSERT_EQUAL_UINT32(0, dma_und);
+}
@@ -0,0 +1,166 @@
+/***************************************************************************//**
+ *   @file   ad469x_model.c
+ *   @brief  AD469x conversion mode model for the streaming tests.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "no_os_delay.h"
+#include "no_os_spi.h"
+#include "no_os_util.h"
+#include "ad469x.h"
+
+/*
+ * AD469x in conversion mode on a simulated time base. Every CS frame reads
+ * one conversion of the sequence set in model_slot_ch, the channel being
+ * in the top 5 bits of the result and the sequence number below, MSB
+ * aligned on model_resol[ch] bits within the capture width. Frames closer
+ * than the conversion period of the device are counted in model_overruns.
+ */
+#define MODEL_SCLK_HZ		40000000
+#define MODEL_CALL_NS		15000
+#define MODEL_CS_NS		100
+#define MODEL_CONV_NS		1000
+
+static uint8_t model_slot_ch[AD469x_SLOTS_NO + 1];
+static uint32_t model_nb_slots;
+static uint8_t model_resol[AD469x_CHANNEL_NO + 1];
+static uint8_t model_width;
+static uint32_t model_conv;
+static uint64_t model_now_ns;
+static uint64_t model_last_ns;
+static uint32_t model_transfers;
+static uint32_t model_overruns;
+
+static void model_reset(uint8_t width)
+{
+	uint32_t i;
+
+	for (i = 0; i <= AD469x_CHANNEL_NO; i++)
+		model_resol[i] = 16;
+	model_width = width;
+	model_nb_slots = 0;
+	model_conv = 0;
+	model_now_ns = 0;
+	model_last_ns = 0;
+	model_transfers = 0;
+	model_overruns = 0;
+}
+
+static uint32_t model_code(uint8_t ch, uint32_t seq)
+{
+	uint8_t resol = model_resol[ch];
+
+	return (ch << (resol - 5)) | (seq & NO_OS_GENMASK(resol - 6, 0));
+}
+
+static void model_frame(uint8_t *frame, uint32_t bytes)
+{
+	uint8_t ch = model_slot_ch[model_conv % model_nb_slots];
+	uint32_t raw, i;
+
+	if (model_conv && model_now_ns - model_last_ns < MODEL_CONV_NS)
+		model_overruns++;
+	model_last_ns = model_now_ns;
+
+	raw = model_code(ch, model_conv / model_nb_slots);
+	raw <<= model_width - model_resol[ch];
+	raw <<= bytes * 8 - model_width;
+	for (i = 0; i < bytes; i++)
+		frame[i] = raw >> (8 * (bytes - 1 - i));
+
+	model_conv++;
+	model_now_ns += bytes * 8 * 1000000000ull / MODEL_SCLK_HZ + MODEL_CS_NS;
+}
+
+static int32_t model_spi_init(struct no_os_spi_desc **desc,
+			      const struct no_os_spi_init_param *param)
+{
+	*desc = calloc(1, sizeof(**desc));
+	if (!*desc)
+		return -ENOMEM;
+
+	(*desc)->max_speed_hz = param->max_speed_hz;
+
+	return 0;
+}
+
+static int32_t model_spi_remove(struct no_os_spi_desc *desc)
+{
+	free(desc);
+
+	return 0;
+}
+
+static int32_t model_spi_transfer(struct no_os_spi_desc *desc,
+				  struct no_os_spi_msg *msgs, uint32_t len)
+{
+	uint32_t i;
+
+	NO_OS_UNUSED_PARAM(desc);
+
+	model_transfers++;
+	model_now_ns += MODEL_CALL_NS;
+	for (i = 0; i < len; i++) {
+		model_frame(msgs[i].rx_buff, msgs[i].bytes_number);
+		model_now_ns += msgs[i].cs_change_delay * 1000ull;
+	}
+
+	return 0;
+}
+
+static const struct no_os_spi_platform_ops model_spi_ops = {
+	.init = model_spi_init,
+	.remove = model_spi_remove,
+	.transfer = model_spi_transfer,
+};
+
+void no_os_udelay(uint32_t usecs)
+{
+	model_now_ns += usecs * 1000ull;
+}
+
+void no_os_mdelay(uint32_t msecs)
+{
+	model_now_ns += msecs * 1000000ull;
+}
+
+struct no_os_time no_os_get_time(void)
+{
+	struct no_os_time t = {
+		.s = model_now_ns / 1000000000ull,
+		.us = model_now_ns / 1000 % 1000000,
+	};
+
+	return t;
+}
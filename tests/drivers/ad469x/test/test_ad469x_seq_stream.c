@@ -0,0 +1,291 @@
+/***************************************************************************//**
+ *   @file   test_ad469x_seq_stream.c
+ *   @brief  Unit tests for the AD469x sequencer streaming.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <errno.h>
+#include "unity.h"
+#include "ad469x.h"
+#include "no_os_alloc.h"
+#include "no_os_spi.h"
+#include "no_os_util.h"
+#include "ad469x_model.c"
+
+TEST_FILE("no_os_gpio.c")
+TEST_FILE("no_os_mutex.c")
+TEST_FILE("no_os_alloc.c")
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define NB_SAMPLES	1000
+#define PERIOD_NS	2000
+
+static struct no_os_spi_init_param spi_ip = {
+	.max_speed_hz = MODEL_SCLK_HZ,
+	.platform_ops = &model_spi_ops,
+};
+static struct ad469x_dev dev;
+static struct ad469x_stream stream;
+static uint32_t ch_data[AD469x_CHANNEL_NO + 1][NB_SAMPLES];
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static void set_std_seq(uint16_t ch_mask, bool temp)
+{
+	uint32_t ch;
+
+	dev.ch_sequence = AD469x_standard_seq;
+	dev.std_seq_ch_mask = ch_mask;
+	dev.num_slots = no_os_hweight16(ch_mask);
+	dev.temp_enabled = temp;
+
+	for (ch = 0; ch < AD469x_CHANNEL_NO; ch++)
+		if (ch_mask & NO_OS_BIT(ch))
+			model_slot_ch[model_nb_slots++] = ch;
+	if (temp)
+		model_slot_ch[model_nb_slots++] = AD469x_CHANNEL_NO;
+}
+
+static void set_buffers(void)
+{
+	uint32_t ch;
+
+	for (ch = 0; ch <= AD469x_CHANNEL_NO; ch++) {
+		stream.ch_buf[ch] = ch_data[ch];
+		stream.ch_len[ch] = NB_SAMPLES;
+	}
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	model_reset(16);
+	memset(&dev, 0, sizeof(dev));
+	memset(&stream, 0, sizeof(stream));
+	memset(ch_data, 0, sizeof(ch_data));
+	dev.capture_data_width = 16;
+	dev.dev_id = ID_AD4696;
+	TEST_ASSERT_EQUAL_INT(0, no_os_spi_init(&dev.spi_desc, &spi_ip));
+}
+
+void tearDown(void)
+{
+	TEST_ASSERT_EQUAL_INT(0, ad469x_seq_stream_remove(&stream));
+	TEST_ASSERT_EQUAL_INT(0, no_os_spi_remove(dev.spi_desc));
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_ad469x_seq_stream_invalid(void)
+{
+	set_std_seq(0x3, false);
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ad469x_seq_stream_init(&dev, &stream));
+	stream.batch = AD469x_STREAM_BATCH_MAX + 1;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ad469x_seq_stream_init(&dev, &stream));
+
+	stream.batch = 16;
+	dev.ch_sequence = AD469x_single_cycle;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ad469x_seq_stream_init(&dev, &stream));
+
+	dev.ch_sequence = AD469x_standard_seq;
+	dev.std_seq_ch_mask = 0;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ad469x_seq_stream_init(&dev, &stream));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ad469x_seq_stream_read(&dev, &stream, 1));
+}
+
+/*
+ * The standard sequence is split in the channel buffers, the temperature
+ * last, and the slot position is kept across reads that end mid-sequence.
+ */
+void test_ad469x_seq_stream_std(void)
+{
+	static const uint8_t chans[] = {0, 2, 5, 7, AD469x_CHANNEL_NO};
+	uint32_t i, j;
+
+	set_std_seq(0xA5, true);
+	set_buffers();
+	stream.ch_buf[1] = NULL;
+	stream.batch = 64;
+	stream.period_ns = PERIOD_NS;
+	TEST_ASSERT_EQUAL_INT(0, ad469x_seq_stream_init(&dev, &stream));
+	TEST_ASSERT_EQUAL_UINT32(5, stream.nb_slots);
+
+	TEST_ASSERT_EQUAL_INT(0, ad469x_seq_stream_read(&dev, &stream, 100));
+	TEST_ASSERT_EQUAL_UINT32(NO_OS_DIV_ROUND_UP(500, 64), model_transfers);
+	TEST_ASSERT_EQUAL_INT(0, ad469x_seq_stream_read(&dev, &stream, 100));
+	TEST_ASSERT_EQUAL_UINT32(0, model_overruns);
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(chans); i++) {
+		TEST_ASSERT_EQUAL_UINT32(200, stream.ch_cnt[chans[i]]);
+		for (j = 0; j < 200; j++)
+			TEST_ASSERT_EQUAL_UINT32(model_code(chans[i], j),
+						 ch_data[chans[i]][j]);
+	}
+	TEST_ASSERT_EQUAL_UINT32(0, stream.ch_cnt[1]);
+	TEST_ASSERT_EQUAL_UINT32(1000, stream.nb_samples);
+}
+
+/*
+ * Advanced sequence with a channel in several slots and oversampled
+ * channels, whose results are brought back to their own resolution.
+ */
+void test_ad469x_seq_stream_adv_osr(void)
+{
+	static const uint8_t slots[] = {3, 1, 3, 0};
+	uint32_t i;
+
+	model_reset(19);
+	dev.capture_data_width = 19;
+	dev.ch_sequence = AD469x_advanced_seq;
+	dev.num_slots = NO_OS_ARRAY_SIZE(slots);
+	for (i = 0; i < AD469x_CHANNEL_NO; i++)
+		dev.adv_seq_osr_resol[i] = 16;
+	dev.adv_seq_osr_resol[3] = 18;
+	dev.adv_seq_osr_resol[0] = 19;
+	model_resol[3] = 18;
+	model_resol[0] = 19;
+	for (i = 0; i < NO_OS_ARRAY_SIZE(slots); i++) {
+		dev.ch_slots[i] = slots[i];
+		model_slot_ch[i] = slots[i];
+	}
+	model_nb_slots = NO_OS_ARRAY_SIZE(slots);
+
+	set_buffers();
+	stream.batch = AD469x_STREAM_BATCH_MAX;
+	TEST_ASSERT_EQUAL_INT(0, ad469x_seq_stream_init(&dev, &stream));
+	TEST_ASSERT_EQUAL_INT(0, ad469x_seq_stream_read(&dev, &stream, 200));
+	TEST_ASSERT_EQUAL_UINT32(NO_OS_DIV_ROUND_UP(800, AD469x_STREAM_BATCH_MAX),
+				 model_transfers);
+
+	TEST_ASSERT_EQUAL_UINT32(400, stream.ch_cnt[3]);
+	for (i = 0; i < 200; i++) {
+		TEST_ASSERT_EQUAL_UINT32(model_code(3, i), ch_data[3][2 * i]);
+		TEST_ASSERT_EQUAL_UINT32(model_code(3, i), ch_data[3][2 * i + 1]);
+		TEST_ASSERT_EQUAL_UINT32(model_code(1, i), ch_data[1][i]);
+		TEST_ASSERT_EQUAL_UINT32(model_code(0, i), ch_data[0][i]);
+	}
+}
+
+/*
+ * A read that would overflow a channel buffer is refused before any
+ * conversion is read, and succeeds again once the buffer is emptied.
+ */
+void test_ad469x_seq_stream_full(void)
+{
+	set_std_seq(0x3, false);
+	set_buffers();
+	stream.ch_len[1] = 150;
+	stream.batch = 16;
+	TEST_ASSERT_EQUAL_INT(0, ad469x_seq_stream_init(&dev, &stream));
+
+	TEST_ASSERT_EQUAL_INT(0, ad469x_seq_stream_read(&dev, &stream, 100));
+	TEST_ASSERT_EQUAL_INT(-ENOSPC, ad469x_seq_stream_read(&dev, &stream,
+			      51));
+	TEST_ASSERT_EQUAL_UINT32(100, stream.ch_cnt[0]);
+	TEST_ASSERT_EQUAL_UINT32(100, stream.ch_cnt[1]);
+	TEST_ASSERT_EQUAL_UINT64(200, stream.nb_samples);
+
+	TEST_ASSERT_EQUAL_INT(0, ad469x_seq_stream_read(&dev, &stream, 50));
+	TEST_ASSERT_EQUAL_UINT32(150, stream.ch_cnt[1]);
+	TEST_ASSERT_EQUAL_INT(-ENOSPC, ad469x_seq_stream_read(&dev, &stream, 1));
+
+	stream.ch_cnt[0] = 0;
+	stream.ch_cnt[1] = 0;
+	TEST_ASSERT_EQUAL_INT(0, ad469x_seq_stream_read(&dev, &stream, 150));
+	TEST_ASSERT_EQUAL_UINT32(model_code(1, 150), ch_data[1][0]);
+}
+
+/* ad469x_seq_read_data() reads one frame per conversion, in batches. */
+void test_ad469x_seq_read_data(void)
+{
+	uint32_t *buf;
+	uint32_t i;
+
+	set_std_seq(0x3, false);
+	buf = no_os_calloc(600, sizeof(*buf));
+	TEST_ASSERT_NOT_NULL(buf);
+
+	TEST_ASSERT_EQUAL_INT(0, ad469x_seq_read_data(&dev, buf, 300));
+	TEST_ASSERT_EQUAL_UINT32(NO_OS_DIV_ROUND_UP(600, AD469x_STREAM_BATCH_MAX),
+				 model_transfers);
+	for (i = 0; i < 600; i++)
+		TEST_ASSERT_EQUAL_UINT32(model_code(i % 2, i / 2), buf[i]);
+
+	no_os_free(buf);
+}
+
+/*
+ * Sample rate of a 4 channel sequence, one SPI transfer per conversion
+ * against batched transfers, and the rate of the offload path.
+ */
+void test_ad469x_seq_stream_rate(void)
+{
+	static const uint32_t batches[] = {1, 16, 64, AD469x_STREAM_BATCH_MAX};
+	uint32_t rate_sps, offload_sps, i;
+
+	printf("batch  period [ns]  stream [SPS]  offload [SPS]\n");
+	for (i = 0; i < NO_OS_ARRAY_SIZE(batches); i++) {
+		model_reset(16);
+		memset(&stream, 0, sizeof(stream));
+		set_std_seq(0xF, false);
+		set_buffers();
+		stream.batch = batches[i];
+		stream.period_ns = MODEL_CONV_NS;
+		TEST_ASSERT_EQUAL_INT(0, ad469x_seq_stream_init(&dev, &stream));
+		TEST_ASSERT_EQUAL_INT(0, ad469x_seq_stream_read(&dev, &stream,
+				      NB_SAMPLES / 4));
+		TEST_ASSERT_EQUAL_INT(0, ad469x_seq_stream_get_rate(&dev, &stream,
+				      &rate_sps, &offload_sps));
+		TEST_ASSERT_EQUAL_INT(0, ad469x_seq_stream_remove(&stream));
+
+		printf("%5u  %11u  %12u  %13u\n", batches[i], stream.period_ns,
+		       rate_sps, offload_sps);
+		TEST_ASSERT_EQUAL_UINT32(0, model_overruns);
+		TEST_ASSERT_TRUE(rate_sps < offload_sps);
+		if (i)
+			TEST_ASSERT_TRUE(rate_sps > 10 * offload_sps / 100);
+	}
+}
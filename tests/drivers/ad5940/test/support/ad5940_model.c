@@ -0,0 +1,286 @@
+/***************************************************************************//**
+ *   @file   ad5940_model.c
+ *   @brief  Simulated AD5940 data FIFO for the FIFO stream tests.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "no_os_delay.h"
+#include "no_os_gpio.h"
+#include "no_os_spi.h"
+#include "no_os_util.h"
+#include "ad5940.h"
+
+/*
+ * AD5940 SPI protocol and data FIFO on a simulated time base. A sweep
+ * writes one point every model_period_ns: the voltage then the current DFT
+ * result, real part first, 4 words in total. When the FIFO holds at least
+ * the threshold, the DATAFIFOTHRESH flag is set and GP0 goes low if the
+ * source is enabled in INTCSEL0. Words that do not fit in the FIFO are
+ * dropped and set DATAFIFOOF.
+ *
+ * Every SPI call costs MODEL_CALL_NS plus the time on the wire, the total
+ * is accumulated in model_bus_ns.
+ */
+#define MODEL_N_REGS		0x4000
+#define MODEL_FIFO_WORDS	1024
+#define MODEL_SCLK_HZ		16000000
+#define MODEL_CALL_NS		10000
+
+static uint32_t model_regs[MODEL_N_REGS];
+static uint32_t model_fifo[MODEL_FIFO_WORDS];
+static uint32_t model_fifo_rd;
+static uint32_t model_fifo_cnt;
+static uint16_t model_addr;
+static uint64_t model_now_ns;
+static uint64_t model_bus_ns;
+static uint64_t model_period_ns;
+static uint32_t model_points;
+static uint32_t model_points_done;
+static uint32_t model_transfers;
+
+static void model_reset(void)
+{
+	memset(model_regs, 0, sizeof(model_regs));
+	model_fifo_rd = 0;
+	model_fifo_cnt = 0;
+	model_addr = 0;
+	model_now_ns = 0;
+	model_bus_ns = 0;
+	model_period_ns = 0;
+	model_points = 0;
+	model_points_done = 0;
+	model_transfers = 0;
+}
+
+static uint32_t model_dft_word(int32_t val)
+{
+	return (FIFOWORD_TAG_DFT << FIFOWORD_TAG_POS) |
+	       (val & FIFOWORD_DATA18_MSK);
+}
+
+/* The DFT results of point p, as read from the FIFO */
+static iImpCar_Type model_volt(uint32_t p)
+{
+	iImpCar_Type v = {.Real = 10000 + p % 1000, .Image = -2000};
+
+	return v;
+}
+
+static iImpCar_Type model_curr(uint32_t p)
+{
+	iImpCar_Type i = {.Real = -5000, .Image = 300 + p % 1000};
+
+	return i;
+}
+
+static void model_push(uint32_t word)
+{
+	uint32_t thresh = no_os_field_get(BITM_AFE_DATAFIFOTHRES_HIGHTHRES,
+					  model_regs[REG_AFE_DATAFIFOTHRES]);
+
+	if (model_fifo_cnt == MODEL_FIFO_WORDS) {
+		model_regs[REG_INTC_INTCFLAG0] |= AFEINTSRC_DATAFIFOOF;
+		return;
+	}
+
+	model_fifo[(model_fifo_rd + model_fifo_cnt++) % MODEL_FIFO_WORDS] = word;
+	if (model_fifo_cnt >= thresh)
+		model_regs[REG_INTC_INTCFLAG0] |= AFEINTSRC_DATAFIFOTHRESH;
+}
+
+static uint32_t model_pop(void)
+{
+	uint32_t word;
+
+	if (!model_fifo_cnt)
+		return 0;
+
+	word = model_fifo[model_fifo_rd];
+	model_fifo_rd = (model_fifo_rd + 1) % MODEL_FIFO_WORDS;
+	model_fifo_cnt--;
+
+	return word;
+}
+
+static void model_start_sweep(uint32_t points, uint64_t period_ns)
+{
+	model_points = points;
+	model_points_done = 0;
+	model_period_ns = period_ns;
+}
+
+static void model_update(void)
+{
+	uint64_t t;
+	iImpCar_Type v, i;
+
+	while (model_points_done < model_points) {
+		t = (model_points_done + 1) * model_period_ns;
+		if (t > model_now_ns)
+			break;
+
+		v = model_volt(model_points_done);
+		i = model_curr(model_points_done);
+		model_push(model_dft_word(v.Real));
+		model_push(model_dft_word(v.Image));
+		model_push(model_dft_word(i.Real));
+		model_push(model_dft_word(i.Image));
+		model_points_done++;
+	}
+}
+
+static bool model_reg32(uint16_t addr)
+{
+	return addr >= 0x1000 && addr <= 0x3014;
+}
+
+static uint32_t model_reg_read(uint16_t addr)
+{
+	switch (addr) {
+	case REG_AFE_DATAFIFORD:
+		return model_pop();
+	case REG_AFE_FIFOCNTSTA:
+		return model_fifo_cnt << BITP_AFE_FIFOCNTSTA_DATAFIFOCNTSTA;
+	default:
+		return model_regs[addr % MODEL_N_REGS];
+	}
+}
+
+static void model_reg_write(uint16_t addr, uint32_t val)
+{
+	if (addr == REG_INTC_INTCCLR)
+		model_regs[REG_INTC_INTCFLAG0] &= ~val;
+	else
+		model_regs[addr % MODEL_N_REGS] = val;
+}
+
+static void model_frame(uint8_t *data, uint32_t len, uint64_t call_ns)
+{
+	uint64_t t = call_ns + len * 8 * 1000000000ull / MODEL_SCLK_HZ;
+	uint32_t i, val = 0;
+	uint32_t nb = model_reg32(model_addr) ? 4 : 2;
+
+	model_bus_ns += t;
+	model_now_ns += t;
+	model_update();
+
+	switch (data[0]) {
+	case SPICMD_SETADDR:
+		model_addr = no_os_get_unaligned_be16(&data[len - 2]);
+		break;
+	case SPICMD_WRITEREG:
+		for (i = 0; i < nb; i++)
+			val = val << 8 | data[1 + i];
+		model_reg_write(model_addr, val);
+		break;
+	case SPICMD_READREG:
+		val = model_reg_read(model_addr);
+		for (i = 0; i < nb; i++)
+			data[2 + i] = val >> (8 * (nb - 1 - i));
+		break;
+	case SPICMD_READFIFO:
+		for (i = 7; i + 4 <= len; i += 4)
+			no_os_put_unaligned_be32(model_pop(), &data[i]);
+		break;
+	}
+}
+
+static int32_t model_spi_write_and_read(struct no_os_spi_desc *desc,
+					uint8_t *data, uint16_t bytes_number)
+{
+	NO_OS_UNUSED_PARAM(desc);
+
+	model_transfers++;
+	model_frame(data, bytes_number, MODEL_CALL_NS);
+
+	return 0;
+}
+
+static int32_t model_spi_transfer(struct no_os_spi_desc *desc,
+				  struct no_os_spi_msg *msgs, uint32_t len)
+{
+	uint32_t i;
+
+	NO_OS_UNUSED_PARAM(desc);
+
+	model_transfers++;
+	for (i = 0; i < len; i++) {
+		memmove(msgs[i].rx_buff, msgs[i].tx_buff, msgs[i].bytes_number);
+		/* Only the first message pays the call overhead */
+		model_frame(msgs[i].rx_buff, msgs[i].bytes_number,
+			    i ? 0 : MODEL_CALL_NS);
+	}
+
+	return 0;
+}
+
+static const struct no_os_spi_platform_ops model_spi_ops = {
+	.write_and_read = model_spi_write_and_read,
+	.transfer = model_spi_transfer,
+};
+
+static int32_t model_gpio_get_value(struct no_os_gpio_desc *desc,
+				    uint8_t *value)
+{
+	NO_OS_UNUSED_PARAM(desc);
+
+	model_update();
+	*value = (model_regs[REG_INTC_INTCFLAG0] &
+		  model_regs[REG_INTC_INTCSEL0]) ? NO_OS_GPIO_LOW : NO_OS_GPIO_HIGH;
+
+	return 0;
+}
+
+static int32_t model_gpio_set_value(struct no_os_gpio_desc *desc,
+				    uint8_t value)
+{
+	NO_OS_UNUSED_PARAM(desc);
+	NO_OS_UNUSED_PARAM(value);
+
+	return 0;
+}
+
+static const struct no_os_gpio_platform_ops model_gpio_ops = {
+	.gpio_ops_get_value = model_gpio_get_value,
+	.gpio_ops_set_value = model_gpio_set_value,
+};
+
+void no_os_udelay(uint32_t usecs)
+{
+	model_now_ns += usecs * 1000ull;
+}
+
+void no_os_mdelay(uint32_t msecs)
+{
+	model_now_ns += msecs * 1000000ull;
+}
@@ -0,0 +1,351 @@
+/***************************************************************************//**
+ *   @file   test_ad5940_fifo_stream.c
+ *   @brief  Unit tests and benchmark for the AD5940 data FIFO stream.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <errno.h>
+#include "unity.h"
+#include "ad5940.h"
+#include "no_os_alloc.h"
+#include "no_os_circular_buffer.h"
+#include "no_os_delay.h"
+#include "no_os_gpio.h"
+#include "no_os_spi.h"
+#include "no_os_util.h"
+#include "ad5940_model.c"
+
+TEST_FILE("no_os_mutex.c")
+TEST_FILE("no_os_alloc.c")
+TEST_FILE("no_os_circular_buffer.c")
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define RING_WORDS	256
+#define THRESH		64
+#define NB_POINTS	2000
+#define PERIOD_NS	250000
+
+static struct no_os_spibus_desc bus;
+static struct no_os_spi_desc spi = {
+	.bus = &bus,
+	.platform_ops = &model_spi_ops,
+};
+static struct no_os_gpio_desc gp0 = {
+	.platform_ops = &model_gpio_ops,
+};
+static struct ad5940_dev dev;
+static struct ad5940_fifo_stream stream;
+static uint32_t ring[RING_WORDS];
+static struct ad5940_fifo_data data[RING_WORDS];
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static void wait_gp0(void)
+{
+	uint8_t val;
+
+	do {
+		TEST_ASSERT_EQUAL_INT(0, no_os_gpio_get_value(dev.gp0_gpio, &val));
+		if (val == NO_OS_GPIO_HIGH)
+			no_os_udelay(5);
+	} while (val == NO_OS_GPIO_HIGH);
+}
+
+/* FIFO handling of the BIA application: threshold flag, count, read, clear */
+static uint32_t legacy_isr(uint32_t *buf)
+{
+	uint32_t cnt;
+
+	TEST_ASSERT_TRUE(ad5940_INTCTestFlag(&dev, AFEINTC_0,
+					     AFEINTSRC_DATAFIFOTHRESH));
+	TEST_ASSERT_EQUAL_INT(0, ad5940_FIFOGetCnt(&dev, &cnt));
+	TEST_ASSERT_EQUAL_INT(0, ad5940_FIFORd(&dev, buf, cnt));
+	TEST_ASSERT_EQUAL_INT(0, ad5940_INTCClrFlag(&dev,
+			      AFEINTSRC_DATAFIFOTHRESH));
+
+	return cnt;
+}
+
+static void check_point(const struct ad5940_fifo_data *d, uint32_t p)
+{
+	iImpCar_Type v = model_volt(p);
+	iImpCar_Type i = model_curr(p);
+
+	TEST_ASSERT_EQUAL_INT(AD5940_FIFO_DFT, d[0].type);
+	TEST_ASSERT_EQUAL_INT(v.Real, d[0].val.Real);
+	TEST_ASSERT_EQUAL_INT(v.Image, d[0].val.Image);
+	TEST_ASSERT_EQUAL_INT(AD5940_FIFO_DFT, d[1].type);
+	TEST_ASSERT_EQUAL_INT(i.Real, d[1].val.Real);
+	TEST_ASSERT_EQUAL_INT(i.Image, d[1].val.Image);
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	memset(&dev, 0, sizeof(dev));
+	dev.spi = &spi;
+	dev.gp0_gpio = &gp0;
+	model_reset();
+}
+
+void tearDown(void)
+{
+	no_os_free(dev.fifo_buf);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_ad5940_fifo_stream_init(void)
+{
+	uint8_t *buf;
+	uint32_t i;
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ad5940_fifo_stream_init(&dev, &stream, ring,
+			      RING_WORDS, 2));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ad5940_fifo_stream_init(&dev, &stream, ring,
+			      THRESH - 1, THRESH));
+
+	model_regs[REG_INTC_INTCFLAG0] = AFEINTSRC_DATAFIFOOF;
+	TEST_ASSERT_EQUAL_INT(0, ad5940_fifo_stream_init(&dev, &stream, ring,
+			      RING_WORDS, THRESH));
+	TEST_ASSERT_EQUAL_UINT32(THRESH << BITP_AFE_DATAFIFOTHRES_HIGHTHRES,
+				 model_regs[REG_AFE_DATAFIFOTHRES]);
+	TEST_ASSERT_TRUE(model_regs[REG_INTC_INTCSEL0] & AFEINTSRC_DATAFIFOTHRESH);
+	TEST_ASSERT_EQUAL_UINT32(0, model_regs[REG_INTC_INTCFLAG0]);
+
+	/* The SPI buffer holds the whole FIFO, the handler never reallocates */
+	TEST_ASSERT_EQUAL_UINT32(AD5940_FIFO_BUF_MAX, dev.fifo_buf_sz);
+	buf = dev.fifo_buf;
+	for (i = 0; i < MODEL_FIFO_WORDS; i++)
+		model_push(i);
+	TEST_ASSERT_EQUAL_INT(RING_WORDS, ad5940_fifo_stream_isr(&dev, &stream));
+	TEST_ASSERT_EQUAL_PTR(buf, dev.fifo_buf);
+	TEST_ASSERT_EQUAL_UINT32(AD5940_FIFO_BUF_MAX, dev.fifo_buf_sz);
+}
+
+/* Words which reach the threshold while the FIFO is read keep GP0 low. */
+void test_ad5940_fifo_stream_rearm(void)
+{
+	uint8_t val;
+
+	TEST_ASSERT_EQUAL_INT(0, ad5940_fifo_stream_init(&dev, &stream, ring,
+			      RING_WORDS, THRESH));
+	/* One point every 4 us, faster than the FIFO is read */
+	model_start_sweep(NB_POINTS, 4000);
+	wait_gp0();
+
+	TEST_ASSERT_TRUE(ad5940_fifo_stream_isr(&dev, &stream) >= THRESH);
+	TEST_ASSERT_TRUE(model_fifo_cnt >= THRESH);
+	TEST_ASSERT_EQUAL_INT(0, no_os_gpio_get_value(dev.gp0_gpio, &val));
+	TEST_ASSERT_EQUAL_INT(NO_OS_GPIO_LOW, val);
+}
+
+/* The address and the data phases of a fast read share one transfer. */
+void test_ad5940_fifo_rd_fast(void)
+{
+	uint32_t buf[THRESH];
+	uint32_t i;
+
+	for (i = 0; i < THRESH; i++)
+		model_push(model_dft_word(i - THRESH / 2));
+
+	TEST_ASSERT_EQUAL_INT(0, ad5940_FIFORd(&dev, buf, THRESH));
+	TEST_ASSERT_EQUAL_UINT32(1, model_transfers);
+	TEST_ASSERT_EQUAL_UINT32(0, model_fifo_cnt);
+	for (i = 0; i < THRESH; i++)
+		TEST_ASSERT_EQUAL_UINT32(model_dft_word(i - THRESH / 2), buf[i]);
+
+	/* The SPI buffer is reused by the next reads */
+	TEST_ASSERT_EQUAL_UINT32(7 + THRESH * 4, dev.fifo_buf_sz);
+	for (i = 0; i < 4; i++)
+		model_push(i);
+	TEST_ASSERT_EQUAL_INT(0, ad5940_FIFORd(&dev, buf, 4));
+	TEST_ASSERT_EQUAL_UINT32(7 + THRESH * 4, dev.fifo_buf_sz);
+	TEST_ASSERT_EQUAL_UINT32(3, buf[3]);
+}
+
+/* ADC, DFT and statistic words are told apart, split DFT results merged. */
+void test_ad5940_fifo_stream_decode(void)
+{
+	TEST_ASSERT_EQUAL_INT(0, ad5940_fifo_stream_init(&dev, &stream, ring,
+			      RING_WORDS, 4));
+
+	model_push(NO_OS_BIT(FIFOWORD_SEQID_POS) | (5 << FIFOWORD_CHID_POS) |
+		   0x8123);
+	model_push(model_dft_word(-3));
+	model_push(model_dft_word(7));
+	model_push((FIFOWORD_TAG_MEAN << FIFOWORD_TAG_POS) | 0x3FFFF);
+	model_push((FIFOWORD_TAG_VAR << FIFOWORD_TAG_POS) | 100);
+	model_push(model_dft_word(11));
+	TEST_ASSERT_EQUAL_INT(6, ad5940_fifo_stream_isr(&dev, &stream));
+	TEST_ASSERT_EQUAL_UINT32(0, model_regs[REG_INTC_INTCFLAG0]);
+
+	TEST_ASSERT_EQUAL_INT(4, ad5940_fifo_stream_decode(&stream, data,
+			      RING_WORDS));
+	TEST_ASSERT_EQUAL_INT(AD5940_FIFO_ADC, data[0].type);
+	TEST_ASSERT_EQUAL_INT(1, data[0].seqid);
+	TEST_ASSERT_EQUAL_INT(5, data[0].chid);
+	TEST_ASSERT_EQUAL_INT(0x8123, data[0].val.Real);
+	TEST_ASSERT_EQUAL_INT(AD5940_FIFO_DFT, data[1].type);
+	TEST_ASSERT_EQUAL_INT(-3, data[1].val.Real);
+	TEST_ASSERT_EQUAL_INT(7, data[1].val.Image);
+	TEST_ASSERT_EQUAL_INT(AD5940_FIFO_MEAN, data[2].type);
+	TEST_ASSERT_EQUAL_INT(-1, data[2].val.Real);
+	TEST_ASSERT_EQUAL_INT(AD5940_FIFO_VAR, data[3].type);
+	TEST_ASSERT_EQUAL_INT(100, data[3].val.Real);
+
+	/* The imaginary part arrives with the next interrupt */
+	model_push(model_dft_word(-12));
+	model_push(0);
+	model_push(0);
+	model_push(0);
+	TEST_ASSERT_EQUAL_INT(4, ad5940_fifo_stream_isr(&dev, &stream));
+	TEST_ASSERT_EQUAL_INT(1, ad5940_fifo_stream_decode(&stream, data, 1));
+	TEST_ASSERT_EQUAL_INT(AD5940_FIFO_DFT, data[0].type);
+	TEST_ASSERT_EQUAL_INT(11, data[0].val.Real);
+	TEST_ASSERT_EQUAL_INT(-12, data[0].val.Image);
+	TEST_ASSERT_EQUAL_INT(3, ad5940_fifo_stream_decode(&stream, data,
+			      RING_WORDS));
+}
+
+/* The FIFO words that do not fit in the ring wait for the next call. */
+void test_ad5940_fifo_stream_ring_full(void)
+{
+	uint32_t i;
+
+	TEST_ASSERT_EQUAL_INT(0, ad5940_fifo_stream_init(&dev, &stream, ring,
+			      RING_WORDS, THRESH));
+	for (i = 0; i < RING_WORDS + THRESH; i++)
+		model_push(model_dft_word(i));
+
+	TEST_ASSERT_EQUAL_INT(RING_WORDS, ad5940_fifo_stream_isr(&dev, &stream));
+	TEST_ASSERT_EQUAL_UINT32(THRESH, model_fifo_cnt);
+	TEST_ASSERT_EQUAL_INT(0, ad5940_fifo_stream_isr(&dev, &stream));
+
+	TEST_ASSERT_EQUAL_INT(RING_WORDS / 2, ad5940_fifo_stream_decode(&stream,
+			      data, RING_WORDS));
+	TEST_ASSERT_EQUAL_INT(RING_WORDS - 2, data[RING_WORDS / 2 - 1].val.Real);
+	TEST_ASSERT_EQUAL_INT(THRESH, ad5940_fifo_stream_isr(&dev, &stream));
+	TEST_ASSERT_EQUAL_UINT32(0, stream.nb_overflows);
+}
+
+void test_ad5940_dft_to_impedance(void)
+{
+	fImpCar_Type rtia = {.Real = 200, .Image = 0};
+	fImpCar_Type z[2];
+	struct ad5940_fifo_data d[] = {
+		{.type = AD5940_FIFO_DFT, .val = {1000, 0}},
+		{.type = AD5940_FIFO_ADC, .val = {1, 0}},
+		{.type = AD5940_FIFO_DFT, .val = {500, 0}},
+		/* V = 1 + j, I = j: Z = (1 - j) * Rtia once conjugated back */
+		{.type = AD5940_FIFO_DFT, .val = {1000, -1000}},
+		{.type = AD5940_FIFO_DFT, .val = {0, -1000}},
+		{.type = AD5940_FIFO_DFT, .val = {1, 1}},
+	};
+
+	TEST_ASSERT_EQUAL_INT(2, ad5940_dft_to_impedance(d, NO_OS_ARRAY_SIZE(d),
+			      &rtia, z));
+	TEST_ASSERT_TRUE(z[0].Real > 399.99 && z[0].Real < 400.01);
+	TEST_ASSERT_TRUE(z[0].Image > -0.01 && z[0].Image < 0.01);
+	TEST_ASSERT_TRUE(z[1].Real > 199.99 && z[1].Real < 200.01);
+	TEST_ASSERT_TRUE(z[1].Image > -200.01 && z[1].Image < -199.99);
+}
+
+/*
+ * Sweep of NB_POINTS points read with the BIA application FIFO handling,
+ * 2 word threshold and count polling, then with the FIFO stream. The bus
+ * time gives the highest sweep rate the host could follow.
+ */
+void test_ad5940_fifo_stream_sweep(void)
+{
+	fImpCar_Type rtia = {.Real = 1000, .Image = 0};
+	fImpCar_Type z[RING_WORDS / 2];
+	uint32_t legacy_buf[MODEL_FIFO_WORDS];
+	uint64_t legacy_bus_ns, stream_bus_ns;
+	uint32_t words, points, i;
+	int n;
+
+	/* BIA application: FIFO threshold of 2 words */
+	model_regs[REG_AFE_DATAFIFOTHRES] = 2 << BITP_AFE_DATAFIFOTHRES_HIGHTHRES;
+	model_regs[REG_INTC_INTCSEL0] = AFEINTSRC_DATAFIFOTHRESH;
+	model_start_sweep(NB_POINTS, PERIOD_NS);
+	for (words = 0; words < NB_POINTS * 4;) {
+		wait_gp0();
+		words += legacy_isr(legacy_buf);
+	}
+	TEST_ASSERT_EQUAL_UINT32(NB_POINTS * 4, words);
+	TEST_ASSERT_FALSE(model_regs[REG_INTC_INTCFLAG0] & AFEINTSRC_DATAFIFOOF);
+	legacy_bus_ns = model_bus_ns;
+
+	model_reset();
+	TEST_ASSERT_EQUAL_INT(0, ad5940_fifo_stream_init(&dev, &stream, ring,
+			      RING_WORDS, THRESH));
+	model_start_sweep(NB_POINTS, PERIOD_NS);
+	for (points = 0; points < NB_POINTS;) {
+		wait_gp0();
+		TEST_ASSERT_TRUE(ad5940_fifo_stream_isr(&dev, &stream) >= THRESH);
+
+		n = ad5940_fifo_stream_decode(&stream, data, RING_WORDS);
+		TEST_ASSERT_TRUE(n > 0 && !(n % 2));
+		for (i = 0; i < (uint32_t)n; i += 2)
+			check_point(&data[i], points + i / 2);
+		TEST_ASSERT_EQUAL_INT(n / 2, ad5940_dft_to_impedance(data, n, &rtia,
+				      z));
+		points += n / 2;
+	}
+	TEST_ASSERT_EQUAL_UINT32(NB_POINTS, points);
+	TEST_ASSERT_EQUAL_UINT32(0, stream.nb_overflows);
+	stream_bus_ns = model_bus_ns;
+
+	printf("sweep of %u points at %u points/s\n", NB_POINTS,
+	       (uint32_t)(1000000000ull / PERIOD_NS));
+	printf("  legacy: bus %3u%%, up to %6u points/s\n",
+	       (uint32_t)(legacy_bus_ns * 100 / (NB_POINTS * (uint64_t)PERIOD_NS)),
+	       (uint32_t)(NB_POINTS * 1000000000ull / legacy_bus_ns));
+	printf("  stream: bus %3u%%, up to %6u points/s\n",
+	       (uint32_t)(stream_bus_ns * 100 / (NB_POINTS * (uint64_t)PERIOD_NS)),
+	       (uint32_t)(NB_POINTS * 1000000000ull / stream_bus_ns));
+	TEST_ASSERT_TRUE(stream_bus_ns * 5 < legacy_bus_ns);
+}
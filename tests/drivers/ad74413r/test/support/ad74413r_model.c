@@ -0,0 +1,307 @@
+/***************************************************************************//**
+ *   @file   ad74413r_model.c
+ *   @brief  Simulated AD74413R for the conversion stream tests.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "no_os_crc8.h"
+#include "no_os_delay.h"
+#include "no_os_spi.h"
+#include "no_os_util.h"
+#include "ad74413r.h"
+
+/*
+ * AD74413R register map and ADC sequencer on a simulated time base. Every
+ * 4 byte frame returns the register selected through READ_SELECT, and the
+ * next one when AUTO_RD_EN is set. The enabled ADC channels, then the
+ * enabled diagnostics, are converted one after the other with the
+ * conversion time of their rejection setting. The diagnostic function is
+ * taken from DIAG_ASSIGN when its slot starts. ADC_DATA_RDY is set at the
+ * end of every sequence.
+ *
+ * ADC channel x of sequence n reads n * 16 + x. Diagnostic x reads its
+ * function in bits 15:12 and the sequence number in bits 11:0.
+ */
+#define MODEL_N_REGS		0x80
+#define MODEL_SCLK_HZ		4000000
+#define MODEL_CALL_NS		5000
+#define MODEL_CS_NS		200
+#define MODEL_N_SLOTS		(AD74413R_N_CHANNELS + AD74413R_N_DIAG_CHANNELS)
+
+static const uint32_t model_conv_us[] = {50000, 208, 100000, 833};
+
+static uint8_t model_crc_table[NO_OS_CRC8_TABLE_SIZE];
+static uint16_t model_regs[MODEL_N_REGS];
+static uint8_t model_rd_ptr;
+static bool model_rd_auto;
+static uint64_t model_now_ns;
+static bool model_running;
+static bool model_cont;
+static uint32_t model_seq;
+static uint32_t model_slot;
+static uint8_t model_slot_src;
+static uint64_t model_slot_end_ns;
+static uint32_t model_transfers;
+static uint32_t model_crc_errors;
+
+static void model_reset(void)
+{
+	no_os_crc8_populate_msb(model_crc_table, 0x7);
+	memset(model_regs, 0, sizeof(model_regs));
+	model_rd_ptr = 0;
+	model_rd_auto = false;
+	model_now_ns = 0;
+	model_running = false;
+	model_cont = false;
+	model_seq = 0;
+	model_transfers = 0;
+	model_crc_errors = 0;
+}
+
+static bool model_slot_enabled(uint32_t slot)
+{
+	if (slot < AD74413R_N_CHANNELS)
+		return model_regs[AD74413R_ADC_CONV_CTRL] & NO_OS_BIT(slot);
+
+	return model_regs[AD74413R_ADC_CONV_CTRL] &
+	       AD74413R_DIAG_EN_MASK(slot - AD74413R_N_CHANNELS);
+}
+
+static uint64_t model_slot_ns(uint32_t slot)
+{
+	uint32_t rej;
+
+	if (slot < AD74413R_N_CHANNELS)
+		rej = no_os_field_get(AD74413R_ADC_REJECTION_MASK,
+				      model_regs[AD74413R_ADC_CONFIG(slot)]);
+	else if (model_regs[AD74413R_ADC_CONV_CTRL] & AD74413R_EN_REJ_DIAG_MASK)
+		rej = AD74413R_REJECTION_50_60;
+	else
+		rej = AD74413R_REJECTION_NONE;
+
+	return model_conv_us[rej] * 1000ull;
+}
+
+/* Start the first enabled slot at or after slot, false if there is none */
+static bool model_next_slot(uint32_t slot, uint64_t start_ns)
+{
+	uint32_t diag;
+
+	for (; slot < MODEL_N_SLOTS; slot++) {
+		if (!model_slot_enabled(slot))
+			continue;
+
+		if (slot >= AD74413R_N_CHANNELS) {
+			diag = slot - AD74413R_N_CHANNELS;
+			model_slot_src = no_os_field_get(AD74413R_DIAG_ASSIGN_MASK(diag),
+							 model_regs[AD74413R_DIAG_ASSIGN]);
+		}
+		model_slot = slot;
+		model_slot_end_ns = start_ns + model_slot_ns(slot);
+
+		return true;
+	}
+
+	return false;
+}
+
+static void model_update(void)
+{
+	uint64_t end_ns;
+	uint32_t diag;
+
+	while (model_running && model_now_ns >= model_slot_end_ns) {
+		end_ns = model_slot_end_ns;
+		if (model_slot < AD74413R_N_CHANNELS) {
+			model_regs[AD74413R_ADC_RESULT(model_slot)] =
+				model_seq * 16 + model_slot;
+		} else {
+			diag = model_slot - AD74413R_N_CHANNELS;
+			model_regs[AD74413R_DIAG_RESULT(diag)] =
+				(model_slot_src << 12) | (model_seq & 0xFFF);
+		}
+
+		if (model_next_slot(model_slot + 1, end_ns))
+			continue;
+
+		model_regs[AD74413R_LIVE_STATUS] |= AD74413R_ADC_DATA_RDY_MASK;
+		model_seq++;
+		if (!model_cont || !model_next_slot(0, end_ns))
+			model_running = false;
+	}
+}
+
+static void model_conv_ctrl(uint16_t val)
+{
+	uint16_t prev = no_os_field_get(AD74413R_CONV_SEQ_MASK,
+					model_regs[AD74413R_ADC_CONV_CTRL]);
+	uint16_t seq = no_os_field_get(AD74413R_CONV_SEQ_MASK, val);
+
+	model_regs[AD74413R_ADC_CONV_CTRL] = val;
+	if (seq == prev)
+		return;
+
+	model_running = false;
+	if (seq != AD74413R_START_SINGLE && seq != AD74413R_START_CONT)
+		return;
+
+	model_cont = seq == AD74413R_START_CONT;
+	model_running = model_next_slot(0, model_now_ns);
+}
+
+static void model_frame(uint8_t *frame)
+{
+	uint8_t addr = frame[0];
+	uint16_t val = no_os_get_unaligned_be16(&frame[1]);
+
+	if (no_os_crc8(model_crc_table, frame, 3, 0) != frame[3])
+		model_crc_errors++;
+
+	model_now_ns += AD74413R_FRAME_SIZE * 8 * 1000000000ull / MODEL_SCLK_HZ +
+			MODEL_CS_NS;
+	model_update();
+
+	frame[0] = model_rd_ptr;
+	no_os_put_unaligned_be16(model_regs[model_rd_ptr % MODEL_N_REGS],
+				 &frame[1]);
+	frame[3] = no_os_crc8(model_crc_table, frame, 3, 0);
+	if (model_rd_auto)
+		model_rd_ptr++;
+
+	switch (addr) {
+	case AD74413R_NOP:
+	case AD74413R_CMD_KEY:
+		break;
+	case AD74413R_READ_SELECT:
+		model_rd_ptr = val;
+		model_rd_auto = val & AD74413R_AUTO_RD_EN_MASK;
+		break;
+	case AD74413R_LIVE_STATUS:
+		model_regs[addr] &= ~val;
+		break;
+	case AD74413R_ADC_CONV_CTRL:
+		model_conv_ctrl(val);
+		break;
+	default:
+		model_regs[addr % MODEL_N_REGS] = val;
+		break;
+	}
+}
+
+static int32_t model_spi_init(struct no_os_spi_desc **desc,
+			      const struct no_os_spi_init_param *param)
+{
+	NO_OS_UNUSED_PARAM(param);
+
+	*desc = calloc(1, sizeof(**desc));
+
+	return *desc ? 0 : -ENOMEM;
+}
+
+static int32_t model_spi_remove(struct no_os_spi_desc *desc)
+{
+	free(desc);
+
+	return 0;
+}
+
+static int32_t model_spi_write_and_read(struct no_os_spi_desc *desc,
+					uint8_t *data, uint16_t bytes_number)
+{
+	uint16_t i;
+
+	NO_OS_UNUSED_PARAM(desc);
+
+	model_transfers++;
+	model_now_ns += MODEL_CALL_NS;
+	for (i = 0; i + AD74413R_FRAME_SIZE <= bytes_number;
+	     i += AD74413R_FRAME_SIZE)
+		model_frame(&data[i]);
+
+	return 0;
+}
+
+static int32_t model_spi_transfer(struct no_os_spi_desc *desc,
+				  struct no_os_spi_msg *msgs, uint32_t len)
+{
+	uint32_t i;
+
+	NO_OS_UNUSED_PARAM(desc);
+
+	model_transfers++;
+	model_now_ns += MODEL_CALL_NS;
+	for (i = 0; i < len; i++) {
+		if (msgs[i].rx_buff != msgs[i].tx_buff)
+			memcpy(msgs[i].rx_buff, msgs[i].tx_buff,
+			       msgs[i].bytes_number);
+		model_frame(msgs[i].rx_buff);
+	}
+
+	return 0;
+}
+
+static const struct no_os_spi_platform_ops model_spi_ops = {
+	.init = model_spi_init,
+	.remove = model_spi_remove,
+	.write_and_read = model_spi_write_and_read,
+	.transfer = model_spi_transfer,
+};
+
+/* A controller without transfer op, served by the no_os_spi_transfer() fallback */
+static const struct no_os_spi_platform_ops model_spi_wr_ops = {
+	.init = model_spi_init,
+	.remove = model_spi_remove,
+	.write_and_read = model_spi_write_and_read,
+};
+
+void no_os_udelay(uint32_t usecs)
+{
+	model_now_ns += usecs * 1000ull;
+}
+
+void no_os_mdelay(uint32_t msecs)
+{
+	model_now_ns += msecs * 1000000ull;
+}
+
+struct no_os_time no_os_get_time(void)
+{
+	struct no_os_time t = {
+		.s = model_now_ns / 1000000000ull,
+		.us = model_now_ns / 1000 % 1000000,
+	};
+
+	return t;
+}
@@ -0,0 +1,278 @@
+/***************************************************************************//**
+ *   @file   test_ad74413r_stream.c
+ *   @brief  Unit tests and benchmark for the AD74413R conversion stream.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <errno.h>
+#include "unity.h"
+#include "ad74413r.h"
+#include "no_os_delay.h"
+#include "no_os_spi.h"
+#include "no_os_util.h"
+#include "ad74413r_model.c"
+
+TEST_FILE("no_os_gpio.c")
+TEST_FILE("no_os_mutex.c")
+TEST_FILE("no_os_alloc.c")
+TEST_FILE("no_os_crc8.c")
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define NB_SEQ		50
+#define WAIT_US		200000
+
+static struct ad74413r_init_param init_param = {
+	.chip_id = AD74413R,
+	.comm_param = {
+		.max_speed_hz = MODEL_SCLK_HZ,
+		.platform_ops = &model_spi_ops,
+	},
+};
+static struct ad74413r_desc *desc;
+static struct ad74413r_stream stream;
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static void set_rejection(uint32_t ch_mask, enum ad74413r_rejection rej)
+{
+	uint32_t ch;
+
+	for (ch = 0; ch < AD74413R_N_CHANNELS; ch++)
+		if (ch_mask & NO_OS_BIT(ch))
+			TEST_ASSERT_EQUAL_INT(0, ad74413r_set_adc_rejection(desc, ch,
+					      rej));
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	model_reset();
+	TEST_ASSERT_EQUAL_INT(0, ad74413r_init(&desc, &init_param));
+	set_rejection(0xF, AD74413R_REJECTION_NONE);
+	memset(&stream, 0, sizeof(stream));
+	model_transfers = 0;
+}
+
+void tearDown(void)
+{
+	TEST_ASSERT_EQUAL_INT(0, ad74413r_remove(desc));
+	TEST_ASSERT_EQUAL_UINT32(0, model_crc_errors);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+/* DIN_COMP_OUT up to DIAG_RESULT3 are read with one transfer. */
+void test_ad74413r_reg_read_burst(void)
+{
+	uint8_t frames[AD74413R_BURST_MAX * AD74413R_FRAME_SIZE];
+	uint32_t i;
+
+	for (i = 0; i < AD74413R_BURST_MAX; i++)
+		model_regs[AD74413R_DIN_COMP_OUT + i] = 0x1100 * (i + 1);
+
+	TEST_ASSERT_EQUAL_INT(0, ad74413r_reg_read_burst(desc,
+				 AD74413R_DIN_COMP_OUT,
+				 AD74413R_BURST_MAX, frames));
+	TEST_ASSERT_EQUAL_UINT32(1, model_transfers);
+	for (i = 0; i < AD74413R_BURST_MAX; i++) {
+		TEST_ASSERT_EQUAL_INT(AD74413R_DIN_COMP_OUT + i,
+				      frames[i * AD74413R_FRAME_SIZE]);
+		TEST_ASSERT_EQUAL_INT(0x1100 * (i + 1),
+				      no_os_get_unaligned_be16(&frames[i * AD74413R_FRAME_SIZE + 1]));
+	}
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ad74413r_reg_read_burst(desc,
+			      AD74413R_DIN_COMP_OUT, 0, frames));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ad74413r_reg_read_burst(desc,
+			      AD74413R_DIN_COMP_OUT,
+			      AD74413R_BURST_MAX + 1, frames));
+}
+
+/* Controllers without a transfer op get the frames one by one, in place. */
+void test_ad74413r_reg_read_burst_no_transfer(void)
+{
+	uint8_t frames[AD74413R_BURST_MAX * AD74413R_FRAME_SIZE];
+	uint32_t i;
+
+	for (i = 0; i < AD74413R_BURST_MAX; i++)
+		model_regs[AD74413R_DIN_COMP_OUT + i] = 0x1100 * (i + 1);
+
+	desc->comm_desc->platform_ops = &model_spi_wr_ops;
+	TEST_ASSERT_EQUAL_INT(0, ad74413r_reg_read_burst(desc,
+				 AD74413R_DIN_COMP_OUT,
+				 AD74413R_BURST_MAX, frames));
+	TEST_ASSERT_EQUAL_UINT32(AD74413R_BURST_MAX + 1, model_transfers);
+	for (i = 0; i < AD74413R_BURST_MAX; i++)
+		TEST_ASSERT_EQUAL_INT(0x1100 * (i + 1),
+				      no_os_get_unaligned_be16(&frames[i * AD74413R_FRAME_SIZE + 1]));
+	desc->comm_desc->platform_ops = &model_spi_ops;
+}
+
+void test_ad74413r_stream_invalid(void)
+{
+	static const enum ad74413r_diag_mode rr[] = {AD74413R_DIAG_AGND};
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ad74413r_stream_start(desc, &stream));
+
+	stream.ch_mask = NO_OS_BIT(4);
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ad74413r_stream_start(desc, &stream));
+
+	stream.ch_mask = 0x1;
+	stream.nb_rr_diag = 1;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ad74413r_stream_start(desc, &stream));
+
+	stream.rr_diag = rr;
+	stream.rr_ch = AD74413R_N_DIAG_CHANNELS;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ad74413r_stream_start(desc, &stream));
+	TEST_ASSERT_FALSE(model_running);
+}
+
+/* Every sequence is read once, with all channels from the same sequence. */
+void test_ad74413r_stream_continuous(void)
+{
+	uint16_t data[AD74413R_N_CHANNELS + AD74413R_N_DIAG_CHANNELS];
+	uint32_t seq, ch;
+
+	stream.ch_mask = 0xF;
+	stream.diag_mask = NO_OS_BIT(2);
+	TEST_ASSERT_EQUAL_INT(0, ad74413r_stream_start(desc, &stream));
+	TEST_ASSERT_TRUE(model_running);
+	TEST_ASSERT_TRUE(desc->channel_configs[3].enabled);
+
+	for (seq = 0; seq < NB_SEQ; seq++) {
+		TEST_ASSERT_EQUAL_INT(0, ad74413r_stream_wait(desc, WAIT_US));
+		model_transfers = 0;
+		TEST_ASSERT_EQUAL_INT(5, ad74413r_stream_read(desc, &stream, data));
+		TEST_ASSERT_EQUAL_UINT32(1, model_transfers);
+
+		for (ch = 0; ch < AD74413R_N_CHANNELS; ch++)
+			TEST_ASSERT_EQUAL_INT(seq * 16 + ch, data[ch]);
+		TEST_ASSERT_EQUAL_INT(seq, data[4] & 0xFFF);
+	}
+
+	TEST_ASSERT_EQUAL_INT(0, ad74413r_stream_stop(desc, &stream));
+	TEST_ASSERT_FALSE(model_running);
+	TEST_ASSERT_FALSE(desc->channel_configs[3].enabled);
+	TEST_ASSERT_EQUAL_INT(0, model_regs[AD74413R_ADC_CONV_CTRL] &
+			      NO_OS_GENMASK(7, 0));
+}
+
+void test_ad74413r_stream_wait_timeout(void)
+{
+	stream.ch_mask = 0x1;
+	set_rejection(0x1, AD74413R_REJECTION_50_60_HART);
+	TEST_ASSERT_EQUAL_INT(0, ad74413r_stream_start(desc, &stream));
+
+	TEST_ASSERT_EQUAL_INT(-ETIMEDOUT, ad74413r_stream_wait(desc, 1000));
+	TEST_ASSERT_EQUAL_INT(0, ad74413r_stream_wait(desc, WAIT_US));
+}
+
+/*
+ * The round-robin diagnostic measures a different function in every
+ * sequence, and rr_result tells which one was read.
+ */
+void test_ad74413r_stream_round_robin(void)
+{
+	static const enum ad74413r_diag_mode rr[] = {
+		AD74413R_DIAG_TEMP, AD74413R_DIAG_AVDD, AD74413R_DIAG_DVCC,
+	};
+	uint16_t data[AD74413R_N_CHANNELS + AD74413R_N_DIAG_CHANNELS];
+	uint32_t seq;
+
+	stream.ch_mask = 0x3;
+	stream.rr_ch = 1;
+	stream.rr_diag = rr;
+	stream.nb_rr_diag = NO_OS_ARRAY_SIZE(rr);
+	TEST_ASSERT_EQUAL_INT(0, ad74413r_stream_start(desc, &stream));
+
+	for (seq = 0; seq < NB_SEQ; seq++) {
+		TEST_ASSERT_EQUAL_INT(0, ad74413r_stream_wait(desc, WAIT_US));
+		TEST_ASSERT_EQUAL_INT(3, ad74413r_stream_read(desc, &stream, data));
+
+		TEST_ASSERT_EQUAL_INT(seq * 16 + 1, data[1]);
+		TEST_ASSERT_EQUAL_INT(rr[seq % NO_OS_ARRAY_SIZE(rr)],
+				      stream.rr_result);
+		TEST_ASSERT_EQUAL_INT(stream.rr_result, data[2] >> 12);
+		TEST_ASSERT_EQUAL_INT(seq, data[2] & 0xFFF);
+	}
+
+	TEST_ASSERT_EQUAL_INT(0, ad74413r_stream_stop(desc, &stream));
+}
+
+/* Samples per second of each channel, single conversions against a stream. */
+void test_ad74413r_stream_rate(void)
+{
+	uint16_t data[AD74413R_N_CHANNELS + AD74413R_N_DIAG_CHANNELS];
+	uint32_t single_sps, stream_sps;
+	uint32_t nb, seq, ch;
+	uint64_t start;
+	uint16_t val;
+
+	printf("channels  single [SPS]  stream [SPS]\n");
+	for (nb = 1; nb <= AD74413R_N_CHANNELS; nb++) {
+		start = model_now_ns;
+		for (seq = 0; seq < NB_SEQ; seq++)
+			for (ch = 0; ch < nb; ch++)
+				TEST_ASSERT_EQUAL_INT(0, ad74413r_get_adc_single(desc, ch,
+						      &val, false));
+		single_sps = NB_SEQ * 1000000000ull / (model_now_ns - start);
+
+		memset(&stream, 0, sizeof(stream));
+		stream.ch_mask = NO_OS_GENMASK(nb - 1, 0);
+		TEST_ASSERT_EQUAL_INT(0, ad74413r_stream_start(desc, &stream));
+		TEST_ASSERT_EQUAL_INT(0, ad74413r_stream_wait(desc, WAIT_US));
+		start = model_now_ns;
+		for (seq = 0; seq < NB_SEQ; seq++) {
+			TEST_ASSERT_EQUAL_INT(0, ad74413r_stream_wait(desc, WAIT_US));
+			TEST_ASSERT_EQUAL_INT(nb, ad74413r_stream_read(desc, &stream,
+					      data));
+		}
+		stream_sps = NB_SEQ * 1000000000ull / (model_now_ns - start);
+		TEST_ASSERT_EQUAL_INT(0, ad74413r_stream_stop(desc, &stream));
+
+		printf("%8u  %12u  %12u\n", nb, single_sps, stream_sps);
+		TEST_ASSERT_TRUE(stream_sps > single_sps);
+	}
+}
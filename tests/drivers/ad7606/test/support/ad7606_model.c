@@ -0,0 +1,147 @@
+/***************************************************************************//**
+ *   @file   ad7606_model.c
+ *   @brief  Behavioral model of the AD7606 serial data interface.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "no_os_gpio.h"
+#include "no_os_spi.h"
+
+/*
+ * AD7606C-18 serial interface seen from the capture engine. CONVST rising
+ * starts a conversion, BUSY is high for model_tconv_us after it and the
+ * output register is updated when BUSY falls. Conversion n returns
+ * n * 8 + ch on the even channels and the negated value on the odd ones.
+ */
+#define MODEL_CONVST		0
+#define MODEL_BUSY		1
+#define MODEL_CHANNELS		8
+#define MODEL_BITS		18
+
+static uint32_t model_tconv_us;
+static uint32_t model_read_us;
+static uint32_t model_started;
+static uint64_t model_start_ns;
+
+static uint64_t model_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static void model_reset(uint32_t tconv_us, uint32_t read_us)
+{
+	model_tconv_us = tconv_us;
+	model_read_us = read_us;
+	model_started = 0;
+	model_start_ns = 0;
+}
+
+static int32_t model_sample(uint32_t conv, uint32_t ch)
+{
+	int32_t val = conv * MODEL_CHANNELS + ch;
+
+	return (ch & 1) ? -val : val;
+}
+
+static bool model_busy(void)
+{
+	return model_started &&
+	       model_now() - model_start_ns < model_tconv_us * 1000ull;
+}
+
+/* Pack MSB first, width bits per value */
+static void model_pack(uint8_t *buf, const uint32_t *vals, uint32_t nb,
+		       uint32_t width)
+{
+	uint32_t i, b, pos = 0;
+
+	memset(buf, 0, (nb * width + 7) / 8);
+	for (i = 0; i < nb; i++) {
+		for (b = 0; b < width; b++, pos++) {
+			if (vals[i] & (1u << (width - 1 - b)))
+				buf[pos / 8] |= 0x80 >> (pos % 8);
+		}
+	}
+}
+
+static int32_t model_spi_transfer(struct no_os_spi_desc *desc,
+				  struct no_os_spi_msg *msgs, uint32_t len)
+{
+	uint32_t vals[MODEL_CHANNELS];
+	uint32_t conv, ch;
+	uint64_t end;
+
+	/* Output register of the last finished conversion */
+	conv = model_busy() ? model_started - 1 : model_started;
+	for (ch = 0; ch < MODEL_CHANNELS; ch++)
+		vals[ch] = model_sample(conv, ch) &
+			   NO_OS_GENMASK(MODEL_BITS - 1, 0);
+	model_pack(msgs[0].rx_buff, vals, MODEL_CHANNELS, MODEL_BITS);
+
+	end = model_now() + model_read_us * 1000ull;
+	while (model_now() < end)
+		;
+
+	return 0;
+}
+
+static int32_t model_gpio_set_value(struct no_os_gpio_desc *desc,
+				    uint8_t value)
+{
+	if (desc->number == MODEL_CONVST && value && !model_busy()) {
+		model_started++;
+		model_start_ns = model_now();
+	}
+
+	return 0;
+}
+
+static int32_t model_gpio_get_value(struct no_os_gpio_desc *desc,
+				    uint8_t *value)
+{
+	*value = desc->number == MODEL_BUSY && model_busy();
+
+	return 0;
+}
+
+static const struct no_os_spi_platform_ops model_spi_ops = {
+	.transfer = model_spi_transfer,
+};
+
+static const struct no_os_gpio_platform_ops model_gpio_ops = {
+	.gpio_ops_set_value = model_gpio_set_value,
+	.gpio_ops_get_value = model_gpio_get_value,
+};
@@ -0,0 +1,311 @@
+/***************************************************************************//**
+ *   @file   test_ad7606_capture.c
+ *   @brief  Unit tests for the AD7606 continuous capture.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include "unity.h"
+#include "ad7606.h"
+#include "ad7606_capture.h"
+#include "no_os_util.h"
+#include "ad7606_model.c"
+
+TEST_FILE("linux_delay.c")
+TEST_FILE("linux_gpio.c")
+TEST_FILE("linux_thread.c")
+TEST_FILE("no_os_crc8.c")
+TEST_FILE("no_os_crc16.c")
+TEST_FILE("no_os_unpack.c")
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define RATE_HZ		10000
+#define BLOCK_FRAMES	32
+
+static struct no_os_spi_desc spi = {
+	.platform_ops = &model_spi_ops,
+};
+static struct no_os_gpio_desc convst = {
+	.number = MODEL_CONVST,
+	.platform_ops = &model_gpio_ops,
+};
+static struct no_os_gpio_desc busy = {
+	.number = MODEL_BUSY,
+	.platform_ops = &model_gpio_ops,
+};
+static struct ad7606_dev dev;
+static struct ad7606_capture *cap;
+
+static void sleep_ms(uint32_t ms)
+{
+	struct timespec ts = {
+		.tv_sec = ms / 1000,
+		.tv_nsec = (ms % 1000) * 1000000,
+	};
+
+	nanosleep(&ts, NULL);
+}
+
+/* Conversion index of a frame, checking that it matches the model pattern */
+static int32_t frame_conv(const int32_t *frame)
+{
+	uint32_t ch;
+	int32_t conv = frame[0] / MODEL_CHANNELS;
+
+	for (ch = 0; ch < MODEL_CHANNELS; ch++)
+		TEST_ASSERT_EQUAL_INT(model_sample(conv, ch), frame[ch]);
+
+	return conv;
+}
+
+static void capture_setup(uint32_t nb_blocks, bool read_during_conv)
+{
+	struct ad7606_capture_init_param param = {
+		.rate_hz = RATE_HZ,
+		.block_frames = BLOCK_FRAMES,
+		.nb_blocks = nb_blocks,
+		.read_during_conv = read_during_conv,
+	};
+
+	TEST_ASSERT_EQUAL_INT(0, ad7606_capture_init(&cap, &dev, &param));
+	TEST_ASSERT_EQUAL_INT(8 * 18 / 8, cap->frame_size);
+}
+
+/*******************************************************************************
+ *    SETUP, TESTING AND TEARDOWN FUNCTIONS
+ ******************************************************************************/
+
+void setUp(void)
+{
+	memset(&dev, 0, sizeof(dev));
+	dev.device_id = ID_AD7606C_18;
+	dev.num_channels = MODEL_CHANNELS;
+	dev.spi_desc = &spi;
+	dev.gpio_convst = &convst;
+	dev.gpio_busy = &busy;
+	cap = NULL;
+	model_reset(5, 0);
+}
+
+void tearDown(void)
+{
+	if (cap)
+		ad7606_capture_remove(cap);
+}
+
+/*******************************************************************************
+ *    UNIT TESTS
+ ******************************************************************************/
+
+void test_ad7606_frame_decode(void)
+{
+	uint32_t vals[MODEL_CHANNELS] = {
+		0x1FFFF, 0x20000, 0x3FFFF, 0, 1, 0x3FFFE, 0x2ABCD, 0x12345
+	};
+	int32_t expected[MODEL_CHANNELS] = {
+		131071, -131072, 0x3FFFF, 0, 1, -2, -87091, 74565
+	};
+	int32_t data[MODEL_CHANNELS];
+	uint8_t frame[18];
+
+	/* Channel 2 is unipolar, so it is not sign-extended */
+	dev.range_ch_type[2] = AD7606_SW_RANGE_SINGLE_ENDED_UNIPOLAR;
+	model_pack(frame, vals, MODEL_CHANNELS, 18);
+
+	TEST_ASSERT_EQUAL_INT(18, ad7606_spi_frame_size(&dev));
+	TEST_ASSERT_EQUAL_INT(0, ad7606_spi_frame_decode(&dev, frame, data));
+	TEST_ASSERT_EQUAL_INT_ARRAY(expected, data, MODEL_CHANNELS);
+}
+
+void test_ad7606_frame_decode_status(void)
+{
+	uint32_t vals[4] = { 0xFFFB3A, 0x000501, 0x7FFF00, 0x8000FF };
+	int32_t expected[4] = {
+		(int32_t)0xFFFFFB3A, 0x000501, 0x7FFF00, (int32_t)0xFF8000FF
+	};
+	int32_t data[4];
+	uint8_t frame[12];
+
+	/* 16 bit samples followed by the status byte */
+	dev.device_id = ID_AD7606_4;
+	dev.num_channels = 4;
+	dev.config.status_header = true;
+	model_pack(frame, vals, 4, 24);
+
+	TEST_ASSERT_EQUAL_INT(12, ad7606_spi_frame_size(&dev));
+	TEST_ASSERT_EQUAL_INT(0, ad7606_spi_frame_decode(&dev, frame, data));
+	TEST_ASSERT_EQUAL_INT_ARRAY(expected, data, 4);
+}
+
+void test_ad7606_capture_stream(void)
+{
+	struct ad7606_capture_stats stats;
+	int32_t *block;
+	int32_t conv, prev = 0;
+	uint32_t i, j;
+
+	capture_setup(8, false);
+	TEST_ASSERT_EQUAL_INT(0, ad7606_capture_start(cap));
+
+	for (i = 0; i < 16; i++) {
+		TEST_ASSERT_EQUAL_INT(0, ad7606_capture_get_block(cap, &block,
+				      1000));
+		for (j = 0; j < BLOCK_FRAMES; j++) {
+			conv = frame_conv(block + j * MODEL_CHANNELS);
+			TEST_ASSERT_TRUE(conv > prev);
+			prev = conv;
+		}
+		TEST_ASSERT_EQUAL_INT(0, ad7606_capture_put_block(cap));
+	}
+
+	TEST_ASSERT_EQUAL_INT(0, ad7606_capture_stop(cap));
+	TEST_ASSERT_EQUAL_INT(0, ad7606_capture_get_stats(cap, &stats));
+
+	TEST_ASSERT_TRUE(stats.frames >= 16 * BLOCK_FRAMES);
+	TEST_ASSERT_EQUAL_INT(0, stats.busy_timeouts);
+	TEST_ASSERT_EQUAL_INT(0, stats.crc_errors);
+	TEST_ASSERT_EQUAL_INT(stats.missed + stats.overflows, stats.dropped);
+	/* Every conversion that was started is accounted for */
+	TEST_ASSERT_TRUE(model_started >= stats.frames);
+	TEST_ASSERT_TRUE(stats.rate_hz > RATE_HZ / 2);
+	TEST_ASSERT_TRUE(stats.rate_hz <= RATE_HZ + RATE_HZ / 10);
+	TEST_ASSERT_TRUE(stats.cpu_load <= 100);
+}
+
+void test_ad7606_capture_overflow(void)
+{
+	struct ad7606_capture_stats stats;
+	int32_t *block;
+	uint32_t j;
+
+	capture_setup(2, false);
+	TEST_ASSERT_EQUAL_INT(0, ad7606_capture_start(cap));
+
+	/* 2 blocks are filled in 6.4ms, the rest does not fit */
+	sleep_ms(30);
+	TEST_ASSERT_EQUAL_INT(0, ad7606_capture_stop(cap));
+	TEST_ASSERT_EQUAL_INT(0, ad7606_capture_get_stats(cap, &stats));
+	TEST_ASSERT_EQUAL_INT(2 * BLOCK_FRAMES, stats.frames);
+	TEST_ASSERT_TRUE(stats.overflows > 0);
+
+	/* The queued blocks were not overwritten */
+	TEST_ASSERT_EQUAL_INT(0, ad7606_capture_get_block(cap, &block, 0));
+	for (j = 0; j < BLOCK_FRAMES; j++)
+		TEST_ASSERT_EQUAL_INT(j + 1,
+				      frame_conv(block + j * MODEL_CHANNELS));
+	TEST_ASSERT_EQUAL_INT(0, ad7606_capture_put_block(cap));
+	TEST_ASSERT_EQUAL_INT(0, ad7606_capture_get_block(cap, &block, 0));
+	TEST_ASSERT_EQUAL_INT(0, ad7606_capture_put_block(cap));
+	TEST_ASSERT_EQUAL_INT(-ENODATA,
+			      ad7606_capture_get_block(cap, &block, 0));
+}
+
+void test_ad7606_capture_set_buffer(void)
+{
+	/* Channels 1, 4 and 6, as stored in an IIO block */
+	const uint32_t mask = NO_OS_BIT(1) | NO_OS_BIT(4) | NO_OS_BIT(6);
+	static int32_t mem[3][BLOCK_FRAMES][3];
+	int32_t *block, conv;
+	uint32_t i, j;
+
+	capture_setup(8, false);
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ad7606_capture_set_buffer(cap, mem, 3,
+			      BLOCK_FRAMES, 0));
+	TEST_ASSERT_EQUAL_INT(0, ad7606_capture_set_buffer(cap, mem, 3,
+			      BLOCK_FRAMES, mask));
+	TEST_ASSERT_EQUAL_INT(0, ad7606_capture_start(cap));
+	TEST_ASSERT_EQUAL_INT(-EBUSY, ad7606_capture_set_buffer(cap, NULL, 0,
+			      0, 0));
+
+	for (i = 0; i < 4; i++) {
+		TEST_ASSERT_EQUAL_INT(0, ad7606_capture_get_block(cap, &block,
+				      1000));
+		TEST_ASSERT_TRUE(block == mem[i % 3][0]);
+		for (j = 0; j < BLOCK_FRAMES; j++) {
+			conv = block[j * 3 + 1] / MODEL_CHANNELS;
+			TEST_ASSERT_EQUAL_INT(model_sample(conv, 1),
+					      block[j * 3]);
+			TEST_ASSERT_EQUAL_INT(model_sample(conv, 4),
+					      block[j * 3 + 1]);
+			TEST_ASSERT_EQUAL_INT(model_sample(conv, 6),
+					      block[j * 3 + 2]);
+		}
+		TEST_ASSERT_EQUAL_INT(0, ad7606_capture_put_block(cap));
+	}
+
+	TEST_ASSERT_EQUAL_INT(0, ad7606_capture_stop(cap));
+
+	/* Back to the allocated queue with all channels */
+	TEST_ASSERT_EQUAL_INT(0, ad7606_capture_set_buffer(cap, NULL, 0, 0, 0));
+	TEST_ASSERT_EQUAL_INT(0, ad7606_capture_start(cap));
+	TEST_ASSERT_EQUAL_INT(0, ad7606_capture_get_block(cap, &block, 1000));
+	TEST_ASSERT_TRUE(block == cap->queue);
+	frame_conv(block);
+	TEST_ASSERT_EQUAL_INT(0, ad7606_capture_stop(cap));
+}
+
+void test_ad7606_capture_read_during_conv(void)
+{
+	struct ad7606_capture_stats stats;
+	int32_t *block;
+	uint32_t j;
+
+	/* Reading takes less than the conversion, frame k comes during k + 1 */
+	model_reset(40, 5);
+	capture_setup(4, true);
+	TEST_ASSERT_EQUAL_INT(0, ad7606_capture_start(cap));
+	TEST_ASSERT_EQUAL_INT(0, ad7606_capture_get_block(cap, &block, 1000));
+	for (j = 1; j < BLOCK_FRAMES; j++)
+		TEST_ASSERT_TRUE(frame_conv(block + j * MODEL_CHANNELS) >
+				 frame_conv(block + (j - 1) * MODEL_CHANNELS));
+	TEST_ASSERT_EQUAL_INT(0, ad7606_capture_stop(cap));
+	TEST_ASSERT_EQUAL_INT(0, ad7606_capture_get_stats(cap, &stats));
+	TEST_ASSERT_EQUAL_INT(0, stats.late_reads);
+	ad7606_capture_remove(cap);
+
+	/* Reading takes longer, BUSY falls during every read */
+	model_reset(10, 30);
+	capture_setup(4, true);
+	TEST_ASSERT_EQUAL_INT(0, ad7606_capture_start(cap));
+	sleep_ms(20);
+	TEST_ASSERT_EQUAL_INT(0, ad7606_capture_stop(cap));
+	TEST_ASSERT_EQUAL_INT(0, ad7606_capture_get_stats(cap, &stats));
+	TEST_ASSERT_TRUE(stats.late_reads > 0);
+	TEST_ASSERT_EQUAL_INT(0, stats.frames);
+}
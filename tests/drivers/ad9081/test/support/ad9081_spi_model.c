@@ -0,0 +1,182 @@
+/***************************************************************************//**
+ *   @file   ad9081_spi_model.c
+ *   @brief  Simulated AD9081 SPI backend with the paged NCO registers.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Register file of the paged blocks touched by the NCO plan. Writes go to
+ * every block selected by the page register, reads come from the lowest
+ * selected one. The ADC NCO profile registers are banked by the profile
+ * update index, like on the device.
+ */
+#define MODEL_REG_SIZE		0x4000
+#define MODEL_DAC_PAGE		0x1B
+#define MODEL_CHAN_PAGE		0x1C
+#define MODEL_CDDC_PAGE		0x18
+#define MODEL_FDDC_PAGE		0x19
+#define MODEL_DAC_BASE		0x800
+#define MODEL_DAC_HOPF_CTRL1	0x801
+#define MODEL_CHAN_BASE		0x1A0
+#define MODEL_CDDC_BASE		0xA00
+#define MODEL_FDDC_BASE		0xA80
+#define MODEL_BLOCK_SIZE	0x80
+#define MODEL_PROFILE_CTRL	0x04
+#define MODEL_PROFILE_START	0x05
+#define MODEL_PROFILE_SIZE	24
+
+static uint8_t model_flat[MODEL_REG_SIZE];
+static uint8_t model_dac[4][MODEL_BLOCK_SIZE];
+static uint8_t model_chan[8][MODEL_BLOCK_SIZE];
+static uint8_t model_cddc[4][MODEL_BLOCK_SIZE];
+static uint8_t model_fddc[8][MODEL_BLOCK_SIZE];
+static uint8_t model_cddc_prof[4][16][MODEL_PROFILE_SIZE];
+static uint8_t model_fddc_prof[8][16][MODEL_PROFILE_SIZE];
+
+/* SPI statistics, cleared by model_reset() and model_stats_clear() */
+static uint32_t model_xfers;
+static uint32_t model_bytes;
+static uint32_t model_max_burst;
+
+static void model_stats_clear(void)
+{
+	model_xfers = 0;
+	model_bytes = 0;
+	model_max_burst = 0;
+}
+
+static void model_reset(void)
+{
+	memset(model_flat, 0, sizeof(model_flat));
+	memset(model_dac, 0, sizeof(model_dac));
+	memset(model_chan, 0, sizeof(model_chan));
+	memset(model_cddc, 0, sizeof(model_cddc));
+	memset(model_fddc, 0, sizeof(model_fddc));
+	memset(model_cddc_prof, 0, sizeof(model_cddc_prof));
+	memset(model_fddc_prof, 0, sizeof(model_fddc_prof));
+	model_stats_clear();
+}
+
+static uint8_t *model_reg(uint16_t reg, uint8_t bank)
+{
+	uint8_t off = reg % MODEL_BLOCK_SIZE;
+	uint8_t prof;
+
+	if (reg >= MODEL_DAC_BASE && reg < MODEL_DAC_BASE + MODEL_BLOCK_SIZE &&
+	    reg != MODEL_DAC_HOPF_CTRL1)
+		return &model_dac[bank][off];
+	if (reg >= MODEL_CHAN_BASE && reg < MODEL_CHAN_BASE + 0x10)
+		return &model_chan[bank][reg - MODEL_CHAN_BASE];
+	if (reg >= MODEL_CDDC_BASE && reg < MODEL_CDDC_BASE + MODEL_BLOCK_SIZE) {
+		prof = model_cddc[bank][MODEL_PROFILE_CTRL] & 0xF;
+		if (off >= MODEL_PROFILE_START &&
+		    off < MODEL_PROFILE_START + MODEL_PROFILE_SIZE)
+			return &model_cddc_prof[bank][prof][off - MODEL_PROFILE_START];
+		return &model_cddc[bank][off];
+	}
+	if (reg >= MODEL_FDDC_BASE && reg < MODEL_FDDC_BASE + MODEL_BLOCK_SIZE) {
+		prof = model_fddc[bank][MODEL_PROFILE_CTRL] & 0xF;
+		if (off >= MODEL_PROFILE_START &&
+		    off < MODEL_PROFILE_START + MODEL_PROFILE_SIZE)
+			return &model_fddc_prof[bank][prof][off - MODEL_PROFILE_START];
+		return &model_fddc[bank][off];
+	}
+
+	return &model_flat[reg];
+}
+
+static uint8_t model_page(uint16_t reg)
+{
+	if (reg >= MODEL_DAC_BASE && reg < MODEL_DAC_BASE + MODEL_BLOCK_SIZE)
+		return model_flat[MODEL_DAC_PAGE] & 0xF;
+	if (reg >= MODEL_CHAN_BASE && reg < MODEL_CHAN_BASE + 0x10)
+		return model_flat[MODEL_CHAN_PAGE];
+	if (reg >= MODEL_CDDC_BASE && reg < MODEL_CDDC_BASE + MODEL_BLOCK_SIZE)
+		return model_flat[MODEL_CDDC_PAGE] >> 4;
+	if (reg >= MODEL_FDDC_BASE && reg < MODEL_FDDC_BASE + MODEL_BLOCK_SIZE)
+		return model_flat[MODEL_FDDC_PAGE];
+
+	return 1;
+}
+
+static void model_write(uint16_t reg, uint8_t val)
+{
+	uint8_t page = model_page(reg);
+	uint8_t bank;
+
+	for (bank = 0; bank < 8; bank++)
+		if (page & (1 << bank))
+			*model_reg(reg, bank) = val;
+}
+
+static uint8_t model_read(uint16_t reg)
+{
+	uint8_t page = model_page(reg);
+	uint8_t bank;
+
+	for (bank = 0; bank < 8; bank++)
+		if (page & (1 << bank))
+			return *model_reg(reg, bank);
+
+	return 0;
+}
+
+static int32_t model_spi_xfer(void *user_data, uint8_t *in_data,
+			      uint8_t *out_data, uint32_t size_bytes)
+{
+	uint16_t reg = ((in_data[0] & 0x3F) << 8) | in_data[1];
+	uint32_t i;
+
+	model_xfers++;
+	model_bytes += size_bytes;
+	if (size_bytes > model_max_burst)
+		model_max_burst = size_bytes;
+
+	for (i = 2; i < size_bytes; i++, reg++) {
+		if (in_data[0] & 0x80)
+			out_data[i] = model_read(reg);
+		else
+			model_write(reg, in_data[i]);
+	}
+
+	return 0;
+}
+
+static uint64_t model_le(const uint8_t *buf, uint8_t len)
+{
+	uint64_t val = 0;
+
+	while (len--)
+		val = (val << 8) | buf[len];
+
+	return val;
+}
@@ -0,0 +1,314 @@
+/***************************************************************************//**
+ *   @file   test_ad9081_hal_cache.c
+ *   @brief  Unit tests of the AD9081 HAL register cache.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "adi_ad9081_hal.h"
+#include "no_os_util.h"
+#include "ad9081_spi_model.c"
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+/* Cacheable registers outside the paged blocks */
+#define REG_A		0x1000
+#define REG_B		0x1100
+/* Status register, never cached */
+#define REG_STATUS	0x0004
+/* Cacheable register of the coarse DDC block, behind its page select */
+#define REG_CDDC	(MODEL_CDDC_BASE + 0x10)
+
+static adi_ad9081_device_t dev;
+static adi_ad9081_hal_cache_t cache;
+/* Value of REG_A seen by the device when the delay starts */
+static int reg_a_at_delay;
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static int32_t model_delay_us(void *user_data, uint32_t us)
+{
+	reg_a_at_delay = model_flat[REG_A];
+
+	return 0;
+}
+
+static int32_t model_reset_pin(void *user_data, uint8_t enable)
+{
+	return 0;
+}
+
+static uint8_t reg_get(uint32_t reg)
+{
+	uint8_t val;
+
+	TEST_ASSERT_EQUAL_INT(API_CMS_ERROR_OK,
+			      adi_ad9081_hal_reg_get(&dev, reg, &val));
+
+	return val;
+}
+
+static void reg_set(uint32_t reg, uint8_t val)
+{
+	TEST_ASSERT_EQUAL_INT(API_CMS_ERROR_OK,
+			      adi_ad9081_hal_reg_set(&dev, reg, val));
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	model_reset();
+	memset(&cache, 0, sizeof(cache));
+	memset(&dev, 0, sizeof(dev));
+	dev.hal_info.spi_xfer = model_spi_xfer;
+	dev.hal_info.delay_us = model_delay_us;
+	dev.hal_info.reset_pin_ctrl = model_reset_pin;
+	dev.hal_info.msb = SPI_MSB_FIRST;
+	dev.hal_info.addr_inc = SPI_ADDR_INC_AUTO;
+	dev.hal_info.cache = &cache;
+	reg_a_at_delay = -1;
+}
+
+void tearDown(void)
+{
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+/* Repeated reads and read-modify-writes are served from the shadow. */
+void test_ad9081_hal_cache_hits(void)
+{
+	uint64_t val;
+
+	model_flat[REG_A] = 0x5A;
+	TEST_ASSERT_EQUAL_UINT32(0x5A, reg_get(REG_A));
+	TEST_ASSERT_EQUAL_UINT32(0x5A, reg_get(REG_A));
+	TEST_ASSERT_EQUAL_UINT32(1, model_xfers);
+	TEST_ASSERT_EQUAL_UINT32(1, cache.hit_cnt);
+
+	/* Bitfield update: the write only */
+	model_stats_clear();
+	TEST_ASSERT_EQUAL_INT(API_CMS_ERROR_OK,
+			      adi_ad9081_hal_bf_set(&dev, REG_A, 0x0204, 0x3));
+	TEST_ASSERT_EQUAL_UINT32(1, model_xfers);
+	TEST_ASSERT_EQUAL_UINT32(0x7A, model_flat[REG_A]);
+	TEST_ASSERT_EQUAL_INT(API_CMS_ERROR_OK,
+			      adi_ad9081_hal_bf_get(&dev, REG_A, 0x0204,
+						    (uint8_t *)&val, 8));
+	TEST_ASSERT_EQUAL_UINT32(1, model_xfers);
+
+	/* Status registers always go to the device */
+	model_stats_clear();
+	model_flat[REG_STATUS] = 1;
+	TEST_ASSERT_EQUAL_UINT32(1, reg_get(REG_STATUS));
+	model_flat[REG_STATUS] = 2;
+	TEST_ASSERT_EQUAL_UINT32(2, reg_get(REG_STATUS));
+	TEST_ASSERT_EQUAL_UINT32(2, model_xfers);
+
+	/* Without a cache every access is sent */
+	dev.hal_info.cache = NULL;
+	model_stats_clear();
+	reg_get(REG_A);
+	reg_get(REG_A);
+	TEST_ASSERT_EQUAL_UINT32(2, model_xfers);
+}
+
+/* Multi-byte bitfields are read in a single streaming transfer. */
+void test_ad9081_hal_cache_bf_stream(void)
+{
+	uint64_t val = 0;
+
+	model_flat[REG_A] = 0x11;
+	model_flat[REG_A + 1] = 0x22;
+	model_flat[REG_A + 2] = 0x33;
+	TEST_ASSERT_EQUAL_INT(API_CMS_ERROR_OK,
+			      adi_ad9081_hal_bf_get(&dev, REG_A, 0x1800,
+						    (uint8_t *)&val, 8));
+	TEST_ASSERT_EQUAL_UINT32(0x332211, val);
+	TEST_ASSERT_EQUAL_UINT32(1, model_xfers);
+	TEST_ASSERT_EQUAL_UINT32(5, model_max_burst);
+}
+
+/*
+ * Deferred writes to consecutive addresses go in one streaming transfer, and
+ * reach the device before any status read or delay.
+ */
+void test_ad9081_hal_cache_batch(void)
+{
+	uint32_t i;
+
+	TEST_ASSERT_EQUAL_INT(API_CMS_ERROR_OK, adi_ad9081_hal_batch_begin(&dev));
+	for (i = 0; i < 8; i++)
+		reg_set(REG_A + i, i + 1);
+	reg_set(REG_B, 0x55);
+	TEST_ASSERT_EQUAL_UINT32(0, model_xfers);
+	/* Served from the queue, not the device */
+	TEST_ASSERT_EQUAL_UINT32(0x55, reg_get(REG_B));
+	TEST_ASSERT_EQUAL_UINT32(0, model_flat[REG_B]);
+
+	TEST_ASSERT_EQUAL_INT(API_CMS_ERROR_OK, adi_ad9081_hal_batch_commit(&dev));
+	TEST_ASSERT_EQUAL_UINT32(2, model_xfers);
+	TEST_ASSERT_EQUAL_UINT32(2 + 8, model_max_burst);
+	for (i = 0; i < 8; i++)
+		TEST_ASSERT_EQUAL_UINT32(i + 1, model_flat[REG_A + i]);
+	TEST_ASSERT_EQUAL_UINT32(0x55, model_flat[REG_B]);
+
+	/* A status read flushes the queue first */
+	model_stats_clear();
+	adi_ad9081_hal_batch_begin(&dev);
+	reg_set(REG_A, 0xAA);
+	reg_get(REG_STATUS);
+	TEST_ASSERT_EQUAL_UINT32(2, model_xfers);
+	TEST_ASSERT_EQUAL_UINT32(0xAA, model_flat[REG_A]);
+
+	/* So does a delay */
+	reg_set(REG_A, 0xBB);
+	TEST_ASSERT_EQUAL_INT(API_CMS_ERROR_OK, adi_ad9081_hal_delay_us(&dev, 10));
+	TEST_ASSERT_EQUAL_INT(0xBB, reg_a_at_delay);
+	adi_ad9081_hal_batch_commit(&dev);
+}
+
+/* A full queue is sent, the writes after it are queued again. */
+void test_ad9081_hal_cache_batch_full(void)
+{
+	uint32_t i;
+
+	adi_ad9081_hal_batch_begin(&dev);
+	for (i = 0; i < AD9081_HAL_BATCH_SIZE + 4; i++)
+		reg_set(REG_A + i, i);
+	TEST_ASSERT_EQUAL_UINT32(1, model_xfers);
+	TEST_ASSERT_EQUAL_UINT32(2 + AD9081_HAL_BATCH_SIZE, model_max_burst);
+	adi_ad9081_hal_batch_commit(&dev);
+	TEST_ASSERT_EQUAL_UINT32(2, model_xfers);
+	for (i = 0; i < AD9081_HAL_BATCH_SIZE + 4; i++)
+		TEST_ASSERT_EQUAL_UINT32(i & 0xFF, model_flat[REG_A + i]);
+
+
+	/* No batch mode without the cache */
+	dev.hal_info.cache = NULL;
+	TEST_ASSERT_EQUAL_INT(API_CMS_ERROR_NULL_PARAM,
+			      adi_ad9081_hal_batch_begin(&dev));
+}
+
+/* Streams longer than 32 registers keep the cached bytes apart. */
+void test_ad9081_hal_cache_stream_get_long(void)
+{
+	uint8_t data[40];
+	uint32_t i;
+
+	for (i = 0; i < 40; i++)
+		model_flat[REG_B + i] = i;
+	TEST_ASSERT_EQUAL_UINT32(0, reg_get(REG_B));
+	TEST_ASSERT_EQUAL_UINT32(35, reg_get(REG_B + 35));
+
+	/* Cached bytes keep their shadow value, the rest is read */
+	for (i = 0; i < 40; i++)
+		model_flat[REG_B + i] = 0x80 + i;
+	model_stats_clear();
+	TEST_ASSERT_EQUAL_INT(API_CMS_ERROR_OK,
+			      adi_ad9081_hal_reg_stream_get(&dev, REG_B, data,
+					      40));
+	TEST_ASSERT_EQUAL_UINT32(1, model_xfers);
+	TEST_ASSERT_EQUAL_UINT32(42, model_max_burst);
+	for (i = 0; i < 40; i++)
+		TEST_ASSERT_EQUAL_UINT32(i == 0 || i == 35 ? i : 0x80 + i,
+					 data[i]);
+
+	/* Now every byte is cached */
+	model_stats_clear();
+	TEST_ASSERT_EQUAL_INT(API_CMS_ERROR_OK,
+			      adi_ad9081_hal_reg_stream_get(&dev, REG_B, data,
+					      40));
+	TEST_ASSERT_EQUAL_UINT32(0, model_xfers);
+}
+
+/*
+ * Changing a page select drops the registers behind it, rewriting the same
+ * page is skipped.
+ */
+void test_ad9081_hal_cache_page(void)
+{
+	reg_set(REG_ADC_COARSE_PAGE_ADDR, 0x10);
+	reg_set(REG_CDDC, 0x11);
+	reg_set(REG_ADC_COARSE_PAGE_ADDR, 0x20);
+	reg_set(REG_CDDC, 0x22);
+	TEST_ASSERT_EQUAL_UINT32(4, model_xfers);
+
+	model_stats_clear();
+	reg_set(REG_ADC_COARSE_PAGE_ADDR, 0x20);
+	TEST_ASSERT_EQUAL_UINT32(0, model_xfers);
+	TEST_ASSERT_EQUAL_UINT32(0x22, reg_get(REG_CDDC));
+	TEST_ASSERT_EQUAL_UINT32(0, model_xfers);
+
+	reg_set(REG_ADC_COARSE_PAGE_ADDR, 0x10);
+	TEST_ASSERT_EQUAL_UINT32(0x11, reg_get(REG_CDDC));
+	TEST_ASSERT_EQUAL_UINT32(2, model_xfers);
+	/* The page selects themselves stay cached */
+	TEST_ASSERT_EQUAL_UINT32(0x10, reg_get(REG_ADC_COARSE_PAGE_ADDR));
+	TEST_ASSERT_EQUAL_UINT32(2, model_xfers);
+}
+
+/* Soft reset, reset pin and explicit invalidation drop the whole shadow. */
+void test_ad9081_hal_cache_invalidate(void)
+{
+	reg_set(REG_A, 0x12);
+	model_flat[REG_A] = 0;
+
+	reg_set(REG_SPI_INTFCONFA_ADDR, BF_SOFTRESET(1) | BF_SOFTRESET_M(1));
+	model_stats_clear();
+	TEST_ASSERT_EQUAL_UINT32(0, reg_get(REG_A));
+	TEST_ASSERT_EQUAL_UINT32(1, model_xfers);
+
+	model_flat[REG_A] = 0x34;
+	TEST_ASSERT_EQUAL_INT(API_CMS_ERROR_OK,
+			      adi_ad9081_hal_reset_pin_ctrl(&dev, 0));
+	TEST_ASSERT_EQUAL_UINT32(0x34, reg_get(REG_A));
+
+	model_flat[REG_A] = 0x56;
+	adi_ad9081_hal_cache_invalidate(&dev);
+	TEST_ASSERT_EQUAL_UINT32(0x56, reg_get(REG_A));
+	TEST_ASSERT_EQUAL_UINT32(3, model_xfers);
+}
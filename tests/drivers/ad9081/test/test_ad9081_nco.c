@@ -0,0 +1,331 @@
+/***************************************************************************//**
+ *   @file   test_ad9081_nco.c
+ *   @brief  Unit tests for the AD9081 NCO hop plan.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "ad9081_nco.h"
+#include "adi_ad9081_hal.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include "ad9081_spi_model.c"
+
+TEST_FILE("adi_ad9081_adc.c")
+TEST_FILE("adi_ad9081_dac.c")
+TEST_FILE("adi_ad9081_device.c")
+TEST_FILE("adi_ad9081_jesd.c")
+TEST_FILE("adi_ad9081_sync.c")
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define NB_HOPS		8
+/* SPI clock used to turn the transfer sizes into a retune time */
+#define SCLK_MHZ	25
+
+#define DACS		(AD9081_DAC_0 | AD9081_DAC_1)
+#define CHANS		(AD9081_DAC_CH_0 | AD9081_DAC_CH_1)
+#define CDDCS		(AD9081_ADC_CDDC_0 | AD9081_ADC_CDDC_2)
+#define FDDCS		(AD9081_ADC_FDDC_0 | AD9081_ADC_FDDC_1)
+
+static adi_ad9081_device_t dev;
+static adi_ad9081_hal_cache_t cache;
+static struct ad9081_nco_hop hops[NB_HOPS];
+static struct ad9081_nco_plan *plan;
+
+static void build_hops(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < NB_HOPS; i++) {
+		hops[i].dac_hz = 1000000000ll + i * 25000000ll;
+		hops[i].dac_chan_hz = -100000000ll + i * 1000000ll;
+		/* hops 2 and 3 share the coarse DDC frequency */
+		hops[i].cddc_hz = -500000000ll + (i == 3 ? 2 : i) * 50000000ll;
+		hops[i].fddc_hz = 10000000ll + i * 100000ll;
+	}
+}
+
+static void init_plan(enum ad9081_nco_trig trig, uint8_t dac_chans)
+{
+	struct ad9081_nco_plan_init_param init = {
+		.dev = &dev,
+		.dacs = DACS,
+		.dac_chans = dac_chans,
+		.cddcs = CDDCS,
+		.fddcs = FDDCS,
+		.hopf_mode = 1,
+		.trig = trig,
+		.hops = hops,
+		.num_hops = NB_HOPS,
+	};
+
+	TEST_ASSERT_EQUAL_INT(0, ad9081_nco_plan_init(&plan, &init));
+	TEST_ASSERT_EQUAL_INT(0, ad9081_nco_plan_load(plan));
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	model_reset();
+	/* Fine interpolation 2, coarse decimation 4 */
+	model_flat[REG_INTRP_MODE_ADDR] = 0x20;
+	model_flat[REG_COARSE_DEC_CTRL_ADDR] = AD9081_CDDC_DCM_4;
+
+	memset(&cache, 0, sizeof(cache));
+	memset(&dev, 0, sizeof(dev));
+	dev.hal_info.spi_xfer = model_spi_xfer;
+	dev.hal_info.msb = SPI_MSB_FIRST;
+	dev.hal_info.addr_inc = SPI_ADDR_INC_AUTO;
+	dev.hal_info.cache = &cache;
+	dev.dev_info.dac_freq_hz = 12000000000ull;
+	dev.dev_info.adc_freq_hz = 4000000000ull;
+
+	build_hops();
+	plan = NULL;
+}
+
+void tearDown(void)
+{
+	ad9081_nco_plan_remove(plan);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_ad9081_nco_plan_init_invalid(void)
+{
+	struct ad9081_nco_plan_init_param init = {
+		.dev = &dev,
+		.dacs = DACS,
+		.hops = hops,
+		.num_hops = AD9081_NCO_HOPS_MAX + 1,
+	};
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ad9081_nco_plan_init(&plan, &init));
+
+	/* The DDC NCOs only have 16 profiles */
+	init.num_hops = AD9081_NCO_DDC_HOPS_MAX + 1;
+	init.cddcs = CDDCS;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ad9081_nco_plan_init(&plan, &init));
+
+	/* The channel NCOs cannot be switched from the pins */
+	init.num_hops = NB_HOPS;
+	init.dac_chans = CHANS;
+	init.trig = AD9081_NCO_TRIG_GPIO;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ad9081_nco_plan_init(&plan, &init));
+	TEST_ASSERT_NULL(plan);
+}
+
+void test_ad9081_nco_plan_load_dac_table(void)
+{
+	uint64_t ftw;
+	uint8_t dac, i;
+
+	init_plan(AD9081_NCO_TRIG_SPI, CHANS);
+
+	/* The whole FFH table goes out in one burst */
+	TEST_ASSERT_EQUAL_UINT32(2 + 4 * NB_HOPS, model_max_burst);
+
+	for (i = 0; i < NB_HOPS; i++) {
+		TEST_ASSERT_EQUAL_INT(0, adi_ad9081_hal_calc_tx_nco_ftw32(&dev,
+				      dev.dev_info.dac_freq_hz, hops[i].dac_hz,
+				      &ftw));
+		for (dac = 0; dac < 2; dac++)
+			TEST_ASSERT_EQUAL_UINT32(ftw,
+						 no_os_get_unaligned_le32(&model_dac[dac][6 + 4 * i]));
+	}
+	/* Nothing past the plan */
+	TEST_ASSERT_EQUAL_UINT32(0,
+				 no_os_get_unaligned_le32(&model_dac[0][6 + 4 * NB_HOPS]));
+	TEST_ASSERT_EQUAL_UINT32(0, model_dac[2][6]);
+}
+
+void test_ad9081_nco_plan_load_ddc_profiles(void)
+{
+	uint64_t ftw;
+	uint8_t i;
+
+	init_plan(AD9081_NCO_TRIG_SPI, 0);
+
+	for (i = 0; i < NB_HOPS; i++) {
+		TEST_ASSERT_EQUAL_INT(0, adi_ad9081_hal_calc_rx_nco_ftw(&dev,
+				      dev.dev_info.adc_freq_hz,
+				      hops[i].cddc_hz, &ftw));
+		TEST_ASSERT_TRUE(ftw == model_le(model_cddc_prof[0][i], 6));
+		TEST_ASSERT_TRUE(ftw == model_le(model_cddc_prof[2][i], 6));
+		/* Phase offset is only set on CDDC0 and CDDC1 */
+		TEST_ASSERT_TRUE(((ftw << 3) & 0xFFFFFFFFFFFFull) ==
+				 model_le(&model_cddc_prof[0][i][6], 6));
+		TEST_ASSERT_TRUE(0 == model_le(&model_cddc_prof[2][i][6], 6));
+
+		/* Fine DDCs run at adc_freq / 4 */
+		TEST_ASSERT_EQUAL_INT(0, adi_ad9081_hal_calc_tx_nco_ftw(&dev,
+				      dev.dev_info.adc_freq_hz / 4,
+				      hops[i].fddc_hz, &ftw));
+		TEST_ASSERT_TRUE(ftw == model_le(model_fddc_prof[0][i], 6));
+		TEST_ASSERT_TRUE(ftw == model_le(model_fddc_prof[1][i], 6));
+	}
+	TEST_ASSERT_TRUE(0 == model_le(model_cddc_prof[1][0], 6));
+	TEST_ASSERT_TRUE(0 == model_le(model_cddc_prof[0][NB_HOPS], 6));
+}
+
+void test_ad9081_nco_plan_hop_spi(void)
+{
+	uint8_t ref[MODEL_BLOCK_SIZE];
+
+	init_plan(AD9081_NCO_TRIG_SPI, CHANS);
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ad9081_nco_plan_hop(plan, NB_HOPS));
+
+	TEST_ASSERT_EQUAL_INT(0, ad9081_nco_plan_hop(plan, 0));
+	model_stats_clear();
+	TEST_ASSERT_EQUAL_INT(0, ad9081_nco_plan_hop(plan, 2));
+
+	/* HOPF_CTRL0, channel FTW burst and load request, two NCO_CTRL */
+	TEST_ASSERT_EQUAL_UINT32(5, model_xfers);
+	TEST_ASSERT_EQUAL_INT((1 << 6) | 3, model_dac[0][0]);
+	TEST_ASSERT_EQUAL_INT((1 << 6) | 3, model_dac[1][0]);
+	TEST_ASSERT_EQUAL_INT(2, model_cddc[0][3]);
+	TEST_ASSERT_EQUAL_INT(2, model_cddc[2][3]);
+	TEST_ASSERT_EQUAL_INT(2, model_fddc[1][3]);
+	TEST_ASSERT_EQUAL_INT(1, model_chan[1][1]);
+	TEST_ASSERT_TRUE(plan->chan_ftw[2] == model_le(&model_chan[0][2], 6));
+
+	/* The coarse DDCs keep their frequency from hop 2 to hop 3 */
+	model_stats_clear();
+	TEST_ASSERT_EQUAL_INT(0, ad9081_nco_plan_hop(plan, 3));
+	TEST_ASSERT_EQUAL_UINT32(4, model_xfers);
+	TEST_ASSERT_EQUAL_INT(2, model_cddc[0][3]);
+	TEST_ASSERT_EQUAL_INT(3, model_fddc[0][3]);
+
+	model_stats_clear();
+	TEST_ASSERT_EQUAL_INT(0, ad9081_nco_plan_hop(plan, 3));
+	TEST_ASSERT_EQUAL_UINT32(0, model_xfers);
+
+	/* Same channel FTW as the vendor API */
+	memcpy(ref, model_chan[0], sizeof(ref));
+	TEST_ASSERT_EQUAL_INT(0, adi_ad9081_dac_duc_nco_set(&dev,
+			      AD9081_DAC_NONE, CHANS, hops[3].dac_chan_hz));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(&ref[2], &model_chan[0][2], 6);
+}
+
+void test_ad9081_nco_plan_hop_no_cache(void)
+{
+	uint8_t sysref = BF_DDSC_FTW_LOAD_SYSREF(1);
+
+	dev.hal_info.cache = NULL;
+	/* Channel NCO loads synchronized to SYSREF */
+	model_chan[0][1] = sysref;
+	model_chan[1][1] = sysref;
+
+	init_plan(AD9081_NCO_TRIG_SPI, CHANS);
+	TEST_ASSERT_EQUAL_INT(0, ad9081_nco_plan_hop(plan, 0));
+
+	/* The plan remembers its page selects */
+	model_stats_clear();
+	TEST_ASSERT_EQUAL_INT(0, ad9081_nco_plan_hop(plan, 2));
+	TEST_ASSERT_EQUAL_UINT32(5, model_xfers);
+	TEST_ASSERT_EQUAL_INT((1 << 6) | 3, model_dac[1][0]);
+	TEST_ASSERT_EQUAL_INT(2, model_cddc[2][3]);
+	TEST_ASSERT_EQUAL_INT(2, model_fddc[1][3]);
+	TEST_ASSERT_EQUAL_INT(sysref | 1, model_chan[0][1]);
+	TEST_ASSERT_EQUAL_INT(sysref | 1, model_chan[1][1]);
+	TEST_ASSERT_TRUE(plan->chan_ftw[2] == model_le(&model_chan[1][2], 6));
+
+	/* Another call moves the DAC page, the plan selects it again */
+	TEST_ASSERT_EQUAL_INT(0, adi_ad9081_dac_select_set(&dev, AD9081_DAC_2));
+	plan->pages = 0;
+	model_stats_clear();
+	TEST_ASSERT_EQUAL_INT(0, ad9081_nco_plan_hop(plan, 4));
+	TEST_ASSERT_EQUAL_UINT32(10, model_xfers);
+	TEST_ASSERT_EQUAL_INT((1 << 6) | 5, model_dac[0][0]);
+	TEST_ASSERT_EQUAL_INT(0, model_dac[2][0]);
+}
+
+void test_ad9081_nco_plan_hop_latency(void)
+{
+	uint32_t plan_bytes, plan_xfers;
+	char msg[128];
+
+	init_plan(AD9081_NCO_TRIG_SPI, CHANS);
+	TEST_ASSERT_EQUAL_INT(0, ad9081_nco_plan_hop(plan, 0));
+
+	model_stats_clear();
+	TEST_ASSERT_EQUAL_INT(0, ad9081_nco_plan_hop(plan, 1));
+	plan_xfers = model_xfers;
+	plan_bytes = model_bytes;
+
+	/* Same retune through the vendor API, with the register cache on */
+	model_stats_clear();
+	TEST_ASSERT_EQUAL_INT(0, adi_ad9081_dac_duc_nco_set(&dev, DACS,
+			      AD9081_DAC_CH_NONE, hops[1].dac_hz));
+	TEST_ASSERT_EQUAL_INT(0, adi_ad9081_dac_duc_nco_set(&dev,
+			      AD9081_DAC_NONE, CHANS, hops[1].dac_chan_hz));
+	TEST_ASSERT_EQUAL_INT(0, adi_ad9081_adc_ddc_coarse_nco_set(&dev, CDDCS,
+			      hops[1].cddc_hz));
+	TEST_ASSERT_EQUAL_INT(0, adi_ad9081_adc_ddc_fine_nco_set(&dev, FDDCS,
+			      hops[1].fddc_hz));
+
+	snprintf(msg, sizeof(msg),
+		 "retune: plan %u xfers %u us, api %u xfers %u us @ %u MHz",
+		 (unsigned)plan_xfers, (unsigned)(plan_bytes * 8 / SCLK_MHZ),
+		 (unsigned)model_xfers, (unsigned)(model_bytes * 8 / SCLK_MHZ),
+		 SCLK_MHZ);
+	TEST_MESSAGE(msg);
+
+	TEST_ASSERT_TRUE(plan_xfers <= 5);
+	TEST_ASSERT_TRUE(plan_bytes * 4 < model_bytes);
+}
+
+void test_ad9081_nco_plan_gpio(void)
+{
+	init_plan(AD9081_NCO_TRIG_GPIO, 0);
+
+	TEST_ASSERT_EQUAL_INT(1, model_flat[REG_DDSM_HOPF_CTRL1_ADDR] & 1);
+	/* profile_pins[3:0] select the profile */
+	TEST_ASSERT_EQUAL_INT(4, model_cddc[0][3] >> 4);
+	TEST_ASSERT_EQUAL_INT(4, model_cddc[2][3] >> 4);
+	TEST_ASSERT_EQUAL_INT(4, model_fddc[1][3] >> 4);
+
+	TEST_ASSERT_EQUAL_INT(-EPERM, ad9081_nco_plan_hop(plan, 1));
+}
@@ -0,0 +1,254 @@
+/***************************************************************************//**
+ *   @file   ade9000_model.c
+ *   @brief  Simulated ADE9000 for the waveform buffer tests.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "no_os_delay.h"
+#include "no_os_spi.h"
+#include "no_os_util.h"
+#include "ade9000.h"
+
+/*
+ * ADE9000 register map and waveform buffer on a simulated time base. While
+ * WF_CAP_EN is set, model_fill() stores sample sets in the buffer at the
+ * fixed data rate, and the completion of a page enabled in WFB_PG_IRQEN sets PAGE_FULL in STATUS0
+ * and the page in WFB_TRG_STAT. In real time mode, sets are also stored as
+ * the bus time goes by. Reads from the waveform buffer addresses return
+ * consecutive words until CS is raised.
+ *
+ * Channel c of sample set n reads (c + 1) << 24 | n, IN reads 0 unless
+ * WF_IN_EN is set.
+ */
+#define MODEL_N_REGS		ADE9000_WFB_ADDR
+#define MODEL_SCLK_HZ		20000000
+#define MODEL_CALL_NS		5000
+
+static uint32_t model_regs[MODEL_N_REGS];
+static uint32_t model_wfb[ADE9000_WFB_WORDS];
+static uint32_t model_wfb_ptr;
+static uint32_t model_nb_sets;
+static uint64_t model_now_ns;
+static uint32_t model_transfers;
+/* Sets are stored as the time goes by, not only by model_fill() */
+static bool model_realtime;
+static uint64_t model_set_time_ns;
+
+static void model_reset(void)
+{
+	memset(model_regs, 0, sizeof(model_regs));
+	memset(model_wfb, 0, sizeof(model_wfb));
+	model_regs[ADE9000_REG_CONFIG5] = ADE9000_CHIP_ID;
+	model_wfb_ptr = 0;
+	model_nb_sets = 0;
+	model_now_ns = 0;
+	model_transfers = 0;
+	model_realtime = false;
+	model_set_time_ns = 0;
+}
+
+static int32_t model_sample(uint32_t set, enum ade9000_wfb_chan chan)
+{
+	if (chan == ADE9000_WFB_IN &&
+	    !(model_regs[ADE9000_REG_WFB_CFG] & ADE9000_WF_IN_EN))
+		return 0;
+
+	return ((chan + 1) << 24) | (set & NO_OS_GENMASK(23, 0));
+}
+
+static uint64_t model_set_ns(void)
+{
+	return ADE9000_WFB_HALF_US(no_os_field_get(ADE9000_WF_SRC,
+				   model_regs[ADE9000_REG_WFB_CFG])) *
+	       1000ull / ADE9000_WFB_HALF_SETS;
+}
+
+static void model_store(uint32_t nb)
+{
+	uint32_t ch, page;
+
+	while (nb--) {
+
+		for (ch = 0; ch < ADE9000_WFB_SET_WORDS; ch++)
+			model_wfb[model_wfb_ptr + ch] = ch < ADE9000_WFB_NB_CHAN ?
+							model_sample(model_nb_sets, ch) : 0;
+		model_nb_sets++;
+		model_wfb_ptr = (model_wfb_ptr + ADE9000_WFB_SET_WORDS) %
+				ADE9000_WFB_WORDS;
+		if (model_wfb_ptr % ADE9000_WFB_PAGE_WORDS)
+			continue;
+
+		page = (model_wfb_ptr + ADE9000_WFB_WORDS - 1) % ADE9000_WFB_WORDS /
+		       ADE9000_WFB_PAGE_WORDS;
+		if (!(model_regs[ADE9000_REG_WFB_PG_IRQEN] & NO_OS_BIT(page)))
+			continue;
+
+		model_regs[ADE9000_REG_STATUS0] |= ADE9000_STATUS0_PAGE_FULL;
+		model_regs[ADE9000_REG_WFB_TRG_STAT] =
+			no_os_field_prep(ADE9000_WFB_LAST_PAGE, page);
+	}
+}
+
+/* Let nb sets come, at the fixed data rate */
+static void model_fill(uint32_t nb)
+{
+	if (!(model_regs[ADE9000_REG_WFB_CFG] & ADE9000_WF_CAP_EN))
+		return;
+
+	model_now_ns += nb * model_set_ns();
+	model_set_time_ns = model_now_ns;
+	model_store(nb);
+}
+
+/* In real time mode, store the sets due since the last ones */
+static void model_catch_up(void)
+{
+	uint32_t nb;
+
+	if (!model_realtime ||
+	    !(model_regs[ADE9000_REG_WFB_CFG] & ADE9000_WF_CAP_EN))
+		return;
+
+	nb = (model_now_ns - model_set_time_ns) / model_set_ns();
+	model_set_time_ns += nb * model_set_ns();
+	model_store(nb);
+}
+
+static bool model_is_16bit(uint16_t addr)
+{
+	return addr >= ADE9000_REG_RUN && addr <= ADE9000_REG_VERSION;
+}
+
+static void model_write(uint16_t addr, uint32_t val)
+{
+	if (addr >= MODEL_N_REGS)
+		return;
+
+	if (addr == ADE9000_REG_STATUS0) {
+		model_regs[addr] &= ~val;
+		return;
+	}
+
+	if (addr == ADE9000_REG_WFB_CFG &&
+	    !(model_regs[addr] & ADE9000_WF_CAP_EN) && (val & ADE9000_WF_CAP_EN)) {
+		model_wfb_ptr = 0;
+		model_set_time_ns = model_now_ns;
+	}
+
+	model_regs[addr] = val;
+}
+
+static int32_t model_spi_init(struct no_os_spi_desc **desc,
+			      const struct no_os_spi_init_param *param)
+{
+	NO_OS_UNUSED_PARAM(param);
+
+	*desc = calloc(1, sizeof(**desc));
+
+	return *desc ? 0 : -ENOMEM;
+}
+
+static int32_t model_spi_remove(struct no_os_spi_desc *desc)
+{
+	free(desc);
+
+	return 0;
+}
+
+static int32_t model_spi_write_and_read(struct no_os_spi_desc *desc,
+					uint8_t *data, uint16_t bytes_number)
+{
+	uint16_t addr = no_os_get_unaligned_be16(data) >> 4;
+	bool read = data[1] & ADE9000_SPI_READ;
+	uint16_t i;
+
+	NO_OS_UNUSED_PARAM(desc);
+
+	model_transfers++;
+	model_now_ns += MODEL_CALL_NS +
+			bytes_number * 8 * 1000000000ull / MODEL_SCLK_HZ;
+	model_catch_up();
+
+	if (addr >= ADE9000_WFB_ADDR) {
+		for (i = 2; i + 4 <= bytes_number; i += 4) {
+			no_os_put_unaligned_be32(model_wfb[addr - ADE9000_WFB_ADDR],
+						 &data[i]);
+			addr = ADE9000_WFB_ADDR + (addr - ADE9000_WFB_ADDR + 1) %
+			       ADE9000_WFB_WORDS;
+		}
+
+		return 0;
+	}
+
+	if (!read) {
+		model_write(addr, model_is_16bit(addr) ?
+			    no_os_get_unaligned_be16(&data[2]) :
+			    no_os_get_unaligned_be32(&data[2]));
+		return 0;
+	}
+
+	if (model_is_16bit(addr))
+		no_os_put_unaligned_be16(model_regs[addr], &data[2]);
+	else
+		no_os_put_unaligned_be32(model_regs[addr], &data[2]);
+
+	return 0;
+}
+
+static const struct no_os_spi_platform_ops model_spi_ops = {
+	.init = model_spi_init,
+	.remove = model_spi_remove,
+	.write_and_read = model_spi_write_and_read,
+};
+
+void no_os_udelay(uint32_t usecs)
+{
+	model_now_ns += usecs * 1000ull;
+}
+
+void no_os_mdelay(uint32_t msecs)
+{
+	model_now_ns += msecs * 1000000ull;
+}
+
+struct no_os_time no_os_get_time(void)
+{
+	struct no_os_time t = {
+		.s = model_now_ns / 1000000000ull,
+		.us = model_now_ns / 1000 % 1000000,
+	};
+
+	return t;
+}
@@ -0,0 +1,80 @@
+/***************************************************************************//**
+ *   @file   iio_stub.c
+ *   @brief  Minimal IIO core for the IIO driver tests.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "iio.h"
+#include "no_os_circular_buffer.h"
+#include "no_os_util.h"
+
+/*
+ * The iio.c helpers used by the IIO drivers under test, without the rest of
+ * the IIO daemon.
+ */
+
+int iio_buffer_push_scans(struct iio_buffer *buffer, void *data, uint32_t nb)
+{
+	if (!buffer)
+		return -EINVAL;
+
+	if (!nb)
+		return 0;
+
+	return no_os_cb_write(buffer->buf, data, nb * buffer->bytes_per_scan);
+}
+
+int iio_buffer_pop_scan(struct iio_buffer *buffer, void *data)
+{
+	if (!buffer)
+		return -EINVAL;
+
+	return no_os_cb_read(buffer->buf, data, buffer->bytes_per_scan);
+}
+
+int iio_format_value(char *buf, uint32_t len, enum iio_val fmt,
+		     int32_t size, int32_t *vals)
+{
+	NO_OS_UNUSED_PARAM(size);
+
+	switch (fmt) {
+	case IIO_VAL_INT:
+		return snprintf(buf, len, "%"PRIi32"", vals[0]);
+	case IIO_VAL_FRACTIONAL:
+		return snprintf(buf, len, "%"PRIi32"/%"PRIi32"", vals[0],
+				vals[1]);
+	default:
+		return 0;
+	}
+}
@@ -0,0 +1,206 @@
+/***************************************************************************//**
+ *   @file   test_ade9000_iio.c
+ *   @brief  Unit tests for the ADE9000 IIO buffered device.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <errno.h>
+#include "unity.h"
+#include "ade9000.h"
+#include "iio_ade9000.h"
+#include "no_os_circular_buffer.h"
+#include "no_os_spi.h"
+#include "no_os_util.h"
+#include "ade9000_model.c"
+#include "iio_stub.c"
+
+TEST_FILE("no_os_gpio.c")
+TEST_FILE("no_os_mutex.c")
+TEST_FILE("no_os_alloc.c")
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+/* IA and VA */
+#define MASK		(NO_OS_BIT(ADE9000_WFB_IA) | NO_OS_BIT(ADE9000_WFB_VA))
+#define NB_CH		2
+
+static struct no_os_spi_init_param spi_ip = {
+	.max_speed_hz = MODEL_SCLK_HZ,
+	.platform_ops = &model_spi_ops,
+};
+static struct ade9000_init_param ade9000_ip = {
+	.spi_init = &spi_ip,
+};
+static struct ade9000_iio_dev_init_param init_param = {
+	.ade9000_init_param = &ade9000_ip,
+	.wfb_src = ADE9000_SRC_SINC4,
+};
+static struct ade9000_iio_dev *iio_dev;
+static struct iio_buffer buffer;
+static struct iio_device_data dev_data;
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+/* Open a buffer of nb scans of IA and VA, like iio_open_dev() */
+static void open_buffer(uint32_t nb)
+{
+	buffer.active_mask = MASK;
+	buffer.bytes_per_scan = NB_CH * sizeof(int32_t);
+	buffer.samples = nb;
+	buffer.size = nb * buffer.bytes_per_scan;
+	buffer.dir = IIO_DIRECTION_INPUT;
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_init(&buffer.buf, buffer.size));
+
+	dev_data.dev = iio_dev;
+	dev_data.buffer = &buffer;
+	TEST_ASSERT_EQUAL_INT(0, iio_dev->iio_dev->pre_enable(iio_dev, MASK));
+}
+
+/* Read nb scans and check they are the sets from first on */
+static void check_scans(uint32_t first, uint32_t nb)
+{
+	int32_t scan[NB_CH];
+	uint32_t i;
+
+	for (i = 0; i < nb; i++) {
+		TEST_ASSERT_EQUAL_INT(0, iio_buffer_pop_scan(&buffer, scan));
+		TEST_ASSERT_EQUAL_INT(model_sample(first + i, ADE9000_WFB_IA),
+				      scan[0]);
+		TEST_ASSERT_EQUAL_INT(model_sample(first + i, ADE9000_WFB_VA),
+				      scan[1]);
+	}
+}
+
+static uint32_t buffered_scans(void)
+{
+	uint32_t size;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_size(buffer.buf, &size));
+
+	return size / buffer.bytes_per_scan;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	model_reset();
+	TEST_ASSERT_EQUAL_INT(0, ade9000_iio_init(&iio_dev, &init_param));
+	buffer.buf = NULL;
+}
+
+void tearDown(void)
+{
+	if (buffer.buf) {
+		TEST_ASSERT_EQUAL_INT(0, iio_dev->iio_dev->post_disable(iio_dev));
+		no_os_cb_remove(buffer.buf);
+	}
+	TEST_ASSERT_EQUAL_INT(0, ade9000_iio_remove(iio_dev));
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_ade9000_iio_attrs(void)
+{
+	struct iio_ch_info info = { .ch_num = 0, .ch_out = false };
+	struct iio_channel *ch = &iio_dev->iio_dev->channels[ADE9000_WFB_VA];
+	char buf[32];
+
+	model_regs[ADE9000_REG_AV_PCF] = -1234;
+	info.type = ch->ch_type;
+	info.address = ch->address;
+	TEST_ASSERT_TRUE(ch->attributes[0].show(iio_dev, buf, sizeof(buf),
+			 &info, 0) > 0);
+	TEST_ASSERT_EQUAL_INT(0, strcmp("-1234", buf));
+
+	TEST_ASSERT_TRUE(iio_dev->iio_dev->attributes[0].show(iio_dev, buf,
+			 sizeof(buf), NULL, 0) > 0);
+	TEST_ASSERT_EQUAL_INT(0, strcmp("32000", buf));
+}
+
+/*
+ * Buffers that are not a multiple of a buffer half get exactly the scans
+ * requested, the rest of the half goes first in the next one.
+ */
+void test_ade9000_iio_submit(void)
+{
+	model_realtime = true;
+	open_buffer(200);
+
+	TEST_ASSERT_EQUAL_INT(0, iio_dev->iio_dev->submit(&dev_data));
+	TEST_ASSERT_EQUAL_UINT32(200, buffered_scans());
+	check_scans(0, 200);
+
+	TEST_ASSERT_EQUAL_INT(0, iio_dev->iio_dev->submit(&dev_data));
+	TEST_ASSERT_EQUAL_UINT32(200, buffered_scans());
+	check_scans(200, 200);
+	TEST_ASSERT_EQUAL_UINT32(0, iio_dev->ade9000_dev->wfb_overruns);
+}
+
+/*
+ * In trigger mode a buffer smaller than a half is not overwritten, the scans
+ * that do not fit are pushed once the client made room.
+ */
+void test_ade9000_iio_trigger(void)
+{
+	open_buffer(100);
+
+	model_fill(ADE9000_WFB_HALF_SETS);
+	TEST_ASSERT_EQUAL_INT(0, iio_dev->iio_dev->trigger_handler(&dev_data));
+	TEST_ASSERT_EQUAL_UINT32(100, buffered_scans());
+
+	/* Full, nothing is pushed */
+	TEST_ASSERT_EQUAL_INT(0, iio_dev->iio_dev->trigger_handler(&dev_data));
+	TEST_ASSERT_EQUAL_UINT32(100, buffered_scans());
+	check_scans(0, 50);
+
+	TEST_ASSERT_EQUAL_INT(0, iio_dev->iio_dev->trigger_handler(&dev_data));
+	TEST_ASSERT_EQUAL_UINT32(78, buffered_scans());
+
+	model_fill(ADE9000_WFB_HALF_SETS);
+	TEST_ASSERT_EQUAL_INT(0, iio_dev->iio_dev->trigger_handler(&dev_data));
+	TEST_ASSERT_EQUAL_UINT32(100, buffered_scans());
+	check_scans(50, 100);
+	TEST_ASSERT_EQUAL_UINT32(106, iio_dev->pend_nb);
+	TEST_ASSERT_EQUAL_UINT32(0, iio_dev->ade9000_dev->wfb_overruns);
+}
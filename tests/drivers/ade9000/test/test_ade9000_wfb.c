@@ -0,0 +1,243 @@
+/***************************************************************************//**
+ *   @file   test_ade9000_wfb.c
+ *   @brief  Unit tests for the ADE9000 waveform buffer capture.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <errno.h>
+#include "unity.h"
+#include "ade9000.h"
+#include "no_os_spi.h"
+#include "no_os_util.h"
+#include "ade9000_model.c"
+
+TEST_FILE("no_os_gpio.c")
+TEST_FILE("no_os_mutex.c")
+TEST_FILE("no_os_alloc.c")
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define NB_HALVES	10
+#define SAMPLE_RATE	32000
+
+static struct no_os_spi_init_param spi_ip = {
+	.max_speed_hz = MODEL_SCLK_HZ,
+	.platform_ops = &model_spi_ops,
+};
+static struct ade9000_init_param init_param = {
+	.spi_init = &spi_ip,
+};
+static struct ade9000_dev *dev;
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static void check_half(uint32_t first_set)
+{
+	uint32_t set, ch;
+
+	for (set = 0; set < ADE9000_WFB_HALF_SETS; set++)
+		for (ch = 0; ch < ADE9000_WFB_NB_CHAN; ch++)
+			TEST_ASSERT_EQUAL_INT(model_sample(first_set + set, ch),
+					      ade9000_wfb_get_raw(dev, set, ch));
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	model_reset();
+	TEST_ASSERT_EQUAL_INT(0, ade9000_init(&dev, init_param));
+	TEST_ASSERT_EQUAL_INT(0, ade9000_setup(dev));
+}
+
+void tearDown(void)
+{
+	TEST_ASSERT_EQUAL_INT(0, ade9000_remove(dev));
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_ade9000_wfb_start_stop(void)
+{
+	uint32_t cfg;
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ade9000_wfb_start(dev, 1, false));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ade9000_wfb_isr(dev));
+
+	TEST_ASSERT_EQUAL_INT(0, ade9000_wfb_start(dev, ADE9000_SRC_SINC4, true));
+	cfg = model_regs[ADE9000_REG_WFB_CFG];
+	TEST_ASSERT_TRUE(cfg & ADE9000_WF_CAP_EN);
+	TEST_ASSERT_TRUE(cfg & ADE9000_WF_CAP_SEL);
+	TEST_ASSERT_TRUE(cfg & ADE9000_WF_IN_EN);
+	TEST_ASSERT_EQUAL_INT(ADE9000_SRC_SINC4, no_os_field_get(ADE9000_WF_SRC, cfg));
+	TEST_ASSERT_EQUAL_INT(ADE9000_MODE_TRIG_EN_EVENTS,
+			      no_os_field_get(ADE9000_WF_MODE, cfg));
+	TEST_ASSERT_EQUAL_INT(ADE9000_BURST_ALL_CH,
+			      no_os_field_get(ADE9000_BURST_CHAN, cfg));
+	TEST_ASSERT_EQUAL_UINT32(0x8080, model_regs[ADE9000_REG_WFB_PG_IRQEN]);
+	TEST_ASSERT_TRUE(model_regs[ADE9000_REG_MASK0] & ADE9000_MASK0_PAGE_FULL);
+
+	TEST_ASSERT_EQUAL_INT(0, ade9000_wfb_stop(dev));
+	TEST_ASSERT_FALSE(model_regs[ADE9000_REG_WFB_CFG] & ADE9000_WF_CAP_EN);
+	TEST_ASSERT_FALSE(model_regs[ADE9000_REG_MASK0] & ADE9000_MASK0_PAGE_FULL);
+	TEST_ASSERT_EQUAL_UINT32(0, model_regs[ADE9000_REG_WFB_PG_IRQEN]);
+}
+
+/* Every half of the buffer is read once, with a single burst. */
+void test_ade9000_wfb_ping_pong(void)
+{
+	uint32_t i;
+
+	TEST_ASSERT_EQUAL_INT(0, ade9000_wfb_start(dev, ADE9000_SRC_SINC4, false));
+	for (i = 0; i < NB_HALVES; i++) {
+		TEST_ASSERT_EQUAL_INT(0, ade9000_wfb_isr(dev));
+		model_fill(ADE9000_WFB_HALF_SETS);
+
+		model_transfers = 0;
+		TEST_ASSERT_EQUAL_INT(ADE9000_WFB_HALF_SETS, ade9000_wfb_isr(dev));
+		TEST_ASSERT_EQUAL_UINT32(4, model_transfers);
+		check_half(i * ADE9000_WFB_HALF_SETS);
+	}
+
+	TEST_ASSERT_EQUAL_UINT32(NB_HALVES, dev->wfb_nb_halves);
+	TEST_ASSERT_EQUAL_UINT32(0, dev->wfb_overruns);
+}
+
+/* A half overwritten before the interrupt is handled is counted. */
+void test_ade9000_wfb_overrun(void)
+{
+	TEST_ASSERT_EQUAL_INT(0, ade9000_wfb_start(dev, ADE9000_SRC_SINC4, false));
+	model_fill(2 * ADE9000_WFB_HALF_SETS);
+
+	TEST_ASSERT_EQUAL_INT(ADE9000_WFB_HALF_SETS, ade9000_wfb_isr(dev));
+	TEST_ASSERT_EQUAL_UINT32(1, dev->wfb_overruns);
+	check_half(ADE9000_WFB_HALF_SETS);
+
+	model_fill(ADE9000_WFB_HALF_SETS);
+	TEST_ASSERT_EQUAL_INT(ADE9000_WFB_HALF_SETS, ade9000_wfb_isr(dev));
+	TEST_ASSERT_EQUAL_UINT32(1, dev->wfb_overruns);
+	check_half(2 * ADE9000_WFB_HALF_SETS);
+}
+
+/* Skipping an even number of halves is an overrun too. */
+void test_ade9000_wfb_overrun_even(void)
+{
+	TEST_ASSERT_EQUAL_INT(0, ade9000_wfb_start(dev, ADE9000_SRC_SINC4, false));
+	model_fill(3 * ADE9000_WFB_HALF_SETS);
+
+	TEST_ASSERT_EQUAL_INT(ADE9000_WFB_HALF_SETS, ade9000_wfb_isr(dev));
+	TEST_ASSERT_EQUAL_UINT32(2, dev->wfb_overruns);
+	check_half(2 * ADE9000_WFB_HALF_SETS);
+
+	model_fill(4 * ADE9000_WFB_HALF_SETS);
+	TEST_ASSERT_EQUAL_INT(ADE9000_WFB_HALF_SETS, ade9000_wfb_isr(dev));
+	TEST_ASSERT_EQUAL_UINT32(5, dev->wfb_overruns);
+	check_half(6 * ADE9000_WFB_HALF_SETS);
+
+	model_fill(ADE9000_WFB_HALF_SETS);
+	TEST_ASSERT_EQUAL_INT(ADE9000_WFB_HALF_SETS, ade9000_wfb_isr(dev));
+	TEST_ASSERT_EQUAL_UINT32(5, dev->wfb_overruns);
+	check_half(7 * ADE9000_WFB_HALF_SETS);
+}
+
+/* Full scale codes are converted to the sensor values, in mV and mA. */
+void test_ade9000_wfb_convert(void)
+{
+	int32_t data[ADE9000_WFB_HALF_SETS];
+	uint8_t *set0;
+
+	TEST_ASSERT_EQUAL_INT(0, ade9000_wfb_start(dev, ADE9000_SRC_DSP, false));
+	model_fill(ADE9000_WFB_HALF_SETS);
+	TEST_ASSERT_EQUAL_INT(ADE9000_WFB_HALF_SETS, ade9000_wfb_isr(dev));
+
+	set0 = &dev->wfb_buf[2];
+	no_os_put_unaligned_be32(ADE9000_PCF_FS_CODES, &set0[ADE9000_WFB_VA * 4]);
+	no_os_put_unaligned_be32(-ADE9000_PCF_FS_CODES,
+				 &set0[ADE9000_WFB_IA * 4]);
+
+	TEST_ASSERT_EQUAL_INT(0, ade9000_wfb_convert(dev, ADE9000_WFB_VA, data));
+	TEST_ASSERT_EQUAL_INT(ADE9000_FS_PEAK_VOLTAGE * ADE9000_VOLTAGE_TR_FCN,
+			      data[0]);
+	TEST_ASSERT_EQUAL_INT(0, ade9000_wfb_convert(dev, ADE9000_WFB_IA, data));
+	TEST_ASSERT_EQUAL_INT(-ADE9000_FS_PEAK_VOLTAGE * ADE9000_CURRENT_TR_FCN,
+			      data[0]);
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ade9000_wfb_convert(dev,
+			      ADE9000_WFB_NB_CHAN, data));
+}
+
+/*
+ * Sample sets per second the SPI bus can move, polling the instantaneous
+ * value registers against reading the waveform buffer by halves, and the
+ * bus load at 32 kSPS.
+ */
+void test_ade9000_wfb_rate(void)
+{
+	static const uint16_t regs[] = {
+		ADE9000_REG_AI_PCF, ADE9000_REG_AV_PCF, ADE9000_REG_BI_PCF,
+		ADE9000_REG_BV_PCF, ADE9000_REG_CI_PCF, ADE9000_REG_CV_PCF,
+		ADE9000_REG_NI_PCF,
+	};
+	uint32_t poll_sps, wfb_sps, val, set, i;
+	uint64_t start;
+
+	start = model_now_ns;
+	for (set = 0; set < ADE9000_WFB_HALF_SETS; set++)
+		for (i = 0; i < NO_OS_ARRAY_SIZE(regs); i++)
+			TEST_ASSERT_EQUAL_INT(0, ade9000_read(dev, regs[i], &val));
+	poll_sps = ADE9000_WFB_HALF_SETS * 1000000000ull / (model_now_ns - start);
+
+	TEST_ASSERT_EQUAL_INT(0, ade9000_wfb_start(dev, ADE9000_SRC_SINC4, true));
+	model_fill(ADE9000_WFB_HALF_SETS);
+	start = model_now_ns;
+	TEST_ASSERT_EQUAL_INT(ADE9000_WFB_HALF_SETS, ade9000_wfb_isr(dev));
+	wfb_sps = ADE9000_WFB_HALF_SETS * 1000000000ull / (model_now_ns - start);
+
+	printf("mode             max [sets/s]  bus load @ 32 kSPS [%%]\n");
+	printf("register poll  %14u  %22u\n", poll_sps,
+	       SAMPLE_RATE * 100 / poll_sps);
+	printf("waveform buf   %14u  %22u\n", wfb_sps,
+	       SAMPLE_RATE * 100 / wfb_sps);
+
+	TEST_ASSERT_TRUE(poll_sps < SAMPLE_RATE);
+	TEST_ASSERT_TRUE(wfb_sps > 2 * SAMPLE_RATE);
+}
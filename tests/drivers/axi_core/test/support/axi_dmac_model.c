@@ -0,0 +1,218 @@
+/***************************************************************************//**
+ *   @file   axi_dmac_model.c
+ *   @brief  Register model of the AXI DMAC used by the unit tests.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <stdbool.h>
+#include <string.h>
+#include "no_os_axi_io.h"
+#include "axi_dmac.h"
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+/* Bus addresses of the simulated data memory and descriptor memory */
+#define MODEL_MEM_BUS		0x10000000u
+#define MODEL_MEM_SIZE		0x10000u
+#define MODEL_DESC_BUS		0x20000000u
+#define MODEL_MAX_LENGTH	0x3fffu
+
+/*
+ * A DEV_TO_MEM DMAC with a 64 bit destination bus. Every completed block is
+ * filled with the index of the block, counted from reset.
+ */
+static struct {
+	uint32_t regs[0x500 / 4];
+	bool has_sg;
+	uint32_t pending;
+	uint64_t sg_addr;
+	bool active;
+	uint32_t next_id;
+	uint32_t nb_blocks;
+	uint32_t nb_submits;
+	uint8_t mem[MODEL_MEM_SIZE];
+	struct axi_dmac_hw_desc *desc;
+	uint32_t desc_size;
+} model;
+
+/* Host address of the model memory, as a 32 bit bus address */
+#define MODEL_MEM_HOST		((uint32_t)(uintptr_t)model.mem)
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static void *model_ptr(uint64_t bus, uint32_t len)
+{
+	if (bus >= MODEL_MEM_BUS && bus + len <= MODEL_MEM_BUS + MODEL_MEM_SIZE)
+		return &model.mem[bus - MODEL_MEM_BUS];
+
+	/* Buffers the driver took from host pointers, such as IIO buffers */
+	if (len <= MODEL_MEM_SIZE && bus - MODEL_MEM_HOST <= MODEL_MEM_SIZE - len)
+		return &model.mem[bus - MODEL_MEM_HOST];
+
+	return NULL;
+}
+
+static struct axi_dmac_hw_desc *model_desc_ptr(uint64_t bus)
+{
+	uint32_t len = sizeof(struct axi_dmac_hw_desc);
+
+	/* Descriptors allocated by the driver are at their host address. */
+	if (!model.desc)
+		return (struct axi_dmac_hw_desc *)(uintptr_t)bus;
+
+	if (bus >= MODEL_DESC_BUS && bus + len <= MODEL_DESC_BUS + model.desc_size)
+		return (struct axi_dmac_hw_desc *)((uint8_t *)model.desc +
+						   (bus - MODEL_DESC_BUS));
+
+	return NULL;
+}
+
+static void model_reset(bool has_sg, struct axi_dmac_hw_desc *desc,
+			uint32_t desc_size)
+{
+	memset(&model, 0, sizeof(model));
+	model.has_sg = has_sg;
+	model.desc = desc;
+	model.desc_size = desc_size;
+	model.regs[AXI_DMAC_REG_INTF_DESC / 4] = 6;
+}
+
+/* Complete up to nb hardware blocks, return the number completed. */
+static uint32_t model_run(uint32_t nb)
+{
+	struct axi_dmac_hw_desc *desc;
+	uint32_t done = 0;
+	uint8_t *dst;
+
+	while (model.active && done < nb) {
+		desc = model_desc_ptr(model.sg_addr);
+		if (!desc)
+			return done;
+
+		dst = model_ptr(desc->dest_addr, desc->x_len + 1);
+		if (!dst)
+			return done;
+
+		memset(dst, model.nb_blocks & 0xff, desc->x_len + 1);
+		model.nb_blocks++;
+		desc->id = model.next_id++;
+		if (desc->flags & AXI_DMAC_HW_FLAG_IRQ)
+			model.pending |= AXI_DMAC_IRQ_EOT;
+		if (desc->flags & AXI_DMAC_HW_FLAG_LAST)
+			model.active = false;
+		else
+			model.sg_addr = desc->next_sg_addr;
+		done++;
+	}
+
+	return done;
+}
+
+/*******************************************************************************
+ *    AXI IO
+ ******************************************************************************/
+
+int32_t no_os_axi_io_read(uint32_t base, uint32_t offset, uint32_t *data)
+{
+	(void)base;
+
+	switch (offset) {
+	case AXI_DMAC_REG_IRQ_PENDING:
+		*data = model.pending & ~model.regs[AXI_DMAC_REG_IRQ_MASK / 4];
+		break;
+	case AXI_DMAC_REG_TRANSFER_SUBMIT:
+		*data = 0;
+		break;
+	default:
+		*data = model.regs[offset / 4];
+		break;
+	}
+
+	return 0;
+}
+
+int32_t no_os_axi_io_write(uint32_t base, uint32_t offset, uint32_t data)
+{
+	uint32_t ctrl = model.regs[AXI_DMAC_REG_CTRL / 4];
+
+	(void)base;
+
+	switch (offset) {
+	case AXI_DMAC_REG_IRQ_PENDING:
+		model.pending &= ~data;
+		return 0;
+	case AXI_DMAC_REG_X_LENGTH:
+		data &= MODEL_MAX_LENGTH;
+		break;
+	case AXI_DMAC_REG_DEST_ADDRESS:
+		data &= ~0x7u;
+		break;
+	case AXI_DMAC_REG_SRC_ADDRESS:
+		data = 0;
+		break;
+	case AXI_DMAC_REG_SG_ADDRESS:
+	case AXI_DMAC_REG_SG_ADDRESS_HIGH:
+		if (!model.has_sg)
+			data = 0;
+		break;
+	case AXI_DMAC_REG_CTRL:
+		if (!model.has_sg)
+			data &= ~AXI_DMAC_CTRL_ENABLE_SG;
+		if (!(data & AXI_DMAC_CTRL_ENABLE))
+			model.active = false;
+		break;
+	case AXI_DMAC_REG_TRANSFER_SUBMIT:
+		if (!(data & AXI_DMAC_TRANSFER_SUBMIT) ||
+		    !(ctrl & AXI_DMAC_CTRL_ENABLE))
+			return 0;
+		model.nb_submits++;
+		if (ctrl & AXI_DMAC_CTRL_ENABLE_SG) {
+			model.sg_addr = model.regs[AXI_DMAC_REG_SG_ADDRESS / 4] |
+					(uint64_t)model.regs[AXI_DMAC_REG_SG_ADDRESS_HIGH / 4]
+					<< 32;
+			model.active = true;
+		}
+		return 0;
+	default:
+		break;
+	}
+
+	model.regs[offset / 4] = data;
+
+	return 0;
+}
@@ -0,0 +1,350 @@
+/***************************************************************************//**
+ *   @file   test_axi_dmac.c
+ *   @brief  Unit tests for the AXI DMAC scatter-gather mode.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <errno.h>
+#include <string.h>
+#include "unity.h"
+#include "axi_dmac.h"
+#include "no_os_util.h"
+#include "no_os_alloc.h"
+#include "mock_no_os_delay.h"
+#include "axi_dmac_model.c"
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define NB_DESC		8
+#define BLOCK_SIZE	0x400
+
+static struct axi_dmac *dmac;
+static struct axi_dmac_hw_desc desc[NB_DESC];
+/* Descriptors as the DMAC sees them when desc is cached */
+static struct axi_dmac_hw_desc desc_mem[NB_DESC];
+static uint32_t nb_flush;
+static uint32_t nb_invalidate;
+static struct axi_dmac_sg_segment seg[NB_DESC];
+static uint32_t completed[4 * NB_DESC];
+static uint32_t nb_completed;
+
+static void sg_complete(void *ctx, uint32_t segment)
+{
+	TEST_ASSERT_TRUE(ctx == &nb_completed);
+	completed[nb_completed++] = segment;
+}
+
+static void desc_flush(uint32_t address, uint32_t bytes_count)
+{
+	uint32_t off = address - (uint32_t)(uintptr_t)desc;
+
+	TEST_ASSERT_TRUE(off + bytes_count <= sizeof(desc));
+	memcpy((uint8_t *)desc_mem + off, (uint8_t *)desc + off, bytes_count);
+	nb_flush++;
+}
+
+static void desc_invalidate(uint32_t address, uint32_t bytes_count)
+{
+	uint32_t off = address - (uint32_t)(uintptr_t)desc;
+
+	TEST_ASSERT_TRUE(off + bytes_count <= sizeof(desc));
+	memcpy((uint8_t *)desc + off, (uint8_t *)desc_mem + off, bytes_count);
+	nb_invalidate++;
+}
+
+static void init_dmac(bool has_sg, enum use_irq irq)
+{
+	struct axi_dmac_init init = {
+		.name = "rx_dmac",
+		.base = 0,
+		.irq_option = irq,
+	};
+
+	model_reset(has_sg, desc, sizeof(desc));
+	TEST_ASSERT_EQUAL_INT(0, axi_dmac_init(&dmac, &init));
+}
+
+static struct axi_dmac_sg_transfer sg_transfer(uint32_t nb,
+		enum cyclic_transfer cyclic)
+{
+	struct axi_dmac_sg_transfer sg = {
+		.segments = seg,
+		.nb_segments = nb,
+		.cyclic = cyclic,
+		.desc = desc,
+		.desc_phys = MODEL_DESC_BUS,
+		.complete = sg_complete,
+		.ctx = &nb_completed,
+	};
+	uint32_t i;
+
+	for (i = 0; i < nb; i++) {
+		seg[i].size = BLOCK_SIZE;
+		seg[i].dest_addr = MODEL_MEM_BUS + i * BLOCK_SIZE;
+		seg[i].src_addr = 0;
+	}
+
+	return sg;
+}
+
+static bool block_is(uint32_t i, uint8_t val)
+{
+	uint32_t k;
+
+	for (k = 0; k < BLOCK_SIZE; k++)
+		if (model.mem[i * BLOCK_SIZE + k] != val)
+			return false;
+
+	return true;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	no_os_mdelay_Ignore();
+	memset(desc, 0, sizeof(desc));
+	memset(desc_mem, 0, sizeof(desc_mem));
+	nb_flush = 0;
+	nb_invalidate = 0;
+	memset(completed, 0, sizeof(completed));
+	nb_completed = 0;
+	dmac = NULL;
+}
+
+void tearDown(void)
+{
+	axi_dmac_remove(dmac);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_axi_dmac_sg_detect(void)
+{
+	struct axi_dmac_sg_transfer sg;
+
+	init_dmac(true, IRQ_DISABLED);
+	TEST_ASSERT_TRUE(dmac->hw_sg);
+	TEST_ASSERT_EQUAL_INT(DMA_DEV_TO_MEM, dmac->direction);
+	TEST_ASSERT_EQUAL_UINT32(MODEL_MAX_LENGTH, dmac->max_length);
+	axi_dmac_remove(dmac);
+
+	init_dmac(false, IRQ_DISABLED);
+	TEST_ASSERT_FALSE(dmac->hw_sg);
+	sg = sg_transfer(2, NO);
+	TEST_ASSERT_EQUAL_INT(-ENOTSUP, axi_dmac_transfer_sg(dmac, &sg));
+}
+
+/* A whole chain runs from a single submit and completes in order. */
+void test_axi_dmac_sg_chain(void)
+{
+	struct axi_dmac_sg_transfer sg;
+	uint32_t i;
+
+	init_dmac(true, IRQ_DISABLED);
+	sg = sg_transfer(NB_DESC, NO);
+	TEST_ASSERT_EQUAL_INT(0, axi_dmac_transfer_sg(dmac, &sg));
+	TEST_ASSERT_EQUAL_UINT32(1, model.nb_submits);
+
+	TEST_ASSERT_EQUAL_UINT32(3, model_run(3));
+	TEST_ASSERT_EQUAL_UINT32(3, axi_dmac_sg_poll(dmac));
+	TEST_ASSERT_FALSE(dmac->transfer.transfer_done);
+
+	/* The DMAC stops after the descriptor flagged as last */
+	TEST_ASSERT_EQUAL_UINT32(NB_DESC - 3, model_run(2 * NB_DESC));
+	TEST_ASSERT_EQUAL_INT(0, axi_dmac_transfer_wait_completion(dmac, 10));
+	TEST_ASSERT_TRUE(dmac->transfer.transfer_done);
+	TEST_ASSERT_EQUAL_UINT32(0, axi_dmac_sg_poll(dmac));
+
+	TEST_ASSERT_EQUAL_UINT32(NB_DESC, nb_completed);
+	for (i = 0; i < NB_DESC; i++) {
+		TEST_ASSERT_EQUAL_UINT32(i, completed[i]);
+		TEST_ASSERT_TRUE(block_is(i, i));
+	}
+	TEST_ASSERT_EQUAL_UINT32(1, model.nb_submits);
+}
+
+/* A cyclic ring keeps running and is re-armed as segments are reported. */
+void test_axi_dmac_sg_cyclic(void)
+{
+	struct axi_dmac_sg_transfer sg;
+	uint32_t i;
+
+	init_dmac(true, IRQ_DISABLED);
+	sg = sg_transfer(3, CYCLIC);
+	TEST_ASSERT_EQUAL_INT(0, axi_dmac_transfer_sg(dmac, &sg));
+
+	TEST_ASSERT_EQUAL_UINT32(2, model_run(2));
+	TEST_ASSERT_EQUAL_UINT32(2, axi_dmac_sg_poll(dmac));
+	TEST_ASSERT_EQUAL_UINT32(3, model_run(3));
+	TEST_ASSERT_EQUAL_UINT32(3, axi_dmac_sg_poll(dmac));
+	TEST_ASSERT_EQUAL_UINT32(7, model_run(7));
+	TEST_ASSERT_EQUAL_UINT32(3, axi_dmac_sg_poll(dmac));
+	TEST_ASSERT_FALSE(dmac->transfer.transfer_done);
+
+	for (i = 0; i < 8; i++)
+		TEST_ASSERT_EQUAL_UINT32(i % 3, completed[i]);
+
+	/* The DMAC went round the ring four times */
+	TEST_ASSERT_TRUE(block_is(0, 9));
+	TEST_ASSERT_TRUE(block_is(1, 10));
+	TEST_ASSERT_TRUE(block_is(2, 11));
+
+	axi_dmac_transfer_stop(dmac);
+	TEST_ASSERT_EQUAL_UINT32(0, model_run(1));
+}
+
+/* Completion is reported from the interrupt handler. */
+void test_axi_dmac_sg_isr(void)
+{
+	struct axi_dmac_sg_transfer sg;
+
+	init_dmac(true, IRQ_ENABLED);
+	sg = sg_transfer(2, NO);
+	TEST_ASSERT_EQUAL_INT(0, axi_dmac_transfer_sg(dmac, &sg));
+
+	model_run(1);
+	axi_dmac_sg_isr(dmac);
+	TEST_ASSERT_EQUAL_UINT32(1, nb_completed);
+	TEST_ASSERT_EQUAL_UINT32(0, model.pending);
+
+	model_run(1);
+	axi_dmac_sg_isr(dmac);
+	TEST_ASSERT_EQUAL_UINT32(2, nb_completed);
+	TEST_ASSERT_EQUAL_INT(0, axi_dmac_transfer_wait_completion(dmac, 10));
+}
+
+void test_axi_dmac_sg_invalid(void)
+{
+	struct axi_dmac_sg_transfer sg;
+
+	init_dmac(true, IRQ_DISABLED);
+
+	sg = sg_transfer(0, NO);
+	TEST_ASSERT_EQUAL_INT(-EINVAL, axi_dmac_transfer_sg(dmac, &sg));
+
+	sg = sg_transfer(2, NO);
+	seg[1].size = MODEL_MAX_LENGTH + 2;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, axi_dmac_transfer_sg(dmac, &sg));
+
+	sg = sg_transfer(2, NO);
+	seg[1].dest_addr += 4;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, axi_dmac_transfer_sg(dmac, &sg));
+
+	sg = sg_transfer(2, NO);
+	sg.desc_phys += 4;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, axi_dmac_transfer_sg(dmac, &sg));
+
+	TEST_ASSERT_EQUAL_UINT32(0, model.nb_submits);
+}
+
+/* A regular transfer after a scatter-gather one leaves scatter-gather mode. */
+void test_axi_dmac_sg_then_single(void)
+{
+	struct axi_dma_transfer transfer = {
+		.size = BLOCK_SIZE,
+		.cyclic = NO,
+		.src_addr = 0,
+		.dest_addr = MODEL_MEM_BUS,
+	};
+	struct axi_dmac_sg_transfer sg;
+
+	init_dmac(true, IRQ_DISABLED);
+	sg = sg_transfer(2, NO);
+	TEST_ASSERT_EQUAL_INT(0, axi_dmac_transfer_sg(dmac, &sg));
+	TEST_ASSERT_EQUAL_UINT32(AXI_DMAC_CTRL_ENABLE | AXI_DMAC_CTRL_ENABLE_SG,
+				 model.regs[AXI_DMAC_REG_CTRL / 4]);
+
+	TEST_ASSERT_EQUAL_INT(0, axi_dmac_transfer_start(dmac, &transfer));
+	TEST_ASSERT_EQUAL_UINT32(AXI_DMAC_CTRL_ENABLE,
+				 model.regs[AXI_DMAC_REG_CTRL / 4]);
+	TEST_ASSERT_EQUAL_UINT32(0, dmac->sg_nb);
+	TEST_ASSERT_EQUAL_UINT32(BLOCK_SIZE - 1,
+				 model.regs[AXI_DMAC_REG_X_LENGTH / 4]);
+}
+
+/* Cached descriptors are flushed before use and invalidated before reading. */
+void test_axi_dmac_sg_dcache(void)
+{
+	struct axi_dmac_sg_transfer sg;
+	uint32_t i;
+
+	init_dmac(true, IRQ_DISABLED);
+	model.desc = desc_mem;
+	sg = sg_transfer(3, CYCLIC);
+	sg.dcache_flush_range = desc_flush;
+	sg.dcache_invalidate_range = desc_invalidate;
+	TEST_ASSERT_EQUAL_INT(0, axi_dmac_transfer_sg(dmac, &sg));
+	TEST_ASSERT_EQUAL_UINT32(1, nb_flush);
+
+	/* The DMAC only sees the chain because it was flushed */
+	TEST_ASSERT_EQUAL_UINT32(2, model_run(2));
+	TEST_ASSERT_EQUAL_UINT32(2, axi_dmac_sg_poll(dmac));
+	TEST_ASSERT_EQUAL_UINT32(3, nb_invalidate);
+
+	/* Re-armed descriptors reach the memory before the DMAC comes back */
+	TEST_ASSERT_EQUAL_UINT32(3, nb_flush);
+	TEST_ASSERT_EQUAL_UINT32(AXI_DMAC_SG_UNUSED, desc_mem[0].id);
+	TEST_ASSERT_EQUAL_UINT32(AXI_DMAC_SG_UNUSED, desc_mem[1].id);
+
+	TEST_ASSERT_EQUAL_UINT32(3, model_run(3));
+	TEST_ASSERT_EQUAL_UINT32(3, axi_dmac_sg_poll(dmac));
+	TEST_ASSERT_EQUAL_UINT32(5, nb_completed);
+	for (i = 0; i < 5; i++)
+		TEST_ASSERT_EQUAL_UINT32(i % 3, completed[i]);
+}
+
+/* A chain allocated by the driver does not share cache lines. */
+void test_axi_dmac_sg_alloc(void)
+{
+	struct axi_dmac_sg_transfer sg;
+
+	init_dmac(true, IRQ_DISABLED);
+	model.desc = NULL;
+	sg = sg_transfer(2, NO);
+	sg.desc = NULL;
+	TEST_ASSERT_EQUAL_INT(0, axi_dmac_transfer_sg(dmac, &sg));
+	TEST_ASSERT_EQUAL_UINT32(0, (uintptr_t)dmac->sg_desc %
+				 sizeof(struct axi_dmac_hw_desc));
+
+	TEST_ASSERT_EQUAL_UINT32(2, model_run(2));
+	TEST_ASSERT_EQUAL_UINT32(2, axi_dmac_sg_poll(dmac));
+	TEST_ASSERT_TRUE(dmac->transfer.transfer_done);
+}
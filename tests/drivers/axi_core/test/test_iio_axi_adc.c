@@ -0,0 +1,240 @@
+/***************************************************************************//**
+ *   @file   test_iio_axi_adc.c
+ *   @brief  Unit tests for the iio_axi_adc scatter-gather capture.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <errno.h>
+#include <string.h>
+#include "unity.h"
+#include "iio_axi_adc.h"
+#include "axi_adc_core.h"
+#include "axi_dmac.h"
+#include "no_os_circular_buffer.h"
+#include "no_os_util.h"
+#include "no_os_alloc.h"
+#include "mock_no_os_delay.h"
+#include "axi_dmac_model.c"
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define NB_BLOCKS	4
+#define BLOCK_SIZE	0x400
+
+static struct axi_dmac *dmac;
+static struct axi_adc adc = {
+	.name = "rx_adc",
+	.num_channels = 2,
+};
+static struct iio_axi_adc_desc *iio_adc;
+static struct iio_device *iio_dev;
+static struct no_os_circular_buffer cb;
+static struct iio_buffer buffer;
+static struct iio_device_data dev_data;
+static uint32_t invalidated[4 * NB_BLOCKS];
+static uint32_t nb_invalidate;
+static uint8_t data[BLOCK_SIZE];
+
+/* Shared by the data blocks and the descriptors, only blocks are recorded */
+static void data_invalidate(uint32_t address, uint32_t bytes_count)
+{
+	if (address - MODEL_MEM_HOST >= MODEL_MEM_SIZE)
+		return;
+
+	TEST_ASSERT_EQUAL_UINT32(BLOCK_SIZE, bytes_count);
+	invalidated[nb_invalidate++] = (address - MODEL_MEM_HOST) / BLOCK_SIZE;
+}
+
+static void init_iio(bool has_sg)
+{
+	struct axi_dmac_init dmac_init = {
+		.name = "rx_dmac",
+		.base = 0,
+		.irq_option = IRQ_DISABLED,
+	};
+	struct iio_axi_adc_init_param init = {
+		.rx_adc = &adc,
+		.rx_dmac = NULL,
+		.dcache_invalidate_range = data_invalidate,
+		.sg_capture = true,
+	};
+
+	model_reset(has_sg, NULL, 0);
+	TEST_ASSERT_EQUAL_INT(0, axi_dmac_init(&dmac, &dmac_init));
+	init.rx_dmac = dmac;
+	if (!has_sg) {
+		TEST_ASSERT_EQUAL_INT(-ENOTSUP, iio_axi_adc_init(&iio_adc, &init));
+		return;
+	}
+
+	TEST_ASSERT_EQUAL_INT(0, iio_axi_adc_init(&iio_adc, &init));
+	iio_axi_adc_get_dev_descriptor(iio_adc, &iio_dev);
+
+	/* The IIO buffer as iio_open_dev() sets it up, over the model memory */
+	buffer.active_mask = 0x3;
+	buffer.bytes_per_scan = 4;
+	buffer.samples = BLOCK_SIZE / buffer.bytes_per_scan;
+	buffer.size = BLOCK_SIZE;
+	buffer.dir = IIO_DIRECTION_INPUT;
+	buffer.buf = &cb;
+	no_os_cb_cfg(&cb, (int8_t *)model.mem, NB_BLOCKS * BLOCK_SIZE);
+	dev_data.dev = iio_adc;
+	dev_data.buffer = &buffer;
+}
+
+static uint32_t available(void)
+{
+	uint32_t size;
+
+	no_os_cb_size(&cb, &size);
+
+	return size;
+}
+
+/* Read one block from the IIO buffer and check it holds val. */
+static bool read_block_is(uint8_t val)
+{
+	uint32_t k;
+
+	if (no_os_cb_read(&cb, data, BLOCK_SIZE))
+		return false;
+
+	for (k = 0; k < BLOCK_SIZE; k++)
+		if (data[k] != val)
+			return false;
+
+	return true;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	no_os_mdelay_Ignore();
+	memset(&buffer, 0, sizeof(buffer));
+	memset(&dev_data, 0, sizeof(dev_data));
+	memset(invalidated, 0, sizeof(invalidated));
+	nb_invalidate = 0;
+	dmac = NULL;
+	iio_adc = NULL;
+}
+
+void tearDown(void)
+{
+	if (iio_adc)
+		iio_axi_adc_remove(iio_adc);
+	axi_dmac_remove(dmac);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_iio_axi_adc_sg_needs_hw_sg(void)
+{
+	init_iio(false);
+	TEST_ASSERT_NULL(iio_adc);
+}
+
+/* Blocks reach the IIO buffer as the ring completes them, from one submit. */
+void test_iio_axi_adc_sg_ring(void)
+{
+	uint32_t i;
+
+	init_iio(true);
+	TEST_ASSERT_NOT_NULL(iio_dev->submit);
+	TEST_ASSERT_NOT_NULL(iio_dev->post_disable);
+
+	TEST_ASSERT_EQUAL_INT(0, iio_dev->submit(&dev_data));
+	TEST_ASSERT_EQUAL_UINT32(1, model.nb_submits);
+	TEST_ASSERT_EQUAL_UINT32(0, available());
+
+	model_run(2);
+	TEST_ASSERT_EQUAL_INT(0, iio_dev->submit(&dev_data));
+	TEST_ASSERT_EQUAL_UINT32(2 * BLOCK_SIZE, available());
+	TEST_ASSERT_TRUE(read_block_is(0));
+	TEST_ASSERT_TRUE(read_block_is(1));
+
+	/* The ring wraps around the IIO buffer */
+	model_run(3);
+	TEST_ASSERT_EQUAL_INT(0, iio_dev->submit(&dev_data));
+	TEST_ASSERT_EQUAL_UINT32(3 * BLOCK_SIZE, available());
+	TEST_ASSERT_TRUE(read_block_is(2));
+	TEST_ASSERT_TRUE(read_block_is(3));
+	TEST_ASSERT_TRUE(read_block_is(4));
+	TEST_ASSERT_EQUAL_UINT32(1, model.nb_submits);
+
+	/* Each block is invalidated before it is published */
+	TEST_ASSERT_EQUAL_UINT32(5, nb_invalidate);
+	for (i = 0; i < nb_invalidate; i++)
+		TEST_ASSERT_EQUAL_UINT32(i % NB_BLOCKS, invalidated[i]);
+}
+
+/* Closing the buffer stops the ring; the next open starts a new one. */
+void test_iio_axi_adc_sg_restart(void)
+{
+	init_iio(true);
+	TEST_ASSERT_EQUAL_INT(0, iio_dev->submit(&dev_data));
+	model_run(1);
+
+	TEST_ASSERT_EQUAL_INT(0, iio_dev->post_disable(iio_adc));
+	TEST_ASSERT_EQUAL_UINT32(0, model_run(1));
+	axi_dmac_sg_poll(dmac);
+	TEST_ASSERT_EQUAL_UINT32(0, available());
+
+	no_os_cb_cfg(&cb, (int8_t *)model.mem, NB_BLOCKS * BLOCK_SIZE);
+	TEST_ASSERT_EQUAL_INT(0, iio_dev->submit(&dev_data));
+	TEST_ASSERT_EQUAL_UINT32(2, model.nb_submits);
+	model_run(1);
+	TEST_ASSERT_EQUAL_INT(0, iio_dev->submit(&dev_data));
+	TEST_ASSERT_TRUE(read_block_is(1));
+}
+
+/* Blocks larger than a descriptor can move are refused. */
+void test_iio_axi_adc_sg_block_too_big(void)
+{
+	init_iio(true);
+	buffer.size = 2 * (MODEL_MAX_LENGTH + 1);
+	no_os_cb_cfg(&cb, (int8_t *)model.mem, buffer.size);
+	TEST_ASSERT_EQUAL_INT(-EINVAL, iio_dev->submit(&dev_data));
+	TEST_ASSERT_EQUAL_UINT32(0, model.nb_submits);
+
+	buffer.size = BLOCK_SIZE;
+	no_os_cb_cfg(&cb, (int8_t *)model.mem, NB_BLOCKS * BLOCK_SIZE);
+	TEST_ASSERT_EQUAL_INT(0, iio_dev->submit(&dev_data));
+}
@@ -0,0 +1,257 @@
+/***************************************************************************//**
+ *   @file   adis1657x_model.c
+ *   @brief  Simulated ADIS1657x FIFO for the burst drain tests.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "no_os_delay.h"
+#include "no_os_spi.h"
+#include "no_os_util.h"
+
+/*
+ * ADIS1657x seen from the FIFO burst path, on a simulated time base.
+ * Samples enter the FIFO every 1 / odr seconds, with the FIFO overwriting
+ * the oldest sample when full. A burst frame returns the sample popped by
+ * the previous frame, then pops the next one if its command is 0x68.
+ * Register frames return the register addressed by the previous frame,
+ * only FIFO_CNT is implemented. Sample n has data counter n, starting at 1.
+ *
+ * Every SPI call costs model_call_ns of CPU time, a busy-wait delay costs
+ * its length, the SCLK and stall time only costs bus time. With
+ * model_busy_wait, the controller times cs_change_delay with no_os_udelay()
+ * as the maxim and stm32 transfer ops do, so the stall time costs CPU time too.
+ */
+#define MODEL_FIFO_DEPTH	512
+#define MODEL_FIFO_CNT_REG	0x3C
+#define MODEL_SCLK_HZ		2000000
+#define MODEL_FRAME_16		22
+#define MODEL_FRAME_32		36
+
+static uint64_t model_now_ns;
+static uint64_t model_cpu_ns;
+static uint64_t model_period_ns;
+static uint64_t model_call_ns;
+static uint32_t model_produced;
+static uint32_t model_fifo[MODEL_FIFO_DEPTH];
+static uint32_t model_head;
+static uint32_t model_count;
+static uint32_t model_overflows;
+static uint32_t model_out;
+static uint8_t model_reg;
+static uint32_t model_bad_cntr;
+static uint32_t model_transfers;
+static bool model_busy_wait;
+static uint32_t model_allocs;
+
+static void model_reset(uint32_t odr, uint32_t call_us)
+{
+	model_now_ns = 0;
+	model_cpu_ns = 0;
+	model_period_ns = 1000000000ull / odr;
+	model_call_ns = call_us * 1000ull;
+	model_produced = 0;
+	model_head = 0;
+	model_count = 0;
+	model_overflows = 0;
+	model_out = 0;
+	model_reg = 0;
+	model_bad_cntr = 0;
+	model_transfers = 0;
+	model_busy_wait = false;
+	model_allocs = 0;
+}
+
+static void model_update(void)
+{
+	while ((uint64_t)(model_produced + 1) * model_period_ns <= model_now_ns) {
+		model_produced++;
+		if (model_count == MODEL_FIFO_DEPTH) {
+			model_head = (model_head + 1) % MODEL_FIFO_DEPTH;
+			model_count--;
+			model_overflows++;
+		}
+		model_fifo[(model_head + model_count) % MODEL_FIFO_DEPTH] =
+			model_produced;
+		model_count++;
+	}
+}
+
+/* Time at which the FIFO holds at least cnt samples */
+static void model_wait_fifo(uint32_t cnt)
+{
+	uint64_t t = (uint64_t)(model_produced + cnt - model_count) *
+		     model_period_ns;
+
+	if (model_count < cnt && t > model_now_ns)
+		model_now_ns = t;
+	model_update();
+}
+
+static void model_put_be16(uint8_t *buf, uint16_t val)
+{
+	buf[0] = val >> 8;
+	buf[1] = val;
+}
+
+/* Burst frame of sample cntr, 0 for an empty FIFO */
+static void model_frame(uint8_t *rx, uint32_t len, uint32_t cntr)
+{
+	uint32_t axis = len == MODEL_FRAME_32 ? 24 : 12;
+	uint16_t sum = 0;
+	uint32_t i;
+
+	memset(rx, 0, len);
+	if (!cntr)
+		return;
+
+	for (i = 0; i < axis; i += 2)
+		model_put_be16(&rx[4 + i], cntr * 8 + i);
+	model_put_be16(&rx[4 + axis], 0x1234);
+	model_put_be16(&rx[6 + axis], cntr);
+
+	for (i = 4; i < len - 2; i++)
+		sum += rx[i];
+	if (cntr == model_bad_cntr)
+		sum++;
+	model_put_be16(&rx[len - 2], sum);
+}
+
+static void model_msg(const uint8_t *tx, uint8_t *rx, uint32_t len)
+{
+	uint8_t frame[MODEL_FRAME_32];
+	uint8_t cmd = tx ? tx[0] : 0;
+
+	model_now_ns += len * 8 * 1000000000ull / MODEL_SCLK_HZ;
+	model_update();
+
+	if (len == MODEL_FRAME_16 || len == MODEL_FRAME_32) {
+		model_frame(frame, len, model_out);
+		if (rx)
+			memcpy(rx, frame, len);
+		if (cmd == 0x68) {
+			model_out = 0;
+			if (model_count) {
+				model_out = model_fifo[model_head];
+				model_head = (model_head + 1) % MODEL_FIFO_DEPTH;
+				model_count--;
+			}
+		}
+		return;
+	}
+
+	if (rx && len == 2)
+		model_put_be16(rx, model_reg == MODEL_FIFO_CNT_REG ? model_count : 0);
+	if (!(cmd & 0x80))
+		model_reg = cmd;
+}
+
+static int32_t model_spi_write_and_read(struct no_os_spi_desc *desc,
+					uint8_t *data, uint16_t bytes_number)
+{
+	uint8_t tx[MODEL_FRAME_32];
+
+	NO_OS_UNUSED_PARAM(desc);
+
+	model_transfers++;
+	model_now_ns += model_call_ns;
+	model_cpu_ns += model_call_ns;
+	memcpy(tx, data, bytes_number);
+	model_msg(tx, data, bytes_number);
+
+	return 0;
+}
+
+static int32_t model_spi_transfer(struct no_os_spi_desc *desc,
+				  struct no_os_spi_msg *msgs, uint32_t len)
+{
+	uint32_t i;
+
+	NO_OS_UNUSED_PARAM(desc);
+
+	model_transfers++;
+	model_now_ns += model_call_ns;
+	model_cpu_ns += model_call_ns;
+	for (i = 0; i < len; i++) {
+		model_msg(msgs[i].tx_buff, msgs[i].rx_buff, msgs[i].bytes_number);
+		if (model_busy_wait) {
+			no_os_udelay(msgs[i].cs_delay_last);
+			if (msgs[i].cs_change)
+				no_os_udelay(msgs[i].cs_change_delay);
+			continue;
+		}
+		model_now_ns += msgs[i].cs_delay_last * 1000ull;
+		if (msgs[i].cs_change)
+			model_now_ns += msgs[i].cs_change_delay * 1000ull;
+	}
+
+	return 0;
+}
+
+static const struct no_os_spi_platform_ops model_spi_ops = {
+	.write_and_read = model_spi_write_and_read,
+	.transfer = model_spi_transfer,
+};
+
+/* A controller without transfer op, served by the no_os_spi_transfer() fallback */
+static const struct no_os_spi_platform_ops model_spi_wr_ops = {
+	.write_and_read = model_spi_write_and_read,
+};
+
+void no_os_udelay(uint32_t usecs)
+{
+	model_now_ns += usecs * 1000ull;
+	model_cpu_ns += usecs * 1000ull;
+}
+
+void no_os_mdelay(uint32_t msecs)
+{
+	no_os_udelay(msecs * 1000);
+}
+
+struct no_os_time no_os_get_time(void)
+{
+	struct no_os_time t = {
+		.s = model_now_ns / 1000000000ull,
+		.us = model_now_ns / 1000 % 1000000,
+	};
+
+	return t;
+}
+
+/* Count the allocations, none is expected while draining the FIFO */
+void *no_os_calloc(size_t nitems, size_t size)
+{
+	model_allocs++;
+
+	return calloc(nitems, size);
+}
@@ -0,0 +1,421 @@
+/***************************************************************************//**
+ *   @file   test_adis1657x_fifo.c
+ *   @brief  Unit tests and benchmark for the ADIS1657x FIFO burst drain.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <errno.h>
+#include "unity.h"
+#include "adis.h"
+#include "adis1657x.h"
+#include "iio_adis_internals.h"
+#include "no_os_alloc.h"
+#include "no_os_circular_buffer.h"
+#include "no_os_spi.h"
+#include "no_os_util.h"
+#include "adis1657x_model.c"
+
+TEST_FILE("no_os_gpio.c")
+TEST_FILE("no_os_mutex.c")
+TEST_FILE("iio_adis.c")
+TEST_FILE("iio.c")
+TEST_FILE("iiod.c")
+TEST_FILE("iio_trigger.c")
+TEST_FILE("no_os_list.c")
+TEST_FILE("no_os_uart.c")
+TEST_FILE("no_os_irq.c")
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define CALL_US		15
+#define WATERMARK	32
+#define SIM_NS		1000000000ull
+
+static struct no_os_spibus_desc bus;
+static struct no_os_spi_desc spi = {
+	.bus = &bus,
+	.platform_ops = &model_spi_ops,
+};
+static struct adis_dev adis;
+static struct adis_burst_data data[ADIS_FIFO_BURST_MAX];
+
+/* Temperature channel only, 16-bit */
+static struct scan_type temp_scan = {
+	.sign = 's',
+	.realbits = 16,
+	.storagebits = 16,
+};
+static struct iio_channel channels[ADIS_NUM_CHAN] = {
+	[ADIS_TEMP] = { .scan_type = &temp_scan },
+};
+static struct iio_device iio_dev = {
+	.channels = channels,
+};
+
+struct drain_stats {
+	uint32_t last;
+	uint32_t samples;
+	uint32_t lost;
+	uint64_t busy_ns;
+};
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static void record(struct drain_stats *st, struct adis_burst_data *d)
+{
+	uint32_t cntr = d->data_cntr_lsb;
+
+	/* The first frame of a drain repeats the last sample */
+	if (cntr <= st->last)
+		return;
+
+	st->lost += cntr - st->last - 1;
+	st->last = cntr;
+	st->samples++;
+}
+
+/* Drain like the trigger handler used to, one SPI transaction per sample */
+static void drain_per_sample(struct drain_stats *st)
+{
+	struct adis_burst_data d;
+	uint32_t cnt, j;
+
+	TEST_ASSERT_EQUAL_INT(0, adis_read_fifo_cnt(&adis, &cnt));
+	no_os_udelay(10);
+	if (cnt <= 2)
+		return;
+
+	for (j = 0; j <= cnt; j++) {
+		if (!adis_read_burst_data(&adis, &d, false, 0, j < cnt, false))
+			record(st, &d);
+		no_os_udelay(10);
+	}
+}
+
+/* Drain like adis_iio_trigger_handler_with_fifo() */
+static void drain_burst(struct drain_stats *st)
+{
+	uint32_t cnt, nb;
+	int ret, j;
+
+	TEST_ASSERT_EQUAL_INT(0, adis_read_fifo_cnt(&adis, &cnt));
+	no_os_udelay(10);
+	if (cnt <= 2)
+		return;
+
+	while (cnt) {
+		nb = no_os_min(cnt, (uint32_t)ADIS_FIFO_BURST_MAX);
+		ret = adis_read_burst_data_fifo(&adis, data, nb, false, 0, true);
+		TEST_ASSERT_TRUE(ret >= 0);
+		for (j = 0; j < ret; j++)
+			record(st, &data[j]);
+		cnt -= nb;
+	}
+}
+
+/* Serve the data ready interrupt at the watermark for one second */
+static void simulate(uint32_t odr, bool burst, bool busy_wait,
+		     struct drain_stats *st)
+{
+	uint64_t t0;
+
+	memset(st, 0, sizeof(*st));
+	model_reset(odr, CALL_US);
+	model_busy_wait = busy_wait;
+	while (model_now_ns < SIM_NS) {
+		model_wait_fifo(WATERMARK);
+		t0 = model_now_ns;
+		if (burst)
+			drain_burst(st);
+		else
+			drain_per_sample(st);
+		st->busy_ns += model_now_ns - t0;
+	}
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	memset(&adis, 0, sizeof(adis));
+	adis.spi_desc = &spi;
+	adis.info = &adis1657x_chip_info;
+	adis.fifo_msgs = no_os_calloc(ADIS_FIFO_BURST_MAX + 1,
+				      sizeof(*adis.fifo_msgs));
+	adis.fifo_rx = no_os_calloc(ADIS_FIFO_BURST_MAX + 1,
+				    ADIS_FIFO_BURST_FRAME_MAX);
+	model_reset(2000, CALL_US);
+}
+
+void tearDown(void)
+{
+	no_os_free(adis.fifo_rx);
+	no_os_free(adis.fifo_msgs);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_adis1657x_fifo_burst_invalid(void)
+{
+	TEST_ASSERT_EQUAL_INT(-EINVAL, adis_read_burst_data_fifo(&adis, data, 0,
+			      false, 0, true));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, adis_read_burst_data_fifo(&adis, data,
+			      ADIS_FIFO_BURST_MAX + 1, false, 0, true));
+
+	/* The burst buffers are allocated by the IIO init */
+	no_os_free(adis.fifo_msgs);
+	adis.fifo_msgs = NULL;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, adis_read_burst_data_fifo(&adis, data, 1,
+			      false, 0, true));
+}
+
+/* All samples come in order from a single SPI transfer. */
+void test_adis1657x_fifo_burst_read(void)
+{
+	uint32_t i;
+
+	model_wait_fifo(20);
+	TEST_ASSERT_EQUAL_INT(20, adis_read_burst_data_fifo(&adis, data, 20,
+			      false, 0, true));
+	TEST_ASSERT_EQUAL_UINT32(1, model_transfers);
+	TEST_ASSERT_EQUAL_UINT32(0, model_allocs);
+	for (i = 0; i < 20; i++)
+		TEST_ASSERT_EQUAL_UINT32(i + 1, data[i].data_cntr_lsb);
+	TEST_ASSERT_FALSE(adis.diag_flags.checksum_err);
+}
+
+/* Controllers without a transfer op get the frames one by one, in place. */
+void test_adis1657x_fifo_burst_no_transfer(void)
+{
+	uint32_t i;
+
+	spi.platform_ops = &model_spi_wr_ops;
+	model_wait_fifo(20);
+	TEST_ASSERT_EQUAL_INT(20, adis_read_burst_data_fifo(&adis, data, 20,
+			      false, 0, true));
+	TEST_ASSERT_EQUAL_UINT32(21, model_transfers);
+	for (i = 0; i < 20; i++)
+		TEST_ASSERT_EQUAL_UINT32(i + 1, data[i].data_cntr_lsb);
+	TEST_ASSERT_FALSE(adis.diag_flags.checksum_err);
+	spi.platform_ops = &model_spi_ops;
+}
+
+/* Frames from an empty FIFO are dropped without a checksum error. */
+void test_adis1657x_fifo_burst_short(void)
+{
+	uint32_t i;
+
+	model_reset(100, CALL_US);
+	model_wait_fifo(4);
+	TEST_ASSERT_EQUAL_INT(4, adis_read_burst_data_fifo(&adis, data, 10,
+			      false, 0, true));
+	TEST_ASSERT_FALSE(adis.diag_flags.checksum_err);
+	for (i = 0; i < 4; i++)
+		TEST_ASSERT_EQUAL_UINT32(i + 1, data[i].data_cntr_lsb);
+}
+
+/* Frames with a bad checksum are dropped and flagged. */
+void test_adis1657x_fifo_burst_drop(void)
+{
+	uint32_t i;
+
+	adis.burst32 = true;
+	model_bad_cntr = 3;
+	model_wait_fifo(8);
+	TEST_ASSERT_EQUAL_INT(7, adis_read_burst_data_fifo(&adis, data, 8,
+			      true, 0, true));
+	TEST_ASSERT_TRUE(adis.diag_flags.checksum_err);
+	for (i = 0; i < 7; i++)
+		TEST_ASSERT_EQUAL_UINT32(i < 2 ? i + 1 : i + 2, data[i].data_cntr_lsb);
+	TEST_ASSERT_EQUAL_UINT32(0x1234, no_os_get_unaligned_be16(
+					 (uint8_t *)&data[0].temp_lsb));
+
+	/* Without the check, the sample goes through */
+	model_reset(2000, CALL_US);
+	model_bad_cntr = 3;
+	model_wait_fifo(8);
+	TEST_ASSERT_EQUAL_INT(8, adis_read_burst_data_fifo(&adis, data, 8,
+			      true, 0, false));
+	TEST_ASSERT_FALSE(adis.diag_flags.checksum_err);
+}
+
+/*
+ * The trigger handler drains the FIFO into the IIO buffer, one circular
+ * buffer write per burst and without allocation.
+ */
+void test_adis1657x_fifo_trigger_handler(void)
+{
+	struct adis_iio_dev iio_adis = {
+		.adis_dev = &adis,
+		.iio_dev = &iio_dev,
+	};
+	struct iio_buffer buffer = {
+		.active_mask = NO_OS_BIT(ADIS_TEMP),
+		.bytes_per_scan = sizeof(uint16_t),
+		.samples = 64,
+	};
+	struct iio_device_data dev_data = {
+		.dev = &iio_adis,
+		.buffer = &buffer,
+	};
+	uint16_t scan;
+	uint32_t size;
+
+	iio_adis.fifo_data = no_os_calloc(ADIS_FIFO_BURST_MAX,
+					  sizeof(*iio_adis.fifo_data));
+	iio_adis.fifo_scans = no_os_calloc(ADIS_FIFO_BURST_MAX,
+					   sizeof(iio_adis.data));
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_init(&buffer.buf,
+					       buffer.samples * buffer.bytes_per_scan));
+	model_allocs = 0;
+
+	/* Bursts of 32 and 8 samples */
+	model_wait_fifo(40);
+	TEST_ASSERT_EQUAL_INT(0, adis_iio_trigger_handler_with_fifo(&dev_data));
+	TEST_ASSERT_EQUAL_UINT32(0, model_allocs);
+	TEST_ASSERT_EQUAL_UINT32(3, model_transfers);
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_size(buffer.buf, &size));
+	TEST_ASSERT_EQUAL_UINT32(40 * sizeof(scan), size);
+	TEST_ASSERT_EQUAL_UINT32(40, iio_adis.data_cntr);
+	TEST_ASSERT_EQUAL_UINT32(0, iio_adis.samples_lost);
+	TEST_ASSERT_EQUAL_INT(0, iio_buffer_pop_scan(&buffer, &scan));
+	TEST_ASSERT_EQUAL_UINT32(0x1234, no_os_get_unaligned_be16(
+					 (uint8_t *)&scan));
+
+	/* Not more than the buffer size */
+	while (!iio_buffer_pop_scan(&buffer, &scan))
+		;
+	model_wait_fifo(80);
+	TEST_ASSERT_EQUAL_INT(0, adis_iio_trigger_handler_with_fifo(&dev_data));
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_size(buffer.buf, &size));
+	TEST_ASSERT_EQUAL_UINT32(64 * sizeof(scan), size);
+	TEST_ASSERT_EQUAL_UINT32(104, iio_adis.data_cntr);
+	TEST_ASSERT_EQUAL_UINT32(0, iio_adis.samples_lost);
+
+	no_os_cb_remove(buffer.buf);
+	no_os_free(iio_adis.fifo_scans);
+	no_os_free(iio_adis.fifo_data);
+}
+
+/*
+ * With only unbuffered channels enabled the FIFO is still drained, the
+ * diagnosis flags and the data counter are updated and nothing is stored.
+ */
+void test_adis1657x_fifo_trigger_handler_no_scan(void)
+{
+	struct adis_iio_dev iio_adis = {
+		.adis_dev = &adis,
+		.iio_dev = &iio_dev,
+	};
+	struct iio_buffer buffer = {
+		.active_mask = 0,
+		.bytes_per_scan = 0,
+		.samples = 64,
+	};
+	struct iio_device_data dev_data = {
+		.dev = &iio_adis,
+		.buffer = &buffer,
+	};
+	uint32_t size;
+
+	iio_adis.fifo_data = no_os_calloc(ADIS_FIFO_BURST_MAX,
+					  sizeof(*iio_adis.fifo_data));
+	iio_adis.fifo_scans = no_os_calloc(ADIS_FIFO_BURST_MAX,
+					   sizeof(iio_adis.data));
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_init(&buffer.buf, 64));
+
+	model_wait_fifo(10);
+	TEST_ASSERT_EQUAL_INT(0, adis_iio_trigger_handler_with_fifo(&dev_data));
+	TEST_ASSERT_EQUAL_UINT32(10, iio_adis.data_cntr);
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_size(buffer.buf, &size));
+	TEST_ASSERT_EQUAL_UINT32(0, size);
+
+	model_wait_fifo(1);
+	TEST_ASSERT_EQUAL_INT(0, adis_iio_trigger_handler(&dev_data));
+
+	no_os_cb_remove(buffer.buf);
+	no_os_free(iio_adis.fifo_scans);
+	no_os_free(iio_adis.fifo_data);
+}
+
+/*
+ * Report CPU and bus load of both drain methods at typical data rates, for
+ * controllers timing the stall themselves (spidev, DMA) and for those
+ * busy-waiting it in the transfer op (maxim, stm32).
+ */
+void test_adis1657x_fifo_sustained_odr(void)
+{
+	static const uint32_t odrs[] = {1000, 2000, 4000};
+	struct drain_stats single, burst, burst_wait;
+	uint64_t single_cpu, burst_cpu, burst_wait_cpu;
+	uint32_t i;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(odrs); i++) {
+		simulate(odrs[i], false, false, &single);
+		single_cpu = model_cpu_ns;
+		simulate(odrs[i], true, false, &burst);
+		burst_cpu = model_cpu_ns;
+		simulate(odrs[i], true, true, &burst_wait);
+		burst_wait_cpu = model_cpu_ns;
+
+		TEST_ASSERT_EQUAL_UINT32(0, burst.lost);
+		TEST_ASSERT_EQUAL_UINT32(0, burst_wait.lost);
+		TEST_ASSERT_EQUAL_UINT32(0, model_overflows);
+		TEST_ASSERT_TRUE(burst.samples + 2 * WATERMARK >= odrs[i]);
+		TEST_ASSERT_TRUE(burst_cpu * 4 < single_cpu);
+		TEST_ASSERT_TRUE(burst_wait_cpu < single_cpu);
+
+		printf("adis1657x FIFO at %u Hz: per-sample %.1f%% CPU, "
+		       "%.1f%% bus, %u lost, max %.0f Hz; "
+		       "burst %.1f%% CPU (%.1f%% busy-waiting the stall), "
+		       "%.1f%% bus, %u lost, max %.0f Hz\n",
+		       odrs[i],
+		       100.0 * single_cpu / model_now_ns,
+		       100.0 * single.busy_ns / model_now_ns, single.lost,
+		       single.samples * 1e9 / single.busy_ns,
+		       100.0 * burst_cpu / model_now_ns,
+		       100.0 * burst_wait_cpu / model_now_ns,
+		       100.0 * burst.busy_ns / model_now_ns, burst.lost,
+		       burst.samples * 1e9 / burst.busy_ns);
+	}
+}
@@ -0,0 +1,197 @@
+/***************************************************************************//**
+ *   @file   ltc2983_model.c
+ *   @brief  Simulated LTC2983 for the multi-channel scan tests.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "no_os_delay.h"
+#include "no_os_gpio.h"
+#include "no_os_spi.h"
+#include "no_os_util.h"
+#include "ltc2983.h"
+
+/*
+ * LTC2983 register map on a simulated time base. Writing the start bit to
+ * the status register converts the selected channel, or all channels of
+ * the multiple channel mask for channel select 0, one after the other in
+ * model_tconv_ms each. Until then, the start bit reads back as 1 and
+ * INTERRUPT is low. Channel n reads n degrees, negated for odd channels,
+ * except for model_bad_chan whose result is not valid.
+ */
+#define MODEL_MEM_SIZE		0x400
+#define MODEL_SCLK_HZ		2000000
+/* Status register done bit, set while no conversion is running */
+#define MODEL_STATUS_DONE	NO_OS_BIT(6)
+
+static uint8_t model_mem[MODEL_MEM_SIZE];
+static uint64_t model_now_ns;
+static uint64_t model_end_ns;
+static uint32_t model_mask;
+static uint32_t model_tconv_ms;
+static bool model_busy;
+static uint32_t model_bad_chan;
+static uint32_t model_transfers;
+
+static void model_reset(uint32_t tconv_ms)
+{
+	memset(model_mem, 0, sizeof(model_mem));
+	model_mem[LTC2983_STATUS_REG] = MODEL_STATUS_DONE;
+	model_now_ns = 0;
+	model_end_ns = 0;
+	model_mask = 0;
+	model_tconv_ms = tconv_ms;
+	model_busy = false;
+	model_bad_chan = 0;
+	model_transfers = 0;
+}
+
+static int32_t model_temp(uint32_t chan)
+{
+	int32_t val = chan * 1024;
+
+	return (chan & 1) ? -val : val;
+}
+
+static void model_update(void)
+{
+	uint32_t chan, res;
+
+	if (!model_busy || model_now_ns < model_end_ns)
+		return;
+
+	for (chan = 1; chan <= LTC2983_MAX_CHANNELS; chan++) {
+		if (!(model_mask & NO_OS_BIT(chan - 1)))
+			continue;
+
+		res = 0;
+		if (chan != model_bad_chan)
+			res = LTC2983_RES_VALID_MASK |
+			      (model_temp(chan) & LTC2983_DATA_MASK);
+		no_os_put_unaligned_be32(res,
+					 &model_mem[LTC2983_CHAN_RES_ADDR(chan)]);
+	}
+
+	model_mem[LTC2983_STATUS_REG] &= ~LTC2983_STATUS_START_MASK;
+	model_mem[LTC2983_STATUS_REG] |= MODEL_STATUS_DONE;
+	model_busy = false;
+}
+
+static void model_start(uint8_t status)
+{
+	uint32_t chan = no_os_field_get(LTC2983_STATUS_CHAN_SEL_MASK, status);
+
+	if (chan)
+		model_mask = NO_OS_BIT(chan - 1);
+	else
+		model_mask = no_os_get_unaligned_be32(
+				     &model_mem[LTC2983_MULT_CHANNEL_REG]);
+
+	model_end_ns = model_now_ns + no_os_hweight32(model_mask) *
+		       model_tconv_ms * 1000000ull;
+	model_busy = true;
+	model_mem[LTC2983_STATUS_REG] = status & ~MODEL_STATUS_DONE;
+}
+
+static int32_t model_spi_write_and_read(struct no_os_spi_desc *desc,
+					uint8_t *data, uint16_t bytes_number)
+{
+	uint16_t addr = no_os_get_unaligned_be16(data + 1);
+	uint16_t i;
+
+	NO_OS_UNUSED_PARAM(desc);
+
+	model_transfers++;
+	model_now_ns += bytes_number * 8 * 1000000000ull / MODEL_SCLK_HZ;
+	model_update();
+
+	for (i = 3; i < bytes_number; i++, addr++) {
+		if (data[0] == LTC2983_SPI_READ_BYTE)
+			data[i] = model_mem[addr % MODEL_MEM_SIZE];
+		else if (addr == LTC2983_STATUS_REG &&
+			 data[i] & LTC2983_STATUS_START_MASK)
+			model_start(data[i]);
+		else
+			model_mem[addr % MODEL_MEM_SIZE] = data[i];
+	}
+
+	return 0;
+}
+
+static const struct no_os_spi_platform_ops model_spi_ops = {
+	.write_and_read = model_spi_write_and_read,
+};
+
+static int32_t model_gpio_get_value(struct no_os_gpio_desc *desc,
+				    uint8_t *value)
+{
+	NO_OS_UNUSED_PARAM(desc);
+
+	model_update();
+	*value = model_busy ? NO_OS_GPIO_LOW : NO_OS_GPIO_HIGH;
+
+	return 0;
+}
+
+static int32_t model_gpio_set_value(struct no_os_gpio_desc *desc,
+				    uint8_t value)
+{
+	NO_OS_UNUSED_PARAM(desc);
+	NO_OS_UNUSED_PARAM(value);
+
+	return 0;
+}
+
+static const struct no_os_gpio_platform_ops model_gpio_ops = {
+	.gpio_ops_get_value = model_gpio_get_value,
+	.gpio_ops_set_value = model_gpio_set_value,
+};
+
+void no_os_udelay(uint32_t usecs)
+{
+	model_now_ns += usecs * 1000ull;
+}
+
+void no_os_mdelay(uint32_t msecs)
+{
+	model_now_ns += msecs * 1000000ull;
+}
+
+struct no_os_time no_os_get_time(void)
+{
+	struct no_os_time t = {
+		.s = model_now_ns / 1000000000ull,
+		.us = model_now_ns / 1000 % 1000000,
+	};
+
+	return t;
+}
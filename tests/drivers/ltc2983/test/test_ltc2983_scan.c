@@ -0,0 +1,211 @@
+/***************************************************************************//**
+ *   @file   test_ltc2983_scan.c
+ *   @brief  Unit tests and benchmark for the LTC2983 multi-channel scan.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <errno.h>
+#include "unity.h"
+#include "ltc2983.h"
+#include "no_os_delay.h"
+#include "no_os_gpio.h"
+#include "no_os_spi.h"
+#include "no_os_util.h"
+#include "ltc2983_model.c"
+
+TEST_FILE("no_os_mutex.c")
+TEST_FILE("no_os_alloc.c")
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define TCONV_MS	167
+
+static struct no_os_spibus_desc bus;
+static struct no_os_spi_desc spi = {
+	.bus = &bus,
+	.platform_ops = &model_spi_ops,
+};
+static struct no_os_gpio_desc gpio_intr = {
+	.platform_ops = &model_gpio_ops,
+};
+static struct ltc2983_sensor sensors[LTC2983_MAX_CHANNELS];
+static struct ltc2983_desc dev;
+static struct ltc2983_scan scan;
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static uint64_t time_ms(struct no_os_time t)
+{
+	return t.s * 1000ull + t.us / 1000;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	int i;
+
+	memset(&dev, 0, sizeof(dev));
+	dev.comm_desc = &spi;
+	dev.max_channels_nr = LTC2983_MAX_CHANNELS;
+	for (i = 0; i < LTC2983_MAX_CHANNELS; i++) {
+		sensors[i].chan = i + 1;
+		sensors[i].type = LTC2983_THERMOCOUPLE_K;
+		dev.sensors[i] = &sensors[i];
+	}
+	dev.num_channels = LTC2983_MAX_CHANNELS;
+	memset(&scan, 0, sizeof(scan));
+	model_reset(TCONV_MS);
+}
+
+void tearDown(void)
+{
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_ltc2983_scan_invalid(void)
+{
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ltc2983_scan(&dev, 0, &scan));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ltc2983_scan(&dev, NO_OS_BIT(20), &scan));
+
+	dev.sensors[4] = NULL;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ltc2983_scan(&dev, NO_OS_BIT(4), &scan));
+
+	sensors[1].type = LTC2983_RSENSE;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ltc2983_scan(&dev, 0x3, &scan));
+	TEST_ASSERT_EQUAL_UINT32(0, model_transfers);
+}
+
+/* The status register is polled with backoff until the scan is done. */
+void test_ltc2983_scan_poll(void)
+{
+	uint32_t mask = NO_OS_BIT(0) | NO_OS_BIT(5) | NO_OS_BIT(6);
+	uint64_t t;
+
+	TEST_ASSERT_EQUAL_INT(0, ltc2983_scan(&dev, mask, &scan));
+	TEST_ASSERT_EQUAL_UINT32(mask, scan.valid);
+	TEST_ASSERT_EQUAL_INT(model_temp(1), scan.raw[0]);
+	TEST_ASSERT_EQUAL_INT(model_temp(6), scan.raw[5]);
+	TEST_ASSERT_EQUAL_INT(model_temp(7), scan.raw[6]);
+
+	t = time_ms(scan.timestamp);
+	TEST_ASSERT_TRUE(t >= 3 * TCONV_MS);
+	TEST_ASSERT_TRUE(t <= 3 * TCONV_MS + LTC2983_POLL_MAX_MS);
+	/* mask, start, a few status reads and one result burst */
+	TEST_ASSERT_TRUE(model_transfers <= 3 + 6);
+}
+
+/* With the INTERRUPT pin, only the commands and the results use the bus. */
+void test_ltc2983_scan_intr(void)
+{
+	dev.gpio_intr = &gpio_intr;
+
+	TEST_ASSERT_EQUAL_INT(0, ltc2983_scan(&dev, 0xFFFFF, &scan));
+	TEST_ASSERT_EQUAL_UINT32(0xFFFFF, scan.valid);
+	TEST_ASSERT_EQUAL_UINT32(3, model_transfers);
+	TEST_ASSERT_TRUE(time_ms(scan.timestamp) <= 20 * TCONV_MS +
+			 LTC2983_POLL_MIN_MS);
+	TEST_ASSERT_EQUAL_INT(model_temp(20), scan.raw[19]);
+}
+
+/* A channel without a valid result does not invalidate the others. */
+void test_ltc2983_scan_bad_chan(void)
+{
+	model_bad_chan = 3;
+
+	TEST_ASSERT_EQUAL_INT(-EIO, ltc2983_scan(&dev, 0xF, &scan));
+	TEST_ASSERT_EQUAL_UINT32(0xB, scan.valid);
+	TEST_ASSERT_EQUAL_INT(model_temp(4), scan.raw[3]);
+}
+
+void test_ltc2983_scan_timeout(void)
+{
+	model_tconv_ms = 2 * LTC2983_CONV_TIMEOUT_MS;
+
+	TEST_ASSERT_EQUAL_INT(-ETIMEDOUT, ltc2983_scan(&dev, 0x1, &scan));
+}
+
+void test_ltc2983_chan_read_raw(void)
+{
+	uint32_t val;
+
+	TEST_ASSERT_EQUAL_INT(0, ltc2983_chan_read_raw(&dev, 9, &val));
+	TEST_ASSERT_EQUAL_INT(model_temp(9), (int32_t)val);
+	TEST_ASSERT_TRUE(model_now_ns < (TCONV_MS + LTC2983_POLL_MAX_MS) *
+			 1000000ull);
+}
+
+/* Time to read n channels one by one and with a single scan. */
+void test_ltc2983_scan_time(void)
+{
+	static const uint32_t counts[] = {1, 2, 5, 10, 20};
+	uint64_t single_ms, scan_ms;
+	uint32_t val, i, n, chan, single_xfers;
+
+	dev.gpio_intr = &gpio_intr;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(counts); i++) {
+		n = counts[i];
+
+		model_reset(TCONV_MS);
+		for (chan = 1; chan <= n; chan++)
+			TEST_ASSERT_EQUAL_INT(0, ltc2983_chan_read_raw(&dev, chan,
+					      &val));
+		single_ms = model_now_ns / 1000000;
+		single_xfers = model_transfers;
+
+		model_reset(TCONV_MS);
+		TEST_ASSERT_EQUAL_INT(0, ltc2983_scan(&dev, NO_OS_GENMASK(n - 1, 0),
+						      &scan));
+		scan_ms = model_now_ns / 1000000;
+
+		TEST_ASSERT_TRUE(scan_ms <= n * TCONV_MS + 2);
+		TEST_ASSERT_TRUE(scan_ms <= single_ms);
+
+		printf("ltc2983 %2u channels: fixed wait %5u ms, single %5llu ms "
+		       "%2u transfers, scan %5llu ms %u transfers\n",
+		       n, n * 300, (unsigned long long)single_ms, single_xfers,
+		       (unsigned long long)scan_ms, model_transfers);
+	}
+}
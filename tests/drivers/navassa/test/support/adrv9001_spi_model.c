@@ -0,0 +1,109 @@
+/***************************************************************************//**
+ *   @file   adrv9001_spi_model.c
+ *   @brief  Simulated ADRV9001 SPI backend with the ARM DMA port.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "adi_adrv9001_arm.h"
+#include "adi_adrv9001_spi.h"
+#include "adrv9001_reg_addr_macros.h"
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+/* Simulated window of the ARM data memory */
+#define MODEL_ARM_BASE		0x20000000u
+#define MODEL_ARM_SIZE		0x8000u
+
+/*
+ * ARM memory and software interrupt register of the ADRV9001, as seen
+ * through adi_adrv9001_arm_Memory_Write() and adi_adrv9001_spi_Byte_Write().
+ */
+static struct {
+	uint8_t sw_int;
+	uint32_t nb_xfers;
+	uint32_t nb_words;
+	bool error;
+	uint8_t mem[MODEL_ARM_SIZE];
+} model;
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static void model_reset(void)
+{
+	memset(&model, 0, sizeof(model));
+}
+
+static uint8_t *model_ptr(uint32_t addr)
+{
+	return &model.mem[addr - MODEL_ARM_BASE];
+}
+
+int32_t adi_adrv9001_arm_Memory_Write(adi_adrv9001_Device_t *device,
+				      uint32_t address, const uint8_t data[],
+				      uint32_t byteCount,
+				      adi_adrv9001_ArmSingleSpiWriteMode_e spiWriteMode)
+{
+	model.nb_xfers++;
+	if (spiWriteMode != ADI_ADRV9001_ARM_SINGLE_SPI_WRITE_MODE_STREAMING_BYTES_4 ||
+	    address % 4 || byteCount % 4 || address < MODEL_ARM_BASE ||
+	    address - MODEL_ARM_BASE + byteCount > MODEL_ARM_SIZE) {
+		model.error = true;
+		return -1;
+	}
+
+	memcpy(model_ptr(address), data, byteCount);
+	model.nb_words += byteCount / 4;
+
+	return 0;
+}
+
+int32_t adi_adrv9001_spi_Byte_Write(adi_adrv9001_Device_t *adrv9001,
+				    uint16_t addr, uint8_t data)
+{
+	if (addr != ADRV9001_ADDR_SW_INTERRUPT_4) {
+		model.error = true;
+		return -1;
+	}
+
+	model.sw_int |= data;
+
+	return 0;
+}
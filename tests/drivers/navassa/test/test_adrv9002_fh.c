@@ -0,0 +1,275 @@
+/***************************************************************************//**
+ *   @file   test_adrv9002_fh.c
+ *   @brief  Unit tests for the ADRV9002 hop table manager.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <errno.h>
+#include <string.h>
+#include "unity.h"
+#include "adrv9002_fh.h"
+#include "adi_adrv9001_rx_types.h"
+#include "no_os_util.h"
+#include "no_os_alloc.h"
+#include "mock_no_os_delay.h"
+#include "mock_adi_adrv9001_fh.h"
+#include "adrv9001_spi_model.c"
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define NB_HOPS		10
+#define TABLE_HOPS	4
+
+#define TABLE_A1	(MODEL_ARM_BASE + 0x0000)
+#define TABLE_B1	(MODEL_ARM_BASE + 0x0010)
+#define BUFFER_A1	(MODEL_ARM_BASE + 0x1000)
+#define BUFFER_B1	(MODEL_ARM_BASE + 0x4000)
+
+static adi_adrv9001_Device_t adrv9001;
+static adi_adrv9001_FhHopFrame_t frames[NB_HOPS];
+static struct adrv9002_fh_mgr *mgr;
+static uint8_t image[ADRV9002_FH_IMAGE_SIZE(TABLE_HOPS)];
+
+static void build_frames(void)
+{
+	uint64_t freq[NB_HOPS];
+	uint8_t gain[NB_HOPS];
+	struct adrv9002_fh_seq seq = {
+		.freq_hz = freq,
+		.rx_gain = gain,
+		.num_hops = NB_HOPS,
+	};
+	uint32_t i;
+
+	for (i = 0; i < NB_HOPS; i++) {
+		freq[i] = 2400000000ull + i * 1000000ull;
+		gain[i] = 200 + i;
+	}
+
+	TEST_ASSERT_EQUAL_INT(0, adrv9002_fh_seq_build(&seq, frames));
+}
+
+static void check_table(uint32_t table, uint32_t buffer, uint32_t first,
+			uint32_t nb)
+{
+	uint8_t *frame;
+	uint32_t i;
+
+	TEST_ASSERT_EQUAL_UINT32(nb, no_os_get_unaligned_le32(model_ptr(table)));
+	for (i = 0; i < nb; i++) {
+		frame = model_ptr(buffer + i * ADRV9002_FH_FRAME_BYTES);
+		TEST_ASSERT_EQUAL_UINT32((uint32_t)frames[first + i].hopFrequencyHz,
+					 no_os_get_unaligned_le32(frame));
+		TEST_ASSERT_EQUAL_UINT32(0, no_os_get_unaligned_le32(frame + 4));
+		TEST_ASSERT_EQUAL_INT(frames[first + i].rx1GainIndex, frame[16]);
+		TEST_ASSERT_EQUAL_INT(frames[first + i].rx2GainIndex, frame[17]);
+	}
+}
+
+static void init_mgr(uint32_t nb_hops)
+{
+	struct adrv9002_fh_mgr_init init = {
+		.adrv9001 = &adrv9001,
+		.hop_signal = ADI_ADRV9001_FH_HOP_SIGNAL_1,
+		.frames = frames,
+		.num_hops = nb_hops,
+		.table_hops = TABLE_HOPS,
+	};
+
+	adi_adrv9001_fh_HopTable_Set_ExpectAndReturn(&adrv9001,
+			ADI_ADRV9001_FH_HOP_SIGNAL_1,
+			ADI_ADRV9001_FHHOPTABLE_A, 0);
+	TEST_ASSERT_EQUAL_INT(0, adrv9002_fh_mgr_init(&mgr, &init));
+}
+
+static void hop(uint32_t nb)
+{
+	while (nb--)
+		TEST_ASSERT_EQUAL_INT(0, adrv9002_fh_mgr_hop(mgr));
+}
+
+static void expect_switch(adi_adrv9001_FhHopTable_e table)
+{
+	adi_adrv9001_fh_HopTable_Set_ExpectAndReturn(&adrv9001,
+			ADI_ADRV9001_FH_HOP_SIGNAL_1, table, 0);
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	struct no_os_time t = {0};
+
+	model_reset();
+	memset(&adrv9001, 0, sizeof(adrv9001));
+	adrv9001.devStateInfo.fhHopTableA1Addr = TABLE_A1;
+	adrv9001.devStateInfo.fhHopTableB1Addr = TABLE_B1;
+	adrv9001.devStateInfo.fhHopTableBufferA1Addr = BUFFER_A1;
+	adrv9001.devStateInfo.fhHopTableBufferB1Addr = BUFFER_B1;
+	mgr = NULL;
+
+	no_os_get_time_IgnoreAndReturn(t);
+	adi_adrv9001_fh_Hop_IgnoreAndReturn(0);
+	build_frames();
+}
+
+void tearDown(void)
+{
+	if (mgr)
+		adrv9002_fh_mgr_remove(mgr);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_seq_build_defaults(void)
+{
+	uint64_t freq = 900000000ull;
+	struct adrv9002_fh_seq seq = {
+		.freq_hz = &freq,
+		.num_hops = 1,
+	};
+	adi_adrv9001_FhHopFrame_t frame;
+
+	TEST_ASSERT_EQUAL_INT(0, adrv9002_fh_seq_build(&seq, &frame));
+	TEST_ASSERT_EQUAL_INT(ADI_ADRV9001_RX_GAIN_INDEX_MAX, frame.rx1GainIndex);
+	TEST_ASSERT_EQUAL_INT(ADI_ADRV9001_RX_GAIN_INDEX_MAX, frame.rx2GainIndex);
+	TEST_ASSERT_EQUAL_INT(0, frame.tx1Attenuation_fifthdB);
+	TEST_ASSERT_EQUAL_INT(0, frame.rx1OffsetFrequencyHz);
+
+	freq = ADI_ADRV9001_FH_MAX_CARRIER_FREQUENCY_HZ + 1;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, adrv9002_fh_seq_build(&seq, &frame));
+}
+
+void test_table_pack_write(void)
+{
+	uint32_t len;
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, adrv9002_fh_table_pack(frames, 0, image,
+			      &len));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, adrv9002_fh_table_pack(frames,
+			      ADRV9002_FH_TABLE_HOPS_MAX + 1, image, &len));
+
+	TEST_ASSERT_EQUAL_INT(0, adrv9002_fh_table_pack(frames, TABLE_HOPS,
+			      image, &len));
+	TEST_ASSERT_EQUAL_UINT32(ADRV9002_FH_IMAGE_SIZE(TABLE_HOPS), len);
+	TEST_ASSERT_EQUAL_INT(-EINVAL, adrv9002_fh_table_write(&adrv9001,
+			      ADI_ADRV9001_FH_HOP_SIGNAL_1,
+			      ADI_ADRV9001_FHHOPTABLE_B, image, len - 4));
+	TEST_ASSERT_EQUAL_INT(0, adrv9002_fh_table_write(&adrv9001,
+			      ADI_ADRV9001_FH_HOP_SIGNAL_1,
+			      ADI_ADRV9001_FHHOPTABLE_B, image, len));
+
+	TEST_ASSERT_FALSE(model.error);
+	/* Entry count, then the frames */
+	TEST_ASSERT_EQUAL_UINT32(2, model.nb_xfers);
+	TEST_ASSERT_EQUAL_UINT32(1 + TABLE_HOPS * ADRV9002_FH_FRAME_BYTES / 4,
+				 model.nb_words);
+	TEST_ASSERT_EQUAL_INT(0x2, model.sw_int);
+	check_table(TABLE_B1, BUFFER_B1, 0, TABLE_HOPS);
+}
+
+void test_mgr_double_buffer(void)
+{
+	init_mgr(NB_HOPS);
+	TEST_ASSERT_EQUAL_UINT32(3, mgr->num_chunks);
+	TEST_ASSERT_EQUAL_UINT32(2, mgr->stats.tables_loaded);
+	TEST_ASSERT_EQUAL_UINT32(4, model.nb_xfers);
+	check_table(TABLE_A1, BUFFER_A1, 0, TABLE_HOPS);
+	check_table(TABLE_B1, BUFFER_B1, TABLE_HOPS, TABLE_HOPS);
+
+	/* B already holds the next chunk, nothing to do */
+	TEST_ASSERT_EQUAL_INT(0, adrv9002_fh_mgr_service(mgr));
+	TEST_ASSERT_EQUAL_UINT32(4, model.nb_xfers);
+
+	hop(TABLE_HOPS);
+	expect_switch(ADI_ADRV9001_FHHOPTABLE_B);
+	hop(1);
+	TEST_ASSERT_EQUAL_UINT32(1, mgr->stats.switches);
+
+	/* The last, partial, chunk goes to table A while B plays */
+	TEST_ASSERT_EQUAL_INT(0, adrv9002_fh_mgr_service(mgr));
+	TEST_ASSERT_EQUAL_UINT32(6, model.nb_xfers);
+	check_table(TABLE_A1, BUFFER_A1, 2 * TABLE_HOPS, NB_HOPS - 2 * TABLE_HOPS);
+
+	hop(TABLE_HOPS - 1);
+	expect_switch(ADI_ADRV9001_FHHOPTABLE_A);
+	hop(NB_HOPS - 2 * TABLE_HOPS);
+
+	/* Wrap around to the start of the sequence */
+	TEST_ASSERT_EQUAL_INT(0, adrv9002_fh_mgr_service(mgr));
+	check_table(TABLE_B1, BUFFER_B1, 0, TABLE_HOPS);
+	expect_switch(ADI_ADRV9001_FHHOPTABLE_B);
+	hop(1);
+
+	TEST_ASSERT_EQUAL_UINT32(NB_HOPS + 1, mgr->stats.hops);
+	TEST_ASSERT_EQUAL_UINT32(3, mgr->stats.switches);
+	TEST_ASSERT_EQUAL_UINT32(0, mgr->stats.underruns);
+	TEST_ASSERT_EQUAL_UINT32(NB_HOPS + TABLE_HOPS, mgr->stats.frames_loaded);
+	TEST_ASSERT_FALSE(model.error);
+}
+
+void test_mgr_underrun(void)
+{
+	init_mgr(NB_HOPS);
+
+	hop(TABLE_HOPS);
+	expect_switch(ADI_ADRV9001_FHHOPTABLE_B);
+	hop(TABLE_HOPS + 1);
+
+	/* Table A was not refilled, B is played again */
+	TEST_ASSERT_EQUAL_UINT32(1, mgr->stats.switches);
+	TEST_ASSERT_EQUAL_UINT32(1, mgr->stats.underruns);
+	TEST_ASSERT_EQUAL_INT(ADI_ADRV9001_FHHOPTABLE_B, mgr->active);
+	TEST_ASSERT_EQUAL_UINT32(1, mgr->pos);
+}
+
+void test_mgr_single_table(void)
+{
+	init_mgr(TABLE_HOPS);
+	TEST_ASSERT_EQUAL_UINT32(1, mgr->num_chunks);
+	TEST_ASSERT_EQUAL_UINT32(2, model.nb_xfers);
+
+	TEST_ASSERT_EQUAL_INT(0, adrv9002_fh_mgr_service(mgr));
+	hop(3 * TABLE_HOPS);
+
+	TEST_ASSERT_EQUAL_UINT32(2, model.nb_xfers);
+	TEST_ASSERT_EQUAL_UINT32(0, mgr->stats.switches);
+	TEST_ASSERT_EQUAL_UINT32(0, mgr->stats.underruns);
+}
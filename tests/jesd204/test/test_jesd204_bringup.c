@@ -0,0 +1,373 @@
+/***************************************************************************//**
+ *   @file   test_jesd204_bringup.c
+ *   @brief  Unit tests for JESD204 bring-up on simulated AXI cores.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include "unity.h"
+#include "jesd204.h"
+#include "jesd204_clk.h"
+#include "axi_adxcvr.h"
+#include "axi_jesd204_rx.h"
+#include "axi_jesd204_tx.h"
+#include "xilinx_transceiver.h"
+#include "linux_axi_io.h"
+#include "linux_axi_sim.h"
+#include "no_os_axi_io.h"
+#include "no_os_clk.h"
+#include "no_os_delay.h"
+#include "no_os_prof.h"
+
+TEST_FILE("jesd204-core.c")
+TEST_FILE("jesd204-fsm.c")
+TEST_FILE("linux_delay.c")
+TEST_FILE("linux_thread.c")
+TEST_FILE("xilinx_transceiver.c")
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define RX_XCVR_BASE	0x44a60000
+#define TX_XCVR_BASE	0x44b60000
+#define RX_JESD_BASE	0x44a90000
+#define TX_JESD_BASE	0x44b90000
+
+#define NUM_LANES	4
+#define REF_CLK_KHZ	250000
+#define LANE_RATE_KHZ	10000000
+#define XCVR_LOCK_US	2000
+#define LINK_LOCK_US	10000
+
+#define JESD_REG_LINK_STATUS	0x280
+#define DRP_PORT_COMMON0	0x000
+#define DRP_PORT_CHANNEL0	0x100
+
+enum {
+	SIM_RX_XCVR,
+	SIM_TX_XCVR,
+	SIM_RX_JESD,
+	SIM_TX_JESD,
+	NB_SIMS
+};
+
+static struct linux_axi_sim_desc *sim[NB_SIMS];
+static struct adxcvr *rx_xcvr, *tx_xcvr;
+static struct axi_jesd204_rx *rx_jesd;
+static struct axi_jesd204_tx *tx_jesd;
+static struct jesd204_clk rx_jesd_clk, tx_jesd_clk;
+static struct no_os_clk_desc rx_lane_clk, tx_lane_clk;
+static struct jesd204_dev *top;
+static struct jesd204_topology_dev tdevs[3];
+static struct jesd204_topology *topology;
+static uint8_t lane_ids[NUM_LANES] = { 0, 1, 2, 3 };
+
+/* L = 4, M = 4, F = 2, K = 32, Np = 16 at 500 MSPS gives 10 Gbps lanes */
+static int top_link_init(struct jesd204_dev *jdev,
+			 enum jesd204_state_op_reason reason,
+			 struct jesd204_link *lnk)
+{
+	if (reason != JESD204_STATE_OP_REASON_INIT)
+		return JESD204_STATE_CHANGE_DONE;
+
+	lnk->is_transmit = lnk->link_id == 1;
+	lnk->num_lanes = NUM_LANES;
+	lnk->num_converters = 4;
+	lnk->octets_per_frame = 2;
+	lnk->frames_per_multiframe = 32;
+	lnk->bits_per_sample = 16;
+	lnk->converter_resolution = 16;
+	lnk->jesd_version = JESD204_VERSION_B;
+	lnk->jesd_encoder = JESD204_ENCODER_8B10B;
+	lnk->subclass = JESD204_SUBCLASS_1;
+	lnk->sample_rate = 500000000;
+	lnk->lane_ids = lane_ids;
+
+	return JESD204_STATE_CHANGE_DONE;
+}
+
+static const struct jesd204_dev_data top_data = {
+	.state_ops = {
+		[JESD204_OP_LINK_INIT] = { .per_link = top_link_init },
+	},
+};
+
+static void sim_init(int idx, uint32_t base, enum linux_axi_sim_core core,
+		     bool tx, uint32_t lock_us)
+{
+	struct linux_axi_sim_init_param param = {
+		.base = base,
+		.core = core,
+		.num_lanes = NUM_LANES,
+		.tx = tx,
+		.xcvr_type = XILINX_XCVR_TYPE_US_GTH4,
+		.qpll_enable = true,
+		.fpga_info = (AXI_FPGA_TECH_ULTRASCALE_PLUS << 24) |
+			     (AXI_FPGA_FAMILY_ZYNQ << 16) |
+			     (AXI_FPGA_SPEED_2 << 8) | AXI_FPGA_DEV_FF,
+		.fpga_voltage = 850,
+		.lock_us = lock_us,
+	};
+
+	TEST_ASSERT_EQUAL_INT(0, linux_axi_sim_init(&sim[idx], &param));
+}
+
+/* Same sequence as the JESD204 setup of the ad9081 project */
+static void bring_up(void)
+{
+	struct adxcvr_init rx_xcvr_init = {
+		.name = "rx_adxcvr",
+		.base = RX_XCVR_BASE,
+		.sys_clk_sel = ADXCVR_SYS_CLK_CPLL,
+		.out_clk_sel = ADXCVR_PROGDIV_CLK,
+		.lpm_enable = 1,
+		.lane_rate_khz = LANE_RATE_KHZ,
+		.ref_rate_khz = REF_CLK_KHZ,
+		.export_no_os_clk = true,
+	};
+	struct adxcvr_init tx_xcvr_init = {
+		.name = "tx_adxcvr",
+		.base = TX_XCVR_BASE,
+		.sys_clk_sel = ADXCVR_SYS_CLK_QPLL0,
+		.out_clk_sel = ADXCVR_PROGDIV_CLK,
+		.lane_rate_khz = LANE_RATE_KHZ,
+		.ref_rate_khz = REF_CLK_KHZ,
+		.export_no_os_clk = true,
+	};
+	struct jesd204_rx_init rx_jesd_init = {
+		.name = "rx_jesd",
+		.base = RX_JESD_BASE,
+		.octets_per_frame = 2,
+		.frames_per_multiframe = 32,
+		.subclass = 1,
+		.device_clk_khz = LANE_RATE_KHZ / 40,
+		.lane_clk_khz = LANE_RATE_KHZ,
+		.lane_clk = &rx_lane_clk,
+	};
+	struct jesd204_tx_init tx_jesd_init = {
+		.name = "tx_jesd",
+		.base = TX_JESD_BASE,
+		.octets_per_frame = 2,
+		.frames_per_multiframe = 32,
+		.converters_per_device = 4,
+		.converter_resolution = 16,
+		.bits_per_sample = 16,
+		.subclass = 1,
+		.device_clk_khz = LANE_RATE_KHZ / 40,
+		.lane_clk_khz = LANE_RATE_KHZ,
+		.lane_clk = &tx_lane_clk,
+	};
+
+	TEST_ASSERT_EQUAL_INT(0, adxcvr_init(&rx_xcvr, &rx_xcvr_init));
+	TEST_ASSERT_EQUAL_INT(0, adxcvr_init(&tx_xcvr, &tx_xcvr_init));
+
+	rx_jesd_clk.xcvr = rx_xcvr;
+	rx_lane_clk.platform_ops = &jesd204_clk_ops;
+	rx_lane_clk.dev_desc = &rx_jesd_clk;
+	tx_jesd_clk.xcvr = tx_xcvr;
+	tx_lane_clk.platform_ops = &jesd204_clk_ops;
+	tx_lane_clk.dev_desc = &tx_jesd_clk;
+
+	TEST_ASSERT_EQUAL_INT(0, axi_jesd204_rx_init(&rx_jesd, &rx_jesd_init));
+	TEST_ASSERT_EQUAL_INT(0, axi_jesd204_tx_init(&tx_jesd, &tx_jesd_init));
+	rx_jesd_clk.jesd_rx = rx_jesd;
+	tx_jesd_clk.jesd_tx = tx_jesd;
+
+	TEST_ASSERT_EQUAL_INT(0, jesd204_dev_register(&top, &top_data));
+
+	tdevs[0].jdev = rx_jesd->jdev;
+	tdevs[0].link_ids[0] = 0;
+	tdevs[0].links_number = 1;
+	tdevs[1].jdev = tx_jesd->jdev;
+	tdevs[1].link_ids[0] = 1;
+	tdevs[1].links_number = 1;
+	tdevs[2].jdev = top;
+	tdevs[2].link_ids[0] = 0;
+	tdevs[2].link_ids[1] = 1;
+	tdevs[2].links_number = 2;
+	tdevs[2].is_top_device = true;
+
+	TEST_ASSERT_EQUAL_INT(0, jesd204_topology_init(&topology, tdevs, 3));
+	topology->max_workers = 2;
+}
+
+/* Lane rate programmed in the transceiver, read back over DRP */
+static uint32_t xcvr_lane_rate_khz(struct adxcvr *xcvr)
+{
+	struct xilinx_xcvr *xlx = &xcvr->xlx_xcvr;
+	struct xilinx_xcvr_cpll_config cpll;
+	struct xilinx_xcvr_qpll_config qpll;
+	uint32_t out_div;
+
+	if (xcvr->tx_enable)
+		TEST_ASSERT_EQUAL_INT(0, xilinx_xcvr_read_out_div(xlx,
+				      DRP_PORT_CHANNEL0, NULL, &out_div));
+	else
+		TEST_ASSERT_EQUAL_INT(0, xilinx_xcvr_read_out_div(xlx,
+				      DRP_PORT_CHANNEL0, &out_div, NULL));
+
+	if (xcvr->cpll_enable) {
+		TEST_ASSERT_EQUAL_INT(0, xilinx_xcvr_cpll_read_config(xlx,
+				      DRP_PORT_CHANNEL0, &cpll));
+		return xilinx_xcvr_cpll_calc_lane_rate(xlx, REF_CLK_KHZ * 1000,
+						       &cpll, out_div);
+	}
+
+	TEST_ASSERT_EQUAL_INT(0, xilinx_xcvr_qpll_read_config(xlx,
+			      DRP_PORT_COMMON0, xcvr->sys_clk_sel, &qpll));
+
+	return xilinx_xcvr_qpll_calc_lane_rate(xlx, REF_CLK_KHZ * 1000, &qpll,
+					       out_div);
+}
+
+static uint32_t link_status(uint32_t base)
+{
+	uint32_t val;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_axi_io_read(base, JESD_REG_LINK_STATUS,
+			      &val));
+
+	return val & 0x3;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	sim_init(SIM_RX_XCVR, RX_XCVR_BASE, LINUX_AXI_SIM_ADXCVR, false,
+		 XCVR_LOCK_US);
+	sim_init(SIM_TX_XCVR, TX_XCVR_BASE, LINUX_AXI_SIM_ADXCVR, true,
+		 XCVR_LOCK_US);
+	sim_init(SIM_RX_JESD, RX_JESD_BASE, LINUX_AXI_SIM_JESD204_RX, false,
+		 LINK_LOCK_US);
+	sim_init(SIM_TX_JESD, TX_JESD_BASE, LINUX_AXI_SIM_JESD204_TX, true,
+		 LINK_LOCK_US);
+
+	memset(tdevs, 0, sizeof(tdevs));
+	memset(&rx_jesd_clk, 0, sizeof(rx_jesd_clk));
+	memset(&tx_jesd_clk, 0, sizeof(tx_jesd_clk));
+	topology = NULL;
+	no_os_prof_reset();
+}
+
+void tearDown(void)
+{
+	int i;
+
+	jesd204_topology_remove(topology);
+	jesd204_dev_unregister(top);
+	jesd204_dev_unregister(rx_jesd->jdev);
+	jesd204_dev_unregister(tx_jesd->jdev);
+	axi_jesd204_rx_remove(rx_jesd);
+	axi_jesd204_tx_remove(tx_jesd);
+	no_os_clk_remove(rx_xcvr->clk_out);
+	no_os_clk_remove(tx_xcvr->clk_out);
+	adxcvr_remove(rx_xcvr);
+	adxcvr_remove(tx_xcvr);
+
+	linux_axi_io_unmap_all();
+	for (i = 0; i < NB_SIMS; i++)
+		linux_axi_sim_remove(sim[i]);
+}
+
+/*******************************************************************************
+ *    UNIT TESTS
+ ******************************************************************************/
+
+/* Transceivers and link layers come up through the JESD204 FSM. */
+void test_jesd204_bringup_links(void)
+{
+	bring_up();
+
+	TEST_ASSERT_EQUAL_INT(0, jesd204_fsm_start(topology, JESD204_LINKS_ALL));
+
+	TEST_ASSERT_EQUAL_UINT32(3, link_status(RX_JESD_BASE));
+	TEST_ASSERT_EQUAL_UINT32(3, link_status(TX_JESD_BASE));
+	TEST_ASSERT_EQUAL_UINT32(NUM_LANES, rx_jesd->num_lanes);
+
+	/* The PLL and divider settings land in the DRP registers */
+	TEST_ASSERT_EQUAL_UINT32(LANE_RATE_KHZ, xcvr_lane_rate_khz(rx_xcvr));
+	TEST_ASSERT_EQUAL_UINT32(LANE_RATE_KHZ, xcvr_lane_rate_khz(tx_xcvr));
+
+	/* Link waits are at least the simulated lock time */
+	TEST_ASSERT_TRUE(topology->op_time_us[JESD204_OP_LINK_RUNNING] >=
+			 LINK_LOCK_US);
+}
+
+/* A link stuck in CGS fails the bring-up instead of hanging. */
+void test_jesd204_bringup_link_timeout(void)
+{
+	bring_up();
+	linux_axi_sim_set_fault(sim[SIM_RX_JESD], true);
+
+	TEST_ASSERT_TRUE(jesd204_fsm_start(topology, JESD204_LINKS_ALL) < 0);
+	TEST_ASSERT_EQUAL_UINT32(2, link_status(RX_JESD_BASE));
+}
+
+/* The profiler finds the delays and the register polls of the bring-up. */
+void test_jesd204_bringup_profile(void)
+{
+	struct no_os_prof_stat stats[16], stat;
+	bool link_poll = false;
+	uint32_t i, n;
+
+	bring_up();
+	TEST_ASSERT_EQUAL_INT(0, jesd204_fsm_start(topology, JESD204_LINKS_ALL));
+
+	no_os_prof_get(NO_OS_PROF_DELAY, &stat);
+	TEST_ASSERT_TRUE(stat.count > 0);
+	TEST_ASSERT_TRUE(stat.time_us >= LINK_LOCK_US);
+
+	no_os_prof_get(NO_OS_PROF_AXI, &stat);
+	TEST_ASSERT_TRUE(stat.count > 0);
+
+	n = no_os_prof_top(stats, 16);
+	TEST_ASSERT_TRUE(n > 0);
+	for (i = 0; i < n; i++) {
+		if (i)
+			TEST_ASSERT_TRUE(stats[i - 1].time_us >= stats[i].time_us);
+		if (stats[i].event == NO_OS_PROF_POLL &&
+		    stats[i].base == RX_JESD_BASE &&
+		    stats[i].offset == JESD_REG_LINK_STATUS)
+			link_poll = true;
+	}
+	TEST_ASSERT_TRUE(link_poll);
+
+	no_os_prof_report(8);
+}
@@ -0,0 +1,358 @@
+/***************************************************************************//**
+ *   @file   test_jesd204_fsm.c
+ *   @brief  Unit tests for the JESD204 FSM scheduler.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include "unity.h"
+#include "jesd204.h"
+#include "no_os_alloc.h"
+#include "no_os_delay.h"
+#include "no_os_thread.h"
+#include "no_os_util.h"
+
+TEST_FILE("jesd204-core.c")
+TEST_FILE("jesd204-fsm.c")
+TEST_FILE("linux_delay.c")
+TEST_FILE("linux_thread.c")
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define MAX_DEVS	24
+#define TOP		MAX_DEVS
+#define OP_DELAY_MS	2
+
+struct op_record {
+	uint32_t start;
+	uint32_t end;
+};
+
+static struct op_record rec[MAX_DEVS + 1][__JESD204_MAX_OPS];
+static uint32_t seq;
+static int active;
+static int max_active;
+static uint32_t nb_sysref;
+static int fail_dev = -1;
+
+static struct jesd204_dev *jdev[MAX_DEVS + 1];
+static struct jesd204_dev *inputs[MAX_DEVS];
+static struct jesd204_topology_dev tdevs[MAX_DEVS + 1];
+static struct jesd204_topology *topology;
+static unsigned int nb_devs;
+
+static int record(struct jesd204_dev *dev, enum jesd204_dev_op op)
+{
+	int idx = *(int *)jesd204_dev_priv(dev);
+	int now, prev;
+
+	rec[idx][op].start = __atomic_add_fetch(&seq, 1, __ATOMIC_SEQ_CST);
+	now = __atomic_add_fetch(&active, 1, __ATOMIC_SEQ_CST);
+	prev = __atomic_load_n(&max_active, __ATOMIC_SEQ_CST);
+	while (now > prev && !__atomic_compare_exchange_n(&max_active, &prev, now,
+			false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+		;
+	no_os_mdelay(OP_DELAY_MS);
+	__atomic_sub_fetch(&active, 1, __ATOMIC_SEQ_CST);
+	rec[idx][op].end = __atomic_add_fetch(&seq, 1, __ATOMIC_SEQ_CST);
+
+	if (idx == fail_dev && op == JESD204_OP_LINK_SETUP)
+		return -EIO;
+
+	return JESD204_STATE_CHANGE_DONE;
+}
+
+#define DEV_OP(name)							\
+static int dev_##name(struct jesd204_dev *dev,				\
+		      enum jesd204_state_op_reason reason)		\
+{									\
+	return record(dev, JESD204_OP_##name);				\
+}
+
+DEV_OP(DEVICE_INIT)
+DEV_OP(LINK_INIT)
+DEV_OP(CLK_SYNC_STAGE1)
+DEV_OP(LINK_SETUP)
+DEV_OP(CLOCKS_ENABLE)
+DEV_OP(LINK_ENABLE)
+DEV_OP(LINK_RUNNING)
+
+static int top_link_setup(struct jesd204_dev *dev,
+			  enum jesd204_state_op_reason reason,
+			  struct jesd204_link *lnk)
+{
+	return record(dev, JESD204_OP_LINK_SETUP);
+}
+
+static int sysref_cb(struct jesd204_dev *dev)
+{
+	nb_sysref++;
+
+	return 0;
+}
+
+static const struct jesd204_dev_data dev_data = {
+	.sysref_cb = sysref_cb,
+	.sizeof_priv = sizeof(int),
+	.state_ops = {
+		[JESD204_OP_DEVICE_INIT] = { .per_device = dev_DEVICE_INIT },
+		[JESD204_OP_LINK_INIT] = { .per_device = dev_LINK_INIT },
+		[JESD204_OP_CLK_SYNC_STAGE1] = { .per_device = dev_CLK_SYNC_STAGE1 },
+		[JESD204_OP_LINK_SETUP] = { .per_device = dev_LINK_SETUP },
+		[JESD204_OP_CLOCKS_ENABLE] = { .per_device = dev_CLOCKS_ENABLE },
+		[JESD204_OP_LINK_ENABLE] = { .per_device = dev_LINK_ENABLE },
+		[JESD204_OP_LINK_RUNNING] = { .per_device = dev_LINK_RUNNING },
+	},
+};
+
+static const struct jesd204_dev_data top_data = {
+	.sizeof_priv = sizeof(int),
+	.state_ops = {
+		[JESD204_OP_LINK_SETUP] = {
+			.per_link = top_link_setup,
+			.post_state_sysref = true,
+		},
+		[JESD204_OP_LINK_ENABLE] = { .per_device = dev_LINK_ENABLE },
+	},
+};
+
+/*
+ * Clock chip feeding n / 2 transceivers, each feeding one JESD204 link
+ * layer, on two links towards the top device.
+ */
+static void build_topology(unsigned int n, unsigned int max_workers)
+{
+	unsigned int i, half = (n - 1) / 2;
+
+	nb_devs = n;
+	for (i = 0; i <= n; i++) {
+		const struct jesd204_dev_data *data = i == n ? &top_data : &dev_data;
+
+		TEST_ASSERT_EQUAL_INT(0, jesd204_dev_register(&jdev[i], data));
+		*(int *)jesd204_dev_priv(jdev[i]) = i == n ? TOP : i;
+
+		tdevs[i].jdev = jdev[i];
+		tdevs[i].link_ids[0] = i % 2;
+		tdevs[i].links_number = 1;
+	}
+
+	/* Clock chip and top device are on both links */
+	tdevs[0].link_ids[1] = 1;
+	tdevs[0].links_number = 2;
+	tdevs[0].is_sysref_provider = true;
+	tdevs[n].link_ids[0] = 0;
+	tdevs[n].link_ids[1] = 1;
+	tdevs[n].links_number = 2;
+	tdevs[n].is_top_device = true;
+
+	for (i = 1; i < n; i++) {
+		inputs[i] = i <= half ? jdev[0] : jdev[i - half];
+		tdevs[i].inputs = &inputs[i];
+		tdevs[i].inputs_number = 1;
+	}
+
+	TEST_ASSERT_EQUAL_INT(0, jesd204_topology_init(&topology, tdevs, n + 1));
+	topology->max_workers = max_workers;
+}
+
+static uint32_t run_ms(void)
+{
+	struct no_os_time t0 = no_os_get_time(), t1;
+
+	TEST_ASSERT_EQUAL_INT(0, jesd204_fsm_start(topology, JESD204_LINKS_ALL));
+	t1 = no_os_get_time();
+
+	return (t1.s - t0.s) * 1000 + ((int)t1.us - (int)t0.us) / 1000;
+}
+
+static void check_all_ran(void)
+{
+	unsigned int i;
+	int op;
+
+	for (i = 0; i < nb_devs; i++)
+		for (op = 0; op < __JESD204_MAX_OPS; op++)
+			if (dev_data.state_ops[op].per_device)
+				TEST_ASSERT_TRUE(rec[i][op].end);
+
+	TEST_ASSERT_TRUE(rec[TOP][JESD204_OP_LINK_SETUP].end);
+	TEST_ASSERT_TRUE(rec[TOP][JESD204_OP_LINK_ENABLE].end);
+	TEST_ASSERT_EQUAL_UINT32(2, nb_sysref);
+}
+
+/* Ordering every scheduler must keep. */
+static void check_order(void)
+{
+	unsigned int i, k;
+	int op, prev;
+
+	for (i = 0; i < nb_devs; i++) {
+		prev = -1;
+		for (op = 0; op < __JESD204_MAX_OPS; op++) {
+			if (!rec[i][op].end)
+				continue;
+			/* A device goes through the states in order */
+			if (prev >= 0)
+				TEST_ASSERT_TRUE(rec[i][prev].end < rec[i][op].start);
+			prev = op;
+
+			/*
+			 * Inputs are done with a state before the device enters
+			 * it; the sequential order follows the links instead.
+			 */
+			for (k = 0; topology->max_workers &&
+			     k < tdevs[i].inputs_number; k++) {
+				int in = *(int *)jesd204_dev_priv(tdevs[i].inputs[k]);
+				TEST_ASSERT_TRUE(rec[in][op].end < rec[i][op].start);
+			}
+		}
+
+		/* Top device callbacks are barriers */
+		TEST_ASSERT_TRUE(rec[i][JESD204_OP_LINK_SETUP].end <
+				 rec[TOP][JESD204_OP_LINK_SETUP].start);
+		TEST_ASSERT_TRUE(rec[TOP][JESD204_OP_LINK_SETUP].end <
+				 rec[i][JESD204_OP_CLOCKS_ENABLE].start);
+		TEST_ASSERT_TRUE(rec[i][JESD204_OP_LINK_ENABLE].end <
+				 rec[TOP][JESD204_OP_LINK_ENABLE].start);
+		TEST_ASSERT_TRUE(rec[TOP][JESD204_OP_LINK_ENABLE].end <
+				 rec[i][JESD204_OP_LINK_RUNNING].start);
+	}
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	memset(rec, 0, sizeof(rec));
+	memset(tdevs, 0, sizeof(tdevs));
+	seq = 0;
+	active = 0;
+	max_active = 0;
+	nb_sysref = 0;
+	fail_dev = -1;
+	topology = NULL;
+}
+
+void tearDown(void)
+{
+	unsigned int i;
+
+	jesd204_topology_remove(topology);
+	for (i = 0; i <= nb_devs; i++)
+		jesd204_dev_unregister(jdev[i]);
+}
+
+/*******************************************************************************
+ *    UNIT TESTS
+ ******************************************************************************/
+
+/* Without workers the states run one callback at a time. */
+void test_jesd204_fsm_sequential(void)
+{
+	build_topology(9, 0);
+	run_ms();
+
+	check_all_ran();
+	check_order();
+	TEST_ASSERT_EQUAL_INT(1, max_active);
+	TEST_ASSERT_TRUE(topology->op_time_us[JESD204_OP_LINK_SETUP] >=
+			 10 * OP_DELAY_MS * 1000);
+}
+
+/* Independent devices run concurrently, dependencies and barriers hold. */
+void test_jesd204_fsm_parallel(void)
+{
+	uint32_t t_seq, t_par;
+
+	build_topology(9, 0);
+	t_seq = run_ms();
+	tearDown();
+	setUp();
+
+	build_topology(9, 4);
+	t_par = run_ms();
+
+	check_all_ran();
+	check_order();
+	TEST_ASSERT_TRUE(max_active > 1);
+	TEST_ASSERT_TRUE(max_active <= 4);
+	TEST_ASSERT_TRUE(t_par < t_seq);
+	TEST_ASSERT_TRUE(topology->op_time_us[JESD204_OP_LINK_SETUP] > 0);
+
+	printf("jesd204 fsm, 9 devices: %u ms sequential, %u ms with 4 workers\n",
+	       (unsigned int)t_seq, (unsigned int)t_par);
+}
+
+/* Topologies are no longer limited to 16 devices. */
+void test_jesd204_fsm_many_devices(void)
+{
+	build_topology(MAX_DEVS - 1, 0);
+	run_ms();
+	check_all_ran();
+	check_order();
+	tearDown();
+	setUp();
+
+	build_topology(MAX_DEVS - 1, 8);
+	run_ms();
+	check_all_ran();
+	check_order();
+}
+
+/* A failing state op stops the parallel bring-up. */
+void test_jesd204_fsm_error(void)
+{
+	build_topology(9, 4);
+	fail_dev = 3;
+
+	TEST_ASSERT_EQUAL_INT(-EIO, jesd204_fsm_start(topology,
+			      JESD204_LINKS_ALL));
+	TEST_ASSERT_FALSE(rec[TOP][JESD204_OP_LINK_SETUP].start);
+	TEST_ASSERT_FALSE(rec[3][JESD204_OP_CLOCKS_ENABLE].start);
+}
+
+void test_jesd204_fsm_dependency_loop(void)
+{
+	build_topology(9, 4);
+	inputs[1] = jdev[5];
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, jesd204_fsm_start(topology,
+			      JESD204_LINKS_ALL));
+}
@@ -0,0 +1,247 @@
+/***************************************************************************//**
+ *   @file   test_linux_axi_io.c
+ *   @brief  Unit tests for the Linux AXI IO mapping cache.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include "unity.h"
+#include "no_os_axi_io.h"
+#include "linux_axi_io.h"
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define REG_BASE	7
+#define REG_SIZE	0x10000
+#define NB_ACCESSES	200000
+#define NB_ACCESSES_OLD	20000
+#define NB_THREADS	4
+#define NB_THREAD_LOOPS	20000
+
+static int reg_fd;
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* Per access open/mmap/munmap/close, as done before the mapping cache. */
+static int32_t uncached_read(uint32_t offset, uint32_t *data)
+{
+	char buf[32];
+	void *addr;
+	int fd;
+
+	sprintf(buf, "/proc/self/fd/%d", reg_fd);
+	fd = open(buf, O_RDWR);
+	if (fd < 0)
+		return -1;
+
+	addr = mmap(NULL, offset + 4, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (addr == MAP_FAILED) {
+		close(fd);
+		return -1;
+	}
+
+	*data = *(volatile uint32_t *)((uintptr_t)addr + offset);
+
+	munmap(addr, offset + 4);
+	close(fd);
+
+	return 0;
+}
+
+/*
+ * Attach a region of its own, then alternate between it and the shared one,
+ * so the windows of the other threads keep replacing the cached one.
+ */
+static void *thread_access(void *arg)
+{
+	uint32_t idx = (uintptr_t)arg;
+	uint32_t base = REG_BASE + 1 + idx;
+	uint32_t i, val;
+	intptr_t err = 0;
+	int fd;
+
+	fd = memfd_create("axi_thread", 0);
+	if (fd < 0 || ftruncate(fd, REG_SIZE) ||
+	    linux_axi_io_attach(base, fd, REG_SIZE))
+		err = 1;
+	if (fd >= 0)
+		close(fd);
+
+	for (i = 0; i < NB_THREAD_LOOPS && !err; i++) {
+		err |= no_os_axi_io_write(base, (i * 4) & 0xfff, i);
+		err |= no_os_axi_io_write(REG_BASE, 0x1000 + idx * 4, i);
+		err |= no_os_axi_io_read(base, (i * 4) & 0xfff, &val);
+		err |= val != i;
+		err |= no_os_axi_io_read(REG_BASE, 0x1000 + idx * 4, &val);
+		err |= val != i;
+	}
+
+	return (void *)err;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	reg_fd = memfd_create("axi_regs", 0);
+	TEST_ASSERT_TRUE(reg_fd >= 0);
+	TEST_ASSERT_EQUAL_INT(0, ftruncate(reg_fd, REG_SIZE));
+	TEST_ASSERT_EQUAL_INT(0, linux_axi_io_attach(REG_BASE, reg_fd,
+			      REG_SIZE));
+}
+
+void tearDown(void)
+{
+	linux_axi_io_unmap_all();
+	close(reg_fd);
+}
+
+/*******************************************************************************
+ *    UNIT TESTS
+ ******************************************************************************/
+
+/* Single accesses go to the backing register file. */
+void test_linux_axi_io_read_write(void)
+{
+	uint32_t val;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_axi_io_write(REG_BASE, 0x40, 0xdeadbeef));
+	TEST_ASSERT_EQUAL_INT(4, pread(reg_fd, &val, 4, 0x40));
+	TEST_ASSERT_EQUAL_UINT32(0xdeadbeef, val);
+
+	val = 0x12345678;
+	TEST_ASSERT_EQUAL_INT(4, pwrite(reg_fd, &val, 4, REG_SIZE - 4));
+	val = 0;
+	TEST_ASSERT_EQUAL_INT(0, no_os_axi_io_read(REG_BASE, REG_SIZE - 4,
+			      &val));
+	TEST_ASSERT_EQUAL_UINT32(0x12345678, val);
+}
+
+/* Bulk accesses and the inline accessors see the same registers. */
+void test_linux_axi_io_bulk(void)
+{
+	volatile uint32_t *regs;
+	uint32_t in[16], out[16];
+	uint32_t i;
+
+	for (i = 0; i < 16; i++)
+		in[i] = i * 0x01010101;
+
+	TEST_ASSERT_EQUAL_INT(0, linux_axi_io_write_bulk(REG_BASE, 0x100, in,
+			      16));
+	TEST_ASSERT_EQUAL_INT(0, linux_axi_io_read_bulk(REG_BASE, 0x100, out,
+			      16));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(in, out, sizeof(in));
+
+	TEST_ASSERT_EQUAL_INT(0, linux_axi_io_map(REG_BASE, REG_SIZE, &regs));
+	TEST_ASSERT_EQUAL_UINT32(in[3], linux_axi_io_reg_read(regs, 0x10c));
+	linux_axi_io_reg_write(regs, 0x10c, 0xa5a5a5a5);
+	TEST_ASSERT_EQUAL_INT(0, no_os_axi_io_read(REG_BASE, 0x10c, &out[0]));
+	TEST_ASSERT_EQUAL_UINT32(0xa5a5a5a5, out[0]);
+}
+
+/* Accesses outside the region or unaligned are rejected. */
+void test_linux_axi_io_invalid(void)
+{
+	volatile uint32_t *regs;
+	uint32_t val;
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_axi_io_read(REG_BASE, REG_SIZE,
+			      &val));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_axi_io_write(REG_BASE, 2, 0));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, linux_axi_io_read_bulk(REG_BASE,
+			      REG_SIZE - 8, &val, 3));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, linux_axi_io_read_bulk(REG_BASE, 0,
+			      &val, 0x40000000));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, linux_axi_io_map(REG_BASE, REG_SIZE + 4,
+			      &regs));
+	TEST_ASSERT_EQUAL_INT(-EBUSY, linux_axi_io_attach(REG_BASE, reg_fd,
+			      REG_SIZE));
+}
+
+/* Threads attaching and accessing regions concurrently. */
+void test_linux_axi_io_threads(void)
+{
+	pthread_t tid[NB_THREADS];
+	void *err;
+	uintptr_t i;
+
+	for (i = 0; i < NB_THREADS; i++)
+		TEST_ASSERT_EQUAL_INT(0, pthread_create(&tid[i], NULL,
+							thread_access, (void *)i));
+
+	for (i = 0; i < NB_THREADS; i++) {
+		TEST_ASSERT_EQUAL_INT(0, pthread_join(tid[i], &err));
+		TEST_ASSERT_NULL(err);
+	}
+}
+
+/* Report register read throughput with and without the mapping cache. */
+void test_linux_axi_io_benchmark(void)
+{
+	double t0, t_old, t_new;
+	uint32_t i, val;
+
+	t0 = now();
+	for (i = 0; i < NB_ACCESSES_OLD; i++)
+		TEST_ASSERT_EQUAL_INT(0, uncached_read((i * 4) & 0xfff, &val));
+	t_old = (now() - t0) / NB_ACCESSES_OLD;
+
+	t0 = now();
+	for (i = 0; i < NB_ACCESSES; i++)
+		no_os_axi_io_read(REG_BASE, (i * 4) & 0xfff, &val);
+	t_new = (now() - t0) / NB_ACCESSES;
+
+	printf("linux_axi_io read: %.0f ns uncached, %.1f ns cached (x%.0f)\n",
+	       t_old * 1e9, t_new * 1e9, t_old / (t_new ? t_new : 1e-12));
+}
@@ -0,0 +1,484 @@
+/***************************************************************************//**
+ *   @file   test_no_os_clk.c
+ *   @brief  Unit tests of the no_os_clk clock tree.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include "unity.h"
+#include "no_os_clk.h"
+#include "no_os_alloc.h"
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define NB_CHAN		14
+#define PLL_CHAN	NB_CHAN
+
+/* Clock chip model, every register access counts as one SPI transaction */
+struct fake_dev {
+	uint64_t pll_rate;
+	uint32_t div[NB_CHAN];
+	/* Transactions of a channel recalc, 1 for AD9528, 0 for HMC7044 */
+	uint32_t read_cost;
+	/* A channel update is followed by an IO update, as on AD9528 */
+	bool io_update;
+	uint32_t xfers;
+	uint32_t batch_calls;
+	/* Error returned by the rate setters, 0 for success */
+	int set_err;
+};
+
+struct event_log {
+	uint32_t pre;
+	uint32_t post;
+	uint32_t abort;
+	uint64_t last_old_rate;
+	uint64_t last_new_rate;
+	int veto;
+};
+
+static struct fake_dev dev;
+static struct no_os_clk_desc *pll;
+static struct no_os_clk_desc *chan[NB_CHAN];
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static int fake_recalc_rate(struct no_os_clk_desc *desc, uint64_t *rate)
+{
+	struct fake_dev *d = desc->dev_desc;
+
+	if (desc->hw_ch_num == PLL_CHAN) {
+		d->xfers += 2;
+		*rate = d->pll_rate;
+		return 0;
+	}
+
+	d->xfers += d->read_cost;
+	*rate = d->pll_rate / d->div[desc->hw_ch_num];
+
+	return 0;
+}
+
+static void fake_write_div(struct fake_dev *d, uint32_t ch, uint64_t rate)
+{
+	d->div[ch] = d->pll_rate / rate;
+	/* read-modify-write of the channel register */
+	d->xfers += 2;
+}
+
+static int fake_set_rate(struct no_os_clk_desc *desc, uint64_t rate)
+{
+	struct fake_dev *d = desc->dev_desc;
+
+	if (d->set_err)
+		return d->set_err;
+
+	if (desc->hw_ch_num == PLL_CHAN) {
+		d->pll_rate = rate;
+		d->xfers += 4;
+		return 0;
+	}
+
+	fake_write_div(d, desc->hw_ch_num, rate);
+	if (d->io_update)
+		d->xfers++;
+
+	return 0;
+}
+
+static int fake_set_rates(struct no_os_clk_desc **desc, const uint64_t *rates,
+			  uint32_t nb_clks)
+{
+	struct fake_dev *d = desc[0]->dev_desc;
+	uint32_t i;
+
+	d->batch_calls++;
+	if (d->set_err)
+		return d->set_err;
+
+	for (i = 0; i < nb_clks; i++)
+		fake_write_div(d, desc[i]->hw_ch_num, rates[i]);
+	if (d->io_update)
+		d->xfers++;
+
+	return 0;
+}
+
+static const struct no_os_clk_platform_ops fake_ops = {
+	.clk_recalc_rate = fake_recalc_rate,
+	.clk_set_rate = fake_set_rate,
+};
+
+static const struct no_os_clk_platform_ops fake_batch_ops = {
+	.clk_recalc_rate = fake_recalc_rate,
+	.clk_set_rate = fake_set_rate,
+	.clk_set_rates = fake_set_rates,
+};
+
+static int log_event(struct no_os_clk_notifier *nb, enum no_os_clk_event event,
+		     struct no_os_clk_desc *desc, uint64_t old_rate,
+		     uint64_t new_rate)
+{
+	struct event_log *log = nb->priv;
+
+	log->last_old_rate = old_rate;
+	switch (event) {
+	case NO_OS_CLK_PRE_RATE_CHANGE:
+		log->pre++;
+		log->last_new_rate = new_rate;
+		return log->veto;
+	case NO_OS_CLK_POST_RATE_CHANGE:
+		log->post++;
+		log->last_new_rate = new_rate;
+		break;
+	case NO_OS_CLK_ABORT_RATE_CHANGE:
+		log->abort++;
+		break;
+	}
+
+	return 0;
+}
+
+/* PLL with NB_CHAN output dividers, as exported by HMC7044 and AD9528 */
+static void make_tree(const struct no_os_clk_platform_ops *ops, uint32_t flags)
+{
+	struct no_os_clk_init_param param = {
+		.name = "pll",
+		.hw_ch_num = PLL_CHAN,
+		.platform_ops = ops,
+		.dev_desc = &dev,
+		.flags = flags,
+	};
+	uint32_t i;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_init(&pll, &param));
+	param.parent = pll;
+	for (i = 0; i < NB_CHAN; i++) {
+		param.name = "out";
+		param.hw_ch_num = i;
+		TEST_ASSERT_EQUAL_INT(0, no_os_clk_init(&chan[i], &param));
+	}
+}
+
+static void free_tree(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < NB_CHAN; i++)
+		no_os_clk_remove(chan[i]);
+	no_os_clk_remove(pll);
+}
+
+/*
+ * JESD204 bring-up: program the device clock, the FPGA reference clocks and
+ * the SYSREFs, then let the link, transceiver and converter drivers query
+ * their clocks. Returns the number of SPI transactions.
+ */
+static uint32_t bring_up(bool batch)
+{
+	static const uint32_t outs[] = {1, 3, 4, 5, 12, 13};
+	static const uint64_t rates[] = {122880000, 122880000, 245760000,
+					 245760000, 960000, 960000
+					};
+	struct no_os_clk_desc *descs[6];
+	uint64_t rate;
+	uint32_t i, q;
+
+	dev.xfers = 0;
+	if (batch) {
+		for (i = 0; i < 6; i++)
+			descs[i] = chan[outs[i]];
+		TEST_ASSERT_EQUAL_INT(0, no_os_clk_set_rates(descs, rates, 6));
+	} else {
+		for (i = 0; i < 6; i++)
+			TEST_ASSERT_EQUAL_INT(0, no_os_clk_set_rate(chan[outs[i]],
+					      rates[i]));
+	}
+
+	/* Each consumer reads its rate at several JESD204 FSM states */
+	for (q = 0; q < 8; q++) {
+		for (i = 0; i < 6; i++) {
+			TEST_ASSERT_EQUAL_INT(0, no_os_clk_recalc_rate(chan[outs[i]],
+					      &rate));
+			TEST_ASSERT_EQUAL_INT(rates[i], rate);
+		}
+	}
+
+	return dev.xfers;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	uint32_t i;
+
+	memset(&dev, 0, sizeof(dev));
+	dev.pll_rate = 2949120000ULL;
+	for (i = 0; i < NB_CHAN; i++)
+		dev.div[i] = 12;
+}
+
+void tearDown(void)
+{
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_no_os_clk_cached_rate(void)
+{
+	uint64_t rate;
+
+	dev.read_cost = 1;
+	make_tree(&fake_ops, NO_OS_CLK_CACHE_RATE);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_recalc_rate(chan[0], &rate));
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_recalc_rate(chan[0], &rate));
+	TEST_ASSERT_EQUAL_INT(245760000, rate);
+	TEST_ASSERT_EQUAL_INT(1, dev.xfers);
+
+	/* A change behind the framework is picked up after invalidation */
+	dev.div[0] = 24;
+	no_os_clk_invalidate_rate(chan[0]);
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_recalc_rate(chan[0], &rate));
+	TEST_ASSERT_EQUAL_INT(122880000, rate);
+	TEST_ASSERT_EQUAL_INT(2, dev.xfers);
+
+	/* Setting the cached rate again is a no-op */
+	dev.xfers = 0;
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_set_rate(chan[0], 122880000));
+	TEST_ASSERT_EQUAL_INT(0, dev.xfers);
+
+	free_tree();
+}
+
+void test_no_os_clk_uncached_rate(void)
+{
+	uint64_t rate;
+
+	dev.read_cost = 1;
+	make_tree(&fake_ops, 0);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_recalc_rate(chan[0], &rate));
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_recalc_rate(chan[0], &rate));
+	TEST_ASSERT_EQUAL_INT(2, dev.xfers);
+
+	free_tree();
+}
+
+/* A parent change invalidates the children and notifies their consumers. */
+void test_no_os_clk_propagation(void)
+{
+	struct event_log log = { 0 };
+	struct no_os_clk_notifier nb = {
+		.notifier_call = log_event,
+		.priv = &log,
+	};
+	uint64_t rate;
+
+	make_tree(&fake_ops, NO_OS_CLK_CACHE_RATE);
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_recalc_rate(chan[3], &rate));
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_notifier_register(chan[3], &nb));
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_set_rate(pll, 3000000000ULL));
+	TEST_ASSERT_EQUAL_INT(1, log.pre);
+	TEST_ASSERT_EQUAL_INT(1, log.post);
+	TEST_ASSERT_EQUAL_INT(0, log.abort);
+	TEST_ASSERT_EQUAL_INT(245760000, log.last_old_rate);
+	TEST_ASSERT_EQUAL_INT(250000000, log.last_new_rate);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_recalc_rate(chan[3], &rate));
+	TEST_ASSERT_EQUAL_INT(250000000, rate);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_notifier_unregister(chan[3], &nb));
+	TEST_ASSERT_EQUAL_INT(-ENOENT, no_os_clk_notifier_unregister(chan[3], &nb));
+	free_tree();
+}
+
+/* A refusal from any consumer of the subtree leaves the hardware untouched. */
+void test_no_os_clk_notifier_veto(void)
+{
+	struct event_log log = { .veto = -EBUSY };
+	struct no_os_clk_notifier nb = {
+		.notifier_call = log_event,
+		.priv = &log,
+	};
+
+	make_tree(&fake_ops, NO_OS_CLK_CACHE_RATE);
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_notifier_register(chan[7], &nb));
+
+	TEST_ASSERT_EQUAL_INT(-EBUSY, no_os_clk_set_rate(pll, 3000000000ULL));
+	TEST_ASSERT_EQUAL_INT(2949120000ULL, dev.pll_rate);
+	TEST_ASSERT_EQUAL_INT(1, log.pre);
+	TEST_ASSERT_EQUAL_INT(0, log.post);
+	TEST_ASSERT_EQUAL_INT(1, log.abort);
+
+	free_tree();
+}
+
+/* Consumers are told to drop a change the driver failed to apply. */
+void test_no_os_clk_set_rate_error(void)
+{
+	struct event_log log = { 0 };
+	struct no_os_clk_notifier nb = {
+		.notifier_call = log_event,
+		.priv = &log,
+	};
+	struct no_os_clk_desc *descs[2];
+	uint64_t rates[2] = {122880000, 61440000};
+	uint64_t rate;
+
+	make_tree(&fake_ops, NO_OS_CLK_CACHE_RATE);
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_notifier_register(chan[3], &nb));
+
+	dev.set_err = -EIO;
+	TEST_ASSERT_EQUAL_INT(-EIO, no_os_clk_set_rate(pll, 3000000000ULL));
+	TEST_ASSERT_EQUAL_INT(1, log.pre);
+	TEST_ASSERT_EQUAL_INT(0, log.post);
+	TEST_ASSERT_EQUAL_INT(1, log.abort);
+
+	dev.set_err = 0;
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_recalc_rate(chan[3], &rate));
+	TEST_ASSERT_EQUAL_INT(245760000, rate);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_notifier_unregister(chan[3], &nb));
+	free_tree();
+
+	make_tree(&fake_batch_ops, NO_OS_CLK_CACHE_RATE);
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_notifier_register(chan[1], &nb));
+	descs[0] = chan[0];
+	descs[1] = chan[1];
+
+	memset(&log, 0, sizeof(log));
+	dev.set_err = -EIO;
+	TEST_ASSERT_EQUAL_INT(-EIO, no_os_clk_set_rates(descs, rates, 2));
+	TEST_ASSERT_EQUAL_INT(1, dev.batch_calls);
+	TEST_ASSERT_EQUAL_INT(1, log.pre);
+	TEST_ASSERT_EQUAL_INT(0, log.post);
+	TEST_ASSERT_EQUAL_INT(1, log.abort);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_notifier_unregister(chan[1], &nb));
+	free_tree();
+}
+
+/* Clocks of the same device are handed to clk_set_rates() together. */
+void test_no_os_clk_batch(void)
+{
+	struct no_os_clk_desc *descs[3];
+	uint64_t rates[3] = {122880000, 61440000, 245760000};
+
+	make_tree(&fake_batch_ops, NO_OS_CLK_CACHE_RATE);
+	descs[0] = chan[0];
+	descs[1] = chan[1];
+	descs[2] = chan[2];
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_set_rates(descs, rates, 3));
+	TEST_ASSERT_EQUAL_INT(1, dev.batch_calls);
+	TEST_ASSERT_EQUAL_INT(24, dev.div[0]);
+	TEST_ASSERT_EQUAL_INT(48, dev.div[1]);
+	TEST_ASSERT_EQUAL_INT(12, dev.div[2]);
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_clk_set_rates(NULL, rates, 3));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_clk_set_rates(descs, rates, 0));
+
+	free_tree();
+}
+
+void test_no_os_clk_remove_unlinks(void)
+{
+	make_tree(&fake_ops, 0);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_remove(chan[NB_CHAN - 1]));
+	TEST_ASSERT_TRUE(pll->child == chan[NB_CHAN - 2]);
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_remove(chan[0]));
+	TEST_ASSERT_NULL(chan[1]->sibling);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_remove(pll));
+	TEST_ASSERT_NULL(chan[1]->parent);
+
+	for (uint32_t i = 1; i < NB_CHAN - 1; i++)
+		no_os_clk_remove(chan[i]);
+}
+
+/*
+ * Compare SPI transactions of a JESD204 clock bring-up on the AD9528
+ * (adrv9009) and HMC7044 (ad9081) topologies: uncached one-by-one versus
+ * cached and batched.
+ */
+void test_no_os_clk_bring_up_transactions(void)
+{
+	uint32_t legacy, tree;
+
+	dev.read_cost = 1;
+	dev.io_update = true;
+	make_tree(&fake_ops, 0);
+	legacy = bring_up(false);
+	free_tree();
+
+	setUp();
+	dev.read_cost = 1;
+	dev.io_update = true;
+	make_tree(&fake_batch_ops, NO_OS_CLK_CACHE_RATE);
+	tree = bring_up(true);
+	free_tree();
+
+	printf("no_os_clk AD9528 bring-up: %u SPI transactions one by one, %u batched\n",
+	       legacy, tree);
+	TEST_ASSERT_TRUE(tree < legacy);
+
+	setUp();
+	make_tree(&fake_ops, 0);
+	legacy = bring_up(false);
+	free_tree();
+
+	setUp();
+	make_tree(&fake_ops, NO_OS_CLK_CACHE_RATE);
+	tree = bring_up(true);
+	free_tree();
+
+	printf("no_os_clk HMC7044 bring-up: %u SPI transactions one by one, %u batched\n",
+	       legacy, tree);
+	TEST_ASSERT_TRUE(tree <= legacy);
+}
@@ -0,0 +1,683 @@
+/***************************************************************************//**
+ *   @file   test_no_os_dac_batch.c
+ *   @brief  Unit tests and update rate of batched DAC writes.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include "unity.h"
+#include "no_os_dac_batch.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+
+TEST_FILE("no_os_spi.c")
+TEST_FILE("no_os_gpio.c")
+TEST_FILE("no_os_timer.c")
+TEST_FILE("no_os_mutex.c")
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+/*
+ * Octal 16-bit DACs on a simulated time base, 3 bytes per command: command in
+ * the top nibble, channel in the low nibble, code in the last two bytes. In
+ * a chain, the first command of a frame ends in the farthest device. Every
+ * SPI or GPIO call costs a fixed overhead, like an ioctl on a Linux host.
+ */
+#define FAKE_NB_CH		8
+#define FAKE_MAX_DEVS		2
+#define FAKE_FRAME		3
+#define FAKE_CMD_NOP		0x0
+#define FAKE_CMD_WRITE		0x1
+#define FAKE_CMD_UPDATE_ALL	0x3
+#define FAKE_SCLK_HZ		50000000
+#define FAKE_SPI_CALL_NS	10000
+#define FAKE_GPIO_CALL_NS	5000
+#define FAKE_CS_NS		50
+
+#define NB_ROWS			1000
+
+struct fake_dac {
+	uint16_t input[FAKE_NB_CH];
+	uint16_t output[FAKE_NB_CH];
+};
+
+static struct fake_dac fake[FAKE_MAX_DEVS];
+static uint8_t fake_nb_devs;
+static uint8_t fake_ldac;
+static uint64_t fake_now_ns;
+static uint64_t fake_timer_start_ns;
+static uint32_t fake_spi_calls;
+static uint32_t fake_cs_frames;
+static uint32_t fake_ldac_pulses;
+
+static struct no_os_spi_desc *spi;
+static struct no_os_gpio_desc *ldac;
+static struct no_os_timer_desc *timer;
+static struct no_os_dac_batch_desc *batch;
+static void *devs[FAKE_MAX_DEVS] = { &fake[0], &fake[1] };
+static uint32_t samples[NB_ROWS * FAKE_MAX_DEVS * FAKE_NB_CH];
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static void fake_update_all(struct fake_dac *dac)
+{
+	memcpy(dac->output, dac->input, sizeof(dac->output));
+}
+
+static void fake_cmd(struct fake_dac *dac, const uint8_t *frame)
+{
+	uint8_t ch = frame[0] & 0xF;
+
+	switch (frame[0] >> 4) {
+	case FAKE_CMD_WRITE:
+		TEST_ASSERT_TRUE(ch < FAKE_NB_CH);
+		dac->input[ch] = no_os_get_unaligned_be16((uint8_t *)&frame[1]);
+		break;
+	case FAKE_CMD_UPDATE_ALL:
+		fake_update_all(dac);
+		break;
+	default:
+		TEST_ASSERT_EQUAL_INT(FAKE_CMD_NOP, frame[0] >> 4);
+		break;
+	}
+}
+
+static int32_t fake_spi_init(struct no_os_spi_desc **desc,
+			     const struct no_os_spi_init_param *param)
+{
+	*desc = no_os_calloc(1, sizeof(**desc));
+	if (!*desc)
+		return -ENOMEM;
+
+	(*desc)->max_speed_hz = param->max_speed_hz;
+
+	return 0;
+}
+
+static int32_t fake_spi_remove(struct no_os_spi_desc *desc)
+{
+	no_os_free(desc);
+
+	return 0;
+}
+
+static void fake_spi_frame(const uint8_t *tx, uint32_t bytes)
+{
+	uint8_t d;
+
+	TEST_ASSERT_EQUAL_INT(fake_nb_devs * FAKE_FRAME, bytes);
+	for (d = 0; d < fake_nb_devs; d++)
+		fake_cmd(&fake[d], &tx[(fake_nb_devs - 1 - d) * FAKE_FRAME]);
+
+	fake_cs_frames++;
+	fake_now_ns += bytes * 8 * 1000000000ull / FAKE_SCLK_HZ + FAKE_CS_NS;
+}
+
+static int32_t fake_spi_write_and_read(struct no_os_spi_desc *desc,
+				       uint8_t *data, uint16_t bytes)
+{
+	NO_OS_UNUSED_PARAM(desc);
+
+	fake_spi_calls++;
+	fake_now_ns += FAKE_SPI_CALL_NS;
+	fake_spi_frame(data, bytes);
+
+	return 0;
+}
+
+static int32_t fake_spi_transfer(struct no_os_spi_desc *desc,
+				 struct no_os_spi_msg *msgs, uint32_t len)
+{
+	uint32_t i;
+
+	NO_OS_UNUSED_PARAM(desc);
+
+	fake_spi_calls++;
+	fake_now_ns += FAKE_SPI_CALL_NS;
+	for (i = 0; i < len; i++) {
+		TEST_ASSERT_TRUE(i == len - 1 || msgs[i].cs_change);
+		fake_spi_frame(msgs[i].tx_buff, msgs[i].bytes_number);
+	}
+
+	return 0;
+}
+
+static const struct no_os_spi_platform_ops fake_spi_ops = {
+	.init = fake_spi_init,
+	.remove = fake_spi_remove,
+	.write_and_read = fake_spi_write_and_read,
+	.transfer = fake_spi_transfer,
+};
+
+/* Platforms with no transfer op, like Xilinx PS SPI */
+static const struct no_os_spi_platform_ops fake_spi_wr_ops = {
+	.init = fake_spi_init,
+	.remove = fake_spi_remove,
+	.write_and_read = fake_spi_write_and_read,
+};
+
+static int32_t fake_gpio_get(struct no_os_gpio_desc **desc,
+			     const struct no_os_gpio_init_param *param)
+{
+	NO_OS_UNUSED_PARAM(param);
+
+	*desc = no_os_calloc(1, sizeof(**desc));
+	if (!*desc)
+		return -ENOMEM;
+
+	return 0;
+}
+
+static int32_t fake_gpio_remove(struct no_os_gpio_desc *desc)
+{
+	no_os_free(desc);
+
+	return 0;
+}
+
+static int32_t fake_gpio_set_value(struct no_os_gpio_desc *desc, uint8_t value)
+{
+	uint8_t d;
+
+	NO_OS_UNUSED_PARAM(desc);
+
+	fake_now_ns += FAKE_GPIO_CALL_NS;
+	if (!fake_ldac && value) {
+		for (d = 0; d < fake_nb_devs; d++)
+			fake_update_all(&fake[d]);
+		fake_ldac_pulses++;
+	}
+	fake_ldac = value;
+
+	return 0;
+}
+
+static int32_t fake_gpio_direction_output(struct no_os_gpio_desc *desc,
+		uint8_t value)
+{
+	NO_OS_UNUSED_PARAM(desc);
+
+	fake_ldac = value;
+
+	return 0;
+}
+
+static const struct no_os_gpio_platform_ops fake_gpio_ops = {
+	.gpio_ops_get = fake_gpio_get,
+	.gpio_ops_remove = fake_gpio_remove,
+	.gpio_ops_direction_output = fake_gpio_direction_output,
+	.gpio_ops_set_value = fake_gpio_set_value,
+};
+
+static int32_t fake_timer_init(struct no_os_timer_desc **desc,
+			       const struct no_os_timer_init_param *param)
+{
+	*desc = no_os_calloc(1, sizeof(**desc));
+	if (!*desc)
+		return -ENOMEM;
+
+	(*desc)->id = param->id;
+	(*desc)->freq_hz = param->freq_hz;
+
+	return 0;
+}
+
+static int32_t fake_timer_remove(struct no_os_timer_desc *desc)
+{
+	no_os_free(desc);
+
+	return 0;
+}
+
+static int32_t fake_timer_start(struct no_os_timer_desc *desc)
+{
+	NO_OS_UNUSED_PARAM(desc);
+
+	fake_timer_start_ns = fake_now_ns;
+
+	return 0;
+}
+
+static int32_t fake_timer_stop(struct no_os_timer_desc *desc)
+{
+	NO_OS_UNUSED_PARAM(desc);
+
+	return 0;
+}
+
+/* Every poll of the timer lets 100 ns of simulated time go by */
+static int32_t fake_timer_elapsed(struct no_os_timer_desc *desc,
+				  uint64_t *elapsed)
+{
+	NO_OS_UNUSED_PARAM(desc);
+
+	fake_now_ns += 100;
+	*elapsed = fake_now_ns - fake_timer_start_ns;
+
+	return 0;
+}
+
+static const struct no_os_timer_platform_ops fake_timer_ops = {
+	.init = fake_timer_init,
+	.remove = fake_timer_remove,
+	.start = fake_timer_start,
+	.stop = fake_timer_stop,
+	.get_elapsed_time_nsec = fake_timer_elapsed,
+};
+
+static int fake_pack_write(void *dev, uint8_t ch, uint32_t code,
+			   uint8_t *frame)
+{
+	NO_OS_UNUSED_PARAM(dev);
+
+	if (ch >= FAKE_NB_CH || code > 0xFFFF)
+		return -EINVAL;
+
+	frame[0] = (FAKE_CMD_WRITE << 4) | ch;
+	no_os_put_unaligned_be16(code, &frame[1]);
+
+	return 0;
+}
+
+static int fake_pack_update(void *dev, uint8_t *frame)
+{
+	NO_OS_UNUSED_PARAM(dev);
+
+	frame[0] = FAKE_CMD_UPDATE_ALL << 4;
+	frame[1] = 0;
+	frame[2] = 0;
+
+	return 0;
+}
+
+static const struct no_os_dac_batch_ops fake_ops = {
+	.frame_size = FAKE_FRAME,
+	.pack_write = fake_pack_write,
+};
+
+static const struct no_os_dac_batch_ops fake_sw_ops = {
+	.frame_size = FAKE_FRAME,
+	.pack_write = fake_pack_write,
+	.pack_update = fake_pack_update,
+};
+
+static void batch_init(enum no_os_dac_batch_mode mode, uint8_t nb_devs,
+		       bool use_ldac, const struct no_os_dac_batch_ops *ops)
+{
+	struct no_os_dac_batch_init_param param = {
+		.spi = spi,
+		.ldac = use_ldac ? ldac : NULL,
+		.devs = devs,
+		.nb_devs = nb_devs,
+		.mode = mode,
+		.ops = ops,
+		.max_updates = nb_devs * FAKE_NB_CH,
+	};
+
+	fake_nb_devs = nb_devs;
+	TEST_ASSERT_EQUAL_INT(0, no_os_dac_batch_init(&batch, &param));
+}
+
+/* Same updates, one SPI call per channel followed by an LDAC pulse. */
+static void per_channel_write(const struct no_os_dac_update *upd, uint32_t nb)
+{
+	uint8_t frame[FAKE_FRAME];
+	uint32_t i;
+
+	for (i = 0; i < nb; i++) {
+		fake_pack_write(NULL, upd[i].ch, upd[i].code, frame);
+		no_os_spi_write_and_read(spi, frame, FAKE_FRAME);
+	}
+	no_os_gpio_set_value(ldac, NO_OS_GPIO_LOW);
+	no_os_gpio_set_value(ldac, NO_OS_GPIO_HIGH);
+}
+
+static void fill_samples(uint32_t nb_chans)
+{
+	uint32_t i;
+
+	for (i = 0; i < NB_ROWS * nb_chans; i++)
+		samples[i] = (i * 2654435761u) >> 16;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	struct no_os_spi_init_param spi_ip = {
+		.max_speed_hz = FAKE_SCLK_HZ,
+		.platform_ops = &fake_spi_ops,
+	};
+	struct no_os_gpio_init_param gpio_ip = {
+		.platform_ops = &fake_gpio_ops,
+	};
+	struct no_os_timer_init_param timer_ip = {
+		.freq_hz = 1000000,
+		.platform_ops = &fake_timer_ops,
+	};
+
+	memset(fake, 0, sizeof(fake));
+	fake_ldac = 0;
+	fake_now_ns = 0;
+	fake_spi_calls = 0;
+	fake_cs_frames = 0;
+	fake_ldac_pulses = 0;
+	batch = NULL;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_spi_init(&spi, &spi_ip));
+	TEST_ASSERT_EQUAL_INT(0, no_os_gpio_get(&ldac, &gpio_ip));
+	TEST_ASSERT_EQUAL_INT(0, no_os_timer_init(&timer, &timer_ip));
+}
+
+void tearDown(void)
+{
+	no_os_dac_batch_remove(batch);
+	no_os_timer_remove(timer);
+	no_os_gpio_remove(ldac);
+	no_os_spi_remove(spi);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_init_invalid(void)
+{
+	struct no_os_dac_batch_init_param param = {
+		.spi = spi,
+		.devs = devs,
+		.nb_devs = 2,
+		.mode = NO_OS_DAC_BATCH_STREAM,
+		.ops = &fake_ops,
+		.max_updates = 8,
+	};
+
+	/* A stream drives a single device */
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_dac_batch_init(&batch, &param));
+
+	param.mode = NO_OS_DAC_BATCH_DAISY_CHAIN;
+	param.max_updates = 0;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_dac_batch_init(&batch, &param));
+
+	param.max_updates = 8;
+	param.ops = NULL;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_dac_batch_init(&batch, &param));
+	TEST_ASSERT_NULL(batch);
+}
+
+void test_stream_write(void)
+{
+	struct no_os_dac_update upd[FAKE_NB_CH];
+	uint32_t i;
+
+	batch_init(NO_OS_DAC_BATCH_STREAM, 1, true, &fake_ops);
+	TEST_ASSERT_EQUAL_INT(1, fake_ldac);
+
+	for (i = 0; i < FAKE_NB_CH; i++)
+		upd[i] = (struct no_os_dac_update) {
+		.ch = FAKE_NB_CH - 1 - i, .code = 0x1000 * i + 1
+	};
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_dac_batch_write(batch, upd, FAKE_NB_CH));
+
+	/* One SPI call, one CS frame per channel, one LDAC pulse */
+	TEST_ASSERT_EQUAL_INT(1, fake_spi_calls);
+	TEST_ASSERT_EQUAL_INT(FAKE_NB_CH, fake_cs_frames);
+	TEST_ASSERT_EQUAL_INT(1, fake_ldac_pulses);
+	for (i = 0; i < FAKE_NB_CH; i++)
+		TEST_ASSERT_EQUAL_INT(upd[i].code, fake[0].output[upd[i].ch]);
+}
+
+/* Without a transfer op, the frames go out one write_and_read call each. */
+void test_stream_write_no_transfer(void)
+{
+	struct no_os_dac_update upd[FAKE_NB_CH];
+	uint32_t i;
+
+	batch_init(NO_OS_DAC_BATCH_STREAM, 1, true, &fake_ops);
+	spi->platform_ops = &fake_spi_wr_ops;
+
+	for (i = 0; i < FAKE_NB_CH; i++)
+		upd[i] = (struct no_os_dac_update) {
+		.ch = i, .code = 0x1234 + i
+	};
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_dac_batch_write(batch, upd, FAKE_NB_CH));
+	TEST_ASSERT_EQUAL_INT(FAKE_NB_CH, fake_spi_calls);
+	TEST_ASSERT_EQUAL_INT(FAKE_NB_CH, fake_cs_frames);
+	TEST_ASSERT_EQUAL_INT(1, fake_ldac_pulses);
+	for (i = 0; i < FAKE_NB_CH; i++)
+		TEST_ASSERT_EQUAL_INT(0x1234 + i, fake[0].output[i]);
+}
+
+void test_stream_last_write_wins(void)
+{
+	struct no_os_dac_update upd[] = {
+		{ .ch = 2, .code = 0x1111 },
+		{ .ch = 2, .code = 0x2222 },
+	};
+
+	batch_init(NO_OS_DAC_BATCH_STREAM, 1, true, &fake_ops);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_dac_batch_write(batch, upd, 2));
+	TEST_ASSERT_EQUAL_INT(0x2222, fake[0].output[2]);
+}
+
+void test_daisy_chain_write(void)
+{
+	struct no_os_dac_update upd[] = {
+		{ .dev = 0, .ch = 0, .code = 0x0100 },
+		{ .dev = 1, .ch = 7, .code = 0x1700 },
+		{ .dev = 0, .ch = 1, .code = 0x0101 },
+		{ .dev = 0, .ch = 2, .code = 0x0102 },
+	};
+	uint32_t i;
+
+	batch_init(NO_OS_DAC_BATCH_DAISY_CHAIN, 2, true, &fake_ops);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_dac_batch_write(batch, upd,
+			      NO_OS_ARRAY_SIZE(upd)));
+
+	/* Device 1 gets no-ops once it has nothing left to write */
+	TEST_ASSERT_EQUAL_INT(1, fake_spi_calls);
+	TEST_ASSERT_EQUAL_INT(3, fake_cs_frames);
+	TEST_ASSERT_EQUAL_INT(1, fake_ldac_pulses);
+	for (i = 0; i < NO_OS_ARRAY_SIZE(upd); i++)
+		TEST_ASSERT_EQUAL_INT(upd[i].code,
+				      fake[upd[i].dev].output[upd[i].ch]);
+	TEST_ASSERT_EQUAL_INT(0, fake[1].output[0]);
+}
+
+void test_write_invalid(void)
+{
+	struct no_os_dac_update upd[FAKE_NB_CH + 1] = {
+		{ .dev = 1, .ch = 0, .code = 1 },
+	};
+
+	batch_init(NO_OS_DAC_BATCH_STREAM, 1, true, &fake_ops);
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_dac_batch_write(batch, upd, 1));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_dac_batch_write(batch, upd,
+			      FAKE_NB_CH + 1));
+
+	upd[0] = (struct no_os_dac_update) {
+		.ch = 0, .code = 0x10000
+	};
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_dac_batch_write(batch, upd, 1));
+	TEST_ASSERT_EQUAL_INT(0, fake_spi_calls);
+	TEST_ASSERT_EQUAL_INT(0, no_os_dac_batch_write(batch, upd, 0));
+}
+
+void test_software_update(void)
+{
+	struct no_os_dac_update upd[] = {
+		{ .dev = 0, .ch = 3, .code = 0x0300 },
+		{ .dev = 1, .ch = 4, .code = 0x1400 },
+	};
+
+	/* Without LDAC the update all command closes the transfer */
+	batch_init(NO_OS_DAC_BATCH_DAISY_CHAIN, 2, false, &fake_sw_ops);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_dac_batch_write(batch, upd, 2));
+	TEST_ASSERT_EQUAL_INT(1, fake_spi_calls);
+	TEST_ASSERT_EQUAL_INT(2, fake_cs_frames);
+	TEST_ASSERT_EQUAL_INT(0, fake_ldac_pulses);
+	TEST_ASSERT_EQUAL_INT(0x0300, fake[0].output[3]);
+	TEST_ASSERT_EQUAL_INT(0x1400, fake[1].output[4]);
+}
+
+void test_latch_only(void)
+{
+	struct no_os_dac_update upd = { .ch = 5, .code = 0x5555 };
+
+	batch_init(NO_OS_DAC_BATCH_STREAM, 1, false, &fake_ops);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_dac_batch_write(batch, &upd, 1));
+	TEST_ASSERT_EQUAL_INT(0x5555, fake[0].input[5]);
+	TEST_ASSERT_EQUAL_INT(0, fake[0].output[5]);
+}
+
+void test_play_paced(void)
+{
+	struct no_os_dac_update chans[FAKE_NB_CH];
+	uint32_t rate = 20000, i;
+	uint64_t expected_ns;
+
+	batch_init(NO_OS_DAC_BATCH_STREAM, 1, true, &fake_ops);
+	fill_samples(FAKE_NB_CH);
+	for (i = 0; i < FAKE_NB_CH; i++)
+		chans[i] = (struct no_os_dac_update) {
+		.ch = i
+	};
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_dac_batch_play(batch, chans, FAKE_NB_CH,
+			      samples, NB_ROWS, timer, rate));
+
+	TEST_ASSERT_EQUAL_INT(0, batch->nb_late);
+	TEST_ASSERT_EQUAL_INT(NB_ROWS, fake_ldac_pulses);
+	for (i = 0; i < FAKE_NB_CH; i++)
+		TEST_ASSERT_EQUAL_INT(samples[(NB_ROWS - 1) * FAKE_NB_CH + i],
+				      fake[0].output[i]);
+
+	/* The last row starts on its slot, not earlier */
+	expected_ns = (uint64_t)(NB_ROWS - 1) * 1000000000 / rate;
+	TEST_ASSERT_TRUE(fake_now_ns >= expected_ns);
+	TEST_ASSERT_TRUE(fake_now_ns < expected_ns + 1000000000 / rate);
+}
+
+void test_play_too_fast(void)
+{
+	struct no_os_dac_update chans[FAKE_NB_CH];
+	uint32_t i;
+
+	batch_init(NO_OS_DAC_BATCH_STREAM, 1, true, &fake_ops);
+	fill_samples(FAKE_NB_CH);
+	for (i = 0; i < FAKE_NB_CH; i++)
+		chans[i] = (struct no_os_dac_update) {
+		.ch = i
+	};
+
+	/* A row takes longer than 10 us on the bus, the rows fall behind */
+	TEST_ASSERT_EQUAL_INT(0, no_os_dac_batch_play(batch, chans, FAKE_NB_CH,
+			      samples, NB_ROWS, timer, 100000));
+	TEST_ASSERT_TRUE(batch->nb_late > NB_ROWS / 2);
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_dac_batch_play(batch, chans,
+			      FAKE_NB_CH, samples, NB_ROWS, timer, 0));
+}
+
+void test_update_rate(void)
+{
+	static const uint8_t nb_devs[] = { 1, 2 };
+	struct no_os_dac_update chans[FAKE_MAX_DEVS * FAKE_NB_CH];
+	struct no_os_dac_update row[FAKE_MAX_DEVS * FAKE_NB_CH];
+	uint32_t nb_chans, r, i, k;
+	double per_ch, batched;
+
+	printf("\n devs chans  per channel rows/s  batched rows/s  speedup\n");
+	for (k = 0; k < NO_OS_ARRAY_SIZE(nb_devs); k++) {
+		batch_init(nb_devs[k] > 1 ? NO_OS_DAC_BATCH_DAISY_CHAIN :
+			   NO_OS_DAC_BATCH_STREAM, nb_devs[k], true, &fake_ops);
+		nb_chans = nb_devs[k] * FAKE_NB_CH;
+		fill_samples(nb_chans);
+		for (i = 0; i < nb_chans; i++)
+			chans[i] = (struct no_os_dac_update) {
+			.dev = i / FAKE_NB_CH, .ch = i % FAKE_NB_CH
+		};
+
+		/* Per channel writes only work on a single device */
+		per_ch = 0;
+		if (nb_devs[k] == 1) {
+			fake_now_ns = 0;
+			for (r = 0; r < NB_ROWS; r++) {
+				for (i = 0; i < nb_chans; i++) {
+					row[i] = chans[i];
+					row[i].code = samples[r * nb_chans + i];
+				}
+				per_channel_write(row, nb_chans);
+			}
+			per_ch = NB_ROWS * 1e9 / fake_now_ns;
+		}
+
+		fake_now_ns = 0;
+		TEST_ASSERT_EQUAL_INT(0, no_os_dac_batch_play(batch, chans,
+				      nb_chans, samples, NB_ROWS, NULL, 0));
+		batched = NB_ROWS * 1e9 / fake_now_ns;
+
+		for (i = 0; i < nb_chans; i++)
+			TEST_ASSERT_EQUAL_INT(samples[(NB_ROWS - 1) * nb_chans + i],
+					      fake[i / FAKE_NB_CH].output[i % FAKE_NB_CH]);
+
+		if (per_ch)
+			printf(" %4u %5u  %18.0f  %14.0f  %6.1fx\n", nb_devs[k],
+			       nb_chans, per_ch, batched, batched / per_ch);
+		else
+			printf(" %4u %5u  %18s  %14.0f\n", nb_devs[k], nb_chans,
+			       "-", batched);
+
+		if (per_ch)
+			TEST_ASSERT_TRUE(batched > 3 * per_ch);
+
+		no_os_dac_batch_remove(batch);
+		batch = NULL;
+	}
+}
@@ -0,0 +1,322 @@
+/***************************************************************************//**
+ *   @file   test_no_os_dds.c
+ *   @brief  Unit tests, SFDR and throughput of the DDS generator.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <errno.h>
+#include "unity.h"
+#include "no_os_dds.h"
+#include "no_os_alloc.h"
+
+TEST_FILE("no_os_sin_lut.c")
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define SAMPLE_RATE	4096000
+#define NB_SAMPLES	4096
+#define BENCH_SAMPLES	(1 << 24)
+#define MIN_SFDR_DBC	85.0
+
+static struct no_os_dds_desc *dds;
+static uint16_t buff[3 * NB_SAMPLES];
+static double mag[NB_SAMPLES / 2];
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static int32_t to_signed(uint16_t sample)
+{
+	return (int32_t)sample - 0x8000;
+}
+
+/* Magnitude spectrum of NB_SAMPLES offset binary samples, no window. */
+static void spectrum(const uint16_t *x, uint32_t stride)
+{
+	static double c[NB_SAMPLES], s[NB_SAMPLES];
+	double re, im;
+	uint32_t k, n;
+
+	for (n = 0; n < NB_SAMPLES; n++) {
+		c[n] = cos(2 * M_PI * n / NB_SAMPLES);
+		s[n] = sin(2 * M_PI * n / NB_SAMPLES);
+	}
+
+	for (k = 0; k < NB_SAMPLES / 2; k++) {
+		re = 0;
+		im = 0;
+		for (n = 0; n < NB_SAMPLES; n++) {
+			re += to_signed(x[n * stride]) * c[(k * n) % NB_SAMPLES];
+			im -= to_signed(x[n * stride]) * s[(k * n) % NB_SAMPLES];
+		}
+		mag[k] = sqrt(re * re + im * im);
+	}
+}
+
+/* Ratio between the carrier and the largest spur, DC excluded. */
+static double sfdr_dbc(uint32_t carrier)
+{
+	double spur = 1e-9;
+	uint32_t k;
+
+	for (k = 1; k < NB_SAMPLES / 2; k++)
+		if (k != carrier && mag[k] > spur)
+			spur = mag[k];
+
+	return 20 * log10(mag[carrier] / spur);
+}
+
+static double now(void)
+{
+	return (double)clock() / CLOCKS_PER_SEC;
+}
+
+static void init_dds(enum no_os_dds_format format)
+{
+	struct no_os_dds_init_param param = {
+		.sample_rate = SAMPLE_RATE,
+		.format = format,
+	};
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_dds_init(&dds, &param));
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	dds = NULL;
+	memset(buff, 0, sizeof(buff));
+}
+
+void tearDown(void)
+{
+	if (dds)
+		no_os_dds_remove(dds);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_no_os_dds_invalid(void)
+{
+	struct no_os_dds_init_param param = { .sample_rate = 0 };
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_dds_init(NULL, &param));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_dds_init(&dds, NULL));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_dds_init(&dds, &param));
+
+	init_dds(NO_OS_DDS_OFFSET_BINARY);
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_dds_set_tone(dds, NO_OS_DDS_MAX_TONES,
+			      1000, NO_OS_DDS_FULL_SCALE, 0));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_dds_set_tone(dds, 0, SAMPLE_RATE,
+			      NO_OS_DDS_FULL_SCALE, 0));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_dds_set_tone(dds, 0, 1000, 0x8000, 0));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_dds_set_chirp(dds, 0, 1000, 1000,
+			      100, NO_OS_DDS_FULL_SCALE));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_dds_set_chirp(dds, 0, 1000, 2000,
+			      0, NO_OS_DDS_FULL_SCALE));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_dds_fill(dds, buff, 16, 0));
+}
+
+/* Every block length and alignment must stay within 2 LSB of the ideal sine. */
+void test_no_os_dds_accuracy(void)
+{
+	static const uint32_t freqs[] = {1000, 127000, 1234567, 2047999};
+	uint32_t i, n, len, done;
+	uint32_t phase;
+	double turns, ideal, err, max_err = 0;
+
+	init_dds(NO_OS_DDS_TWOS_COMPLEMENT);
+	for (i = 0; i < sizeof(freqs) / sizeof(freqs[0]); i++) {
+		phase = NO_OS_DDS_PHASE_DEG(30 * i);
+		TEST_ASSERT_EQUAL_INT(0, no_os_dds_set_tone(dds, 0, freqs[i],
+				      NO_OS_DDS_FULL_SCALE, phase));
+
+		/* Odd chunk lengths exercise the vector tails */
+		for (done = 0, len = 1; done < NB_SAMPLES; done += len, len += 2) {
+			if (len > NB_SAMPLES - done)
+				len = NB_SAMPLES - done;
+			no_os_dds_fill(dds, buff + done, len, 1);
+		}
+
+		for (n = 0; n < NB_SAMPLES; n++) {
+			turns = (phase + (double)dds->tone[0].ftw * n) / 4294967296.0;
+			/* no_os_sine_lut_16 is centered on -0.5 LSB */
+			ideal = (32767.5 * sin(2 * M_PI * turns) - 0.5) *
+				NO_OS_DDS_FULL_SCALE / 32768;
+			err = fabs((int16_t)buff[n] - ideal);
+			if (err > max_err)
+				max_err = err;
+		}
+	}
+
+	printf("no_os_dds max error vs ideal sine: %.2f LSB\n", max_err);
+	TEST_ASSERT_TRUE(max_err <= 2.0);
+}
+
+/* Interleaved output must match the contiguous output sample for sample. */
+void test_no_os_dds_stride(void)
+{
+	struct no_os_dds_desc *ref;
+	struct no_os_dds_init_param param = {
+		.sample_rate = SAMPLE_RATE,
+		.format = NO_OS_DDS_OFFSET_BINARY,
+	};
+	uint32_t n;
+
+	init_dds(NO_OS_DDS_OFFSET_BINARY);
+	TEST_ASSERT_EQUAL_INT(0, no_os_dds_init(&ref, &param));
+	TEST_ASSERT_EQUAL_INT(0, no_os_dds_set_tone(dds, 0, 300000, 20000, 0));
+	TEST_ASSERT_EQUAL_INT(0, no_os_dds_set_tone(dds, 1, 700000, 12000, 0));
+	*ref = *dds;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_dds_fill(ref, buff, NB_SAMPLES, 1));
+	TEST_ASSERT_EQUAL_INT(0, no_os_dds_fill(dds, buff + NB_SAMPLES + 1,
+						NB_SAMPLES / 2, 2));
+	for (n = 0; n < NB_SAMPLES / 2; n++)
+		TEST_ASSERT_EQUAL_UINT32(buff[n], buff[NB_SAMPLES + 1 + 2 * n]);
+
+	no_os_dds_remove(ref);
+}
+
+/* Single full scale tone, coherent with the record length. */
+void test_no_os_dds_sfdr(void)
+{
+	static const uint32_t bins[] = {1, 127, 1021, 2039};
+	double sfdr;
+	uint32_t i;
+
+	init_dds(NO_OS_DDS_OFFSET_BINARY);
+	for (i = 0; i < sizeof(bins) / sizeof(bins[0]); i++) {
+		TEST_ASSERT_EQUAL_INT(0, no_os_dds_set_tone(dds, 0,
+				      bins[i] * (SAMPLE_RATE / NB_SAMPLES),
+				      NO_OS_DDS_FULL_SCALE, 0));
+		TEST_ASSERT_EQUAL_INT(0, no_os_dds_fill(dds, buff, NB_SAMPLES, 1));
+		spectrum(buff, 1);
+		sfdr = sfdr_dbc(bins[i]);
+		printf("no_os_dds SFDR at bin %4u: %.1f dBc\n", bins[i], sfdr);
+		TEST_ASSERT_TRUE(sfdr >= MIN_SFDR_DBC);
+	}
+}
+
+/* Two tones at -6 dBFS each, written to one channel of an interleaved buffer. */
+void test_no_os_dds_two_tone(void)
+{
+	double spur = 0, carrier;
+	uint32_t k;
+
+	init_dds(NO_OS_DDS_OFFSET_BINARY);
+	TEST_ASSERT_EQUAL_INT(0, no_os_dds_set_tone(dds, 0, 301 * 1000,
+			      NO_OS_DDS_FULL_SCALE / 2, 0));
+	TEST_ASSERT_EQUAL_INT(0, no_os_dds_set_tone(dds, 1, 331 * 1000,
+			      NO_OS_DDS_FULL_SCALE / 2, NO_OS_DDS_PHASE_DEG(90)));
+	TEST_ASSERT_EQUAL_INT(0, no_os_dds_fill(dds, buff + 1, NB_SAMPLES, 3));
+	spectrum(buff + 1, 3);
+
+	carrier = mag[301] < mag[331] ? mag[301] : mag[331];
+	for (k = 1; k < NB_SAMPLES / 2; k++)
+		if (k != 301 && k != 331 && mag[k] > spur)
+			spur = mag[k];
+
+	printf("no_os_dds two tone SFDR: %.1f dBc\n", 20 * log10(carrier / spur));
+	TEST_ASSERT_TRUE(20 * log10(carrier / spur) >= MIN_SFDR_DBC - 6);
+	TEST_ASSERT_TRUE(fabs(20 * log10(mag[301] / mag[331])) < 0.1);
+}
+
+/* Zero crossings over one sweep must match the mean frequency. */
+void test_no_os_dds_chirp(void)
+{
+	uint32_t n, crossings = 0;
+	double expected;
+
+	init_dds(NO_OS_DDS_TWOS_COMPLEMENT);
+	TEST_ASSERT_EQUAL_INT(0, no_os_dds_set_chirp(dds, 0, 100000, 900000,
+			      NB_SAMPLES, NO_OS_DDS_FULL_SCALE));
+	TEST_ASSERT_EQUAL_INT(0, no_os_dds_fill(dds, buff, NB_SAMPLES, 1));
+	for (n = 1; n < NB_SAMPLES; n++)
+		if (((int16_t)buff[n - 1] < 0) != ((int16_t)buff[n] < 0))
+			crossings++;
+
+	expected = 2.0 * 500000 * NB_SAMPLES / SAMPLE_RATE;
+	TEST_ASSERT_TRUE(fabs(crossings - expected) <= 2);
+
+	/* The sweep starts over after NB_SAMPLES */
+	TEST_ASSERT_EQUAL_UINT32(dds->tone[0].ftw_start, dds->tone[0].ftw);
+
+	/* Downwards */
+	TEST_ASSERT_EQUAL_INT(0, no_os_dds_set_chirp(dds, 0, 900000, 100000,
+			      NB_SAMPLES, NO_OS_DDS_FULL_SCALE));
+	TEST_ASSERT_EQUAL_INT(0, no_os_dds_fill(dds, buff, NB_SAMPLES, 1));
+	TEST_ASSERT_EQUAL_UINT32(dds->tone[0].ftw_start, dds->tone[0].ftw);
+}
+
+/* Report generated samples per second. */
+void test_no_os_dds_benchmark(void)
+{
+	static const char * const name[] = {"1 tone", "4 tones", "chirp"};
+	double t0, t;
+	uint32_t i, k, done;
+
+	init_dds(NO_OS_DDS_OFFSET_BINARY);
+	for (i = 0; i < 3; i++) {
+		memset(dds->tone, 0, sizeof(dds->tone));
+		if (i == 2)
+			no_os_dds_set_chirp(dds, 0, 10000, 1000000, 100000,
+					    NO_OS_DDS_FULL_SCALE);
+		for (k = 0; k < (i == 1 ? NO_OS_DDS_MAX_TONES : 1) && i != 2; k++)
+			no_os_dds_set_tone(dds, k, 100000 * (k + 1),
+					   NO_OS_DDS_FULL_SCALE / 4, 0);
+
+		t0 = now();
+		for (done = 0; done < BENCH_SAMPLES; done += NB_SAMPLES)
+			no_os_dds_fill(dds, buff, NB_SAMPLES, 1);
+		t = now() - t0;
+
+		printf("no_os_dds %-7s: %.1f M samples/s\n", name[i],
+		       BENCH_SAMPLES / (t ? t : 1e-9) / 1e6);
+	}
+}
@@ -0,0 +1,174 @@
+/***************************************************************************//**
+ *   @file   test_no_os_fifo.c
+ *   @brief  Unit tests for the ring-backed no_os_fifo.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <string.h>
+#include <errno.h>
+#include "unity.h"
+#include "no_os_fifo.h"
+#include "mock_no_os_alloc.h"
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define FIFO_SIZE	64
+
+static struct no_os_fifo fifo;
+static uint8_t fifo_buff[FIFO_SIZE];
+static uint8_t data_in[3 * FIFO_SIZE];
+static uint8_t data_out[3 * FIFO_SIZE];
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < sizeof(data_in); i++)
+		data_in[i] = i;
+	memset(data_out, 0, sizeof(data_out));
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_fifo_ring_cfg(&fifo, fifo_buff, FIFO_SIZE));
+}
+
+void tearDown(void)
+{
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_no_os_fifo_ring_cfg_invalid(void)
+{
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_fifo_ring_cfg(NULL, fifo_buff,
+			      FIFO_SIZE));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_fifo_ring_cfg(&fifo, NULL, FIFO_SIZE));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_fifo_ring_cfg(&fifo, fifo_buff, 0));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_fifo_ring_cfg(&fifo, fifo_buff, 48));
+}
+
+/*
+ * No allocator expectations are set, so any no_os_calloc/no_os_malloc/no_os_free
+ * call made while moving data through the fifo fails the test.
+ */
+void test_no_os_fifo_ring_byte_per_byte_no_alloc(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < 3 * FIFO_SIZE; i++) {
+		TEST_ASSERT_EQUAL_UINT32(1, no_os_fifo_ring_write(&fifo, &data_in[i], 1));
+		TEST_ASSERT_EQUAL_UINT32(1, no_os_fifo_ring_read(&fifo, &data_out[i], 1));
+	}
+
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(data_in, data_out, 3 * FIFO_SIZE);
+	TEST_ASSERT_EQUAL_UINT32(0, fifo.overflows);
+}
+
+void test_no_os_fifo_ring_wrap_bulk_drain(void)
+{
+	TEST_ASSERT_EQUAL_UINT32(40, no_os_fifo_ring_write(&fifo, data_in, 40));
+	TEST_ASSERT_EQUAL_UINT32(30, no_os_fifo_ring_read(&fifo, data_out, 30));
+	/* Crosses the end of the storage. */
+	TEST_ASSERT_EQUAL_UINT32(50, no_os_fifo_ring_write(&fifo, &data_in[40], 50));
+	TEST_ASSERT_EQUAL_UINT32(60, no_os_fifo_ring_level(&fifo));
+	TEST_ASSERT_EQUAL_UINT32(60, no_os_fifo_ring_read(&fifo, &data_out[30],
+				 sizeof(data_out) - 30));
+
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(data_in, data_out, 90);
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_fifo_ring_level(&fifo));
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_fifo_ring_read(&fifo, data_out, 1));
+}
+
+void test_no_os_fifo_ring_overflow_counters(void)
+{
+	TEST_ASSERT_EQUAL_UINT32(FIFO_SIZE, no_os_fifo_ring_write(&fifo, data_in,
+				 FIFO_SIZE + 10));
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_fifo_ring_write(&fifo, data_in, 5));
+	TEST_ASSERT_EQUAL_UINT32(2, fifo.overflows);
+	TEST_ASSERT_EQUAL_UINT32(15, fifo.dropped);
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_fifo_ring_space(&fifo));
+
+	/* Data already in the fifo is never overwritten. */
+	TEST_ASSERT_EQUAL_UINT32(FIFO_SIZE, no_os_fifo_ring_read(&fifo, data_out,
+				 sizeof(data_out)));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(data_in, data_out, FIFO_SIZE);
+
+	no_os_fifo_ring_write(&fifo, data_in, 8);
+	no_os_fifo_ring_flush(&fifo);
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_fifo_ring_level(&fifo));
+	TEST_ASSERT_EQUAL_UINT32(2, fifo.overflows);
+}
+
+void test_no_os_fifo_ring_init_allocates_once(void)
+{
+	static struct no_os_fifo fifo_alloc;
+	static uint8_t buff_alloc[FIFO_SIZE];
+	struct no_os_fifo *f;
+	uint32_t i;
+
+	no_os_calloc_ExpectAndReturn(1, sizeof(struct no_os_fifo), &fifo_alloc);
+	no_os_calloc_ExpectAndReturn(1, FIFO_SIZE, buff_alloc);
+	TEST_ASSERT_EQUAL_INT(0, no_os_fifo_ring_init(&f, FIFO_SIZE));
+
+	/* Steady state traffic must not touch the heap. */
+	for (i = 0; i < 3 * FIFO_SIZE; i += 16) {
+		no_os_fifo_ring_write(f, &data_in[i], 16);
+		no_os_fifo_ring_read(f, &data_out[i], 16);
+	}
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(data_in, data_out, 3 * FIFO_SIZE);
+
+	no_os_free_Expect(buff_alloc);
+	no_os_free_Expect(&fifo_alloc);
+	TEST_ASSERT_EQUAL_INT(0, no_os_fifo_ring_remove(f));
+}
+
+void test_no_os_fifo_ring_init_enomem(void)
+{
+	static struct no_os_fifo fifo_alloc;
+	struct no_os_fifo *f;
+
+	no_os_calloc_ExpectAndReturn(1, sizeof(struct no_os_fifo), NULL);
+	TEST_ASSERT_EQUAL_INT(-ENOMEM, no_os_fifo_ring_init(&f, FIFO_SIZE));
+
+	no_os_calloc_ExpectAndReturn(1, sizeof(struct no_os_fifo), &fifo_alloc);
+	no_os_calloc_ExpectAndReturn(1, FIFO_SIZE, NULL);
+	no_os_free_Expect(&fifo_alloc);
+	TEST_ASSERT_EQUAL_INT(-ENOMEM, no_os_fifo_ring_init(&f, FIFO_SIZE));
+}
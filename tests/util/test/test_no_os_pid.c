@@ -0,0 +1,246 @@
+/***************************************************************************//**
+ *   @file   test_no_os_pid.c
+ *   @brief  Unit tests and benchmark for the no_os_pid bank.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <errno.h>
+#include "unity.h"
+#include "no_os_pid.h"
+#include "no_os_alloc.h"
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define MAX_PIDS	64
+#define NB_STEPS	2000
+#define BENCH_STEPS	200000
+
+static struct no_os_pid_config cfg[MAX_PIDS];
+static struct no_os_pid *pid[MAX_PIDS];
+static int sp[MAX_PIDS];
+static int pv[MAX_PIDS];
+static int pv_step[MAX_PIDS];
+static int out_ref[MAX_PIDS];
+static int out_bank[MAX_PIDS];
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static int rand_range(int lo, int hi)
+{
+	return lo + rand() % (hi - lo + 1);
+}
+
+static void make_configs(unsigned int n)
+{
+	unsigned int k;
+
+	for (k = 0; k < n; k++) {
+		cfg[k].Kp = rand_range(0, 2000000);
+		cfg[k].Ki = rand_range(0, 200000);
+		cfg[k].Kd = rand_range(0, 500000);
+		cfg[k].hysteresis = rand_range(0, 8);
+		/* mix of enabled and disabled clipping */
+		cfg[k].i_clip.low = (k & 1) ? -5000 : 0;
+		cfg[k].i_clip.high = (k & 1) ? 5000 : 0;
+		cfg[k].output_clip.low = 0;
+		cfg[k].output_clip.high = (k & 2) ? 4095 : 0;
+		cfg[k].initial = rand_range(0, 4095);
+	}
+}
+
+static double now(void)
+{
+	return (double)clock() / CLOCKS_PER_SEC;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	srand(1);
+}
+
+void tearDown(void)
+{
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_no_os_pid_bank_init_invalid(void)
+{
+	struct no_os_pid_bank *bank;
+
+	make_configs(2);
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_pid_bank_init(NULL, cfg, 2));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_pid_bank_init(&bank, NULL, 2));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_pid_bank_init(&bank, cfg, 0));
+
+	cfg[1].output_clip.high = -1;
+	cfg[1].output_clip.low = 1;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_pid_bank_init(&bank, cfg, 2));
+}
+
+/* Every bank size from 1 to 64 must match no_os_pid_control() bit for bit. */
+void test_no_os_pid_bank_bit_exact(void)
+{
+	struct no_os_pid_bank *bank;
+	unsigned int n, k, s;
+
+	for (n = 1; n <= MAX_PIDS; n++) {
+		make_configs(n);
+		for (k = 0; k < n; k++) {
+			TEST_ASSERT_EQUAL_INT(0, no_os_pid_init(&pid[k], cfg[k]));
+			pv[k] = cfg[k].initial;
+		}
+		TEST_ASSERT_EQUAL_INT(0, no_os_pid_bank_init(&bank, cfg, n));
+
+		for (s = 0; s < NB_STEPS; s++) {
+			if (s == NB_STEPS / 2) {
+				no_os_pid_bank_reset(bank);
+				for (k = 0; k < n; k++)
+					no_os_pid_reset(pid[k]);
+			}
+			for (k = 0; k < n; k++) {
+				sp[k] = (s % 500 < 250) ? 3000 : 1000;
+				TEST_ASSERT_EQUAL_INT(0, no_os_pid_control(pid[k], sp[k], pv[k],
+						      &out_ref[k]));
+			}
+			TEST_ASSERT_EQUAL_INT(0, no_os_pid_bank_control(bank, sp, pv, out_bank));
+			TEST_ASSERT_EQUAL_INT_ARRAY(out_ref, out_bank, n);
+
+			/* crude first order plant with noise */
+			for (k = 0; k < n; k++)
+				pv[k] += (out_ref[k] - pv[k]) / 4 + rand_range(-3, 3);
+		}
+
+		for (k = 0; k < n; k++)
+			no_os_pid_remove(pid[k]);
+		no_os_pid_bank_remove(bank);
+	}
+}
+
+/*
+ * Controllers held by the hysteresis keep an initial output that is outside
+ * of the output clip range, as no_os_pid_control() does.
+ */
+void test_no_os_pid_bank_held_unclipped(void)
+{
+	struct no_os_pid_bank *bank;
+	unsigned int n, k, s;
+
+	for (n = 1; n <= 9; n++) {
+		make_configs(n);
+		for (k = 0; k < n; k++) {
+			cfg[k].hysteresis = 4;
+			cfg[k].output_clip.low = 0;
+			cfg[k].output_clip.high = 4095;
+			cfg[k].initial = (k & 1) ? -1000 : 5000;
+			TEST_ASSERT_EQUAL_INT(0, no_os_pid_init(&pid[k], cfg[k]));
+		}
+		TEST_ASSERT_EQUAL_INT(0, no_os_pid_bank_init(&bank, cfg, n));
+
+		for (s = 0; s < 4; s++) {
+			/* held for two steps, then a large error on odd ones */
+			for (k = 0; k < n; k++) {
+				sp[k] = 2000;
+				pv[k] = (s < 2 || !(k & 1)) ? 2000 : 100;
+				TEST_ASSERT_EQUAL_INT(0, no_os_pid_control(pid[k], sp[k], pv[k],
+						      &out_ref[k]));
+			}
+			TEST_ASSERT_EQUAL_INT(0, no_os_pid_bank_control(bank, sp, pv, out_bank));
+			TEST_ASSERT_EQUAL_INT_ARRAY(out_ref, out_bank, n);
+		}
+		TEST_ASSERT_EQUAL_INT(5000, out_bank[0]);
+
+		for (k = 0; k < n; k++)
+			no_os_pid_remove(pid[k]);
+		no_os_pid_bank_remove(bank);
+	}
+}
+
+/* Report controller updates per second, scalar calls versus the bank. */
+void test_no_os_pid_bank_benchmark(void)
+{
+	static const unsigned int sizes[] = {1, 2, 4, 8, 16, 32, 64};
+	struct no_os_pid_bank *bank;
+	double t0, t_ref, t_bank;
+	unsigned int i, n, k, s;
+
+	for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+		n = sizes[i];
+		make_configs(n);
+		for (k = 0; k < n; k++) {
+			TEST_ASSERT_EQUAL_INT(0, no_os_pid_init(&pid[k], cfg[k]));
+			sp[k] = rand_range(0, 4095);
+			pv[k] = rand_range(0, 4095);
+		}
+		TEST_ASSERT_EQUAL_INT(0, no_os_pid_bank_init(&bank, cfg, n));
+
+		t0 = now();
+		for (s = 0; s < BENCH_STEPS; s++) {
+			for (k = 0; k < n; k++)
+				pv_step[k] = pv[k] + (s & 7);
+			for (k = 0; k < n; k++)
+				no_os_pid_control(pid[k], sp[k], pv_step[k], &out_ref[k]);
+		}
+		t_ref = now() - t0;
+
+		t0 = now();
+		for (s = 0; s < BENCH_STEPS; s++) {
+			for (k = 0; k < n; k++)
+				pv_step[k] = pv[k] + (s & 7);
+			no_os_pid_bank_control(bank, sp, pv_step, out_bank);
+		}
+		t_bank = now() - t0;
+
+		printf("no_os_pid %2u controllers: scalar %.1f M updates/s, bank %.1f M updates/s\n",
+		       n, n * (double)BENCH_STEPS / (t_ref ? t_ref : 1e-9) / 1e6,
+		       n * (double)BENCH_STEPS / (t_bank ? t_bank : 1e-9) / 1e6);
+
+		for (k = 0; k < n; k++)
+			no_os_pid_remove(pid[k]);
+		no_os_pid_bank_remove(bank);
+	}
+}
@@ -0,0 +1,238 @@
+/***************************************************************************//**
+ *   @file   test_no_os_print_log.c
+ *   @brief  Unit tests of the deferred log ring.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "unity.h"
+
+/* Small ring, so that the records wrap around */
+#define NO_OS_LOG_DEFERRED
+#define NO_OS_LOG_BUFF_WORDS	128
+/* The ring is static, the source is built with the test */
+#include "no_os_print_log.c"
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define MASK		(NO_OS_LOG_BUFF_WORDS - 1)
+
+static char out[512];
+static FILE *out_file;
+static int stdout_fd;
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+/* Redirect stdout, where no_os_log_process() prints, to a file */
+static void capture_start(void)
+{
+	fflush(stdout);
+	out_file = tmpfile();
+	TEST_ASSERT_NOT_NULL(out_file);
+	stdout_fd = dup(STDOUT_FILENO);
+	dup2(fileno(out_file), STDOUT_FILENO);
+}
+
+static const char *capture_end(void)
+{
+	size_t len;
+
+	fflush(stdout);
+	dup2(stdout_fd, STDOUT_FILENO);
+	close(stdout_fd);
+	rewind(out_file);
+	len = fread(out, 1, sizeof(out) - 1, out_file);
+	out[len] = '\0';
+	fclose(out_file);
+
+	return out;
+}
+
+static uint32_t process_all(void)
+{
+	uint32_t cnt = 0;
+
+	while (no_os_log_process())
+		cnt++;
+
+	return cnt;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	memset(&no_os_log, 0, sizeof(no_os_log));
+}
+
+void tearDown(void)
+{
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+/* A record holds the format id and the raw arguments. */
+void test_no_os_log_record_layout(void)
+{
+	uint32_t words[16];
+
+	pr_deferred(NO_OS_LOG_WARNING, "a %d %s %lld\n", -5, "hello",
+		    1ll << 40);
+
+	TEST_ASSERT_EQUAL_UINT32(8, no_os_log_read(words, NO_OS_ARRAY_SIZE(words)));
+	TEST_ASSERT_EQUAL_UINT32(NO_OS_LOG_HDR(NO_OS_LOG_WARNING, 8), words[0]);
+	TEST_ASSERT_EQUAL_INT(0, strcmp("a %d %s %lld\n",
+					__start_no_os_log_fmt + words[1]));
+	TEST_ASSERT_EQUAL_INT(-5, (int32_t)words[2]);
+	TEST_ASSERT_EQUAL_UINT32(5, words[3]);
+	TEST_ASSERT_EQUAL_INT(0, memcmp("hello", &words[4], 5));
+	TEST_ASSERT_EQUAL_UINT32(0, words[6]);
+	TEST_ASSERT_EQUAL_UINT32(1 << 8, words[7]);
+
+	/* Nothing left */
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_log_read(words, NO_OS_ARRAY_SIZE(words)));
+}
+
+/* Records are read whole, in order. */
+void test_no_os_log_read_whole(void)
+{
+	uint32_t words[8];
+
+	pr_deferred(NO_OS_LOG_INFO, "%d %d\n", 1, 2);
+	pr_deferred(NO_OS_LOG_INFO, "%d\n", 3);
+
+	TEST_ASSERT_EQUAL_UINT32(4, no_os_log_read(words, 5));
+	TEST_ASSERT_EQUAL_UINT32(2, words[3]);
+	TEST_ASSERT_EQUAL_UINT32(3, no_os_log_read(words, 5));
+	TEST_ASSERT_EQUAL_UINT32(3, words[2]);
+}
+
+/* The output is the one of printf() with the same arguments. */
+void test_no_os_log_process(void)
+{
+	char expected[sizeof(out)];
+	const char *str = "a string longer than the copied 32 characters";
+
+	pr_deferred(NO_OS_LOG_INFO, "[%5d|%-4u|%x|%c|%%]\n", -12, 7u, 0xBEEFu,
+		    'z');
+	pr_deferred(NO_OS_LOG_INFO, "%*d|%.*f|%e\n", 6, 42, 3, 3.14159, -1e-9);
+	pr_deferred(NO_OS_LOG_INFO, "%ld %lu %llu %zu\n", -100000L, 100000UL,
+		    1ull << 63, (size_t)123);
+	pr_deferred(NO_OS_LOG_INFO, "<%s> <%8s> <%s>\n", str, "ab", "");
+	pr_deferred(NO_OS_LOG_INFO, "no arguments\n");
+
+	capture_start();
+	TEST_ASSERT_EQUAL_UINT32(5, process_all());
+	capture_end();
+
+	snprintf(expected, sizeof(expected),
+		 "[%5d|%-4u|%x|%c|%%]\n%*d|%.*f|%e\n%ld %lu %llu %zu\n"
+		 "<%.32s> <%8s> <%s>\nno arguments\n",
+		 -12, 7u, 0xBEEFu, 'z', 6, 42, 3, 3.14159, -1e-9,
+		 -100000L, 100000UL, 1ull << 63, (size_t)123, str, "ab", "");
+	TEST_ASSERT_EQUAL_INT(0, strcmp(expected, out));
+}
+
+/* When the ring is full the new messages are dropped and counted. */
+void test_no_os_log_full(void)
+{
+	uint32_t i;
+
+	/* 4 words per record */
+	for (i = 0; i < NO_OS_LOG_BUFF_WORDS / 4 + 3; i++)
+		pr_deferred(NO_OS_LOG_INFO, "%d %d\n", i, i);
+
+	TEST_ASSERT_EQUAL_UINT32(3, no_os_log_dropped());
+	capture_start();
+	TEST_ASSERT_EQUAL_UINT32(NO_OS_LOG_BUFF_WORDS / 4, process_all());
+	capture_end();
+	TEST_ASSERT_EQUAL_INT(0, strncmp("0 0\n1 1\n", out, 8));
+
+	pr_deferred(NO_OS_LOG_INFO, "%d %d\n", 1, 1);
+	TEST_ASSERT_EQUAL_UINT32(3, no_os_log_dropped());
+}
+
+/*
+ * A slot reserved by a producer that did not write its record yet is not
+ * read, even when it lies over the arguments of older records.
+ */
+void test_no_os_log_reserved(void)
+{
+	uint32_t words[8];
+	uint32_t i, pos;
+
+	/* 5 words per record, so that the records do not align on a wrap */
+	for (i = 0; i < 20; i++)
+		pr_deferred(NO_OS_LOG_INFO, "%x %x %x\n", 0x11111111u,
+			    0x22222222u, 0x33333333u);
+	capture_start();
+	TEST_ASSERT_EQUAL_UINT32(20, process_all());
+	for (i = 0; i < 10; i++)
+		pr_deferred(NO_OS_LOG_INFO, "%x %x %x\n", 0x11111111u,
+			    0x22222222u, 0x33333333u);
+	TEST_ASSERT_EQUAL_UINT32(10, process_all());
+	capture_end();
+
+	/* Reserve 5 words, as a producer interrupted after the CAS on head */
+	pos = no_os_log.head;
+	no_os_log.head += 5;
+	for (i = 0; i < 5; i++)
+		TEST_ASSERT_EQUAL_UINT32(0, no_os_log.buff[(pos + i) & MASK]);
+	TEST_ASSERT_EQUAL_INT(0, no_os_log_process());
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_log_read(words, NO_OS_ARRAY_SIZE(words)));
+
+	/* Then the producer writes the record and commits it */
+	pr_deferred(NO_OS_LOG_INFO, "%d %d %d\n", 1, 2, 3);
+	no_os_log.buff[(pos + 1) & MASK] = no_os_log.buff[(pos + 6) & MASK];
+	no_os_log.buff[(pos + 2) & MASK] = 4;
+	no_os_log.buff[(pos + 3) & MASK] = 5;
+	no_os_log.buff[(pos + 4) & MASK] = 6;
+	no_os_log.buff[pos & MASK] = NO_OS_LOG_HDR(NO_OS_LOG_INFO, 5);
+
+	capture_start();
+	TEST_ASSERT_EQUAL_UINT32(2, process_all());
+	capture_end();
+	TEST_ASSERT_EQUAL_INT(0, strcmp("4 5 6\n1 2 3\n", out));
+}
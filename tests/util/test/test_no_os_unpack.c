@@ -0,0 +1,289 @@
+/***************************************************************************//**
+ *   @file   test_no_os_unpack.c
+ *   @brief  Unit tests and benchmark for no_os_unpack.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include "unity.h"
+#include "no_os_unpack.h"
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define MAX_WORDS	67
+#define BENCH_WORDS	4096
+#define BENCH_LOOPS	2000
+
+static uint8_t packed[MAX_WORDS * 4 + 8];
+static uint32_t words[MAX_WORDS];
+static int32_t dst[MAX_WORDS];
+static uint32_t status[MAX_WORDS];
+static int32_t dst_ref[MAX_WORDS];
+static uint32_t status_ref[MAX_WORDS];
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static void fill_random(uint8_t *buf, uint32_t len)
+{
+	uint32_t i;
+
+	for (i = 0; i < len; i++)
+		buf[i] = rand();
+}
+
+/* Word i of a packed stream, read one bit at a time */
+static uint32_t ref_word(const uint8_t *src, uint32_t width, uint32_t i)
+{
+	uint32_t k, bit, val = 0;
+
+	for (k = 0; k < width; k++) {
+		bit = i * width + k;
+		val = (val << 1) | ((src[bit / 8] >> (7 - bit % 8)) & 1);
+	}
+
+	return val;
+}
+
+static void ref_split(const struct no_os_unpack_fmt *fmt, uint32_t word,
+		      bool split, int32_t *d, uint32_t *s)
+{
+	uint32_t width = fmt->bits + fmt->status_bits;
+	uint32_t val = word;
+	uint32_t nbits = width;
+
+	if (split && fmt->status_bits) {
+		*s = word & ((1u << fmt->status_bits) - 1);
+		val = word >> fmt->status_bits;
+		nbits = fmt->bits;
+	}
+
+	if (fmt->sign && nbits < 32 && (val & (1u << (nbits - 1))))
+		val |= ~((1u << nbits) - 1);
+
+	*d = (int32_t)val;
+}
+
+static double now(void)
+{
+	return (double)clock() / CLOCKS_PER_SEC;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	srand(1);
+}
+
+void tearDown(void)
+{
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_no_os_unpack_invalid(void)
+{
+	struct no_os_unpack_fmt fmt = { .bits = 0 };
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_unpack(NULL, packed, 1, dst, NULL));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_unpack(&fmt, packed, 1, dst, NULL));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_unpack32(&fmt, words, 1, dst, NULL));
+
+	fmt.bits = 24;
+	fmt.status_bits = 9;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_unpack(&fmt, packed, 1, dst, NULL));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_unpack32(&fmt, words, 1, dst,
+			      status));
+}
+
+/* AD7606C-18 frame: 18-bit samples followed by a status byte. */
+void test_no_os_unpack_ad7606_frame(void)
+{
+	static const uint8_t frame[] = {
+		/* 0x1FFFF, st 0xA5, -1, st 0x01 */
+		0x7F, 0xFF, 0xE9, 0x7F, 0xFF, 0xF0, 0x10,
+	};
+	struct no_os_unpack_fmt fmt = {
+		.bits = 18, .status_bits = 8, .sign = true
+	};
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_unpack(&fmt, frame, 2, dst, status));
+	TEST_ASSERT_EQUAL_INT(0x1FFFF, dst[0]);
+	TEST_ASSERT_EQUAL_INT(-1, dst[1]);
+	TEST_ASSERT_EQUAL_UINT32(0xA5, status[0]);
+	TEST_ASSERT_EQUAL_UINT32(0x01, status[1]);
+
+	/* Status kept in the low byte, the sample sign-extended above it */
+	TEST_ASSERT_EQUAL_INT(0, no_os_unpack(&fmt, frame, 2, dst, NULL));
+	TEST_ASSERT_EQUAL_INT((0x1FFFF << 8) | 0xA5, dst[0]);
+	TEST_ASSERT_EQUAL_INT((int32_t)0xFFFFFF01, dst[1]);
+}
+
+/* Every layout, word count and source alignment against the bit reader. */
+void test_no_os_unpack_bit_exact(void)
+{
+	struct no_os_unpack_fmt fmt;
+	uint32_t bits, sbits, sign, split, nb, off, i;
+	uint8_t *src;
+
+	for (bits = 1; bits <= 32; bits++) {
+		for (sbits = 0; bits + sbits <= 32; sbits++) {
+			fmt.bits = bits;
+			fmt.status_bits = sbits;
+			for (sign = 0; sign < 2; sign++) {
+				fmt.sign = sign;
+				for (split = 0; split < 2; split++) {
+					for (nb = 0; nb <= MAX_WORDS; nb++) {
+						off = nb % 4;
+						src = packed + off;
+						fill_random(packed, sizeof(packed));
+						for (i = 0; i < nb; i++)
+							ref_split(&fmt, ref_word(src, bits + sbits, i),
+								  split, &dst_ref[i], &status_ref[i]);
+
+						memset(dst, 0, sizeof(dst));
+						memset(status, 0, sizeof(status));
+						TEST_ASSERT_EQUAL_INT(0, no_os_unpack(&fmt, src, nb, dst,
+								      split ? status : NULL));
+						TEST_ASSERT_EQUAL_INT_ARRAY(dst_ref, dst, nb);
+						if (split && sbits)
+							TEST_ASSERT_EQUAL_INT_ARRAY(status_ref, status, nb);
+					}
+				}
+			}
+		}
+	}
+}
+
+/* Same for words right aligned in 32-bit containers, garbage above them. */
+void test_no_os_unpack32_bit_exact(void)
+{
+	struct no_os_unpack_fmt fmt;
+	uint32_t bits, sbits, sign, split, nb, i, width;
+
+	for (bits = 1; bits <= 32; bits++) {
+		for (sbits = 0; bits + sbits <= 32; sbits++) {
+			fmt.bits = bits;
+			fmt.status_bits = sbits;
+			width = bits + sbits;
+			for (sign = 0; sign < 2; sign++) {
+				fmt.sign = sign;
+				for (split = 0; split < 2; split++) {
+					for (nb = 0; nb <= MAX_WORDS; nb += 3) {
+						fill_random((uint8_t *)words, sizeof(words));
+						for (i = 0; i < nb; i++)
+							ref_split(&fmt, width < 32 ?
+								  words[i] & ((1u << width) - 1) :
+								  words[i], split,
+								  &dst_ref[i], &status_ref[i]);
+
+						TEST_ASSERT_EQUAL_INT(0, no_os_unpack32(&fmt, words, nb,
+								      dst, split ? status : NULL));
+						TEST_ASSERT_EQUAL_INT_ARRAY(dst_ref, dst, nb);
+						if (split && sbits)
+							TEST_ASSERT_EQUAL_INT_ARRAY(status_ref, status, nb);
+					}
+				}
+			}
+		}
+	}
+
+	/* In place */
+	fmt.bits = 24;
+	fmt.status_bits = 0;
+	fmt.sign = true;
+	words[0] = 0xAA800000;
+	TEST_ASSERT_EQUAL_INT(0, no_os_unpack32(&fmt, words, 1, (int32_t *)words,
+			      NULL));
+	TEST_ASSERT_EQUAL_INT((int32_t)0xFF800000, (int32_t)words[0]);
+}
+
+/* Report the unpack throughput for the common ADC word widths. */
+void test_no_os_unpack_benchmark(void)
+{
+	static const struct no_os_unpack_fmt fmts[] = {
+		{ .bits = 16, .sign = true },
+		{ .bits = 18, .sign = true },
+		{ .bits = 18, .status_bits = 8, .sign = true },
+		{ .bits = 20, .sign = true },
+		{ .bits = 24, .sign = true },
+		{ .bits = 26, .sign = true },
+		{ .bits = 24, .status_bits = 8, .sign = true },
+	};
+	uint8_t *src;
+	int32_t *out;
+	uint32_t *st;
+	uint32_t i, k, width, len;
+	double t0, t;
+
+	src = malloc(BENCH_WORDS * 4);
+	out = malloc(BENCH_WORDS * sizeof(*out));
+	st = malloc(BENCH_WORDS * sizeof(*st));
+	TEST_ASSERT_NOT_NULL(src);
+	TEST_ASSERT_NOT_NULL(out);
+	TEST_ASSERT_NOT_NULL(st);
+	fill_random(src, BENCH_WORDS * 4);
+
+	for (i = 0; i < sizeof(fmts) / sizeof(fmts[0]); i++) {
+		width = fmts[i].bits + fmts[i].status_bits;
+		len = BENCH_WORDS * width / 8;
+
+		t0 = now();
+		for (k = 0; k < BENCH_LOOPS; k++)
+			no_os_unpack(&fmts[i], src, BENCH_WORDS, out,
+				     fmts[i].status_bits ? st : NULL);
+		t = now() - t0;
+
+		printf("no_os_unpack %2u+%u bits: %.2f GB/s packed, %.0f M words/s\n",
+		       fmts[i].bits, fmts[i].status_bits,
+		       (double)len * BENCH_LOOPS / (t ? t : 1e-9) / 1e9,
+		       (double)BENCH_WORDS * BENCH_LOOPS / (t ? t : 1e-9) / 1e6);
+	}
+
+	free(st);
+	free(out);
+	free(src);
+}
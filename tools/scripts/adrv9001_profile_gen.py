@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+"""Convert an ADRV9001 JSON profile into a const adi_adrv9001_Init_t.
+
+The generated header is loaded with adrv9002_init_param.profile_init and
+replaces adi_adrv9001_profileutil_Parse() at boot. The field layout is
+taken from adrv9001_Init_t_parser.h, so the result matches what the
+runtime parser would produce for the same profile. Since the output is a
+designated initializer, a profile generated for a different API version
+fails to compile instead of loading garbage.
+
+The input is either the profile JSON file or a C header holding the JSON
+as a string literal, like projects/adrv9001/src/app/Navassa_*_profile.h.
+
+Usage:
+  adrv9001_profile_gen.py <profile.json | profile.h> <out.h> [symbol]
+"""
+
+import json
+import os
+import re
+import sys
+
+PARSER_H = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..',
+                        '..', 'drivers', 'rf-transceiver', 'navassa',
+                        'devices', 'adrv9001', 'public', 'include',
+                        'adrv9001_Init_t_parser.h')
+ROOT = 'ADRV9001_INIT_T'
+
+DEFINE = re.compile(r'^#define (ADRV9001_\w+_T)\(tokenArray,')
+FIELD = re.compile(r'^ADI_PROCESS_(\w+?)\s*\(.*Instance\.(\w+),\s*"(\w+)"\)')
+
+
+def load_schema(path):
+    """Map every struct macro to its (kind, member) list."""
+    schema = {}
+    fields = None
+    with open(path) as f:
+        for line in f:
+            m = DEFINE.match(line)
+            if m:
+                fields = schema.setdefault(m.group(1), [])
+                continue
+            if fields is None:
+                continue
+            m = FIELD.match(line)
+            if not m:
+                fields = None
+                continue
+            kind, member, name = m.groups()
+            if member != name:
+                sys.exit('%s: JSON key %s does not match member %s' %
+                         (path, name, member))
+            fields.append((kind, member))
+    return schema
+
+
+def load_json(path):
+    with open(path) as f:
+        text = f.read()
+    if path.endswith('.h'):
+        # const char *json_profile = "{ \
+        #   \"key\": value, \
+        # }";
+        text = text[text.index('"') + 1:text.rindex('"')]
+        text = text.replace('\\\n', '\n').replace('\\"', '"')
+    return json.loads(text)
+
+
+def c_int(val):
+    # Same conversion as atoi() in ADI_STORE_INT
+    if isinstance(val, bool):
+        return '0'
+    return str(int(val))
+
+
+def c_bool(val):
+    # Same test as ADI_STORE_BOOL
+    return 'false' if str(val).lower()[:1] in ('0', 'f') else 'true'
+
+
+def emit_struct(schema, macro, obj, depth):
+    ind = '\t' * (depth + 1)
+    out = []
+    for kind, member in schema[macro]:
+        if member not in obj:
+            continue
+        val = obj[member]
+        if kind == 'INT':
+            out.append('%s.%s = %s,' % (ind, member, c_int(val)))
+        elif kind == 'BOOL':
+            out.append('%s.%s = %s,' % (ind, member, c_bool(val)))
+        elif kind == 'STR':
+            out.append('%s.%s = %s,' % (ind, member, json.dumps(val)))
+        elif kind == 'ARRAY_INT':
+            out.append('%s.%s = {' % (ind, member))
+            vals = [c_int(v) for v in val]
+            for i in range(0, len(vals), 8):
+                out.append('%s\t%s,' % (ind, ', '.join(vals[i:i + 8])))
+            out.append('%s},' % ind)
+        elif kind.startswith('STRUCT_'):
+            out.append('%s.%s = {' % (ind, member))
+            out += emit_struct(schema, kind[len('STRUCT_'):], val, depth + 1)
+            out.append('%s},' % ind)
+        elif kind.startswith('ARRAY_'):
+            out.append('%s.%s = {' % (ind, member))
+            for elem in val:
+                out.append('%s\t{' % ind)
+                out += emit_struct(schema, kind[len('ARRAY_'):], elem,
+                                   depth + 2)
+                out.append('%s\t},' % ind)
+            out.append('%s},' % ind)
+        else:
+            sys.exit('unknown field kind %s' % kind)
+    return out
+
+
+def main():
+    if len(sys.argv) < 3:
+        print(__doc__)
+        sys.exit(1)
+
+    src, dst = sys.argv[1], sys.argv[2]
+    base = os.path.splitext(os.path.basename(dst))[0]
+    symbol = sys.argv[3] if len(sys.argv) > 3 else base.lower()
+    guard = '__%s_H__' % base.upper()
+
+    schema = load_schema(PARSER_H)
+    body = emit_struct(schema, ROOT, load_json(src), 0)
+
+    with open(dst, 'w') as f:
+        f.write('/* Generated by adrv9001_profile_gen.py from %s, do not edit. */\n'
+                % os.path.basename(src))
+        f.write('#ifndef %s\n#define %s\n\n' % (guard, guard))
+        f.write('#include <stdbool.h>\n#include "adi_adrv9001_types.h"\n\n')
+        f.write('const adi_adrv9001_Init_t %s = {\n' % symbol)
+        f.write('\n'.join(body))
+        f.write('\n};\n\n#endif\n')
+
+
+if __name__ == '__main__':
+    main()
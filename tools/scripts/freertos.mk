@@ -32,7 +32,8 @@ INCS += $(RTOS_INCS)
 # Include freeRTOS platform specifics
 SRCS += $(NO-OS)/drivers/platform/freeRTOS/freertos_mutex.c \
         $(NO-OS)/drivers/platform/freeRTOS/freertos_semaphore.c \
-        $(NO-OS)/drivers/platform/freeRTOS/freertos_delay.c 
+        $(NO-OS)/drivers/platform/freeRTOS/freertos_delay.c \
+        $(NO-OS)/drivers/platform/freeRTOS/freertos_thread.c
 
 # Include FreeRTOS specific configurations
 ifeq ($(wildcard $(FREERTOS_CONFIG_PATH)),)
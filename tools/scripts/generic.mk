@@ -182,6 +182,14 @@ ifeq (y,$(strip $(DISABLE_SECURE_SOCKET)))
 CFLAGS += -DDISABLE_SECURE_SOCKET
 endif
 
+# Deferred logging: pr_* record binary messages, decoded with
+# tools/scripts/no_os_log_decode.py and the extracted format table
+ifeq (y,$(strip $(NO_OS_LOG_DEFERRED)))
+CFLAGS += -DNO_OS_LOG_DEFERRED
+SRCS += $(NO-OS)/util/no_os_print_log.c
+LOG_OBJCOPY ?= $(if $(SIZE),$(patsubst %size,%objcopy,$(SIZE)),objcopy)
+endif
+
 # Mbed also has an INC_DIRS variable, so this needs to be NO_OS_INC_DIRS
 NO_OS_INC_DIRS := $(patsubst %/,%,$(NO_OS_INC_DIRS))
 SRC_DIRS := $(patsubst %/,%,$(SRC_DIRS))
@@ -194,6 +202,13 @@ ASM_SRCS += $(foreach dir, $(SRC_DIRS), $(call rwildcard, $(dir),*.s))
 INCS     += $(foreach dir, $(SRC_DIRS), $(call rwildcard, $(dir),*.h))
 INCS     += $(foreach dir, $(NO_OS_INC_DIRS), $(call rwildcard, $(dir),*.h))
 
+# Bring-up profiler: time spent in delays, register polls and SPI transfers,
+# printed with no_os_prof_report()
+ifeq (y,$(strip $(NO_OS_PROF)))
+CFLAGS += -DNO_OS_PROF
+SRCS += $(filter-out $(SRCS),$(NO-OS)/util/no_os_prof.c)
+endif
+
 # Recursive ignored files. If a directory is in the variable IGNORED_FILES,
 # all files from inside the directory will be ignored
 ALL_IGNORED_FILES += $(foreach dir, $(IGNORED_FILES), $(call rwildcard, $(dir),*))
@@ -372,6 +387,10 @@ project: $(LIB_TARGETS) $(PLATFORM)_project
 # Platform specific post build dependencies can be added to this rule.
 post_build: $(PLATFORM)_post_build
 	-$(SIZE) --format=Berkley $(BINARY) $(HEX) 2> /dev/null
+ifeq (y,$(strip $(NO_OS_LOG_DEFERRED)))
+	$(call print,Extracting log format table)
+	-$(LOG_OBJCOPY) -O binary --only-section=no_os_log_fmt $(BINARY) $(BINARY).logfmt
+endif
 
 # Function to process a list in chunks
 # Arguments:
@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+"""Decoder for the deferred no-OS log stream (NO_OS_LOG_DEFERRED=y).
+
+The target sends the raw records returned by no_os_log_read(). The format
+strings are taken from the no_os_log_fmt section, extracted at build time
+into <binary>.logfmt, or read directly from the ELF file.
+
+Usage:
+  no_os_log_decode.py <binary.logfmt | binary.elf> <log.bin | /dev/ttyX> [baud]
+"""
+
+import re
+import struct
+import subprocess
+import sys
+import tempfile
+
+LOG_MAGIC = 0xA5
+STR_MAX = 32
+
+SPEC = re.compile(r'%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|L|j|z|t)?([diuxXoceEfFgGaAps%])')
+
+
+def load_fmt_table(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+    if not data.startswith(b'\x7fELF'):
+        return data
+
+    with tempfile.NamedTemporaryFile() as tmp:
+        subprocess.check_call(['objcopy', '-O', 'binary',
+                               '--only-section=no_os_log_fmt', path, tmp.name])
+        return tmp.read()
+
+
+def fmt_at(table, offset):
+    end = table.index(b'\0', offset)
+    return table[offset:end].decode('utf-8', 'replace')
+
+
+def to_signed(val, bits):
+    return val - (1 << bits) if val & (1 << (bits - 1)) else val
+
+
+def format_record(fmt, words):
+    out = []
+    pos = 0
+    w = 0
+
+    def take():
+        nonlocal w
+        val = words[w] if w < len(words) else 0
+        w += 1
+        return val
+
+    for m in SPEC.finditer(fmt):
+        out.append(fmt[pos:m.start()])
+        pos = m.end()
+        flags, width, prec, length, conv = m.groups()
+        if conv == '%':
+            out.append('%')
+            continue
+
+        if width == '*':
+            width = str(to_signed(take(), 32))
+        if prec == '*':
+            prec = str(to_signed(take(), 32))
+        pyspec = '%' + flags + (width or '') + ('.' + prec if prec else '')
+
+        if conv == 's':
+            n = min(take(), STR_MAX)
+            raw = struct.pack('<%dI' % ((n + 3) // 4),
+                              *[take() for _ in range((n + 3) // 4)])
+            out.append((pyspec + 's') % raw[:n].decode('utf-8', 'replace'))
+            continue
+
+        wide = conv in 'eEfFgGaAp' or length in ('l', 'll', 'j', 'z', 't')
+        val = take()
+        if wide:
+            val |= take() << 32
+
+        if conv in 'eEfFgGaA':
+            val = struct.unpack('<d', struct.pack('<Q', val))[0]
+            out.append((pyspec + conv.replace('a', 'e').replace('A', 'E')) % val)
+        elif conv == 'p':
+            out.append('0x%x' % val)
+        elif conv == 'c':
+            out.append((pyspec + 'c') % chr(val & 0xFF))
+        elif conv in 'di':
+            out.append((pyspec + 'd') % to_signed(val, 64 if wide else 32))
+        else:
+            out.append((pyspec + ('d' if conv == 'u' else conv)) % val)
+
+    out.append(fmt[pos:])
+    return ''.join(out)
+
+
+def decode(table, stream, follow=False):
+    buf = b''
+    while True:
+        chunk = stream.read(4096)
+        if not chunk:
+            if follow:
+                continue
+            break
+        buf += chunk
+        while len(buf) >= 8:
+            hdr, offset = struct.unpack_from('<II', buf)
+            n = hdr & 0xFFFF
+            if hdr >> 24 != LOG_MAGIC or n < 2:
+                # Resynchronize on the next header
+                buf = buf[1:]
+                continue
+            if len(buf) < 4 * n:
+                break
+            words = struct.unpack_from('<%dI' % n, buf)
+            buf = buf[4 * n:]
+            try:
+                fmt = fmt_at(table, offset)
+            except ValueError:
+                sys.stdout.write('<bad format id 0x%x>\n' % offset)
+                continue
+            sys.stdout.write(format_record(fmt, list(words[2:])))
+        sys.stdout.flush()
+
+
+def main():
+    if len(sys.argv) < 3:
+        print(__doc__)
+        sys.exit(1)
+
+    table = load_fmt_table(sys.argv[1])
+    if sys.argv[2].startswith('/dev/') or sys.argv[2].startswith('COM'):
+        import serial
+        baud = int(sys.argv[3]) if len(sys.argv) > 3 else 115200
+        with serial.Serial(sys.argv[2], baud, timeout=0.1) as stream:
+            decode(table, stream, follow=True)
+    else:
+        with open(sys.argv[2], 'rb') as stream:
+            decode(table, stream)
+
+
+if __name__ == '__main__':
+    main()
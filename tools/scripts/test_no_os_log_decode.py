@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+"""Tests of no_os_log_decode.py, on records laid out as no_os_log_record()
+writes them.
+
+Usage:
+  python3 -m unittest tools/scripts/test_no_os_log_decode.py
+"""
+
+import io
+import os
+import struct
+import sys
+import unittest
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+
+import no_os_log_decode as dec  # noqa: E402
+
+LEVEL_INFO = 6
+
+
+def fmt_table(*fmts):
+    """Format table and the offset of each format in it."""
+    table = b''
+    offsets = []
+    for fmt in fmts:
+        offsets.append(len(table))
+        table += fmt.encode() + b'\0'
+    return table, offsets
+
+
+def record(offset, *args):
+    """Record of the given argument words, header included."""
+    words = [offset] + list(args)
+    hdr = (dec.LOG_MAGIC << 24) | (LEVEL_INFO << 16) | (len(words) + 1)
+    return struct.pack('<%dI' % (len(words) + 1), hdr, *words)
+
+
+def string(s):
+    """Length word followed by the bytes, as no_os_log_record() does."""
+    raw = s.encode()[:dec.STR_MAX]
+    n = (len(raw) + 3) // 4
+    raw += b'\0' * (4 * n - len(raw))
+    return [len(s.encode()[:dec.STR_MAX])] + list(struct.unpack('<%dI' % n, raw))
+
+
+def wide(val):
+    return [val & 0xFFFFFFFF, (val >> 32) & 0xFFFFFFFF]
+
+
+def double(val):
+    return wide(struct.unpack('<Q', struct.pack('<d', val))[0])
+
+
+class TestDecode(unittest.TestCase):
+
+    def decode(self, table, data):
+        out = io.StringIO()
+        stdout = sys.stdout
+        sys.stdout = out
+        try:
+            dec.decode(table, io.BytesIO(data))
+        finally:
+            sys.stdout = stdout
+        return out.getvalue()
+
+    def test_conversions(self):
+        table, off = fmt_table('[%5d|%-4u|%x|%c|%%]\n',
+                               '%*d|%.*f|%e\n',
+                               '%ld %lu %llu %zu\n',
+                               '<%s> <%8s> <%s>\n')
+        long_str = 'a string longer than the copied 32 characters'
+        data = record(off[0], (-12) & 0xFFFFFFFF, 7, 0xBEEF, ord('z'))
+        data += record(off[1], 6, 42, 3, *(double(3.14159) + double(-1e-9)))
+        data += record(off[2], *(wide(-100000 & (2**64 - 1)) + wide(100000) +
+                                 wide(1 << 63) + wide(123)))
+        data += record(off[3], *(string(long_str) + string('ab') +
+                                 string('')))
+
+        expected = ('[%5d|%-4u|%x|%c|%%]\n' % (-12, 7, 0xBEEF, 'z') +
+                    '%*d|%.*f|%e\n' % (6, 42, 3, 3.14159, -1e-9) +
+                    '-100000 100000 %d 123\n' % (1 << 63) +
+                    '<%s> <%8s> <>\n' % (long_str[:dec.STR_MAX], 'ab'))
+        self.assertEqual(expected, self.decode(table, data))
+
+    def test_resync(self):
+        table, off = fmt_table('x', '%d\n')
+        data = b'\x01\x02\x03' + record(off[1], 1) + b'\xff' * 5
+        data += record(off[1], 2)
+        self.assertEqual('1\n2\n', self.decode(table, data))
+
+    def test_truncated(self):
+        table, off = fmt_table('%d %d\n')
+        data = record(off[0], 1, 2) + record(off[0], 3, 4)[:-4]
+        self.assertEqual('1 2\n', self.decode(table, data))
+
+    def test_bad_format(self):
+        table, off = fmt_table('%d\n')
+        data = record(len(table) + 4, 1) + record(off[0], 2)
+        self.assertEqual('<bad format id 0x%x>\n2\n' % (len(table) + 4),
+                         self.decode(table, data))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -64,6 +64,7 @@ int32_t no_os_clk_init(struct no_os_clk_desc **desc,
 	clk->hw_ch_num = param->hw_ch_num;
 	clk->dev_desc = param->dev_desc;
 	clk->platform_ops = param->platform_ops;
+	clk->flags = param->flags;
 
 	if (param->platform_ops->init) {
 		ret = param->platform_ops->init(desc, param);
@@ -71,6 +72,12 @@ int32_t no_os_clk_init(struct no_os_clk_desc **desc,
 			goto error;
 	}
 
+	if (param->parent) {
+		clk->parent = param->parent;
+		clk->sibling = param->parent->child;
+		param->parent->child = clk;
+	}
+
 	*desc = clk;
 
 	return 0;
@@ -88,6 +95,7 @@ error:
  */
 int32_t no_os_clk_remove(struct no_os_clk_desc *desc)
 {
+	struct no_os_clk_desc **link, *child, *next;
 	int ret;
 
 	if (!desc || !desc->platform_ops)
@@ -99,6 +107,21 @@ int32_t no_os_clk_remove(struct no_os_clk_desc *desc)
 			return ret;
 	}
 
+	if (desc->parent) {
+		link = &desc->parent->child;
+		while (*link && *link != desc)
+			link = &(*link)->sibling;
+		if (*link)
+			*link = desc->sibling;
+	}
+
+	/* The children become root clocks */
+	for (child = desc->child; child; child = next) {
+		next = child->sibling;
+		child->parent = NULL;
+		child->sibling = NULL;
+	}
+
 	no_os_free(desc);
 
 	return 0;
@@ -137,7 +160,8 @@ int32_t no_os_clk_disable(struct no_os_clk_desc *desc)
 }
 
 /**
- * Get the current frequency of the clock.
+ * Get the current frequency of the clock. With NO_OS_CLK_CACHE_RATE the
+ * device is only queried after a rate change.
  * @param clk - The clock descriptor.
  * @param rate - The current frequency.
  * @return 0 in case of success, negative error code otherwise.
@@ -145,13 +169,29 @@ int32_t no_os_clk_disable(struct no_os_clk_desc *desc)
 int32_t no_os_clk_recalc_rate(struct no_os_clk_desc *desc,
 			      uint64_t *rate)
 {
+	int ret;
+
 	if (!desc || !desc->platform_ops || !rate)
 		return -EINVAL;
 
+	if (desc->rate_valid) {
+		*rate = desc->rate;
+		return 0;
+	}
+
 	if (!desc->platform_ops->clk_recalc_rate)
 		return -ENOSYS;
 
-	return desc->platform_ops->clk_recalc_rate(desc, rate);
+	ret = desc->platform_ops->clk_recalc_rate(desc, rate);
+	if (ret)
+		return ret;
+
+	if (desc->flags & NO_OS_CLK_CACHE_RATE) {
+		desc->rate = *rate;
+		desc->rate_valid = true;
+	}
+
+	return 0;
 }
 
 /**
@@ -174,6 +214,104 @@ int32_t no_os_clk_round_rate(struct no_os_clk_desc *desc,
 	return desc->platform_ops->clk_round_rate(desc, rate, rounded_rate);
 }
 
+/**
+ * Drop the cached rate of the clock and of all the clocks derived from it.
+ * @param desc - The clock descriptor.
+ */
+void no_os_clk_invalidate_rate(struct no_os_clk_desc *desc)
+{
+	struct no_os_clk_desc *child;
+
+	if (!desc)
+		return;
+
+	desc->rate_valid = false;
+	for (child = desc->child; child; child = child->sibling)
+		no_os_clk_invalidate_rate(child);
+}
+
+/**
+ * Call the notifiers of a clock.
+ * @param desc - The clock descriptor.
+ * @param event - Rate change event.
+ * @param new_rate - The new frequency, 0 if not known.
+ * @return 0 in case of success, the first non-zero notifier return value for
+ * NO_OS_CLK_PRE_RATE_CHANGE.
+ */
+static int no_os_clk_notify(struct no_os_clk_desc *desc,
+			    enum no_os_clk_event event, uint64_t new_rate)
+{
+	struct no_os_clk_notifier *nb;
+	int ret;
+
+	for (nb = desc->notifiers; nb; nb = nb->next) {
+		ret = nb->notifier_call(nb, event, desc, desc->old_rate,
+					new_rate);
+		if (ret && event == NO_OS_CLK_PRE_RATE_CHANGE)
+			return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * Announce a rate change to the clock and to the clocks derived from it.
+ * The current rates are saved as old rates, the device is only queried for
+ * clocks which have notifiers.
+ * @param desc - The clock descriptor.
+ * @param new_rate - Requested frequency, 0 for the children.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int no_os_clk_notify_pre(struct no_os_clk_desc *desc,
+				uint64_t new_rate)
+{
+	struct no_os_clk_desc *child;
+	int ret;
+
+	if (desc->notifiers) {
+		if (no_os_clk_recalc_rate(desc, &desc->old_rate))
+			desc->old_rate = 0;
+
+		ret = no_os_clk_notify(desc, NO_OS_CLK_PRE_RATE_CHANGE,
+				       new_rate);
+		if (ret)
+			return ret;
+	}
+
+	for (child = desc->child; child; child = child->sibling) {
+		ret = no_os_clk_notify_pre(child, 0);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * Deliver a post or abort event to the clock and to the clocks derived
+ * from it. For a post event the new rate is read once per clock which has
+ * notifiers.
+ * @param desc - The clock descriptor.
+ * @param event - NO_OS_CLK_POST_RATE_CHANGE or NO_OS_CLK_ABORT_RATE_CHANGE.
+ */
+static void no_os_clk_notify_done(struct no_os_clk_desc *desc,
+				  enum no_os_clk_event event)
+{
+	struct no_os_clk_desc *child;
+	uint64_t rate = 0;
+
+	if (desc->notifiers) {
+		if (event == NO_OS_CLK_POST_RATE_CHANGE &&
+		    no_os_clk_recalc_rate(desc, &rate))
+			rate = 0;
+
+		no_os_clk_notify(desc, event, rate);
+	}
+
+	for (child = desc->child; child; child = child->sibling)
+		no_os_clk_notify_done(child, event);
+}
+
 /**
  * Change the frequency of the clock.
  * @param clk - The clock descriptor.
@@ -183,11 +321,182 @@ int32_t no_os_clk_round_rate(struct no_os_clk_desc *desc,
 int32_t no_os_clk_set_rate(struct no_os_clk_desc *desc,
 			   uint64_t rate)
 {
-	if (!desc || !desc->platform_ops)
+	return no_os_clk_set_rates(&desc, &rate, 1);
+}
+
+/* State of a clock during no_os_clk_set_rates() */
+#define NO_OS_CLK_UNCHANGED	0
+#define NO_OS_CLK_NOTIFIED	1
+#define NO_OS_CLK_APPLIED	2
+#define NO_OS_CLK_FAILED	3
+
+/**
+ * Change the frequency of several clocks in one batch.
+ *
+ * Clocks with a cached rate equal to the requested one are skipped. All the
+ * notifiers of the affected clocks and of their children are called before
+ * any change is made, so a refusal leaves the hardware untouched. Clocks of
+ * the same device are then handed to clk_set_rates at once when the driver
+ * implements it. The cached rates of the changed subtrees are dropped and
+ * read again only when needed. Notifiers of a clock whose change was not
+ * applied, because of a refusal or a driver error, get
+ * NO_OS_CLK_ABORT_RATE_CHANGE instead of NO_OS_CLK_POST_RATE_CHANGE.
+ * @param desc - Array of clock descriptors.
+ * @param rates - The desired frequencies.
+ * @param nb_clks - Number of clocks.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_clk_set_rates(struct no_os_clk_desc **desc,
+			    const uint64_t *rates,
+			    uint32_t nb_clks)
+{
+	const struct no_os_clk_platform_ops *ops;
+	struct no_os_clk_desc *single_group;
+	struct no_os_clk_desc **group;
+	uint64_t single_rate, *group_rates;
+	uint8_t single_state, *state;
+	void *mem = NULL;
+	uint32_t i, j, n;
+	int ret = 0;
+
+	if (!desc || !rates || !nb_clks)
 		return -EINVAL;
 
-	if (!desc->platform_ops->clk_set_rate)
-		return -ENOSYS;
+	for (i = 0; i < nb_clks; i++) {
+		if (!desc[i] || !desc[i]->platform_ops)
+			return -EINVAL;
+
+		if (!desc[i]->platform_ops->clk_set_rate &&
+		    !desc[i]->platform_ops->clk_set_rates)
+			return -ENOSYS;
+	}
+
+	if (nb_clks == 1) {
+		group = &single_group;
+		group_rates = &single_rate;
+		state = &single_state;
+	} else {
+		mem = no_os_calloc(nb_clks, sizeof(*group) +
+				   sizeof(*group_rates) + sizeof(*state));
+		if (!mem)
+			return -ENOMEM;
+
+		group_rates = mem;
+		group = (struct no_os_clk_desc **)(group_rates + nb_clks);
+		state = (uint8_t *)(group + nb_clks);
+	}
+
+	for (i = 0; i < nb_clks; i++) {
+		state[i] = NO_OS_CLK_UNCHANGED;
+		if (desc[i]->rate_valid && desc[i]->rate == rates[i])
+			continue;
+
+		ret = no_os_clk_notify_pre(desc[i], rates[i]);
+		if (ret) {
+			no_os_clk_notify_done(desc[i],
+					      NO_OS_CLK_ABORT_RATE_CHANGE);
+			goto out;
+		}
+		state[i] = NO_OS_CLK_NOTIFIED;
+	}
+
+	for (i = 0; i < nb_clks; i++) {
+		if (state[i] != NO_OS_CLK_NOTIFIED)
+			continue;
+
+		ops = desc[i]->platform_ops;
+		if (!ops->clk_set_rates) {
+			ret = ops->clk_set_rate(desc[i], rates[i]);
+			if (ret) {
+				state[i] = NO_OS_CLK_FAILED;
+				goto out;
+			}
+			state[i] = NO_OS_CLK_APPLIED;
+			continue;
+		}
+
+		for (n = 0, j = i; j < nb_clks; j++) {
+			if (state[j] != NO_OS_CLK_NOTIFIED ||
+			    desc[j]->platform_ops != ops ||
+			    desc[j]->dev_desc != desc[i]->dev_desc)
+				continue;
+
+			state[j] = NO_OS_CLK_APPLIED;
+			group[n] = desc[j];
+			group_rates[n++] = rates[j];
+		}
+
+		ret = ops->clk_set_rates(group, group_rates, n);
+		if (ret) {
+			for (j = i; j < nb_clks; j++)
+				if (state[j] == NO_OS_CLK_APPLIED &&
+				    desc[j]->platform_ops == ops &&
+				    desc[j]->dev_desc == desc[i]->dev_desc)
+					state[j] = NO_OS_CLK_FAILED;
+			goto out;
+		}
+	}
+
+out:
+	/* A failed driver call may have left the hardware half programmed */
+	for (i = 0; i < nb_clks; i++)
+		if (state[i] == NO_OS_CLK_APPLIED ||
+		    state[i] == NO_OS_CLK_FAILED)
+			no_os_clk_invalidate_rate(desc[i]);
+
+	for (i = 0; i < nb_clks; i++) {
+		if (state[i] == NO_OS_CLK_APPLIED)
+			no_os_clk_notify_done(desc[i],
+					      NO_OS_CLK_POST_RATE_CHANGE);
+		else if (state[i] != NO_OS_CLK_UNCHANGED)
+			no_os_clk_notify_done(desc[i],
+					      NO_OS_CLK_ABORT_RATE_CHANGE);
+	}
+
+	no_os_free(mem);
+
+	return ret;
+}
+
+/**
+ * Register a rate change notifier.
+ * @param desc - The clock descriptor.
+ * @param nb - The notifier, must stay valid until unregistered.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_clk_notifier_register(struct no_os_clk_desc *desc,
+				    struct no_os_clk_notifier *nb)
+{
+	if (!desc || !nb || !nb->notifier_call)
+		return -EINVAL;
+
+	nb->next = desc->notifiers;
+	desc->notifiers = nb;
+
+	return 0;
+}
+
+/**
+ * Unregister a rate change notifier.
+ * @param desc - The clock descriptor.
+ * @param nb - The notifier.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_clk_notifier_unregister(struct no_os_clk_desc *desc,
+				      struct no_os_clk_notifier *nb)
+{
+	struct no_os_clk_notifier **link;
+
+	if (!desc || !nb)
+		return -EINVAL;
+
+	for (link = &desc->notifiers; *link; link = &(*link)->next) {
+		if (*link == nb) {
+			*link = nb->next;
+			nb->next = NULL;
+			return 0;
+		}
+	}
 
-	return desc->platform_ops->clk_set_rate(desc, rate);
+	return -ENOENT;
 }
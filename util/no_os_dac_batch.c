@@ -0,0 +1,296 @@
+/***************************************************************************//**
+ *   @file   no_os_dac_batch.c
+ *   @brief  Batched, LDAC synchronous DAC channel updates.
+ *   @author Analog Devices Inc.
+********************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <errno.h>
+#include <string.h>
+#include "no_os_dac_batch.h"
+#include "no_os_alloc.h"
+#include "no_os_units.h"
+#include "no_os_util.h"
+
+/**
+ * @brief Allocate the frame buffers of a batch.
+ * @param desc - Batch descriptor.
+ * @param param - Initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_dac_batch_init(struct no_os_dac_batch_desc **desc,
+			 const struct no_os_dac_batch_init_param *param)
+{
+	struct no_os_dac_batch_desc *batch;
+	uint32_t nb_frames;
+	int ret;
+
+	if (!desc || !param || !param->spi || !param->devs || !param->ops)
+		return -EINVAL;
+
+	if (!param->ops->pack_write || !param->ops->frame_size ||
+	    param->ops->frame_size > NO_OS_DAC_BATCH_MAX_FRAME)
+		return -EINVAL;
+
+	if (!param->nb_devs || !param->max_updates)
+		return -EINVAL;
+
+	if (param->mode == NO_OS_DAC_BATCH_STREAM && param->nb_devs != 1)
+		return -EINVAL;
+
+	batch = no_os_calloc(1, sizeof(*batch));
+	if (!batch)
+		return -ENOMEM;
+
+	batch->spi = param->spi;
+	batch->ldac = param->ldac;
+	batch->devs = param->devs;
+	batch->nb_devs = param->nb_devs;
+	batch->mode = param->mode;
+	batch->ops = param->ops;
+	batch->max_updates = param->max_updates;
+
+	/* Worst case, all the updates go to one device, plus the update */
+	nb_frames = param->max_updates + 1;
+
+	batch->cnt = no_os_calloc(param->nb_devs, sizeof(*batch->cnt));
+	batch->buf = no_os_calloc(nb_frames, param->nb_devs *
+				  param->ops->frame_size);
+	batch->msgs = no_os_calloc(nb_frames, sizeof(*batch->msgs));
+	batch->row = no_os_calloc(param->max_updates, sizeof(*batch->row));
+	if (!batch->cnt || !batch->buf || !batch->msgs || !batch->row) {
+		ret = -ENOMEM;
+		goto free_batch;
+	}
+
+	if (batch->ldac) {
+		ret = no_os_gpio_direction_output(batch->ldac, NO_OS_GPIO_HIGH);
+		if (ret)
+			goto free_batch;
+	}
+
+	*desc = batch;
+
+	return 0;
+
+free_batch:
+	no_os_dac_batch_remove(batch);
+
+	return ret;
+}
+
+/**
+ * @brief Fill the slot of a device which has nothing to write in a round.
+ * @param desc - Batch descriptor.
+ * @param dev - Device index.
+ * @param frame - Frame of the device in the round.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int no_os_dac_batch_pad(struct no_os_dac_batch_desc *desc, uint8_t dev,
+			       uint8_t *frame)
+{
+	if (!desc->ops->pack_nop) {
+		memset(frame, 0, desc->ops->frame_size);
+		return 0;
+	}
+
+	return desc->ops->pack_nop(desc->devs[dev], frame);
+}
+
+/**
+ * @brief Write updates in one SPI transfer, then load them all together.
+ *
+ * The n-th update of each device goes in the n-th chip select frame. In a
+ * daisy chain, a frame holds one command per device, the farthest device
+ * first, and devices with fewer updates get no-ops. Several updates of the
+ * same channel are applied in order, so the last one wins.
+ * @param desc - Batch descriptor.
+ * @param upd - Updates.
+ * @param nb - Number of updates, at most max_updates.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_dac_batch_write(struct no_os_dac_batch_desc *desc,
+			  const struct no_os_dac_update *upd, uint32_t nb)
+{
+	uint8_t fs, d, *frame;
+	uint32_t chain, nb_frames = 0, i, r;
+	int ret;
+
+	if (!desc || (nb && !upd) || nb > desc->max_updates)
+		return -EINVAL;
+
+	if (!nb)
+		return 0;
+
+	fs = desc->ops->frame_size;
+	chain = desc->nb_devs * fs;
+	memset(desc->cnt, 0, desc->nb_devs * sizeof(*desc->cnt));
+
+	for (i = 0; i < nb; i++) {
+		d = upd[i].dev;
+		if (d >= desc->nb_devs)
+			return -EINVAL;
+
+		r = desc->cnt[d]++;
+		frame = desc->buf + r * chain + (desc->nb_devs - 1 - d) * fs;
+		ret = desc->ops->pack_write(desc->devs[d], upd[i].ch,
+					    upd[i].code, frame);
+		if (ret)
+			return ret;
+
+		nb_frames = no_os_max(nb_frames, r + 1);
+	}
+
+	for (d = 0; d < desc->nb_devs; d++) {
+		for (r = desc->cnt[d]; r < nb_frames; r++) {
+			frame = desc->buf + r * chain +
+				(desc->nb_devs - 1 - d) * fs;
+			ret = no_os_dac_batch_pad(desc, d, frame);
+			if (ret)
+				return ret;
+		}
+	}
+
+	if (!desc->ldac && desc->ops->pack_update) {
+		for (d = 0; d < desc->nb_devs; d++) {
+			frame = desc->buf + nb_frames * chain +
+				(desc->nb_devs - 1 - d) * fs;
+			ret = desc->ops->pack_update(desc->devs[d], frame);
+			if (ret)
+				return ret;
+		}
+		nb_frames++;
+	}
+
+	/* In place, as the no_os_spi_transfer() fallback requires */
+	for (r = 0; r < nb_frames; r++) {
+		desc->msgs[r] = (struct no_os_spi_msg) {
+			.tx_buff = desc->buf + r * chain,
+			.rx_buff = desc->buf + r * chain,
+			.bytes_number = chain,
+			.cs_change = 1,
+		};
+	}
+
+	ret = no_os_spi_transfer(desc->spi, desc->msgs, nb_frames);
+	if (ret || !desc->ldac)
+		return ret;
+
+	ret = no_os_gpio_set_value(desc->ldac, NO_OS_GPIO_LOW);
+	if (ret)
+		return ret;
+
+	return no_os_gpio_set_value(desc->ldac, NO_OS_GPIO_HIGH);
+}
+
+/**
+ * @brief Play a sample matrix, one batch write per row.
+ *
+ * Row n is written once the timer reaches n / rate_hz. Rows written more than
+ * one period after their slot are counted in desc->nb_late. Without a timer
+ * the rows are written back to back.
+ * @param desc - Batch descriptor.
+ * @param chans - Device and channel of each column, the codes are ignored.
+ * @param nb_chans - Number of columns, at most max_updates.
+ * @param samples - nb_rows x nb_chans codes, row major.
+ * @param nb_rows - Number of rows.
+ * @param timer - Timer reporting the elapsed time, may be NULL.
+ * @param rate_hz - Rows per second.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_dac_batch_play(struct no_os_dac_batch_desc *desc,
+			 const struct no_os_dac_update *chans,
+			 uint32_t nb_chans, const uint32_t *samples,
+			 uint32_t nb_rows, struct no_os_timer_desc *timer,
+			 uint32_t rate_hz)
+{
+	uint64_t slot, now, period = 0;
+	uint32_t r, i;
+	int ret = 0;
+
+	if (!desc || !chans || !samples || !nb_chans ||
+	    nb_chans > desc->max_updates || (timer && !rate_hz))
+		return -EINVAL;
+
+	desc->nb_late = 0;
+	memcpy(desc->row, chans, nb_chans * sizeof(*chans));
+
+	if (timer) {
+		period = NANO / rate_hz;
+		ret = no_os_timer_start(timer);
+		if (ret)
+			return ret;
+	}
+
+	for (r = 0; r < nb_rows; r++) {
+		for (i = 0; i < nb_chans; i++)
+			desc->row[i].code = samples[r * nb_chans + i];
+
+		if (timer) {
+			slot = (uint64_t)r * NANO / rate_hz;
+			do {
+				ret = no_os_timer_get_elapsed_time_nsec(timer,
+									&now);
+				if (ret)
+					goto stop;
+			} while (now < slot);
+
+			if (now - slot >= period)
+				desc->nb_late++;
+		}
+
+		ret = no_os_dac_batch_write(desc, desc->row, nb_chans);
+		if (ret)
+			break;
+	}
+
+stop:
+	if (timer)
+		no_os_timer_stop(timer);
+
+	return ret;
+}
+
+/**
+ * @brief Free the resources allocated by no_os_dac_batch_init().
+ * @param desc - Batch descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_dac_batch_remove(struct no_os_dac_batch_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	no_os_free(desc->row);
+	no_os_free(desc->msgs);
+	no_os_free(desc->buf);
+	no_os_free(desc->cnt);
+	no_os_free(desc);
+
+	return 0;
+}
@@ -0,0 +1,480 @@
+/***************************************************************************//**
+ *   @file   no_os_dds.c
+ *   @brief  Direct digital synthesis (DDS) waveform generator.
+ *   @author Analog Devices Inc.
+********************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <errno.h>
+#include <string.h>
+#include "no_os_dds.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+
+#ifdef IIO_SUPPORT
+#include "iio.h"
+#endif
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/* Samples generated per pass over the tones */
+#define NO_OS_DDS_BLOCK		64
+
+/*
+ * Phase word layout: bits 31..23 index the sine table, bits 22..9 are the
+ * interpolation fraction, the remaining bits only accumulate.
+ */
+#define NO_OS_DDS_IDX_SHIFT	23
+#define NO_OS_DDS_FRAC_SHIFT	9
+#define NO_OS_DDS_FRAC_BITS	14
+#define NO_OS_DDS_FRAC_MASK	((1 << NO_OS_DDS_FRAC_BITS) - 1)
+#define NO_OS_DDS_FRAC_ROUND	(1 << (NO_OS_DDS_FRAC_BITS - 1))
+#define NO_OS_DDS_AMP_ROUND	(1 << 14)
+
+/*
+ * Sine table in two's complement, one word per entry: sample in the low half,
+ * difference to the next sample in the high half.
+ */
+static uint32_t no_os_dds_lut[512];
+static bool no_os_dds_lut_ready;
+
+/**
+ * @brief Build the interpolation table from no_os_sine_lut_16.
+ */
+static void no_os_dds_lut_init(void)
+{
+	uint32_t i, n = NO_OS_ARRAY_SIZE(no_os_dds_lut);
+	int32_t s0, s1;
+
+	if (no_os_dds_lut_ready)
+		return;
+
+	for (i = 0; i < n; i++) {
+		s0 = (int32_t)no_os_sine_lut_16[i] - 0x8000;
+		s1 = (int32_t)no_os_sine_lut_16[(i + 1) % n] - 0x8000;
+		no_os_dds_lut[i] = (uint16_t)s0 |
+				   ((uint32_t)(uint16_t)(s1 - s0) << 16);
+	}
+
+	no_os_dds_lut_ready = true;
+}
+
+/**
+ * @brief Interpolated and scaled sine sample for a phase word.
+ * @param phase - Phase word.
+ * @param amplitude - Amplitude (Q15).
+ * @return Two's complement sample.
+ */
+static inline int32_t no_os_dds_sample(uint32_t phase, int32_t amplitude)
+{
+	uint32_t pair = no_os_dds_lut[phase >> NO_OS_DDS_IDX_SHIFT];
+	int32_t frac = (phase >> NO_OS_DDS_FRAC_SHIFT) & NO_OS_DDS_FRAC_MASK;
+	int32_t y;
+
+	y = ((int16_t)pair * (1 << NO_OS_DDS_FRAC_BITS) +
+	     (int16_t)(pair >> 16) * frac + NO_OS_DDS_FRAC_ROUND) >>
+	    NO_OS_DDS_FRAC_BITS;
+
+	return (y * amplitude + NO_OS_DDS_AMP_ROUND) >> 15;
+}
+
+/**
+ * @brief Add n samples of a fixed frequency tone to the accumulator.
+ * @param tone - Tone state, the phase is advanced by n samples.
+ * @param acc - Accumulator.
+ * @param n - Number of samples.
+ */
+static void no_os_dds_tone_acc(struct no_os_dds_tone *tone, int32_t *acc,
+			       uint32_t n)
+{
+	uint32_t phase = tone->phase;
+	uint32_t ftw = tone->ftw;
+	uint32_t i = 0;
+#if defined(__ARM_NEON)
+	static const uint32_t ramp[4] = {0, 1, 2, 3};
+	uint32x4_t ph = vmlaq_n_u32(vdupq_n_u32(phase), vld1q_u32(ramp), ftw);
+	uint32x4_t step = vdupq_n_u32(4 * ftw);
+	int32x4_t fmask = vdupq_n_s32(NO_OS_DDS_FRAC_MASK);
+	int32x4_t frac_round = vdupq_n_s32(NO_OS_DDS_FRAC_ROUND);
+	int32x4_t amp_round = vdupq_n_s32(NO_OS_DDS_AMP_ROUND);
+	int32x4_t pair, frac, s0, delta, y;
+	uint32_t ix[4], pr[4];
+
+	for (; i + 4 <= n; i += 4) {
+		frac = vreinterpretq_s32_u32(vshrq_n_u32(ph,
+					     NO_OS_DDS_FRAC_SHIFT));
+		frac = vandq_s32(frac, fmask);
+		vst1q_u32(ix, vshrq_n_u32(ph, NO_OS_DDS_IDX_SHIFT));
+		pr[0] = no_os_dds_lut[ix[0]];
+		pr[1] = no_os_dds_lut[ix[1]];
+		pr[2] = no_os_dds_lut[ix[2]];
+		pr[3] = no_os_dds_lut[ix[3]];
+		pair = vreinterpretq_s32_u32(vld1q_u32(pr));
+		s0 = vshrq_n_s32(vshlq_n_s32(pair, 16), 16);
+		delta = vshrq_n_s32(pair, 16);
+		y = vshlq_n_s32(s0, NO_OS_DDS_FRAC_BITS);
+		y = vmlaq_s32(y, delta, frac);
+		y = vshrq_n_s32(vaddq_s32(y, frac_round), NO_OS_DDS_FRAC_BITS);
+		y = vmlaq_n_s32(amp_round, y, tone->amplitude);
+		y = vshrq_n_s32(y, 15);
+		vst1q_s32(acc + i, vaddq_s32(vld1q_s32(acc + i), y));
+		ph = vaddq_u32(ph, step);
+	}
+	phase += i * ftw;
+#elif defined(__SSE2__)
+	__m128i ph = _mm_setr_epi32(phase, phase + ftw, phase + 2 * ftw,
+				    phase + 3 * ftw);
+	__m128i step = _mm_set1_epi32(4 * ftw);
+	__m128i fmask = _mm_set1_epi32(NO_OS_DDS_FRAC_MASK);
+	__m128i unity = _mm_set1_epi32(1 << NO_OS_DDS_FRAC_BITS);
+	__m128i amp = _mm_set1_epi32(tone->amplitude);
+	__m128i frac_round = _mm_set1_epi32(NO_OS_DDS_FRAC_ROUND);
+	__m128i amp_round = _mm_set1_epi32(NO_OS_DDS_AMP_ROUND);
+	__m128i pair, frac, y, sum;
+	uint32_t ix[4];
+
+	for (; i + 4 <= n; i += 4) {
+		frac = _mm_srli_epi32(ph, NO_OS_DDS_FRAC_SHIFT);
+		frac = _mm_and_si128(frac, fmask);
+		_mm_storeu_si128((__m128i *)ix,
+				 _mm_srli_epi32(ph, NO_OS_DDS_IDX_SHIFT));
+		pair = _mm_setr_epi32(no_os_dds_lut[ix[0]],
+				      no_os_dds_lut[ix[1]],
+				      no_os_dds_lut[ix[2]],
+				      no_os_dds_lut[ix[3]]);
+		/* s0 * 2^14 + delta * frac, one 16-bit pair per lane */
+		y = _mm_or_si128(unity, _mm_slli_epi32(frac, 16));
+		y = _mm_madd_epi16(pair, y);
+		y = _mm_add_epi32(y, frac_round);
+		y = _mm_srai_epi32(y, NO_OS_DDS_FRAC_BITS);
+		/* y fits in the low half of each lane, amp zeroes the rest */
+		y = _mm_add_epi32(_mm_madd_epi16(y, amp), amp_round);
+		y = _mm_srai_epi32(y, 15);
+		sum = _mm_loadu_si128((__m128i *)(acc + i));
+		_mm_storeu_si128((__m128i *)(acc + i), _mm_add_epi32(sum, y));
+		ph = _mm_add_epi32(ph, step);
+	}
+	phase += i * ftw;
+#endif
+	for (; i < n; i++) {
+		acc[i] += no_os_dds_sample(phase, tone->amplitude);
+		phase += ftw;
+	}
+
+	tone->phase = phase;
+}
+
+/**
+ * @brief Add n samples of a chirp to the accumulator.
+ * @param tone - Tone state, the phase and tuning word are advanced.
+ * @param acc - Accumulator.
+ * @param n - Number of samples.
+ */
+static void no_os_dds_chirp_acc(struct no_os_dds_tone *tone, int32_t *acc,
+				uint32_t n)
+{
+	uint32_t phase = tone->phase;
+	uint32_t ftw = tone->ftw;
+	uint32_t pos = tone->chirp_pos;
+	uint32_t i;
+
+	for (i = 0; i < n; i++) {
+		acc[i] += no_os_dds_sample(phase, tone->amplitude);
+		phase += ftw;
+
+		if (++pos == tone->chirp_len) {
+			pos = 0;
+			ftw = tone->ftw_start;
+		} else {
+			ftw += tone->chirp_step;
+		}
+	}
+
+	tone->phase = phase;
+	tone->ftw = ftw;
+	tone->chirp_pos = pos;
+}
+
+/**
+ * @brief Saturate and store the accumulated samples.
+ * @param format - Output sample coding.
+ * @param acc - Accumulator.
+ * @param buff - Output buffer.
+ * @param n - Number of samples.
+ * @param stride - Distance between two output samples, in samples.
+ */
+static void no_os_dds_store(enum no_os_dds_format format, const int32_t *acc,
+			    uint16_t *buff, uint32_t n, uint32_t stride)
+{
+	uint16_t flip = format == NO_OS_DDS_OFFSET_BINARY ? 0x8000 : 0;
+	uint32_t i = 0;
+
+	if (stride == 1) {
+#if defined(__ARM_NEON)
+		uint16x8_t vflip = vdupq_n_u16(flip);
+		int16x8_t s;
+
+		for (; i + 8 <= n; i += 8) {
+			s = vcombine_s16(vqmovn_s32(vld1q_s32(acc + i)),
+					 vqmovn_s32(vld1q_s32(acc + i + 4)));
+			vst1q_u16(buff + i,
+				  veorq_u16(vreinterpretq_u16_s16(s), vflip));
+		}
+#elif defined(__SSE2__)
+		__m128i vflip = _mm_set1_epi16((short)flip);
+		__m128i s;
+
+		for (; i + 8 <= n; i += 8) {
+			s = _mm_packs_epi32(
+				    _mm_loadu_si128((__m128i *)(acc + i)),
+				    _mm_loadu_si128((__m128i *)(acc + i + 4)));
+			_mm_storeu_si128((__m128i *)(buff + i),
+					 _mm_xor_si128(s, vflip));
+		}
+#endif
+	}
+
+	for (; i < n; i++)
+		buff[i * stride] = (uint16_t)no_os_clamp(acc[i], INT16_MIN,
+				   INT16_MAX) ^ flip;
+}
+
+/**
+ * @brief Allocate a DDS generator.
+ * @param desc - Generator descriptor.
+ * @param param - Initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_dds_init(struct no_os_dds_desc **desc,
+		   const struct no_os_dds_init_param *param)
+{
+	struct no_os_dds_desc *dds;
+
+	if (!desc || !param || !param->sample_rate)
+		return -EINVAL;
+
+	dds = no_os_calloc(1, sizeof(*dds));
+	if (!dds)
+		return -ENOMEM;
+
+	no_os_dds_lut_init();
+
+	dds->sample_rate = param->sample_rate;
+	dds->format = param->format;
+	*desc = dds;
+
+	return 0;
+}
+
+/**
+ * @brief Frequency tuning word for a frequency.
+ * @param desc - Generator descriptor.
+ * @param freq - Frequency in Hz.
+ * @return Tuning word.
+ */
+static uint32_t no_os_dds_ftw(struct no_os_dds_desc *desc, uint32_t freq)
+{
+	return ((uint64_t)freq << 32) / desc->sample_rate;
+}
+
+/**
+ * @brief Set a fixed frequency tone.
+ * @param desc - Generator descriptor.
+ * @param idx - Tone index.
+ * @param freq - Frequency in Hz, lower than the sample rate.
+ * @param amplitude - Amplitude (Q15), 0 disables the tone.
+ * @param phase - Initial phase word, see NO_OS_DDS_PHASE_DEG().
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_dds_set_tone(struct no_os_dds_desc *desc, uint8_t idx,
+		       uint32_t freq, uint16_t amplitude, uint32_t phase)
+{
+	struct no_os_dds_tone *tone;
+
+	if (!desc || idx >= NO_OS_DDS_MAX_TONES || freq >= desc->sample_rate ||
+	    amplitude > NO_OS_DDS_FULL_SCALE)
+		return -EINVAL;
+
+	tone = &desc->tone[idx];
+	memset(tone, 0, sizeof(*tone));
+	tone->phase = phase;
+	tone->ftw = no_os_dds_ftw(desc, freq);
+	tone->amplitude = amplitude;
+
+	return 0;
+}
+
+/**
+ * @brief Set a linear chirp. The frequency goes from f_start to f_stop in
+ * nb_samples samples, then starts over.
+ * @param desc - Generator descriptor.
+ * @param idx - Tone index.
+ * @param f_start - Start frequency in Hz, lower than the sample rate.
+ * @param f_stop - Stop frequency in Hz, lower than the sample rate.
+ * @param nb_samples - Sweep length in samples.
+ * @param amplitude - Amplitude (Q15), 0 disables the tone.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_dds_set_chirp(struct no_os_dds_desc *desc, uint8_t idx,
+			uint32_t f_start, uint32_t f_stop, uint32_t nb_samples,
+			uint16_t amplitude)
+{
+	struct no_os_dds_tone *tone;
+	int64_t span;
+
+	if (!desc || idx >= NO_OS_DDS_MAX_TONES || !nb_samples ||
+	    f_start >= desc->sample_rate || f_stop >= desc->sample_rate ||
+	    amplitude > NO_OS_DDS_FULL_SCALE)
+		return -EINVAL;
+
+	span = (int64_t)no_os_dds_ftw(desc, f_stop) -
+	       no_os_dds_ftw(desc, f_start);
+	span /= nb_samples;
+	if (!span || span > INT32_MAX || span < INT32_MIN)
+		return -EINVAL;
+
+	tone = &desc->tone[idx];
+	memset(tone, 0, sizeof(*tone));
+	tone->ftw_start = no_os_dds_ftw(desc, f_start);
+	tone->ftw = tone->ftw_start;
+	tone->chirp_step = span;
+	tone->chirp_len = nb_samples;
+	tone->amplitude = amplitude;
+
+	return 0;
+}
+
+/**
+ * @brief Generate samples. The enabled tones are summed and the result is
+ * saturated to 16 bits.
+ * @param desc - Generator descriptor.
+ * @param buff - Output buffer.
+ * @param nb_samples - Number of samples to generate.
+ * @param stride - Distance between two output samples, in samples. Use the
+ * number of channels to write one channel of an interleaved buffer.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_dds_fill(struct no_os_dds_desc *desc, uint16_t *buff,
+		   uint32_t nb_samples, uint32_t stride)
+{
+	int32_t acc[NO_OS_DDS_BLOCK];
+	struct no_os_dds_tone *tone;
+	uint32_t i, n;
+
+	if (!desc || !buff || !stride)
+		return -EINVAL;
+
+	while (nb_samples) {
+		n = no_os_min(nb_samples, NO_OS_DDS_BLOCK);
+		memset(acc, 0, n * sizeof(*acc));
+
+		for (i = 0; i < NO_OS_DDS_MAX_TONES; i++) {
+			tone = &desc->tone[i];
+			if (!tone->amplitude)
+				continue;
+
+			if (tone->chirp_step)
+				no_os_dds_chirp_acc(tone, acc, n);
+			else
+				no_os_dds_tone_acc(tone, acc, n);
+		}
+
+		no_os_dds_store(desc->format, acc, buff, n, stride);
+		buff += n * stride;
+		nb_samples -= n;
+	}
+
+	return 0;
+}
+
+#ifdef IIO_SUPPORT
+/**
+ * @brief Fill one block of an iio buffer with 16-bit samples.
+ *
+ * An input buffer gets the block read by the client, as from an ADC. An
+ * output buffer gets the block the DAC path takes next with
+ * iio_buffer_get_block(), in place of data pushed by the client.
+ * @param desc - Generators indexed by channel number. Only the entries of the
+ * active channels are used.
+ * @param buffer - iio buffer.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_dds_fill_iio_buffer(struct no_os_dds_desc **desc,
+			      struct iio_buffer *buffer)
+{
+	uint32_t nb_ch, nb_scans, mask, ch, size, k = 0;
+	uint16_t *block;
+	int ret, done;
+
+	if (!desc || !buffer)
+		return -EINVAL;
+
+	nb_ch = no_os_hweight32(buffer->active_mask);
+	if (!nb_ch || buffer->bytes_per_scan != nb_ch * sizeof(*block))
+		return -EINVAL;
+
+	/* The generated block is written on the producer side of the buffer. */
+	ret = no_os_cb_prepare_async_write(buffer->buf, buffer->size,
+					   (void **)&block, &size);
+	if (ret)
+		return ret;
+
+	nb_scans = size / buffer->bytes_per_scan;
+	for (mask = buffer->active_mask, ch = 0; mask; mask >>= 1, ch++) {
+		if (!(mask & 1))
+			continue;
+
+		ret = no_os_dds_fill(desc[ch], block + k++, nb_scans, nb_ch);
+		if (ret)
+			break;
+	}
+
+	done = no_os_cb_end_async_write(buffer->buf);
+
+	return ret ? ret : done;
+}
+#endif
+
+/**
+ * @brief Free the resources allocated by no_os_dds_init().
+ * @param desc - Generator descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_dds_remove(struct no_os_dds_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	no_os_free(desc);
+
+	return 0;
+}
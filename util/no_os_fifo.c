@@ -36,6 +36,7 @@
 #include "no_os_fifo.h"
 #include "no_os_error.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
 
 /**
  * @brief Create new fifo element
@@ -124,3 +125,177 @@ struct no_os_fifo_element * no_os_fifo_remove(struct no_os_fifo_element *p_fifo)
 
 	return p_fifo;
 }
+
+/**
+ * @brief Configure a ring-backed fifo over caller provided storage.
+ *
+ * No memory is allocated, which makes this suitable for descriptors that
+ * embed both the fifo and its storage.
+ *
+ * @param fifo - Fifo to be configured.
+ * @param buff - Ring storage.
+ * @param size - Size of the storage in bytes, must be a power of two.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_fifo_ring_cfg(struct no_os_fifo *fifo, uint8_t *buff, uint32_t size)
+{
+	if (!fifo || !buff || !size || (size & (size - 1)))
+		return -EINVAL;
+
+	memset(fifo, 0, sizeof(*fifo));
+	fifo->buff = buff;
+	fifo->size = size;
+
+	return 0;
+}
+
+/**
+ * @brief Allocate a ring-backed fifo.
+ *
+ * All the memory is allocated here, inserting and draining data never
+ * allocates.
+ *
+ * @param fifo - Where to store the fifo reference.
+ * @param size - Size of the storage in bytes, must be a power of two.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_fifo_ring_init(struct no_os_fifo **fifo, uint32_t size)
+{
+	struct no_os_fifo *f;
+	uint8_t *buff;
+	int ret;
+
+	if (!fifo)
+		return -EINVAL;
+
+	f = no_os_calloc(1, sizeof(*f));
+	if (!f)
+		return -ENOMEM;
+
+	buff = no_os_calloc(1, size);
+	if (!buff) {
+		ret = -ENOMEM;
+		goto free_fifo;
+	}
+
+	ret = no_os_fifo_ring_cfg(f, buff, size);
+	if (ret)
+		goto free_buff;
+
+	f->own_buff = true;
+	*fifo = f;
+
+	return 0;
+
+free_buff:
+	no_os_free(buff);
+free_fifo:
+	no_os_free(f);
+
+	return ret;
+}
+
+/**
+ * @brief Free the resources allocated by no_os_fifo_ring_init().
+ * @param fifo - Ring-backed fifo.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_fifo_ring_remove(struct no_os_fifo *fifo)
+{
+	if (!fifo)
+		return -EINVAL;
+
+	if (fifo->own_buff) {
+		no_os_free(fifo->buff);
+		no_os_free(fifo);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Append data to the fifo tail.
+ *
+ * Bytes that do not fit are dropped and accounted in the overflow counters,
+ * data already in the fifo is never overwritten.
+ *
+ * @param fifo - Ring-backed fifo.
+ * @param data - Data to be appended.
+ * @param len - Number of bytes to append.
+ * @return Number of bytes stored in the fifo.
+ */
+uint32_t no_os_fifo_ring_write(struct no_os_fifo *fifo, const uint8_t *data,
+			       uint32_t len)
+{
+	uint32_t head, idx, n, first;
+
+	if (!fifo || !data || !len)
+		return 0;
+
+	n = no_os_min(len, no_os_fifo_ring_space(fifo));
+	if (n < len) {
+		fifo->overflows++;
+		fifo->dropped += len - n;
+	}
+	if (!n)
+		return 0;
+
+	head = fifo->head;
+	idx = head & (fifo->size - 1);
+	first = no_os_min(n, fifo->size - idx);
+	memcpy(fifo->buff + idx, data, first);
+	memcpy(fifo->buff, data + first, n - first);
+
+	/* Publish the data only after it has been copied. */
+	__sync_synchronize();
+	fifo->head = head + n;
+
+	return n;
+}
+
+/**
+ * @brief Drain data from the fifo head into the caller's buffer.
+ * @param fifo - Ring-backed fifo.
+ * @param data - Destination buffer.
+ * @param len - Maximum number of bytes to read.
+ * @return Number of bytes copied, 0 if the fifo is empty.
+ */
+uint32_t no_os_fifo_ring_read(struct no_os_fifo *fifo, uint8_t *data,
+			      uint32_t len)
+{
+	uint32_t tail, idx, n, first;
+
+	if (!fifo || !data || !len)
+		return 0;
+
+	n = no_os_min(len, no_os_fifo_ring_level(fifo));
+	if (!n)
+		return 0;
+
+	tail = fifo->tail;
+	idx = tail & (fifo->size - 1);
+	first = no_os_min(n, fifo->size - idx);
+	memcpy(data, fifo->buff + idx, first);
+	memcpy(data + first, fifo->buff, n - first);
+
+	/* Release the space only after the data has been copied out. */
+	__sync_synchronize();
+	fifo->tail = tail + n;
+
+	return n;
+}
+
+/**
+ * @brief Discard all data currently in the fifo.
+ *
+ * Must be called from the consumer side. Overflow counters are kept.
+ *
+ * @param fifo - Ring-backed fifo.
+ */
+void no_os_fifo_ring_flush(struct no_os_fifo *fifo)
+{
+	if (!fifo)
+		return;
+
+	fifo->tail = fifo->head;
+}
@@ -35,6 +35,15 @@
 #include "no_os_alloc.h"
 #include "no_os_print_log.h"
 
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/* Controllers handled by one vector kernel iteration */
+#define NO_OS_PID_BANK_LANES	4
+
 struct no_os_pid {
 	int iacc; // integral accumulator
 	int dacc; // derivative accumulator
@@ -200,3 +209,378 @@ int no_os_pid_remove(struct no_os_pid *pid)
 
 	return 0;
 }
+
+struct no_os_pid_bank {
+	unsigned int nb_pids;
+	/* configuration, one entry per controller */
+	uint32_t *Kp;
+	uint32_t *Ki;
+	uint32_t *Kd;
+	uint32_t *hysteresis;
+	int32_t *i_high;
+	int32_t *i_low;
+	int32_t *o_high;
+	int32_t *o_low;
+	/* state, one entry per controller */
+	int32_t *iacc;
+	int32_t *dacc;
+	int64_t *output;
+	/* per update scratch: control applied and p + i + d sum */
+	int32_t *active;
+	int64_t *sum;
+};
+
+/**
+ * @brief Initialize a bank of PID controllers
+ * @param bank - Double pointer to a PID bank descriptor that the function allocates
+ * @param config - Array of nb_pids PID configurations
+ * @param nb_pids - Number of controllers in the bank
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ *  - -ENOMEM : Memory allocation failure
+ */
+int no_os_pid_bank_init(struct no_os_pid_bank **bank,
+			const struct no_os_pid_config *config,
+			unsigned int nb_pids)
+{
+	struct no_os_pid_bank *b;
+	unsigned int k;
+
+	if (!bank || !config || !nb_pids)
+		return -EINVAL;
+
+	for (k = 0; k < nb_pids; k++)
+		if (config[k].output_clip.high < config[k].output_clip.low)
+			return -EINVAL;
+
+	/* Descriptor, 2 64-bit arrays and 11 32-bit arrays in one block */
+	b = no_os_calloc(1, sizeof(*b) + nb_pids * (2 * sizeof(int64_t) +
+			 11 * sizeof(int32_t)));
+	if (!b)
+		return -ENOMEM;
+
+	b->nb_pids = nb_pids;
+	b->output = (int64_t *)(b + 1);
+	b->sum = b->output + nb_pids;
+	b->Kp = (uint32_t *)(b->sum + nb_pids);
+	b->Ki = b->Kp + nb_pids;
+	b->Kd = b->Ki + nb_pids;
+	b->hysteresis = b->Kd + nb_pids;
+	b->i_high = (int32_t *)(b->hysteresis + nb_pids);
+	b->i_low = b->i_high + nb_pids;
+	b->o_high = b->i_low + nb_pids;
+	b->o_low = b->o_high + nb_pids;
+	b->iacc = b->o_low + nb_pids;
+	b->dacc = b->iacc + nb_pids;
+	b->active = b->dacc + nb_pids;
+
+	for (k = 0; k < nb_pids; k++) {
+		b->Kp[k] = config[k].Kp;
+		b->Ki[k] = config[k].Ki;
+		b->Kd[k] = config[k].Kd;
+		b->hysteresis[k] = config[k].hysteresis;
+		b->i_high[k] = config[k].i_clip.high;
+		b->i_low[k] = config[k].i_clip.low;
+		b->o_high[k] = config[k].output_clip.high;
+		b->o_low[k] = config[k].output_clip.low;
+		b->output[k] = config[k].initial;
+	}
+
+	*bank = b;
+
+	return 0;
+}
+
+/**
+ * @brief Scalar first stage of one bank controller: error, hysteresis,
+ * integrator clipping and the p + i + d sum, same arithmetic as
+ * no_os_pid_control().
+ * @param b - PID bank
+ * @param k - Controller index
+ * @param SP - Set-point
+ * @param PV - Process variable
+ */
+static void no_os_pid_bank_step(struct no_os_pid_bank *b, unsigned int k,
+				int SP, int PV)
+{
+	int err = SP - PV;
+	int64_t p, i, d;
+
+	b->active[k] = !(abs(err) < b->hysteresis[k]);
+	b->sum[k] = 0;
+	if (!b->active[k])
+		return;
+
+	p = (int64_t)b->Kp[k] * err;
+
+	if (b->i_high[k] > b->i_low[k]) {
+		if (b->iacc[k] > b->i_high[k])
+			b->iacc[k] = b->i_high[k];
+		else if (b->iacc[k] < b->i_low[k])
+			b->iacc[k] = b->i_low[k];
+	}
+
+	i = (int64_t)b->Ki[k] * b->iacc[k];
+	d = (int64_t)b->Kd[k] * (b->dacc[k] - err);
+
+	b->sum[k] = p + i + d;
+	b->iacc[k] += err;
+	b->dacc[k] = err;
+}
+
+#if defined(__ARM_NEON)
+/*
+ * (int64_t)gain * x for an unsigned 32-bit gain and a signed 32-bit x:
+ * the unsigned widening product is off by gain << 32 when x is negative.
+ */
+static inline int64x2_t no_os_pid_mul_us(uint32x2_t gain, int32x2_t x)
+{
+	uint64x2_t prod = vmull_u32(gain, vreinterpret_u32_s32(x));
+	uint64x2_t corr = vshlq_n_u64(vmovl_u32(gain), 32);
+	uint64x2_t neg = vreinterpretq_u64_s64(vmovl_s32(vshr_n_s32(x, 31)));
+
+	return vreinterpretq_s64_u64(vsubq_u64(prod, vandq_u64(corr, neg)));
+}
+
+/**
+ * @brief First stage for NO_OS_PID_BANK_LANES controllers starting at index k (NEON).
+ */
+static void no_os_pid_bank_kernel(struct no_os_pid_bank *b, unsigned int k,
+				  const int *SP, const int *PV)
+{
+	int32x4_t err, iacc, iclip, dacc, dd;
+	uint32x4_t active, ien, kp, ki, kd;
+	uint32x2_t any;
+	int64x2_t lo, hi;
+
+	err = vsubq_s32(vld1q_s32((const int32_t *)&SP[k]),
+			vld1q_s32((const int32_t *)&PV[k]));
+
+	/* abs() of INT_MIN stays INT_MIN, which compares as 2^31 unsigned */
+	active = vmvnq_u32(vcltq_u32(vreinterpretq_u32_s32(vabsq_s32(err)),
+				     vld1q_u32(&b->hysteresis[k])));
+	vst1q_s32(&b->active[k], vreinterpretq_s32_u32(active));
+	any = vorr_u32(vget_low_u32(active), vget_high_u32(active));
+	if (!(vget_lane_u32(any, 0) | vget_lane_u32(any, 1)))
+		return;
+
+	iacc = vld1q_s32(&b->iacc[k]);
+	ien = vcgtq_s32(vld1q_s32(&b->i_high[k]), vld1q_s32(&b->i_low[k]));
+	iclip = vminq_s32(vmaxq_s32(iacc, vld1q_s32(&b->i_low[k])),
+			  vld1q_s32(&b->i_high[k]));
+	iacc = vbslq_s32(vandq_u32(ien, active), iclip, iacc);
+
+	dacc = vld1q_s32(&b->dacc[k]);
+	dd = vsubq_s32(dacc, err);
+
+	kp = vld1q_u32(&b->Kp[k]);
+	ki = vld1q_u32(&b->Ki[k]);
+	kd = vld1q_u32(&b->Kd[k]);
+
+	lo = vaddq_s64(vaddq_s64(no_os_pid_mul_us(vget_low_u32(kp), vget_low_s32(err)),
+				 no_os_pid_mul_us(vget_low_u32(ki), vget_low_s32(iacc))),
+		       no_os_pid_mul_us(vget_low_u32(kd), vget_low_s32(dd)));
+	hi = vaddq_s64(vaddq_s64(no_os_pid_mul_us(vget_high_u32(kp), vget_high_s32(err)),
+				 no_os_pid_mul_us(vget_high_u32(ki), vget_high_s32(iacc))),
+		       no_os_pid_mul_us(vget_high_u32(kd), vget_high_s32(dd)));
+	vst1q_s64(&b->sum[k], lo);
+	vst1q_s64(&b->sum[k + 2], hi);
+
+	vst1q_s32(&b->iacc[k], vbslq_s32(active, vaddq_s32(iacc, err), iacc));
+	vst1q_s32(&b->dacc[k], vbslq_s32(active, err, dacc));
+}
+#elif defined(__SSE2__)
+/* Bitwise select: mask ? a : b */
+static inline __m128i no_os_pid_sel(__m128i mask, __m128i a, __m128i b)
+{
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+/*
+ * (int64_t)gain * x for the even 32-bit lanes of an unsigned gain and a
+ * signed x: the unsigned widening product is off by gain << 32 when x is
+ * negative.
+ */
+static inline __m128i no_os_pid_mul_us(__m128i gain, __m128i x)
+{
+	__m128i neg = _mm_shuffle_epi32(_mm_srai_epi32(x, 31),
+					_MM_SHUFFLE(2, 2, 0, 0));
+
+	return _mm_sub_epi64(_mm_mul_epu32(gain, x),
+			     _mm_and_si128(_mm_slli_epi64(gain, 32), neg));
+}
+
+/**
+ * @brief First stage for NO_OS_PID_BANK_LANES controllers starting at index k (SSE2).
+ */
+static void no_os_pid_bank_kernel(struct no_os_pid_bank *b, unsigned int k,
+				  const int *SP, const int *PV)
+{
+	const __m128i bias = _mm_set1_epi32((int)0x80000000);
+	__m128i err, sign, aerr, active, iacc, ihi, ilo, ien, iclip, dacc, dd;
+	__m128i kp, ki, kd, even, odd;
+
+	err = _mm_sub_epi32(_mm_loadu_si128((const __m128i *)&SP[k]),
+			    _mm_loadu_si128((const __m128i *)&PV[k]));
+
+	/* abs() of INT_MIN stays INT_MIN, which compares as 2^31 unsigned */
+	sign = _mm_srai_epi32(err, 31);
+	aerr = _mm_sub_epi32(_mm_xor_si128(err, sign), sign);
+	active = _mm_cmpgt_epi32(_mm_xor_si128(_mm_loadu_si128(
+			(const __m128i *)&b->hysteresis[k]), bias),
+				 _mm_xor_si128(aerr, bias));
+	active = _mm_xor_si128(active, _mm_set1_epi32(-1));
+	_mm_storeu_si128((__m128i *)&b->active[k], active);
+	if (!_mm_movemask_ps(_mm_castsi128_ps(active)))
+		return;
+
+	iacc = _mm_loadu_si128((const __m128i *)&b->iacc[k]);
+	ihi = _mm_loadu_si128((const __m128i *)&b->i_high[k]);
+	ilo = _mm_loadu_si128((const __m128i *)&b->i_low[k]);
+	ien = _mm_and_si128(_mm_cmpgt_epi32(ihi, ilo), active);
+	iclip = no_os_pid_sel(_mm_cmpgt_epi32(iacc, ihi), ihi,
+			      no_os_pid_sel(_mm_cmplt_epi32(iacc, ilo), ilo, iacc));
+	iacc = no_os_pid_sel(ien, iclip, iacc);
+
+	dacc = _mm_loadu_si128((const __m128i *)&b->dacc[k]);
+	dd = _mm_sub_epi32(dacc, err);
+
+	kp = _mm_loadu_si128((const __m128i *)&b->Kp[k]);
+	ki = _mm_loadu_si128((const __m128i *)&b->Ki[k]);
+	kd = _mm_loadu_si128((const __m128i *)&b->Kd[k]);
+
+	/* lanes 0 and 2 */
+	even = _mm_add_epi64(_mm_add_epi64(no_os_pid_mul_us(kp, err),
+					   no_os_pid_mul_us(ki, iacc)),
+			     no_os_pid_mul_us(kd, dd));
+	/* lanes 1 and 3 */
+	odd = _mm_add_epi64(_mm_add_epi64(
+				    no_os_pid_mul_us(_mm_srli_epi64(kp, 32), _mm_srli_epi64(err, 32)),
+				    no_os_pid_mul_us(_mm_srli_epi64(ki, 32), _mm_srli_epi64(iacc, 32))),
+			    no_os_pid_mul_us(_mm_srli_epi64(kd, 32), _mm_srli_epi64(dd, 32)));
+	_mm_storeu_si128((__m128i *)&b->sum[k], _mm_unpacklo_epi64(even, odd));
+	_mm_storeu_si128((__m128i *)&b->sum[k + 2], _mm_unpackhi_epi64(even, odd));
+
+	_mm_storeu_si128((__m128i *)&b->iacc[k],
+			 no_os_pid_sel(active, _mm_add_epi32(iacc, err), iacc));
+	_mm_storeu_si128((__m128i *)&b->dacc[k], no_os_pid_sel(active, err, dacc));
+}
+#endif
+
+/**
+ * @brief Perform PID control on every controller of a bank.
+ *
+ * Equivalent to calling no_os_pid_control() for each controller, including
+ * the hysteresis and integrator clipping behavior.
+ *
+ * @param bank - PID bank created with no_os_pid_bank_init()
+ * @param SP - Array of set-points, one per controller
+ * @param PV - Array of process variables, one per controller
+ * @param output - Array where the outputs are stored, one per controller
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_pid_bank_control(struct no_os_pid_bank *bank, const int *SP,
+			   const int *PV, int *output)
+{
+	int64_t out, high, low;
+	unsigned int k = 0;
+
+	if (!bank || !SP || !PV || !output)
+		return -EINVAL;
+
+#if defined(__ARM_NEON) || defined(__SSE2__)
+	for (; k + NO_OS_PID_BANK_LANES <= bank->nb_pids; k += NO_OS_PID_BANK_LANES)
+		no_os_pid_bank_kernel(bank, k, SP, PV);
+#endif
+	for (; k < bank->nb_pids; k++)
+		no_os_pid_bank_step(bank, k, SP[k], PV[k]);
+
+	/* Output stage */
+	for (k = 0; k < bank->nb_pids; k++) {
+		/*
+		 * Controllers held by the hysteresis keep their output as is,
+		 * without clipping, like no_os_pid_control().
+		 */
+		if (!bank->active[k]) {
+			output[k] = bank->output[k];
+			continue;
+		}
+
+		out = (bank->output[k] * 1000000 - bank->sum[k]) / 1000000;
+
+		/* With high > low this is the same as the if / else if clip */
+		high = bank->o_high[k];
+		low = bank->o_low[k];
+		if (high > low) {
+			out = out > high ? high : out;
+			out = out < low ? low : out;
+		}
+
+		bank->output[k] = out;
+		output[k] = out;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Change the hysteresis of one controller in the bank.
+ * @param bank - PID bank created with no_os_pid_bank_init()
+ * @param idx - Controller index
+ * @param hyst - The new hysteresis value
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_pid_bank_hysteresis(struct no_os_pid_bank *bank, unsigned int idx,
+			      unsigned int hyst)
+{
+	if (!bank || idx >= bank->nb_pids)
+		return -EINVAL;
+
+	bank->hysteresis[idx] = hyst;
+
+	return 0;
+}
+
+/**
+ * @brief Reset internal accumulators of every controller in the bank.
+ * @param bank - PID bank created with no_os_pid_bank_init()
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_pid_bank_reset(struct no_os_pid_bank *bank)
+{
+	unsigned int k;
+
+	if (!bank)
+		return -EINVAL;
+
+	for (k = 0; k < bank->nb_pids; k++) {
+		bank->iacc[k] = 0;
+		bank->dacc[k] = 0;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief De-initialize a PID bank by freeing the allocated memory
+ * @param bank - PID bank created with no_os_pid_bank_init()
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_pid_bank_remove(struct no_os_pid_bank *bank)
+{
+	if (!bank)
+		return -EINVAL;
+
+	no_os_free(bank);
+
+	return 0;
+}
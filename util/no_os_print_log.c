@@ -0,0 +1,510 @@
+/***************************************************************************//**
+ *   @file   no_os_print_log.c
+ *   @brief  Deferred, binary encoded logging backend.
+ *   @author Analog Devices Inc.
+********************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <string.h>
+#include "no_os_print_log.h"
+#include "no_os_util.h"
+
+#if defined(NO_OS_LOG_DEFERRED)
+
+#ifndef NO_OS_LOG_BUFF_WORDS
+#define NO_OS_LOG_BUFF_WORDS	1024
+#endif
+
+#if NO_OS_LOG_BUFF_WORDS & (NO_OS_LOG_BUFF_WORDS - 1)
+#error "NO_OS_LOG_BUFF_WORDS must be a power of two"
+#endif
+
+/* Longest record (header and format id included), in 32-bit words. */
+#define NO_OS_LOG_MAX_WORDS	64
+/* Strings are copied in the record, truncated to this many characters. */
+#define NO_OS_LOG_STR_MAX	32
+
+/*
+ * Record layout, all fields are 32-bit little endian words:
+ *	header:	magic[31:24] | level[23:16] | nb_words[15:0]
+ *	fmt:	offset of the format string in the no_os_log_fmt section
+ *	args:	1 word for int sized and char arguments,
+ *		2 words (low first) for long, long long, size_t, pointers and
+ *		doubles,
+ *		1 length word followed by the bytes for strings.
+ */
+#define NO_OS_LOG_MAGIC		0xA5u
+#define NO_OS_LOG_HDR(level, n)	((NO_OS_LOG_MAGIC << 24) | \
+				 (((level) & 0xFF) << 16) | ((n) & 0xFFFF))
+#define NO_OS_LOG_HDR_LEN(hdr)	((hdr) & 0xFFFF)
+
+/* Start of the format string table, provided by the linker. */
+extern const char __start_no_os_log_fmt[];
+
+/* Word ring shared by any number of producers and one consumer. */
+static struct {
+	uint32_t buff[NO_OS_LOG_BUFF_WORDS];
+	uint32_t head;
+	uint32_t tail;
+	uint32_t dropped;
+} no_os_log;
+
+enum no_os_log_arg {
+	NO_OS_LOG_ARG_NONE,
+	NO_OS_LOG_ARG_INT,
+	NO_OS_LOG_ARG_UINT,
+	NO_OS_LOG_ARG_LONG,
+	NO_OS_LOG_ARG_ULONG,
+	NO_OS_LOG_ARG_LLONG,
+	NO_OS_LOG_ARG_SIZE,
+	NO_OS_LOG_ARG_PTR,
+	NO_OS_LOG_ARG_DOUBLE,
+	NO_OS_LOG_ARG_STR,
+};
+
+/**
+ * @brief Parse a printf conversion specification.
+ * @param spec - Pointer to the character following '%'.
+ * @param stars - Number of '*' width/precision arguments.
+ * @return Pointer to the conversion character.
+ */
+static const char *no_os_log_spec_end(const char *spec, uint32_t *stars)
+{
+	*stars = 0;
+	while (*spec && strchr("-+ #0", *spec))
+		spec++;
+	if (*spec == '*') {
+		(*stars)++;
+		spec++;
+	}
+	while (*spec >= '0' && *spec <= '9')
+		spec++;
+	if (*spec == '.') {
+		spec++;
+		if (*spec == '*') {
+			(*stars)++;
+			spec++;
+		}
+		while (*spec >= '0' && *spec <= '9')
+			spec++;
+	}
+	while (*spec && strchr("hlLjzt", *spec))
+		spec++;
+
+	return spec;
+}
+
+/**
+ * @brief Get the type of the argument consumed by a conversion.
+ * @param spec - Pointer to the character following '%'.
+ * @param end - Pointer to the conversion character.
+ * @return Argument type.
+ */
+static enum no_os_log_arg no_os_log_spec_type(const char *spec,
+		const char *end)
+{
+	bool is_unsigned = strchr("uxXo", *end);
+	bool l = false, ll = false, z = false;
+
+	for (; spec < end; spec++) {
+		if (*spec == 'l') {
+			ll = l;
+			l = true;
+		} else if (*spec == 'j') {
+			ll = true;
+		} else if (*spec == 'z' || *spec == 't') {
+			z = true;
+		}
+	}
+
+	switch (*end) {
+	case 'd':
+	case 'i':
+	case 'u':
+	case 'x':
+	case 'X':
+	case 'o':
+		if (ll)
+			return NO_OS_LOG_ARG_LLONG;
+		if (z)
+			return NO_OS_LOG_ARG_SIZE;
+		if (l)
+			return is_unsigned ? NO_OS_LOG_ARG_ULONG : NO_OS_LOG_ARG_LONG;
+		return is_unsigned ? NO_OS_LOG_ARG_UINT : NO_OS_LOG_ARG_INT;
+	case 'c':
+		return NO_OS_LOG_ARG_INT;
+	case 'p':
+		return NO_OS_LOG_ARG_PTR;
+	case 'e':
+	case 'E':
+	case 'f':
+	case 'F':
+	case 'g':
+	case 'G':
+	case 'a':
+	case 'A':
+		return NO_OS_LOG_ARG_DOUBLE;
+	case 's':
+		return NO_OS_LOG_ARG_STR;
+	default:
+		return NO_OS_LOG_ARG_NONE;
+	}
+}
+
+/**
+ * @brief Store a 64-bit value as two words.
+ * @param w - Destination.
+ * @param val - Value to be stored.
+ */
+static inline void no_os_log_put64(uint32_t *w, uint64_t val)
+{
+	w[0] = (uint32_t)val;
+	w[1] = (uint32_t)(val >> 32);
+}
+
+/**
+ * @brief Record a log message in the deferred log ring.
+ *
+ * No formatting and no I/O happen here: the arguments are copied as raw words
+ * next to the format string id. Safe to call from interrupt context. When the
+ * ring is full the message is dropped and counted.
+ *
+ * @param level - Log level.
+ * @param fmt - Format string placed in the no_os_log_fmt section.
+ */
+void no_os_log_record(uint8_t level, const char *fmt, ...)
+{
+	uint32_t rec[NO_OS_LOG_MAX_WORDS];
+	uint32_t n = 2, i, stars, len, head, next;
+	enum no_os_log_arg type;
+	const char *p = fmt, *end;
+	const char *str;
+	union {
+		double d;
+		uint64_t u;
+	} dbl;
+	va_list ap;
+
+	rec[1] = (uint32_t)(fmt - __start_no_os_log_fmt);
+
+	va_start(ap, fmt);
+	while ((p = strchr(p, '%'))) {
+		if (p[1] == '%') {
+			p += 2;
+			continue;
+		}
+		end = no_os_log_spec_end(p + 1, &stars);
+		type = no_os_log_spec_type(p + 1, end);
+		p = *end ? end + 1 : end;
+
+		/* Worst case: stars, a string, or a 64-bit value. */
+		if (n + stars + 1 + NO_OS_DIV_ROUND_UP(NO_OS_LOG_STR_MAX, 4) >
+		    NO_OS_LOG_MAX_WORDS)
+			break;
+
+		for (i = 0; i < stars; i++)
+			rec[n++] = va_arg(ap, int);
+
+		switch (type) {
+		case NO_OS_LOG_ARG_INT:
+			rec[n++] = va_arg(ap, int);
+			break;
+		case NO_OS_LOG_ARG_UINT:
+			rec[n++] = va_arg(ap, unsigned int);
+			break;
+		case NO_OS_LOG_ARG_LONG:
+			no_os_log_put64(&rec[n], (int64_t)va_arg(ap, long));
+			n += 2;
+			break;
+		case NO_OS_LOG_ARG_ULONG:
+			no_os_log_put64(&rec[n], va_arg(ap, unsigned long));
+			n += 2;
+			break;
+		case NO_OS_LOG_ARG_LLONG:
+			no_os_log_put64(&rec[n], va_arg(ap, unsigned long long));
+			n += 2;
+			break;
+		case NO_OS_LOG_ARG_SIZE:
+			no_os_log_put64(&rec[n], va_arg(ap, size_t));
+			n += 2;
+			break;
+		case NO_OS_LOG_ARG_PTR:
+			no_os_log_put64(&rec[n], (uintptr_t)va_arg(ap, void *));
+			n += 2;
+			break;
+		case NO_OS_LOG_ARG_DOUBLE:
+			dbl.d = va_arg(ap, double);
+			no_os_log_put64(&rec[n], dbl.u);
+			n += 2;
+			break;
+		case NO_OS_LOG_ARG_STR:
+			str = va_arg(ap, const char *);
+			len = str ? strnlen(str, NO_OS_LOG_STR_MAX) : 0;
+			rec[n++] = len;
+			rec[n + len / 4] = 0;
+			if (len)
+				memcpy(&rec[n], str, len);
+			n += NO_OS_DIV_ROUND_UP(len, 4);
+			break;
+		default:
+			break;
+		}
+	}
+	va_end(ap);
+
+	rec[0] = NO_OS_LOG_HDR(level, n);
+
+	/* Reserve space, concurrent producers get disjoint slots. */
+	head = __atomic_load_n(&no_os_log.head, __ATOMIC_RELAXED);
+	do {
+		if (head + n - __atomic_load_n(&no_os_log.tail, __ATOMIC_ACQUIRE) >
+		    NO_OS_LOG_BUFF_WORDS) {
+			__atomic_fetch_add(&no_os_log.dropped, 1, __ATOMIC_RELAXED);
+			return;
+		}
+		next = head + n;
+	} while (!__atomic_compare_exchange_n(&no_os_log.head, &head, next, true,
+					      __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+	for (i = 1; i < n; i++)
+		no_os_log.buff[(head + i) & (NO_OS_LOG_BUFF_WORDS - 1)] = rec[i];
+
+	/* A non-zero header commits the record to the consumer. */
+	__atomic_store_n(&no_os_log.buff[head & (NO_OS_LOG_BUFF_WORDS - 1)], rec[0],
+			 __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Take the oldest committed record out of the ring.
+ * @param rec - Where to copy the record.
+ * @return Number of words in the record, 0 if there is nothing to read.
+ */
+static uint32_t no_os_log_pop(uint32_t *rec)
+{
+	uint32_t tail, hdr, n, i;
+
+	tail = no_os_log.tail;
+	if (tail == __atomic_load_n(&no_os_log.head, __ATOMIC_ACQUIRE))
+		return 0;
+
+	hdr = __atomic_load_n(&no_os_log.buff[tail & (NO_OS_LOG_BUFF_WORDS - 1)],
+			      __ATOMIC_ACQUIRE);
+	/* Space reserved but record not yet committed by its producer. */
+	if (!hdr)
+		return 0;
+
+	/*
+	 * Free space must read as zero: a producer reserves its slot before
+	 * writing the header, and any word of an older record could be taken
+	 * as a committed header meanwhile.
+	 */
+	n = NO_OS_LOG_HDR_LEN(hdr);
+	rec[0] = hdr;
+	no_os_log.buff[tail & (NO_OS_LOG_BUFF_WORDS - 1)] = 0;
+	for (i = 1; i < n; i++) {
+		rec[i] = no_os_log.buff[(tail + i) & (NO_OS_LOG_BUFF_WORDS - 1)];
+		no_os_log.buff[(tail + i) & (NO_OS_LOG_BUFF_WORDS - 1)] = 0;
+	}
+
+	__atomic_store_n(&no_os_log.tail, tail + n, __ATOMIC_RELEASE);
+
+	return n;
+}
+
+/**
+ * @brief Copy complete binary records out of the ring.
+ *
+ * The output is meant to be sent as is to a host and decoded there with
+ * tools/scripts/no_os_log_decode.py.
+ *
+ * @param words - Destination buffer.
+ * @param max_words - Size of the destination buffer, in words.
+ * @return Number of words copied.
+ */
+uint32_t no_os_log_read(uint32_t *words, uint32_t max_words)
+{
+	uint32_t hdr, cnt = 0;
+
+	if (!words)
+		return 0;
+
+	while (no_os_log.tail != __atomic_load_n(&no_os_log.head,
+			__ATOMIC_ACQUIRE)) {
+		hdr = __atomic_load_n(&no_os_log.buff[no_os_log.tail &
+				      (NO_OS_LOG_BUFF_WORDS - 1)], __ATOMIC_ACQUIRE);
+		if (!hdr || cnt + NO_OS_LOG_HDR_LEN(hdr) > max_words)
+			break;
+		cnt += no_os_log_pop(&words[cnt]);
+	}
+
+	return cnt;
+}
+
+/**
+ * @brief Format and print one pending record.
+ *
+ * Meant to be called from a low priority context (main loop, idle task).
+ * The format string is split at each conversion and every chunk is printed
+ * with its own argument.
+ *
+ * @return 1 if a record was printed, 0 if the ring was empty.
+ */
+int no_os_log_process(void)
+{
+	uint32_t rec[NO_OS_LOG_MAX_WORDS];
+	char chunk[NO_OS_LOG_STR_MAX + 16];
+	char str[NO_OS_LOG_STR_MAX + 1];
+	uint32_t n, w = 2, stars, len, i;
+	int32_t star[2];
+	const char *fmt, *p, *end;
+	enum no_os_log_arg type;
+	union {
+		double d;
+		uint64_t u;
+	} dbl;
+	uint64_t v;
+
+	n = no_os_log_pop(rec);
+	if (!n)
+		return 0;
+
+	fmt = __start_no_os_log_fmt + rec[1];
+	while (*fmt) {
+		p = strchr(fmt, '%');
+		if (!p) {
+			printf("%s", fmt);
+			break;
+		}
+		/* Literal text up to the conversion. */
+		printf("%.*s", (int)(p - fmt), fmt);
+		if (p[1] == '%') {
+			printf("%%");
+			fmt = p + 2;
+			continue;
+		}
+
+		end = no_os_log_spec_end(p + 1, &stars);
+		type = no_os_log_spec_type(p + 1, end);
+		fmt = *end ? end + 1 : end;
+
+		len = no_os_min((uint32_t)(fmt - p), sizeof(chunk) - 1);
+		memcpy(chunk, p, len);
+		chunk[len] = '\0';
+
+		for (i = 0; i < stars && w < n; i++)
+			star[i] = rec[w++];
+		if (type == NO_OS_LOG_ARG_NONE || w >= n)
+			continue;
+
+		if (type == NO_OS_LOG_ARG_STR) {
+			len = no_os_min(rec[w], (uint32_t)NO_OS_LOG_STR_MAX);
+			w++;
+			memcpy(str, &rec[w], len);
+			str[len] = '\0';
+			w += NO_OS_DIV_ROUND_UP(len, 4);
+			if (stars == 2)
+				printf(chunk, star[0], star[1], str);
+			else if (stars)
+				printf(chunk, star[0], str);
+			else
+				printf(chunk, str);
+			continue;
+		}
+
+		if (type == NO_OS_LOG_ARG_INT || type == NO_OS_LOG_ARG_UINT) {
+			v = rec[w++];
+		} else {
+			v = rec[w] | ((uint64_t)rec[w + 1] << 32);
+			w += 2;
+		}
+
+		switch (type) {
+		case NO_OS_LOG_ARG_DOUBLE:
+			dbl.u = v;
+			if (stars == 2)
+				printf(chunk, star[0], star[1], dbl.d);
+			else if (stars)
+				printf(chunk, star[0], dbl.d);
+			else
+				printf(chunk, dbl.d);
+			break;
+		case NO_OS_LOG_ARG_LONG:
+		case NO_OS_LOG_ARG_ULONG:
+			if (stars == 2)
+				printf(chunk, star[0], star[1], (long)v);
+			else if (stars)
+				printf(chunk, star[0], (long)v);
+			else
+				printf(chunk, (long)v);
+			break;
+		case NO_OS_LOG_ARG_LLONG:
+			if (stars == 2)
+				printf(chunk, star[0], star[1], (long long)v);
+			else if (stars)
+				printf(chunk, star[0], (long long)v);
+			else
+				printf(chunk, (long long)v);
+			break;
+		case NO_OS_LOG_ARG_SIZE:
+			if (stars == 2)
+				printf(chunk, star[0], star[1], (size_t)v);
+			else if (stars)
+				printf(chunk, star[0], (size_t)v);
+			else
+				printf(chunk, (size_t)v);
+			break;
+		case NO_OS_LOG_ARG_PTR:
+			printf(chunk, (void *)(uintptr_t)v);
+			break;
+		default:
+			if (stars == 2)
+				printf(chunk, star[0], star[1], (int)v);
+			else if (stars)
+				printf(chunk, star[0], (int)v);
+			else
+				printf(chunk, (int)v);
+			break;
+		}
+	}
+
+	return 1;
+}
+
+/**
+ * @brief Get the number of messages lost because the ring was full.
+ * @return Number of dropped messages.
+ */
+uint32_t no_os_log_dropped(void)
+{
+	return __atomic_load_n(&no_os_log.dropped, __ATOMIC_RELAXED);
+}
+
+#endif
@@ -0,0 +1,315 @@
+/***************************************************************************//**
+ *   @file   no_os_prof.c
+ *   @brief  Bring-up latency profiler.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "no_os_delay.h"
+#include "no_os_prof.h"
+
+#if defined(NO_OS_PROF)
+
+/* Number of call sites tracked, the rest only count in the totals */
+#define NO_OS_PROF_SITES	64
+/* Number of register blocks tracked for poll detection */
+#define NO_OS_PROF_BLOCKS	16
+
+/**
+ * @struct no_os_prof_last_read
+ * @brief Last register read from a register block.
+ */
+struct no_os_prof_last_read {
+	uint32_t base;
+	uint32_t offset;
+	uint64_t time_us;
+	uint8_t valid;
+};
+
+static const char *const no_os_prof_names[NO_OS_PROF_EVENT_MAX] = {
+	[NO_OS_PROF_DELAY] = "delay",
+	[NO_OS_PROF_POLL] = "poll",
+	[NO_OS_PROF_SPI] = "spi",
+	[NO_OS_PROF_AXI] = "axi",
+};
+
+static struct no_os_prof_stat totals[NO_OS_PROF_EVENT_MAX];
+static struct no_os_prof_stat sites[NO_OS_PROF_SITES];
+static uint32_t nb_sites;
+static struct no_os_prof_last_read last_read[NO_OS_PROF_BLOCKS];
+static uint32_t next_block;
+static char lock;
+
+/*
+ * The JESD204 FSM runs device ops from several threads, the lock only
+ * protects a few counter updates so a spinlock is enough and works the same
+ * with or without an OS.
+ */
+static void no_os_prof_lock(void)
+{
+	while (__atomic_test_and_set(&lock, __ATOMIC_ACQUIRE))
+		;
+}
+
+static void no_os_prof_unlock(void)
+{
+	__atomic_clear(&lock, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Add an event to its total and to its call site. Called locked.
+ * @param event - Kind of event.
+ * @param site - Call site.
+ * @param base - Register block (POLL).
+ * @param offset - Register offset (POLL).
+ * @param bytes - Bytes transferred.
+ * @param time_us - Duration of the event.
+ */
+static void no_os_prof_add(enum no_os_prof_event event, const void *site,
+			   uint32_t base, uint32_t offset, uint32_t bytes,
+			   uint64_t time_us)
+{
+	struct no_os_prof_stat *stat;
+	uint32_t i;
+
+	totals[event].count++;
+	totals[event].bytes += bytes;
+	totals[event].time_us += time_us;
+
+	for (i = 0; i < nb_sites; i++) {
+		stat = &sites[i];
+		if (stat->event != event)
+			continue;
+		/* Polls go through register accessors, the register is the key */
+		if (event == NO_OS_PROF_POLL ? stat->base == base &&
+		    stat->offset == offset : stat->site == site)
+			break;
+	}
+
+	if (i == nb_sites) {
+		if (nb_sites == NO_OS_PROF_SITES)
+			return;
+		stat = &sites[nb_sites++];
+		stat->event = event;
+		stat->site = site;
+		stat->base = base;
+		stat->offset = offset;
+	}
+
+	stat->count++;
+	stat->bytes += bytes;
+	stat->time_us += time_us;
+}
+
+/**
+ * @brief Get the current time, to be passed to no_os_prof_record().
+ * @return Time in microseconds.
+ */
+uint64_t no_os_prof_start(void)
+{
+	struct no_os_time t = no_os_get_time();
+
+	return (uint64_t)t.s * 1000000 + t.us;
+}
+
+/**
+ * @brief Account an event.
+ * @param event - Kind of event.
+ * @param site - Call site, usually NO_OS_PROF_SITE.
+ * @param start_us - Value returned by no_os_prof_start() before the event.
+ * @param bytes - Bytes transferred.
+ */
+void no_os_prof_record(enum no_os_prof_event event, const void *site,
+		       uint64_t start_us, uint32_t bytes)
+{
+	uint64_t now = no_os_prof_start();
+
+	if (event >= NO_OS_PROF_EVENT_MAX)
+		return;
+
+	no_os_prof_lock();
+	no_os_prof_add(event, site, 0, 0, bytes, now - start_us);
+	no_os_prof_unlock();
+}
+
+/**
+ * @brief Account a register access.
+ *
+ * Reading the same register of a block again, with no other access to that
+ * block in between, is taken as one more iteration of a polling loop and the
+ * time since the previous read is accounted to that register.
+ * @param site - Call site, usually NO_OS_PROF_SITE.
+ * @param start_us - Value returned by no_os_prof_start() before the access.
+ * @param base - Register block.
+ * @param offset - Register offset.
+ * @param write - true for a write access.
+ */
+void no_os_prof_axi(const void *site, uint64_t start_us, uint32_t base,
+		    uint32_t offset, bool write)
+{
+	uint64_t now = no_os_prof_start();
+	struct no_os_prof_last_read *last = NULL;
+	uint32_t i;
+
+	no_os_prof_lock();
+
+	no_os_prof_add(NO_OS_PROF_AXI, site, 0, 0, 4, now - start_us);
+
+	for (i = 0; i < NO_OS_PROF_BLOCKS; i++) {
+		if (last_read[i].valid && last_read[i].base == base) {
+			last = &last_read[i];
+			break;
+		}
+	}
+
+	if (!last) {
+		if (write)
+			goto out;
+		last = &last_read[next_block];
+		next_block = (next_block + 1) % NO_OS_PROF_BLOCKS;
+		last->base = base;
+	} else if (write) {
+		last->valid = 0;
+		goto out;
+	} else if (last->offset == offset) {
+		no_os_prof_add(NO_OS_PROF_POLL, site, base, offset, 0,
+			       now - last->time_us);
+	}
+
+	last->valid = 1;
+	last->offset = offset;
+	last->time_us = now;
+out:
+	no_os_prof_unlock();
+}
+
+/**
+ * @brief Get the total of an event kind.
+ * @param event - Kind of event.
+ * @param stat - Location where the total will be stored.
+ */
+void no_os_prof_get(enum no_os_prof_event event, struct no_os_prof_stat *stat)
+{
+	if (!stat || event >= NO_OS_PROF_EVENT_MAX)
+		return;
+
+	no_os_prof_lock();
+	*stat = totals[event];
+	no_os_prof_unlock();
+
+	stat->event = event;
+}
+
+/**
+ * @brief Get the call sites that took the most time, AXI accesses excluded.
+ * @param stats - Location where the sites will be stored, most expensive
+ * 		  first.
+ * @param max - Size of stats.
+ * @return Number of sites stored.
+ */
+uint32_t no_os_prof_top(struct no_os_prof_stat *stats, uint32_t max)
+{
+	struct no_os_prof_stat tmp;
+	uint32_t i, j, n = 0;
+
+	if (!stats)
+		return 0;
+
+	no_os_prof_lock();
+	for (i = 0; i < nb_sites; i++) {
+		if (sites[i].event == NO_OS_PROF_AXI)
+			continue;
+
+		tmp = sites[i];
+		for (j = n; j > 0 && stats[j - 1].time_us < tmp.time_us; j--)
+			if (j < max)
+				stats[j] = stats[j - 1];
+		if (j < max)
+			stats[j] = tmp;
+		if (n < max)
+			n++;
+	}
+	no_os_prof_unlock();
+
+	return n;
+}
+
+/**
+ * @brief Print the totals and the most expensive call sites.
+ *
+ * Polling loops are printed with the register they poll, the other sites
+ * with the return address of the instrumented call.
+ * @param max_sites - Number of call sites to be printed.
+ */
+void no_os_prof_report(uint32_t max_sites)
+{
+	struct no_os_prof_stat stat[NO_OS_PROF_SITES];
+	uint32_t i, n;
+
+	for (i = 0; i < NO_OS_PROF_EVENT_MAX; i++) {
+		no_os_prof_get(i, &stat[0]);
+		printf("prof: %-5s %8"PRIu32" events %8"PRIu64" bytes %10"PRIu64" us\n",
+		       no_os_prof_names[i], stat[0].count, stat[0].bytes,
+		       stat[0].time_us);
+	}
+
+	if (max_sites > NO_OS_PROF_SITES)
+		max_sites = NO_OS_PROF_SITES;
+
+	n = no_os_prof_top(stat, max_sites);
+	for (i = 0; i < n; i++) {
+		if (stat[i].event == NO_OS_PROF_POLL)
+			printf("prof: %10"PRIu64" us %-5s x%-6"PRIu32" reg 0x%08"PRIx32" + 0x%"PRIx32"\n",
+			       stat[i].time_us, no_os_prof_names[stat[i].event],
+			       stat[i].count, stat[i].base, stat[i].offset);
+		else
+			printf("prof: %10"PRIu64" us %-5s x%-6"PRIu32" at %p\n",
+			       stat[i].time_us, no_os_prof_names[stat[i].event],
+			       stat[i].count, stat[i].site);
+	}
+}
+
+/**
+ * @brief Clear all counters.
+ */
+void no_os_prof_reset(void)
+{
+	no_os_prof_lock();
+	memset(totals, 0, sizeof(totals));
+	memset(sites, 0, sizeof(sites));
+	memset(last_read, 0, sizeof(last_read));
+	nb_sites = 0;
+	next_block = 0;
+	no_os_prof_unlock();
+}
+
+#endif
@@ -0,0 +1,419 @@
+/***************************************************************************//**
+ *   @file   no_os_unpack.c
+ *   @brief  Unpacking of packed ADC sample words.
+ *   @author Analog Devices Inc.
+ *******************************************************************************
+ * Copyright 2025(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include <errno.h>
+#include "no_os_unpack.h"
+#include "no_os_util.h"
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define NO_OS_UNPACK_SHUFFLE
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#define NO_OS_UNPACK_SHUFFLE
+#elif defined(__SSE4_1__)
+#include <smmintrin.h>
+#define NO_OS_UNPACK_SHUFFLE
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+ * Every kernel moves a word to the top of a 32-bit lane first. The sample
+ * and the status are then taken with one shift each, an arithmetic shift
+ * doing the sign extension.
+ */
+struct no_os_unpack_plan {
+	/* Word width, sample and status */
+	uint32_t width;
+	/* Top aligned word to sample */
+	uint32_t dshift;
+	/* Top aligned word to status */
+	uint32_t sshift;
+	uint32_t smask;
+	bool sign;
+	/* Status goes to its own array */
+	bool split;
+};
+
+static int no_os_unpack_plan(const struct no_os_unpack_fmt *fmt,
+			     bool split, struct no_os_unpack_plan *p)
+{
+	if (!fmt || !fmt->bits || fmt->bits + fmt->status_bits > 32)
+		return -EINVAL;
+
+	p->width = fmt->bits + fmt->status_bits;
+	p->split = split && fmt->status_bits;
+	p->dshift = 32 - (p->split ? fmt->bits : p->width);
+	p->sshift = 32 - p->width;
+	p->smask = (1u << fmt->status_bits) - 1;
+	p->sign = fmt->sign;
+
+	return 0;
+}
+
+static inline void no_os_unpack_one(const struct no_os_unpack_plan *p,
+				    uint32_t x, int32_t *dst, uint32_t *status)
+{
+	if (p->split)
+		*status = (x >> p->sshift) & p->smask;
+
+	*dst = p->sign ? (int32_t)x >> p->dshift : (int32_t)(x >> p->dshift);
+}
+
+#ifdef NO_OS_UNPACK_SHUFFLE
+/*
+ * Packed words, four at a time. Four words take width / 2 bytes, so for an
+ * even width every group starts on a byte boundary with the same layout:
+ * word i starts (i * width) % 8 bits into the big endian 32-bit value at
+ * byte i * width / 8. The vector kernels gather these bytes with a table
+ * lookup, then shift each lane left by that offset. Widths where a word
+ * does not fit in its lane use the scalar path.
+ */
+static bool no_os_unpack_group(uint32_t width, uint8_t *idx, uint32_t *shift)
+{
+	uint32_t i, j;
+
+	if (width % 2)
+		return false;
+
+	for (i = 0; i < 4; i++) {
+		shift[i] = (i * width) % 8;
+		if (shift[i] + width > 32)
+			return false;
+
+		for (j = 0; j < 4; j++)
+			idx[4 * i + j] = i * width / 8 + 3 - j;
+	}
+
+	return true;
+}
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+static uint32_t no_os_unpack_vec(const struct no_os_unpack_plan *p,
+				 const uint8_t *src, uint32_t nb,
+				 uint32_t nbytes, int32_t *dst,
+				 uint32_t *status)
+{
+	uint8_t idx[16];
+	uint32_t shift[4];
+	uint8x16_t tbl;
+	int32x4_t lsh, dsh, ssh;
+	uint32x4_t x, smask;
+	uint32_t i, g = p->width / 2;
+
+	if (!no_os_unpack_group(p->width, idx, shift))
+		return 0;
+
+	tbl = vld1q_u8(idx);
+	lsh = vreinterpretq_s32_u32(vld1q_u32(shift));
+	dsh = vdupq_n_s32(-(int32_t)p->dshift);
+	ssh = vdupq_n_s32(-(int32_t)p->sshift);
+	smask = vdupq_n_u32(p->smask);
+
+	for (i = 0; i + 4 <= nb && (i / 4) * g + 16 <= nbytes; i += 4) {
+		x = vreinterpretq_u32_u8(vqtbl1q_u8(vld1q_u8(src + (i / 4) * g),
+						    tbl));
+		x = vshlq_u32(x, lsh);
+		if (p->split)
+			vst1q_u32(status + i, vandq_u32(vshlq_u32(x, ssh), smask));
+		if (p->sign)
+			vst1q_s32(dst + i, vshlq_s32(vreinterpretq_s32_u32(x), dsh));
+		else
+			vst1q_s32(dst + i,
+				  vreinterpretq_s32_u32(vshlq_u32(x, dsh)));
+	}
+
+	return i;
+}
+#elif defined(__AVX2__)
+static uint32_t no_os_unpack_vec(const struct no_os_unpack_plan *p,
+				 const uint8_t *src, uint32_t nb,
+				 uint32_t nbytes, int32_t *dst,
+				 uint32_t *status)
+{
+	uint8_t idx[16];
+	uint32_t shift[4];
+	__m256i tbl, lsh, smask, x;
+	__m128i tbl4, lsh4, dsh, ssh;
+	uint32_t i, g = p->width / 2;
+
+	if (!no_os_unpack_group(p->width, idx, shift))
+		return 0;
+
+	/* Both 128-bit halves hold a group of four words */
+	tbl4 = _mm_loadu_si128((const __m128i *)idx);
+	lsh4 = _mm_loadu_si128((const __m128i *)shift);
+	tbl = _mm256_set_m128i(tbl4, tbl4);
+	lsh = _mm256_set_m128i(lsh4, lsh4);
+	dsh = _mm_cvtsi32_si128(p->dshift);
+	ssh = _mm_cvtsi32_si128(p->sshift);
+	smask = _mm256_set1_epi32(p->smask);
+
+	for (i = 0; i + 8 <= nb && (i / 4 + 1) * g + 16 <= nbytes; i += 8) {
+		x = _mm256_loadu2_m128i(
+			    (const __m128i *)(src + (i / 4 + 1) * g),
+			    (const __m128i *)(src + (i / 4) * g));
+		x = _mm256_sllv_epi32(_mm256_shuffle_epi8(x, tbl), lsh);
+		if (p->split)
+			_mm256_storeu_si256((__m256i *)(status + i),
+					    _mm256_and_si256(_mm256_srl_epi32(x, ssh),
+							    smask));
+		_mm256_storeu_si256((__m256i *)(dst + i),
+				    p->sign ? _mm256_sra_epi32(x, dsh) :
+				    _mm256_srl_epi32(x, dsh));
+	}
+
+	return i;
+}
+#elif defined(__SSE4_1__)
+static uint32_t no_os_unpack_vec(const struct no_os_unpack_plan *p,
+				 const uint8_t *src, uint32_t nb,
+				 uint32_t nbytes, int32_t *dst,
+				 uint32_t *status)
+{
+	uint8_t idx[16];
+	uint32_t shift[4];
+	__m128i tbl, mul, dsh, ssh, smask, x;
+	uint32_t i, g = p->width / 2;
+
+	if (!no_os_unpack_group(p->width, idx, shift))
+		return 0;
+
+	tbl = _mm_loadu_si128((const __m128i *)idx);
+	/* No per-lane shift before AVX2, multiply by 2^shift instead */
+	mul = _mm_setr_epi32(1u << shift[0], 1u << shift[1],
+			     1u << shift[2], 1u << shift[3]);
+	dsh = _mm_cvtsi32_si128(p->dshift);
+	ssh = _mm_cvtsi32_si128(p->sshift);
+	smask = _mm_set1_epi32(p->smask);
+
+	for (i = 0; i + 4 <= nb && (i / 4) * g + 16 <= nbytes; i += 4) {
+		x = _mm_loadu_si128((const __m128i *)(src + (i / 4) * g));
+		x = _mm_mullo_epi32(_mm_shuffle_epi8(x, tbl), mul);
+		if (p->split)
+			_mm_storeu_si128((__m128i *)(status + i),
+					 _mm_and_si128(_mm_srl_epi32(x, ssh),
+						       smask));
+		_mm_storeu_si128((__m128i *)(dst + i),
+				 p->sign ? _mm_sra_epi32(x, dsh) :
+				 _mm_srl_epi32(x, dsh));
+	}
+
+	return i;
+}
+#else
+static uint32_t no_os_unpack_vec(const struct no_os_unpack_plan *p,
+				 const uint8_t *src, uint32_t nb,
+				 uint32_t nbytes, int32_t *dst,
+				 uint32_t *status)
+{
+	NO_OS_UNUSED_PARAM(p);
+	NO_OS_UNUSED_PARAM(src);
+	NO_OS_UNUSED_PARAM(nb);
+	NO_OS_UNUSED_PARAM(nbytes);
+	NO_OS_UNUSED_PARAM(dst);
+	NO_OS_UNUSED_PARAM(status);
+
+	return 0;
+}
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+static uint32_t no_os_unpack32_vec(const struct no_os_unpack_plan *p,
+				   const uint32_t *src, uint32_t nb,
+				   int32_t *dst, uint32_t *status)
+{
+	int32x4_t lsh = vdupq_n_s32(32 - p->width);
+	int32x4_t dsh = vdupq_n_s32(-(int32_t)p->dshift);
+	int32x4_t ssh = vdupq_n_s32(-(int32_t)p->sshift);
+	uint32x4_t smask = vdupq_n_u32(p->smask);
+	uint32x4_t x;
+	uint32_t i;
+
+	for (i = 0; i + 4 <= nb; i += 4) {
+		x = vshlq_u32(vld1q_u32(src + i), lsh);
+		if (p->split)
+			vst1q_u32(status + i, vandq_u32(vshlq_u32(x, ssh), smask));
+		if (p->sign)
+			vst1q_s32(dst + i, vshlq_s32(vreinterpretq_s32_u32(x), dsh));
+		else
+			vst1q_s32(dst + i,
+				  vreinterpretq_s32_u32(vshlq_u32(x, dsh)));
+	}
+
+	return i;
+}
+#elif defined(__AVX2__)
+static uint32_t no_os_unpack32_vec(const struct no_os_unpack_plan *p,
+				   const uint32_t *src, uint32_t nb,
+				   int32_t *dst, uint32_t *status)
+{
+	__m128i lsh = _mm_cvtsi32_si128(32 - p->width);
+	__m128i dsh = _mm_cvtsi32_si128(p->dshift);
+	__m128i ssh = _mm_cvtsi32_si128(p->sshift);
+	__m256i smask = _mm256_set1_epi32(p->smask);
+	__m256i x;
+	uint32_t i;
+
+	for (i = 0; i + 8 <= nb; i += 8) {
+		x = _mm256_sll_epi32(_mm256_loadu_si256((const __m256i *)(src + i)),
+				     lsh);
+		if (p->split)
+			_mm256_storeu_si256((__m256i *)(status + i),
+					    _mm256_and_si256(_mm256_srl_epi32(x, ssh),
+							    smask));
+		_mm256_storeu_si256((__m256i *)(dst + i),
+				    p->sign ? _mm256_sra_epi32(x, dsh) :
+				    _mm256_srl_epi32(x, dsh));
+	}
+
+	return i;
+}
+#elif defined(__SSE2__)
+static uint32_t no_os_unpack32_vec(const struct no_os_unpack_plan *p,
+				   const uint32_t *src, uint32_t nb,
+				   int32_t *dst, uint32_t *status)
+{
+	__m128i lsh = _mm_cvtsi32_si128(32 - p->width);
+	__m128i dsh = _mm_cvtsi32_si128(p->dshift);
+	__m128i ssh = _mm_cvtsi32_si128(p->sshift);
+	__m128i smask = _mm_set1_epi32(p->smask);
+	__m128i x;
+	uint32_t i;
+
+	for (i = 0; i + 4 <= nb; i += 4) {
+		x = _mm_sll_epi32(_mm_loadu_si128((const __m128i *)(src + i)), lsh);
+		if (p->split)
+			_mm_storeu_si128((__m128i *)(status + i),
+					 _mm_and_si128(_mm_srl_epi32(x, ssh),
+						       smask));
+		_mm_storeu_si128((__m128i *)(dst + i),
+				 p->sign ? _mm_sra_epi32(x, dsh) :
+				 _mm_srl_epi32(x, dsh));
+	}
+
+	return i;
+}
+#else
+static uint32_t no_os_unpack32_vec(const struct no_os_unpack_plan *p,
+				   const uint32_t *src, uint32_t nb,
+				   int32_t *dst, uint32_t *status)
+{
+	NO_OS_UNUSED_PARAM(p);
+	NO_OS_UNUSED_PARAM(src);
+	NO_OS_UNUSED_PARAM(nb);
+	NO_OS_UNUSED_PARAM(dst);
+	NO_OS_UNUSED_PARAM(status);
+
+	return 0;
+}
+#endif
+
+/**
+ * @brief Unpack words packed back to back, MSB first.
+ *
+ * This is the layout of most multi-channel ADC frames read over SPI, one
+ * word per channel. If status is NULL, the status bits are kept below the
+ * sample in dst, and the whole word is sign-extended if fmt->sign is set.
+ * Otherwise dst only gets the sample and status gets the status bits.
+ * @param fmt - Word layout.
+ * @param src - Packed words, nb * (bits + status_bits) bits rounded up to
+ *              a byte.
+ * @param nb - Number of words.
+ * @param dst - Samples, nb entries.
+ * @param status - Status of each word, NULL to keep it in dst.
+ * @return 0 in case of success, -EINVAL for an invalid layout.
+ */
+int no_os_unpack(const struct no_os_unpack_fmt *fmt, const uint8_t *src,
+		 uint32_t nb, int32_t *dst, uint32_t *status)
+{
+	struct no_os_unpack_plan p;
+	uint32_t nbytes, i, nbits = 0;
+	uint64_t acc = 0;
+	int ret;
+
+	ret = no_os_unpack_plan(fmt, status != NULL, &p);
+	if (ret)
+		return ret;
+
+	nbytes = ((uint64_t)nb * p.width + 7) / 8;
+	i = no_os_unpack_vec(&p, src, nb, nbytes, dst, status);
+	/* The vector kernels stop on a byte boundary */
+	src += (uint64_t)i * p.width / 8;
+
+	for (; i < nb; i++) {
+		while (nbits < p.width) {
+			acc = (acc << 8) | *src++;
+			nbits += 8;
+		}
+		nbits -= p.width;
+		no_os_unpack_one(&p, (uint32_t)(acc >> nbits) << (32 - p.width),
+				 &dst[i], status ? &status[i] : NULL);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Unpack words already right aligned in 32-bit containers.
+ *
+ * Same as no_os_unpack(), for data that comes one word per 32-bit
+ * container, like DMA buffers of HDL cores. The bits above the word are
+ * ignored. src and dst may be the same buffer.
+ * @param fmt - Word layout.
+ * @param src - Words.
+ * @param nb - Number of words.
+ * @param dst - Samples, nb entries.
+ * @param status - Status of each word, NULL to keep it in dst.
+ * @return 0 in case of success, -EINVAL for an invalid layout.
+ */
+int no_os_unpack32(const struct no_os_unpack_fmt *fmt, const uint32_t *src,
+		   uint32_t nb, int32_t *dst, uint32_t *status)
+{
+	struct no_os_unpack_plan p;
+	uint32_t i;
+	int ret;
+
+	ret = no_os_unpack_plan(fmt, status != NULL, &p);
+	if (ret)
+		return ret;
+
+	i = no_os_unpack32_vec(&p, src, nb, dst, status);
+	for (; i < nb; i++)
+		no_os_unpack_one(&p, src[i] << (32 - p.width), &dst[i],
+				 status ? &status[i] : NULL);
+
+	return 0;
+}